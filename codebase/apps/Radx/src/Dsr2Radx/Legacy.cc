@@ -270,7 +270,12 @@ int Legacy::_run ()
   // Instantiate and initialize the DsRadar queue and message
 
   DsRadarQueue radarQueue;
-  DsRadarMsg radarMsg;
+  DsRadarMsg radarMsg(DsMessage::PointToMem);
+
+  // read the beam data in place in the FMQ message,
+  // see _createInputRay()
+
+  radarMsg.setDecodeBeamData(false);
 
   if (_params.seek_to_end_of_input) {
     if (radarQueue.init(_params.input_fmq_url, _progName.c_str(),
@@ -1389,8 +1394,14 @@ RadxRay *Legacy::_createInputRay(const DsRadarMsg &radarMsg,
   }
 
   // load up fields
+  // the data is converted in place in the message, which may
+  // be gate-interleaved or field-planar
 
-  int byteWidth = rbeam.byteWidth;
+  DsBeamView beamView;
+  if (beamView.init(radarMsg)) {
+    cerr << "WARNING - Legacy::_createInputRay" << endl;
+    cerr << "  Cannot access beam data, ignoring fields" << endl;
+  }
   
   for (size_t iparam = 0; iparam < fparamsVec.size(); iparam++) {
 
@@ -1405,62 +1416,7 @@ RadxRay *Legacy::_createInputRay(const DsRadarMsg &radarMsg,
     // convert to floats
     
     Radx::fl32 *fdata = new Radx::fl32[nGates];
-
-    if (byteWidth == 4) {
-
-      fl32 *inData = (fl32 *) rbeam.data() + iparam;
-      fl32 inMissing = (fl32) fparams.missingDataValue;
-      Radx::fl32 *outData = fdata;
-      
-      for (int igate = 0; igate < nGates;
-           igate++, inData += fparamsVec.size(), outData++) {
-        fl32 inVal = *inData;
-        if (inVal == inMissing) {
-          *outData = Radx::missingFl32;
-        } else {
-          *outData = *inData;
-        }
-      } // igate
-
-    } else if (byteWidth == 2) {
-
-      ui16 *inData = (ui16 *) rbeam.data() + iparam;
-      ui16 inMissing = (ui16) fparams.missingDataValue;
-      double scale = fparams.scale;
-      double bias = fparams.bias;
-      Radx::fl32 *outData = fdata;
-      
-      for (int igate = 0; igate < nGates;
-           igate++, inData += fparamsVec.size(), outData++) {
-        ui16 inVal = *inData;
-        if (inVal == inMissing) {
-          *outData = Radx::missingFl32;
-        } else {
-          *outData = *inData * scale + bias;
-        }
-      } // igate
-
-    } else {
-
-      // byte width 1
-
-      ui08 *inData = (ui08 *) rbeam.data() + iparam;
-      ui08 inMissing = (ui08) fparams.missingDataValue;
-      double scale = fparams.scale;
-      double bias = fparams.bias;
-      Radx::fl32 *outData = fdata;
-      
-      for (int igate = 0; igate < nGates;
-           igate++, inData += fparamsVec.size(), outData++) {
-        ui08 inVal = *inData;
-        if (inVal == inMissing) {
-          *outData = Radx::missingFl32;
-        } else {
-          *outData = *inData * scale + bias;
-        }
-      } // igate
-
-    } // if (byteWidth == 4)
+    beamView.getFieldFl32(iparam, fdata, nGates, Radx::missingFl32);
 
     RadxField *field = new RadxField(fparams.name, fparams.units);
     field->copyRangeGeom(*ray);
@@ -52,6 +52,7 @@
 #include <Radx/RadxVol.hh>
 #include <Radx/RadxFile.hh>
 #include <rapformats/DsRadarMsg.hh>
+#include <rapformats/DsBeamView.hh>
 #include <Fmq/DsRadarQueue.hh>
 class RadxRay;
 
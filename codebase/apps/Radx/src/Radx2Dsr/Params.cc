@@ -1064,6 +1064,18 @@
     tt->single_val.i = 100000000;
     tt++;
     
+    // Parameter 'output_field_planar_beams'
+    // ctype is 'tdrp_bool_t'
+    
+    memset(tt, 0, sizeof(TDRPtable));
+    tt->ptype = BOOL_TYPE;
+    tt->param_name = tdrpStrDup("output_field_planar_beams");
+    tt->descr = tdrpStrDup("Option to write the beam data field by field.");
+    tt->help = tdrpStrDup("By default the beam data is written gate by gate, i.e. with the fields interleaved at each gate. If true, the data for each field is written contiguously, so that readers can access each field directly without de-interleaving it. Only set this if all readers of the queue have been built with support for the field-planar layout. Older readers will misinterpret the data.");
+    tt->val_offset = (char *) &output_field_planar_beams - &_start_;
+    tt->single_val.b = pFALSE;
+    tt++;
+    
     // trailing entry has param_name set to NULL
     
     tt->param_name = NULL;
@@ -451,6 +451,8 @@ public:
 
   int output_buf_size;
 
+  tdrp_bool_t output_field_planar_beams;
+
   char _end_; // end of data region
               // needed for zeroing out data
 
@@ -458,7 +460,7 @@ private:
 
   void _init();
 
-  mutable TDRPtable _table[41];
+  mutable TDRPtable _table[42];
 
   const char *_className;
 
@@ -886,6 +886,14 @@ int Radx2Dsr::_writeBeam(const RadxVol &vol,
   if (_params.debug >= Params::DEBUG_VERBOSE) {
     beam.print(cerr);
   }
+
+  // option to write field by field
+  // the number of fields is needed to encode the planar layout
+
+  if (_params.output_field_planar_beams) {
+    msg.getRadarParams().numFields = nFields;
+    msg.setFieldPlanar(true);
+  }
   
   // put beam
   
@@ -0,0 +1,412 @@
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* 
+// ** Copyright UCAR (c) 1990 - 2016                                         
+// ** University Corporation for Atmospheric Research (UCAR)                 
+// ** National Center for Atmospheric Research (NCAR)                        
+// ** Boulder, Colorado, USA                                                 
+// ** BSD licence applies - redistribution and use in source and binary      
+// ** forms, with or without modification, are permitted provided that       
+// ** the following conditions are met:                                      
+// ** 1) If the software is modified to produce derivative works,            
+// ** such modified software should be clearly marked, so as not             
+// ** to confuse it with the version available from UCAR.                    
+// ** 2) Redistributions of source code must retain the above copyright      
+// ** notice, this list of conditions and the following disclaimer.          
+// ** 3) Redistributions in binary form must reproduce the above copyright   
+// ** notice, this list of conditions and the following disclaimer in the    
+// ** documentation and/or other materials provided with the distribution.   
+// ** 4) Neither the name of UCAR nor the names of its contributors,         
+// ** if any, may be used to endorse or promote products derived from        
+// ** this software without specific prior written permission.               
+// ** DISCLAIMER: THIS SOFTWARE IS PROVIDED "AS IS" AND WITHOUT ANY EXPRESS  
+// ** OR IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED      
+// ** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.    
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* 
+///////////////////////////////////////////////////////////////
+// CartGeomCache.cc
+//
+// CartGeomCache class.
+// Cache of the polar-to-Cartesian interpolation geometry
+// used by CartInterp.
+//
+///////////////////////////////////////////////////////////////
+
+#include "CartGeomCache.hh"
+#include <toolsa/os_config.h>
+#include <toolsa/file_io.h>
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+#include <cerrno>
+#include <iostream>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+using namespace std;
+
+const char *CartGeomCache::_fileMagic = "RX2GGEOM";
+
+//////////////////////////////////////////////////////////////
+// Table constructor and destructor
+
+CartGeomCache::Table::Table(const string &key, size_t nPoints) :
+        _key(key),
+        _nPoints(nPoints),
+        _entries(NULL),
+        _alloc(NULL),
+        _mapBuf(NULL),
+        _mapLen(0)
+{
+}
+
+CartGeomCache::Table::~Table()
+{
+  if (_alloc) {
+    delete[] _alloc;
+  }
+  if (_mapBuf) {
+    munmap(_mapBuf, _mapLen);
+  }
+}
+
+//////////////////////////////////////////////////////////////
+// Constructor
+
+CartGeomCache::CartGeomCache(const Params &params) :
+        _params(params)
+{
+}
+
+//////////////////////////////////////////////////////////////
+// destructor
+
+CartGeomCache::~CartGeomCache()
+{
+  clear();
+}
+
+//////////////////////////////////////////////////////////////
+// free all tables
+
+void CartGeomCache::clear()
+{
+  for (list<Table *>::iterator it = _tables.begin();
+       it != _tables.end(); it++) {
+    delete *it;
+  }
+  _tables.clear();
+}
+
+//////////////////////////////////////////////////////////////
+// look up a table, in memory and then on disk
+// returns NULL on miss
+
+CartGeomCache::Table *CartGeomCache::lookup(const string &key,
+                                            size_t nPoints)
+{
+
+  // check memory, moving a hit to the front of the list
+
+  for (list<Table *>::iterator it = _tables.begin();
+       it != _tables.end(); it++) {
+    Table *table = *it;
+    if (table->_nPoints == nPoints && table->_key == key) {
+      _tables.erase(it);
+      _tables.push_front(table);
+      if (_params.debug) {
+        cerr << "  CartGeomCache - using geometry table from memory" << endl;
+      }
+      return table;
+    }
+  }
+
+  // check disk
+
+  if (strlen(_params.interp_geometry_cache_dir) == 0) {
+    return NULL;
+  }
+
+  Table *table = _readFile(key, nPoints);
+  if (table == NULL) {
+    return NULL;
+  }
+  if (_params.debug) {
+    cerr << "  CartGeomCache - using geometry table from file: "
+         << _getFilePath(key) << endl;
+  }
+
+  _tables.push_front(table);
+  _trim();
+  return table;
+
+}
+
+//////////////////////////////////////////////////////////////
+// create a new table, with all entries cleared
+
+CartGeomCache::Table *CartGeomCache::createTable(const string &key,
+                                                 size_t nPoints)
+{
+  Table *table = new Table(key, nPoints);
+  table->_alloc = new Entry[nPoints];
+  table->_entries = table->_alloc;
+  for (size_t ii = 0; ii < nPoints; ii++) {
+    table->_entries[ii].clear();
+  }
+  return table;
+}
+
+//////////////////////////////////////////////////////////////
+// add a filled table to the cache, which takes ownership
+
+void CartGeomCache::addTable(Table *table)
+{
+
+  _tables.push_front(table);
+
+  if (strlen(_params.interp_geometry_cache_dir) > 0) {
+    if (_writeFile(table)) {
+      cerr << "WARNING - CartGeomCache::addTable" << endl;
+      cerr << "  Cannot write geometry table to dir: "
+           << _params.interp_geometry_cache_dir << endl;
+    }
+  }
+
+  _trim();
+
+}
+
+//////////////////////////////////////////////////////////////
+// free least-recently used tables beyond the max count
+
+void CartGeomCache::_trim()
+{
+  size_t maxTables = _params.interp_geometry_cache_max_tables;
+  if (maxTables < 1) {
+    maxTables = 1;
+  }
+  while (_tables.size() > maxTables) {
+    delete _tables.back();
+    _tables.pop_back();
+  }
+}
+
+//////////////////////////////////////////////////////////////
+// building the key
+// values are added in native byte order - the key is only
+// compared with keys built on the same host
+
+void CartGeomCache::addToKey(string &key, int val)
+{
+  si32 ival = val;
+  key.append((const char *) &ival, sizeof(ival));
+}
+
+void CartGeomCache::addToKey(string &key, double val)
+{
+  key.append((const char *) &val, sizeof(val));
+}
+
+void CartGeomCache::addToKey(string &key, const string &val)
+{
+  addToKey(key, (int) val.size());
+  key.append(val);
+}
+
+void CartGeomCache::addAngleToKey(string &key, double angle,
+                                  double tolerance)
+{
+  if (tolerance <= 0) {
+    addToKey(key, angle);
+  } else {
+    si64 ival = (si64) floor(angle / tolerance + 0.5);
+    key.append((const char *) &ival, sizeof(ival));
+  }
+}
+
+//////////////////////////////////////////////////////////////
+// get the file path for a key
+// the name is the FNV-1a hash of the key
+
+string CartGeomCache::_getFilePath(const string &key) const
+{
+
+  ui64 hash = 14695981039346656037ULL;
+  for (size_t ii = 0; ii < key.size(); ii++) {
+    hash ^= (unsigned char) key[ii];
+    hash *= 1099511628211ULL;
+  }
+
+  char name[64];
+  snprintf(name, sizeof(name), "geom_%016llx.rx2g",
+           (unsigned long long) hash);
+
+  string path(_params.interp_geometry_cache_dir);
+  path += PATH_DELIM;
+  path += name;
+  return path;
+
+}
+
+//////////////////////////////////////////////////////////////
+// read a table from a file, using mmap
+// returns NULL if the file does not exist or does not match
+
+CartGeomCache::Table *CartGeomCache::_readFile(const string &key,
+                                               size_t nPoints)
+{
+
+  string path = _getFilePath(key);
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return NULL;
+  }
+  
+  struct stat fileStat;
+  if (fstat(fd, &fileStat)) {
+    close(fd);
+    return NULL;
+  }
+  
+  // entries start on an 8-byte boundary after the key
+
+  size_t entryOffset = sizeof(file_hdr_t) + key.size();
+  entryOffset = ((entryOffset + 7) / 8) * 8;
+  size_t expectedLen = entryOffset + nPoints * sizeof(Entry);
+  if ((size_t) fileStat.st_size != expectedLen) {
+    if (_params.debug) {
+      cerr << "WARNING - CartGeomCache::_readFile" << endl;
+      cerr << "  Ignoring geometry file with wrong size: " << path << endl;
+    }
+    close(fd);
+    return NULL;
+  }
+
+  void *buf = mmap(NULL, expectedLen, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (buf == MAP_FAILED) {
+    int errNum = errno;
+    cerr << "WARNING - CartGeomCache::_readFile" << endl;
+    cerr << "  Cannot mmap file: " << path << endl;
+    cerr << "  " << strerror(errNum) << endl;
+    return NULL;
+  }
+
+  // check header and key - a hash collision or a file from
+  // a different build is treated as a miss
+
+  const file_hdr_t *hdr = (const file_hdr_t *) buf;
+  const char *fileKey = (const char *) buf + sizeof(file_hdr_t);
+  if (memcmp(hdr->magic, _fileMagic, sizeof(hdr->magic)) != 0 ||
+      hdr->version != _fileVersion ||
+      hdr->entrySize != (si32) sizeof(Entry) ||
+      hdr->keyLen != (si64) key.size() ||
+      hdr->nPoints != (si64) nPoints ||
+      memcmp(fileKey, key.c_str(), key.size()) != 0) {
+    if (_params.debug) {
+      cerr << "WARNING - CartGeomCache::_readFile" << endl;
+      cerr << "  Geometry file does not match key: " << path << endl;
+    }
+    munmap(buf, expectedLen);
+    return NULL;
+  }
+
+  Table *table = new Table(key, nPoints);
+  table->_mapBuf = buf;
+  table->_mapLen = expectedLen;
+  table->_entries = (Entry *) ((char *) buf + entryOffset);
+  return table;
+
+}
+
+//////////////////////////////////////////////////////////////
+// write a table to a file
+// writes to a tmp file and renames, so that readers never
+// see a partial file
+// returns 0 on success, -1 on failure
+
+int CartGeomCache::_writeFile(const Table *table)
+{
+
+  if (ta_makedir_recurse(_params.interp_geometry_cache_dir)) {
+    int errNum = errno;
+    cerr << "ERROR - CartGeomCache::_writeFile" << endl;
+    cerr << "  Cannot make dir: " << _params.interp_geometry_cache_dir << endl;
+    cerr << "  " << strerror(errNum) << endl;
+    return -1;
+  }
+
+  string path = _getFilePath(table->_key);
+  char tmpPath[MAX_PATH_LEN];
+  snprintf(tmpPath, MAX_PATH_LEN, "%s.tmp.%d", path.c_str(), (int) getpid());
+
+  FILE *out = fopen(tmpPath, "w");
+  if (out == NULL) {
+    int errNum = errno;
+    cerr << "ERROR - CartGeomCache::_writeFile" << endl;
+    cerr << "  Cannot open file for writing: " << tmpPath << endl;
+    cerr << "  " << strerror(errNum) << endl;
+    return -1;
+  }
+
+  file_hdr_t hdr;
+  memset(&hdr, 0, sizeof(hdr));
+  memcpy(hdr.magic, _fileMagic, sizeof(hdr.magic));
+  hdr.version = _fileVersion;
+  hdr.entrySize = sizeof(Entry);
+  hdr.keyLen = table->_key.size();
+  hdr.nPoints = table->_nPoints;
+
+  size_t keyEnd = sizeof(file_hdr_t) + table->_key.size();
+  size_t entryOffset = ((keyEnd + 7) / 8) * 8;
+  char pad[8];
+  memset(pad, 0, sizeof(pad));
+
+  bool error = false;
+  if (fwrite(&hdr, sizeof(hdr), 1, out) != 1) {
+    error = true;
+  }
+  if (!error && table->_key.size() > 0 &&
+      fwrite(table->_key.c_str(), table->_key.size(), 1, out) != 1) {
+    error = true;
+  }
+  if (!error && entryOffset > keyEnd &&
+      fwrite(pad, entryOffset - keyEnd, 1, out) != 1) {
+    error = true;
+  }
+  if (!error &&
+      fwrite(table->_entries, sizeof(Entry),
+             table->_nPoints, out) != table->_nPoints) {
+    error = true;
+  }
+  if (fclose(out)) {
+    error = true;
+  }
+
+  if (error) {
+    int errNum = errno;
+    cerr << "ERROR - CartGeomCache::_writeFile" << endl;
+    cerr << "  Cannot write file: " << tmpPath << endl;
+    cerr << "  " << strerror(errNum) << endl;
+    unlink(tmpPath);
+    return -1;
+  }
+
+  if (rename(tmpPath, path.c_str())) {
+    int errNum = errno;
+    cerr << "ERROR - CartGeomCache::_writeFile" << endl;
+    cerr << "  Cannot rename file: " << tmpPath << endl;
+    cerr << "  to: " << path << endl;
+    cerr << "  " << strerror(errNum) << endl;
+    unlink(tmpPath);
+    return -1;
+  }
+
+  if (_params.debug) {
+    cerr << "  CartGeomCache - wrote geometry table to file: "
+         << path << endl;
+  }
+
+  return 0;
+
+}
@@ -0,0 +1,177 @@
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* 
+// ** Copyright UCAR (c) 1990 - 2016                                         
+// ** University Corporation for Atmospheric Research (UCAR)                 
+// ** National Center for Atmospheric Research (NCAR)                        
+// ** Boulder, Colorado, USA                                                 
+// ** BSD licence applies - redistribution and use in source and binary      
+// ** forms, with or without modification, are permitted provided that       
+// ** the following conditions are met:                                      
+// ** 1) If the software is modified to produce derivative works,            
+// ** such modified software should be clearly marked, so as not             
+// ** to confuse it with the version available from UCAR.                    
+// ** 2) Redistributions of source code must retain the above copyright      
+// ** notice, this list of conditions and the following disclaimer.          
+// ** 3) Redistributions in binary form must reproduce the above copyright   
+// ** notice, this list of conditions and the following disclaimer in the    
+// ** documentation and/or other materials provided with the distribution.   
+// ** 4) Neither the name of UCAR nor the names of its contributors,         
+// ** if any, may be used to endorse or promote products derived from        
+// ** this software without specific prior written permission.               
+// ** DISCLAIMER: THIS SOFTWARE IS PROVIDED "AS IS" AND WITHOUT ANY EXPRESS  
+// ** OR IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED      
+// ** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.    
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* 
+/////////////////////////////////////////////////////////////
+// CartGeomCache.hh
+//
+// CartGeomCache class.
+// Cache of the polar-to-Cartesian interpolation geometry
+// used by CartInterp.
+//
+///////////////////////////////////////////////////////////////
+//
+// For each grid point, a table entry holds the indices of the
+// (up to) 4 rays bounding the point, the inner gate index and
+// the normalized weights for the 8 neighboring gates. This is
+// everything CartInterp needs to interpolate the fields, so a
+// volume with a matching key can skip the search entirely.
+//
+// The key is a byte string, built by CartInterp, describing the
+// radar location, output grid, range geometry and ray angles.
+//
+// Tables are held in memory, up to a maximum count, with the
+// least-recently used table freed first. If a directory is
+// specified, tables are also written to files, named from a hash
+// of the key, and on a memory miss the directory is checked.
+// Files are memory-mapped for reading, and the key stored in
+// the file is compared with the requested key before use.
+//
+///////////////////////////////////////////////////////////////
+
+#ifndef CartGeomCache_HH
+#define CartGeomCache_HH
+
+#include <dataport/port_types.h>
+#include <string>
+#include <list>
+#include "Params.hh"
+using namespace std;
+
+class CartGeomCache {
+
+public:
+
+  // geometry for a single grid point
+  // rays are ordered ll, ul, lr, ur
+  // rayIndex is -1 for a missing ray
+  // if all 4 are missing, the point is not interpolated
+
+  class Entry {
+  public:
+    si32 rayIndex[4];
+    si32 igateInner;
+    fl32 wts[8]; // ll_inner, ll_outer, ul_inner, ..., ur_outer
+    inline void clear() {
+      rayIndex[0] = rayIndex[1] = rayIndex[2] = rayIndex[3] = -1;
+      igateInner = 0;
+      for (int ii = 0; ii < 8; ii++) {
+        wts[ii] = 0.0;
+      }
+    }
+    inline bool isValid() const {
+      return (rayIndex[0] >= 0 || rayIndex[1] >= 0 ||
+              rayIndex[2] >= 0 || rayIndex[3] >= 0);
+    }
+  };
+
+  // table of entries for a volume, one per grid point
+
+  class Table {
+    friend class CartGeomCache;
+  public:
+    const string &getKey() const { return _key; }
+    size_t getNPoints() const { return _nPoints; }
+    bool isValid(size_t ptIndex) const {
+      return _entries[ptIndex].isValid();
+    }
+    Entry &getEntry(size_t ptIndex) { return _entries[ptIndex]; }
+    const Entry &getEntry(size_t ptIndex) const { return _entries[ptIndex]; }
+  private:
+    Table(const string &key, size_t nPoints);
+    ~Table();
+    string _key;
+    size_t _nPoints;
+    Entry *_entries;
+    Entry *_alloc; // non-NULL if allocated
+    void *_mapBuf; // non-NULL if memory-mapped
+    size_t _mapLen;
+  };
+
+  // constructor
+  
+  CartGeomCache(const Params &params);
+
+  // destructor
+  
+  ~CartGeomCache();
+
+  // look up a table, in memory and then on disk
+  // returns NULL on miss
+
+  Table *lookup(const string &key, size_t nPoints);
+
+  // create a new table, with all entries cleared
+  // ready for filling in.
+  // Pass to addTable() when filled.
+
+  Table *createTable(const string &key, size_t nPoints);
+
+  // add a filled table to the cache, which takes ownership.
+  // It is also written to disk if a directory was specified.
+
+  void addTable(Table *table);
+
+  // free all tables
+
+  void clear();
+
+  // building the key
+
+  static void addToKey(string &key, int val);
+  static void addToKey(string &key, double val);
+  static void addToKey(string &key, const string &val);
+
+  // add an angle to the key, rounded to the tolerance
+  // if tolerance is 0, the angle is added unchanged
+  
+  static void addAngleToKey(string &key, double angle, double tolerance);
+
+private:
+  
+  const Params &_params;
+
+  // tables in memory, most recently used first
+
+  list<Table *> _tables;
+
+  // file handling
+
+  static const char *_fileMagic;
+  static const int _fileVersion = 1;
+  
+  typedef struct {
+    char magic[8];
+    si32 version;
+    si32 entrySize;
+    si64 keyLen;
+    si64 nPoints;
+  } file_hdr_t;
+
+  string _getFilePath(const string &key) const;
+  Table *_readFile(const string &key, size_t nPoints);
+  int _writeFile(const Table *table);
+  void _trim();
+
+};
+
+#endif
@@ -98,6 +98,12 @@ CartInterp::CartInterp(const string &progName,
   _orient = NULL;
   _echoOrientationAvailable = false;
 
+  _geomCache = NULL;
+  _geomTable = NULL;
+  _geomRecording = false;
+
+  _mosaicNRadars = 0;
+
   // create debug fields if needed
 
   if (_params.output_debug_fields) {
@@ -135,6 +141,20 @@ CartInterp::CartInterp(const string &progName,
   }
   _gotConvStrat = false;
 
+  // set up the geometry cache
+  // the debug output depends on the search, so the cache
+  // cannot be used with it
+
+  if (_params.cache_interp_geometry) {
+    if (_params.output_debug_fields || _params.write_search_matrix_files) {
+      cerr << "WARNING - CartInterp" << endl;
+      cerr << "  cache_interp_geometry is ignored if output_debug_fields"
+           << " or write_search_matrix_files is set" << endl;
+    } else {
+      _geomCache = new CartGeomCache(_params);
+    }
+  }
+
   // set up orientation object
 
   if (_params.use_echo_orientation) {
@@ -159,9 +179,13 @@ CartInterp::~CartInterp()
   _freeGridLoc();
   _freeOutputArrays();
   _freeDerivedFields();
+  clearMosaic();
   if (_orient) {
     delete _orient;
   }
+  if (_geomCache) {
+    delete _geomCache;
+  }
 
 }
 
@@ -220,22 +244,6 @@ int CartInterp::interpVol()
     cerr << "  _spansNorth: " << (char *) (_spansNorth? "Y":"N") << endl;
   }
   
-  // compute search matrix angle limits - keep the matrix
-  // as small as possible for efficiency
-  
-  _printRunTime("Cart interp - before computeSearchLimits");
-  _computeSearchLimits();
-  _printRunTime("Computing search limits");
-
-  // fill the search matrix
-
-  if (_params.debug) {
-    cerr << "  Filling search matrix ... " << endl;
-  }
-  _printRunTime("Cart interp - before fillSearchMatrix");
-  _fillSearchMatrix();
-  _printRunTime("Filling search matrix");
-  
   // compute grid locations relative to radar
 
   if (_params.debug) {
@@ -245,6 +253,47 @@ int CartInterp::interpVol()
   _computeGridRelative();
   _printRunTime("Computing grid relative to radar");
 
+  // check for cached geometry for this volume
+  // on a miss, a new table is filled in during the interpolation
+
+  _geomTable = NULL;
+  _geomRecording = false;
+  if (_geomCache) {
+    for (size_t ii = 0; ii < _interpRays.size(); ii++) {
+      _interpRays[ii]->rayIndex = ii;
+    }
+    string key;
+    _buildGeomKey(key);
+    _geomTable = _geomCache->lookup(key, _nPointsVol);
+    if (_geomTable == NULL) {
+      if (_params.debug) {
+        cerr << "  No cached geometry, will compute and save" << endl;
+      }
+      _geomTable = _geomCache->createTable(key, _nPointsVol);
+      _geomRecording = true;
+    }
+  }
+
+  if (_geomTable == NULL || _geomRecording) {
+
+    // compute search matrix angle limits - keep the matrix
+    // as small as possible for efficiency
+    
+    _printRunTime("Cart interp - before computeSearchLimits");
+    _computeSearchLimits();
+    _printRunTime("Computing search limits");
+    
+    // fill the search matrix
+    
+    if (_params.debug) {
+      cerr << "  Filling search matrix ... " << endl;
+    }
+    _printRunTime("Cart interp - before fillSearchMatrix");
+    _fillSearchMatrix();
+    _printRunTime("Filling search matrix");
+
+  }
+
   // determine echo orientation
   // for now this only works in PPI mode
 
@@ -270,12 +319,33 @@ int CartInterp::interpVol()
   _doInterp();
   _printRunTime("Interpolating");
 
+  // save newly computed geometry - the cache takes ownership
+
+  if (_geomRecording) {
+    _geomCache->addTable(_geomTable);
+    _geomRecording = false;
+  }
+  _geomTable = NULL;
+
   // transform for output
   // this will change any transformed fields back to
   // their original form as appropriate
 
   _transformForOutput();
 
+  // in mosaic mode, add this volume to the mosaic
+  // the output is written by writeMosaic()
+
+  if (_params.mosaic_mode) {
+    _addToMosaic();
+    _printRunTime("Adding to mosaic");
+    _freeSearchMatrix();
+    if (_params.free_memory_between_files) {
+      _freeGridLoc();
+    }
+    return 0;
+  }
+
   // compute convective stratiform split
 
   _gotConvStrat = false;
@@ -1685,6 +1755,11 @@ void CartInterp::_interpRow(int iz, int iy)
 
 {
 
+  if (_geomTable && !_geomRecording) {
+    _interpRowFromGeom(iz, iy);
+    return;
+  }
+
   int ptIndex = iz * _nPointsPlane + iy * _gridNx;
 
   for (int ix = 0; ix < _gridNx; ix++, ptIndex++) {
@@ -1938,7 +2013,6 @@ void CartInterp::_interpRow(int iz, int iy)
     double rangeKm = loc->slantRange;
     double dgate = (rangeKm - _startRangeKm) / _gateSpacingKm;
     int igateInner = (int) floor(dgate);
-    int igateOuter = igateInner + 1;
     double wtOuter = dgate - igateInner;
     double wtInner = 1.0 - wtOuter;
     Neighbors wts;
@@ -1996,36 +2070,223 @@ void CartInterp::_interpRow(int iz, int iy)
     wts.ur_inner /= sumWt;
     wts.ur_outer /= sumWt;
 
+    // if caching, save the geometry, and use the saved version
+    // so that later volumes give identical results
+
+    if (_geomRecording) {
+      CartGeomCache::Entry &entry = _geomTable->getEntry(ptIndex);
+      _storeGeomEntry(entry, igateInner, ll, ul, lr, ur, wts);
+      _loadGeomEntry(entry, ll, ul, lr, ur, wts);
+    }
+
     // interpolate fields
 
-    int maxContrib = 0;
-    for (size_t ifield = 0; ifield < _interpFields.size(); ifield++) {
+    _interpGridPt(ptIndex, igateInner, ll, ul, lr, ur, wts);
 
-      int nContrib = 0;
-      if (_interpFields[ifield].isDiscrete || _params.use_nearest_neighbor) {
-        nContrib = _loadNearestGridPt(ifield, ptIndex, igateInner, igateOuter,
-                                      ll, ul, lr, ur, wts);
-      } else if (_interpFields[ifield].fieldFolds) {
-        nContrib = _loadFoldedGridPt(ifield, ptIndex, igateInner, igateOuter,
-                                     ll, ul, lr, ur, wts);
-      } else {
-        nContrib = _loadInterpGridPt(ifield, ptIndex, igateInner, igateOuter,
-                                     ll, ul, lr, ur, wts);
-      }
-      if (nContrib > maxContrib) {
-        maxContrib = nContrib;
-      }
+  } // ix
+
+}
 
-    } // ifield
+////////////////////////////////////////////////////
+// Interpolate a row using the cached geometry
 
-    if (_nContribDebug) {
-      _nContribDebug->data[ptIndex] = maxContrib;
-    }
+void CartInterp::_interpRowFromGeom(int iz, int iy)
+
+{
 
+  int ptIndex = iz * _nPointsPlane + iy * _gridNx;
+  SearchPoint ll, ul, lr, ur;
+  Neighbors wts;
+
+  for (int ix = 0; ix < _gridNx; ix++, ptIndex++) {
+    const CartGeomCache::Entry &entry = _geomTable->getEntry(ptIndex);
+    if (!entry.isValid()) {
+      continue;
+    }
+    _loadGeomEntry(entry, ll, ul, lr, ur, wts);
+    _interpGridPt(ptIndex, entry.igateInner, ll, ul, lr, ur, wts);
   } // ix
 
 }
 
+////////////////////////////////////////////////////
+// Interpolate the fields for a grid point,
+// given the bounding rays and weights
+
+void CartInterp::_interpGridPt(int ptIndex,
+                               int igateInner,
+                               const SearchPoint &ll,
+                               const SearchPoint &ul,
+                               const SearchPoint &lr,
+                               const SearchPoint &ur,
+                               const Neighbors &wts)
+
+{
+
+  int igateOuter = igateInner + 1;
+
+  int maxContrib = 0;
+  for (size_t ifield = 0; ifield < _interpFields.size(); ifield++) {
+    
+    int nContrib = 0;
+    if (_interpFields[ifield].isDiscrete || _params.use_nearest_neighbor) {
+      nContrib = _loadNearestGridPt(ifield, ptIndex, igateInner, igateOuter,
+                                    ll, ul, lr, ur, wts);
+    } else if (_interpFields[ifield].fieldFolds) {
+      nContrib = _loadFoldedGridPt(ifield, ptIndex, igateInner, igateOuter,
+                                   ll, ul, lr, ur, wts);
+    } else {
+      nContrib = _loadInterpGridPt(ifield, ptIndex, igateInner, igateOuter,
+                                   ll, ul, lr, ur, wts);
+    }
+    if (nContrib > maxContrib) {
+      maxContrib = nContrib;
+    }
+    
+  } // ifield
+  
+  if (_nContribDebug) {
+    _nContribDebug->data[ptIndex] = maxContrib;
+  }
+
+}
+
+////////////////////////////////////////////////////
+// Build the key for the geometry cache.
+// This must include everything which affects the
+// search and the weights.
+
+void CartInterp::_buildGeomKey(string &key)
+
+{
+
+  key.clear();
+  CartGeomCache::addToKey(key, string("Radx2Grid-CartGeom-1"));
+  CartGeomCache::addToKey(key, (int) _rhiMode);
+
+  // radar location
+
+  CartGeomCache::addToKey(key, _radarLat);
+  CartGeomCache::addToKey(key, _radarLon);
+  CartGeomCache::addToKey(key, _radarAltKm);
+  CartGeomCache::addToKey(key, (int) _params.override_standard_pseudo_earth_radius);
+  CartGeomCache::addToKey(key, _params.pseudo_earth_radius_ratio);
+
+  // output grid
+
+  CartGeomCache::addToKey(key, (int) _params.grid_projection);
+  CartGeomCache::addToKey(key, _params.grid_rotation);
+  CartGeomCache::addToKey(key, _params.grid_lat1);
+  CartGeomCache::addToKey(key, _params.grid_lat2);
+  CartGeomCache::addToKey(key, (int) _params.grid_pole_is_north);
+  CartGeomCache::addToKey(key, _params.grid_tangent_lat);
+  CartGeomCache::addToKey(key, _params.grid_tangent_lon);
+  CartGeomCache::addToKey(key, _params.grid_central_scale);
+  CartGeomCache::addToKey(key, _params.grid_persp_radius);
+  CartGeomCache::addToKey(key, (int) _params.grid_set_offset_origin);
+  CartGeomCache::addToKey(key, _params.grid_offset_origin_latitude);
+  CartGeomCache::addToKey(key, _params.grid_offset_origin_longitude);
+  CartGeomCache::addToKey(key, _params.grid_false_northing);
+  CartGeomCache::addToKey(key, _params.grid_false_easting);
+  CartGeomCache::addToKey(key, _gridOriginLat);
+  CartGeomCache::addToKey(key, _gridOriginLon);
+  CartGeomCache::addToKey(key, _gridNx);
+  CartGeomCache::addToKey(key, _gridNy);
+  CartGeomCache::addToKey(key, _gridNz);
+  CartGeomCache::addToKey(key, _gridMinx);
+  CartGeomCache::addToKey(key, _gridMiny);
+  CartGeomCache::addToKey(key, _gridDx);
+  CartGeomCache::addToKey(key, _gridDy);
+  for (size_t ii = 0; ii < _gridZLevels.size(); ii++) {
+    CartGeomCache::addToKey(key, _gridZLevels[ii]);
+  }
+
+  // range geometry and beam width
+
+  CartGeomCache::addToKey(key, _startRangeKm);
+  CartGeomCache::addToKey(key, _gateSpacingKm);
+  CartGeomCache::addToKey(key, _beamWidthDegH);
+  CartGeomCache::addToKey(key, _beamWidthDegV);
+  CartGeomCache::addToKey
+    (key, _params.beam_width_fraction_for_data_limit_extension);
+
+  // data sector
+
+  CartGeomCache::addToKey(key, (int) _isSector);
+  CartGeomCache::addToKey(key, (int) _spansNorth);
+  CartGeomCache::addToKey(key, _dataSectorStartAzDeg);
+  CartGeomCache::addToKey(key, _dataSectorEndAzDeg);
+
+  // ray angles, rounded to the tolerance
+
+  double tol = _params.interp_geometry_cache_angle_tolerance_deg;
+  CartGeomCache::addToKey(key, (int) _interpRays.size());
+  for (size_t ii = 0; ii < _interpRays.size(); ii++) {
+    const Ray *ray = _interpRays[ii];
+    CartGeomCache::addAngleToKey(key, ray->el, tol);
+    CartGeomCache::addAngleToKey(key, ray->az, tol);
+    CartGeomCache::addAngleToKey(key, ray->elForLimits, tol);
+    CartGeomCache::addAngleToKey(key, ray->azForLimits, tol);
+  }
+
+}
+
+////////////////////////////////////////////////////
+// Store the geometry for a grid point in a cache entry
+
+void CartInterp::_storeGeomEntry(CartGeomCache::Entry &entry,
+                                 int igateInner,
+                                 const SearchPoint &ll,
+                                 const SearchPoint &ul,
+                                 const SearchPoint &lr,
+                                 const SearchPoint &ur,
+                                 const Neighbors &wts)
+
+{
+
+  entry.rayIndex[0] = (ll.ray? ll.ray->rayIndex : -1);
+  entry.rayIndex[1] = (ul.ray? ul.ray->rayIndex : -1);
+  entry.rayIndex[2] = (lr.ray? lr.ray->rayIndex : -1);
+  entry.rayIndex[3] = (ur.ray? ur.ray->rayIndex : -1);
+  entry.igateInner = igateInner;
+  entry.wts[0] = wts.ll_inner;
+  entry.wts[1] = wts.ll_outer;
+  entry.wts[2] = wts.ul_inner;
+  entry.wts[3] = wts.ul_outer;
+  entry.wts[4] = wts.lr_inner;
+  entry.wts[5] = wts.lr_outer;
+  entry.wts[6] = wts.ur_inner;
+  entry.wts[7] = wts.ur_outer;
+
+}
+
+////////////////////////////////////////////////////
+// Load the geometry for a grid point from a cache entry
+
+void CartInterp::_loadGeomEntry(const CartGeomCache::Entry &entry,
+                                SearchPoint &ll,
+                                SearchPoint &ul,
+                                SearchPoint &lr,
+                                SearchPoint &ur,
+                                Neighbors &wts)
+
+{
+
+  ll.ray = (entry.rayIndex[0] >= 0? _interpRays[entry.rayIndex[0]] : NULL);
+  ul.ray = (entry.rayIndex[1] >= 0? _interpRays[entry.rayIndex[1]] : NULL);
+  lr.ray = (entry.rayIndex[2] >= 0? _interpRays[entry.rayIndex[2]] : NULL);
+  ur.ray = (entry.rayIndex[3] >= 0? _interpRays[entry.rayIndex[3]] : NULL);
+  wts.ll_inner = entry.wts[0];
+  wts.ll_outer = entry.wts[1];
+  wts.ul_inner = entry.wts[2];
+  wts.ul_outer = entry.wts[3];
+  wts.lr_inner = entry.wts[4];
+  wts.lr_outer = entry.wts[5];
+  wts.ur_inner = entry.wts[6];
+  wts.ur_outer = entry.wts[7];
+
+}
+
 ////////////////////////////////////////////
 // load up weights for case where we only
 // have 2 valid rays
@@ -2691,15 +2952,6 @@ void CartInterp::_addMatrixField(DsMdvx &mdvx,
 int CartInterp::_convStratCompute()
 {
 
-  // set the grid in the ConvStratFinder object
-
-  bool isLatLon = (_params.grid_projection == Params::PROJ_LATLON);
-  _convStrat.setGrid(_gridNx, _gridNy,
-                     _gridDx, _gridDy,
-                     _gridMinx, _gridMiny,
-                     _gridZLevels,
-                     isLatLon);
-
   // get the dbz field for ConvStratFinder
 
   string dbzName(_params.conv_strat_dbz_field_name);
@@ -2718,6 +2970,25 @@ int CartInterp::_convStratCompute()
     return -1;
   }
 
+  return _convStratCompute(dbzVals);
+
+}
+
+//////////////////////////////////////////////////
+// Compute convective/stratiform split, given the dbz grid
+
+int CartInterp::_convStratCompute(const fl32 *dbzVals)
+{
+
+  // set the grid in the ConvStratFinder object
+
+  bool isLatLon = (_params.grid_projection == Params::PROJ_LATLON);
+  _convStrat.setGrid(_gridNx, _gridNy,
+                     _gridDx, _gridDy,
+                     _gridMinx, _gridMiny,
+                     _gridZLevels,
+                     isLatLon);
+
   // compute the convective/stratiform partition
   
   if (_convStrat.computeEchoType(dbzVals, missingFl32)) {
@@ -2732,6 +3003,276 @@ int CartInterp::_convStratCompute()
   
 }
 
+//////////////////////////////////////////////////
+// Write out the mosaic, and clear it for the next one.
+// If validTime is 0, the latest volume end time is used.
+// returns 0 on succes, -1 on failure
+
+int CartInterp::writeMosaic(time_t validTime)
+{
+
+  if (_mosaicNRadars == 0) {
+    cerr << "ERROR - CartInterp::writeMosaic" << endl;
+    cerr << "  No volumes in mosaic" << endl;
+    return -1;
+  }
+
+  if (_params.debug) {
+    cerr << "  Writing mosaic, n radars: " << _mosaicNRadars << endl;
+  }
+
+  // compute the final values
+
+  _finishMosaic();
+
+  if (validTime > 0) {
+    _mosaicVol.setEndTime(validTime, 0);
+    if (_mosaicVol.getStartTimeSecs() > validTime) {
+      _mosaicVol.setStartTime(validTime, 0);
+    }
+  }
+
+  // compute convective stratiform split on the mosaic
+
+  _gotConvStrat = false;
+  if (_params.identify_convective_stratiform_split) {
+    string dbzName(_params.conv_strat_dbz_field_name);
+    const fl32 *dbzVals = NULL;
+    for (size_t ii = 0; ii < _mosaicFields.size(); ii++) {
+      if (_mosaicFields[ii]->props.radxName == dbzName) {
+        dbzVals = &_mosaicFields[ii]->val[0];
+        break;
+      }
+    }
+    if (dbzVals == NULL) {
+      cerr << "ERROR - CartInterp::writeMosaic()" << endl;
+      cerr << "  Cannot find dbz field: " << dbzName << endl;
+      cerr << "  conv/strat partition will not be computed" << endl;
+    } else if (_convStratCompute(dbzVals) == 0) {
+      _gotConvStrat = true;
+    }
+  }
+
+  // write out
+
+  int iret = 0;
+  if (_writeMosaicFile()) {
+    cerr << "ERROR - CartInterp::writeMosaic" << endl;
+    cerr << "  Cannot write output file" << endl;
+    iret = -1;
+  }
+  _printRunTime("Writing mosaic");
+
+  clearMosaic();
+  return iret;
+
+}
+
+//////////////////////////////////////////////////
+// Clear the mosaic
+
+void CartInterp::clearMosaic()
+{
+  for (size_t ii = 0; ii < _mosaicFields.size(); ii++) {
+    delete _mosaicFields[ii];
+  }
+  _mosaicFields.clear();
+  _mosaicVol.clear();
+  _mosaicNRadars = 0;
+}
+
+//////////////////////////////////////////////////
+// Add the current volume to the mosaic
+
+void CartInterp::_addToMosaic()
+{
+
+  // metadata - the times span all of the volumes
+
+  if (_mosaicNRadars == 0) {
+    _mosaicVol.copyMeta(_readVol);
+    _mosaicVol.setInstrumentName("Mosaic");
+    _mosaicVol.setSiteName("");
+    _mosaicVol.setLocation(_gridOriginLat, _gridOriginLon, 0.0);
+    _mosaicVol.setHistory("Radx2Grid mosaic of: " +
+                          _readVol.getInstrumentName());
+  } else {
+    if (_readVol.getStartTimeSecs() < _mosaicVol.getStartTimeSecs()) {
+      _mosaicVol.setStartTime(_readVol.getStartTimeSecs(),
+                              _readVol.getStartNanoSecs());
+    }
+    if (_readVol.getEndTimeSecs() > _mosaicVol.getEndTimeSecs()) {
+      _mosaicVol.setEndTime(_readVol.getEndTimeSecs(),
+                            _readVol.getEndNanoSecs());
+    }
+    _mosaicVol.setHistory(_mosaicVol.getHistory() + " " +
+                          _readVol.getInstrumentName());
+  }
+  _mosaicNRadars++;
+
+  if (_params.debug) {
+    cerr << "  Adding to mosaic: " << _readVol.getInstrumentName() << endl;
+  }
+
+  // weight of this radar at each grid point, from the slant range
+
+  vector<fl32> ptWt(_nPointsVol);
+  double scale = _params.mosaic_range_weight_scale_km;
+  int ptIndex = 0;
+  for (int iz = 0; iz < _gridNz; iz++) {
+    for (int iy = 0; iy < _gridNy; iy++) {
+      for (int ix = 0; ix < _gridNx; ix++, ptIndex++) {
+        double rr = _gridLoc[iz][iy][ix]->slantRange / scale;
+        ptWt[ptIndex] = 1.0 / (1.0 + rr * rr);
+      }
+    }
+  }
+
+  // accumulate the fields
+
+  for (size_t ifield = 0; ifield < _interpFields.size(); ifield++) {
+
+    const Field &ifld = _interpFields[ifield];
+    MosaicField *mfld = _getMosaicField(ifld);
+    const fl32 *vals = _outputFields[ifield];
+    fl32 *mval = &mfld->val[0];
+    fl32 *mwt = &mfld->wt[0];
+
+    if (ifld.isDiscrete || ifld.fieldFolds ||
+        _params.mosaic_combine_method == Params::MOSAIC_NEAREST_RADAR) {
+
+      // nearest radar has the highest weight
+      
+      for (int ii = 0; ii < _nPointsVol; ii++) {
+        if (vals[ii] != missingFl32 && ptWt[ii] > mwt[ii]) {
+          mval[ii] = vals[ii];
+          mwt[ii] = ptWt[ii];
+        }
+      }
+
+    } else if (_params.mosaic_combine_method == Params::MOSAIC_MAXIMUM) {
+
+      for (int ii = 0; ii < _nPointsVol; ii++) {
+        if (vals[ii] != missingFl32 &&
+            (mwt[ii] == 0 || vals[ii] > mval[ii])) {
+          mval[ii] = vals[ii];
+          mwt[ii] = ptWt[ii];
+        }
+      }
+
+    } else {
+
+      for (int ii = 0; ii < _nPointsVol; ii++) {
+        if (vals[ii] != missingFl32) {
+          mval[ii] += ptWt[ii] * vals[ii];
+          mwt[ii] += ptWt[ii];
+        }
+      }
+
+    }
+
+  } // ifield
+
+}
+
+//////////////////////////////////////////////////
+// Get the mosaic field matching an interp field,
+// creating it if needed
+
+CartInterp::MosaicField *CartInterp::_getMosaicField(const Field &fld)
+{
+
+  for (size_t ii = 0; ii < _mosaicFields.size(); ii++) {
+    if (_mosaicFields[ii]->props.outputName == fld.outputName) {
+      return _mosaicFields[ii];
+    }
+  }
+
+  MosaicField *mfld = new MosaicField;
+  mfld->props = fld;
+  mfld->val.resize(_nPointsVol, 0.0);
+  mfld->wt.resize(_nPointsVol, 0.0);
+  _mosaicFields.push_back(mfld);
+  return mfld;
+
+}
+
+//////////////////////////////////////////////////
+// Compute the final mosaic values from the accumulated
+// values and weights
+
+void CartInterp::_finishMosaic()
+{
+
+  for (size_t ifield = 0; ifield < _mosaicFields.size(); ifield++) {
+
+    MosaicField *mfld = _mosaicFields[ifield];
+    const Field &props = mfld->props;
+    bool weightedMean =
+      (!props.isDiscrete && !props.fieldFolds &&
+       _params.mosaic_combine_method == Params::MOSAIC_RANGE_WEIGHTED);
+
+    fl32 *mval = &mfld->val[0];
+    fl32 *mwt = &mfld->wt[0];
+    for (int ii = 0; ii < _nPointsVol; ii++) {
+      if (mwt[ii] == 0) {
+        mval[ii] = missingFl32;
+      } else if (weightedMean) {
+        mval[ii] /= mwt[ii];
+      }
+    }
+
+  } // ifield
+
+}
+
+//////////////////////////////////////////////////
+// Write out the mosaic file
+
+int CartInterp::_writeMosaicFile()
+{
+
+  if (_params.debug) {
+    cerr << "  Writing mosaic file ... " << endl;
+  }
+
+  OutputMdv out(_progName, _params);
+  out.setMasterHeader(_mosaicVol);
+  for (size_t ifield = 0; ifield < _mosaicFields.size(); ifield++) {
+    const MosaicField *mfld = _mosaicFields[ifield];
+    const Field &ifld = mfld->props;
+    if (!out.suppressThisField(ifld.outputName)) {
+      out.addField(_mosaicVol, _proj, _gridZLevels,
+                   ifld.outputName, ifld.longName, ifld.units,
+                   ifld.inputDataType,
+                   ifld.inputScale,
+                   ifld.inputOffset,
+                   missingFl32,
+                   &mfld->val[0]);
+    }
+  } // ifield
+
+  // convective stratiform split
+
+  if (_params.identify_convective_stratiform_split && _gotConvStrat) {
+    out.addConvStratFields(_convStrat, _mosaicVol,
+                           _proj, _gridZLevels);
+  }
+
+  // write out file
+  // the radar chunks do not apply to a mosaic
+  
+  if (out.writeVol()) {
+    cerr << "ERROR - CartInterp::_writeMosaicFile" << endl;
+    cerr << "  Cannot write file to output_dir: "
+         << _params.output_dir << endl;
+    return -1;
+  }
+
+  return 0;
+
+}
+
 ///////////////////////////////////////////////////////////////
 // FillSearchLowerLeft thread
 ///////////////////////////////////////////////////////////////
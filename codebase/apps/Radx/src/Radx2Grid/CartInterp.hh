@@ -37,9 +37,11 @@
 #define CartInterp_HH
 
 #include "Interp.hh"
+#include "CartGeomCache.hh"
 #include <toolsa/TaThread.hh>
 #include <toolsa/TaThreadPool.hh>
 #include <radar/ConvStratFinder.hh>
+#include <Radx/RadxVol.hh>
 class DsMdvx;
 class Orient;
 
@@ -74,6 +76,18 @@ public:
 
   void setRhiMode(bool state) { _rhiMode = state; }
   
+  // mosaic mode
+  // If mosaic_mode is set, interpVol() adds the interpolated
+  // volume to the mosaic instead of writing it out.
+  // writeMosaic() writes the combined grid to a single file,
+  // and then clears the mosaic ready for the next one.
+  // If validTime is 0, the latest volume end time is used.
+  // returns 0 on succes, -1 on failure
+
+  int writeMosaic(time_t validTime = 0);
+  void clearMosaic();
+  int getMosaicNRadars() const { return _mosaicNRadars; }
+
 protected:
 private:
 
@@ -182,6 +196,33 @@ private:
   ConvStratFinder _convStrat;
   bool _gotConvStrat;
 
+  // interpolation geometry cache
+  // _geomTable is the table for the current volume.
+  // If _geomRecording is true, the table is being filled in
+  // by the search, otherwise the search is skipped.
+
+  CartGeomCache *_geomCache;
+  CartGeomCache::Table *_geomTable;
+  bool _geomRecording;
+
+  // mosaic accumulation
+  // fields are matched by output name, since the fields
+  // present may differ from one radar to the next.
+  // For the weighted mean, val holds the sum of weight * value
+  // and wt the sum of the weights. For the other methods, val
+  // holds the selected value and wt the weight of the radar
+  // which supplied it.
+
+  class MosaicField {
+  public:
+    Field props;
+    vector<fl32> val;
+    vector<fl32> wt;
+  };
+  vector<MosaicField *> _mosaicFields;
+  RadxVol _mosaicVol; // metadata for output
+  int _mosaicNRadars;
+
   // private methods
 
   void _createThreads();
@@ -244,6 +285,32 @@ private:
   void _interpSingleThreaded();
   void _interpMultiThreaded();
   void _interpRow(int iz, int iy);
+  void _interpRowFromGeom(int iz, int iy);
+
+  void _interpGridPt(int ptIndex,
+                     int igateInner,
+                     const SearchPoint &ll,
+                     const SearchPoint &ul,
+                     const SearchPoint &lr,
+                     const SearchPoint &ur,
+                     const Neighbors &wts);
+
+  void _buildGeomKey(string &key);
+
+  void _storeGeomEntry(CartGeomCache::Entry &entry,
+                       int igateInner,
+                       const SearchPoint &ll,
+                       const SearchPoint &ul,
+                       const SearchPoint &lr,
+                       const SearchPoint &ur,
+                       const Neighbors &wts);
+
+  void _loadGeomEntry(const CartGeomCache::Entry &entry,
+                      SearchPoint &ll,
+                      SearchPoint &ul,
+                      SearchPoint &lr,
+                      SearchPoint &ur,
+                      Neighbors &wts);
 
   void _loadWtsFor2ValidRays(const GridLoc *loc,
                              const SearchPoint &ll,
@@ -307,6 +374,12 @@ private:
                        const string &units);
 
   int _convStratCompute();
+  int _convStratCompute(const fl32 *dbzVals);
+
+  void _addToMosaic();
+  MosaicField *_getMosaicField(const Field &fld);
+  void _finishMosaic();
+  int _writeMosaicFile();
 
   //////////////////////////////////////////////////////////////
   // Classes for threads
@@ -1127,6 +1127,7 @@ Interp::Ray::Ray(RadxRay *ray,
 
   inputRay = ray;
   sweepIndex = isweep;
+  rayIndex = -1;
   inputRay->convertToFl32();
 
   bool ppiMode = true;
@@ -103,6 +103,7 @@ public:
     int nGates;
     fl32 **fldData;
     fl32 *missingVal;
+    int rayIndex; // position in _interpRays, set by CartInterp
   };
 
   // class for output grid locations
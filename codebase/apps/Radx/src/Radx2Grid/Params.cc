@@ -684,6 +684,18 @@
     tt->single_val.i = 300;
     tt++;
     
+    // Parameter 'input_from_shared_memory'
+    // ctype is 'tdrp_bool_t'
+    
+    memset(tt, 0, sizeof(TDRPtable));
+    tt->ptype = BOOL_TYPE;
+    tt->param_name = tdrpStrDup("input_from_shared_memory");
+    tt->descr = tdrpStrDup("Option to read the volumes from shared memory.");
+    tt->help = tdrpStrDup("REALTIME mode only. The upstream app - e.g. RadxConvert with write_to_shared_memory set - places each volume in a shared memory segment, and writes a _latest_data_info file to input_dir giving the segment name. The field data is used in place, without reading a file. The read options which select fields, sweeps and gates are not applied to these volumes, so any selection should be done upstream.");
+    tt->val_offset = (char *) &input_from_shared_memory - &_start_;
+    tt->single_val.b = pFALSE;
+    tt++;
+    
     // Parameter 'start_time'
     // ctype is 'char*'
     
@@ -2946,6 +2958,186 @@
     memset(tt, 0, sizeof(TDRPtable));
     tt->ptype = COMMENT_TYPE;
     tt->param_name = tdrpStrDup("Comment 35");
+    tt->comment_hdr = tdrpStrDup("CACHING THE INTERPOLATION GEOMETRY");
+    tt->comment_text = tdrpStrDup("Applies to INTERP_MODE_CART only. For a fixed radar with a repeating scan strategy, the rays bounding each grid point, and the interpolation weights, are the same from one volume to the next. Computing them - filling the search matrix and locating the neighboring rays for each grid point - is a large part of the interpolation cost. If caching is active, the geometry for a volume is saved in a table keyed on the radar location, the output grid, the range geometry and the ray angles. Subsequent volumes with a matching key skip the search and use the saved table. The cache is not used if output_debug_fields or write_search_matrix_files is true.");
+    tt++;
+    
+    // Parameter 'cache_interp_geometry'
+    // ctype is 'tdrp_bool_t'
+    
+    memset(tt, 0, sizeof(TDRPtable));
+    tt->ptype = BOOL_TYPE;
+    tt->param_name = tdrpStrDup("cache_interp_geometry");
+    tt->descr = tdrpStrDup("Option to cache the interpolation geometry between volumes.");
+    tt->help = tdrpStrDup("The weights are stored as 32-bit floats, so the interpolated values may differ from the un-cached case in the last few bits.");
+    tt->val_offset = (char *) &cache_interp_geometry - &_start_;
+    tt->single_val.b = pFALSE;
+    tt++;
+    
+    // Parameter 'interp_geometry_cache_angle_tolerance_deg'
+    // ctype is 'double'
+    
+    memset(tt, 0, sizeof(TDRPtable));
+    tt->ptype = DOUBLE_TYPE;
+    tt->param_name = tdrpStrDup("interp_geometry_cache_angle_tolerance_deg");
+    tt->descr = tdrpStrDup("Tolerance for matching ray angles in the geometry key (deg).");
+    tt->help = tdrpStrDup("The elevation and azimuth of each ray are rounded to this resolution before being added to the key. Volumes whose ray angles round to the same values share a geometry table, and use the weights computed for the first of those volumes. Set to 0 to require an exact match, in which case only scans with very repeatable pointing will benefit from the cache.");
+    tt->val_offset = (char *) &interp_geometry_cache_angle_tolerance_deg - &_start_;
+    tt->has_min = TRUE;
+    tt->min_val.d = 0;
+    tt->single_val.d = 0.01;
+    tt++;
+    
+    // Parameter 'interp_geometry_cache_max_tables'
+    // ctype is 'int'
+    
+    memset(tt, 0, sizeof(TDRPtable));
+    tt->ptype = INT_TYPE;
+    tt->param_name = tdrpStrDup("interp_geometry_cache_max_tables");
+    tt->descr = tdrpStrDup("Max number of geometry tables held in memory.");
+    tt->help = tdrpStrDup("Each table holds about 52 bytes per output grid point. If a scan strategy alternates between several VCPs, set this to at least the number of VCPs. The least-recently used table is freed when this limit is exceeded.");
+    tt->val_offset = (char *) &interp_geometry_cache_max_tables - &_start_;
+    tt->has_min = TRUE;
+    tt->min_val.i = 1;
+    tt->single_val.i = 4;
+    tt++;
+    
+    // Parameter 'interp_geometry_cache_dir'
+    // ctype is 'char*'
+    
+    memset(tt, 0, sizeof(TDRPtable));
+    tt->ptype = STRING_TYPE;
+    tt->param_name = tdrpStrDup("interp_geometry_cache_dir");
+    tt->descr = tdrpStrDup("Directory for storing geometry tables on disk.");
+    tt->help = tdrpStrDup("If empty, tables are held in memory only and are lost when the app exits. If set, each table is also written to a file in this directory, and on a memory miss the directory is checked before computing the geometry. The files are memory-mapped for reading, so they are shared between processes on the same host. The files are in native byte order and may be deleted at any time.");
+    tt->val_offset = (char *) &interp_geometry_cache_dir - &_start_;
+    tt->single_val.s = tdrpStrDup("");
+    tt++;
+    
+    // Parameter 'Comment 36'
+    
+    memset(tt, 0, sizeof(TDRPtable));
+    tt->ptype = COMMENT_TYPE;
+    tt->param_name = tdrpStrDup("Comment 36");
+    tt->comment_hdr = tdrpStrDup("MOSAIC MODE");
+    tt->comment_text = tdrpStrDup("Applies to INTERP_MODE_CART only. In mosaic mode, volumes from several radars are interpolated onto the same output grid and combined into a single mosaic, which is written to one output file. No per-radar output files are written. The radars are interpolated one at a time, each using the compute threads, and the results are accumulated into the mosaic as each radar is completed.\n\nIn FILELIST mode, all of the files on the command line are combined into a single mosaic.\n\nIn ARCHIVE mode, a mosaic is created at each multiple of mosaic_interval_secs between the start and end times, using the volume closest in time from each of the mosaic_input_dirs.\n\nIn REALTIME mode, a mosaic is created at each multiple of mosaic_interval_secs, after waiting mosaic_realtime_wait_secs for the data to arrive.\n\nThe grid must be fixed, so center_grid_on_radar and override_radar_location must be false. If cache_interp_geometry is true, set interp_geometry_cache_max_tables to at least the number of radars.");
+    tt++;
+    
+    // Parameter 'mosaic_mode'
+    // ctype is 'tdrp_bool_t'
+    
+    memset(tt, 0, sizeof(TDRPtable));
+    tt->ptype = BOOL_TYPE;
+    tt->param_name = tdrpStrDup("mosaic_mode");
+    tt->descr = tdrpStrDup("Option to combine the volumes into a multi-radar mosaic.");
+    tt->help = tdrpStrDup("See the section header above.");
+    tt->val_offset = (char *) &mosaic_mode - &_start_;
+    tt->single_val.b = pFALSE;
+    tt++;
+    
+    // Parameter 'mosaic_input_dirs'
+    // ctype is 'char*'
+    
+    memset(tt, 0, sizeof(TDRPtable));
+    tt->ptype = STRING_TYPE;
+    tt->param_name = tdrpStrDup("mosaic_input_dirs");
+    tt->descr = tdrpStrDup("Input directories for the radars in the mosaic.");
+    tt->help = tdrpStrDup("ARCHIVE and REALTIME modes only. One directory per radar. input_dir is ignored in mosaic mode.");
+    tt->array_offset = (char *) &_mosaic_input_dirs - &_start_;
+    tt->array_n_offset = (char *) &mosaic_input_dirs_n - &_start_;
+    tt->is_array = TRUE;
+    tt->array_len_fixed = FALSE;
+    tt->array_elem_size = sizeof(char*);
+    tt->array_n = 2;
+    tt->array_vals = (tdrpVal_t *)
+        tdrpMalloc(tt->array_n * sizeof(tdrpVal_t));
+      tt->array_vals[0].s = tdrpStrDup("/tmp/radar1");
+      tt->array_vals[1].s = tdrpStrDup("/tmp/radar2");
+    tt++;
+    
+    // Parameter 'mosaic_interval_secs'
+    // ctype is 'int'
+    
+    memset(tt, 0, sizeof(TDRPtable));
+    tt->ptype = INT_TYPE;
+    tt->param_name = tdrpStrDup("mosaic_interval_secs");
+    tt->descr = tdrpStrDup("Time between mosaics (secs).");
+    tt->help = tdrpStrDup("ARCHIVE and REALTIME modes only. Mosaics are created at multiples of this interval.");
+    tt->val_offset = (char *) &mosaic_interval_secs - &_start_;
+    tt->has_min = TRUE;
+    tt->min_val.i = 1;
+    tt->single_val.i = 300;
+    tt++;
+    
+    // Parameter 'mosaic_search_margin_secs'
+    // ctype is 'int'
+    
+    memset(tt, 0, sizeof(TDRPtable));
+    tt->ptype = INT_TYPE;
+    tt->param_name = tdrpStrDup("mosaic_search_margin_secs");
+    tt->descr = tdrpStrDup("Time margin for finding volumes for the mosaic (secs).");
+    tt->help = tdrpStrDup("ARCHIVE and REALTIME modes only. For each mosaic time, the volume closest in time from each input directory is used, provided it is within this margin. Radars with no volume within the margin are left out of the mosaic.");
+    tt->val_offset = (char *) &mosaic_search_margin_secs - &_start_;
+    tt->has_min = TRUE;
+    tt->min_val.i = 0;
+    tt->single_val.i = 300;
+    tt++;
+    
+    // Parameter 'mosaic_realtime_wait_secs'
+    // ctype is 'int'
+    
+    memset(tt, 0, sizeof(TDRPtable));
+    tt->ptype = INT_TYPE;
+    tt->param_name = tdrpStrDup("mosaic_realtime_wait_secs");
+    tt->descr = tdrpStrDup("Wait time before creating a realtime mosaic (secs).");
+    tt->help = tdrpStrDup("REALTIME mode only. The mosaic for a given time is created this number of seconds after that time, to allow the data from all of the radars to arrive.");
+    tt->val_offset = (char *) &mosaic_realtime_wait_secs - &_start_;
+    tt->has_min = TRUE;
+    tt->min_val.i = 0;
+    tt->single_val.i = 60;
+    tt++;
+    
+    // Parameter 'mosaic_combine_method'
+    // ctype is '_mosaic_combine_method_t'
+    
+    memset(tt, 0, sizeof(TDRPtable));
+    tt->ptype = ENUM_TYPE;
+    tt->param_name = tdrpStrDup("mosaic_combine_method");
+    tt->descr = tdrpStrDup("Method for combining the radars at each grid point.");
+    tt->help = tdrpStrDup("MOSAIC_RANGE_WEIGHTED: weighted mean of the radar values, with a weight of 1 / (1 + (r / scale)^2) for a radar at slant range r - see mosaic_range_weight_scale_km. MOSAIC_NEAREST_RADAR: the value from the radar closest to the grid point. MOSAIC_MAXIMUM: the maximum of the radar values. Discrete fields, and fields which fold, always use the value from the nearest radar.");
+    tt->val_offset = (char *) &mosaic_combine_method - &_start_;
+    tt->enum_def.name = tdrpStrDup("mosaic_combine_method_t");
+    tt->enum_def.nfields = 3;
+    tt->enum_def.fields = (enum_field_t *)
+        tdrpMalloc(tt->enum_def.nfields * sizeof(enum_field_t));
+      tt->enum_def.fields[0].name = tdrpStrDup("MOSAIC_RANGE_WEIGHTED");
+      tt->enum_def.fields[0].val = MOSAIC_RANGE_WEIGHTED;
+      tt->enum_def.fields[1].name = tdrpStrDup("MOSAIC_NEAREST_RADAR");
+      tt->enum_def.fields[1].val = MOSAIC_NEAREST_RADAR;
+      tt->enum_def.fields[2].name = tdrpStrDup("MOSAIC_MAXIMUM");
+      tt->enum_def.fields[2].val = MOSAIC_MAXIMUM;
+    tt->single_val.e = MOSAIC_RANGE_WEIGHTED;
+    tt++;
+    
+    // Parameter 'mosaic_range_weight_scale_km'
+    // ctype is 'double'
+    
+    memset(tt, 0, sizeof(TDRPtable));
+    tt->ptype = DOUBLE_TYPE;
+    tt->param_name = tdrpStrDup("mosaic_range_weight_scale_km");
+    tt->descr = tdrpStrDup("Range scale for MOSAIC_RANGE_WEIGHTED (km).");
+    tt->help = tdrpStrDup("A radar at this slant range from a grid point has half the weight of a radar located at the grid point.");
+    tt->val_offset = (char *) &mosaic_range_weight_scale_km - &_start_;
+    tt->has_min = TRUE;
+    tt->min_val.d = 0.001;
+    tt->single_val.d = 100;
+    tt++;
+    
+    // Parameter 'Comment 37'
+    
+    memset(tt, 0, sizeof(TDRPtable));
+    tt->ptype = COMMENT_TYPE;
+    tt->param_name = tdrpStrDup("Comment 37");
     tt->comment_hdr = tdrpStrDup("INTERPOLATION FOR SATELLITE DATA");
     tt->comment_text = tdrpStrDup("Satellite interpolation uses the reorder params above, plus those in this section.");
     tt++;
@@ -2974,11 +3166,11 @@
     tt->single_val.b = pFALSE;
     tt++;
     
-    // Parameter 'Comment 36'
+    // Parameter 'Comment 38'
     
     memset(tt, 0, sizeof(TDRPtable));
     tt->ptype = COMMENT_TYPE;
-    tt->param_name = tdrpStrDup("Comment 36");
+    tt->param_name = tdrpStrDup("Comment 38");
     tt->comment_hdr = tdrpStrDup("OPTION TO WRITE SEARCH MATRIX FILES");
     tt->comment_text = tdrpStrDup("This is for debugging purposes only. The search matrix data will be written to MDV files that can then be viewed in CIDD or JAZZ.");
     tt++;
@@ -3007,11 +3199,11 @@
     tt->single_val.s = tdrpStrDup("./mdv/search_matrix");
     tt++;
     
-    // Parameter 'Comment 37'
+    // Parameter 'Comment 39'
     
     memset(tt, 0, sizeof(TDRPtable));
     tt->ptype = COMMENT_TYPE;
-    tt->param_name = tdrpStrDup("Comment 37");
+    tt->param_name = tdrpStrDup("Comment 39");
     tt->comment_hdr = tdrpStrDup("OPTION TO IDENTIFY THE CONVECTIVE/STRATIFORM SPLIT");
     tt->comment_text = tdrpStrDup("Applies only to INTERP_MODE_CART.");
     tt++;
@@ -3184,11 +3376,11 @@
     tt->single_val.b = pFALSE;
     tt++;
     
-    // Parameter 'Comment 38'
+    // Parameter 'Comment 40'
     
     memset(tt, 0, sizeof(TDRPtable));
     tt->ptype = COMMENT_TYPE;
-    tt->param_name = tdrpStrDup("Comment 38");
+    tt->param_name = tdrpStrDup("Comment 40");
     tt->comment_hdr = tdrpStrDup("INTERPOLATION USING REORDER METHOD");
     tt->comment_text = tdrpStrDup("!!!!!! WARNING - IMPORTANT NOTE - this mode should only be used for mobile platforms. Use INTERP_MODE_CART for all fixed platforms - it is much more robust and gives much better results !!!!!!!");
     tt++;
@@ -3325,11 +3517,11 @@
     tt->single_val.b = pFALSE;
     tt++;
     
-    // Parameter 'Comment 39'
+    // Parameter 'Comment 41'
     
     memset(tt, 0, sizeof(TDRPtable));
     tt->ptype = COMMENT_TYPE;
-    tt->param_name = tdrpStrDup("Comment 39");
+    tt->param_name = tdrpStrDup("Comment 41");
     tt->comment_hdr = tdrpStrDup("OPTION TO SET BOUNDS ON SELECTED FIELDS");
     tt->comment_text = tdrpStrDup("");
     tt++;
@@ -3390,11 +3582,11 @@
       tt->struct_vals[5].d = 50;
     tt++;
     
-    // Parameter 'Comment 40'
+    // Parameter 'Comment 42'
     
     memset(tt, 0, sizeof(TDRPtable));
     tt->ptype = COMMENT_TYPE;
-    tt->param_name = tdrpStrDup("Comment 40");
+    tt->param_name = tdrpStrDup("Comment 42");
     tt->comment_hdr = tdrpStrDup("USE ECHO ORIENTATION TO INFORM INTERPOLATION GEOMETRY");
     tt->comment_text = tdrpStrDup("Vertically-oriented echoes (convective) should be interpolated in the vertical. Horizontally-oriented echoes (stratiform, bright-band, anvil) should be interpolated in the horizontal. This attempts to prevent the typical ringing behavior we see in Cartesian products in regionis with layered structures, for example anvils.");
     tt++;
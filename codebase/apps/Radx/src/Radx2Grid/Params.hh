@@ -127,6 +127,12 @@ public:
     NETCDF4 = 3
   } netcdf_style_t;
 
+  typedef enum {
+    MOSAIC_RANGE_WEIGHTED = 0,
+    MOSAIC_NEAREST_RADAR = 1,
+    MOSAIC_MAXIMUM = 2
+  } mosaic_combine_method_t;
+
   // struct typedefs
 
   typedef struct {
@@ -506,6 +512,8 @@ public:
 
   int max_realtime_data_age_secs;
 
+  tdrp_bool_t input_from_shared_memory;
+
   char* start_time;
 
   char* end_time;
@@ -772,6 +780,29 @@ public:
 
   int n_compute_threads;
 
+  tdrp_bool_t cache_interp_geometry;
+
+  double interp_geometry_cache_angle_tolerance_deg;
+
+  int interp_geometry_cache_max_tables;
+
+  char* interp_geometry_cache_dir;
+
+  tdrp_bool_t mosaic_mode;
+
+  char* *_mosaic_input_dirs;
+  int mosaic_input_dirs_n;
+
+  int mosaic_interval_secs;
+
+  int mosaic_search_margin_secs;
+
+  int mosaic_realtime_wait_secs;
+
+  mosaic_combine_method_t mosaic_combine_method;
+
+  double mosaic_range_weight_scale_km;
+
   tdrp_bool_t sat_data_invert_in_range;
 
   tdrp_bool_t sat_data_set_range_geom_from_fields;
@@ -854,7 +885,7 @@ private:
 
   void _init();
 
-  mutable TDRPtable _table[214];
+  mutable TDRPtable _table[228];
 
   const char *_className;
 
@@ -109,6 +109,46 @@ Radx2Grid::Radx2Grid(int argc, char **argv)
     }
   }
 
+  // check mosaic mode settings
+
+  if (_params.mosaic_mode) {
+    if (_params.interp_mode != Params::INTERP_MODE_CART) {
+      cerr << "ERROR: " << _progName << endl;
+      cerr << "  mosaic_mode requires interp_mode INTERP_MODE_CART" << endl;
+      OK = FALSE;
+    }
+    if (_params.center_grid_on_radar ||
+        _params.override_radar_location) {
+      cerr << "ERROR: " << _progName << endl;
+      cerr << "  mosaic_mode requires a fixed grid" << endl;
+      cerr << "  center_grid_on_radar and override_radar_location"
+           << " must be false" << endl;
+      OK = FALSE;
+    }
+    if (_params.output_format == Params::CEDRIC) {
+      cerr << "ERROR: " << _progName << endl;
+      cerr << "  mosaic_mode does not support CEDRIC output" << endl;
+      OK = FALSE;
+    }
+    if (_params.mode != Params::FILELIST &&
+        _params.mosaic_input_dirs_n < 1) {
+      cerr << "ERROR: " << _progName << endl;
+      cerr << "  mosaic_mode requires at least 1 entry"
+           << " in mosaic_input_dirs" << endl;
+      OK = FALSE;
+    }
+  }
+
+  // shared memory input is only for realtime
+
+  if (_params.input_from_shared_memory &&
+      (_params.mode != Params::REALTIME || _params.mosaic_mode)) {
+    cerr << "ERROR: " << _progName << endl;
+    cerr << "  input_from_shared_memory requires REALTIME mode,"
+         << " without mosaic_mode" << endl;
+    OK = FALSE;
+  }
+
   // volume number
 
   if (_params.override_volume_number ||
@@ -184,6 +224,14 @@ int Radx2Grid::_runFilelist()
 
   }
 
+  // in mosaic mode, the files are combined into a single mosaic
+
+  if (_params.mosaic_mode) {
+    if (_writeMosaic(0)) {
+      iret = -1;
+    }
+  }
+
   return iret;
 
 }
@@ -227,6 +275,10 @@ int Radx2Grid::_runArchive()
     cerr << "  End time: " << RadxTime::strm(endTime) << endl;
   }
 
+  if (_params.mosaic_mode) {
+    return _runMosaicArchive(startTime, endTime);
+  }
+
   // get the files to be processed
   
   RadxTimeList tlist;
@@ -277,6 +329,10 @@ int Radx2Grid::_runRealtime()
                 _params.procmap_register_interval);
   PMU_auto_register("Init realtime mode");
 
+  if (_params.mosaic_mode) {
+    return _runMosaicRealtime();
+  }
+
   // watch for new data to arrive
 
   LdataInfo ldata(_params.input_dir,
@@ -288,7 +344,12 @@ int Radx2Grid::_runRealtime()
     ldata.readBlocking(_params.max_realtime_data_age_secs,
                        1000, PMU_auto_register);
     
-    const string path = ldata.getDataPath();
+    // for shared memory, the relative path is the segment name
+    
+    string path = ldata.getDataPath();
+    if (_params.input_from_shared_memory) {
+      path = ldata.getRelDataPath();
+    }
     if (_processFile(path)) {
       iret = -1;
     }
@@ -298,6 +359,149 @@ int Radx2Grid::_runRealtime()
 
 }
 
+//////////////////////////////////////////////////
+// Run mosaics in archive mode
+// A mosaic is created at each multiple of mosaic_interval_secs
+// between the start and end times
+
+int Radx2Grid::_runMosaicArchive(time_t startTime, time_t endTime)
+{
+
+  int interval = _params.mosaic_interval_secs;
+  time_t mosaicTime = ((startTime + interval - 1) / interval) * interval;
+
+  int iret = 0;
+  for (; mosaicTime <= endTime; mosaicTime += interval) {
+    if (_processMosaic(mosaicTime)) {
+      iret = -1;
+    }
+  }
+
+  return iret;
+
+}
+
+//////////////////////////////////////////////////
+// Run mosaics in realtime mode
+// A mosaic is created at each multiple of mosaic_interval_secs,
+// mosaic_realtime_wait_secs after that time
+
+int Radx2Grid::_runMosaicRealtime()
+{
+
+  int interval = _params.mosaic_interval_secs;
+  int wait = _params.mosaic_realtime_wait_secs;
+  time_t mosaicTime = ((time(NULL) - wait) / interval + 1) * interval;
+
+  int iret = 0;
+
+  while (true) {
+
+    // wait for the data to arrive
+
+    while (time(NULL) < mosaicTime + wait) {
+      PMU_auto_register("Waiting for mosaic time");
+      umsleep(1000);
+    }
+
+    if (_processMosaic(mosaicTime)) {
+      iret = -1;
+    }
+
+    // move to the next time - if we have fallen behind,
+    // skip to the latest time which is ready
+
+    mosaicTime += interval;
+    time_t latestTime = ((time(NULL) - wait) / interval) * interval;
+    if (mosaicTime < latestTime) {
+      if (_params.debug) {
+        cerr << "WARNING - Radx2Grid::_runMosaicRealtime" << endl;
+        cerr << "  Falling behind, skipping to: "
+             << RadxTime::strm(latestTime) << endl;
+      }
+      mosaicTime = latestTime;
+    }
+
+  }
+
+  return iret;
+
+}
+
+//////////////////////////////////////////////////
+// Create the mosaic for a given time, using the volume
+// closest in time from each input dir
+// Returns 0 on success, -1 on failure
+
+int Radx2Grid::_processMosaic(time_t mosaicTime)
+{
+
+  PMU_auto_register("Processing mosaic");
+
+  if (_params.debug) {
+    cerr << "INFO - Radx2Grid::_processMosaic" << endl;
+    cerr << "  Mosaic time: " << RadxTime::strm(mosaicTime) << endl;
+  }
+
+  int iret = 0;
+  for (int idir = 0; idir < _params.mosaic_input_dirs_n; idir++) {
+
+    const char *inputDir = _params._mosaic_input_dirs[idir];
+    RadxTimeList tlist;
+    tlist.setDir(inputDir);
+    tlist.setModeClosest(mosaicTime, _params.mosaic_search_margin_secs);
+    if (_params.aggregate_sweep_files_on_read) {
+      tlist.setReadAggregateSweeps(true);
+    }
+    if (tlist.compile()) {
+      cerr << "ERROR - Radx2Grid::_processMosaic()" << endl;
+      cerr << "  Cannot compile time list, dir: " << inputDir << endl;
+      cerr << tlist.getErrStr() << endl;
+      iret = -1;
+      continue;
+    }
+
+    const vector<string> &paths = tlist.getPathList();
+    if (paths.size() < 1) {
+      if (_params.debug) {
+        cerr << "WARNING - Radx2Grid::_processMosaic()" << endl;
+        cerr << "  No data within margin, dir: " << inputDir << endl;
+      }
+      continue;
+    }
+
+    if (_processFile(paths[0])) {
+      iret = -1;
+    }
+
+  } // idir
+
+  if (_writeMosaic(mosaicTime)) {
+    iret = -1;
+  }
+
+  return iret;
+
+}
+
+//////////////////////////////////////////////////
+// Write out the mosaic
+// If mosaicTime is 0, the latest volume end time is used.
+// Returns 0 on success, -1 on failure
+
+int Radx2Grid::_writeMosaic(time_t mosaicTime)
+{
+
+  if (_cartInterp == NULL || _cartInterp->getMosaicNRadars() == 0) {
+    cerr << "ERROR - Radx2Grid::_writeMosaic()" << endl;
+    cerr << "  No volumes found for mosaic" << endl;
+    return -1;
+  }
+
+  return _cartInterp->writeMosaic(mosaicTime);
+
+}
+
 //////////////////////////////////////////////////
 // Process a file
 // Returns 0 on success, -1 on failure
@@ -308,9 +512,11 @@ int Radx2Grid::_processFile(const string &filePath)
   PMU_auto_register("Processing file");
 
   // ensure memory is freed up
+  // the volume must be cleared before detaching from shared memory
   
   _readVol.clear();
   _freeInterpRays();
+  _readShm.detach();
 
   // check file name
   
@@ -428,6 +634,7 @@ int Radx2Grid::_processFile(const string &filePath)
   if (_params.free_memory_between_files) {
     _readVol.clear();
     _freeInterpRays();
+    _readShm.detach();
   }
 
   return 0;
@@ -441,17 +648,34 @@ int Radx2Grid::_processFile(const string &filePath)
 int Radx2Grid::_readFile(const string &filePath)
 {
 
-  GenericRadxFile inFile;
-  _setupRead(inFile);
-  
-  // read in file
-  
-  if (inFile.readFromPath(filePath, _readVol)) {
-    cerr << "ERROR - Radx2Grid::_readFile" << endl;
-    cerr << inFile.getErrStr() << endl;
-    return -1;
+  if (_params.input_from_shared_memory) {
+
+    // attach to volume in shared memory
+    // the path is the segment name
+
+    _readShm.setDebug(_params.debug >= Params::DEBUG_VERBOSE);
+    if (_readShm.attach(filePath, _readVol)) {
+      cerr << "ERROR - Radx2Grid::_readFile" << endl;
+      cerr << _readShm.getErrStr() << endl;
+      return -1;
+    }
+    _readPaths.clear();
+
+  } else {
+
+    GenericRadxFile inFile;
+    _setupRead(inFile);
+    
+    // read in file
+    
+    if (inFile.readFromPath(filePath, _readVol)) {
+      cerr << "ERROR - Radx2Grid::_readFile" << endl;
+      cerr << inFile.getErrStr() << endl;
+      return -1;
+    }
+    _readPaths = inFile.getReadPaths();
+
   }
-  _readPaths = inFile.getReadPaths();
 
   // convert to fl32
 
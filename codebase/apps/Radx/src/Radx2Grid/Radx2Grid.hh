@@ -53,6 +53,7 @@
 #include <toolsa/TaArray.hh>
 #include <radar/NoiseLocator.hh>
 #include <Radx/RadxVol.hh>
+#include <Radx/RadxVolShm.hh>
 #include <Mdv/MdvxProj.hh>
 class RadxFile;
 class RadxRay;
@@ -90,6 +91,7 @@ private:
   // input data
   
   vector<string> _readPaths;
+  RadxVolShm _readShm; // must outlive _readVol
   RadxVol _readVol;
   bool _rhiMode;
   int _volNum;
@@ -116,6 +118,10 @@ private:
   int _runFilelist();
   int _runArchive();
   int _runRealtime();
+  int _runMosaicArchive(time_t startTime, time_t endTime);
+  int _runMosaicRealtime();
+  int _processMosaic(time_t mosaicTime);
+  int _writeMosaic(time_t mosaicTime);
   void _setupRead(RadxFile &file);
   int _processFile(const string &filePath);
   int _readFile(const string &filePath);
@@ -71,7 +71,6 @@ ReorderInterp::ReorderInterp(const string &progName,
   _zSearchRatio = _params.reorder_z_search_ratio;
 
   _kdTree = NULL;
-  _kdMat = NULL;
 
   _tagStartRangeKm = -9999;
   _tagGateSpacingKm = -9999;
@@ -117,8 +116,6 @@ ReorderInterp::~ReorderInterp()
 void ReorderInterp::_freeThreads()
 {
 
-  pthread_mutex_destroy(&_kdTreeMutex);
-  
   // NOTE - thread pools free their threads in the destructor
 
 }
@@ -255,10 +252,6 @@ void ReorderInterp::_initGrid()
 void ReorderInterp::_createThreads()
 {
 
-  // initialize mutex for kd tree since it is not thread safe
-
-  pthread_mutex_init(&_kdTreeMutex, NULL);
-  
   // initialize thread pool for interpolation
   // use same number of threads as vert levels
   // since we compute a plane in each thread
@@ -574,6 +567,8 @@ void ReorderInterp::_computeGridRelRow(int iz, int iy, GridLoc **locIn)
 void ReorderInterp::_buildKdTree()
 {
 
+  vector<float> kdCoords;
+
   for (size_t ipt = 0; ipt < _radarPoints.size(); ipt++) {
     
     radar_point_t radarPt = _radarPoints[ipt];
@@ -584,23 +579,16 @@ void ReorderInterp::_buildKdTree()
     double xx = radarPt.xx;
     double yy = radarPt.yy;
 
-    KD_real *kdPt = new KD_real[KD_DIM];
-    kdPt[0] = radarPt.zz / _zSearchRatio;
-    kdPt[1] = yy;
-    kdPt[2] = xx;
-    _kdVec.push_back(kdPt);
+    kdCoords.push_back(radarPt.zz / _zSearchRatio);
+    kdCoords.push_back(yy);
+    kdCoords.push_back(xx);
     _tagPoints.push_back(radarPt);
       
   } // ipt
   
-  // create array of pointers to the pts in the vector
+  // create the tree - this copies the points
   
-  _kdMat = new KD_real*[_kdVec.size()];
-  for (size_t ii = 0; ii < _kdVec.size(); ii++) {
-    _kdMat[ii] = _kdVec[ii];
-  }
-  
-  _kdTree = new KD_tree((const KD_real **) _kdMat, _kdVec.size(), KD_DIM);
+  _kdTree = new KD_flat_tree(kdCoords.data(), _tagPoints.size(), KD_DIM);
   _printRunTime("building KD tree");
 
   
@@ -614,14 +602,6 @@ void ReorderInterp::_freeKdTree()
 
   delete _kdTree;
   _kdTree = NULL;
-  
-  delete[] _kdMat;
-  _kdMat = NULL;
-  
-  for (size_t ii = 0; ii < _kdVec.size(); ii++) {
-    delete[] _kdVec[ii];
-  }
-  _kdVec.clear();
   _tagPoints.clear();
 
 }
@@ -729,11 +709,9 @@ void ReorderInterp::_interpPlane(int iz)
     _computeGridRelRow(iz, iy, gridLoc[iy]);
   }
 
-  // copy the KD tree
+  // the KD tree queries are thread safe, so the tree is shared
 
-  pthread_mutex_lock(&_kdTreeMutex);
-  KD_tree kdTree(*_kdTree);
-  pthread_mutex_unlock(&_kdTreeMutex);
+  const KD_flat_tree &kdTree = *_kdTree;
   
   // init
   
@@ -742,8 +720,8 @@ void ReorderInterp::_interpPlane(int iz)
   TaArray<int> tagIndexes_;
   int *tagIndexes = tagIndexes_.alloc(nNeighbors);
   
-  TaArray<KD_real> distSq_;
-  KD_real *distSq = distSq_.alloc(nNeighbors);
+  TaArray<float> distSq_;
+  float *distSq = distSq_.alloc(nNeighbors);
 
   // create a vector of neighbor details, one for each
   // point in the row
@@ -766,7 +744,7 @@ void ReorderInterp::_interpPlane(int iz)
       
       // set the query location
       
-      KD_real queryLoc[KD_DIM];
+      float queryLoc[KD_DIM];
       queryLoc[0] = neighborProps->loc->zz / _zSearchRatio;
       queryLoc[1] = neighborProps->loc->yyInstr;
       queryLoc[2] = neighborProps->loc->xxInstr;
@@ -780,12 +758,10 @@ void ReorderInterp::_interpPlane(int iz)
       
       kdTree.nnquery(queryLoc, // query location
                      1, // get only 1 point
-                     KD_EUCLIDEAN, // search metric
-                     1, // Minkowski parameter
                      tagIndexes, // out: indices of nearest nbrs
                      distSq); // out: squares of distances of nbrs
 
-      if (tagIndexes[0] >= (int) _tagPoints.size()) {
+      if (tagIndexes[0] < 0 || tagIndexes[0] >= (int) _tagPoints.size()) {
         continue;
       }
       const radar_point_t &closestPt = _tagPoints[tagIndexes[0]];
@@ -809,8 +785,6 @@ void ReorderInterp::_interpPlane(int iz)
       
       kdTree.nnquery(queryLoc, // query location
                      nNeighbors, // number of neighbors to search for
-                     KD_EUCLIDEAN, // search metric
-                     1, // Minkowski parameter
                      tagIndexes, // out: indices of nearest nbrs
                      distSq); // out: squares of distances of nbrs
       
@@ -38,7 +38,7 @@
 #define ReorderInterp_HH
 
 #include "Interp.hh"
-#include <kd/kd.hh>
+#include <kd/kd_flat.hh>
 #include <iostream>
 #include <toolsa/TaThread.hh>
 #include <toolsa/TaThreadPool.hh>
@@ -102,9 +102,7 @@ private:
   
   static const int KD_DIM = 3;
   
-  vector<KD_real *> _kdVec;
-  KD_real **_kdMat;
-  KD_tree *_kdTree;
+  KD_flat_tree *_kdTree;
 
   // tag gates - use to identify rays closest to grid points
 
@@ -219,10 +217,6 @@ private:
   // instantiate thread pool for interpolation
   TaThreadPool _threadPoolInterp;
 
-  // threading control
-  
-  pthread_mutex_t _kdTreeMutex;
-  
 
 };
 
@@ -69,7 +69,6 @@ SatInterp::SatInterp(const string &progName,
   _zSearchRatio = _params.reorder_z_search_ratio;
 
   _kdTree = NULL;
-  _kdMat = NULL;
 
   _tagStartRangeKm = -9999;
   _tagGateSpacingKm = -9999;
@@ -95,7 +94,6 @@ SatInterp::~SatInterp()
   // threading
 
   _freeThreads();
-  pthread_mutex_destroy(&_kdTreeMutex);
 
   // free up grid
 
@@ -237,10 +235,6 @@ void SatInterp::_initGrid()
 void SatInterp::_createThreads()
 {
 
-  // initialize compute object
-
-  pthread_mutex_init(&_kdTreeMutex, NULL);
-  
   // initialize thread pool for grid relative to radar
 
   for (int ii = 0; ii < _params.n_compute_threads; ii++) {
@@ -553,6 +547,8 @@ void SatInterp::_computeGridRelRow(int iz, int iy)
 void SatInterp::_buildKdTree()
 {
 
+  vector<float> kdCoords;
+
   for (size_t ipt = 0; ipt < _instrPoints.size(); ipt++) {
     
     instr_point_t instrPt = _instrPoints[ipt];
@@ -563,23 +559,16 @@ void SatInterp::_buildKdTree()
     double xx = instrPt.xx;
     double yy = instrPt.yy;
 
-    KD_real *kdPt = new KD_real[KD_DIM];
-    kdPt[0] = instrPt.zz / _zSearchRatio;
-    kdPt[1] = yy;
-    kdPt[2] = xx;
-    _kdVec.push_back(kdPt);
+    kdCoords.push_back(instrPt.zz / _zSearchRatio);
+    kdCoords.push_back(yy);
+    kdCoords.push_back(xx);
     _tagPoints.push_back(instrPt);
       
   } // ipt
   
-  // create array of pointers to the pts in the vector
-  
-  _kdMat = new KD_real*[_kdVec.size()];
-  for (size_t ii = 0; ii < _kdVec.size(); ii++) {
-    _kdMat[ii] = _kdVec[ii];
-  }
+  // create the tree - this copies the points
   
-  _kdTree = new KD_tree((const KD_real **) _kdMat, _kdVec.size(), KD_DIM);
+  _kdTree = new KD_flat_tree(kdCoords.data(), _tagPoints.size(), KD_DIM);
   _printRunTime("building KD tree");
 
   
@@ -593,14 +582,6 @@ void SatInterp::_freeKdTree()
 
   delete _kdTree;
   _kdTree = NULL;
-  
-  delete[] _kdMat;
-  _kdMat = NULL;
-  
-  for (size_t ii = 0; ii < _kdVec.size(); ii++) {
-    delete[] _kdVec[ii];
-  }
-  _kdVec.clear();
   _tagPoints.clear();
 
 }
@@ -699,11 +680,9 @@ void SatInterp::_interpPlane(int iz)
 
 {
 
-  // copy the KD tree
+  // the KD tree queries are thread safe, so the tree is shared
 
-  pthread_mutex_lock(&_kdTreeMutex);
-  KD_tree kdTree(*_kdTree);
-  pthread_mutex_unlock(&_kdTreeMutex);
+  const KD_flat_tree &kdTree = *_kdTree;
   
   // init
   
@@ -712,8 +691,8 @@ void SatInterp::_interpPlane(int iz)
   TaArray<int> tagIndexes_;
   int *tagIndexes = tagIndexes_.alloc(nNeighbors);
   
-  TaArray<KD_real> distSq_;
-  KD_real *distSq = distSq_.alloc(nNeighbors);
+  TaArray<float> distSq_;
+  float *distSq = distSq_.alloc(nNeighbors);
 
   // create a vector of neighbor details, one for each
   // point in the row
@@ -734,7 +713,7 @@ void SatInterp::_interpPlane(int iz)
       
       // set the query location
       
-      KD_real queryLoc[KD_DIM];
+      float queryLoc[KD_DIM];
       queryLoc[0] = neighborProps->loc->zzInstr / _zSearchRatio;
       queryLoc[1] = neighborProps->loc->yyInstr;
       queryLoc[2] = neighborProps->loc->xxInstr;
@@ -751,8 +730,6 @@ void SatInterp::_interpPlane(int iz)
 
       kdTree.nnquery(queryLoc, // query location
                      nNeighbors, // number of neighbors to search for
-                     KD_EUCLIDEAN, // search metric
-                     1, // Minkowski parameter
                      tagIndexes, // out: indices of nearest nbrs
                      distSq); // out: squares of distances of nbrs
       
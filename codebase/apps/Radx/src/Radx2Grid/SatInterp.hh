@@ -37,7 +37,7 @@
 #define SatInterp_HH
 
 #include "Interp.hh"
-#include <kd/kd.hh>
+#include <kd/kd_flat.hh>
 #include <iostream>
 #include <toolsa/TaThread.hh>
 #include <toolsa/TaThreadPool.hh>
@@ -99,9 +99,7 @@ private:
   
   static const int KD_DIM = 3;
   
-  vector<KD_real *> _kdVec;
-  KD_real **_kdMat;
-  KD_tree *_kdTree;
+  KD_flat_tree *_kdTree;
 
   // tag gates - use to identify rays closest to grid points
 
@@ -213,10 +211,6 @@ private:
   // instantiate thread pool for interpolation
   TaThreadPool _threadPoolInterp;
 
-  // threading - mutex for KdTree, since it is not thread safe
-  
-  pthread_mutex_t _kdTreeMutex;
-  
 };
 
 #endif
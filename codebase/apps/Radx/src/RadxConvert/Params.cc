@@ -651,6 +651,20 @@
     tt->single_val.e = REALTIME;
     tt++;
     
+    // Parameter 'n_parallel_files'
+    // ctype is 'int'
+    
+    memset(tt, 0, sizeof(TDRPtable));
+    tt->ptype = INT_TYPE;
+    tt->param_name = tdrpStrDup("n_parallel_files");
+    tt->descr = tdrpStrDup("Number of files to convert in parallel.");
+    tt->help = tdrpStrDup("ARCHIVE and FILELIST modes only. If greater than 1, each file is read, converted and written in a separate child process, with up to this many children running at a time. When writing compressed CfRadial files, the run time is generally dominated by deflating the fields, and the NetCDF library will only compress one field at a time in a process. Running several conversions in parallel makes use of multiple cores. Does not apply if aggregate_all_files_on_read is set. If autoincrement_volume_number is set, volume numbers are assigned in file order, including files which are skipped on read. Must be 1 if write_to_shared_memory is set, since the shared memory segments are published and evicted by a single process.");
+    tt->val_offset = (char *) &n_parallel_files - &_start_;
+    tt->has_min = TRUE;
+    tt->min_val.i = 1;
+    tt->single_val.i = 1;
+    tt++;
+    
     // Parameter 'max_realtime_data_age_secs'
     // ctype is 'int'
     
@@ -3039,6 +3053,54 @@
     tt->single_val.i = 4;
     tt++;
     
+    // Parameter 'output_chunking_mode'
+    // ctype is '_chunking_mode_t'
+    
+    memset(tt, 0, sizeof(TDRPtable));
+    tt->ptype = ENUM_TYPE;
+    tt->param_name = tdrpStrDup("output_chunking_mode");
+    tt->descr = tdrpStrDup("Chunk shape for compressed field variables.");
+    tt->help = tdrpStrDup("Applies to NetCDF4 only. CHUNKING_SWEEP: each chunk holds the max number of rays in any sweep by all gates. This suits reading the data one sweep at a time. CHUNKING_N_RAYS: each chunk holds output_chunk_n_rays rays by all gates. CHUNKING_DEFAULT: the NetCDF library chooses the chunk shape. Chunks are limited to about 4 MB.");
+    tt->val_offset = (char *) &output_chunking_mode - &_start_;
+    tt->enum_def.name = tdrpStrDup("chunking_mode_t");
+    tt->enum_def.nfields = 3;
+    tt->enum_def.fields = (enum_field_t *)
+        tdrpMalloc(tt->enum_def.nfields * sizeof(enum_field_t));
+      tt->enum_def.fields[0].name = tdrpStrDup("CHUNKING_DEFAULT");
+      tt->enum_def.fields[0].val = CHUNKING_DEFAULT;
+      tt->enum_def.fields[1].name = tdrpStrDup("CHUNKING_SWEEP");
+      tt->enum_def.fields[1].val = CHUNKING_SWEEP;
+      tt->enum_def.fields[2].name = tdrpStrDup("CHUNKING_N_RAYS");
+      tt->enum_def.fields[2].val = CHUNKING_N_RAYS;
+    tt->single_val.e = CHUNKING_SWEEP;
+    tt++;
+    
+    // Parameter 'output_chunk_n_rays'
+    // ctype is 'int'
+    
+    memset(tt, 0, sizeof(TDRPtable));
+    tt->ptype = INT_TYPE;
+    tt->param_name = tdrpStrDup("output_chunk_n_rays");
+    tt->descr = tdrpStrDup("Number of rays per chunk for CHUNKING_N_RAYS.");
+    tt->help = tdrpStrDup("");
+    tt->val_offset = (char *) &output_chunk_n_rays - &_start_;
+    tt->has_min = TRUE;
+    tt->min_val.i = 1;
+    tt->single_val.i = 360;
+    tt++;
+    
+    // Parameter 'output_shuffle'
+    // ctype is 'tdrp_bool_t'
+    
+    memset(tt, 0, sizeof(TDRPtable));
+    tt->ptype = BOOL_TYPE;
+    tt->param_name = tdrpStrDup("output_shuffle");
+    tt->descr = tdrpStrDup("Option to apply the shuffle filter before compression.");
+    tt->help = tdrpStrDup("Applies to NetCDF4 only, for integer-packed fields. Shuffling the bytes generally improves the compression of packed data.");
+    tt->val_offset = (char *) &output_shuffle - &_start_;
+    tt->single_val.b = pTRUE;
+    tt++;
+    
     // Parameter 'Comment 28'
     
     memset(tt, 0, sizeof(TDRPtable));
@@ -3407,6 +3469,67 @@
     memset(tt, 0, sizeof(TDRPtable));
     tt->ptype = COMMENT_TYPE;
     tt->param_name = tdrpStrDup("Comment 29");
+    tt->comment_hdr = tdrpStrDup("OPTION TO HAND OFF VOLUMES IN SHARED MEMORY");
+    tt->comment_text = tdrpStrDup("Instead of being written to a file, the volume may be placed in a POSIX shared memory segment, to be read by a downstream app on the same host - e.g. Radx2Grid with input_from_shared_memory set. The downstream app uses the field data in place, so the volume is not written to disk and read back. A _latest_data_info file is written to output_dir, with the segment name as the relative data path, to notify the downstream app. On Linux the segments may be seen in /dev/shm.");
+    tt++;
+    
+    // Parameter 'write_to_shared_memory'
+    // ctype is 'tdrp_bool_t'
+    
+    memset(tt, 0, sizeof(TDRPtable));
+    tt->ptype = BOOL_TYPE;
+    tt->param_name = tdrpStrDup("write_to_shared_memory");
+    tt->descr = tdrpStrDup("Option to write the volume to shared memory instead of a file.");
+    tt->help = tdrpStrDup("See the section header above. The output format params do not apply.");
+    tt->val_offset = (char *) &write_to_shared_memory - &_start_;
+    tt->single_val.b = pFALSE;
+    tt++;
+    
+    // Parameter 'shm_name_prefix'
+    // ctype is 'char*'
+    
+    memset(tt, 0, sizeof(TDRPtable));
+    tt->ptype = STRING_TYPE;
+    tt->param_name = tdrpStrDup("shm_name_prefix");
+    tt->descr = tdrpStrDup("Prefix for the shared memory segment names.");
+    tt->help = tdrpStrDup("The volume start time is appended to form the name, e.g. RadxConvert_20261017_120000. Use a different prefix for each radar on the host.");
+    tt->val_offset = (char *) &shm_name_prefix - &_start_;
+    tt->single_val.s = tdrpStrDup("RadxConvert");
+    tt++;
+    
+    // Parameter 'shm_n_consumers'
+    // ctype is 'int'
+    
+    memset(tt, 0, sizeof(TDRPtable));
+    tt->ptype = INT_TYPE;
+    tt->param_name = tdrpStrDup("shm_n_consumers");
+    tt->descr = tdrpStrDup("Number of downstream apps which read each volume.");
+    tt->help = tdrpStrDup("The segment is removed once this number of apps have finished with it. If 0, segments are only removed once shm_max_segments is exceeded.");
+    tt->val_offset = (char *) &shm_n_consumers - &_start_;
+    tt->has_min = TRUE;
+    tt->min_val.i = 0;
+    tt->single_val.i = 1;
+    tt++;
+    
+    // Parameter 'shm_max_segments'
+    // ctype is 'int'
+    
+    memset(tt, 0, sizeof(TDRPtable));
+    tt->ptype = INT_TYPE;
+    tt->param_name = tdrpStrDup("shm_max_segments");
+    tt->descr = tdrpStrDup("Max number of segments kept in shared memory.");
+    tt->help = tdrpStrDup("Once this number is exceeded the oldest segment is removed, even if not all downstream apps have read it. This prevents memory from filling if a downstream app stops. Apps which are using the segment when it is removed are not affected.");
+    tt->val_offset = (char *) &shm_max_segments - &_start_;
+    tt->has_min = TRUE;
+    tt->min_val.i = 1;
+    tt->single_val.i = 4;
+    tt++;
+    
+    // Parameter 'Comment 30'
+    
+    memset(tt, 0, sizeof(TDRPtable));
+    tt->ptype = COMMENT_TYPE;
+    tt->param_name = tdrpStrDup("Comment 30");
     tt->comment_hdr = tdrpStrDup("SEPARATING VOLUMES BY TYPE");
     tt->comment_text = tdrpStrDup("");
     tt++;
@@ -3483,11 +3606,11 @@
     tt->single_val.s = tdrpStrDup("sun");
     tt++;
     
-    // Parameter 'Comment 30'
+    // Parameter 'Comment 31'
     
     memset(tt, 0, sizeof(TDRPtable));
     tt->ptype = COMMENT_TYPE;
-    tt->param_name = tdrpStrDup("Comment 30");
+    tt->param_name = tdrpStrDup("Comment 31");
     tt->comment_hdr = tdrpStrDup("OPTION TO OVERRIDE MISSING VALUES");
     tt->comment_text = tdrpStrDup("Missing values are applicable to both metadata and field data. The default values should be satisfactory for most purposes. However, you can choose to override these if you are careful with the selected values.\n\nThe default values for metadata are:\n\tmissingMetaDouble = -9999.0\n\tmissingMetaFloat = -9999.0\n\tmissingMetaInt = -9999\n\tmissingMetaChar = -128\n\nThe default values for field data are:\n\tmissingFl64 = -9.0e33\n\tmissingFl32 = -9.0e33\n\tmissingSi32 = -2147483647\n\tmissingSi16 = -32768\n\tmissingSi08 = -128\n\n");
     tt++;
@@ -171,6 +171,12 @@ public:
     NETCDF4_CLASSIC = 3
   } netcdf_style_t;
 
+  typedef enum {
+    CHUNKING_DEFAULT = 0,
+    CHUNKING_SWEEP = 1,
+    CHUNKING_N_RAYS = 2
+  } chunking_mode_t;
+
   typedef enum {
     START_AND_END_TIMES = 0,
     START_TIME_ONLY = 1,
@@ -544,6 +550,8 @@ public:
 
   mode_t mode;
 
+  int n_parallel_files;
+
   int max_realtime_data_age_secs;
 
   tdrp_bool_t latest_data_info_avail;
@@ -836,6 +844,12 @@ public:
 
   int compression_level;
 
+  chunking_mode_t output_chunking_mode;
+
+  int output_chunk_n_rays;
+
+  tdrp_bool_t output_shuffle;
+
   char* output_dir;
 
   filename_mode_t output_filename_mode;
@@ -878,6 +892,14 @@ public:
 
   tdrp_bool_t write_using_proposed_standard_name_attr;
 
+  tdrp_bool_t write_to_shared_memory;
+
+  char* shm_name_prefix;
+
+  int shm_n_consumers;
+
+  int shm_max_segments;
+
   tdrp_bool_t separate_output_dirs_by_scan_type;
 
   char* surveillance_subdir;
@@ -919,7 +941,7 @@ private:
 
   void _init();
 
-  mutable TDRPtable _table[216];
+  mutable TDRPtable _table[225];
 
   const char *_className;
 
@@ -51,6 +51,8 @@
 #include <toolsa/pmu.h>
 #include <toolsa/umisc.h>
 #include <cerrno>
+#include <cstdio>
+#include <sys/wait.h>
 #include <set>
 using namespace std;
 
@@ -104,6 +106,18 @@ RadxConvert::RadxConvert(int argc, char **argv)
     }
   }
 
+  // shared memory output is published and evicted by a single
+  // process, so it cannot be written from parallel children
+
+  if (_params.write_to_shared_memory && _params.n_parallel_files > 1) {
+    cerr << "ERROR: " << _progName << endl;
+    cerr << "  Problem with TDRP parameters." << endl;
+    cerr << "  write_to_shared_memory is set, n_parallel_files is "
+         << _params.n_parallel_files << endl;
+    cerr << "  n_parallel_files must be 1 for shared memory output." << endl;
+    OK = FALSE;
+  }
+
   // set up variable transforms
 
   if (_params.apply_variable_transforms) {
@@ -202,7 +216,14 @@ int RadxConvert::_runFilelist()
   int nGood = 0;
   int nError = 0;
   
-  if (!_params.aggregate_all_files_on_read) {
+  if (!_params.aggregate_all_files_on_read &&
+      _params.n_parallel_files > 1) {
+
+    // convert files in parallel, in child processes
+
+    return _runParallel(_args.inputFileList);
+
+  } else if (!_params.aggregate_all_files_on_read) {
 
     // loop through the input file list
     
@@ -321,6 +342,12 @@ int RadxConvert::_runArchive()
     return -1;
   }
   
+  // convert files in parallel, in child processes?
+
+  if (_params.n_parallel_files > 1) {
+    return _runParallel(paths);
+  }
+
   // loop through the input file list
 
   RadxVol vol;
@@ -348,6 +375,174 @@ int RadxConvert::_runArchive()
 
 }
 
+//////////////////////////////////////////////////
+// Convert files in parallel.
+// Each file is converted in a child process, with up to
+// n_parallel_files children running at a time.
+// Returns 0 on success, -1 if any conversion failed.
+
+int RadxConvert::_runParallel(const vector<string> &paths)
+{
+
+  if (_params.debug) {
+    cerr << "Running RadxConvert in parallel" << endl;
+    cerr << "  n input files: " << paths.size() << endl;
+    cerr << "  n parallel files: " << _params.n_parallel_files << endl;
+  }
+
+  int nGood = 0;
+  int nError = 0;
+  int nChildren = 0;
+
+  for (size_t ii = 0; ii < paths.size(); ii++) {
+    
+    // wait for a child to exit if we are at the limit
+
+    while (nChildren >= _params.n_parallel_files) {
+      if (_waitForChild(nGood, nError)) {
+        nChildren = 0;
+      } else {
+        nChildren--;
+      }
+    }
+
+    // flush before forking, so that buffered output
+    // is not written by both parent and child
+
+    cout.flush();
+    cerr.flush();
+    fflush(NULL);
+
+    pid_t childPid = fork();
+
+    if (childPid == 0) {
+
+      // child - convert the file, and exit.
+      // _exit() does not flush the streams, so flush them here.
+
+      int iret = _convertFile(paths[ii]);
+      cout.flush();
+      cerr.flush();
+      fflush(NULL);
+      _exit(iret == 0 ? 0 : 1);
+
+    } else if (childPid < 0) {
+
+      // cannot fork, convert in this process
+
+      int errNum = errno;
+      cerr << "WARNING - RadxConvert::_runParallel" << endl;
+      cerr << "  Cannot fork child: " << strerror(errNum) << endl;
+      cerr << "  Converting in main process: " << paths[ii] << endl;
+      if (_convertFile(paths[ii])) {
+        nError++;
+      } else {
+        nGood++;
+      }
+
+    } else {
+
+      // parent - the child has its own copy of the volume number
+      
+      nChildren++;
+      if (_params.autoincrement_volume_number) {
+        _volNum++;
+      }
+
+    }
+
+  } // ii
+
+  // wait for the remaining children
+
+  while (nChildren > 0) {
+    if (_waitForChild(nGood, nError)) {
+      break;
+    }
+    nChildren--;
+  }
+
+  if (_params.debug) {
+    cerr << "RadxConvert done" << endl;
+    cerr << "====>> n good files processed: " << nGood << endl;
+    cerr << "====>> n errors: " << nError << endl;
+  }
+
+  if (nError > 0) {
+    return -1;
+  }
+  return 0;
+
+}
+
+//////////////////////////////////////////////////
+// Wait for a child process to exit, and update
+// the counts from its exit status.
+// Returns 0 on success, -1 if there are no children.
+
+int RadxConvert::_waitForChild(int &nGood, int &nError)
+{
+
+  int status;
+  pid_t pid = waitpid(-1, &status, 0);
+  if (pid < 0) {
+    return -1;
+  }
+
+  if (WIFEXITED(status) && WEXITSTATUS(status) == 0) {
+    nGood++;
+  } else {
+    nError++;
+  }
+
+  if (_params.debug >= Params::DEBUG_VERBOSE) {
+    cerr << "  ====>> child exited, pid: " << pid << endl;
+    cerr << "  ====>> n good files so far: " << nGood << endl;
+    cerr << "  ====>> n errors     so far: " << nError << endl;
+  }
+  
+  return 0;
+
+}
+
+//////////////////////////////////////////////////
+// Read, convert and write a single file.
+// Returns 0 on success or if the file is skipped,
+// -1 on failure.
+
+int RadxConvert::_convertFile(const string &path)
+{
+
+  RadxVol vol;
+  if (_params.debug >= Params::DEBUG_VERBOSE) {
+    vol.setDebug(true);
+  }
+
+  int jret = _readFile(path, vol);
+  if (jret > 0) {
+    // skipped
+    return 0;
+  } else if (jret < 0) {
+    return -1;
+  }
+
+  // finalize the volume
+
+  _finalizeVol(vol);
+
+  // write the volume out
+
+  if (_writeVol(vol)) {
+    cerr << "ERROR - RadxConvert::_convertFile" << endl;
+    cerr << "  Cannot write volume to file" << endl;
+    cerr << "  Input path: " << path << endl;
+    return -1;
+  }
+
+  return 0;
+
+}
+
 //////////////////////////////////////////////////
 // Run in realtime mode with latest data info
 
@@ -1388,6 +1583,16 @@ void RadxConvert::_setupWrite(RadxFile &file)
     file.setWriteCompressed(false);
   }
 
+  if (_params.output_chunking_mode == Params::CHUNKING_N_RAYS) {
+    file.setWriteChunking(RadxFile::CHUNKING_N_RAYS,
+                          _params.output_chunk_n_rays);
+  } else if (_params.output_chunking_mode == Params::CHUNKING_DEFAULT) {
+    file.setWriteChunking(RadxFile::CHUNKING_DEFAULT);
+  } else {
+    file.setWriteChunking(RadxFile::CHUNKING_SWEEP);
+  }
+  file.setWriteShuffle(_params.output_shuffle);
+
   if (_params.output_native_byte_order) {
     file.setWriteNativeByteOrder(true);
   } else {
@@ -1561,6 +1766,10 @@ void RadxConvert::_setGlobalAttr(RadxVol &vol)
 int RadxConvert::_writeVol(RadxVol &vol)
 {
 
+  if (_params.write_to_shared_memory) {
+    return _writeVolToShm(vol);
+  }
+
   // output file
 
   GenericRadxFile outFile;
@@ -1644,6 +1853,57 @@ int RadxConvert::_writeVol(RadxVol &vol)
 
 }
 
+//////////////////////////////////////////////////
+// write the volume to a shared memory segment,
+// and notify downstream apps via latest data info
+
+int RadxConvert::_writeVolToShm(RadxVol &vol)
+{
+
+  // segment name from prefix and volume time
+
+  RadxTime vtime(vol.getStartTimeSecs());
+  char timeStr[64];
+  snprintf(timeStr, sizeof(timeStr), "_%.4d%.2d%.2d_%.2d%.2d%.2d",
+           vtime.getYear(), vtime.getMonth(), vtime.getDay(),
+           vtime.getHour(), vtime.getMin(), vtime.getSec());
+  string shmName = _params.shm_name_prefix;
+  shmName += timeStr;
+
+  // publish
+
+  _shm.setDebug(_params.debug >= Params::DEBUG_VERBOSE);
+  _shm.setMaxPublished(_params.shm_max_segments);
+  if (_shm.publish(shmName, vol, _params.shm_n_consumers)) {
+    cerr << "ERROR - RadxConvert::_writeVolToShm" << endl;
+    cerr << _shm.getErrStr() << endl;
+    return -1;
+  }
+
+  if (_params.debug) {
+    cerr << "Wrote volume to shared memory: " << shmName << endl;
+  }
+
+  // write latest data info, with the segment name
+  // as the relative path
+
+  DsLdataInfo ldata(_params.output_dir);
+  if (_params.debug >= Params::DEBUG_VERBOSE) {
+    ldata.setDebug(true);
+  }
+  ldata.setRelDataPath(shmName);
+  ldata.setDataType("radxshm");
+  ldata.setWriter(_progName);
+  if (ldata.write(vol.getStartTimeSecs())) {
+    cerr << "WARNING - RadxConvert::_writeVolToShm" << endl;
+    cerr << "  Cannot write latest data info file to dir: "
+         << _params.output_dir << endl;
+  }
+
+  return 0;
+
+}
+
 ////////////////////////////////////////////////////////////////////
 // censor fields in vol
 
@@ -40,6 +40,7 @@
 #include <string>
 #include <set>
 #include <Radx/Radx.hh>
+#include <Radx/RadxVolShm.hh>
 class RadxVol;
 class RadxFile;
 class RadxRay;
@@ -81,10 +82,15 @@ private:
   int _volNum;
   int _nWarnCensorPrint;
 
+  RadxVolShm _shm;
+
   int _runFilelist();
   int _runArchive();
   int _runRealtimeWithLdata();
   int _runRealtimeNoLdata();
+  int _runParallel(const vector<string> &paths);
+  int _waitForChild(int &nGood, int &nError);
+  int _convertFile(const string &path);
   int _readFile(const string &filePath,
                 RadxVol &vol);
   int _readGeorefCorrections(RadxVol &vol);
@@ -97,6 +103,7 @@ private:
   void _setupWrite(RadxFile &file);
   void _setGlobalAttr(RadxVol &vol);
   int _writeVol(RadxVol &vol);
+  int _writeVolToShm(RadxVol &vol);
   void _censorFields(RadxVol &vol);
   void _censorRay(RadxRay *ray);
   bool _checkFieldForCensoring(const RadxField *field);
@@ -111,6 +111,18 @@ int Args::parse (int argc, char **argv, string &prog_name)
       sprintf(tmp_str, "print_mode = PRINT_MODE_NATIVE;");
       TDRP_add_override(&override, tmp_str);
       
+    } else if (!strcmp(argv[i], "-time_read")) {
+      
+      sprintf(tmp_str, "print_mode = PRINT_MODE_TIME_READ;");
+      TDRP_add_override(&override, tmp_str);
+      if (i < argc - 1) {
+        i++;
+	sprintf(tmp_str, "n_time_reads = %s;", argv[i]);
+	TDRP_add_override(&override, tmp_str);
+      } else {
+	OK = false;
+      }
+
     } else if (!strcmp(argv[i], "-dorade_format")) {
       
       sprintf(tmp_str, "print_mode = PRINT_MODE_DORADE_FORMAT;");
@@ -379,6 +391,18 @@ int Args::parse (int argc, char **argv, string &prog_name)
       sprintf(tmp_str, "apply_georeference_corrections = TRUE;");
       TDRP_add_override(&override, tmp_str);
       
+    } else if (!strcmp(argv[i], "-max_range")) {
+      
+      if (i < argc - 1) {
+        i++;
+	sprintf(tmp_str, "set_max_range = TRUE;");
+	TDRP_add_override(&override, tmp_str);
+	sprintf(tmp_str, "max_range_km = %s;", argv[i]);
+	TDRP_add_override(&override, tmp_str);
+      } else {
+	OK = false;
+      }
+
     } else if (!strcmp(argv[i], "-rem_miss")) {
       
       sprintf(tmp_str, "remove_rays_with_all_data_missing = TRUE;");
@@ -531,6 +555,8 @@ void Args::_usage(ostream &out)
       << "     Options: latest, closest, first_before, first_after,\n"
       << "              rays_in_interval\n"
       << "\n"
+      << "  [ -max_range ? ] set max range (km) on read\n"
+      << "\n"
       << "  [ -native ] print in native format\n"
       << "              no translation into Radx\n"
       << "\n"
@@ -585,6 +611,11 @@ void Args::_usage(ostream &out)
       << "  [ -time ? ] specify search time\n"       
       << "     Format is \"YYYY MM DD HH MM SS\"\n"
       << "\n"
+      << "  [ -time_read ? ] time the specified number of reads\n"
+      << "     Compares a full read of the file with a read using the\n"
+      << "     field, angle, sweep and range constraints.\n"
+      << "     For example: -f file.nc -sweep 0 -max_range 50 -time_read 5\n"
+      << "\n"
       << "  [ -trim_sur ] trim surveillance sweeps to 360 degrees\n"
       << "                Remove extra rays in each surveillance sweep\n"
       << "\n"
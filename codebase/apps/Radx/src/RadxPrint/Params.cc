@@ -1110,10 +1110,10 @@
     tt->ptype = ENUM_TYPE;
     tt->param_name = tdrpStrDup("print_mode");
     tt->descr = tdrpStrDup("Print mode option");
-    tt->help = tdrpStrDup("Controls details of the printing. Generally set in response to the command line args.");
+    tt->help = tdrpStrDup("Controls details of the printing. Generally set in response to the command line args.\n\nPRINT_MODE_TIME_READ: time the reads of the file, comparing a full read with a read using the read constraints - fields, fixed angle or sweep number limits, and max range. Prints the timing and the amount of data read in each case.");
     tt->val_offset = (char *) &print_mode - &_start_;
     tt->enum_def.name = tdrpStrDup("print_mode_t");
-    tt->enum_def.nfields = 3;
+    tt->enum_def.nfields = 4;
     tt->enum_def.fields = (enum_field_t *)
         tdrpMalloc(tt->enum_def.nfields * sizeof(enum_field_t));
       tt->enum_def.fields[0].name = tdrpStrDup("PRINT_MODE_NORM");
@@ -1122,9 +1122,25 @@
       tt->enum_def.fields[1].val = PRINT_MODE_NATIVE;
       tt->enum_def.fields[2].name = tdrpStrDup("PRINT_MODE_DORADE_FORMAT");
       tt->enum_def.fields[2].val = PRINT_MODE_DORADE_FORMAT;
+      tt->enum_def.fields[3].name = tdrpStrDup("PRINT_MODE_TIME_READ");
+      tt->enum_def.fields[3].val = PRINT_MODE_TIME_READ;
     tt->single_val.e = PRINT_MODE_NORM;
     tt++;
     
+    // Parameter 'n_time_reads'
+    // ctype is 'int'
+    
+    memset(tt, 0, sizeof(TDRPtable));
+    tt->ptype = INT_TYPE;
+    tt->param_name = tdrpStrDup("n_time_reads");
+    tt->descr = tdrpStrDup("Number of reads for PRINT_MODE_TIME_READ.");
+    tt->help = tdrpStrDup("The times are averaged over the reads.");
+    tt->val_offset = (char *) &n_time_reads - &_start_;
+    tt->has_min = TRUE;
+    tt->min_val.i = 1;
+    tt->single_val.i = 5;
+    tt++;
+    
     // Parameter 'print_sweep_angles'
     // ctype is 'tdrp_bool_t'
     
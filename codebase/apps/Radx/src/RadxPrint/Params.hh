@@ -93,7 +93,8 @@ public:
   typedef enum {
     PRINT_MODE_NORM = 0,
     PRINT_MODE_NATIVE = 1,
-    PRINT_MODE_DORADE_FORMAT = 2
+    PRINT_MODE_DORADE_FORMAT = 2,
+    PRINT_MODE_TIME_READ = 3
   } print_mode_t;
 
   ///////////////////////////
@@ -469,6 +470,8 @@ public:
 
   print_mode_t print_mode;
 
+  int n_time_reads;
+
   tdrp_bool_t print_sweep_angles;
 
   tdrp_bool_t print_rays;
@@ -486,7 +489,7 @@ private:
 
   void _init();
 
-  mutable TDRPtable _table[50];
+  mutable TDRPtable _table[51];
 
   const char *_className;
 
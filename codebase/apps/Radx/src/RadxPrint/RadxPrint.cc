@@ -41,6 +41,7 @@
 #include <Radx/RadxRay.hh>
 #include <Mdv/GenericRadxFile.hh>
 #include <sys/stat.h>
+#include <sys/time.h>
 #include <cerrno>
 using namespace std;
 
@@ -200,6 +201,12 @@ int RadxPrint::_handleViaPath(const string &path)
 
   }
 
+  // time the reads?
+
+  if (_params.print_mode == Params::PRINT_MODE_TIME_READ) {
+    return _timeReads(path);
+  }
+
   // set up read
 
   _setupRead(file);
@@ -478,6 +485,97 @@ void RadxPrint::_setupRead(RadxFile &file)
 
 }
 
+//////////////////////////////////////////////////
+// Time the reads of a file, comparing the full read
+// with the constrained read - fields, angle or sweep
+// limits, max range.
+
+int RadxPrint::_timeReads(const string &path)
+{
+
+  double fullSecs = 0.0, subsetSecs = 0.0;
+  RadxVol fullVol, subsetVol;
+
+  for (int ii = 0; ii < _params.n_time_reads; ii++) {
+
+    // full read
+    
+    GenericRadxFile fullFile;
+    fullFile.setReadAggregateSweeps(_params.aggregate_sweep_files_on_read);
+    struct timeval tv0, tv1;
+    gettimeofday(&tv0, NULL);
+    if (fullFile.readFromPath(path, fullVol)) {
+      cerr << "ERROR - RadxPrint::_timeReads" << endl;
+      cerr << "  Full read of file: " << path << endl;
+      cerr << fullFile.getErrStr() << endl;
+      return -1;
+    }
+    gettimeofday(&tv1, NULL);
+    fullSecs += ((tv1.tv_sec - tv0.tv_sec) +
+                 (tv1.tv_usec - tv0.tv_usec) / 1.0e6);
+
+    // constrained read
+    
+    GenericRadxFile subsetFile;
+    _setupRead(subsetFile);
+    subsetFile.setReadAggregateSweeps(_params.aggregate_sweep_files_on_read);
+    gettimeofday(&tv0, NULL);
+    if (subsetFile.readFromPath(path, subsetVol)) {
+      cerr << "ERROR - RadxPrint::_timeReads" << endl;
+      cerr << "  Subset read of file: " << path << endl;
+      cerr << subsetFile.getErrStr() << endl;
+      return -1;
+    }
+    gettimeofday(&tv1, NULL);
+    subsetSecs += ((tv1.tv_sec - tv0.tv_sec) +
+                   (tv1.tv_usec - tv0.tv_usec) / 1.0e6);
+
+  } // ii
+
+  fullSecs /= _params.n_time_reads;
+  subsetSecs /= _params.n_time_reads;
+
+  cout << "==================== READ TIMING ====================" << endl;
+  cout << "  File: " << path << endl;
+  cout << "  N reads: " << _params.n_time_reads << endl;
+  _printReadTiming(cout, "Full read", fullVol, fullSecs);
+  _printReadTiming(cout, "Subset read", subsetVol, subsetSecs);
+  if (subsetSecs > 0) {
+    cout << "  Speedup: " << fullSecs / subsetSecs << endl;
+  }
+  cout << "=====================================================" << endl;
+
+  return 0;
+
+}
+
+//////////////////////////////////////////////////
+// print the timing and size for a read
+
+void RadxPrint::_printReadTiming(ostream &out,
+                                 const string &label,
+                                 const RadxVol &vol,
+                                 double secs)
+{
+  
+  size_t nFields = 0, nPoints = 0;
+  const vector<RadxRay *> &rays = vol.getRays();
+  for (size_t ii = 0; ii < rays.size(); ii++) {
+    size_t nFieldsRay = rays[ii]->getFields().size();
+    nFields = max(nFields, nFieldsRay);
+    nPoints += rays[ii]->getNGates() * nFieldsRay;
+  }
+
+  out << "  " << label << ":" << endl;
+  out << "    nSweeps, nRays, nFields: "
+      << vol.getNSweeps() << ", "
+      << vol.getNRays() << ", "
+      << nFields << endl;
+  out << "    nPoints: " << nPoints << endl;
+  out << "    mean secs per read: " << secs << endl;
+
+}
+
 //////////////////////////////////////////////////
 // perform print
 
@@ -79,6 +79,9 @@ private:
   int _handleViaPath(const string &path);
   int _handleViaTime();
   void _setupRead(RadxFile &file);
+  int _timeReads(const string &path);
+  void _printReadTiming(ostream &out, const string &label,
+                        const RadxVol &vol, double secs);
   void _printVol(RadxVol &vol);
   void _printRayTable(ostream &out, const RadxVol &vol);
 
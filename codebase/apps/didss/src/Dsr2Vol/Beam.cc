@@ -35,6 +35,7 @@
 #include "Transform.hh"
 #include <toolsa/toolsa_macros.h>
 #include <toolsa/mem.h>
+#include <rapformats/DsBeamView.hh>
 #include <iostream>
 
 using namespace std;
@@ -99,46 +100,21 @@ Beam::Beam(DsRadarMsg &radarMsg,
   fieldData = ucalloc2(_fields.size(), nGates, byteWidth);
   censorFlag = (int *) ucalloc(nGates, sizeof(int));
   
-  // copy in the field data
-  // order changes from gate-by-gate to field-by-field
+  // copy in the field data, field by field
+  // the data is read in place in the message, which may
+  // be gate-interleaved or field-planar
+
+  DsBeamView beamView;
+  if (beamView.init(radarMsg)) {
+    cerr << "WARNING - Dsr2Vol Beam" << endl;
+    cerr << "  Cannot access beam data, fields will be zero" << endl;
+  }
   
   for (size_t ifield = 0; ifield < _fields.size(); ifield++) {
     for (size_t ii = 0; ii < fparams.size(); ii++) {
       if (_fields[ifield].dsrName == fparams[ii]->name) {
-
-	if (byteWidth == 4) {
-
-	  fl32 *inData = (fl32 *) rbeam.data() + ii;
-	  fl32 *outData = (fl32 *) fieldData[ifield];
-	  for (int igate = 0; igate < nGates;
-	       igate++, inData += fparams.size(), outData++) {
-	    *outData = *inData;
-	  } // igate
-
-	} else if (byteWidth == 2) {
-
-	  ui16 *inData = (ui16 *) rbeam.data() + ii;
-	  ui16 *outData = (ui16 *) fieldData[ifield];
-	  for (int igate = 0; igate < nGates;
-	       igate++, inData += fparams.size(), outData++) {
-	    *outData = *inData;
-	  } // igate
-
-	} else {
-
-	  // byte width 1
-	  
-	  ui08 *inData = (ui08 *) rbeam.data() + ii;
-	  ui08 *outData = (ui08 *) fieldData[ifield];
-	  for (int igate = 0; igate < nGates;
-	       igate++, inData += fparams.size(), outData++) {
-	    *outData = *inData;
-	  } // igate
-
-	}
-
+        beamView.getFieldRaw(ii, fieldData[ifield], nGates);
 	break;
-
       } // if (!strcmp ...
     } // ii
   } // ifield
@@ -270,7 +270,11 @@ int Dsr2Vol::_run ()
   // Instantiate and initialize the DsRadar queue and message
 
   DsRadarQueue radarQueue;
-  DsRadarMsg radarMsg;
+  DsRadarMsg radarMsg(DsMessage::PointToMem);
+
+  // Beam reads the data in place in the FMQ message
+
+  radarMsg.setDecodeBeamData(false);
 
   if (_params.seek_to_end_of_input) {
     if (radarQueue.init(_params.input_fmq_url, _progName.c_str(),
@@ -34,8 +34,14 @@
 
 #include "Params.hh"
 #include "DsMdvServer.hh"
+#include "ReplyCache.hh"
 
 #include <toolsa/Path.hh>
+#include <toolsa/TaStr.hh>
+#include <toolsa/file_io.h>
+#include <didss/DsURL.hh>
+#include <didss/LdataInfo.hh>
+#include <didss/RapDataDir.hh>
 #include <dsserver/DsLocator.hh>
 #include <Mdv/DsMdvxMsg.hh>
 #include <Mdv/climo/DailyByYearFileFinder.hh>
@@ -64,7 +70,9 @@ DsMdvServer::DsMdvServer(string executableName,
                           params.run_read_only,
                           params.allow_http),
           _paramsOrig(params),
-          _climoFileFinder(0)
+          _climoFileFinder(0),
+          _replyCache(NULL),
+          _lastCacheStatsTime(0)
 
 {
     setNoThreadDebug(params.no_threads);
@@ -81,10 +89,36 @@ DsMdvServer::DsMdvServer(string executableName,
     }
 
     _createClimoObjects();
+
+    // the reply cache must be set up before any children are forked
+
+    if (params.use_reply_cache) {
+      _createReplyCache();
+    }
 }
 
 DsMdvServer::~DsMdvServer()
 {
+  if (_replyCache) {
+    delete _replyCache;
+  }
+}
+
+// Override base class on timeout and post handlers,
+// printing the reply cache stats in debug mode
+
+bool DsMdvServer::timeoutMethod()
+{
+  bool iret = DsProcessServer::timeoutMethod();
+  _printReplyCacheStats();
+  return iret;
+}
+
+bool DsMdvServer::postHandlerMethod()
+{
+  bool iret = DsProcessServer::postHandlerMethod();
+  _printReplyCacheStats();
+  return iret;
 }
 
 // Handle data commands from the client.
@@ -208,6 +242,7 @@ int DsMdvServer::_checkForLocalParams(DsServerMsg &msg,
   //       and modify the url
 
   bool paramsExist;
+  _localParamsPath.clear();
   _incomingUrl = msg.getFirstURLStr();
   if (_incomingUrl == "") {
     errStr += "No URL in message.\n";
@@ -235,6 +270,7 @@ int DsMdvServer::_checkForLocalParams(DsServerMsg &msg,
       errStr += "\n";
       return( -1 );
     }
+    _localParamsPath = url.getParamFile();
     if (_isDebug) {
       cerr << "-->> Found local params, file: " << url.getParamFile() << endl;
     }
@@ -485,3 +521,183 @@ DsMdvServer::_createClimoObjects()
 
   return 0;
 }
+
+//////////////////////////////////////////////////////
+// Create the reply cache
+// On failure, the server runs without the cache
+
+void DsMdvServer::_createReplyCache()
+{
+
+  // use a subdirectory for this port
+
+  string cacheDir = _paramsOrig.reply_cache_dir;
+  TaStr::AddInt(cacheDir, PATH_DELIM, _paramsOrig.port, false);
+
+  size_t maxBytes =
+    (size_t) _paramsOrig.reply_cache_max_mbytes * 1000000;
+  
+  _replyCache = new ReplyCache(cacheDir, maxBytes,
+                               _paramsOrig.reply_cache_max_age_secs,
+                               _isDebug, _isVerbose);
+
+  if (_replyCache->init()) {
+    cerr << "WARNING - DsMdvServer" << endl;
+    cerr << "  Cannot set up reply cache, dir: " << cacheDir << endl;
+    cerr << "  Running without the cache" << endl;
+    delete _replyCache;
+    _replyCache = NULL;
+  }
+
+}
+
+//////////////////////////////////////////////////////
+// Compute the reply cache key for a read request.
+//
+// The key is made up of:
+//   the request, assembled again after the server overrides
+//     have been applied to the mdvx object;
+//   the header width used for the reply;
+//   the identity of the local params file, if any;
+//   the identity of the data - the _latest_data_info files
+//     for reads by time, or the file for reads by path.
+//
+// Returns 0 on success, -1 if the request cannot be cached.
+
+int DsMdvServer::_getReplyCacheKey(const DsMdvxMsg &msg,
+                                   const DsMdvx &mdvx,
+                                   string &key)
+{
+
+  key.clear();
+
+  if (_replyCache == NULL || !_params.use_reply_cache) {
+    return -1;
+  }
+
+  int subType = msg.getSubType();
+  if (subType != DsMdvxMsg::MDVP_READ_VOLUME &&
+      subType != DsMdvxMsg::MDVP_READ_VSECTION) {
+    return -1;
+  }
+
+  // these read data from more than one location, so the
+  // data identity cannot be determined up front
+
+  if (_params.serve_multiple_domains ||
+      _params.use_failover_urls ||
+      _params.use_climatology_url ||
+      _params.handle_derived_fields ||
+      _params.serve_rhi_data) {
+    return -1;
+  }
+
+  // the request
+
+  DsMdvxMsg keyMsg;
+  void *keyBuf = NULL;
+  if (subType == DsMdvxMsg::MDVP_READ_VOLUME) {
+    keyBuf = keyMsg.assembleReadVolume(mdvx);
+  } else {
+    keyBuf = keyMsg.assembleReadVsection(mdvx);
+  }
+  if (keyBuf == NULL) {
+    return -1;
+  }
+  key.assign((const char *) keyBuf, keyMsg.lengthAssembled());
+
+  if (msg.getUse32BitHeaders()) {
+    key += "|hdrs32";
+  } else {
+    key += "|hdrs64";
+  }
+
+  // local params
+
+  if (_localParamsPath.size() > 0) {
+    if (_addFileIdentity(_localParamsPath, key)) {
+      return -1;
+    }
+  }
+
+  // data
+
+  if (_params.use_static_file) {
+    DsURL url(_params.static_file_url);
+    string path;
+    RapDataDir.fillPath(url.getFile(), path);
+    return _addFileIdentity(path, key);
+  }
+
+  if (mdvx._readTimeSet) {
+    // the latest data info changes whenever new data arrives
+    DsURL url(mdvx._readDirUrl);
+    LdataInfo ldata(url.getFile());
+    string infoPath = ldata.getInfoPath();
+    string xmlPath = infoPath + ".xml";
+    int iret1 = _addFileIdentity(infoPath, key);
+    int iret2 = _addFileIdentity(xmlPath, key);
+    if (iret1 && iret2) {
+      // no latest data info, so we cannot tell when data changes
+      return -1;
+    }
+    return 0;
+  }
+
+  DsURL url(mdvx._readPathUrl);
+  string path;
+  RapDataDir.fillPath(url.getFile(), path);
+  return _addFileIdentity(path, key);
+
+}
+
+//////////////////////////////////////////////////////
+// Add the identity of a file to the cache key.
+// Latest data info files are replaced by rename, so the
+// inode changes on each update as well as the mod time.
+// Returns 0 on success, -1 if the file does not exist.
+
+int DsMdvServer::_addFileIdentity(const string &path, string &key)
+{
+
+  struct stat fileStat;
+  if (ta_stat(path.c_str(), &fileStat)) {
+    key += "|";
+    key += path;
+    key += ":none";
+    return -1;
+  }
+
+  char text[256];
+  snprintf(text, sizeof(text), ":%llu:%lld:%lld",
+           (unsigned long long) fileStat.st_ino,
+           (long long) fileStat.st_mtime,
+           (long long) fileStat.st_size);
+  key += "|";
+  key += path;
+  key += text;
+
+  return 0;
+
+}
+
+//////////////////////////////////////////////////////
+// Print the reply cache stats, once per minute,
+// in debug mode
+
+void DsMdvServer::_printReplyCacheStats()
+{
+
+  if (_replyCache == NULL || !_isDebug) {
+    return;
+  }
+
+  time_t now = time(NULL);
+  if (now - _lastCacheStatsTime < 60) {
+    return;
+  }
+  _lastCacheStatsTime = now;
+
+  _replyCache->printStats(cerr);
+
+}
@@ -50,6 +50,8 @@ class MdvFile;
 class DsMdvSocket;
 class DsMdvx;
 class ClimoFileFinder;
+class DsMdvxMsg;
+class ReplyCache;
 
 class DsMdvServer : public DsProcessServer {
   
@@ -64,14 +66,26 @@ public:
 protected:
     virtual int handleDataCommand(Socket * socket,
                                   const void * data, ssize_t dataSize);
+
+    // Override base class on timeout and post handlers,
+    // to print the reply cache stats
+
+    virtual bool timeoutMethod();
+    virtual bool postHandlerMethod();
   
 private:
 
   const Params &_paramsOrig;
   Params _params; // params used when serving clients
   string _incomingUrl;
+  string _localParamsPath;
 
   ClimoFileFinder *_climoFileFinder;
+
+  // cache of read replies, shared between the children
+
+  ReplyCache *_replyCache;
+  time_t _lastCacheStatsTime;
   
   // reading rhi azimuths
 
@@ -106,6 +120,15 @@ private:
   void _checkForRhiDir(const string &paramsFile);
 
   int _createClimoObjects();
+
+  // reply cache
+
+  void _createReplyCache();
+  int _getReplyCacheKey(const DsMdvxMsg &msg,
+                        const DsMdvx &mdvx,
+                        string &key);
+  static int _addFileIdentity(const string &path, string &key);
+  void _printReplyCacheStats();
   
   // set up and follow up on reads for headers, vol and vsection
   
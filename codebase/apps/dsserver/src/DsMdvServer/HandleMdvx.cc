@@ -34,6 +34,7 @@
 
 #include "Params.hh"
 #include "DsMdvServer.hh"
+#include "ReplyCache.hh"
 #include <Mdv/DsMdvx.hh>
 #include <Mdv/DsMdvxMsg.hh>
 #include <Mdv/climo/ClimoFileFinder.hh>
@@ -142,6 +143,28 @@ int DsMdvServer::handleMdvxCommand(Socket *socket,
     cerr << "  Client user: " << msg.getClientUser() << endl;
   }
 
+  // check the reply cache for volume and vsection reads
+
+  string cacheKey;
+  if (_getReplyCacheKey(msg, mdvx, cacheKey) == 0) {
+    MemBuf cachedReply;
+    if (_replyCache->lookup(cacheKey, cachedReply) == 0) {
+      if (socket->writeMessage(0, cachedReply.getPtr(),
+                               cachedReply.getLen())) {
+        cerr << "ERROR - COMM -HandleMdvxCommand." << endl;
+        cerr << "  Sending cached reply to client." << endl;
+        cerr << socket->getErrStr() << endl;
+      } else {
+        if (_isDebug) {
+          cerr << "SUCCESS - DsMdvServer sent cached reply to client" << endl;
+        }
+      }
+      return 0;
+    }
+  } else {
+    cacheKey.clear();
+  }
+
   // handle major actions
   
   int iret = 0;
@@ -264,6 +287,13 @@ int DsMdvServer::handleMdvxCommand(Socket *socket,
     }
   }
 
+  // save successful reads in the cache, after the client
+  // has its reply
+
+  if (iret == 0 && cacheKey.size() > 0) {
+    _replyCache->store(cacheKey, msgToSend, msgLen);
+  }
+
   return 0;
 
 }
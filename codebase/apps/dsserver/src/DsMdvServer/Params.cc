@@ -725,6 +725,63 @@
     memset(tt, 0, sizeof(TDRPtable));
     tt->ptype = COMMENT_TYPE;
     tt->param_name = tdrpStrDup("Comment 4");
+    tt->comment_hdr = tdrpStrDup("CACHING OF READ REPLIES - READ OPERATIONS ONLY");
+    tt->comment_text = tdrpStrDup("Volume and vertical section replies may be cached, so that repeated requests for the same data are served without reading and decoding the MDV file again. Each entry is keyed on the read request, after the server overrides have been applied, and on the identity of the data: the _latest_data_info file for reads by time, or the file itself for reads by path. Entries therefore become stale as soon as LdataInfo reports new data. Requests for multiple domains, failover URLs, derived fields and RHIs are not cached.");
+    tt++;
+    
+    // Parameter 'use_reply_cache'
+    // ctype is 'tdrp_bool_t'
+    
+    memset(tt, 0, sizeof(TDRPtable));
+    tt->ptype = BOOL_TYPE;
+    tt->param_name = tdrpStrDup("use_reply_cache");
+    tt->descr = tdrpStrDup("Option to cache volume and vsection replies.");
+    tt->help = tdrpStrDup("The cache is set up at startup from the main parameter file. A local parameter file in a data directory may set this to FALSE to disable caching for that directory.");
+    tt->val_offset = (char *) &use_reply_cache - &_start_;
+    tt->single_val.b = pFALSE;
+    tt++;
+    
+    // Parameter 'reply_cache_dir'
+    // ctype is 'char*'
+    
+    memset(tt, 0, sizeof(TDRPtable));
+    tt->ptype = STRING_TYPE;
+    tt->param_name = tdrpStrDup("reply_cache_dir");
+    tt->descr = tdrpStrDup("Directory for the reply cache.");
+    tt->help = tdrpStrDup("Each client is served by a separate child process, so the cache is held in files and is shared by all of the children. Use a memory-backed file system such as /dev/shm. Entries are stored in a subdirectory named for the port number, so that servers on different ports do not share entries. The subdirectory is cleared at startup.");
+    tt->val_offset = (char *) &reply_cache_dir - &_start_;
+    tt->single_val.s = tdrpStrDup("/dev/shm/DsMdvServer_cache");
+    tt++;
+    
+    // Parameter 'reply_cache_max_mbytes'
+    // ctype is 'int'
+    
+    memset(tt, 0, sizeof(TDRPtable));
+    tt->ptype = INT_TYPE;
+    tt->param_name = tdrpStrDup("reply_cache_max_mbytes");
+    tt->descr = tdrpStrDup("Maximum size of the reply cache (MBytes).");
+    tt->help = tdrpStrDup("When the cache grows beyond this size the least recently used entries are deleted. Replies larger than a quarter of this size are not cached.");
+    tt->val_offset = (char *) &reply_cache_max_mbytes - &_start_;
+    tt->single_val.i = 512;
+    tt++;
+    
+    // Parameter 'reply_cache_max_age_secs'
+    // ctype is 'int'
+    
+    memset(tt, 0, sizeof(TDRPtable));
+    tt->ptype = INT_TYPE;
+    tt->param_name = tdrpStrDup("reply_cache_max_age_secs");
+    tt->descr = tdrpStrDup("Maximum age of a cache entry (secs).");
+    tt->help = tdrpStrDup("Entries older than this are not used. This guards against data which is updated without the _latest_data_info file changing.");
+    tt->val_offset = (char *) &reply_cache_max_age_secs - &_start_;
+    tt->single_val.i = 3600;
+    tt++;
+    
+    // Parameter 'Comment 5'
+    
+    memset(tt, 0, sizeof(TDRPtable));
+    tt->ptype = COMMENT_TYPE;
+    tt->param_name = tdrpStrDup("Comment 5");
     tt->comment_hdr = tdrpStrDup("VERTICAL SECTIONS - READ OPERATIONS ONLY");
     tt->comment_text = tdrpStrDup("");
     tt++;
@@ -765,11 +822,11 @@
     tt->single_val.b = pFALSE;
     tt++;
     
-    // Parameter 'Comment 5'
+    // Parameter 'Comment 6'
     
     memset(tt, 0, sizeof(TDRPtable));
     tt->ptype = COMMENT_TYPE;
-    tt->param_name = tdrpStrDup("Comment 5");
+    tt->param_name = tdrpStrDup("Comment 6");
     tt->comment_hdr = tdrpStrDup("STATIC FILES - READ OPERATIONS ONLY");
     tt->comment_text = tdrpStrDup("Option to serve out data from a static file if a time-based request is made.");
     tt++;
@@ -798,11 +855,11 @@
     tt->single_val.s = tdrpStrDup("none");
     tt++;
     
-    // Parameter 'Comment 6'
+    // Parameter 'Comment 7'
     
     memset(tt, 0, sizeof(TDRPtable));
     tt->ptype = COMMENT_TYPE;
-    tt->param_name = tdrpStrDup("Comment 6");
+    tt->param_name = tdrpStrDup("Comment 7");
     tt->comment_hdr = tdrpStrDup("FAILOVER OPTION - READ OPERATIONS ONLY");
     tt->comment_text = tdrpStrDup("");
     tt++;
@@ -839,11 +896,11 @@
       tt->array_vals[1].s = tdrpStrDup("mdvp:://slowReliable::mdv/data");
     tt++;
     
-    // Parameter 'Comment 7'
+    // Parameter 'Comment 8'
     
     memset(tt, 0, sizeof(TDRPtable));
     tt->ptype = COMMENT_TYPE;
-    tt->param_name = tdrpStrDup("Comment 7");
+    tt->param_name = tdrpStrDup("Comment 8");
     tt->comment_hdr = tdrpStrDup("MULTIPLE DOMAINS - READ OPERATIONS ONLY");
     tt->comment_text = tdrpStrDup("");
     tt++;
@@ -925,11 +982,11 @@
     tt->single_val.b = pTRUE;
     tt++;
     
-    // Parameter 'Comment 8'
+    // Parameter 'Comment 9'
     
     memset(tt, 0, sizeof(TDRPtable));
     tt->ptype = COMMENT_TYPE;
-    tt->param_name = tdrpStrDup("Comment 8");
+    tt->param_name = tdrpStrDup("Comment 9");
     tt->comment_hdr = tdrpStrDup("OVERRIDING ENCODING ON READ");
     tt->comment_text = tdrpStrDup("");
     tt++;
@@ -970,20 +1027,20 @@
     tt->single_val.e = ENCODING_ASIS;
     tt++;
     
-    // Parameter 'Comment 9'
+    // Parameter 'Comment 10'
     
     memset(tt, 0, sizeof(TDRPtable));
     tt->ptype = COMMENT_TYPE;
-    tt->param_name = tdrpStrDup("Comment 9");
+    tt->param_name = tdrpStrDup("Comment 10");
     tt->comment_hdr = tdrpStrDup("OVERRIDING DATA SET SOURCE, NAME AND INFO - READ OPERATIONS ONLY");
     tt->comment_text = tdrpStrDup("The following options allow you to override the data set source, name and info when reading. These will be replaced by the specified XML strings, for use by the client.");
     tt++;
     
-    // Parameter 'Comment 10'
+    // Parameter 'Comment 11'
     
     memset(tt, 0, sizeof(TDRPtable));
     tt->ptype = COMMENT_TYPE;
-    tt->param_name = tdrpStrDup("Comment 10");
+    tt->param_name = tdrpStrDup("Comment 11");
     tt->comment_hdr = tdrpStrDup("OVERRIDING DATA SET SOURCE, NAME AND INFO - READ OPERATIONS ONLY");
     tt->comment_text = tdrpStrDup("The following options allow you to override the data set source, name and info when reading. These will be replaced by the specified XML strings, for use by the client.");
     tt++;
@@ -1060,11 +1117,11 @@
     tt->single_val.s = tdrpStrDup("<info></info>");
     tt++;
     
-    // Parameter 'Comment 11'
+    // Parameter 'Comment 12'
     
     memset(tt, 0, sizeof(TDRPtable));
     tt->ptype = COMMENT_TYPE;
-    tt->param_name = tdrpStrDup("Comment 11");
+    tt->param_name = tdrpStrDup("Comment 12");
     tt->comment_hdr = tdrpStrDup("REMAP TO LAT-LON - READ OPERATIONS ONLY");
     tt->comment_text = tdrpStrDup("Option to remap the projection to a Lat-lon grid.");
     tt++;
@@ -1081,11 +1138,11 @@
     tt->single_val.b = pFALSE;
     tt++;
     
-    // Parameter 'Comment 12'
+    // Parameter 'Comment 13'
     
     memset(tt, 0, sizeof(TDRPtable));
     tt->ptype = COMMENT_TYPE;
-    tt->param_name = tdrpStrDup("Comment 12");
+    tt->param_name = tdrpStrDup("Comment 13");
     tt->comment_hdr = tdrpStrDup("CONSTRAIN THE LEAD TIMES FOR FORECAST DATA - READ OPERATIONS ONLY");
     tt->comment_text = tdrpStrDup("This option allows you to select only certain lead times to be served out. You can also specify that the search time be interpreted as the generate time.");
     tt++;
@@ -1138,11 +1195,11 @@
       tt->struct_vals[2].b = pFALSE;
     tt++;
     
-    // Parameter 'Comment 13'
+    // Parameter 'Comment 14'
     
     memset(tt, 0, sizeof(TDRPtable));
     tt->ptype = COMMENT_TYPE;
-    tt->param_name = tdrpStrDup("Comment 13");
+    tt->param_name = tdrpStrDup("Comment 14");
     tt->comment_hdr = tdrpStrDup("CREATE COMPOSITE - READ OPERATIONS ONLY");
     tt->comment_text = tdrpStrDup("Option to create a composite - max at any height.");
     tt++;
@@ -1159,11 +1216,11 @@
     tt->single_val.b = pFALSE;
     tt++;
     
-    // Parameter 'Comment 14'
+    // Parameter 'Comment 15'
     
     memset(tt, 0, sizeof(TDRPtable));
     tt->ptype = COMMENT_TYPE;
-    tt->param_name = tdrpStrDup("Comment 14");
+    tt->param_name = tdrpStrDup("Comment 15");
     tt->comment_hdr = tdrpStrDup("DECIMATION - READ OPERATIONS ONLY");
     tt->comment_text = tdrpStrDup("");
     tt++;
@@ -1192,11 +1249,11 @@
     tt->single_val.i = 1000000;
     tt++;
     
-    // Parameter 'Comment 15'
+    // Parameter 'Comment 16'
     
     memset(tt, 0, sizeof(TDRPtable));
     tt->ptype = COMMENT_TYPE;
-    tt->param_name = tdrpStrDup("Comment 15");
+    tt->param_name = tdrpStrDup("Comment 16");
     tt->comment_hdr = tdrpStrDup("MEASURED RHI DATA OPTION - READ OPERATIONS ONLY");
     tt->comment_text = tdrpStrDup("");
     tt++;
@@ -1273,11 +1330,11 @@
     tt->single_val.b = pFALSE;
     tt++;
     
-    // Parameter 'Comment 16'
+    // Parameter 'Comment 17'
     
     memset(tt, 0, sizeof(TDRPtable));
     tt->ptype = COMMENT_TYPE;
-    tt->param_name = tdrpStrDup("Comment 16");
+    tt->param_name = tdrpStrDup("Comment 17");
     tt->comment_hdr = tdrpStrDup("VERTICAL UNITS SPECIFICATION - READ OPERATIONS ONLY");
     tt->comment_text = tdrpStrDup("");
     tt++;
@@ -1316,11 +1373,11 @@
     tt->single_val.e = HEIGHT_KM;
     tt++;
     
-    // Parameter 'Comment 17'
+    // Parameter 'Comment 18'
     
     memset(tt, 0, sizeof(TDRPtable));
     tt->ptype = COMMENT_TYPE;
-    tt->param_name = tdrpStrDup("Comment 17");
+    tt->param_name = tdrpStrDup("Comment 18");
     tt->comment_hdr = tdrpStrDup("DERIVED FIELDS - READ OPERATIONS ONLY");
     tt->comment_text = tdrpStrDup("Creating derived fields on the fly.");
     tt++;
@@ -1518,11 +1575,11 @@
       tt->struct_vals[22].d = 0;
     tt++;
     
-    // Parameter 'Comment 18'
+    // Parameter 'Comment 19'
     
     memset(tt, 0, sizeof(TDRPtable));
     tt->ptype = COMMENT_TYPE;
-    tt->param_name = tdrpStrDup("Comment 18");
+    tt->param_name = tdrpStrDup("Comment 19");
     tt->comment_hdr = tdrpStrDup("CLIMATOLOGY DATA");
     tt->comment_text = tdrpStrDup("Option to serve out data from a climatology directory if a time-based request is made.");
     tt++;
@@ -1587,11 +1644,11 @@
     tt->single_val.s = tdrpStrDup("");
     tt++;
     
-    // Parameter 'Comment 19'
+    // Parameter 'Comment 20'
     
     memset(tt, 0, sizeof(TDRPtable));
     tt->ptype = COMMENT_TYPE;
-    tt->param_name = tdrpStrDup("Comment 19");
+    tt->param_name = tdrpStrDup("Comment 20");
     tt->comment_hdr = tdrpStrDup("FILLING IN REGIONS OF MISSING DATA - READ OPERATIONS ONLY");
     tt->comment_text = tdrpStrDup("");
     tt++;
@@ -1608,11 +1665,11 @@
     tt->single_val.b = pFALSE;
     tt++;
     
-    // Parameter 'Comment 20'
+    // Parameter 'Comment 21'
     
     memset(tt, 0, sizeof(TDRPtable));
     tt->ptype = COMMENT_TYPE;
-    tt->param_name = tdrpStrDup("Comment 20");
+    tt->param_name = tdrpStrDup("Comment 21");
     tt->comment_hdr = tdrpStrDup("SETTING VALID TIME SEARCH WEIGHT - READ OPERATIONS ONLY");
     tt->comment_text = tdrpStrDup("Only applies to forecast data sets stored in the gen_time/forecast_time format.");
     tt++;
@@ -1641,11 +1698,11 @@
     tt->single_val.d = 2.5;
     tt++;
     
-    // Parameter 'Comment 21'
+    // Parameter 'Comment 22'
     
     memset(tt, 0, sizeof(TDRPtable));
     tt->ptype = COMMENT_TYPE;
-    tt->param_name = tdrpStrDup("Comment 21");
+    tt->param_name = tdrpStrDup("Comment 22");
     tt->comment_hdr = tdrpStrDup("FORWARD ON WRITE - WRITE OPERATIONS ONLY");
     tt->comment_text = tdrpStrDup("");
     tt++;
@@ -1682,11 +1739,11 @@
       tt->array_vals[1].s = tdrpStrDup("mdvp:://remotehost::mdv/data/set1");
     tt++;
     
-    // Parameter 'Comment 22'
+    // Parameter 'Comment 23'
     
     memset(tt, 0, sizeof(TDRPtable));
     tt->ptype = COMMENT_TYPE;
-    tt->param_name = tdrpStrDup("Comment 22");
+    tt->param_name = tdrpStrDup("Comment 23");
     tt->comment_hdr = tdrpStrDup("OVERRIDE FORMAT for WRITES");
     tt->comment_text = tdrpStrDup("If set, these override the write format specified in the message from the client.\n\nFORMAT_MDV: normal legacy MDV format\n\nFORMAT_XML: XML format. XML data consists of 2 buffers/files: an XML text buffer for the headers/meta-data, and a data buffer for the data. NOTE: only COMPRESSION_NONE and COMPRESSION_GZIP_VOL are supported in XML. File extensions are .mdv.xml and .xml.buf\n\nFORMAT_NCF: netCDF CF format. File extension is .mdv.nc");
     tt++;
@@ -1725,11 +1782,11 @@
     tt->single_val.e = FORMAT_MDV;
     tt++;
     
-    // Parameter 'Comment 23'
+    // Parameter 'Comment 24'
     
     memset(tt, 0, sizeof(TDRPtable));
     tt->ptype = COMMENT_TYPE;
-    tt->param_name = tdrpStrDup("Comment 23");
+    tt->param_name = tdrpStrDup("Comment 24");
     tt->comment_hdr = tdrpStrDup("WRITE IN FORECAST PATH STYLE");
     tt->comment_text = tdrpStrDup("");
     tt++;
@@ -1758,11 +1815,11 @@
     tt->single_val.b = pFALSE;
     tt++;
     
-    // Parameter 'Comment 24'
+    // Parameter 'Comment 25'
     
     memset(tt, 0, sizeof(TDRPtable));
     tt->ptype = COMMENT_TYPE;
-    tt->param_name = tdrpStrDup("Comment 24");
+    tt->param_name = tdrpStrDup("Comment 25");
     tt->comment_hdr = tdrpStrDup("WRITE USING EXTENDED PATHS");
     tt->comment_text = tdrpStrDup("This will be overridden if the environment variable MDV_WRITE_USING_EXTENDED_PATHS exists and is set to TRUE.");
     tt++;
@@ -1779,11 +1836,11 @@
     tt->single_val.b = pFALSE;
     tt++;
     
-    // Parameter 'Comment 25'
+    // Parameter 'Comment 26'
     
     memset(tt, 0, sizeof(TDRPtable));
     tt->ptype = COMMENT_TYPE;
-    tt->param_name = tdrpStrDup("Comment 25");
+    tt->param_name = tdrpStrDup("Comment 26");
     tt->comment_hdr = tdrpStrDup("NETCDF CF SUPPORT.");
     tt->comment_text = tdrpStrDup("The following parameters control conversion of MDV files to NetCDF CF-compliant files.");
     tt++;
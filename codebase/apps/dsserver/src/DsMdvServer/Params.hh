@@ -504,6 +504,14 @@ public:
 
   tdrp_bool_t copy_message_memory;
 
+  tdrp_bool_t use_reply_cache;
+
+  char* reply_cache_dir;
+
+  int reply_cache_max_mbytes;
+
+  int reply_cache_max_age_secs;
+
   tdrp_bool_t vsection_set_nsamples;
 
   int vsection_nsamples;
@@ -632,7 +640,7 @@ private:
 
   void _init();
 
-  mutable TDRPtable _table[95];
+  mutable TDRPtable _table[100];
 
   const char *_className;
 
@@ -0,0 +1,459 @@
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* 
+// ** Copyright UCAR (c) 1990 - 2016                                         
+// ** University Corporation for Atmospheric Research (UCAR)                 
+// ** National Center for Atmospheric Research (NCAR)                        
+// ** Boulder, Colorado, USA                                                 
+// ** BSD licence applies - redistribution and use in source and binary      
+// ** forms, with or without modification, are permitted provided that       
+// ** the following conditions are met:                                      
+// ** 1) If the software is modified to produce derivative works,            
+// ** such modified software should be clearly marked, so as not             
+// ** to confuse it with the version available from UCAR.                    
+// ** 2) Redistributions of source code must retain the above copyright      
+// ** notice, this list of conditions and the following disclaimer.          
+// ** 3) Redistributions in binary form must reproduce the above copyright   
+// ** notice, this list of conditions and the following disclaimer in the    
+// ** documentation and/or other materials provided with the distribution.   
+// ** 4) Neither the name of UCAR nor the names of its contributors,         
+// ** if any, may be used to endorse or promote products derived from        
+// ** this software without specific prior written permission.               
+// ** DISCLAIMER: THIS SOFTWARE IS PROVIDED "AS IS" AND WITHOUT ANY EXPRESS  
+// ** OR IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED      
+// ** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.    
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* 
+/////////////////////////////////////////////////////////////
+// ReplyCache.cc
+//
+// Cache of assembled read replies, shared between the
+// child processes which serve the clients.
+//
+///////////////////////////////////////////////////////////////
+
+#include "ReplyCache.hh"
+
+#include <toolsa/file_io.h>
+#include <toolsa/Path.hh>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <ctime>
+#include <algorithm>
+#include <vector>
+#include <dirent.h>
+#include <unistd.h>
+#include <utime.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+using namespace std;
+
+const char *ReplyCache::_magic = "MDVRPLY1";
+const char *ReplyCache::_ext = ".rcache";
+
+//////////////////////////////////////////////
+// constructor
+
+ReplyCache::ReplyCache(const string &dir,
+                       size_t maxBytes,
+                       int maxAgeSecs,
+                       bool debug,
+                       bool verbose) :
+        _dir(dir),
+        _maxBytes(maxBytes),
+        _maxAgeSecs(maxAgeSecs),
+        _debug(debug),
+        _verbose(verbose),
+        _stats(NULL)
+  
+{
+}
+
+//////////////////////////////////////////////
+// destructor
+
+ReplyCache::~ReplyCache()
+{
+  if (_stats != NULL) {
+    munmap(_stats, sizeof(stats_t));
+  }
+}
+
+//////////////////////////////////////////////
+// Create the directory, remove any old entries and set up
+// the shared statistics.
+// Returns 0 on success, -1 on failure.
+
+int ReplyCache::init()
+
+{
+
+  if (ta_makedir_recurse(_dir.c_str())) {
+    int errNum = errno;
+    cerr << "ERROR - ReplyCache::init" << endl;
+    cerr << "  Cannot create cache dir: " << _dir << endl;
+    cerr << "  " << strerror(errNum) << endl;
+    return -1;
+  }
+
+  // entries from a previous run may have been created with
+  // different server params, so they cannot be trusted
+
+  _clearDir();
+
+  // the stats must be mapped before the children are forked
+
+  void *ptr = mmap(NULL, sizeof(stats_t), PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  if (ptr == MAP_FAILED) {
+    int errNum = errno;
+    cerr << "ERROR - ReplyCache::init" << endl;
+    cerr << "  Cannot map shared memory for stats" << endl;
+    cerr << "  " << strerror(errNum) << endl;
+    return -1;
+  }
+  _stats = (stats_t *) ptr;
+  memset(_stats, 0, sizeof(stats_t));
+
+  if (_debug) {
+    cerr << "Reply cache dir: " << _dir << endl;
+    cerr << "  max MBytes: " << _maxBytes / 1.0e6 << endl;
+    cerr << "  max age secs: " << _maxAgeSecs << endl;
+  }
+
+  return 0;
+
+}
+
+//////////////////////////////////////////////
+// Look up the reply for a key.
+// Returns 0 on hit, with the reply in the buffer,
+// -1 on miss.
+
+int ReplyCache::lookup(const string &key, MemBuf &reply)
+
+{
+
+  string path = _getEntryPath(key);
+  
+  FILE *fp = fopen(path.c_str(), "r");
+  if (fp == NULL) {
+    if (_verbose) {
+      cerr << "Reply cache miss, no entry: " << path << endl;
+    }
+    _incr(&_stats->nMisses);
+    return -1;
+  }
+
+  // check header
+
+  entry_hdr_t hdr;
+  if (fread(&hdr, sizeof(hdr), 1, fp) != 1 ||
+      memcmp(hdr.magic, _magic, sizeof(hdr.magic)) != 0) {
+    fclose(fp);
+    _incr(&_stats->nMisses);
+    return -1;
+  }
+
+  time_t now = time(NULL);
+  if (now - hdr.created > _maxAgeSecs) {
+    if (_verbose) {
+      cerr << "Reply cache miss, entry too old: " << path << endl;
+    }
+    fclose(fp);
+    unlink(path.c_str());
+    _incr(&_stats->nMisses);
+    return -1;
+  }
+
+  // check the full key, in case of a hash collision
+
+  if (hdr.keyLen != key.size()) {
+    fclose(fp);
+    _incr(&_stats->nMisses);
+    return -1;
+  }
+  vector<char> entryKey(hdr.keyLen);
+  if (hdr.keyLen > 0 &&
+      fread(entryKey.data(), 1, hdr.keyLen, fp) != hdr.keyLen) {
+    fclose(fp);
+    _incr(&_stats->nMisses);
+    return -1;
+  }
+  if (memcmp(entryKey.data(), key.c_str(), hdr.keyLen) != 0) {
+    if (_verbose) {
+      cerr << "Reply cache miss, key collision: " << path << endl;
+    }
+    fclose(fp);
+    _incr(&_stats->nMisses);
+    return -1;
+  }
+
+  // read the reply
+
+  reply.reset();
+  void *buf = reply.reserve(hdr.replyLen);
+  if (fread(buf, 1, hdr.replyLen, fp) != hdr.replyLen) {
+    fclose(fp);
+    reply.reset();
+    _incr(&_stats->nMisses);
+    return -1;
+  }
+  fclose(fp);
+
+  // mark as recently used
+
+  utime(path.c_str(), NULL);
+  
+  _incr(&_stats->nHits);
+  _incr(&_stats->nBytesServed, hdr.replyLen);
+
+  if (_verbose) {
+    cerr << "Reply cache hit: " << path
+         << ", nbytes: " << hdr.replyLen << endl;
+  }
+
+  return 0;
+
+}
+
+//////////////////////////////////////////////
+// Store the reply for a key.
+// Returns 0 on success, -1 on failure.
+
+int ReplyCache::store(const string &key,
+                      const void *reply, size_t replyLen)
+
+{
+
+  // do not let a single large reply flush the cache
+
+  if (replyLen > _maxBytes / 4) {
+    if (_verbose) {
+      cerr << "Reply too large to cache, nbytes: " << replyLen << endl;
+    }
+    return -1;
+  }
+
+  string path = _getEntryPath(key);
+  char pidStr[64];
+  snprintf(pidStr, sizeof(pidStr), ".tmp.%d", (int) getpid());
+  string tmpPath = path + pidStr;
+
+  FILE *fp = fopen(tmpPath.c_str(), "w");
+  if (fp == NULL) {
+    int errNum = errno;
+    cerr << "ERROR - ReplyCache::store" << endl;
+    cerr << "  Cannot open tmp file for writing: " << tmpPath << endl;
+    cerr << "  " << strerror(errNum) << endl;
+    return -1;
+  }
+
+  entry_hdr_t hdr;
+  memset(&hdr, 0, sizeof(hdr));
+  memcpy(hdr.magic, _magic, sizeof(hdr.magic));
+  hdr.created = time(NULL);
+  hdr.keyLen = key.size();
+  hdr.replyLen = replyLen;
+
+  if (fwrite(&hdr, sizeof(hdr), 1, fp) != 1 ||
+      fwrite(key.c_str(), 1, key.size(), fp) != key.size() ||
+      fwrite(reply, 1, replyLen, fp) != replyLen) {
+    int errNum = errno;
+    cerr << "ERROR - ReplyCache::store" << endl;
+    cerr << "  Cannot write tmp file: " << tmpPath << endl;
+    cerr << "  " << strerror(errNum) << endl;
+    fclose(fp);
+    unlink(tmpPath.c_str());
+    return -1;
+  }
+  fclose(fp);
+
+  if (rename(tmpPath.c_str(), path.c_str())) {
+    int errNum = errno;
+    cerr << "ERROR - ReplyCache::store" << endl;
+    cerr << "  Cannot rename tmp file: " << tmpPath << endl;
+    cerr << "  " << strerror(errNum) << endl;
+    unlink(tmpPath.c_str());
+    return -1;
+  }
+
+  _incr(&_stats->nStores);
+
+  if (_verbose) {
+    cerr << "Reply cache store: " << path
+         << ", nbytes: " << replyLen << endl;
+  }
+
+  _evict();
+
+  return 0;
+
+}
+
+//////////////////////////////////////////////
+// print the hit and miss statistics
+
+void ReplyCache::printStats(ostream &out) const
+
+{
+
+  if (_stats == NULL) {
+    return;
+  }
+
+  ui64 nHits = _stats->nHits;
+  ui64 nMisses = _stats->nMisses;
+  ui64 nRequests = nHits + nMisses;
+  double hitPercent = 0.0;
+  if (nRequests > 0) {
+    hitPercent = (100.0 * nHits) / nRequests;
+  }
+
+  out << "Reply cache stats, dir: " << _dir << endl;
+  out << "  nHits: " << nHits << endl;
+  out << "  nMisses: " << nMisses << endl;
+  out << "  hit percent: " << hitPercent << endl;
+  out << "  nStores: " << _stats->nStores << endl;
+  out << "  nEvictions: " << _stats->nEvictions << endl;
+  out << "  MBytes served: " << _stats->nBytesServed / 1.0e6 << endl;
+
+}
+
+//////////////////////////////////////////////
+// get the entry path for a key
+// the name is the 64-bit FNV-1a hash of the key
+
+string ReplyCache::_getEntryPath(const string &key) const
+
+{
+
+  ui64 hash = 14695981039346656037ULL;
+  for (size_t ii = 0; ii < key.size(); ii++) {
+    hash ^= (unsigned char) key[ii];
+    hash *= 1099511628211ULL;
+  }
+
+  char name[64];
+  snprintf(name, sizeof(name), "%016llx", (unsigned long long) hash);
+
+  string path = _dir;
+  path += PATH_DELIM;
+  path += name;
+  path += _ext;
+  return path;
+
+}
+
+//////////////////////////////////////////////
+// delete the least recently used entries until the
+// cache is within budget, and any files which have not
+// been used within the max age
+
+void ReplyCache::_evict()
+
+{
+
+  DIR *dirp = opendir(_dir.c_str());
+  if (dirp == NULL) {
+    return;
+  }
+
+  // scan the entries
+
+  vector<Entry> entries;
+  size_t totalBytes = 0;
+  time_t now = time(NULL);
+
+  struct dirent *dp;
+  for (dp = readdir(dirp); dp != NULL; dp = readdir(dirp)) {
+
+    if (dp->d_name[0] == '.') {
+      continue;
+    }
+    string path = _dir;
+    path += PATH_DELIM;
+    path += dp->d_name;
+
+    struct stat fileStat;
+    if (stat(path.c_str(), &fileStat)) {
+      // removed by another child
+      continue;
+    }
+
+    // stale files, including tmp files left by a child which died
+
+    if (now - fileStat.st_mtime > _maxAgeSecs) {
+      if (unlink(path.c_str()) == 0) {
+        _incr(&_stats->nEvictions);
+      }
+      continue;
+    }
+
+    if (strstr(dp->d_name, _ext) == NULL ||
+        strstr(dp->d_name, ".tmp.") != NULL) {
+      continue;
+    }
+
+    totalBytes += fileStat.st_size;
+    entries.push_back(Entry(fileStat.st_mtime, fileStat.st_size, path));
+
+  } // dp
+
+  closedir(dirp);
+
+  if (totalBytes <= _maxBytes) {
+    return;
+  }
+
+  // delete least recently used first
+
+  sort(entries.begin(), entries.end());
+
+  for (size_t ii = 0; ii < entries.size() && totalBytes > _maxBytes; ii++) {
+    const Entry &entry = entries[ii];
+    if (unlink(entry.path.c_str()) == 0) {
+      _incr(&_stats->nEvictions);
+      if (_verbose) {
+        cerr << "Reply cache evict: " << entry.path << endl;
+      }
+    }
+    totalBytes -= entry.nBytes;
+  }
+
+}
+
+//////////////////////////////////////////////
+// remove all files from the cache dir
+
+void ReplyCache::_clearDir()
+
+{
+
+  DIR *dirp = opendir(_dir.c_str());
+  if (dirp == NULL) {
+    return;
+  }
+
+  struct dirent *dp;
+  for (dp = readdir(dirp); dp != NULL; dp = readdir(dirp)) {
+    if (strstr(dp->d_name, _ext) == NULL) {
+      continue;
+    }
+    string path = _dir;
+    path += PATH_DELIM;
+    path += dp->d_name;
+    unlink(path.c_str());
+  }
+
+  closedir(dirp);
+
+}
+
+//////////////////////////////////////////////
+// increment a shared counter
+// the children update the counters concurrently
+
+void ReplyCache::_incr(ui64 *counter, ui64 val /* = 1*/)
+
+{
+  __sync_fetch_and_add(counter, val);
+}
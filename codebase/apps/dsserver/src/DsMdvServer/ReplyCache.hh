@@ -0,0 +1,160 @@
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* 
+// ** Copyright UCAR (c) 1990 - 2016                                         
+// ** University Corporation for Atmospheric Research (UCAR)                 
+// ** National Center for Atmospheric Research (NCAR)                        
+// ** Boulder, Colorado, USA                                                 
+// ** BSD licence applies - redistribution and use in source and binary      
+// ** forms, with or without modification, are permitted provided that       
+// ** the following conditions are met:                                      
+// ** 1) If the software is modified to produce derivative works,            
+// ** such modified software should be clearly marked, so as not             
+// ** to confuse it with the version available from UCAR.                    
+// ** 2) Redistributions of source code must retain the above copyright      
+// ** notice, this list of conditions and the following disclaimer.          
+// ** 3) Redistributions in binary form must reproduce the above copyright   
+// ** notice, this list of conditions and the following disclaimer in the    
+// ** documentation and/or other materials provided with the distribution.   
+// ** 4) Neither the name of UCAR nor the names of its contributors,         
+// ** if any, may be used to endorse or promote products derived from        
+// ** this software without specific prior written permission.               
+// ** DISCLAIMER: THIS SOFTWARE IS PROVIDED "AS IS" AND WITHOUT ANY EXPRESS  
+// ** OR IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED      
+// ** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.    
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* 
+/////////////////////////////////////////////////////////////
+// ReplyCache.hh
+//
+// Cache of assembled read replies, shared between the
+// child processes which serve the clients.
+//
+///////////////////////////////////////////////////////////////
+//
+// DsProcessServer forks a child for each client, so an
+// in-memory cache in one child is never seen by the others.
+// Instead, each entry is stored as a file in a directory which
+// should be on a memory-backed file system such as /dev/shm.
+//
+// The entry file name is a hash of the key. The file holds the
+// full key as well as the reply, so that a hash collision is
+// treated as a miss. Entries are written to a tmp file and then
+// renamed, so readers never see a partial entry.
+//
+// The file modification time is updated on each hit, and when
+// the total size exceeds the budget the entries with the oldest
+// modification times are deleted - i.e. least recently used.
+//
+// The hit and miss counts are held in shared anonymous memory
+// mapped before the children are forked, so that the parent can
+// report them.
+//
+///////////////////////////////////////////////////////////////
+
+#ifndef ReplyCache_HH
+#define ReplyCache_HH
+
+#include <string>
+#include <iostream>
+#include <ctime>
+#include <dataport/port_types.h>
+#include <toolsa/MemBuf.hh>
+using namespace std;
+
+class ReplyCache {
+  
+public:
+
+  ReplyCache(const string &dir,
+             size_t maxBytes,
+             int maxAgeSecs,
+             bool debug,
+             bool verbose);
+  
+  ~ReplyCache();
+
+  // Create the directory, remove any old entries and set up
+  // the shared statistics.
+  // Must be called before the children are forked.
+  // Returns 0 on success, -1 on failure.
+
+  int init();
+
+  // The following may only be called after a successful init().
+
+  // Look up the reply for a key.
+  // Returns 0 on hit, with the reply in the buffer,
+  // -1 on miss.
+  
+  int lookup(const string &key, MemBuf &reply);
+
+  // Store the reply for a key, evicting old entries
+  // if the cache is over budget.
+  // Returns 0 on success, -1 on failure.
+  
+  int store(const string &key, const void *reply, size_t replyLen);
+
+  // print the hit and miss statistics
+
+  void printStats(ostream &out) const;
+
+  // get the directory
+
+  const string &getDir() const { return _dir; }
+
+private:
+
+  typedef struct {
+    char magic[8];
+    ti64 created;
+    ui64 keyLen;
+    ui64 replyLen;
+  } entry_hdr_t;
+
+  typedef struct {
+    ui64 nHits;
+    ui64 nMisses;
+    ui64 nStores;
+    ui64 nEvictions;
+    ui64 nBytesServed;
+  } stats_t;
+
+  // entry found when scanning the directory
+
+  class Entry {
+  public:
+    time_t mtime;
+    size_t nBytes;
+    string path;
+    Entry(time_t mtime_, size_t nBytes_, const string &path_) {
+      mtime = mtime_;
+      nBytes = nBytes_;
+      path = path_;
+    }
+    bool operator<(const Entry &other) const {
+      return mtime < other.mtime;
+    }
+  };
+
+  static const char *_magic;
+  static const char *_ext;
+
+  string _dir;
+  size_t _maxBytes;
+  int _maxAgeSecs;
+  bool _debug;
+  bool _verbose;
+
+  stats_t *_stats; // in shared memory
+
+  string _getEntryPath(const string &key) const;
+  void _evict();
+  void _clearDir();
+  void _incr(ui64 *counter, ui64 val = 1);
+
+  // Private methods with no bodies. DO NOT USE!
+  
+  ReplyCache(const ReplyCache &orig);
+  ReplyCache &operator=(const ReplyCache &other);
+
+};
+
+#endif
@@ -197,6 +197,8 @@ int Grib2Mdv::init(int nFiles, char** fileList, bool printVarList,
    } // if( nFiles > 0 ) {
 
    _Grib2File   = new Grib2::Grib2File ();
+   _Grib2File->setUseIndex(_paramsPtr->use_grib2_index,
+                           _paramsPtr->grib2_index_dir);
    _printVarList = printVarList;
    _printSummary = printsummary;
    _printSections = printsections;
@@ -412,6 +414,16 @@ int Grib2Mdv::getData()
 	  if( _field->vert_level_dz > 1)
 	    levelDz =  _field->vert_level_dz;
 
+	  //
+	  // Decode the requested levels concurrently if required.
+	  // getData() below then returns the decoded data.
+	  if (_paramsPtr->n_decode_threads > 1 && levelMax > levelMin) {
+	    vector<Grib2::Grib2Record::Grib2Sections_t> decodeRecords;
+	    for(int levelNum = levelMin; levelNum <= levelMax; levelNum+=levelDz)
+	      decodeRecords.push_back(GribRecords[levelNum]);
+	    Grib2::Grib2File::decodeRecords(decodeRecords, _paramsPtr->n_decode_threads);
+	  }
+
 	  //
 	  // Loop over requested vertical levels in each field
 	  for(int levelNum = levelMin; levelNum <= levelMax; levelNum+=levelDz) {
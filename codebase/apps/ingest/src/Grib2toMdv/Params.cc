@@ -729,6 +729,53 @@
     memset(tt, 0, sizeof(TDRPtable));
     tt->ptype = COMMENT_TYPE;
     tt->param_name = tdrpStrDup("Comment 2");
+    tt->comment_hdr = tdrpStrDup("GRIB2 READ OPTIONS");
+    tt->comment_text = tdrpStrDup("");
+    tt++;
+    
+    // Parameter 'use_grib2_index'
+    // ctype is 'tdrp_bool_t'
+    
+    memset(tt, 0, sizeof(TDRPtable));
+    tt->ptype = BOOL_TYPE;
+    tt->param_name = tdrpStrDup("use_grib2_index");
+    tt->descr = tdrpStrDup("Option to use an index file for each grib2 file.");
+    tt->help = tdrpStrDup("The index holds the location, name, level and lead time of each record in the grib2 file. If a valid index exists, only the records for the requested fields are unpacked, which is much faster for large model files when only some of the fields are needed. Otherwise the index is written after the file is read. The index is valid while the size and modify time of the grib2 file are unchanged.");
+    tt->val_offset = (char *) &use_grib2_index - &_start_;
+    tt->single_val.b = pFALSE;
+    tt++;
+    
+    // Parameter 'grib2_index_dir'
+    // ctype is 'char*'
+    
+    memset(tt, 0, sizeof(TDRPtable));
+    tt->ptype = STRING_TYPE;
+    tt->param_name = tdrpStrDup("grib2_index_dir");
+    tt->descr = tdrpStrDup("Directory for grib2 index files.");
+    tt->help = tdrpStrDup("If empty, the index is written alongside the grib2 file, with the extension .g2idx. Set this if the input directory is not writable.");
+    tt->val_offset = (char *) &grib2_index_dir - &_start_;
+    tt->single_val.s = tdrpStrDup("");
+    tt++;
+    
+    // Parameter 'n_decode_threads'
+    // ctype is 'int'
+    
+    memset(tt, 0, sizeof(TDRPtable));
+    tt->ptype = INT_TYPE;
+    tt->param_name = tdrpStrDup("n_decode_threads");
+    tt->descr = tdrpStrDup("Number of threads for decoding grib2 records.");
+    tt->help = tdrpStrDup("The vertical levels of each field are decoded concurrently. If 1, the levels are decoded one at a time.");
+    tt->val_offset = (char *) &n_decode_threads - &_start_;
+    tt->has_min = TRUE;
+    tt->min_val.i = 1;
+    tt->single_val.i = 1;
+    tt++;
+    
+    // Parameter 'Comment 3'
+    
+    memset(tt, 0, sizeof(TDRPtable));
+    tt->ptype = COMMENT_TYPE;
+    tt->param_name = tdrpStrDup("Comment 3");
     tt->comment_hdr = tdrpStrDup("PRINT SECTIONS PARAMETERS");
     tt->comment_text = tdrpStrDup("Parameters only used with -printSec or debug > 1\nFor each grib message prints the sections defined below\n");
     tt++;
@@ -829,11 +876,11 @@
     tt->single_val.b = pFALSE;
     tt++;
     
-    // Parameter 'Comment 3'
+    // Parameter 'Comment 4'
     
     memset(tt, 0, sizeof(TDRPtable));
     tt->ptype = COMMENT_TYPE;
-    tt->param_name = tdrpStrDup("Comment 3");
+    tt->param_name = tdrpStrDup("Comment 4");
     tt->comment_hdr = tdrpStrDup("MDV OUTPUT PARAMETERS");
     tt->comment_text = tdrpStrDup("");
     tt++;
@@ -1466,11 +1513,11 @@
       tt->array_vals[0].d = 0;
     tt++;
     
-    // Parameter 'Comment 4'
+    // Parameter 'Comment 5'
     
     memset(tt, 0, sizeof(TDRPtable));
     tt->ptype = COMMENT_TYPE;
-    tt->param_name = tdrpStrDup("Comment 4");
+    tt->param_name = tdrpStrDup("Comment 5");
     tt->comment_hdr = tdrpStrDup("INTERPOLATE INTO HEIGHT LEVELS (km MSL)");
     tt->comment_text = tdrpStrDup("Option to interpolate the model data into height levels. This requires that (a) the vertical coords are pressure levels and (b) the geopotential height field is included in the input data.");
     tt++;
@@ -481,6 +481,12 @@ public:
 
   int data_check_interval_secs;
 
+  tdrp_bool_t use_grib2_index;
+
+  char* grib2_index_dir;
+
+  int n_decode_threads;
+
   tdrp_bool_t printSec_is;
 
   tdrp_bool_t printSec_ids;
@@ -568,7 +574,7 @@ private:
 
   void _init();
 
-  mutable TDRPtable _table[56];
+  mutable TDRPtable _table[60];
 
   const char *_className;
 
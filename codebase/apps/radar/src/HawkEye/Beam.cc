@@ -67,8 +67,10 @@ Beam::Beam(const Params &params,
   // fillColors() method.
   
   _brushes.resize(n_fields);
+  _colors.resize(n_fields);
   for (int field = 0; field < n_fields; ++field) {
     _brushes[field].resize(_nGates);
+    _colors[field].resize(_nGates);
   }
 
   // initialize client counting for this object
@@ -88,6 +90,7 @@ Beam::~Beam()
 {
 
   _brushes.clear();
+  _colors.clear();
 
   // decrement client count on the ray
   // and delete if no other clients
@@ -109,8 +112,10 @@ void Beam::resetFieldBrush(size_t field, const QBrush *brush)
 
   assert(field < _nFields);
   
+  QRgb color = brush->color().rgb();
   for (size_t gate = 0; gate < _nGates; ++gate) {
     _brushes[field][gate] = brush;
+    _colors[field][gate] = color;
   }
 
 }
@@ -137,6 +142,7 @@ void Beam::fillColors(const std::vector<std::vector<double> >& beam_data,
       } else {
 	_brushes[field][igate] = map.dataBrush(data);
       }
+      _colors[field][igate] = _brushes[field][igate]->color().rgb();
 
     } // igate
 
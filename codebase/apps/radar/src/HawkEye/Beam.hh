@@ -54,6 +54,8 @@
 #include "DisplayField.hh"
 #include "Params.hh"
 
+class PpiRaster;
+
 //#if defined(OSX_LROSE) && !defined(SINCOS_DEFN)
 //#define SINCOS_DEFN
 //#define sincosf(x, s, c) __sincosf(x, s, c)
@@ -140,6 +142,20 @@ public:
                      size_t field,
                      bool useHeight = false,
                      bool drawInstHt = false) = 0;
+
+  /**
+   * @brief Paint the given field using a raster lookup table.
+   *        The default is not to support this.
+   *
+   * @return true if painted, false if paint() should be used instead.
+   */
+  
+  virtual bool paintRaster(QImage *image,
+                           const PpiRaster &raster,
+                           size_t field)
+  {
+    return false;
+  }
   
   /**
    * @brief Print details of beam object
@@ -313,6 +329,13 @@ protected:
 
   std::vector< std::vector< const QBrush* > > _brushes;
 
+  /**
+   * @brief The color for each gate for each field, matching _brushes,
+   *        for raster rendering.
+   */
+
+  std::vector< std::vector< QRgb > > _colors;
+
   // keeping track of reference counting clients using this object
 
   mutable int _nClients;
@@ -22,6 +22,7 @@
 // ** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.    
 // *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* 
 #include "FieldRenderer.hh"
+#include "PpiRaster.hh"
 using namespace std;
 
 
@@ -38,6 +39,7 @@ FieldRenderer::FieldRenderer(const Params &params,
         _image(NULL),
         _backgroundRender(false),
         _backgroundRenderTimer(NULL),
+        _raster(NULL),
         _useHeight(false),
         _drawInstHt(false)
 {
@@ -107,9 +109,11 @@ void FieldRenderer::unselectField()
   _backgroundRender = true;
   
   // Start the timer for turning off the background rendering after the
-  // specified period of time.
+  // specified period of time, unless all fields are always rendered.
   
-  _backgroundRenderTimer->start();
+  if (!_params.background_render_all_fields) {
+    _backgroundRenderTimer->start();
+  }
   
 }
   
@@ -125,9 +129,11 @@ void FieldRenderer::activateBackgroundRendering()
   _backgroundRender = true;
   
   // Start the timer for turning off the background rendering after the
-  // specified period of time.
+  // specified period of time, unless all fields are always rendered.
   
-  _backgroundRenderTimer->start();
+  if (!_params.background_render_all_fields) {
+    _backgroundRenderTimer->start();
+  }
   
 }
   
@@ -177,7 +183,10 @@ void FieldRenderer::run()
     //        << _field.getLabel() << endl;
     //   (*beam)->print(cerr);
     // }
-    (*beam)->paint(_image, _transform, _fieldIndex, _useHeight, _drawInstHt);
+    if (_raster == NULL ||
+        !(*beam)->paintRaster(_image, *_raster, _fieldIndex)) {
+      (*beam)->paint(_image, _transform, _fieldIndex, _useHeight, _drawInstHt);
+    }
     (*beam)->setBeingRendered(_fieldIndex, false);
   }
   
@@ -83,6 +83,10 @@ public:
   void createImage(int width, int height);
   void setTransform(const QTransform &transform) { _transform = transform; }
 
+  // setting state - ppi raster lookup table, NULL to paint polygons
+  
+  void setRaster(const PpiRaster *raster) { _raster = raster; }
+
   // setting state - bscan only
 
   void setUseHeight(bool useHeight) { _useHeight = useHeight; }
@@ -205,6 +209,13 @@ protected:
 
   QTransform _transform;
   
+  /**
+   * @brief Raster lookup table for ppi beams, if not NULL.
+   *        Owned by the widget.
+   */
+
+  const PpiRaster *_raster;
+  
   /**
    * @brief Array of beams to be rendered
    */
@@ -1155,6 +1155,30 @@
     tt->single_val.d = 2;
     tt++;
     
+    // Parameter 'background_render_all_fields'
+    // ctype is 'tdrp_bool_t'
+    
+    memset(tt, 0, sizeof(TDRPtable));
+    tt->ptype = BOOL_TYPE;
+    tt->param_name = tdrpStrDup("background_render_all_fields");
+    tt->descr = tdrpStrDup("Option to render all fields in the background.");
+    tt->help = tdrpStrDup("If TRUE, all fields are rendered as beams arrive, not just the fields viewed in the last background_render_mins, so that switching fields is immediate. This uses more CPU, so is best used with ppi_raster_rendering.");
+    tt->val_offset = (char *) &background_render_all_fields - &_start_;
+    tt->single_val.b = pFALSE;
+    tt++;
+    
+    // Parameter 'ppi_raster_rendering'
+    // ctype is 'tdrp_bool_t'
+    
+    memset(tt, 0, sizeof(TDRPtable));
+    tt->ptype = BOOL_TYPE;
+    tt->param_name = tdrpStrDup("ppi_raster_rendering");
+    tt->descr = tdrpStrDup("Option to render PPI beams using a pixel lookup table.");
+    tt->help = tdrpStrDup("If TRUE, the azimuth and range of every pixel is computed once for each image size and zoom, and each beam is rendered by setting the colors of the pixels it covers. This is much faster than filling a polygon for each gate, especially for high resolution data. If FALSE, polygons are filled.");
+    tt->val_offset = (char *) &ppi_raster_rendering - &_start_;
+    tt->single_val.b = pTRUE;
+    tt++;
+    
     // Parameter 'use_field_label_in_title'
     // ctype is 'tdrp_bool_t'
     
@@ -496,6 +496,10 @@ public:
 
   double background_render_mins;
 
+  tdrp_bool_t background_render_all_fields;
+
+  tdrp_bool_t ppi_raster_rendering;
+
   tdrp_bool_t use_field_label_in_title;
 
   tdrp_bool_t set_max_range;
@@ -764,7 +768,7 @@ private:
 
   void _init();
 
-  mutable TDRPtable _table[178];
+  mutable TDRPtable _table[180];
 
   const char *_className;
 
@@ -235,7 +235,9 @@ void PolarWidget::activateRealtimeRendering()
 {
   
   for (size_t ii = 0; ii < _fieldRenderers.size(); ii++) {
-    if (ii != _selectedField) {
+    if (_params.background_render_all_fields) {
+      _fieldRenderers[ii]->setBackgroundRenderingOn();
+    } else if (ii != _selectedField) {
       _fieldRenderers[ii]->activateBackgroundRendering();
     }
   }
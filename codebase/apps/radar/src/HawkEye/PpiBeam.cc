@@ -35,6 +35,7 @@
 #include <QStylePainter>
 
 #include "PpiBeam.hh"
+#include "PpiRaster.hh"
 #include <Radx/Radx.hh>
 
 using namespace std;
@@ -167,6 +168,30 @@ void PpiBeam::paint(QImage *image,
 
 }
 
+////////////////////////////////////////////////////////////////
+bool PpiBeam::paintRaster(QImage *image,
+                          const PpiRaster &raster,
+                          size_t field)
+{
+
+  if (image == NULL ||
+      (image->format() != QImage::Format_RGB32 &&
+       image->format() != QImage::Format_ARGB32) ||
+      !raster.canPaint(image->width(), image->height(),
+                       image->bytesPerLine())) {
+    return false;
+  }
+  if (_nGates == 0) {
+    return true;
+  }
+
+  raster.paintBeam((QRgb *) image->bits(), startAngle, stopAngle,
+                   _ray->getStartRangeKm(), _ray->getGateSpacingKm(),
+                   &_colors[field][0], _nGates);
+  return true;
+
+}
+
 ////////////////////////////////////////////////////////////////
 void PpiBeam::print(ostream &out)
 
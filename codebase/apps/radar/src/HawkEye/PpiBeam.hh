@@ -120,6 +120,15 @@ public:
                      bool useHeight = false,
                      bool drawInstHt = false);
 
+  /**
+   * @brief Paint the given field using a raster lookup table,
+   *        instead of polygons.
+   */
+
+  virtual bool paintRaster(QImage *image,
+                           const PpiRaster &raster,
+                           size_t field);
+
   /**
    * @brief Print details of beam object
    */
@@ -0,0 +1,206 @@
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* 
+// ** Copyright UCAR (c) 1990 - 2016                                         
+// ** University Corporation for Atmospheric Research (UCAR)                 
+// ** National Center for Atmospheric Research (NCAR)                        
+// ** Boulder, Colorado, USA                                                 
+// ** BSD licence applies - redistribution and use in source and binary      
+// ** forms, with or without modification, are permitted provided that       
+// ** the following conditions are met:                                      
+// ** 1) If the software is modified to produce derivative works,            
+// ** such modified software should be clearly marked, so as not             
+// ** to confuse it with the version available from UCAR.                    
+// ** 2) Redistributions of source code must retain the above copyright      
+// ** notice, this list of conditions and the following disclaimer.          
+// ** 3) Redistributions in binary form must reproduce the above copyright   
+// ** notice, this list of conditions and the following disclaimer in the    
+// ** documentation and/or other materials provided with the distribution.   
+// ** 4) Neither the name of UCAR nor the names of its contributors,         
+// ** if any, may be used to endorse or promote products derived from        
+// ** this software without specific prior written permission.               
+// ** DISCLAIMER: THIS SOFTWARE IS PROVIDED "AS IS" AND WITHOUT ANY EXPRESS  
+// ** OR IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED      
+// ** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.    
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* 
+#include <cmath>
+#include <toolsa/toolsa_macros.h>
+
+#include "PpiRaster.hh"
+
+using namespace std;
+
+/////////////////////////////////////////////////////////
+// world to pixel transform
+
+PpiRaster::Transform::Transform() :
+        m11(1.0), m12(0.0), m21(0.0), m22(1.0), dx(0.0), dy(0.0)
+{
+}
+
+PpiRaster::Transform::Transform(double m11_, double m12_,
+                                double m21_, double m22_,
+                                double dx_, double dy_) :
+        m11(m11_), m12(m12_), m21(m21_), m22(m22_), dx(dx_), dy(dy_)
+{
+}
+
+bool PpiRaster::Transform::operator==(const Transform &other) const
+{
+  return (m11 == other.m11 && m12 == other.m12 &&
+          m21 == other.m21 && m22 == other.m22 &&
+          dx == other.dx && dy == other.dy);
+}
+
+/////////////////////////////////////////////////////////
+// constructor - compute azimuth and range for each pixel
+
+PpiRaster::PpiRaster(int width, int height, const Transform &transform) :
+        _width(width),
+        _height(height),
+        _transform(transform),
+        _ok(false)
+  
+{
+
+  _binStart.resize(_nAzBins + 1, 0);
+
+  double det = transform.m11 * transform.m22 - transform.m12 * transform.m21;
+  if (det == 0.0 || width <= 0 || height <= 0) {
+    return;
+  }
+
+  size_t nPixels = (size_t) width * (size_t) height;
+  vector<float> az(nPixels), range(nPixels);
+  vector<int> bin(nPixels);
+
+  // azimuth and range of pixel centers, in world coords
+
+  vector<int> count(_nAzBins, 0);
+  size_t ii = 0;
+  for (int iy = 0; iy < height; iy++) {
+    for (int ix = 0; ix < width; ix++, ii++) {
+      double px = ix + 0.5 - transform.dx;
+      double py = iy + 0.5 - transform.dy;
+      double xx = (transform.m22 * px - transform.m21 * py) / det;
+      double yy = (transform.m11 * py - transform.m12 * px) / det;
+      double azDeg = atan2(xx, yy) * RAD_TO_DEG;
+      if (azDeg < 0) {
+        azDeg += 360.0;
+      }
+      int ibin = (int) (azDeg * _nAzBins / 360.0);
+      if (ibin >= _nAzBins) {
+        ibin = _nAzBins - 1;
+      }
+      az[ii] = azDeg;
+      range[ii] = sqrt(xx * xx + yy * yy);
+      bin[ii] = ibin;
+      count[ibin]++;
+    }
+  }
+
+  // sort into bins
+
+  for (int ibin = 0; ibin < _nAzBins; ibin++) {
+    _binStart[ibin + 1] = _binStart[ibin] + count[ibin];
+  }
+  _offset.resize(nPixels);
+  _az.resize(nPixels);
+  _range.resize(nPixels);
+  vector<int> next(_binStart.begin(), _binStart.end() - 1);
+  ii = 0;
+  for (int iy = 0; iy < height; iy++) {
+    for (int ix = 0; ix < width; ix++, ii++) {
+      int jj = next[bin[ii]]++;
+      _offset[jj] = iy * width + ix;
+      _az[jj] = az[ii];
+      _range[jj] = range[ii];
+    }
+  }
+
+  _ok = true;
+
+}
+
+////////////////////////////////////////////////////////////////
+
+PpiRaster::~PpiRaster()
+{
+}
+
+////////////////////////////////////////////////////////////////
+// check if table applies to size and transform
+
+bool PpiRaster::matches(int width, int height,
+                        const Transform &transform) const
+{
+  return (width == _width && height == _height && transform == _transform);
+}
+
+////////////////////////////////////////////////////////////////
+// check if table can be used for image
+
+bool PpiRaster::canPaint(int width, int height, int bytesPerLine) const
+{
+  if (!_ok) {
+    return false;
+  }
+  if (width != _width || height != _height) {
+    return false;
+  }
+  // pixel offsets assume no padding at end of lines
+  return (bytesPerLine == _width * (int) sizeof(unsigned int));
+}
+
+////////////////////////////////////////////////////////////////
+// paint the gates of one beam
+
+void PpiRaster::paintBeam(unsigned int *pixels,
+                          double startAngle, double stopAngle,
+                          double startRangeKm, double gateSpacingKm,
+                          const unsigned int *colors, size_t nGates) const
+{
+
+  if (nGates == 0 || gateSpacingKm <= 0 || stopAngle <= startAngle) {
+    return;
+  }
+
+  int startBin = (int) floor(startAngle * _nAzBins / 360.0);
+  int endBin = (int) floor(stopAngle * _nAzBins / 360.0);
+  if (startBin < 0) {
+    startBin = 0;
+  }
+  if (endBin > _nAzBins - 1) {
+    endBin = _nAzBins - 1;
+  }
+
+  // gates with a negative inner range are not painted
+
+  int minGate = 0;
+  if (startRangeKm < 0) {
+    minGate = (int) ceil(-startRangeKm / gateSpacingKm);
+  }
+  int nGatesInt = (int) nGates;
+  
+  float startAz = startAngle;
+  float stopAz = stopAngle;
+  float startRange = startRangeKm;
+  float invSpacing = 1.0 / gateSpacingKm;
+
+  int jStart = _binStart[startBin];
+  int jEnd = _binStart[endBin + 1];
+  for (int jj = jStart; jj < jEnd; jj++) {
+    float az = _az[jj];
+    if (az < startAz || az >= stopAz) {
+      continue;
+    }
+    float gg = (_range[jj] - startRange) * invSpacing;
+    if (gg < 0) {
+      continue;
+    }
+    int igate = (int) gg;
+    if (igate < minGate || igate >= nGatesInt) {
+      continue;
+    }
+    pixels[_offset[jj]] = colors[igate];
+  }
+
+}
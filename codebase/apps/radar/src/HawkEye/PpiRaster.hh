@@ -0,0 +1,143 @@
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* 
+// ** Copyright UCAR (c) 1990 - 2016                                         
+// ** University Corporation for Atmospheric Research (UCAR)                 
+// ** National Center for Atmospheric Research (NCAR)                        
+// ** Boulder, Colorado, USA                                                 
+// ** BSD licence applies - redistribution and use in source and binary      
+// ** forms, with or without modification, are permitted provided that       
+// ** the following conditions are met:                                      
+// ** 1) If the software is modified to produce derivative works,            
+// ** such modified software should be clearly marked, so as not             
+// ** to confuse it with the version available from UCAR.                    
+// ** 2) Redistributions of source code must retain the above copyright      
+// ** notice, this list of conditions and the following disclaimer.          
+// ** 3) Redistributions in binary form must reproduce the above copyright   
+// ** notice, this list of conditions and the following disclaimer in the    
+// ** documentation and/or other materials provided with the distribution.   
+// ** 4) Neither the name of UCAR nor the names of its contributors,         
+// ** if any, may be used to endorse or promote products derived from        
+// ** this software without specific prior written permission.               
+// ** DISCLAIMER: THIS SOFTWARE IS PROVIDED "AS IS" AND WITHOUT ANY EXPRESS  
+// ** OR IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED      
+// ** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.    
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* 
+#ifndef PpiRaster_HH
+#define PpiRaster_HH
+
+#include <cstddef>
+#include <vector>
+
+/////////////////////////////////////////////////////////////////////
+/// Pixel lookup table for rendering PPI beams into an image,
+/// for one image size and one world-to-pixel transform (i.e. one
+/// zoom level).
+///
+/// For each pixel the azimuth and range of the pixel center are
+/// computed once, and the pixels are sorted into azimuth bins.
+/// A beam is then rendered by visiting only the pixels in the bins
+/// spanned by the beam, computing the gate from the range, and
+/// storing the color for that gate - there is no polygon filling.
+///
+/// The table is read-only once constructed, so it may be shared by
+/// the FieldRenderer threads. It has no dependency on Qt - images are
+/// passed in as 32-bit pixel arrays, with the same layout as an RGB32
+/// QImage - so it can be tested and benchmarked without a display.
+
+class PpiRaster
+{
+
+public:
+
+  /**
+   * @brief World (km) to pixel affine transform, with the same
+   *        coefficients as QTransform:
+   *          px = m11 * x + m21 * y + dx
+   *          py = m12 * x + m22 * y + dy
+   */
+
+  class Transform {
+  public:
+    Transform(); // identity
+    Transform(double m11, double m12, double m21, double m22,
+              double dx, double dy);
+    bool operator==(const Transform &other) const;
+    double m11, m12, m21, m22, dx, dy;
+  };
+
+  /**
+   * @brief Constructor - computes the lookup table.
+   *
+   * @param[in] width      Image width in pixels.
+   * @param[in] height     Image height in pixels.
+   * @param[in] transform  World (km) to pixel transform, as used for
+   *                       painting the beam polygons.
+   */
+
+  PpiRaster(int width, int height, const Transform &transform);
+
+  /**
+   * @brief Destructor
+   */
+
+  ~PpiRaster();
+
+  /**
+   * @brief Check if this table applies to the given image size and
+   *        transform.
+   */
+
+  bool matches(int width, int height, const Transform &transform) const;
+
+  /**
+   * @brief Check if this table may be used to paint into an image
+   *        with 32-bit pixels, of the given size and line length.
+   */
+
+  bool canPaint(int width, int height, int bytesPerLine) const;
+
+  /**
+   * @brief Paint the gates of one beam into the image.
+   *
+   * @param[in,out] pixels     Image pixels, 32-bit, must pass canPaint().
+   * @param[in] startAngle     Start azimuth of beam, deg.
+   * @param[in] stopAngle      Stop azimuth of beam, deg - the beam covers
+   *                           startAngle <= az < stopAngle.
+   * @param[in] startRangeKm   Range to start of first gate.
+   * @param[in] gateSpacingKm  Gate spacing.
+   * @param[in] colors         Color for each gate.
+   * @param[in] nGates         Number of gates.
+   */
+
+  void paintBeam(unsigned int *pixels,
+                 double startAngle, double stopAngle,
+                 double startRangeKm, double gateSpacingKm,
+                 const unsigned int *colors, size_t nGates) const;
+
+  int getWidth() const { return _width; }
+  int getHeight() const { return _height; }
+  
+private:
+
+  static const int _nAzBins = 3600;
+
+  int _width;
+  int _height;
+  Transform _transform;
+  bool _ok;
+
+  // pixels, sorted by azimuth bin
+  // pixels for bin i are _binStart[i] to _binStart[i+1] - 1
+
+  std::vector<int> _binStart;
+  std::vector<int> _offset;   // offset of pixel in image, in pixels
+  std::vector<float> _az;     // azimuth of pixel center, deg
+  std::vector<float> _range;  // range of pixel center, km
+
+  // no copying
+
+  PpiRaster(const PpiRaster &);
+  PpiRaster &operator=(const PpiRaster &);
+
+};
+
+#endif
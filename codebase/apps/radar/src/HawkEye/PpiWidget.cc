@@ -22,6 +22,7 @@
 // ** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.    
 // *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* 
 #include "PpiWidget.hh"
+#include "PpiRaster.hh"
 #include "PolarManager.hh"
 #include "SpreadSheetView.hh"
 #include "SpreadSheetController.hh"
@@ -100,6 +101,13 @@ PpiWidget::~PpiWidget()
   }
   _ppiBeams.clear();
 
+  // delete the raster lookup tables
+
+  for (size_t i = 0; i < _rasters.size(); ++i) {
+    delete _rasters[i];
+  }
+  _rasters.clear();
+
 }
 
 /*************************************************************************
@@ -1144,6 +1152,56 @@ void PpiWidget::_cullBeams(const PpiBeam *beamAB)
   
 }
 
+/*************************************************************************
+ * _getRaster()
+ */
+
+const PpiRaster *PpiWidget::_getRaster()
+{
+
+  if (!_params.ppi_raster_rendering) {
+    return NULL;
+  }
+
+  // the table handles affine transforms only - otherwise
+  // fall back to painting polygons
+
+  if (!_zoomTransform.isAffine()) {
+    return NULL;
+  }
+  PpiRaster::Transform transform(_zoomTransform.m11(), _zoomTransform.m12(),
+                                 _zoomTransform.m21(), _zoomTransform.m22(),
+                                 _zoomTransform.dx(), _zoomTransform.dy());
+
+  // use an existing table if we have one for this size and zoom,
+  // moving it to the front of the list
+
+  for (size_t ii = 0; ii < _rasters.size(); ii++) {
+    PpiRaster *raster = _rasters[ii];
+    if (raster->matches(width(), height(), transform)) {
+      _rasters.erase(_rasters.begin() + ii);
+      _rasters.insert(_rasters.begin(), raster);
+      return raster;
+    }
+  }
+
+  // create a new one, deleting the least recently used if needed.
+  // Rendering is not in progress here, so no renderer is using it.
+
+  PpiRaster *raster = new PpiRaster(width(), height(), transform);
+  _rasters.insert(_rasters.begin(), raster);
+  while (_rasters.size() > _maxRasters) {
+    delete _rasters.back();
+    _rasters.pop_back();
+  }
+
+  LOG(DEBUG_VERBOSE) << "Created raster lookup table, width, height: "
+                     << width() << ", " << height();
+
+  return raster;
+
+}
+
 /*************************************************************************
  * _refreshImages()
  */
@@ -1151,6 +1209,8 @@ void PpiWidget::_cullBeams(const PpiBeam *beamAB)
 void PpiWidget::_refreshImages()
 {
 
+  const PpiRaster *raster = _getRaster();
+
   for (size_t ifield = 0; ifield < _fieldRenderers.size(); ++ifield) {
     
     FieldRenderer *field = _fieldRenderers[ifield];
@@ -1168,6 +1228,7 @@ void PpiWidget::_refreshImages()
     // set up rendering details
 
     field->setTransform(_zoomTransform);
+    field->setRaster(raster);
     
     // Add pointers to the beams to be rendered
     
@@ -157,6 +157,12 @@ class DLL_EXPORT PpiWidget : public PolarWidget
 
   std::vector<PpiBeam*> _ppiBeams;
 
+  // raster lookup tables for rendering, most recently used first,
+  // one per image size and zoom
+
+  std::vector<PpiRaster*> _rasters;
+  static const size_t _maxRasters = 4;
+
   // are we in archive mode? and if so are we at the start of a sweep?
 
   bool _isArchiveMode;
@@ -211,6 +217,15 @@ class DLL_EXPORT PpiWidget : public PolarWidget
 
   virtual void _refreshImages();
 
+  /**
+   * @brief Get the raster lookup table for the current image size and
+   *        zoom, creating it if needed.
+   *
+   * @return Returns NULL if raster rendering is not in use.
+   */
+
+  const PpiRaster *_getRaster();
+
   /**
    * @brief For dynamically allocated beams, cull the beam list, removing
    *        beams that are hidden by the given new beam.
@@ -0,0 +1,282 @@
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* 
+// ** Copyright UCAR (c) 1990 - 2016                                         
+// ** University Corporation for Atmospheric Research (UCAR)                 
+// ** National Center for Atmospheric Research (NCAR)                        
+// ** Boulder, Colorado, USA                                                 
+// ** BSD licence applies - redistribution and use in source and binary      
+// ** forms, with or without modification, are permitted provided that       
+// ** the following conditions are met:                                      
+// ** 1) If the software is modified to produce derivative works,            
+// ** such modified software should be clearly marked, so as not             
+// ** to confuse it with the version available from UCAR.                    
+// ** 2) Redistributions of source code must retain the above copyright      
+// ** notice, this list of conditions and the following disclaimer.          
+// ** 3) Redistributions in binary form must reproduce the above copyright   
+// ** notice, this list of conditions and the following disclaimer in the    
+// ** documentation and/or other materials provided with the distribution.   
+// ** 4) Neither the name of UCAR nor the names of its contributors,         
+// ** if any, may be used to endorse or promote products derived from        
+// ** this software without specific prior written permission.               
+// ** DISCLAIMER: THIS SOFTWARE IS PROVIDED "AS IS" AND WITHOUT ANY EXPRESS  
+// ** OR IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED      
+// ** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.    
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* 
+/*
+ * Name: TEST_PpiRaster.cc
+ *
+ * Purpose:
+ *
+ *      To test the PpiRaster lookup table without a display.
+ *
+ *      A synthetic 720-ray sweep is painted into an image through the
+ *      table. Every pixel is then checked against the beam and gate
+ *      computed directly from the azimuth and range of the pixel
+ *      center, at the full view and at a zoom.
+ *
+ *      With -time, the time taken to build the table, to paint one
+ *      beam, and to fill a whole field, is printed for a range of
+ *      image sizes.
+ *
+ * Usage:
+ *
+ *       % PpiRaster-test [-time]
+ *
+ * Inputs:
+ *
+ *       None
+ *
+ * Returns 0 on success, 1 on failure.
+ * Prints nothing on success, unless -time is specified.
+ *
+ */
+
+/*
+ * include files
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <sys/time.h>
+#include "PpiRaster.hh"
+using namespace std;
+
+static const int nRays = 720;
+static const int nGates = 1000;
+static const double startRangeKm = 0.075;
+static const double gateSpacingKm = 0.15;
+static const double maxRangeKm = startRangeKm + nGates * gateSpacingKm;
+static const double beamWidthDeg = 360.0 / nRays;
+
+static int nFail = 0;
+
+/*
+ * Color for a gate - encodes the ray and gate, never 0
+ */
+
+static inline unsigned int _color(int iray, int igate)
+{
+  return ((unsigned int) (iray + 1) << 16) | (unsigned int) (igate + 1);
+}
+
+/*
+ * Transform for an image centered on the radar, as set up by
+ * PolarWidget - y increases upwards in world coords.
+ * zoom > 1 zooms in, and the view is offset by xOffKm, yOffKm.
+ */
+
+static PpiRaster::Transform _transform(int width, int height, double zoom,
+                                       double xOffKm, double yOffKm)
+{
+  double pixPerKm = zoom * (width < height ? width : height) /
+    (2.0 * maxRangeKm);
+  return PpiRaster::Transform(pixPerKm, 0.0, 0.0, -pixPerKm,
+                              width / 2.0 - xOffKm * pixPerKm,
+                              height / 2.0 + yOffKm * pixPerKm);
+}
+
+/*
+ * Paint the whole sweep into the image
+ */
+
+static void _paintSweep(const PpiRaster &raster,
+                        const vector< vector<unsigned int> > &colors,
+                        vector<unsigned int> &image)
+{
+  for (int iray = 0; iray < nRays; iray++) {
+    raster.paintBeam(&image[0],
+                     iray * beamWidthDeg, (iray + 1) * beamWidthDeg,
+                     startRangeKm, gateSpacingKm,
+                     &colors[iray][0], nGates);
+  }
+}
+
+/*
+ * Check every pixel against the beam and gate computed directly.
+ * Pixels very close to a beam or gate edge are skipped, since the
+ * table holds the angles and ranges as floats.
+ */
+
+static void _checkImage(const char *label, int width, int height,
+                        const PpiRaster::Transform &tr,
+                        const vector<unsigned int> &image)
+{
+  double det = tr.m11 * tr.m22 - tr.m12 * tr.m21;
+  int nBad = 0;
+  for (int iy = 0; iy < height; iy++) {
+    for (int ix = 0; ix < width; ix++) {
+      double px = ix + 0.5 - tr.dx;
+      double py = iy + 0.5 - tr.dy;
+      double xx = (tr.m22 * px - tr.m21 * py) / det;
+      double yy = (tr.m11 * py - tr.m12 * px) / det;
+      double az = atan2(xx, yy) * 180.0 / M_PI;
+      if (az < 0) {
+        az += 360.0;
+      }
+      double range = sqrt(xx * xx + yy * yy);
+      double rayPos = az / beamWidthDeg;
+      double gatePos = (range - startRangeKm) / gateSpacingKm;
+      if (fabs(rayPos - floor(rayPos + 0.5)) < 1.0e-3 ||
+          fabs(gatePos - floor(gatePos + 0.5)) < 1.0e-3) {
+        continue;
+      }
+      unsigned int expected = 0;
+      if (gatePos >= 0 && gatePos < nGates) {
+        int iray = (int) rayPos;
+        if (iray >= nRays) {
+          iray = nRays - 1;
+        }
+        expected = _color(iray, (int) gatePos);
+      }
+      unsigned int actual = image[iy * width + ix];
+      if (actual != expected) {
+        if (nBad == 0) {
+          fprintf(stderr, "FAIL - %s, pixel %d, %d, az %g, range %g, "
+                  "expected 0x%x, got 0x%x\n",
+                  label, ix, iy, az, range, expected, actual);
+        }
+        nBad++;
+      }
+    }
+  }
+  if (nBad > 0) {
+    fprintf(stderr, "FAIL - %s, %d bad pixels\n", label, nBad);
+    nFail++;
+  }
+}
+
+/*
+ * Test one image size and view
+ */
+
+static void _testView(const char *label, int width, int height,
+                      double zoom, double xOffKm, double yOffKm,
+                      const vector< vector<unsigned int> > &colors)
+{
+  PpiRaster::Transform tr = _transform(width, height, zoom, xOffKm, yOffKm);
+  PpiRaster raster(width, height, tr);
+  if (!raster.matches(width, height, tr) ||
+      raster.matches(width + 1, height, tr) ||
+      !raster.canPaint(width, height, width * sizeof(unsigned int)) ||
+      raster.canPaint(width, height, (width + 1) * sizeof(unsigned int))) {
+    fprintf(stderr, "FAIL - %s, matches() or canPaint()\n", label);
+    nFail++;
+    return;
+  }
+  vector<unsigned int> image(width * height, 0);
+  _paintSweep(raster, colors, image);
+  _checkImage(label, width, height, tr, image);
+}
+
+/*
+ * Time in secs
+ */
+
+static double _now()
+{
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return tv.tv_sec + tv.tv_usec * 1.0e-6;
+}
+
+/*
+ * Print the times for one image size
+ */
+
+static void _time(int width, int height,
+                  const vector< vector<unsigned int> > &colors)
+{
+
+  PpiRaster::Transform tr = _transform(width, height, 1.0, 0.0, 0.0);
+
+  int nBuild = 5;
+  double start = _now();
+  for (int ii = 0; ii < nBuild - 1; ii++) {
+    PpiRaster raster(width, height, tr);
+  }
+  PpiRaster raster(width, height, tr);
+  double buildSecs = (_now() - start) / nBuild;
+
+  vector<unsigned int> image(width * height, 0);
+  int nFill = 20;
+  start = _now();
+  for (int ii = 0; ii < nFill; ii++) {
+    _paintSweep(raster, colors, image);
+  }
+  double fillSecs = (_now() - start) / nFill;
+
+  fprintf(stdout, "%5d x %-5d  build table %8.2f ms  "
+          "paintBeam %7.1f us  field fill %7.2f ms\n",
+          width, height, buildSecs * 1.0e3,
+          fillSecs * 1.0e6 / nRays, fillSecs * 1.0e3);
+
+}
+
+/* ======================================================================== */
+
+/*
+ * main program
+ */
+
+int main(int argc, char *argv[])
+{
+
+  bool doTime = (argc > 1 && strcmp(argv[1], "-time") == 0);
+
+  vector< vector<unsigned int> > colors(nRays);
+  for (int iray = 0; iray < nRays; iray++) {
+    colors[iray].resize(nGates);
+    for (int igate = 0; igate < nGates; igate++) {
+      colors[iray][igate] = _color(iray, igate);
+    }
+  }
+
+  _testView("full view", 600, 500, 1.0, 0.0, 0.0, colors);
+  _testView("zoomed view", 500, 600, 4.0, 20.0, -35.0, colors);
+  _testView("radar outside view", 400, 400, 8.0, 100.0, 60.0, colors);
+
+  // a transform which cannot be inverted gives a table
+  // which cannot be used
+
+  PpiRaster::Transform singular(0.0, 0.0, 0.0, 0.0, 10.0, 10.0);
+  PpiRaster bad(100, 100, singular);
+  if (bad.canPaint(100, 100, 100 * sizeof(unsigned int))) {
+    fprintf(stderr, "FAIL - singular transform, canPaint() is true\n");
+    nFail++;
+  }
+
+  if (doTime) {
+    int sizes[] = {500, 1000, 2000};
+    for (size_t ii = 0; ii < sizeof(sizes) / sizeof(int); ii++) {
+      _time(sizes[ii], sizes[ii], colors);
+    }
+  }
+
+  if (nFail > 0) {
+    fprintf(stderr, "PpiRaster-test: %d failures\n", nFail);
+    return 1;
+  }
+  return 0;
+
+}
@@ -34,6 +34,7 @@ HEADERS += ParameterColorView.hh
 HEADERS += FieldColorController.hh
 HEADERS += DisplayFieldModel.hh
 HEADERS += PpiBeam.hh
+HEADERS += PpiRaster.hh
 HEADERS += PolarManager.hh
 HEADERS += PolarWidget.hh
 HEADERS += PpiWidget.hh
@@ -87,6 +88,7 @@ SOURCES += DisplayFieldModel.cc
 SOURCES += PolarManager.cc
 SOURCES += PolarWidget.cc
 SOURCES += PpiBeam.cc
+SOURCES += PpiRaster.cc
 SOURCES += PpiWidget.cc
 SOURCES += Reader.cc
 SOURCES += RhiBeam.cc
@@ -54,7 +54,6 @@ using namespace std;
 
 const double Beam::_missingDbl = MomentsFields::missingDouble;
 int Beam::_nWarnings = 0;
-pthread_mutex_t Beam::_fftMutex = PTHREAD_MUTEX_INITIALIZER;
 pthread_mutex_t Beam::_pulseUnpackMutex = PTHREAD_MUTEX_INITIALIZER;
 pthread_mutex_t Beam::_debugPrintMutex = PTHREAD_MUTEX_INITIALIZER;
 
@@ -508,11 +507,9 @@ void Beam::_prepareForComputeMoments()
 
   // ffts and regression filter
 
-  // initialize the FFT objects on the threads
-  // Note: the initialization is not thread safe so it 
-  // must be protected by a mutex
-
-  pthread_mutex_lock(&_fftMutex);
+  // initialize the FFT objects
+  // the FFTW plans come from the RadarFft plan cache, which is
+  // thread safe, so no lock is needed
 
   _fft->init(_nSamples);
   _fftHalf->init(_nSamplesHalf);
@@ -541,8 +538,6 @@ void Beam::_prepareForComputeMoments()
                             _params.regression_filter_cnr_exponent,
                             _wavelengthM);
 
-  pthread_mutex_unlock(&_fftMutex);
-
   // compute delta phases for SZ, if required
   
   if (_applySz1) {
@@ -3348,12 +3343,8 @@ void Beam::_filtSpecCmdSimHv()
 {
 
   // dimensions
-  // need to protect fft during initialization since that action
-  // is not thread safe
   
-  pthread_mutex_lock(&_fftMutex);
   _specCmd.setDimensions(_nGates, _nSamples);
-  pthread_mutex_unlock(&_fftMutex);
 
   // metadata
 
@@ -400,7 +400,6 @@ private:
   
   // FFTs
 
-  static pthread_mutex_t _fftMutex;
   RadarFft *_fft;
   RadarFft *_fftHalf;
 
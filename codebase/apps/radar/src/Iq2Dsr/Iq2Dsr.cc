@@ -41,6 +41,7 @@
 #include <cassert>
 #include <iostream>
 #include <toolsa/pmu.h>
+#include <radar/RadarFft.hh>
 #include "EgmCorrection.hh"
 #include "SpectraPrint.hh"
 #include "Iq2Dsr.hh"
@@ -134,6 +135,19 @@ Iq2Dsr::Iq2Dsr(int argc, char **argv)
     _params.check_for_missing_pulses = pTRUE;
   }
   
+  // import FFTW wisdom, to avoid re-planning the FFTs
+  
+  if (strlen(_params.fftw_wisdom_path) > 0) {
+    if (RadarFft::importWisdom(_params.fftw_wisdom_path)) {
+      if (_params.debug) {
+        cerr << "WARNING - Iq2Dsr" << endl;
+        cerr << "  Cannot import FFTW wisdom, file: "
+             << _params.fftw_wisdom_path << endl;
+        cerr << "  Wisdom will be saved on exit" << endl;
+      }
+    }
+  }
+
   // initalize calibration object, read in starting calibration
 
   _calib = new Calibration(_params);
@@ -332,6 +346,16 @@ void Iq2Dsr::_cleanUp()
     cerr << "  Gates per second: " << gatesPerSec << endl;
   }
 
+  // save FFTW wisdom for next time
+
+  if (strlen(_params.fftw_wisdom_path) > 0) {
+    if (RadarFft::exportWisdom(_params.fftw_wisdom_path)) {
+      cerr << "WARNING - Iq2Dsr" << endl;
+      cerr << "  Cannot export FFTW wisdom, file: "
+           << _params.fftw_wisdom_path << endl;
+    }
+  }
+
   if (_params.debug) {
     cerr << "Exiting _cleanUp" << endl;
   }
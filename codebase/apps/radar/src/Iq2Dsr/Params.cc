@@ -655,6 +655,18 @@
     tt->single_val.i = 8;
     tt++;
     
+    // Parameter 'fftw_wisdom_path'
+    // ctype is 'char*'
+    
+    memset(tt, 0, sizeof(TDRPtable));
+    tt->ptype = STRING_TYPE;
+    tt->param_name = tdrpStrDup("fftw_wisdom_path");
+    tt->descr = tdrpStrDup("Path for FFTW wisdom file.");
+    tt->help = tdrpStrDup("FFTW plans are cached and shared between the compute threads. Planning for a new dwell length can be slow. If this path is set, the wisdom in the file is imported on startup, and the accumulated wisdom is written back to the file on exit, so that subsequent runs do not need to re-plan. If empty, wisdom is not saved.");
+    tt->val_offset = (char *) &fftw_wisdom_path - &_start_;
+    tt->single_val.s = tdrpStrDup("");
+    tt++;
+    
     // Parameter 'Comment 3'
     
     memset(tt, 0, sizeof(TDRPtable));
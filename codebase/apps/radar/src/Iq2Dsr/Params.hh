@@ -798,6 +798,8 @@ public:
 
   int n_compute_threads;
 
+  char* fftw_wisdom_path;
+
   mode_t mode;
 
   char* input_fmq;
@@ -1396,7 +1398,7 @@ private:
 
   void _init();
 
-  mutable TDRPtable _table[323];
+  mutable TDRPtable _table[324];
 
   const char *_className;
 
@@ -26,11 +26,15 @@
  *
  * Adapted from goto40's implementation in https://stackoverflow.com/questions/31090302
  *
- * This implementation keeps nodesInUse_ as a map<T*, unique_ptr<T>>, matching
- * a raw "T*" to the associated unique_ptr<T>. Since std::map is a sorted
- * container, finding nodes in use by their associated raw T* is O(log(n))
- * problem rather than O(n), so free_() moves items from nodesInUse_ to
- * freeNodes_ *MUCH* faster.
+ * All nodes are owned by allNodes_, and the free nodes are kept as raw
+ * pointers in freeNodes_, so returning a node to the pool is a simple
+ * push onto a vector whose capacity has already been reserved.
+ *
+ * The shared_ptr control blocks are taken from a free list of blocks kept
+ * by the pool (see ControlBlockStore), rather than from the heap. Once the
+ * pool has grown to its working size, alloc() and the release of a node
+ * therefore perform no heap allocation. This matters for Iq2Dsr, where a
+ * pulse is allocated from the pool at the pulse rate.
  *
  *  Created on: Apr 25, 2023
  *      Author: Chris Burghart <burghart@ucar.edu>
@@ -46,6 +50,7 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <new>
 #include <sstream>
 #include <stdexcept>
 #include <string>
@@ -62,24 +67,115 @@
 template<class T, bool grow_on_demand=true>
 class SharedPointerPool
 {
+private:
+
+    /// @brief Free list of fixed-size memory blocks, used for the shared_ptr
+    /// control blocks.
+    ///
+    /// All control blocks created by alloc() have the same type, and hence
+    /// the same size. The block size is set by the first request; any request
+    /// for a different size is passed through to the heap.
+    class ControlBlockStore
+    {
+    public:
+        ControlBlockStore() : blockSize_(0) {}
+        ~ControlBlockStore()
+        {
+            for (size_t i = 0; i < freeBlocks_.size(); i++)
+            {
+                ::operator delete(freeBlocks_[i]);
+            }
+        }
+        void* get(size_t nbytes)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                if (blockSize_ == 0)
+                {
+                    blockSize_ = nbytes;
+                }
+                if (nbytes == blockSize_ && !freeBlocks_.empty())
+                {
+                    void* block = freeBlocks_.back();
+                    freeBlocks_.pop_back();
+                    return block;
+                }
+            }
+            return ::operator new(nbytes);
+        }
+        void put(void* block, size_t nbytes)
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (nbytes == blockSize_)
+            {
+                freeBlocks_.push_back(block);
+            }
+            else
+            {
+                ::operator delete(block);
+            }
+        }
+        void reserve(size_t n)
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            freeBlocks_.reserve(n);
+        }
+    private:
+        std::mutex mutex_;
+        size_t blockSize_;
+        std::vector<void*> freeBlocks_;
+    };
+
+    /// @brief Allocator handed to the shared_ptr constructor, which takes
+    /// control blocks from the ControlBlockStore
+    template<class U>
+    class ControlBlockAllocator
+    {
+    public:
+        typedef U value_type;
+        explicit ControlBlockAllocator(ControlBlockStore* store) :
+            store_(store) {}
+        template<class V>
+        ControlBlockAllocator(const ControlBlockAllocator<V>& other) :
+            store_(other.store_) {}
+        U* allocate(size_t n)
+        {
+            return static_cast<U*>(store_->get(n * sizeof(U)));
+        }
+        void deallocate(U* p, size_t n)
+        {
+            store_->put(p, n * sizeof(U));
+        }
+        template<class V>
+        bool operator==(const ControlBlockAllocator<V>& other) const
+        {
+            return store_ == other.store_;
+        }
+        template<class V>
+        bool operator!=(const ControlBlockAllocator<V>& other) const
+        {
+            return store_ != other.store_;
+        }
+        ControlBlockStore* store_;
+    };
+
 public:
     /// @brief constructor
     /// @param n the number of objects initially allocated in the pool
     /// @param factoryFunction std::function used to create new T* nodes for
     /// the pool (default is just "new T()").
     SharedPointerPool(size_t n = 0, std::function<T*()> factoryFunction = []() { return new T(); }) :
-        nodeCount_(n),
+        nodeCount_(0),
         mutex_(),
+        allNodes_(),
         freeNodes_(),
-        nodesInUse_(),
+        blockStore_(),
         factoryFunction_(factoryFunction)
     {
         // Start the pool with the requested number of nodes
-        for (size_t i = 0; i < nodeCount_; i++)
+        for (size_t i = 0; i < n; i++)
         {
-            // Create a unique_ptr to a  newly created node and push it onto
-            // freeNodes_
-            freeNodes_.push_back(std::unique_ptr<T>(factoryFunction_()));
+            addNode_();
         }
     }
 
@@ -92,39 +188,31 @@ public:
     /// the pool.
     std::shared_ptr<T> alloc()
     {
-        std::unique_lock<std::mutex> lock(mutex_);
-        if (freeNodes_.empty())
+        T* rawPtr = NULL;
         {
-            if (grow_on_demand)
-            {
-                freeNodes_.push_back(std::unique_ptr<T>(factoryFunction_()));
-                nodeCount_++;
-            }
-            else
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (freeNodes_.empty())
             {
-                throw std::bad_alloc();
+                if (grow_on_demand)
+                {
+                    addNode_();
+                }
+                else
+                {
+                    throw std::bad_alloc();
+                }
             }
+            rawPtr = freeNodes_.back();
+            freeNodes_.pop_back();
         }
 
-        // Get a reference to the last unique_ptr<T> in freeNodes_. We'll shift
-        // its ownership to nodesInUse_ below using std::move.
-        std::unique_ptr<T>& uPtr(freeNodes_.back());
-
-        // Get the raw T* pointer from the unique_ptr
-        T* rawPtr = uPtr.get();
-
         // Create a shared_ptr<T> from the raw pointer. A lambda using our
-        // _free() method is passed in as the new shared_ptr's destructor; it
-        // will move the associated unique_ptr back to freeNodes_ as soon as the
-        // shared_ptr's reference count goes to zero.
-        std::shared_ptr<T> sptr(rawPtr, [=](T* ptr){ this->free_(ptr); });
-
-        // Now shift the unique_ptr<T> ownership from freeNodes_ to nodesInUse_,
-        // and remove the associated node from freeNodes_.
-        nodesInUse_[rawPtr] = std::move(uPtr);
-        freeNodes_.pop_back();
-
-        return sptr;
+        // free_() method is passed in as the new shared_ptr's deleter; it
+        // will return the node to freeNodes_ as soon as the shared_ptr's
+        // reference count goes to zero. The control block comes from
+        // blockStore_.
+        return std::shared_ptr<T>(rawPtr, [=](T* ptr){ this->free_(ptr); },
+                                  ControlBlockAllocator<T>(&blockStore_));
     }
 
     /// @brief Return the count of all nodes in the pool (used and free)
@@ -141,7 +229,7 @@ public:
     size_t getInUseCount()
     {
         std::unique_lock<std::mutex> lock(mutex_);
-        return nodesInUse_.size();
+        return allNodes_.size() - freeNodes_.size();
     }
 
     /// @brief Set the total pool size to a given node count
@@ -153,51 +241,57 @@ public:
         std::unique_lock<std::mutex> lock(mutex_);
 
         // We can't resize smaller than the count of nodes currently in use
-        if (size < nodesInUse_.size()) {
+        size_t nInUse = allNodes_.size() - freeNodes_.size();
+        if (size < nInUse) {
             std::ostringstream os;
             os << "Cannot resize SharedPointerPool to " << size
-               << " nodes: " << nodesInUse_.size() << " nodes are in use!";
+               << " nodes: " << nInUse << " nodes are in use!";
             throw std::runtime_error(os.str());
         }
 
-        int delta = size - getCount();
-        if (delta == 0)
+        while (allNodes_.size() > size)
         {
-            // no change
-        }
-        else if (delta < 0)
-        {
-            // Permanently delete nodes from freeNodes()
-            for (int i = delta; i; i++)
+            // Permanently delete a free node
+            T* rawPtr = freeNodes_.back();
+            freeNodes_.pop_back();
+            for (size_t i = 0; i < allNodes_.size(); i++)
             {
-                freeNodes_.pop_back();
-                nodeCount_--;
+                if (allNodes_[i].get() == rawPtr)
+                {
+                    allNodes_.erase(allNodes_.begin() + i);
+                    break;
+                }
             }
+            nodeCount_--;
         }
-        else
+        while (allNodes_.size() < size)
         {
             // Add new free nodes
-            for (int i = 0; i < delta; i++)
-            {
-                freeNodes_.push_back(std::unique_ptr<T>(factoryFunction_()));
-                nodeCount_++;
-            }
+            addNode_();
         }
     }
 private:
 
-    /// @brief Move the unique_ptr associated with a given raw pointer from the
-    // "in use" list to the "free" list
+    /// @brief Create a new node and add it to the free list.
+    /// Must be called with mutex_ held.
+    void addNode_()
+    {
+        allNodes_.push_back(std::unique_ptr<T>(factoryFunction_()));
+        // reserve so that free_() never needs to grow the vector
+        freeNodes_.reserve(allNodes_.capacity());
+        blockStore_.reserve(allNodes_.capacity());
+        freeNodes_.push_back(allNodes_.back().get());
+        nodeCount_++;
+    }
+
+    /// @brief Return a node to the free list
     /// @param objPtr raw pointer to the node to be returned to the free list
     void free_(T* objPtr)
     {
         std::unique_lock<std::mutex> lock(mutex_);
-        /// Find the unique_ptr in nodesInUse_ and move it to freeNodes_
-        auto it = nodesInUse_.find(objPtr);
-        if (it != nodesInUse_.end())
+        if (freeNodes_.size() < allNodes_.size())
         {
-            freeNodes_.push_back(std::move(it->second));    // it->second is the unique_ptr<T>
-            nodesInUse_.erase(it);
+            freeNodes_.push_back(objPtr);
         }
         else
         {
@@ -206,8 +300,6 @@ private:
                << std::hex << objPtr;
             // Log the request to free an unknown node
             cerr << os.str() << endl;
-//            // Throw an exception if we were asked to free an unknown node
-//            throw std::runtime_error(os.str());
         }
     }
 
@@ -215,12 +307,14 @@ private:
     std::atomic<size_t> nodeCount_;
     std::mutex mutex_;
 
-    /// @brief Set of unique_ptr-s to all of the free nodes
-    std::vector<std::unique_ptr<T>> freeNodes_;
+    /// @brief unique_ptr-s to all of the nodes, free and in use
+    std::vector<std::unique_ptr<T>> allNodes_;
+
+    /// @brief Raw pointers to the free nodes
+    std::vector<T*> freeNodes_;
 
-    /// @brief Container mapping raw node pointers to unique_ptr-s of the
-    /// nodes currently in use
-    std::map<T*, std::unique_ptr<T>> nodesInUse_;
+    /// @brief Recycled shared_ptr control blocks
+    ControlBlockStore blockStore_;
 
     /// @brief Factory function taking no arguments which will return a pointer
     /// to a new T node
@@ -40,8 +40,6 @@
 #include "MomentsMgr.hh"
 #include <cassert>
 
-pthread_mutex_t ComputeThread::_fftMutex = PTHREAD_MUTEX_INITIALIZER;
-
 /////////////////////////////////
 // Generic thread
 
@@ -222,23 +220,20 @@ ComputeThread::~ComputeThread()
 
 }
 
-// create and destroy FFT objects in a thread safe manner
+// create and destroy FFT objects
+// RadarFft shares its plans through a thread-safe cache,
+// so no locking is needed here
 
 RadarFft *ComputeThread::createFft(size_t nSamples)
 
 {
-  pthread_mutex_lock(&_fftMutex);
-  RadarFft *fft = new RadarFft(nSamples);
-  pthread_mutex_unlock(&_fftMutex);
-  return fft;
+  return new RadarFft(nSamples);
 }
 
 void ComputeThread::destroyFft(RadarFft *fft)
 
 {
-  pthread_mutex_lock(&_fftMutex);
   delete fft;
-  pthread_mutex_unlock(&_fftMutex);
 }
 
 // initialize the FFTs
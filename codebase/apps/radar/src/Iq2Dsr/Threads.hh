@@ -161,7 +161,7 @@ public:
   void initRegrStag(const ForsytheRegrFilter &master);
 
   //////////////////////////////////////////////////////////////
-  // create and destroy FFT objects in a thread safe manner
+  // create and destroy FFT objects
   
   static RadarFft *createFft(size_t nSamples);
   static void destroyFft(RadarFft *fft);
@@ -205,7 +205,6 @@ public:
 
 private:
 
-  static pthread_mutex_t _fftMutex;
   Beam *_beam;
   bool _beamReadyForWrite;
 
@@ -1,6 +1,8 @@
 
 #include "FirstGuess.hh"
 #include "ClassIngest.hh"
+#include <Radx/RadxRay.hh>
+#include <Radx/RadxSweep.hh>
 
 using namespace std;
 
@@ -132,115 +134,15 @@ bool FirstGuess::firstGuess(Volume* soundVolume, time_t soundingTime)
   success = true;
 
   //
-  // Load and retrieve spdb sounding data
+  // Load the sounding and build the profile
   //
-  double *soundingU = NULL;
-  double *soundingV = NULL;
-  double *soundingAlt = NULL;
-  int numPoints = 0;
+  vector< vector<float> > ua_data;
   float missingValue = sounding.getMissingValue();
-
-  int ret =  loadSoundingData(soundingTime);
-  if( ret <= 0 ) {
-      // try reading a text file for the sounding
-      ClassIngest *classIngest = loadSoundingDataText(soundingTime);
-      if (classIngest != NULL) {
-        soundingU = classIngest->getU();
-        soundingV = classIngest->getV();
-        soundingAlt = classIngest->getAlts();
-        numPoints = classIngest->getNumPoints();
-        missingValue = classIngest->getMissingValue();
-        delete classIngest;
-      }
-      //success = false;
-      //return success;
-  } else {
-      // data in sounding is good, extract it
-      soundingU = sounding.getU();
-      soundingV = sounding.getV();
-      soundingAlt = sounding.getAlts();
-      numPoints = sounding.getNumPoints();
-      missingValue = sounding.getMissingValue();
+  if (_loadProfile(soundingTime, ua_data, numLevs, missingValue)) {
+    success = false;
+    return success;
   }
 
-  if( (soundingU == NULL) || (soundingV == NULL) || (soundingAlt == NULL) )
-    {
-      if (_debug)
-	      cerr << "Failed to obtain U and V from sounding. Sounding will not be used\n";
-      success = false;
-      return success;
-    }
-
-  //
-  // Allocate space for matrix to a hold sounding data and derived data
-  //
-  //int numPoints = sounding.getNumPoints();
-
-  float** ua_data = new float*[numPoints + 1];
-  
-  for (int i = 0; i < numPoints + 1 ; i++)
-    ua_data[i] = new float[5];
-
-  ua_data[0][0]=0.0;
-  ua_data[0][1]=0.0;
-  ua_data[0][2]=0.0;
-  ua_data[0][3]=0.0;
-  ua_data[0][4]=0.0;
-  
-
-  int k = 1;
-  //float missingValue = sounding.getMissingValue();
-  if (_debug) cerr << "sounding missing value = " << missingValue << endl;
-  for( int i = 0 ; i < numPoints; i++)
-    {
-      //
-      // Get U,V and Alt
-      //
-      ua_data[k][0] = soundingAlt[i];
-      ua_data[k][1] = soundingU[i];
-      ua_data[k][2] = soundingV[i];
-      
-      // TODO: what if the missing value for the sounding is different than
-      // the missing value for the velocity field?
-
-      if (ua_data[k][0] == missingValue || 
-	      ua_data[k][1] == missingValue ||
-	      ua_data[k][2]  == missingValue)
-	        continue;
-
-      //
-      // calculate shear U
-      //
-      ua_data[k][3]=(ua_data[k][1]-ua_data[k-1][1])/
-                     (ua_data[k][0]-ua_data[k-1][0]);
-
-      //
-      // calculate shear V
-      //
-      ua_data[k][4]=(ua_data[k][2]-ua_data[k-1][2])/
-                     (ua_data[k][0]-ua_data[k-1][0]);
-      
-      if (fabs( ua_data[k][3] ) <= _max_shear && 
-  	  fabs( ua_data[k][4] ) <= _max_shear )
-  	  {
-  	    k++; 
-  	  }
-       
-    }
-
-  numLevs = k - 1;
-
-  //
-  // Force wind at ground to be same as that of first level: 
-  //
-  ua_data[0][1] = ua_data[1][1];
-  ua_data[0][2] = ua_data[1][2];
-  ua_data[1][3] = 0.0;
-  ua_data[1][4] = 0.0;
-
-  if(_debug)
-    fprintf(stderr, "Number of sounding levels used: %d\n\n", numLevs);
-
   numSweeps = soundVolume->h.nsweeps;
 
   //
@@ -365,16 +267,279 @@ bool FirstGuess::firstGuess(Volume* soundVolume, time_t soundingTime)
   if (flag) 
     success = true;
 
+  return success;
+ 
+}
+
+/////////////////////////////////////////////////////////////////////////
+//
+//  METHOD: firstGuess, RadxVol version
+//
+//  DESCRIPTION:
+//      Same algorithm as the Volume version above, but the guess is
+//      computed from the ray geometry of a RadxVol, and returned as one
+//      float array per sweep, nRays * nGates long, ray by ray, in the
+//      order of the rays in the sweep.
+//
+//      The gate geometry is taken from the range geometry of the rays,
+//      in meters. Gates for which no guess is possible are set to
+//      missingVal, the velocity missing value, so that the guess can
+//      be compared directly with the velocity data.
+//
+//  Returns true on success, false if no sounding is available.
+//
+bool FirstGuess::firstGuess(const RadxVol &vol, time_t soundingTime,
+                            float missingVal,
+                            vector< vector<float> > &soundVals)
+{
+
+  soundVals.clear();
+
   //
-  // free memory 
+  // Load the sounding and build the profile
   //
-  for (int i = 0; i < numPoints + 1; i++)
-    delete[](ua_data[i]);
+  vector< vector<float> > ua_data;
+  int numLevs = 0;
+  float soundingMissing = sounding.getMissingValue();
+  if (_loadProfile(soundingTime, ua_data, numLevs, soundingMissing)) {
+    return false;
+  }
+  if (numLevs < 1) {
+    if (_debug) {
+      cerr << "No usable levels in sounding. Sounding will not be used" << endl;
+    }
+    return false;
+  }
+
+  float meanShearU = 0.0, meanShearV = 0.0;
+  float wind = 0.0, dir = 0.0;
+  bool haveGuess = false;
+
+  //
+  // Standard Atmosphere refractivity gradient in km^-1
+  //
+  float dRdz = -39.2464;
+  float ke = 1/(1+A*dRdz*pow(10.0,-6.0));
+  float alt = vol.getAltitudeKm() * 1000.0;
+
+  if(_debug)
+    fprintf(stderr,"Radar altitude: %g\n",alt);
+
+  const vector<RadxRay *> &rays = vol.getRays();
+  const vector<RadxSweep *> &sweeps = vol.getSweeps();
+  soundVals.resize(sweeps.size());
+
+  for (size_t isweep = 0; isweep < sweeps.size(); isweep++) {
+
+    const RadxSweep *sweep = sweeps[isweep];
+    size_t startRay = sweep->getStartRayIndex();
+    int numRays = sweep->getNRays();
+    if (numRays < 1) {
+      continue;
+    }
+    const RadxRay *ray0 = rays[startRay];
+    int numBins = ray0->getNGates();
+    float start_range = ray0->getStartRangeKm() * 1000.0;
+    float gate_size = ray0->getGateSpacingKm() * 1000.0;
+    float elev = PI * ray0->getElevationDeg() / 180.0;
+
+    vector<float> &guess = soundVals[isweep];
+    guess.resize(numRays * numBins, missingVal);
+
+    vector<float> az(numRays);
+    for (int iray = 0; iray < numRays; iray++) {
+      az[iray] = PI * rays[startRay + iray]->getAzimuthDeg() / 180.0;
+    }
+
+    int index = 0;
+
+    for (int i = 0; i < numBins; i++) {
+
+      float rnge = start_range + i*gate_size + gate_size/2.0;
+
+      //
+      // Doviak and Zrnic, 1993
+      //
+      float height = sqrt(pow(rnge,2) + pow(ke*A*1000,2) + 2*rnge*ke*A*1000
+                          *sin(elev))-ke*A*1000+alt;
+
+      float h_range = ke*A*1000*asin(rnge*cos(elev)/(ke*A*1000+height-alt));
+
+      //
+      //  atan (dh/ds)
+      //
+      float ang = atan(cos(elev)*sin(elev+h_range/ke/A/1000) *
+                       pow(cos( elev + h_range/ke/A/1000),-2));
+
+      float U = 0.0, V = 0.0;
+      bool haveWind = false;
+      if (height >= ua_data[0][0] && height <= ua_data[numLevs-1][0]) {
+        // walk the profile from the level used for the previous gate
+        while (index > 0 && height < ua_data[index][0]) {
+          index--;
+        }
+        while (index < numLevs-1 && height >= ua_data[index+1][0]) {
+          index++;
+        }
+        if (index < numLevs-1) {
+          U = ua_data[index][1] + ua_data[index+1][3] *
+            (height-ua_data[index][0]);
+          V = ua_data[index][2] + ua_data[index+1][4] *
+            (height-ua_data[index][0]);
+          haveWind = true;
+        }
+      } else if (height > ua_data[numLevs-1][0]) {
+        U = ua_data[numLevs-1][1] + meanShearU*
+          (height-ua_data[numLevs-1][0]);
+        V = ua_data[numLevs-1][2]+ meanShearV*
+          (height-ua_data[numLevs-1][0]);
+        haveWind = true;
+      }
+
+      if (haveWind) {
+        wind = sqrt(pow(U,2)+pow(V,2));
+        float offset = (_sign < 0) ? 0.0 : PI;
+        if (U >= 0) {
+          dir = (acos(V/wind)+offset) * 180/PI;
+        } else {
+          if (offset == PI)
+            dir = (offset-acos(V/wind)) * 180/PI;
+          else // offset == 0
+            dir = (2*PI - acos(V/wind)) * 180/PI;
+        }
+      }
+
+      if (wind >= 0.0 && dir >= 0.0) {
+        float wind_val = wind*cos(ang);
+        for (int iray = 0; iray < numRays; iray++) {
+          guess[iray * numBins + i] = wind_val*cos(PI*dir/180.0-az[iray]);
+        }
+        haveGuess = true;
+      }
+
+    } // i
+
+  } // isweep
+
+  return haveGuess;
+
+}
+
+/////////////////////////////////////////////////////////////////////////
+//
+// Load the sounding for the given time, from spdb or from a text file,
+// and build the profile table used by firstGuess(). Each row of
+// ua_data holds height (m), U, V, shear U and shear V. Row 0 is the
+// ground, and rows 1 to numLevs are the levels that passed the
+// missing and max_shear checks.
+//
+// missingValue is set to the missing value of the sounding used.
+//
+// Returns 0 on success, -1 if no sounding is available.
+//
+int FirstGuess::_loadProfile(time_t soundingTime,
+                             vector< vector<float> > &ua_data,
+                             int &numLevs,
+                             float &missingValue)
+{
+
+  //
+  // Load and retrieve spdb sounding data
+  //
+  vector<double> soundingU, soundingV, soundingAlt;
+
+  int ret =  loadSoundingData(soundingTime);
+  if( ret <= 0 ) {
+    // try reading a text file for the sounding
+    ClassIngest *classIngest = loadSoundingDataText(soundingTime);
+    if (classIngest != NULL) {
+      // copy the profile, since classIngest owns the arrays
+      int numPoints = classIngest->getNumPoints();
+      if (classIngest->getU() != NULL && classIngest->getV() != NULL &&
+          classIngest->getAlts() != NULL) {
+        soundingU.assign(classIngest->getU(), classIngest->getU() + numPoints);
+        soundingV.assign(classIngest->getV(), classIngest->getV() + numPoints);
+        soundingAlt.assign(classIngest->getAlts(),
+                           classIngest->getAlts() + numPoints);
+      }
+      missingValue = classIngest->getMissingValue();
+      delete classIngest;
+    }
+  } else {
+    // data in sounding is good, extract it
+    int numPoints = sounding.getNumPoints();
+    if (sounding.getU() != NULL && sounding.getV() != NULL &&
+        sounding.getAlts() != NULL) {
+      soundingU.assign(sounding.getU(), sounding.getU() + numPoints);
+      soundingV.assign(sounding.getV(), sounding.getV() + numPoints);
+      soundingAlt.assign(sounding.getAlts(), sounding.getAlts() + numPoints);
+    }
+    missingValue = sounding.getMissingValue();
+  }
+
+  if (soundingU.size() == 0) {
+    if (_debug)
+      cerr << "Failed to obtain U and V from sounding. Sounding will not be used\n";
+    return -1;
+  }
+
+  //
+  // matrix to hold sounding data and derived data
+  //
+  int numPoints = soundingU.size();
+  ua_data.assign(numPoints + 1, vector<float>(5, 0.0));
+
+  int k = 1;
+  if (_debug) cerr << "sounding missing value = " << missingValue << endl;
+  for( int i = 0 ; i < numPoints; i++)
+    {
+      //
+      // Get U,V and Alt
+      //
+      ua_data[k][0] = soundingAlt[i];
+      ua_data[k][1] = soundingU[i];
+      ua_data[k][2] = soundingV[i];
+      
+      if (ua_data[k][0] == missingValue || 
+	      ua_data[k][1] == missingValue ||
+	      ua_data[k][2]  == missingValue)
+	        continue;
+
+      //
+      // calculate shear U
+      //
+      ua_data[k][3]=(ua_data[k][1]-ua_data[k-1][1])/
+                     (ua_data[k][0]-ua_data[k-1][0]);
+
+      //
+      // calculate shear V
+      //
+      ua_data[k][4]=(ua_data[k][2]-ua_data[k-1][2])/
+                     (ua_data[k][0]-ua_data[k-1][0]);
+      
+      if (fabs( ua_data[k][3] ) <= _max_shear && 
+  	  fabs( ua_data[k][4] ) <= _max_shear )
+  	  {
+  	    k++; 
+  	  }
+       
+    }
+
+  numLevs = k - 1;
+
+  //
+  // Force wind at ground to be same as that of first level: 
+  //
+  ua_data[0][1] = ua_data[1][1];
+  ua_data[0][2] = ua_data[1][2];
+  ua_data[1][3] = 0.0;
+  ua_data[1][4] = 0.0;
+
+  if(_debug)
+    fprintf(stderr, "Number of sounding levels used: %d\n\n", numLevs);
+
+  return 0;
 
-  delete[](ua_data);
-     
-  return success;
- 
 }
 
 
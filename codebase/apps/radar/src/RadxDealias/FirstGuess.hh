@@ -68,6 +68,8 @@
 #include <toolsa/DateTime.hh>
 #include <toolsa/mem.h>
 #include "ClassIngest.hh"
+#include <Radx/RadxVol.hh>
+#include <vector>
 //#include "Params.hh"
 using namespace std;
 
@@ -90,6 +92,14 @@ public:
  
   bool firstGuess(Volume* soundVolume, time_t volTime);
 
+  // first guess from the ray geometry of a RadxVol;
+  // soundVals[isweep] is filled with nRays * nGates values, ray by ray.
+  // Gates with no guess are set to missingVal.
+
+  bool firstGuess(const RadxVol &vol, time_t volTime,
+                  float missingVal,
+                  vector< vector<float> > &soundVals);
+
   int loadSoundingData(time_t issueTime);
 
   ClassIngest *loadSoundingDataText(time_t issueTime);
@@ -109,6 +119,10 @@ private:
   float  _avg_wind_v;
   float  _max_shear;
   int    _sign;
+
+  int _loadProfile(time_t soundingTime,
+                   vector< vector<float> > &ua_data,
+                   int &numLevs, float &missingValue);
   
   // float  _missingVal;
 
@@ -763,6 +763,32 @@
     tt->single_val.s = tdrpStrDup("Test");
     tt++;
     
+    // Parameter 'use_rsl_dealiaser'
+    // ctype is 'tdrp_bool_t'
+    
+    memset(tt, 0, sizeof(TDRPtable));
+    tt->ptype = BOOL_TYPE;
+    tt->param_name = tdrpStrDup("use_rsl_dealiaser");
+    tt->descr = tdrpStrDup("Option to dealias using the legacy RSL Volume structures.");
+    tt->help = tdrpStrDup("If FALSE, the 4DD algorithm runs directly on the RadxVol float arrays, using azimuth lookup tables to match rays between sweeps and volumes, and dealiasing sweeps in parallel as soon as the sweep above and the matching sweep in the previous volume are done. If TRUE, each volume is copied into RSL Volume structures and dealiased one sweep at a time, as in earlier versions. The default is TRUE until the RadxVol path has been checked against the RSL path by a regression test.");
+    tt->val_offset = (char *) &use_rsl_dealiaser - &_start_;
+    tt->single_val.b = pTRUE;
+    tt++;
+    
+    // Parameter 'n_threads'
+    // ctype is 'int'
+    
+    memset(tt, 0, sizeof(TDRPtable));
+    tt->ptype = INT_TYPE;
+    tt->param_name = tdrpStrDup("n_threads");
+    tt->descr = tdrpStrDup("Number of threads for dealiasing.");
+    tt->help = tdrpStrDup("Not used if use_rsl_dealiaser is TRUE. In ARCHIVE and FILELIST mode, up to n_threads volumes are read at a time, and their sweeps are dealiased as a pipeline: sweep s of volume v may run as soon as sweep s+1 of volume v and sweep s of volume v-1 are done. In REALTIME mode volumes are handled one at a time, so the threads only share the setup of each sweep.");
+    tt->val_offset = (char *) &n_threads - &_start_;
+    tt->has_min = TRUE;
+    tt->min_val.i = 1;
+    tt->single_val.i = 4;
+    tt++;
+    
     // Parameter 'required_fields'
     // ctype is 'char*'
     
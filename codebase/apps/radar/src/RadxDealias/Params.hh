@@ -415,6 +415,10 @@ public:
 
   char* instance;
 
+  tdrp_bool_t use_rsl_dealiaser;
+
+  int n_threads;
+
   char* *_required_fields;
   int required_fields_n;
 
@@ -503,7 +507,7 @@ private:
 
   void _init();
 
-  mutable TDRPtable _table[62];
+  mutable TDRPtable _table[64];
 
   const char *_className;
 
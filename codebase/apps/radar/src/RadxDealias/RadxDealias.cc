@@ -28,6 +28,7 @@
 /////////////////////////////////////////////////////////
 
 #include <stdexcept>
+#include <algorithm>
 #include <toolsa/umisc.h>
 #include <toolsa/pmu.h>
 #include <toolsa/mem.h>
@@ -51,6 +52,8 @@ using namespace std;
 RadxDealias::RadxDealias(int argc, char **argv)
 {
   isOK = true;
+  _fourDD = NULL;
+  _radxFourDD = NULL;
 
   //
   // set programe name
@@ -100,6 +103,10 @@ RadxDealias::~RadxDealias()
 
 {
 
+  if (_radxFourDD != NULL) {
+    delete _radxFourDD;
+  }
+
   //
   // unregister process
   //
@@ -188,6 +195,12 @@ int RadxDealias::Run()
 		      _params.min_good,
 		      (float) _params.std_thresh);
 
+  // the RadxVol dealiaser, unless the RSL version is requested
+
+  if (!_params.use_rsl_dealiaser) {
+    _radxFourDD = new RadxFourDD(_params);
+  }
+
 
   try {
   // build the list of files depending on the mode
@@ -260,6 +273,16 @@ int RadxDealias::_processOne(string filePath)
     cerr << "processingOne volume from file ..." << filePath << endl;
   }
 
+  if (_radxFourDD != NULL) {
+    // dealias directly on the RadxVol
+    int nGood = 0, nError = 0;
+    _processBatch(vector<string>(1, filePath), nGood, nError);
+    if (nError > 0) {
+      throw "ERROR - RadxDealias::_processOne - volume not dealiased";
+    }
+    return iret;
+  }
+
   static Volume *prevVelVol = NULL;
   Volume *currVelVol = NULL;    
   Volume *currDbzVol = NULL;
@@ -269,29 +292,12 @@ int RadxDealias::_processOne(string filePath)
   // read input file
   _readFile(filePath, vol);
 
-  vol.sortSweepRaysByAzimuth();
-
-  vol.loadFieldsFromRays();
+  _prepareVol(vol);
 
-  // TODO: force same geometry ...
-  //void remapToPredomGeom(); 
-  //then                      
-  //remapRangeGeom(double startRangeKm,
-  //             double gateSpacingKm, 
-  //             bool interp = false);  
-  vol.remapToFinestGeom();
-
-  vol.setNGatesConstant();
-
-  vol.convertToFl32(); // does FourDD use signed ints? No, it seems to use floats
- 
   string velocityFieldName = _params._required_fields[1];
   float nyquist_mps = 0.0; 
   if (_params.nyquist_mps != 0.0) { // then use the Nyquist frequency from the the param file
     nyquist_mps = _params.nyquist_mps;
-  } else { // estimate the Nyquist frequency from the max velocity of the volume
-    vol.estimateSweepNyquistFromVel(velocityFieldName);
-    // this puts the estimate in each ray; to be used in the extractFieldData step below
   }
 
   // convert from RadxVol to Volume structures
@@ -382,6 +388,34 @@ int RadxDealias::_runWithCompleteFileList(vector<string> fileList)
   int nGood = 0;
   int nError = 0;
 
+  if (_radxFourDD != NULL) {
+
+    // dealias n_threads volumes at a time, so that the sweeps
+    // of successive volumes can be pipelined
+
+    size_t batchSize = _params.n_threads;
+    if (batchSize < 1) {
+      batchSize = 1;
+    }
+    for (size_t ii = 0; ii < fileList.size(); ii += batchSize) {
+      size_t end = min(ii + batchSize, fileList.size());
+      vector<string> batch(fileList.begin() + ii, fileList.begin() + end);
+      _processBatch(batch, nGood, nError);
+      statusReport(nError, nGood);
+    }
+    if (nError > 0) {
+      iret = -1;
+    }
+
+    if (_params.debug) {
+      cerr << "RadxDealias done" << endl;
+      cerr << "====>> n good files processed: " << nGood << endl;
+    }
+
+    return iret;
+
+  }
+
   // loop through the file list
 
   for (int ii = 0; ii < (int) fileList.size(); ii++) {
@@ -619,6 +653,145 @@ void RadxDealias::_readFile(const string &readPath,
 
 }
 
+//////////////////////////////////////////////////
+// Prepare a volume for dealiasing:
+// sort the rays, force a constant gate geometry, convert to floats
+// and, unless the Nyquist velocity is set in the params, estimate
+// it from the velocities in each sweep
+
+void RadxDealias::_prepareVol(RadxVol &vol)
+{
+
+  vol.sortSweepRaysByAzimuth();
+
+  vol.loadFieldsFromRays();
+
+  // TODO: force same geometry ...
+  //void remapToPredomGeom(); 
+  //then                      
+  //remapRangeGeom(double startRangeKm,
+  //             double gateSpacingKm, 
+  //             bool interp = false);  
+  vol.remapToFinestGeom();
+
+  vol.setNGatesConstant();
+
+  vol.convertToFl32(); // does FourDD use signed ints? No, it seems to use floats
+ 
+  if (_params.nyquist_mps == 0.0) {
+    // estimate the Nyquist frequency from the max velocity of the volume
+    // this puts the estimate in each ray
+    vol.estimateSweepNyquistFromVel(_params._required_fields[1]);
+  }
+
+}
+
+//////////////////////////////////////////////////
+// Dealias a batch of files, in time order, using RadxFourDD.
+// The volumes are read and given a first guess one at a time,
+// then dealiased together so that the sweeps of successive
+// volumes can be processed in parallel.
+// nGood and nError are incremented for each file.
+
+void RadxDealias::_processBatch(const vector<string> &filePaths,
+                                int &nGood, int &nError)
+{
+
+  FirstGuess firstGuess(
+			_params.debug >= Params::DEBUG_VERBOSE,
+			_params.sounding_url,
+			(float) _params.sounding_look_back,
+			(float) _params.wind_alt_min,
+			(float) _params.wind_alt_max,
+			(float) _params.avg_wind_u,
+			(float) _params.avg_wind_v,
+			(float) _params.max_shear,         
+			_params.sign);
+
+  // read the volumes
+
+  vector<RadxFourDD::VolInput> inputs;
+  vector<string> paths;
+
+  for (size_t ii = 0; ii < filePaths.size(); ii++) {
+
+    if (_params.debug) {
+      cerr << "processing volume from file ..." << filePaths[ii] << endl;
+    }
+
+    RadxVol *vol = new RadxVol;
+    try {
+      _readFile(filePaths[ii], *vol);
+    } catch (...) {
+      cerr << "ERROR - RadxDealias::_processBatch" << endl;
+      cerr << "  Cannot read file: " << filePaths[ii] << endl;
+      delete vol;
+      nError++;
+      continue;
+    }
+
+    // the dealiaser will not run without the required fields
+
+    vector<string> fieldNames = vol->getUniqueFieldNameList();
+    bool fieldsOk = true;
+    for (int jj = 0; jj < _params.required_fields_n; jj++) {
+      if (find(fieldNames.begin(), fieldNames.end(),
+               string(_params._required_fields[jj])) == fieldNames.end()) {
+        cerr << "ERROR - RadxDealias::_processBatch" << endl;
+        cerr << "  No field " << _params._required_fields[jj]
+             << " in file: " << filePaths[ii] << endl;
+        fieldsOk = false;
+      }
+    }
+    if (!fieldsOk) {
+      delete vol;
+      nError++;
+      continue;
+    }
+
+    _prepareVol(*vol);
+
+    RadxFourDD::VolInput input;
+    input.vol = vol;
+    input.volTime = vol->getStartTimeSecs();
+    input.soundOk =
+      firstGuess.firstGuess(*vol, input.volTime,
+                            _radxFourDD->getMissingValue(*vol),
+                            input.soundVals);
+    inputs.push_back(input);
+    paths.push_back(filePaths[ii]);
+
+  } // ii
+
+  // dealias
+
+  vector<int> status;
+  _radxFourDD->dealias(inputs, status);
+
+  // write out, in order
+
+  for (size_t ii = 0; ii < inputs.size(); ii++) {
+    RadxVol *vol = inputs[ii].vol;
+    if (status[ii] == 0) {
+      vol->loadFieldsFromRays();
+      try {
+        _writeVol(*vol);
+        nGood++;
+      } catch (...) {
+        cerr << "ERROR - RadxDealias::_processBatch" << endl;
+        cerr << "  Cannot write volume for file: " << paths[ii] << endl;
+        nError++;
+      }
+    } else {
+      cerr << "ERROR - RadxDealias::_processBatch" << endl;
+      cerr << "  Volume not dealiased, file: " << paths[ii] << endl;
+      nError++;
+    }
+    delete vol;
+  }
+
+}
+
 //////////////////////////////////////////////////
 // write out the volume
 // if errors encountered, throw a string exception
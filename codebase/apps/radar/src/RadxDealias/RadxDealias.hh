@@ -50,6 +50,7 @@
 #include <Radx/RadxVol.hh>
 #include "Rsl.hh"
 #include "FourDD.hh"
+#include "RadxFourDD.hh"
 using namespace std;
 
 class RadxDealias {
@@ -73,6 +74,9 @@ private:
   void _readFile(const string &filePath, RadxVol &vol);
 
   int _processOne(string filePath);
+  void _processBatch(const vector<string> &filePaths,
+                     int &nGood, int &nError);
+  void _prepareVol(RadxVol &vol);
   int _runWithCompleteFileList(vector<string> fileList);
   int _runRealtimeWithLdata();
   int _runRealtimeNoLdata();
@@ -129,6 +133,7 @@ private:
   // Dealiser methods
   //
   FourDD    *_fourDD;
+  RadxFourDD *_radxFourDD;
 
   //
   // Copyright inforamtion for the 4DD algorithm
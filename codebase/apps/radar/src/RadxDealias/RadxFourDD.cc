@@ -0,0 +1,1229 @@
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*
+// ** Copyright UCAR (c) 1990 - 2016
+// ** University Corporation for Atmospheric Research (UCAR)
+// ** National Center for Atmospheric Research (NCAR)
+// ** Boulder, Colorado, USA
+// ** BSD licence applies - redistribution and use in source and binary
+// ** forms, with or without modification, are permitted provided that
+// ** the following conditions are met:
+// ** 1) If the software is modified to produce derivative works,
+// ** such modified software should be clearly marked, so as not
+// ** to confuse it with the version available from UCAR.
+// ** 2) Redistributions of source code must retain the above copyright
+// ** notice, this list of conditions and the following disclaimer.
+// ** 3) Redistributions in binary form must reproduce the above copyright
+// ** notice, this list of conditions and the following disclaimer in the
+// ** documentation and/or other materials provided with the distribution.
+// ** 4) Neither the name of UCAR nor the names of its contributors,
+// ** if any, may be used to endorse or promote products derived from
+// ** this software without specific prior written permission.
+// ** DISCLAIMER: THIS SOFTWARE IS PROVIDED "AS IS" AND WITHOUT ANY EXPRESS
+// ** OR IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+// ** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*
+/////////////////////////////////////////////////////////
+//
+// RadxFourDD.cc: 4DD dealiasing on RadxVol data
+//
+// The passes follow FourDD.cc closely, including the order in
+// which gates are visited, since the spatial continuity pass
+// depends on it. See FourDD.cc for the description of each pass.
+//
+/////////////////////////////////////////////////////////
+
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <Radx/RadxRay.hh>
+#include <Radx/RadxTime.hh>
+#include <Radx/RadxSweep.hh>
+#include <Radx/RadxField.hh>
+#include "RadxFourDD.hh"
+
+using namespace std;
+
+// state values, as in FourDD
+
+static const short UNSUCCESSFUL = FourDD::UNSUCCESSFUL;
+static const short MISSING = FourDD::MISSING;
+static const short TBD = FourDD::TBD;
+static const short DEALIASED = FourDD::DEALIASED;
+
+// wrap a ray index into 0 to nRays-1
+
+static inline int _wrapRay(int iray, int nRays)
+{
+  iray %= nRays;
+  if (iray < 0) {
+    iray += nRays;
+  }
+  return iray;
+}
+
+///////////////////////////////////////////////////////
+// Constructor
+
+RadxFourDD::RadxFourDD(const Params &params) :
+        _params(params),
+        _fourDD(false),
+        _prevVol(NULL)
+{
+
+  _velName = _params._required_fields[1];
+  _unfName = _velName + "_UNF";
+
+  _delNumBins = _params.del_num_bins;
+  if (_delNumBins < 0) {
+    _delNumBins = 0;
+  }
+
+  // thresholds, with the same fallbacks as FourDD::unfoldVolume()
+
+  if (_params.comp_thresh > 1.0 || _params.comp_thresh <= 0.0) {
+    _fraction = 0.25;
+  } else {
+    _fraction = _params.comp_thresh;
+  }
+  if (_params.comp_thresh2 > 1.0 || _params.comp_thresh2 <= 0.0) {
+    _fraction2 = 0.49;
+  } else {
+    _fraction2 = _params.comp_thresh2;
+  }
+  if (_params.thresh > 1.0 || _params.thresh <= 0.0) {
+    _pfraction = 0.4;
+  } else {
+    _pfraction = _params.thresh;
+  }
+
+}
+
+///////////////////////////////////////////////////////
+// Destructor
+
+RadxFourDD::~RadxFourDD()
+{
+  clearPrevious();
+}
+
+///////////////////////////////////////////////////////
+// forget the previous volume
+
+void RadxFourDD::clearPrevious()
+{
+  if (_prevVol != NULL) {
+    delete _prevVol;
+    _prevVol = NULL;
+  }
+}
+
+///////////////////////////////////////////////////////
+// velocity missing value for a volume - taken from the velocity
+// field, as for the RSL volumes, unless overridden by the params
+
+float RadxFourDD::getMissingValue(const RadxVol &vol) const
+{
+  if (_params.override_missing_field_values) {
+    return _params.velocity_field_missing_value;
+  }
+  float missing = 0.0;
+  const vector<RadxRay *> &rays = vol.getRays();
+  for (size_t iray = 0; iray < rays.size(); iray++) {
+    const RadxField *velField = rays[iray]->getField(_velName);
+    if (velField != NULL) {
+      missing = velField->getMissingFl32();
+    }
+  }
+  return missing;
+}
+
+///////////////////////////////////////////////////////
+// Dealias a batch of volumes, in time order.
+// Returns 0 if all volumes succeeded, -1 otherwise.
+
+int RadxFourDD::dealias(vector<VolInput> &inputs, vector<int> &status)
+{
+
+  int iret = 0;
+  size_t nVols = inputs.size();
+  status.assign(nVols, 0);
+  if (nVols == 0) {
+    return 0;
+  }
+
+  // set up the volumes, and decide how each one is to be handled.
+  // A volume is seeded by the last good volume before it.
+
+  vector<Vol> vols(nVols);
+  const Vol *prev = _prevVol;
+  int nSweepsTotal = 0;
+
+  for (size_t ivol = 0; ivol < nVols; ivol++) {
+
+    Vol &vol = vols[ivol];
+    vol.input = &inputs[ivol];
+
+    if (_initVol(vol)) {
+      vol.failed = true;
+      status[ivol] = -1;
+      iret = -1;
+      continue;
+    }
+
+    vol.prev = prev;
+    int nSweeps = vol.sweeps.size();
+
+    if (prev != NULL && (int) prev->sweeps.size() != nSweeps) {
+      // 4DD requires the previous volume to have the same sweeps
+      cerr << "WARNING - RadxFourDD::dealias" << endl;
+      cerr << "  Cannot dealias velocity volumes of different sizes" << endl;
+      cerr << "  Volume time: "
+           << RadxTime::strm(vol.input->volTime) << endl;
+      vol.prev = NULL;
+    } else if (_params.output_soundVol) {
+      // debug option - output the first guess instead
+      if (vol.input->soundOk) {
+        for (int isweep = 0; isweep < nSweeps; isweep++) {
+          Sweep &sweep = vol.sweeps[isweep];
+          if (sweep.sound == NULL) {
+            continue;
+          }
+          for (int iray = 0; iray < sweep.nRays; iray++) {
+            memcpy(sweep.unf[iray], sweep.sound + iray * sweep.nGates,
+                   sweep.nGates * sizeof(Radx::fl32));
+          }
+        }
+        cerr << "REPLACED VELOCITY DATA WITH SOUNDING DATA!!" << endl;
+      }
+    } else {
+      vol.doDealias = (vol.input->soundOk || prev != NULL);
+    }
+
+    if (vol.doDealias) {
+      // sanity check the Nyquist velocity
+      for (int isweep = 0; isweep < nSweeps; isweep++) {
+        if (fabs(vol.sweeps[isweep].nyquist * _pfraction) < 1) {
+          cerr << "ERROR - RadxFourDD::dealias" << endl;
+          cerr << "  Nyquist velocity too small: "
+               << vol.sweeps[isweep].nyquist << endl;
+          cerr << "  Volume time: "
+               << RadxTime::strm(vol.input->volTime)
+               << ", sweep index: " << isweep << endl;
+          vol.failed = true;
+          vol.doDealias = false;
+          status[ivol] = -1;
+          iret = -1;
+          break;
+        }
+      }
+    }
+
+    if (vol.doDealias) {
+      vol.sweepStatus.assign(nSweeps, SWEEP_WAITING);
+      nSweepsTotal += nSweeps;
+    } else if (_params.debug && !vol.failed) {
+      cerr << "Velocity volume was NOT unfolded, time: "
+           << RadxTime::strm(vol.input->volTime) << endl;
+    }
+
+    if (!vol.failed) {
+      prev = &vol;
+    }
+
+  } // ivol
+
+  // run the sweeps
+
+  if (nSweepsTotal > 0) {
+
+    Task task;
+    task.obj = this;
+    for (size_t ivol = 0; ivol < nVols; ivol++) {
+      if (vols[ivol].doDealias) {
+        task.vols.push_back(&vols[ivol]);
+      }
+    }
+    task.nTotal = nSweepsTotal;
+
+    // prepare all sweeps, independently
+
+    task.nDone = 0;
+    task.nextSetup = 0;
+    _runThreads(task, _setupThreadMain);
+
+    // then dealias, as the dependencies allow
+
+    task.nDone = 0;
+    _runThreads(task, _dealiasThreadMain);
+
+    if (_params.debug) {
+      for (size_t ii = 0; ii < task.vols.size(); ii++) {
+        cerr << "Velocity volume was unfolded, time: "
+             << RadxTime::strm(task.vols[ii]->input->volTime) << endl;
+      }
+    }
+
+  }
+
+  // keep the last good volume, to seed the next batch
+
+  for (int ivol = (int) nVols - 1; ivol >= 0; ivol--) {
+    if (!vols[ivol].failed) {
+      _keepAsPrevious(vols[ivol]);
+      break;
+    }
+  }
+
+  return iret;
+
+}
+
+///////////////////////////////////////////////////////
+// Set up a volume - add the _UNF field to the rays, as a copy of
+// the velocity field, and set up the sweeps.
+// Returns 0 on success, -1 on failure.
+
+int RadxFourDD::_initVol(Vol &vol)
+{
+
+  RadxVol &rvol = *vol.input->vol;
+  const vector<RadxRay *> &rays = rvol.getRays();
+  const vector<RadxSweep *> &sweeps = rvol.getSweeps();
+
+  for (size_t iray = 0; iray < rays.size(); iray++) {
+    RadxField *velField = rays[iray]->getField(_velName);
+    if (velField == NULL || velField->getDataType() != Radx::FL32) {
+      cerr << "ERROR - RadxFourDD::_initVol" << endl;
+      cerr << "  No fl32 velocity field in ray: " << _velName << endl;
+      cerr << "  Volume time: "
+           << RadxTime::strm(vol.input->volTime) << endl;
+      return -1;
+    }
+  }
+  vol.missing = getMissingValue(rvol);
+
+  vol.sweeps.resize(sweeps.size());
+
+  for (size_t isweep = 0; isweep < sweeps.size(); isweep++) {
+
+    Sweep &sweep = vol.sweeps[isweep];
+    size_t startRay = sweeps[isweep]->getStartRayIndex();
+    sweep.nRays = sweeps[isweep]->getNRays();
+    if (sweep.nRays < 1) {
+      cerr << "ERROR - RadxFourDD::_initVol" << endl;
+      cerr << "  No rays in sweep index: " << isweep << endl;
+      return -1;
+    }
+    sweep.nGates = rays[startRay]->getNGates();
+
+    if (_params.nyquist_mps != 0.0) {
+      sweep.nyquist = _params.nyquist_mps;
+    } else {
+      sweep.nyquist = rays[startRay]->getNyquistMps();
+    }
+
+    sweep.az.resize(sweep.nRays);
+    sweep.unf.resize(sweep.nRays);
+
+    for (int iray = 0; iray < sweep.nRays; iray++) {
+      RadxRay *ray = rays[startRay + iray];
+      if ((int) ray->getNGates() != sweep.nGates) {
+        cerr << "ERROR - RadxFourDD::_initVol" << endl;
+        cerr << "  Number of gates varies in sweep index: " << isweep << endl;
+        return -1;
+      }
+      sweep.az[iray] = ray->getAzimuthDeg();
+      RadxField *velField = ray->getField(_velName);
+      RadxField *unfField =
+        ray->addField(_unfName, velField->getUnits(), sweep.nGates,
+                      (Radx::fl32) vol.missing,
+                      velField->getDataFl32(), true);
+      sweep.unf[iray] = unfField->getDataFl32();
+    }
+
+    sweep.lookup.init(sweep.az);
+
+    if (vol.input->soundOk && isweep < vol.input->soundVals.size() &&
+        (int) vol.input->soundVals[isweep].size() ==
+        sweep.nRays * sweep.nGates) {
+      sweep.sound = vol.input->soundVals[isweep].data();
+    }
+
+  } // isweep
+
+  return 0;
+
+}
+
+///////////////////////////////////////////////////////
+// Keep a copy of the dealiased data from a volume,
+// to seed the next batch
+
+void RadxFourDD::_keepAsPrevious(Vol &vol)
+{
+
+  Vol *keep = new Vol;
+  keep->missing = vol.missing;
+  keep->sweeps.resize(vol.sweeps.size());
+  keep->sweepStatus.assign(vol.sweeps.size(), SWEEP_DONE);
+
+  for (size_t isweep = 0; isweep < vol.sweeps.size(); isweep++) {
+    const Sweep &from = vol.sweeps[isweep];
+    Sweep &to = keep->sweeps[isweep];
+    to.nRays = from.nRays;
+    to.nGates = from.nGates;
+    to.nyquist = from.nyquist;
+    to.az = from.az;
+    to.lookup = from.lookup;
+    to.kept.resize(from.nRays * from.nGates);
+    to.unf.resize(from.nRays);
+    for (int iray = 0; iray < from.nRays; iray++) {
+      float *dest = to.kept.data() + iray * from.nGates;
+      memcpy(dest, from.unf[iray], from.nGates * sizeof(float));
+      to.unf[iray] = dest;
+    }
+  }
+
+  clearPrevious();
+  _prevVol = keep;
+
+}
+
+///////////////////////////////////////////////////////
+// Run the threads for a stage of the batch.
+// The calling thread also does work.
+
+void RadxFourDD::_runThreads(Task &task, void *(*threadMain)(void *))
+{
+
+  pthread_mutex_init(&task.mutex, NULL);
+  pthread_cond_init(&task.cond, NULL);
+
+  int nThreads = _params.n_threads;
+  if (nThreads > task.nTotal) {
+    nThreads = task.nTotal;
+  }
+
+  vector<pthread_t> threads;
+  for (int ii = 1; ii < nThreads; ii++) {
+    pthread_t thread;
+    if (pthread_create(&thread, NULL, threadMain, &task) == 0) {
+      threads.push_back(thread);
+    }
+  }
+
+  threadMain(&task);
+
+  for (size_t ii = 0; ii < threads.size(); ii++) {
+    pthread_join(threads[ii], NULL);
+  }
+
+  pthread_cond_destroy(&task.cond);
+  pthread_mutex_destroy(&task.mutex);
+
+}
+
+void *RadxFourDD::_setupThreadMain(void *args)
+{
+  _setupSweeps(*((Task *) args));
+  return NULL;
+}
+
+void *RadxFourDD::_dealiasThreadMain(void *args)
+{
+  _dealiasSweeps(*((Task *) args));
+  return NULL;
+}
+
+///////////////////////////////////////////////////////
+// Prepare the sweeps - these do not depend on each other,
+// so they are simply handed out in turn
+
+void RadxFourDD::_setupSweeps(Task &task)
+{
+
+  for (;;) {
+
+    pthread_mutex_lock(&task.mutex);
+    int next = task.nextSetup++;
+    pthread_mutex_unlock(&task.mutex);
+
+    if (next >= task.nTotal) {
+      break;
+    }
+
+    for (size_t ii = 0; ii < task.vols.size(); ii++) {
+      int nSweeps = task.vols[ii]->sweeps.size();
+      if (next < nSweeps) {
+        task.obj->_prepSweep(*task.vols[ii], next);
+        break;
+      }
+      next -= nSweeps;
+    }
+
+  }
+
+}
+
+///////////////////////////////////////////////////////
+// Dealias the sweeps. A sweep is ready once the sweep above it,
+// and the same sweep in the previous volume, are done. Ready sweeps
+// are taken from the earliest volume first, so that the volumes
+// are finished in order.
+
+void RadxFourDD::_dealiasSweeps(Task &task)
+{
+
+  pthread_mutex_lock(&task.mutex);
+
+  while (task.nDone < task.nTotal) {
+
+    Vol *vol = NULL;
+    int isweep = -1;
+    for (size_t ii = 0; ii < task.vols.size() && vol == NULL; ii++) {
+      Vol *candidate = task.vols[ii];
+      for (int jj = (int) candidate->sweeps.size() - 1; jj >= 0; jj--) {
+        if (_sweepReady(*candidate, jj)) {
+          vol = candidate;
+          isweep = jj;
+          break;
+        }
+      }
+    }
+
+    if (vol == NULL) {
+      pthread_cond_wait(&task.cond, &task.mutex);
+      continue;
+    }
+
+    vol->sweepStatus[isweep] = SWEEP_RUNNING;
+    pthread_mutex_unlock(&task.mutex);
+
+    task.obj->_dealiasSweep(*vol, isweep);
+
+    pthread_mutex_lock(&task.mutex);
+    vol->sweepStatus[isweep] = SWEEP_DONE;
+    task.nDone++;
+    pthread_cond_broadcast(&task.cond);
+
+  }
+
+  pthread_mutex_unlock(&task.mutex);
+
+}
+
+///////////////////////////////////////////////////////
+// Is a sweep ready to be dealiased?
+// Called with the task mutex locked.
+
+bool RadxFourDD::_sweepReady(const Vol &vol, int isweep)
+{
+  if (vol.sweepStatus[isweep] != SWEEP_WAITING) {
+    return false;
+  }
+  int nSweeps = vol.sweeps.size();
+  if (isweep < nSweeps - 1 && vol.sweepStatus[isweep + 1] != SWEEP_DONE) {
+    return false;
+  }
+  if (vol.prev != NULL && !vol.prev->sweepStatus.empty() &&
+      vol.prev->sweepStatus[isweep] != SWEEP_DONE) {
+    return false;
+  }
+  return true;
+}
+
+///////////////////////////////////////////////////////
+// Prepare a sweep for dealiasing.
+//
+// If directed, remove velocities near the radar, and where the
+// reflectivity is missing or outside the limits, as in
+// FourDD::prepVolume(). Then keep a copy of the velocities and
+// set the initial STATE, applying the 3x3 filter if directed.
+
+void RadxFourDD::_prepSweep(Vol &vol, int isweep)
+{
+
+  Sweep &sweep = vol.sweeps[isweep];
+  int nGates = sweep.nGates;
+  float missing = vol.missing;
+
+  if (_params.prep) {
+    const vector<RadxRay *> &rays = vol.input->vol->getRays();
+    size_t startRay =
+      vol.input->vol->getSweeps()[isweep]->getStartRayIndex();
+    string dbzName = _params._required_fields[0];
+    for (int iray = 0; iray < sweep.nRays; iray++) {
+      const RadxField *dbzField = rays[startRay + iray]->getField(dbzName);
+      if (dbzField == NULL || dbzField->getDataType() != Radx::FL32) {
+        continue;
+      }
+      const Radx::fl32 *dbz = dbzField->getDataFl32();
+      float dbzMissing = dbzField->getMissingFl32();
+      int nDbz = min(nGates, (int) dbzField->getNPoints());
+      Radx::fl32 *vel = sweep.unf[iray];
+      for (int igate = 0; igate < nDbz; igate++) {
+        if (igate < _delNumBins) {
+          vel[igate] = missing;
+        } else if (_params.dbz_rm_rv && _isMissing(dbz[igate], dbzMissing)) {
+          vel[igate] = missing;
+        } else if (dbz[igate] < _params.low_dbz ||
+                   dbz[igate] > _params.high_dbz) {
+          vel[igate] = missing;
+        }
+      }
+    }
+  }
+
+  sweep.orig.resize(sweep.nRays * nGates);
+  for (int iray = 0; iray < sweep.nRays; iray++) {
+    memcpy(sweep.orig.data() + iray * nGates, sweep.unf[iray],
+           nGates * sizeof(float));
+  }
+
+  sweep.state.assign(sweep.nRays * nGates, TBD);
+  for (int iray = 0; iray < sweep.nRays; iray++) {
+    for (int igate = _delNumBins; igate < nGates; igate++) {
+      int index = iray * nGates + igate;
+      if (_isMissing(sweep.orig[index], missing)) {
+        sweep.state[index] = MISSING;
+      } else if (_params.filt) {
+        sweep.state[index] = _filter3x3(sweep, missing, iray, igate);
+      }
+    }
+  }
+
+}
+
+///////////////////////////////////////////////////////
+// Dealias a sweep - see FourDD::unfoldVolume()
+
+void RadxFourDD::_dealiasSweep(Vol &vol, int isweep)
+{
+
+  if (_params.debug >= Params::DEBUG_VERBOSE) {
+    cerr << "Dealiasing volume " << RadxTime::strm(vol.input->volTime)
+         << ", sweep index " << isweep << endl;
+  }
+
+  _initialDealiasing(vol, isweep);
+  _unfoldSpatial(vol, isweep);
+  _unfoldWindow(vol, isweep);
+  if (vol.prev != NULL && vol.sweeps[isweep].sound != NULL) {
+    _secondPass(vol, isweep);
+  }
+
+  // free the working arrays
+
+  Sweep &sweep = vol.sweeps[isweep];
+  vector<float>().swap(sweep.orig);
+  vector<short>().swap(sweep.state);
+
+}
+
+///////////////////////////////////////////////////////
+// Initial dealiasing, using the sweep above and the previous volume
+// - see FourDD::InitialDealiasing()
+
+void RadxFourDD::_initialDealiasing(Vol &vol, int isweep)
+{
+
+  Sweep &sweep = vol.sweeps[isweep];
+  int nGates = sweep.nGates;
+  float missing = vol.missing;
+  int nSweeps = vol.sweeps.size();
+  bool isTop = (isweep == nSweeps - 1);
+
+  const Vol *prev = vol.prev;
+  const Sweep *prevSweep = (prev != NULL) ? &prev->sweeps[isweep] : NULL;
+  const Sweep *aboveSweep = isTop ? NULL : &vol.sweeps[isweep + 1];
+
+  for (int iray = 0; iray < sweep.nRays; iray++) {
+
+    const float *prevData = NULL;
+    if (prevSweep != NULL) {
+      prevData = prevSweep->unf[prevSweep->lookup.nearest(sweep.az[iray])];
+    }
+    const float *aboveData = NULL;
+    if (aboveSweep != NULL) {
+      aboveData = aboveSweep->unf[aboveSweep->lookup.nearest(sweep.az[iray])];
+    }
+
+    Radx::fl32 *unf = sweep.unf[iray];
+
+    for (int igate = _delNumBins; igate < nGates; igate++) {
+
+      unf[igate] = missing;
+      int index = iray * nGates + igate;
+      float startingValue = sweep.orig[index];
+
+      if (sweep.state[index] != TBD ||
+          fabs(startingValue) <= _params.ck_val) {
+        continue;
+      }
+
+      float prevVal = missing;
+      if (prevData != NULL && igate < prevSweep->nGates &&
+          !_isMissing(prevData[igate], prev->missing)) {
+        prevVal = prevData[igate];
+      }
+      float soundVal = missing;
+      if (sweep.sound != NULL && prev == NULL) {
+        soundVal = sweep.sound[index];
+      }
+      float aboveVal = missing;
+      if (aboveData != NULL && igate < aboveSweep->nGates) {
+        aboveVal = aboveData[igate];
+      }
+      // seed the top sweep from the previous volume
+      if (isTop && prev != NULL) {
+        aboveVal = prevVal;
+      }
+
+      float unfoldedValue;
+      bool successful;
+      _fourDD.TryToDealiasUsingVerticalAndTemporalContinuity
+        (missing, aboveVal, soundVal, startingValue, prevVal, prev == NULL,
+         _fraction, sweep.nyquist, _params.strict_first_pass,
+         _params.max_count, &unfoldedValue, &successful);
+      if (successful) {
+        unf[igate] = unfoldedValue;
+        sweep.state[index] = DEALIASED;
+      }
+
+    } // igate
+
+  } // iray
+
+}
+
+///////////////////////////////////////////////////////
+// Unfold TBD gates assuming spatial continuity
+// - see FourDD::UnfoldTbdBinsAssumingSpatialContinuity().
+// Gates are visited range by range, sweeping the rays in
+// alternate directions on each loop.
+
+void RadxFourDD::_unfoldSpatial(Vol &vol, int isweep)
+{
+
+  Sweep &sweep = vol.sweeps[isweep];
+  int nRays = sweep.nRays;
+  int nGates = sweep.nGates;
+  float missing = vol.missing;
+  float nyquist = sweep.nyquist;
+  float nyqInterval = 2.0 * nyquist;
+  int maxCount = _params.max_count;
+
+  int loopcount = 0;
+  bool changed = true;
+  int step = -1;
+
+  while (changed) {
+
+    loopcount++;
+    changed = false;
+    int startIndex, endIndex;
+    if (step == 1) {
+      step = -1;
+      startIndex = nRays - 1;
+      endIndex = -1;
+    } else {
+      step = 1;
+      startIndex = 0;
+      endIndex = nRays;
+    }
+
+    for (int igate = _delNumBins; igate < nGates; igate++) {
+      for (int iray = startIndex; iray != endIndex; iray += step) {
+
+        int index = iray * nGates + igate;
+        float val = sweep.orig[index];
+        if (_isMissing(val, missing)) {
+          continue;
+        }
+
+        short &state = sweep.state[index];
+        int numtimes = 0;
+        while (state == TBD && numtimes <= maxCount) {
+
+          numtimes++;
+
+          int in, out, numpos, numneg;
+          bool noHope = false;
+          _assessNeighborhood(sweep, iray, igate, val, nyquist,
+                              &in, &out, &numpos, &numneg, &noHope);
+
+          // last step of Bergen and Albers filter
+          if (loopcount == 1 && noHope) {
+            state = MISSING;
+          }
+
+          if (in + out >= 1) {
+            if (in > 0 && out == 0) {
+              sweep.unf[iray][igate] = val;
+              state = DEALIASED;
+              changed = true;
+            } else if ((numpos + numneg) < (in + out - (numpos + numneg))) {
+              if (loopcount > 2) {
+                // keep the value after two passes through data
+                sweep.unf[iray][igate] = val;
+                state = DEALIASED;
+                changed = true;
+              }
+            } else if (numpos > numneg) {
+              val = val + nyqInterval;
+            } else if (numneg > numpos) {
+              val = val - nyqInterval;
+            } else {
+              // save gate for windowing if unsuccessful after four passes
+              if (loopcount > 4) {
+                state = UNSUCCESSFUL;
+              }
+            }
+          }
+
+        } // while
+
+        if (numtimes > maxCount) {
+          state = UNSUCCESSFUL;
+        }
+
+      } // iray
+    } // igate
+
+  } // while (changed)
+
+}
+
+///////////////////////////////////////////////////////
+// Unfold remote or unsuccessful gates against the mean of a
+// window around them - see
+// FourDD::UnfoldRemoteBinsOrUnsuccessfulBinsUsingWindow()
+
+void RadxFourDD::_unfoldWindow(Vol &vol, int isweep)
+{
+
+  Sweep &sweep = vol.sweeps[isweep];
+  int nRays = sweep.nRays;
+  int nGates = sweep.nGates;
+  float missing = vol.missing;
+  float nyquist = sweep.nyquist;
+  int proximity = _params.proximity;
+  bool soundNull = (sweep.sound == NULL);
+  bool prevNull = (vol.prev == NULL);
+
+  for (int igate = _delNumBins; igate < nGates; igate++) {
+    for (int iray = 0; iray < nRays; iray++) {
+
+      int index = iray * nGates + igate;
+      short &state = sweep.state[index];
+      if (state != TBD && state != UNSUCCESSFUL) {
+        continue;
+      }
+
+      float originalValue = sweep.orig[index];
+
+      int startRay = _wrapRay(iray - proximity, nRays);
+      int endRay = _wrapRay(iray + proximity, nRays);
+      int firstGate = max(igate - proximity, 0);
+      int lastGate = min(igate + proximity, nGates - 1);
+
+      bool success = false;
+      float averageVelocity = _window(sweep, missing, startRay, endRay,
+                                      firstGate, lastGate, &success);
+
+      // too few good values - expand the window
+      if (_isMissing(averageVelocity, missing) && success) {
+        startRay = _wrapRay(iray - 2 * proximity, nRays);
+        endRay = _wrapRay(iray + 2 * proximity, nRays);
+        firstGate = max(igate - 2 * proximity, 0);
+        lastGate = min(igate + 2 * proximity, nGates - 1);
+        averageVelocity = _window(sweep, missing, startRay, endRay,
+                                  firstGate, lastGate, &success);
+      }
+
+      if (!_isMissing(averageVelocity, missing)) {
+        float unfoldedVal = _fourDD.Unfold(originalValue, averageVelocity,
+                                           _params.max_count, nyquist);
+        float diff = fabs(averageVelocity - unfoldedVal);
+        if (diff < _pfraction * nyquist) {
+          sweep.unf[iray][igate] = unfoldedVal;
+          state = DEALIASED;
+        } else if (diff < (1.0 - (1.0 - _pfraction) / 2.0) * nyquist) {
+          // within relaxed threshold - keep the value,
+          // but do not use it to dealias other gates
+          sweep.unf[iray][igate] = unfoldedVal;
+          state = MISSING;
+        } else {
+          state = MISSING;
+        }
+      } else if (!success) {
+        // could not examine entire window
+        state = MISSING;
+      } else if (soundNull || prevNull) {
+        if (state == TBD) {
+          // leave gate untouched, but do not use it to unfold others
+          sweep.unf[iray][igate] = originalValue;
+        }
+        state = MISSING;
+      } else if (state != TBD) {
+        state = MISSING;
+      }
+      // otherwise, leave TBD gates for the second pass
+
+    } // iray
+  } // igate
+
+}
+
+///////////////////////////////////////////////////////
+// Second pass, against the first guess only
+// - see FourDD::SecondPassUsingSoundVolumeOnly()
+
+void RadxFourDD::_secondPass(Vol &vol, int isweep)
+{
+
+  Sweep &sweep = vol.sweeps[isweep];
+  int nRays = sweep.nRays;
+  int nGates = sweep.nGates;
+  float missing = vol.missing;
+  float nyquist = sweep.nyquist;
+  float nyqInterval = 2.0 * nyquist;
+  int maxCount = _params.max_count;
+
+  // unfold against the first guess
+
+  for (int iray = 0; iray < nRays; iray++) {
+    for (int igate = _delNumBins; igate < nGates; igate++) {
+      int index = iray * nGates + igate;
+      if (sweep.state[index] != TBD) {
+        continue;
+      }
+      float val = sweep.orig[index];
+      float soundVal = sweep.sound[index];
+      if (_isMissing(soundVal, missing) || _isMissing(val, missing)) {
+        continue;
+      }
+      float unfoldedVal = _fourDD.Unfold(val, soundVal, maxCount, nyquist);
+      float diff = soundVal - unfoldedVal;
+      if (diff < _fraction2 * nyquist && fabs(val) > _params.ck_val) {
+        sweep.unf[iray][igate] = unfoldedVal;
+        sweep.state[index] = DEALIASED;
+      }
+    }
+  }
+
+  // then unfold the remaining TBD gates assuming spatial continuity
+
+  int loopcount = 0;
+  bool changed = true;
+  int step = -1;
+
+  while (changed) {
+
+    loopcount++;
+    changed = false;
+    int startIndex, endIndex;
+    if (step == 1) {
+      step = -1;
+      startIndex = nRays - 1;
+      endIndex = -1;
+    } else {
+      step = 1;
+      startIndex = 0;
+      endIndex = nRays;
+    }
+
+    for (int iray = startIndex; iray != endIndex; iray += step) {
+      for (int igate = _delNumBins; igate < nGates; igate++) {
+
+        int index = iray * nGates + igate;
+        short &state = sweep.state[index];
+        if (state != TBD) {
+          continue;
+        }
+        float val = sweep.orig[index];
+        if (_isMissing(val, missing)) {
+          continue;
+        }
+
+        int in, out, numpos, numneg;
+        bool noHope = false;
+        _assessNeighborhood(sweep, iray, igate, val, nyquist,
+                            &in, &out, &numpos, &numneg, &noHope);
+        if (in + out < 1) {
+          continue;
+        }
+
+        int attempts = 0;
+        bool tryAgainLater = false;
+        while (state == TBD && attempts < maxCount && !tryAgainLater) {
+          attempts++;
+          if (in > 0 && out == 0) {
+            sweep.unf[iray][igate] = val;
+            state = DEALIASED;
+          } else if ((numpos + numneg) < (in + out - (numpos + numneg))) {
+            if (loopcount > 2) {
+              // keep the value after two passes through data
+              sweep.unf[iray][igate] = val;
+              state = DEALIASED;
+            } else {
+              tryAgainLater = true;
+            }
+          } else if (numpos > numneg) {
+            val = val + nyqInterval;
+          } else if (numneg > numpos) {
+            val = val - nyqInterval;
+          } else {
+            if (loopcount > 4) {
+              state = MISSING;
+            }
+          }
+        }
+
+        if (state == DEALIASED) {
+          changed = true;
+        }
+        if (state == TBD && !tryAgainLater) {
+          // remove gate
+          state = MISSING;
+        }
+
+      } // igate
+    } // iray
+
+  } // while (changed)
+
+}
+
+///////////////////////////////////////////////////////
+// 3x3 filter, as proposed by Bergen & Albers 1988
+// - see FourDD::Filter3x3()
+
+short RadxFourDD::_filter3x3(const Sweep &sweep, float missing,
+                             int iray, int igate)
+{
+
+  int nRays = sweep.nRays;
+  int nGates = sweep.nGates;
+  int left = (iray == 0) ? nRays - 1 : iray - 1;
+  int right = (iray == nRays - 1) ? 0 : iray + 1;
+  const float *orig = sweep.orig.data();
+
+  int count = 0;
+  if (igate > _delNumBins) {
+    int prev = igate - 1;
+    if (!_isMissing(orig[left * nGates + prev], missing)) count++;
+    if (!_isMissing(orig[iray * nGates + prev], missing)) count++;
+    if (!_isMissing(orig[right * nGates + prev], missing)) count++;
+  }
+  if (!_isMissing(orig[left * nGates + igate], missing)) count++;
+  if (!_isMissing(orig[right * nGates + igate], missing)) count++;
+  if (igate < nGates - 1) {
+    int next = igate + 1;
+    if (!_isMissing(orig[left * nGates + next], missing)) count++;
+    if (!_isMissing(orig[iray * nGates + next], missing)) count++;
+    if (!_isMissing(orig[right * nGates + next], missing)) count++;
+  }
+
+  if (((igate == nGates - 1 || igate == _delNumBins) && count >= 3) ||
+      count >= 5) {
+    return TBD;
+  }
+  return MISSING;
+
+}
+
+///////////////////////////////////////////////////////
+// Compare a gate with its dealiased neighbors
+// - see FourDD::AssessNeighborhood2()
+
+void RadxFourDD::_assessNeighborhood(const Sweep &sweep, int iray, int igate,
+                                     float foldedValue, float nyquist,
+                                     int *nWithin, int *nOutside,
+                                     int *nPositive, int *nNegative,
+                                     bool *noHope)
+{
+
+  int nRays = sweep.nRays;
+  int nGates = sweep.nGates;
+  int left = (iray == 0) ? nRays - 1 : iray - 1;
+  int right = (iray == nRays - 1) ? 0 : iray + 1;
+
+  int nbrRay[8], nbrGate[8];
+  int nNbrs = 0;
+  if (igate > _delNumBins) {
+    int prev = igate - 1;
+    nbrRay[nNbrs] = left; nbrGate[nNbrs++] = prev;
+    nbrRay[nNbrs] = iray; nbrGate[nNbrs++] = prev;
+    nbrRay[nNbrs] = right; nbrGate[nNbrs++] = prev;
+  }
+  nbrRay[nNbrs] = left; nbrGate[nNbrs++] = igate;
+  nbrRay[nNbrs] = right; nbrGate[nNbrs++] = igate;
+  if (igate < nGates - 1) {
+    int next = igate + 1;
+    nbrRay[nNbrs] = left; nbrGate[nNbrs++] = next;
+    nbrRay[nNbrs] = iray; nbrGate[nNbrs++] = next;
+    nbrRay[nNbrs] = right; nbrGate[nNbrs++] = next;
+  }
+
+  int nTbd = 0, in = 0, out = 0, numpos = 0, numneg = 0;
+  float limit = _pfraction * nyquist;
+  for (int ii = 0; ii < nNbrs; ii++) {
+    short state = sweep.state[nbrRay[ii] * nGates + nbrGate[ii]];
+    if (state == TBD) {
+      nTbd++;
+    } else if (state == DEALIASED) {
+      float diff = sweep.unf[nbrRay[ii]][nbrGate[ii]] - foldedValue;
+      if (fabs(diff) < limit) {
+        in++;
+      } else {
+        out++;
+        if (diff > nyquist) {
+          numpos++;
+        } else if (diff < -nyquist) {
+          numneg++;
+        }
+      }
+    }
+  }
+
+  *nWithin = in;
+  *nOutside = out;
+  *nPositive = numpos;
+  *nNegative = numneg;
+  *noHope = (nTbd + in + out < 1);
+
+}
+
+///////////////////////////////////////////////////////
+// Mean of the dealiased data in a window - see FourDD::window().
+// If startRay > endRay, the window wraps through north.
+// Returns the mean, or missing if there are fewer than min_good
+// values. success is false if the standard deviation is too high.
+
+float RadxFourDD::_window(const Sweep &sweep, float missing,
+                          int startRay, int endRay,
+                          int firstGate, int lastGate,
+                          bool *success)
+{
+
+  *success = false;
+  int num = 0;
+  float sum = 0.0, sumsq = 0.0;
+
+  int nRaysInWindow;
+  if (startRay > endRay) {
+    nRaysInWindow = sweep.nRays - startRay + endRay + 1;
+  } else {
+    nRaysInWindow = endRay - startRay + 1;
+  }
+
+  for (int ii = 0; ii < nRaysInWindow; ii++) {
+    const float *unf = sweep.unf[(startRay + ii) % sweep.nRays];
+    for (int igate = firstGate; igate <= lastGate; igate++) {
+      float val = unf[igate];
+      if (!_isMissing(val, missing)) {
+        num++;
+        sum += val;
+        sumsq += val * val;
+      }
+    }
+  }
+
+  if (num >= _params.min_good) {
+    float std = sqrt(fabs((sumsq - (sum * sum) / num) / (num - 1)));
+    if (std <= _params.std_thresh * sweep.nyquist) {
+      *success = true;
+    }
+    return sum / num;
+  }
+
+  *success = true;
+  return missing;
+
+}
+
+///////////////////////////////////////////////////////
+// Azimuth lookup - build the table.
+//
+// The rays are sorted by azimuth, and the azimuth circle is divided
+// into as many bins as there are rays. For each bin we store the
+// first sorted position at or above the start of the bin, so that
+// a search only has to look at the few rays in one bin.
+
+void RadxFourDD::AzLookup::init(const vector<float> &az)
+{
+
+  int nRays = az.size();
+  _nBins = max(nRays, 1);
+
+  vector< pair<float, int> > sorted(nRays);
+  for (int ii = 0; ii < nRays; ii++) {
+    float aa = fmod(az[ii], 360.0f);
+    if (aa < 0) {
+      aa += 360.0;
+    }
+    sorted[ii] = make_pair(aa, ii);
+  }
+  sort(sorted.begin(), sorted.end());
+
+  _rayIndex.resize(nRays);
+  _sortedAz.resize(nRays);
+  for (int ii = 0; ii < nRays; ii++) {
+    _sortedAz[ii] = sorted[ii].first;
+    _rayIndex[ii] = sorted[ii].second;
+  }
+
+  _binStart.resize(_nBins + 1);
+  int pos = 0;
+  for (int ibin = 0; ibin <= _nBins; ibin++) {
+    float binStartAz = (ibin * 360.0) / _nBins;
+    while (pos < nRays && _sortedAz[pos] < binStartAz) {
+      pos++;
+    }
+    _binStart[ibin] = pos;
+  }
+
+}
+
+///////////////////////////////////////////////////////
+// Azimuth lookup - find the ray nearest to an azimuth
+
+int RadxFourDD::AzLookup::nearest(float az) const
+{
+
+  int nRays = _sortedAz.size();
+  if (nRays < 2) {
+    return 0;
+  }
+
+  float aa = fmod(az, 360.0f);
+  if (aa < 0) {
+    aa += 360.0;
+  }
+  int ibin = (int) (aa * _nBins / 360.0);
+  if (ibin >= _nBins) {
+    ibin = _nBins - 1;
+  }
+
+  // first ray at or above az
+
+  int pos = _binStart[ibin];
+  int end = _binStart[ibin + 1];
+  while (pos < end && _sortedAz[pos] < aa) {
+    pos++;
+  }
+
+  // compare with the ray below, wrapping through north
+
+  int above = (pos < nRays) ? pos : 0;
+  float aboveAz = (pos < nRays) ? _sortedAz[pos] : _sortedAz[0] + 360.0;
+  int below = (pos > 0) ? pos - 1 : nRays - 1;
+  float belowAz = (pos > 0) ? _sortedAz[pos - 1] : _sortedAz[nRays - 1] - 360.0;
+
+  if (aboveAz - aa < aa - belowAz) {
+    return _rayIndex[above];
+  }
+  return _rayIndex[below];
+
+}
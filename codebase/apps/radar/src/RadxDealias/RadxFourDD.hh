@@ -0,0 +1,224 @@
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*
+// ** Copyright UCAR (c) 1990 - 2016
+// ** University Corporation for Atmospheric Research (UCAR)
+// ** National Center for Atmospheric Research (NCAR)
+// ** Boulder, Colorado, USA
+// ** BSD licence applies - redistribution and use in source and binary
+// ** forms, with or without modification, are permitted provided that
+// ** the following conditions are met:
+// ** 1) If the software is modified to produce derivative works,
+// ** such modified software should be clearly marked, so as not
+// ** to confuse it with the version available from UCAR.
+// ** 2) Redistributions of source code must retain the above copyright
+// ** notice, this list of conditions and the following disclaimer.
+// ** 3) Redistributions in binary form must reproduce the above copyright
+// ** notice, this list of conditions and the following disclaimer in the
+// ** documentation and/or other materials provided with the distribution.
+// ** 4) Neither the name of UCAR nor the names of its contributors,
+// ** if any, may be used to endorse or promote products derived from
+// ** this software without specific prior written permission.
+// ** DISCLAIMER: THIS SOFTWARE IS PROVIDED "AS IS" AND WITHOUT ANY EXPRESS
+// ** OR IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+// ** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*
+/*
+ *   Module: RadxFourDD.hh
+ *
+ *   Description: The 4DD (Four Dimensional Dealiasing) algorithm,
+ *                running directly on the float velocity arrays in
+ *                RadxVol rays, rather than on RSL Volume copies.
+ *
+ *                The passes are those of the FourDD class - initial
+ *                dealiasing against the sweep above and the previous
+ *                volume, spatial continuity, window, and the second
+ *                pass against the sounding. Rays are matched between
+ *                sweeps and volumes with azimuth lookup tables.
+ *
+ *                A batch of successive volumes is dealiased at once.
+ *                Each sweep only depends on the sweep above it in the
+ *                same volume, and on the matching sweep in the previous
+ *                volume, so sweeps are handed to a pool of threads as
+ *                soon as those two are done. The top sweep of volume
+ *                v+1 can therefore run while volume v is still working
+ *                down through its lower sweeps.
+ *
+ *                The last volume of each batch is kept, to seed the
+ *                first volume of the next batch.
+ *
+ *   The 4DD algorithm was developed by Curtis James, Mesoscale Group,
+ *   Department of Atmospheric Sciences, University of Washington.
+ *   See FourDD.hh for the University of Washington copyright notice,
+ *   which also applies to this derivative work.
+ */
+
+#ifndef RADX_FOURDD_HH
+#define RADX_FOURDD_HH
+
+#include <string>
+#include <vector>
+#include <pthread.h>
+#include <Radx/RadxVol.hh>
+#include "Params.hh"
+#include "FourDD.hh"
+using namespace std;
+
+class RadxFourDD {
+
+public:
+
+  // input for one volume
+
+  class VolInput {
+  public:
+    VolInput() : vol(NULL), soundOk(false) {}
+    RadxVol *vol;                       // prepared volume, see dealias()
+    time_t volTime;
+    bool soundOk;                       // first guess available
+    vector< vector<float> > soundVals;  // first guess, per sweep,
+                                        // nRays * nGates, ray by ray
+  };
+
+  RadxFourDD(const Params &params);
+  ~RadxFourDD();
+
+  // Dealias a batch of volumes, in time order.
+  //
+  // The volumes must have been prepared as for the RSL dealiaser:
+  // rays sorted by azimuth in each sweep, constant number of gates,
+  // and fields converted to fl32 and loaded from the rays.
+  //
+  // The field <velocity>_UNF is added to every ray of each volume.
+  // It holds the dealiased velocity, or the input velocity if the
+  // volume could not be dealiased.
+  //
+  // status is resized to the number of volumes, and set to 0 for each
+  // volume that is ready to be written, -1 for a volume that failed.
+  // A failed volume is not used to seed the volumes after it.
+  //
+  // Returns 0 if all volumes succeeded, -1 otherwise.
+
+  int dealias(vector<VolInput> &vols, vector<int> &status);
+
+  // forget the previous volume, so that the next batch
+  // starts from the first guess only
+
+  void clearPrevious();
+
+  // velocity missing value for a volume, overridden if directed
+  // by the params
+
+  float getMissingValue(const RadxVol &vol) const;
+
+private:
+
+  // nearest-ray lookup on azimuth, for one sweep
+
+  class AzLookup {
+  public:
+    void init(const vector<float> &az);
+    int nearest(float az) const;
+  private:
+    int _nBins;
+    vector<int> _rayIndex;   // ray indices, sorted by azimuth
+    vector<float> _sortedAz; // azimuths, sorted, in [0, 360)
+    vector<int> _binStart;   // first sorted position in each az bin
+  };
+
+  // working state for one sweep
+
+  class Sweep {
+  public:
+    Sweep() : nRays(0), nGates(0), nyquist(0.0), sound(NULL) {}
+    int nRays;
+    int nGates;
+    float nyquist;
+    vector<float> az;
+    vector<Radx::fl32 *> unf;  // output data, one pointer per ray
+    vector<float> orig;        // velocity after prep, ray by ray
+    vector<short> state;       // 4DD STATE, ray by ray
+    const float *sound;        // first guess, or NULL
+    AzLookup lookup;
+    vector<float> kept;        // unf data, when kept as previous volume
+  };
+
+  // working state for one volume
+
+  class Vol {
+  public:
+    Vol() : input(NULL), missing(0.0), doDealias(false),
+            failed(false), prev(NULL) {}
+    VolInput *input;
+    float missing;
+    bool doDealias;
+    bool failed;
+    const Vol *prev;
+    vector<Sweep> sweeps;
+    vector<int> sweepStatus;
+  };
+
+  // sweep tasks in a batch
+
+  typedef enum {
+    SWEEP_WAITING,
+    SWEEP_RUNNING,
+    SWEEP_DONE
+  } sweep_status_t;
+
+  class Task {
+  public:
+    RadxFourDD *obj;
+    vector<Vol *> vols;
+    int nTotal;
+    int nDone;
+    int nextSetup;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+  };
+
+  const Params &_params;
+  FourDD _fourDD;
+  string _velName;
+  string _unfName;
+
+  int _delNumBins;
+  float _fraction;
+  float _fraction2;
+  float _pfraction;
+
+  Vol *_prevVol;
+
+  int _initVol(Vol &vol);
+  void _keepAsPrevious(Vol &vol);
+
+  void _runThreads(Task &task, void *(*threadMain)(void *));
+  static void *_setupThreadMain(void *args);
+  static void *_dealiasThreadMain(void *args);
+  static void _setupSweeps(Task &task);
+  static void _dealiasSweeps(Task &task);
+  static bool _sweepReady(const Vol &vol, int isweep);
+
+  void _prepSweep(Vol &vol, int isweep);
+  void _dealiasSweep(Vol &vol, int isweep);
+
+  void _initialDealiasing(Vol &vol, int isweep);
+  void _unfoldSpatial(Vol &vol, int isweep);
+  void _unfoldWindow(Vol &vol, int isweep);
+  void _secondPass(Vol &vol, int isweep);
+
+  short _filter3x3(const Sweep &sweep, float missing, int iray, int igate);
+  void _assessNeighborhood(const Sweep &sweep, int iray, int igate,
+                           float foldedValue, float nyquist,
+                           int *nWithin, int *nOutside,
+                           int *nPositive, int *nNegative,
+                           bool *noHope);
+  float _window(const Sweep &sweep, float missing,
+                int startRay, int endRay, int firstGate, int lastGate,
+                bool *success);
+
+  inline bool _isMissing(float val, float missing) const {
+    return fabs(val - missing) < MISSING_THRESHOLD;
+  }
+
+};
+
+#endif
@@ -88,6 +88,18 @@ bool Filt2d::filter(const FiltInfoInput &inp, FiltInfoOutput &out) const
   case FiltAlgParams::TEXTURE_Y:
     out.texture(_nr, _ntheta, false);
     break;
+  case FiltAlgParams::ELLIP_SUMMED_AREA:
+    out.smoothSummedArea(_nr, _ntheta);
+    break;
+  case FiltAlgParams::SDEV_SUMMED_AREA:
+    out.sdevSummedArea(_nr, _ntheta);
+    break;
+  case FiltAlgParams::TEXTURE_X_SUMMED_AREA:
+    out.textureSummedArea(_nr, _ntheta, true);
+    break;
+  case FiltAlgParams::TEXTURE_Y_SUMMED_AREA:
+    out.textureSummedArea(_nr, _ntheta, false);
+    break;
   default:
     LOG(ERROR) << "wrong filter";
     out.setBad();
@@ -735,7 +735,7 @@
       tt->struct_def.fields[4].rel_offset = 
         (char *) &_filter->filter - (char *) _filter;
         tt->struct_def.fields[4].enum_def.name = tdrpStrDup("filter_t");
-        tt->struct_def.fields[4].enum_def.nfields = 34;
+        tt->struct_def.fields[4].enum_def.nfields = 38;
         tt->struct_def.fields[4].enum_def.fields = (enum_field_t *) tdrpMalloc
           (tt->struct_def.fields[4].enum_def.nfields * sizeof(enum_field_t));
         tt->struct_def.fields[4].enum_def.fields[0].name = tdrpStrDup("CLUMP");
@@ -756,56 +756,64 @@
         tt->struct_def.fields[4].enum_def.fields[7].val = TEXTURE_X;
         tt->struct_def.fields[4].enum_def.fields[8].name = tdrpStrDup("TEXTURE_Y");
         tt->struct_def.fields[4].enum_def.fields[8].val = TEXTURE_Y;
-        tt->struct_def.fields[4].enum_def.fields[9].name = tdrpStrDup("REMAP");
-        tt->struct_def.fields[4].enum_def.fields[9].val = REMAP;
-        tt->struct_def.fields[4].enum_def.fields[10].name = tdrpStrDup("REPLACE");
-        tt->struct_def.fields[4].enum_def.fields[10].val = REPLACE;
-        tt->struct_def.fields[4].enum_def.fields[11].name = tdrpStrDup("MAX_TRUE");
-        tt->struct_def.fields[4].enum_def.fields[11].val = MAX_TRUE;
-        tt->struct_def.fields[4].enum_def.fields[12].name = tdrpStrDup("MAX");
-        tt->struct_def.fields[4].enum_def.fields[12].val = MAX;
-        tt->struct_def.fields[4].enum_def.fields[13].name = tdrpStrDup("AVERAGE");
-        tt->struct_def.fields[4].enum_def.fields[13].val = AVERAGE;
-        tt->struct_def.fields[4].enum_def.fields[14].name = tdrpStrDup("AVERAGE_ORIENTATION");
-        tt->struct_def.fields[4].enum_def.fields[14].val = AVERAGE_ORIENTATION;
-        tt->struct_def.fields[4].enum_def.fields[15].name = tdrpStrDup("PRODUCT");
-        tt->struct_def.fields[4].enum_def.fields[15].val = PRODUCT;
-        tt->struct_def.fields[4].enum_def.fields[16].name = tdrpStrDup("FULL_MEAN");
-        tt->struct_def.fields[4].enum_def.fields[16].val = FULL_MEAN;
-        tt->struct_def.fields[4].enum_def.fields[17].name = tdrpStrDup("FULL_SDEV");
-        tt->struct_def.fields[4].enum_def.fields[17].val = FULL_SDEV;
-        tt->struct_def.fields[4].enum_def.fields[18].name = tdrpStrDup("FULL_MEDIAN");
-        tt->struct_def.fields[4].enum_def.fields[18].val = FULL_MEDIAN;
-        tt->struct_def.fields[4].enum_def.fields[19].name = tdrpStrDup("VERT_AVERAGE");
-        tt->struct_def.fields[4].enum_def.fields[19].val = VERT_AVERAGE;
-        tt->struct_def.fields[4].enum_def.fields[20].name = tdrpStrDup("VERT_MAX");
-        tt->struct_def.fields[4].enum_def.fields[20].val = VERT_MAX;
-        tt->struct_def.fields[4].enum_def.fields[21].name = tdrpStrDup("VERT_PRODUCT");
-        tt->struct_def.fields[4].enum_def.fields[21].val = VERT_PRODUCT;
-        tt->struct_def.fields[4].enum_def.fields[22].name = tdrpStrDup("WEIGHTED_SUM");
-        tt->struct_def.fields[4].enum_def.fields[22].val = WEIGHTED_SUM;
-        tt->struct_def.fields[4].enum_def.fields[23].name = tdrpStrDup("WEIGHTED_ORIENTATION_SUM");
-        tt->struct_def.fields[4].enum_def.fields[23].val = WEIGHTED_ORIENTATION_SUM;
-        tt->struct_def.fields[4].enum_def.fields[24].name = tdrpStrDup("NORM_WEIGHTED_SUM");
-        tt->struct_def.fields[4].enum_def.fields[24].val = NORM_WEIGHTED_SUM;
-        tt->struct_def.fields[4].enum_def.fields[25].name = tdrpStrDup("NORM_WEIGHTED_ORIENTATION_SUM");
-        tt->struct_def.fields[4].enum_def.fields[25].val = NORM_WEIGHTED_ORIENTATION_SUM;
-        tt->struct_def.fields[4].enum_def.fields[26].name = tdrpStrDup("MASK");
-        tt->struct_def.fields[4].enum_def.fields[26].val = MASK;
-        tt->struct_def.fields[4].enum_def.fields[27].name = tdrpStrDup("RESCALE");
-        tt->struct_def.fields[4].enum_def.fields[27].val = RESCALE;
-        tt->struct_def.fields[4].enum_def.fields[28].name = tdrpStrDup("DB2LINEAR");
-        tt->struct_def.fields[4].enum_def.fields[28].val = DB2LINEAR;
-        tt->struct_def.fields[4].enum_def.fields[29].name = tdrpStrDup("LINEAR2DB");
-        tt->struct_def.fields[4].enum_def.fields[29].val = LINEAR2DB;
-        tt->struct_def.fields[4].enum_def.fields[30].name = tdrpStrDup("TRAPEZOID_REMAP");
-        tt->struct_def.fields[4].enum_def.fields[30].val = TRAPEZOID_REMAP;
-        tt->struct_def.fields[4].enum_def.fields[31].name = tdrpStrDup("S_REMAP");
-        tt->struct_def.fields[4].enum_def.fields[31].val = S_REMAP;
-        tt->struct_def.fields[4].enum_def.fields[32].name = tdrpStrDup("PASSTHROUGH");
-        tt->struct_def.fields[4].enum_def.fields[32].val = PASSTHROUGH;
-        tt->struct_def.fields[4].enum_def.fields[33].name = tdrpStrDup("APPFILTER");
-        tt->struct_def.fields[4].enum_def.fields[33].val = APPFILTER;
+        tt->struct_def.fields[4].enum_def.fields[9].name = tdrpStrDup("ELLIP_SUMMED_AREA");
+        tt->struct_def.fields[4].enum_def.fields[9].val = ELLIP_SUMMED_AREA;
+        tt->struct_def.fields[4].enum_def.fields[10].name = tdrpStrDup("SDEV_SUMMED_AREA");
+        tt->struct_def.fields[4].enum_def.fields[10].val = SDEV_SUMMED_AREA;
+        tt->struct_def.fields[4].enum_def.fields[11].name = tdrpStrDup("TEXTURE_X_SUMMED_AREA");
+        tt->struct_def.fields[4].enum_def.fields[11].val = TEXTURE_X_SUMMED_AREA;
+        tt->struct_def.fields[4].enum_def.fields[12].name = tdrpStrDup("TEXTURE_Y_SUMMED_AREA");
+        tt->struct_def.fields[4].enum_def.fields[12].val = TEXTURE_Y_SUMMED_AREA;
+        tt->struct_def.fields[4].enum_def.fields[13].name = tdrpStrDup("REMAP");
+        tt->struct_def.fields[4].enum_def.fields[13].val = REMAP;
+        tt->struct_def.fields[4].enum_def.fields[14].name = tdrpStrDup("REPLACE");
+        tt->struct_def.fields[4].enum_def.fields[14].val = REPLACE;
+        tt->struct_def.fields[4].enum_def.fields[15].name = tdrpStrDup("MAX_TRUE");
+        tt->struct_def.fields[4].enum_def.fields[15].val = MAX_TRUE;
+        tt->struct_def.fields[4].enum_def.fields[16].name = tdrpStrDup("MAX");
+        tt->struct_def.fields[4].enum_def.fields[16].val = MAX;
+        tt->struct_def.fields[4].enum_def.fields[17].name = tdrpStrDup("AVERAGE");
+        tt->struct_def.fields[4].enum_def.fields[17].val = AVERAGE;
+        tt->struct_def.fields[4].enum_def.fields[18].name = tdrpStrDup("AVERAGE_ORIENTATION");
+        tt->struct_def.fields[4].enum_def.fields[18].val = AVERAGE_ORIENTATION;
+        tt->struct_def.fields[4].enum_def.fields[19].name = tdrpStrDup("PRODUCT");
+        tt->struct_def.fields[4].enum_def.fields[19].val = PRODUCT;
+        tt->struct_def.fields[4].enum_def.fields[20].name = tdrpStrDup("FULL_MEAN");
+        tt->struct_def.fields[4].enum_def.fields[20].val = FULL_MEAN;
+        tt->struct_def.fields[4].enum_def.fields[21].name = tdrpStrDup("FULL_SDEV");
+        tt->struct_def.fields[4].enum_def.fields[21].val = FULL_SDEV;
+        tt->struct_def.fields[4].enum_def.fields[22].name = tdrpStrDup("FULL_MEDIAN");
+        tt->struct_def.fields[4].enum_def.fields[22].val = FULL_MEDIAN;
+        tt->struct_def.fields[4].enum_def.fields[23].name = tdrpStrDup("VERT_AVERAGE");
+        tt->struct_def.fields[4].enum_def.fields[23].val = VERT_AVERAGE;
+        tt->struct_def.fields[4].enum_def.fields[24].name = tdrpStrDup("VERT_MAX");
+        tt->struct_def.fields[4].enum_def.fields[24].val = VERT_MAX;
+        tt->struct_def.fields[4].enum_def.fields[25].name = tdrpStrDup("VERT_PRODUCT");
+        tt->struct_def.fields[4].enum_def.fields[25].val = VERT_PRODUCT;
+        tt->struct_def.fields[4].enum_def.fields[26].name = tdrpStrDup("WEIGHTED_SUM");
+        tt->struct_def.fields[4].enum_def.fields[26].val = WEIGHTED_SUM;
+        tt->struct_def.fields[4].enum_def.fields[27].name = tdrpStrDup("WEIGHTED_ORIENTATION_SUM");
+        tt->struct_def.fields[4].enum_def.fields[27].val = WEIGHTED_ORIENTATION_SUM;
+        tt->struct_def.fields[4].enum_def.fields[28].name = tdrpStrDup("NORM_WEIGHTED_SUM");
+        tt->struct_def.fields[4].enum_def.fields[28].val = NORM_WEIGHTED_SUM;
+        tt->struct_def.fields[4].enum_def.fields[29].name = tdrpStrDup("NORM_WEIGHTED_ORIENTATION_SUM");
+        tt->struct_def.fields[4].enum_def.fields[29].val = NORM_WEIGHTED_ORIENTATION_SUM;
+        tt->struct_def.fields[4].enum_def.fields[30].name = tdrpStrDup("MASK");
+        tt->struct_def.fields[4].enum_def.fields[30].val = MASK;
+        tt->struct_def.fields[4].enum_def.fields[31].name = tdrpStrDup("RESCALE");
+        tt->struct_def.fields[4].enum_def.fields[31].val = RESCALE;
+        tt->struct_def.fields[4].enum_def.fields[32].name = tdrpStrDup("DB2LINEAR");
+        tt->struct_def.fields[4].enum_def.fields[32].val = DB2LINEAR;
+        tt->struct_def.fields[4].enum_def.fields[33].name = tdrpStrDup("LINEAR2DB");
+        tt->struct_def.fields[4].enum_def.fields[33].val = LINEAR2DB;
+        tt->struct_def.fields[4].enum_def.fields[34].name = tdrpStrDup("TRAPEZOID_REMAP");
+        tt->struct_def.fields[4].enum_def.fields[34].val = TRAPEZOID_REMAP;
+        tt->struct_def.fields[4].enum_def.fields[35].name = tdrpStrDup("S_REMAP");
+        tt->struct_def.fields[4].enum_def.fields[35].val = S_REMAP;
+        tt->struct_def.fields[4].enum_def.fields[36].name = tdrpStrDup("PASSTHROUGH");
+        tt->struct_def.fields[4].enum_def.fields[36].val = PASSTHROUGH;
+        tt->struct_def.fields[4].enum_def.fields[37].name = tdrpStrDup("APPFILTER");
+        tt->struct_def.fields[4].enum_def.fields[37].val = APPFILTER;
       tt->struct_def.fields[5].ftype = tdrpStrDup("int");
       tt->struct_def.fields[5].fname = tdrpStrDup("filter_index");
       tt->struct_def.fields[5].ptype = INT_TYPE;
@@ -996,7 +1004,7 @@
     tt->ptype = STRUCT_TYPE;
     tt->param_name = tdrpStrDup("parm_2d");
     tt->descr = tdrpStrDup("list of 2d filter params");
-    tt->help = tdrpStrDup("nr = number of radial points\nntheta = number of azimuthal points\nfilters that are 2d are:  ELLIP, DILATE SDEV SDEV_NO_OVERLAP TEXTURE_X TEXTURE_Y\n");
+    tt->help = tdrpStrDup("nr = number of radial points\nntheta = number of azimuthal points\nfilters that are 2d are:  ELLIP, DILATE SDEV SDEV_NO_OVERLAP TEXTURE_X TEXTURE_Y\n  ELLIP_SUMMED_AREA SDEV_SUMMED_AREA TEXTURE_X_SUMMED_AREA TEXTURE_Y_SUMMED_AREA\nThe _SUMMED_AREA filters give the same results as ELLIP, SDEV, TEXTURE_X and TEXTURE_Y, using summed area tables so that the time taken does not depend on the box size. They are faster for large boxes.\n");
     tt->array_offset = (char *) &_parm_2d - &_start_;
     tt->array_n_offset = (char *) &parm_2d_n - &_start_;
     tt->is_array = TRUE;
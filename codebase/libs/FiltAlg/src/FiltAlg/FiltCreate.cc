@@ -60,6 +60,10 @@ Filter *FiltCreate::create(const FiltAlgParams::data_filter_t f,
   case FiltAlgParams::SDEV:
   case FiltAlgParams::TEXTURE_X:
   case FiltAlgParams::TEXTURE_Y:
+  case FiltAlgParams::ELLIP_SUMMED_AREA:
+  case FiltAlgParams::SDEV_SUMMED_AREA:
+  case FiltAlgParams::TEXTURE_X_SUMMED_AREA:
+  case FiltAlgParams::TEXTURE_Y_SUMMED_AREA:
     filt = new Filt2d(f, P);
     break;
   case FiltAlgParams::MEDIAN:
@@ -129,6 +129,18 @@ string Filter::filter_string(const FiltAlgParams::data_filter_t f)
   case FiltAlgParams::TEXTURE_Y:
     ret = "TEXTURE_Y";
     break;
+  case FiltAlgParams::ELLIP_SUMMED_AREA:
+    ret = "ELLIP_SUMMED_AREA";
+    break;
+  case FiltAlgParams::SDEV_SUMMED_AREA:
+    ret = "SDEV_SUMMED_AREA";
+    break;
+  case FiltAlgParams::TEXTURE_X_SUMMED_AREA:
+    ret = "TEXTURE_X_SUMMED_AREA";
+    break;
+  case FiltAlgParams::TEXTURE_Y_SUMMED_AREA:
+    ret = "TEXTURE_Y_SUMMED_AREA";
+    break;
   case FiltAlgParams::REMAP:
     ret = "REMAP";
     break;
@@ -227,6 +239,10 @@ int Filter::max_elem_for_filter(const FiltAlgParams::data_filter_t f,
   case FiltAlgParams::SDEV_NO_OVERLAP:
   case FiltAlgParams::TEXTURE_X:
   case FiltAlgParams::TEXTURE_Y:
+  case FiltAlgParams::ELLIP_SUMMED_AREA:
+  case FiltAlgParams::SDEV_SUMMED_AREA:
+  case FiltAlgParams::TEXTURE_X_SUMMED_AREA:
+  case FiltAlgParams::TEXTURE_Y_SUMMED_AREA:
     ret = P.parm_2d_n;
     break;
   case FiltAlgParams::MAX_TRUE:
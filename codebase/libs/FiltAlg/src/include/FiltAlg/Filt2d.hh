@@ -30,7 +30,9 @@
  * All filters that have a moving 2d box that moves through a 2d grid,
  * and one value is computed within the box to generate the output
  * at box center. This includes filters such as ELLIP, DILATE, SDEV, 
- * TEXTURE_X, TEXTURE_Y.  The main input is data to be filtered, the output
+ * TEXTURE_X, TEXTURE_Y, and the summed area table versions
+ * ELLIP_SUMMED_AREA, SDEV_SUMMED_AREA, TEXTURE_X_SUMMED_AREA and
+ * TEXTURE_Y_SUMMED_AREA.  The main input is data to be filtered, the output
  * is filtered data.
  */
 
@@ -81,31 +81,35 @@ public:
     SDEV_NO_OVERLAP = 6,
     TEXTURE_X = 7,
     TEXTURE_Y = 8,
-    REMAP = 9,
-    REPLACE = 10,
-    MAX_TRUE = 11,
-    MAX = 12,
-    AVERAGE = 13,
-    AVERAGE_ORIENTATION = 14,
-    PRODUCT = 15,
-    FULL_MEAN = 16,
-    FULL_SDEV = 17,
-    FULL_MEDIAN = 18,
-    VERT_AVERAGE = 19,
-    VERT_MAX = 20,
-    VERT_PRODUCT = 21,
-    WEIGHTED_SUM = 22,
-    WEIGHTED_ORIENTATION_SUM = 23,
-    NORM_WEIGHTED_SUM = 24,
-    NORM_WEIGHTED_ORIENTATION_SUM = 25,
-    MASK = 26,
-    RESCALE = 27,
-    DB2LINEAR = 28,
-    LINEAR2DB = 29,
-    TRAPEZOID_REMAP = 30,
-    S_REMAP = 31,
-    PASSTHROUGH = 32,
-    APPFILTER = 33
+    ELLIP_SUMMED_AREA = 9,
+    SDEV_SUMMED_AREA = 10,
+    TEXTURE_X_SUMMED_AREA = 11,
+    TEXTURE_Y_SUMMED_AREA = 12,
+    REMAP = 13,
+    REPLACE = 14,
+    MAX_TRUE = 15,
+    MAX = 16,
+    AVERAGE = 17,
+    AVERAGE_ORIENTATION = 18,
+    PRODUCT = 19,
+    FULL_MEAN = 20,
+    FULL_SDEV = 21,
+    FULL_MEDIAN = 22,
+    VERT_AVERAGE = 23,
+    VERT_MAX = 24,
+    VERT_PRODUCT = 25,
+    WEIGHTED_SUM = 26,
+    WEIGHTED_ORIENTATION_SUM = 27,
+    NORM_WEIGHTED_SUM = 28,
+    NORM_WEIGHTED_ORIENTATION_SUM = 29,
+    MASK = 30,
+    RESCALE = 31,
+    DB2LINEAR = 32,
+    LINEAR2DB = 33,
+    TRAPEZOID_REMAP = 34,
+    S_REMAP = 35,
+    PASSTHROUGH = 36,
+    APPFILTER = 37
   } filter_t;
 
   // struct typedefs
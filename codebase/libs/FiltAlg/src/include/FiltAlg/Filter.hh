@@ -79,6 +79,13 @@
  *            is a 2 dimensional texture filter within a box around
  *            each point   </TD></TR>
  * <TR ALIGN="LEFT" VALIGN="TOP">
+ *       <TD> ELLIP_SUMMED_AREA, SDEV_SUMMED_AREA,
+ *            TEXTURE_X_SUMMED_AREA, TEXTURE_Y_SUMMED_AREA </TD>
+ *       <TD> Filt2d     </TD>
+ *       <TD> As ELLIP, SDEV, TEXTURE_X and TEXTURE_Y, but computed from
+ *            summed area tables, so the cost per point does not
+ *            depend on the box size   </TD></TR>
+ * <TR ALIGN="LEFT" VALIGN="TOP">
  *       <TD> MEDIAN_NO_OVERLAP </TD>
  *       <TD> FiltMedianNoOverlap     </TD>
  *       <TD> Input is VlevelData where each slice is a Grid2dW.  The filter
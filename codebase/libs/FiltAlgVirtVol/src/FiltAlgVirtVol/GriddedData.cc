@@ -51,6 +51,28 @@ void GriddedData::setMissing(int ipt)
   Grid2d::setMissing(ipt);
 }
 
+//------------------------------------------------------------------
+void GriddedData::getVals(int i0, int n, double *v, bool *ok) const
+{
+  const double *d = &(Grid2d::getData()[i0]);
+  double missing = Grid2d::getMissing();
+  for (int i=0; i<n; ++i)
+  {
+    v[i] = d[i];
+    ok[i] = d[i] != missing;
+  }
+}
+
+//------------------------------------------------------------------
+void GriddedData::setVals(int i0, int n, const double *v, const bool *ok)
+{
+  double missing = Grid2d::getMissing();
+  for (int i=0; i<n; ++i)
+  {
+    Grid2d::setValue(i0 + i, ok[i] ? v[i] : missing);
+  }
+}
+
 //------------------------------------------------------------------
 double GriddedData::getMissingValue(void) const
 {
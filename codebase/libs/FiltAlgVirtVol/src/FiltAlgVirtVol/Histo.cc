@@ -43,6 +43,7 @@ Histo::Histo(const double res, const double min, const double max)
     _bin.push_back(v);
     _counts.push_back(0.0);
   }
+  _coarse.assign(((_nbin - 1) >> _fineShift) + 1, 0.0);
   _nc = 0;
 }
 
@@ -58,26 +59,36 @@ void Histo::clear(void)
   {
     _counts[i] = 0;
   }
+  for (size_t i=0; i<_coarse.size(); ++i)
+  {
+    _coarse[i] = 0;
+  }
   _nc = 0;
 }
 
 //----------------------------------------------------------------
 void Histo::addValue(double d)
 {
-  // find bin
-  int index = static_cast<int>((d-_binMin)/_binDelta);
-  if (index < 0)
-  {
-    index = 0;
-  }
-  if (index >= _nbin)
-  {
-    index = _nbin-1;
-  }
+  int index = _binIndex(d);
   _counts[index] ++;
+  _coarse[index >> _fineShift] ++;
   ++_nc;
 }
 
+//----------------------------------------------------------------
+void Histo::removeValue(double d)
+{
+  int index = _binIndex(d);
+  if (_counts[index] <= 0)
+  {
+    LOG(ERROR) << "removing " << d << " from empty bin " << _bin[index];
+    return;
+  }
+  _counts[index] --;
+  _coarse[index >> _fineShift] --;
+  --_nc;
+}
+
 //----------------------------------------------------------------
 bool Histo::getMedian(double &m) const
 {
@@ -100,19 +111,49 @@ bool Histo::getPercentile(double pct, double &m) const
 //----------------------------------------------------------------
 bool Histo::_pcntile(double pct, double &m) const
 {
+  // first bin at which the cumulative count reaches the target,
+  // skipping whole coarse bins where possible
   double fpt = pct*static_cast<double>(_nc);
   int ipt = static_cast<int>(fpt);
   int count=0;
-  for (int i=0; i<_nbin; ++i)
+  int ncoarse = static_cast<int>(_coarse.size());
+  for (int c=0; c<ncoarse; ++c)
   {
-    count += static_cast<int>(_counts[i]);
-    if (count >= ipt)
+    if (count + static_cast<int>(_coarse[c]) < ipt)
+    {
+      count += static_cast<int>(_coarse[c]);
+      continue;
+    }
+    int i1 = (c + 1) << _fineShift;
+    if (i1 > _nbin)
+    {
+      i1 = _nbin;
+    }
+    for (int i=c << _fineShift; i<i1; ++i)
     {
-      m = _bin[i];
-      return true;
+      count += static_cast<int>(_counts[i]);
+      if (count >= ipt)
+      {
+	m = _bin[i];
+	return true;
+      }
     }
   }
   LOG(ERROR) << "getting percentile " << pct;
   return false;
 }
 
+//----------------------------------------------------------------
+int Histo::_binIndex(double d) const
+{
+  int index = static_cast<int>((d-_binMin)/_binDelta);
+  if (index < 0)
+  {
+    index = 0;
+  }
+  if (index >= _nbin)
+  {
+    index = _nbin-1;
+  }
+  return index;
+}
@@ -6,6 +6,98 @@
 #include <Mdv/MdvxProj.hh>
 #include <toolsa/LogStream.hh>
 #include <cmath>
+#include <map>
+
+//------------------------------------------------------------------
+// The azimuth offsets a0 to a1 covered by a template at one gate r
+class _AzimuthSpan
+{
+public:
+  inline _AzimuthSpan(int r, int a) : _r(r), _a0(a), _a1(a), _n(1) {}
+  int _r;
+  int _a0;
+  int _a1;
+  int _n;
+};
+
+//------------------------------------------------------------------
+// Group the template offsets by gate, returning false if the offsets
+// at any gate are not a contiguous range of azimuths
+static bool _azimuthSpans(const LookupOffsets &lx, int nx,
+			  std::vector<_AzimuthSpan> &spans)
+{
+  spans.clear();
+  std::map<int, size_t> spanIndex;
+  for (int j=0; j<lx.num(); ++j)
+  {
+    int rj = lx.ithIndexR(j);
+    int aj = lx.ithIndexA(j);
+    if (rj < 0 || rj >= nx)
+    {
+      continue;
+    }
+    std::map<int, size_t>::iterator it = spanIndex.find(rj);
+    if (it == spanIndex.end())
+    {
+      spanIndex[rj] = spans.size();
+      spans.push_back(_AzimuthSpan(rj, aj));
+    }
+    else
+    {
+      _AzimuthSpan &s = spans[it->second];
+      if (aj < s._a0)
+      {
+	s._a0 = aj;
+      }
+      if (aj > s._a1)
+      {
+	s._a1 = aj;
+      }
+      s._n++;
+    }
+  }
+  for (size_t i=0; i<spans.size(); ++i)
+  {
+    if (spans[i]._n != spans[i]._a1 - spans[i]._a0 + 1)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------
+// Add or remove the data at gate r, azimuth index ia to or from
+// a histogram, wrapping the azimuth index if circular
+static void _histoUpdate(Histo &H, const Grid2d &data, int r, int ia,
+			 bool circular, bool add)
+{
+  int ny = data.getNy();
+  if (circular)
+  {
+    ia = ia % ny;
+    if (ia < 0)
+    {
+      ia += ny;
+    }
+  }
+  else if (ia < 0 || ia >= ny)
+  {
+    return;
+  }
+  double v;
+  if (data.getValue(r, ia, v))
+  {
+    if (add)
+    {
+      H.addValue(v);
+    }
+    else
+    {
+      H.removeValue(v);
+    }
+  }
+}
 
 //------------------------------------------------------------------
 static bool _percentLessThan(const std::vector<double> &dataInBox,
@@ -264,31 +356,65 @@ void PolarCircularFilter::median(Grid2d &a, const PolarCircularTemplate &pt, dou
   Grid2d out(a);
   out.setAllMissing();
   Histo H(binDelta, binMin, binMax);
-  for (int y=0; y<out.getNy(); ++y)
+  int nx = out.getNx();
+  int ny = out.getNy();
+  for (int x=0; x<nx && x<pt.nGates(); ++x)
   {
-    for (int x=0; x<out.getNx(); ++x)
+    vector<_AzimuthSpan> spans;
+    if (!_azimuthSpans(pt[x], nx, spans))
     {
-      H.clear();
-      vector<double> dataInBox = pt.dataInsideCircle(x, y, a);
-      if (dataInBox.empty())
-      {
-	LOG(DEBUG_VERBOSE) << "No data x=" << x;
-      }
-      else
+      // not contiguous in azimuth, build the histogram at each point
+      for (int y=0; y<ny; ++y)
       {
+	vector<double> dataInBox = pt.dataInsideCircle(x, y, a);
+	if (dataInBox.empty())
+	{
+	  LOG(DEBUG_VERBOSE) << "No data x=" << x;
+	  continue;
+	}
+	H.clear();
 	for (size_t i=0; i<dataInBox.size(); ++i)
 	{
 	  H.addValue(dataInBox[i]);
-	  double m;
-	  if (H.getMedian(m))
-	  {
-	    out.setValue(x, y, m);
-	  }
-	  else
-	  {
-	    LOG(WARNING) << "No median x=" << x;
-	  }
 	}
+	double m;
+	if (H.getMedian(m))
+	{
+	  out.setValue(x, y, m);
+	}
+	else
+	{
+	  LOG(WARNING) << "No median x=" << x;
+	}
+      }
+      continue;
+    }
+
+    // slide the histogram along the azimuths
+    H.clear();
+    for (size_t i=0; i<spans.size(); ++i)
+    {
+      for (int aj=spans[i]._a0; aj<=spans[i]._a1; ++aj)
+      {
+	_histoUpdate(H, a, spans[i]._r, aj, pt.isCircular(), true);
+      }
+    }
+    for (int y=0; y<ny; ++y)
+    {
+      if (y > 0)
+      {
+	for (size_t i=0; i<spans.size(); ++i)
+	{
+	  _histoUpdate(H, a, spans[i]._r, y - 1 + spans[i]._a0,
+		       pt.isCircular(), false);
+	  _histoUpdate(H, a, spans[i]._r, y + spans[i]._a1,
+		       pt.isCircular(), true);
+	}
+      }
+      double m;
+      if (H.getMedian(m))
+      {
+	out.setValue(x, y, m);
       }
     }
   }
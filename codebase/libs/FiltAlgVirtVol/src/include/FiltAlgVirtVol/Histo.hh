@@ -17,11 +17,17 @@ public:
   ~Histo();
   void clear(void);
   void addValue(double d);
+  void removeValue(double d);
   bool getMedian(double &m) const;
   bool getPercentile(double pct, double &m) const;
 private:
 
   bool _pcntile(double pct, double &m) const;
+  int _binIndex(double d) const;
+
+  // bins are grouped into coarse bins of 16 fine bins, to speed up
+  // the search for a percentile
+  static const int _fineShift = 4;
 
   double _binMin;
   double _binMax;
@@ -29,6 +35,7 @@ private:
   int _nbin;
   std::vector<double> _bin;
   std::vector<double> _counts;
+  std::vector<double> _coarse;
   double _nc;
 };
 
@@ -70,6 +70,11 @@ public:
    * 
    * At each point set output to median of values in the template
    *
+   * Where the template at a gate is contiguous in azimuth at each gate
+   * it covers, the histogram is slid along the azimuths, taking out and
+   * putting in one value per covered gate at each step, rather than being
+   * rebuilt at each point.
+   *
    * @param[in,out] a  The grid read/write
    * @param[in] pt  The template
    * @param[in] binMin histogram spec
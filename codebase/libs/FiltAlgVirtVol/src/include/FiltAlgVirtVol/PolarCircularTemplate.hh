@@ -47,6 +47,11 @@ public:
    */
   inline int nGates(void) const {return _ngates;}
 
+  /**
+   * @return true if the azimuths wrap around a full circle
+   */
+  inline bool isCircular(void) const {return _circular;}
+
   /**
    * @return reference to indexed indivdual lookup
    * @param[in] i
@@ -33,6 +33,7 @@
                                  
 #include <cassert>
 #include <cstdarg>
+#include <cmath>
 #include <dataport/bigend.h>
 #include <toolsa/MsgLog.hh>
 #include <toolsa/TaStr.hh>
@@ -61,6 +62,7 @@ Fmq::Fmq()
   _bufSize = 0;
   _msecSleep = -1;
   _msecBlockingReadTimeout = -1;
+  _msecNotifyWait = 1000;
 
   _dev = NULL;
   _msgLog = NULL;
@@ -391,13 +393,18 @@ Fmq::closeMsgQueue()
 
 /////////////////////////////////////////////////////////////////
 // setting the compression method
-// only use GZIP compression, others are deprecated
+// Use GZIP, ZSTD or LZ4 compression, others are deprecated.
+// ZSTD and LZ4 revert to GZIP if not available in toolsa.
 // Returns 0 on success, -1 on error
 
 int Fmq::setCompressionMethod(ta_compression_method_t method)
 {
   if (method == TA_COMPRESSION_NONE) {
     _compressMethod = TA_COMPRESSION_NONE;
+  } else if ((method == TA_COMPRESSION_ZSTD ||
+              method == TA_COMPRESSION_LZ4) &&
+             ta_compression_available(method)) {
+    _compressMethod = method;
   } else {
     _compressMethod = TA_COMPRESSION_GZIP;
   }
@@ -1593,6 +1600,10 @@ int Fmq::_read(int *msg_read, int type)
 //  a message is received. Registers with procmap while
 //  waiting.
 //
+//  If the device supports write notification, waits for the
+//  writer to signal a new message, for up to _msecNotifyWait
+//  at a time. Otherwise sleeps between reads.
+//
 //   Parameters:
 //
 //    msecs_sleep - number of millisecs to sleep between reads
@@ -1612,13 +1623,24 @@ int Fmq::_read_blocking (int msecs_sleep, int type)
 {
 
   int msg_read;
-  int sleepTotalMsecs = 0;
   if (msecs_sleep < 0) {
     msecs_sleep = 10;
   }
 
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  double waitStart = tv.tv_sec + (double) tv.tv_usec / 1.0e6;
+
   while (true) {
 
+    // arm the write notification before checking the queue,
+    // so that a write after the check is not missed
+
+    bool notify = false;
+    if (_msecNotifyWait > 0 && _dev->prepare_wait() == 0) {
+      notify = true;
+    }
+
     if(_read_next(&msg_read)) {
       return -1; // error
     }
@@ -1634,17 +1656,32 @@ int Fmq::_read_blocking (int msecs_sleep, int type)
 	return 0;
       }
 
-      sleepTotalMsecs = 0;
+      gettimeofday(&tv, NULL);
+      waitStart = tv.tv_sec + (double) tv.tv_usec / 1.0e6;
 
     } else {
 
-      umsleep(msecs_sleep);
-      sleepTotalMsecs += msecs_sleep;
+      // do not wait past the blocking read timeout
+
+      int msecsWait = notify ? _msecNotifyWait : msecs_sleep;
+      if (_msecBlockingReadTimeout > 0) {
+        gettimeofday(&tv, NULL);
+        double now = tv.tv_sec + (double) tv.tv_usec / 1.0e6;
+        double msecsLeft =
+          _msecBlockingReadTimeout - (now - waitStart) * 1.0e3;
+        if (msecsLeft <= 0) {
+          _errStr += "Fmq _read_blocking timed out\n";
+          return -1;
+        }
+        if (msecsWait > msecsLeft) {
+          msecsWait = (int) ceil(msecsLeft);
+        }
+      }
 
-      if (_msecBlockingReadTimeout > 0 && 
-          sleepTotalMsecs > _msecBlockingReadTimeout) {
-        _errStr += "Fmq _read_blocking timed out\n";
-        return -1;
+      if (notify) {
+        _dev->wait_for_write(msecsWait);
+      } else {
+        umsleep(msecsWait);
       }
     
     } // if (msg_read)
@@ -2444,6 +2481,12 @@ int Fmq::_write(void *msg, int msg_len,
   iret = _write_msg(msg, msg_len, msg_type, msg_subtype,
 		    false, msg_len);
   _unlock_device();
+
+  // wake up readers waiting on the queue
+
+  if (iret == 0) {
+    _dev->notify_write();
+  }
   
   return (iret);
   
@@ -2477,6 +2520,12 @@ int Fmq::_write_precompressed(void *msg, int msg_len,
   iret = _write_msg(msg, msg_len, msg_type, msg_subtype,
 		    true, uncompressed_len);
   _unlock_device();
+
+  // wake up readers waiting on the queue
+
+  if (iret == 0) {
+    _dev->notify_write();
+  }
   
   return (iret);
 
@@ -34,6 +34,10 @@
 
 #include <cerrno>                                 
 #include <unistd.h>
+#include <poll.h>
+#if defined(__linux__)
+#include <sys/inotify.h>
+#endif
 #include <dataport/bigend.h>
 #include <toolsa/file_io.h>
 #include <toolsa/uusleep.h>
@@ -67,6 +71,9 @@ FmqDeviceFile::FmqDeviceFile(const string &fmqPath,
   _stat_fd = 0;
   _buf_fd = 0;
 
+  _notify_fd = -1;
+  _notify_wd = -1;
+
 }
 
 FmqDeviceFile::~FmqDeviceFile()
@@ -168,6 +175,10 @@ void FmqDeviceFile::do_close()
 
   clearErrStr();
 
+  // stop write notification
+
+  _close_notify();
+
   // close stat file
   
   if (_stat_file != NULL) {
@@ -516,3 +527,131 @@ int FmqDeviceFile::update_last_id_read(int lastIdRead)
 
 }
 
+
+/////////////////////////////////////////////////////////////////
+// Prepare to wait for a write.
+//
+// Sets up the inotify watch on the stat file if needed, and
+// discards any events already queued. Events from writes after
+// this call stay queued until wait_for_write(), so a write which
+// occurs between the reader's check and its wait is not missed.
+//
+//  Return value:
+//    0 on success, -1 if notification is not available.
+
+int FmqDeviceFile::prepare_wait()
+
+{
+
+#if defined(__linux__)
+
+  if (_notify_fd < 0) {
+    return _open_notify();
+  }
+
+  // drain the queued events
+  
+  char events[4096]
+    __attribute__ ((aligned(__alignof__(struct inotify_event))));
+  bool watchRemoved = false;
+  
+  while (true) {
+    ssize_t len = read(_notify_fd, events, sizeof(events));
+    if (len <= 0) {
+      break;
+    }
+    for (char *ptr = events; ptr < events + len; ) {
+      const struct inotify_event *event = (const struct inotify_event *) ptr;
+      if (event->mask & (IN_IGNORED | IN_DELETE_SELF | IN_MOVE_SELF)) {
+        watchRemoved = true;
+      }
+      ptr += sizeof(struct inotify_event) + event->len;
+    }
+  }
+
+  // if the stat file has been removed or replaced, for example
+  // when the writer re-creates the queue, watch the new file
+
+  if (watchRemoved) {
+    _close_notify();
+    return _open_notify();
+  }
+
+  return 0;
+
+#else
+
+  return -1;
+
+#endif
+
+}
+
+/////////////////////////////////////////////////////////////////
+// Wait for a write to the stat file, or for msecs to elapse.
+
+void FmqDeviceFile::wait_for_write(int msecs)
+
+{
+
+  if (_notify_fd < 0) {
+    umsleep(msecs);
+    return;
+  }
+
+  struct pollfd pfd;
+  pfd.fd = _notify_fd;
+  pfd.events = POLLIN;
+  pfd.revents = 0;
+  poll(&pfd, 1, msecs);
+
+}
+
+/////////////////////////////////////////////////////////////////
+// Set up the inotify watch on the stat file
+//
+//  Return value:
+//    0 on success, -1 on failure.
+
+int FmqDeviceFile::_open_notify()
+
+{
+
+#if defined(__linux__)
+
+  _notify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (_notify_fd < 0) {
+    return -1;
+  }
+
+  _notify_wd = inotify_add_watch(_notify_fd, _stat_path.c_str(),
+                                 IN_MODIFY | IN_CLOSE_WRITE |
+                                 IN_DELETE_SELF | IN_MOVE_SELF);
+  if (_notify_wd < 0) {
+    _close_notify();
+    return -1;
+  }
+
+  return 0;
+
+#else
+
+  return -1;
+
+#endif
+
+}
+
+/////////////////////////////////////////////////////////////////
+// Close the inotify watch
+
+void FmqDeviceFile::_close_notify()
+
+{
+  if (_notify_fd >= 0) {
+    close(_notify_fd);
+  }
+  _notify_fd = -1;
+  _notify_wd = -1;
+}
+
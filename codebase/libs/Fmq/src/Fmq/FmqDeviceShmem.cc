@@ -46,6 +46,13 @@
 #include <sys/shm.h>
 #include <sys/fcntl.h>
 #include <semaphore.h>
+#include <climits>
+#include <ctime>
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 using namespace std;
 
 FmqDeviceShmem::FmqDeviceShmem(const string &fmqPath,
@@ -68,6 +75,8 @@ FmqDeviceShmem::FmqDeviceShmem(const string &fmqPath,
   _offset[STAT_IDENT] = 0;
   _offset[BUF_IDENT] = 0;
 
+  _waitYoungestId = 0;
+
   // initialize size of stat and buf segments
   // these will be updated later if queue already exists
   
@@ -547,6 +556,93 @@ int FmqDeviceShmem::update_last_id_read(int lastIdRead)
 
 }
 
+////////////////////////////////////////////////////////////
+// Prepare to wait for a write.
+//
+// Saves the current youngest_id word from the status segment.
+// wait_for_write() returns immediately if it has changed since,
+// so a write between the reader's check and its wait is not missed.
+//
+//  Return value:
+//    0 on success, -1 if notification is not available.
+
+int FmqDeviceShmem::prepare_wait()
+
+{
+
+#if defined(__linux__)
+  volatile si32 *youngestId = _youngestIdPtr();
+  if (youngestId == NULL) {
+    return -1;
+  }
+  _waitYoungestId = *youngestId;
+  return 0;
+#else
+  return -1;
+#endif
+
+}
+
+////////////////////////////////////////////////////////////
+// Wait for a writer to update youngest_id, or for msecs to elapse.
+
+void FmqDeviceShmem::wait_for_write(int msecs)
+
+{
+
+#if defined(__linux__)
+  volatile si32 *youngestId = _youngestIdPtr();
+  if (youngestId != NULL) {
+    struct timespec timeout;
+    timeout.tv_sec = msecs / 1000;
+    timeout.tv_nsec = (msecs % 1000) * 1000000L;
+    // the segment is shared between processes, so the futex
+    // must not be FUTEX_PRIVATE
+    syscall(SYS_futex, youngestId, FUTEX_WAIT, _waitYoungestId,
+            &timeout, NULL, 0);
+    return;
+  }
+#endif
+
+  umsleep(msecs);
+
+}
+
+////////////////////////////////////////////////////////////
+// Wake any readers waiting for a write.
+
+void FmqDeviceShmem::notify_write()
+
+{
+
+#if defined(__linux__)
+  volatile si32 *youngestId = _youngestIdPtr();
+  if (youngestId != NULL) {
+    syscall(SYS_futex, youngestId, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+  }
+#endif
+
+}
+
+////////////////////////////////////////////////////////////
+// Get pointer to the youngest_id word in the status segment.
+// Returns NULL if the segment is not attached.
+
+volatile si32 *FmqDeviceShmem::_youngestIdPtr()
+
+{
+
+  if (_statPtr == NULL) {
+    return NULL;
+  }
+
+  Fmq::q_stat_t stat;
+  off_t offset = (char *) &stat.youngest_id - (char *) &stat.magic_cookie;
+  
+  return (volatile si32 *) (_statPtr + offset);
+
+}
+
 ////////////////////////////////////////////////////////////
 // Get the segment name
 
@@ -314,6 +314,21 @@ public:
   // Setting a timeout for blocking reads
 
   void setBlockingReadTimeout(int msecs) { _msecBlockingReadTimeout = msecs; }
+
+  // Write notification for blocking reads.
+  //
+  // Where the device supports it (inotify for file queues, futex for
+  // shmem queues, on Linux), readMsgBlocking() waits for the writer
+  // to signal a new message rather than sleeping between checks.
+  // The wait is bounded by msecs, after which the queue is checked
+  // anyway and the heartbeat function is called. Default is 1000.
+  //
+  // Set msecs to 0 to disable notification and poll the queue,
+  // sleeping msecSleep between checks. Use this if the writer may
+  // not signal the reader, e.g. a file queue on a network file
+  // system written from another host.
+
+  void setBlockingReadNotifyWait(int msecs) { _msecNotifyWait = msecs; }
  
   // Closing the fmq
   // returns 0 on success, -1 on failure
@@ -321,6 +336,9 @@ public:
   virtual int closeMsgQueue();
 
   // setting the compression method - default is GZIP compression
+  // TA_COMPRESSION_ZSTD and TA_COMPRESSION_LZ4 are faster, if available.
+  // Readers detect the method from each message, so older queues
+  // and writers are still read correctly.
   // Returns 0 on success, -1 on error
 
   virtual int setCompressionMethod(ta_compression_method_t method);
@@ -600,6 +618,7 @@ protected:
   int _bufSize;
   int _msecSleep;
   int _msecBlockingReadTimeout;
+  int _msecNotifyWait;
 
   // logging
   
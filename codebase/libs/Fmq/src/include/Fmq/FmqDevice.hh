@@ -37,6 +37,7 @@
 
 #include <string>
 #include <toolsa/heartbeat.h>
+#include <toolsa/uusleep.h>
 using namespace std;
 
 // class definition
@@ -107,6 +108,24 @@ public:
 
   virtual int get_size(ident_t id) = 0;
   
+  // Write notification, for blocking reads.
+  //
+  // A reader calls prepare_wait() before checking the queue for
+  // new messages. If none are found it calls wait_for_write(),
+  // which returns as soon as a writer has committed a message since
+  // prepare_wait() was called, or after msecs have elapsed.
+  // prepare_wait() returns 0 if notification is available on this
+  // device, -1 otherwise, in which case the reader should fall back
+  // to sleeping between checks.
+  //
+  // Writers call notify_write() after each message is committed.
+  //
+  // The default implementation does not support notification.
+
+  virtual int prepare_wait() { return -1; }
+  virtual void wait_for_write(int msecs) { umsleep(msecs); }
+  virtual void notify_write() {}
+
   ///////////////////////////////////////////////////////////////////
   // error string is set during open/read/write operations
   // get error string is an error is returned
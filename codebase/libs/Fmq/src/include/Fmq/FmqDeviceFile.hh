@@ -104,6 +104,15 @@ public:
 
   virtual int get_size(ident_t id);
   
+  // Write notification for blocking reads.
+  // On Linux, uses inotify on the stat file, which is modified on
+  // every write. Not available on other systems.
+  // Note: inotify does not see writes made from other hosts to a
+  // queue on a network file system.
+
+  virtual int prepare_wait();
+  virtual void wait_for_write(int msecs);
+
 protected:
 
 private:
@@ -124,6 +133,14 @@ private:
   int _buf_fd;
   int _fd[N_IDENT];
 
+  // inotify for write notification
+
+  int _notify_fd;
+  int _notify_wd;
+
+  int _open_notify();
+  void _close_notify();
+
 };
 
 #endif
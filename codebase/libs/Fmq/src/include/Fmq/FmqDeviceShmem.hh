@@ -36,6 +36,7 @@
 #define _FMQ_DEVICE_SHMEM_HH_INCLUDED_
 
 #include <sys/types.h>
+#include <dataport/port_types.h>
 #include <Fmq/FmqDevice.hh>
 using namespace std;
 
@@ -101,6 +102,15 @@ public:
 
   virtual int get_size(ident_t id);
   
+  // Write notification for blocking reads.
+  // On Linux, readers wait on a futex on the youngest_id word in the
+  // status segment, and writers wake them after each write.
+  // Not available on other systems.
+
+  virtual int prepare_wait();
+  virtual void wait_for_write(int msecs);
+  virtual void notify_write();
+
 protected:
 
 private:
@@ -123,12 +133,17 @@ private:
   // off_t _bufOffset; // current offset in buf segment
   off_t _offset[N_IDENT];
 
+  // youngest_id value seen by prepare_wait()
+
+  si32 _waitYoungestId;
+
   // lock file for synchronization
   
   string _lock_path;
   FILE *_lock_file;
   
   const char *_getSegName(ident_t id);
+  volatile si32 *_youngestIdPtr();
   
   int _open_create();
   int _open_rdwr();
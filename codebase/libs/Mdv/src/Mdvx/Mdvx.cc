@@ -62,6 +62,7 @@ Mdvx::Mdvx()
 {
   _debug = false;
   _heartbeatFunc = NULL;
+  _readNThreads = 1;
   clear();
 }
 
@@ -261,6 +262,7 @@ Mdvx &Mdvx::_copy(const Mdvx &rhs)
   _readAsSingleBuffer = rhs._readAsSingleBuffer;
 
   _read32BitHeaders = rhs._read32BitHeaders;
+  _readNThreads = rhs._readNThreads;
 
   // write request members
 
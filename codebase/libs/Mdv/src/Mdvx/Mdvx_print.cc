@@ -1220,6 +1220,10 @@ const char *Mdvx::compressionType2Str(const int compression_type)
     return("COMPRESSION_GZIP");
   case COMPRESSION_GZIP_VOL:
     return("COMPRESSION_GZIP_VOL");
+  case COMPRESSION_ZSTD:
+    return("COMPRESSION_ZSTD");
+  case COMPRESSION_LZ4:
+    return("COMPRESSION_LZ4");
   default:
     return (_labelledInt("Unknown compression type", compression_type));
   }
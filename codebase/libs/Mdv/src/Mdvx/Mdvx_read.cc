@@ -49,6 +49,7 @@
 #include <toolsa/Path.hh>
 #include <dataport/bigend.h>
 #include <sys/stat.h>
+#include <pthread.h>
 using namespace std;
 
 //////////////////////////////
@@ -1097,6 +1098,17 @@ void Mdvx::clearReadAsSingleBuffer()
   _readAsSingleBuffer = false;
 }
 
+///////////////////////
+// number of read threads
+
+void Mdvx::setReadNThreads(int n_threads)
+{
+  _readNThreads = n_threads;
+  if (_readNThreads < 1) {
+    _readNThreads = 1;
+  }
+}
+
 void Mdvx::setReadAsSinglePart()
 {
   setReadAsSingleBuffer();
@@ -3061,36 +3073,51 @@ int Mdvx::_readVolumeMdv(bool fill_missing,
 
   // create the fields, read in the data volume for each field
 
-  MdvxRemapLut remapLut;
+  if (_readNThreads > 1 && _readFieldNums.size() > 1) {
 
-  for (size_t i = 0; i < _readFieldNums.size(); i++) {
-    
-    MdvxField *field = new MdvxField(_fhdrsFile[_readFieldNums[i]],
-                                     _vhdrsFile[_readFieldNums[i]], NULL);
-    if (field == NULL) {
+    // read, decompress and convert fields concurrently
+
+    if (_readFieldsThreaded(infile, fill_missing,
+                            do_decimate, do_final_convert,
+                            is_vsection, vsection_min_lon, vsection_max_lon)) {
       _errStr += "ERROR - Mdvx::_readVolumeMdv.\n";
-      char errstr[128];
-      safe_snprintf(errstr, " Allocating field mem");
-      _errStr += errstr;
       return -1;
     }
+
+  } else {
+
+    MdvxRemapLut remapLut;
+
+    for (size_t i = 0; i < _readFieldNums.size(); i++) {
     
-    if (field->_read_volume(infile, *this, fill_missing,
-			    do_decimate, do_final_convert, remapLut,
-			    is_vsection, vsection_min_lon, vsection_max_lon)) {
-      _errStr += "ERROR - Mdvx::_readVolumeMdv.\n";
-      char errstr[128];
-      safe_snprintf(errstr, "  Reading field %d\n", (int) i);
-      _errStr += errstr;
-      _errStr += field->getErrStr();
-      delete field;
-      return -1;
-    }
+      MdvxField *field = new MdvxField(_fhdrsFile[_readFieldNums[i]],
+                                       _vhdrsFile[_readFieldNums[i]], NULL);
+      if (field == NULL) {
+        _errStr += "ERROR - Mdvx::_readVolumeMdv.\n";
+        char errstr[128];
+        safe_snprintf(errstr, " Allocating field mem");
+        _errStr += errstr;
+        return -1;
+      }
+    
+      if (field->_read_volume(infile, *this, fill_missing,
+                              do_decimate, do_final_convert, remapLut,
+                              is_vsection, vsection_min_lon, vsection_max_lon)) {
+        _errStr += "ERROR - Mdvx::_readVolumeMdv.\n";
+        char errstr[128];
+        safe_snprintf(errstr, "  Reading field %d\n", (int) i);
+        _errStr += errstr;
+        _errStr += field->getErrStr();
+        delete field;
+        return -1;
+      }
 
-    _fields.push_back(field);
+      _fields.push_back(field);
+
+      if (_heartbeatFunc != NULL) {
+        _heartbeatFunc("Mdvx::_readVolumeMdv");
+      }
 
-    if (_heartbeatFunc != NULL) {
-      _heartbeatFunc("Mdvx::_readVolumeMdv");
     }
 
   }
@@ -3136,6 +3163,169 @@ int Mdvx::_readVolumeMdv(bool fill_missing,
 
 }
 
+//////////////////////////////////////////////////////////
+// context shared by the threads in _readFieldsThreaded()
+
+namespace {
+
+  class ReadFieldsContext {
+  public:
+    const Mdvx *mdvx;
+    int fd;
+    bool fill_missing;
+    bool do_decimate;
+    bool do_final_convert;
+    bool is_vsection;
+    double vsection_min_lon;
+    double vsection_max_lon;
+    vector<MdvxField *> fields;
+    vector<bool> failed;
+    size_t nextField;
+    bool error;
+    pthread_mutex_t mutex;
+  };
+
+}
+
+//////////////////////////////////////////////////////////
+// Read the requested fields using a pool of threads.
+//
+// The fields are read with positional reads on the already open
+// file, so the threads do not share a file offset. Each thread then
+// decompresses, converts and remaps its field, using its own remap
+// lookup table. The fields are added in the requested order.
+//
+// Returns 0 on success, -1 on failure.
+
+int Mdvx::_readFieldsThreaded(TaFile &infile,
+                              bool fill_missing,
+                              bool do_decimate,
+                              bool do_final_convert,
+                              bool is_vsection,
+                              double vsection_min_lon,
+                              double vsection_max_lon)
+  
+{
+
+  ReadFieldsContext context;
+  context.mdvx = this;
+  context.fd = fileno(infile.getFILE());
+  context.fill_missing = fill_missing;
+  context.do_decimate = do_decimate;
+  context.do_final_convert = do_final_convert;
+  context.is_vsection = is_vsection;
+  context.vsection_min_lon = vsection_min_lon;
+  context.vsection_max_lon = vsection_max_lon;
+  context.nextField = 0;
+  context.error = false;
+  pthread_mutex_init(&context.mutex, NULL);
+
+  for (size_t i = 0; i < _readFieldNums.size(); i++) {
+    MdvxField *field = new MdvxField(_fhdrsFile[_readFieldNums[i]],
+                                     _vhdrsFile[_readFieldNums[i]], NULL);
+    context.fields.push_back(field);
+    context.failed.push_back(false);
+  }
+
+  // start the worker threads - the calling thread also does its share
+
+  size_t nThreads = _readNThreads;
+  if (nThreads > context.fields.size()) {
+    nThreads = context.fields.size();
+  }
+  vector<pthread_t> threads;
+  for (size_t i = 1; i < nThreads; i++) {
+    pthread_t thread;
+    if (pthread_create(&thread, NULL,
+                       _readFieldsThreadMain, (void *) &context)) {
+      // cannot create more threads, carry on with the ones we have
+      break;
+    }
+    threads.push_back(thread);
+  }
+  _readFieldsThreadMain((void *) &context);
+  for (size_t i = 0; i < threads.size(); i++) {
+    pthread_join(threads[i], NULL);
+  }
+  pthread_mutex_destroy(&context.mutex);
+
+  // check for errors
+
+  if (context.error) {
+    _errStr += "ERROR - Mdvx::_readFieldsThreaded.\n";
+    for (size_t i = 0; i < context.fields.size(); i++) {
+      if (context.failed[i]) {
+        char errstr[128];
+        safe_snprintf(errstr, "  Reading field %d\n", (int) i);
+        _errStr += errstr;
+        _errStr += context.fields[i]->getErrStr();
+      }
+      delete context.fields[i];
+    }
+    return -1;
+  }
+
+  // add the fields in order
+
+  for (size_t i = 0; i < context.fields.size(); i++) {
+    _fields.push_back(context.fields[i]);
+    if (_heartbeatFunc != NULL) {
+      _heartbeatFunc("Mdvx::_readVolumeMdv");
+    }
+  }
+
+  return 0;
+
+}
+
+//////////////////////////////////////////////////////////
+// Thread main for _readFieldsThreaded().
+// Takes the next unread field until all fields are done,
+// or an error occurs.
+
+void *Mdvx::_readFieldsThreadMain(void *args)
+  
+{
+
+  ReadFieldsContext *context = (ReadFieldsContext *) args;
+
+  // the remap lookup table is not thread safe, so each
+  // thread has its own
+
+  MdvxRemapLut remapLut;
+
+  while (true) {
+
+    pthread_mutex_lock(&context->mutex);
+    if (context->error || context->nextField >= context->fields.size()) {
+      pthread_mutex_unlock(&context->mutex);
+      break;
+    }
+    size_t index = context->nextField;
+    context->nextField++;
+    pthread_mutex_unlock(&context->mutex);
+
+    MdvxField *field = context->fields[index];
+    if (field->_read_volume_pread(context->fd, *context->mdvx,
+                                  context->fill_missing,
+                                  context->do_decimate,
+                                  context->do_final_convert,
+                                  remapLut,
+                                  context->is_vsection,
+                                  context->vsection_min_lon,
+                                  context->vsection_max_lon)) {
+      pthread_mutex_lock(&context->mutex);
+      context->failed[index] = true;
+      context->error = true;
+      pthread_mutex_unlock(&context->mutex);
+    }
+
+  } // while
+
+  return NULL;
+
+}
+
 //////////////////////////////////////////////////////////
 // Private read vertical section method
 // Returns 0 on success, -1 on failure
@@ -53,6 +53,8 @@
 #include <iomanip>
 #include <limits>
 #include <cerrno>
+#include <cstring>
+#include <unistd.h>
 using namespace std;
 
 #define PSEUDO_RADIUS 8533.0
@@ -847,6 +849,8 @@ vector<double> MdvxField::getVlevels() const
 //   Mdvx::COMPRESSION_BZIP - see <toolsa/compress.h>
 //   Mdvx::COMPRESSION_GZIP - see <toolsa/compress.h>
 //   Mdvx::COMPRESSION_GZIP_VOL - GZIP with single buffer for vol
+//   Mdvx::COMPRESSION_ZSTD - see <toolsa/compress.h>
+//   Mdvx::COMPRESSION_LZ4 - see <toolsa/compress.h>
 //
 // Scaling types apply only to conversions to int types (INT8 and INT16)
 //
@@ -5737,7 +5741,7 @@ int MdvxField::compress(int compression_type) const
   }
   
   // check if we are already properly compressed
-  // now use gzip for all compression
+  // now use gzip, zstd or lz4 for all compression
 
   if (compression_type == Mdvx::COMPRESSION_ASIS) {
     return 0;
@@ -5753,6 +5757,12 @@ int MdvxField::compress(int compression_type) const
     return 0;
   }
 
+  if ((compression_type == Mdvx::COMPRESSION_ZSTD ||
+       compression_type == Mdvx::COMPRESSION_LZ4) &&
+      _fhdr.compression_type == compression_type) {
+    return 0;
+  }
+
   // uncompress
 
   if (decompress()) {
@@ -5769,7 +5779,11 @@ int MdvxField::compress(int compression_type) const
     return _compressGzipVol();
   }
 
-  // proceed with gzip compression
+  // proceed with per-plane compression
+
+  ta_compression_method_t ta_method;
+  Mdvx::compression_type_t plane_compression =
+    _planeCompressionType(compression_type, ta_method);
 
   int nz = _fhdr.nz;
   int64_t npoints_plane = _fhdr.nx * _fhdr.ny;
@@ -5792,11 +5806,9 @@ int MdvxField::compress(int compression_type) const
 
   for (int iz = 0; iz < nz; iz++) {
 
-    // only use GZIP compression - all others are deprecated
-    
     void *uncompressed_plane = ((char *) _volBuf.getPtr() + iz * nbytes_plane);
     ui64 nbytes_compressed;
-    void *compressed_plane = ta_compress(TA_COMPRESSION_GZIP,
+    void *compressed_plane = ta_compress(ta_method,
                                          uncompressed_plane,
                                          nbytes_plane,
                                          &nbytes_compressed);
@@ -5831,7 +5843,7 @@ int MdvxField::compress(int compression_type) const
 
   // adjust header
 
-  _fhdr.compression_type = Mdvx::COMPRESSION_GZIP;
+  _fhdr.compression_type = plane_compression;
   _fhdr.volume_size = next_offset + 2 * index_array_size;
 
   return 0;
@@ -5862,7 +5874,7 @@ int MdvxField::compress64(int compression_type) const
   }
   
   // check if we are already properly compressed
-  // now use gzip for all compression
+  // now use gzip, zstd or lz4 for all compression
 
   if (compression_type == Mdvx::COMPRESSION_ASIS) {
     return 0;
@@ -5878,6 +5890,12 @@ int MdvxField::compress64(int compression_type) const
     return 0;
   }
 
+  if ((compression_type == Mdvx::COMPRESSION_ZSTD ||
+       compression_type == Mdvx::COMPRESSION_LZ4) &&
+      _fhdr.compression_type == compression_type) {
+    return 0;
+  }
+
   // uncompress
 
   if (decompress()) {
@@ -5894,7 +5912,11 @@ int MdvxField::compress64(int compression_type) const
     return _compressGzipVol();
   }
 
-  // proceed with gzip compression
+  // proceed with per-plane compression
+
+  ta_compression_method_t ta_method;
+  Mdvx::compression_type_t plane_compression =
+    _planeCompressionType(compression_type, ta_method);
 
   ui32 flags64[2] = { MDV_FLAG_64, MDV_FLAG_64 };
   int nz = _fhdr.nz;
@@ -5918,11 +5940,9 @@ int MdvxField::compress64(int compression_type) const
 
   for (int iz = 0; iz < nz; iz++) {
 
-    // only use GZIP compression - all others are deprecated
-    
     void *uncompressed_plane = ((char *) _volBuf.getPtr() + iz * nbytes_plane);
     ui64 nbytes_compressed;
-    void *compressed_plane = ta_compress(TA_COMPRESSION_GZIP,
+    void *compressed_plane = ta_compress(ta_method,
                                          uncompressed_plane,
                                          nbytes_plane,
                                          &nbytes_compressed);
@@ -5958,13 +5978,43 @@ int MdvxField::compress64(int compression_type) const
 
   // adjust header
 
-  _fhdr.compression_type = Mdvx::COMPRESSION_GZIP;
+  _fhdr.compression_type = plane_compression;
   _fhdr.volume_size = next_offset + 2 * index_array_size;
 
   return 0;
 
 }
 
+///////////////////////////////////////////////////////////////
+// Determine the per-plane compression type to use for a requested
+// type, and the matching toolsa method.
+//
+// ZSTD and LZ4 are used if requested and available in toolsa.
+// All other types are deprecated, and GZIP is used instead.
+
+Mdvx::compression_type_t
+  MdvxField::_planeCompressionType(int compression_type,
+                                   ta_compression_method_t &ta_method)
+
+{
+
+  if (compression_type == Mdvx::COMPRESSION_ZSTD &&
+      ta_compression_available(TA_COMPRESSION_ZSTD)) {
+    ta_method = TA_COMPRESSION_ZSTD;
+    return Mdvx::COMPRESSION_ZSTD;
+  }
+
+  if (compression_type == Mdvx::COMPRESSION_LZ4 &&
+      ta_compression_available(TA_COMPRESSION_LZ4)) {
+    ta_method = TA_COMPRESSION_LZ4;
+    return Mdvx::COMPRESSION_LZ4;
+  }
+
+  ta_method = TA_COMPRESSION_GZIP;
+  return Mdvx::COMPRESSION_GZIP;
+
+}
+
 ///////////////////////////////////////////////////////////////
 // compress the data volume into a single GZIP buffer
 //
@@ -6618,6 +6668,83 @@ int MdvxField::_read_volume(TaFile &infile,
 
 }
 
+//////////////////////////////////////////////////////////////////////////
+//
+// Read a field volume from an open file descriptor, using positional
+// reads (pread) so that the file offset is not shared between callers.
+//
+// This allows several fields to be read and converted concurrently from
+// the same file, one thread per field. Apart from the read itself, this
+// behaves exactly as _read_volume().
+//
+// The remapLut must not be shared between threads.
+//
+// Returns 0 on success, -1 on failure.
+//
+
+int MdvxField::_read_volume_pread(int fd,
+                                  const Mdvx &mdvx,
+                                  bool fill_missing,
+                                  bool do_decimate,
+                                  bool do_final_convert,
+                                  MdvxRemapLut &remapLut,
+                                  bool is_vsection,
+                                  double vsection_min_lon,
+                                  double vsection_max_lon)
+  
+{
+
+  clearErrStr();
+
+  size_t volume_size = _fhdr.volume_size;
+  char *buf = (char *) _volBuf.prepare(volume_size);
+  off_t offset = _fhdr.field_data_offset;
+  size_t nDone = 0;
+
+  while (nDone < volume_size) {
+    ssize_t nRead = pread(fd, buf + nDone, volume_size - nDone,
+                          offset + nDone);
+    if (nRead < 0 && errno == EINTR) {
+      continue;
+    }
+    if (nRead <= 0) {
+      _errStr += "ERROR - MdvxField::_read_volume_pread\n";
+      _errStr += "  Cannot read field: ";
+      _errStr += _fhdr.field_name;
+      _errStr += "\n";
+      if (nRead < 0) {
+        _errStr += "  ";
+        _errStr += strerror(errno);
+        _errStr += "\n";
+      }
+      return -1;
+    }
+    nDone += nRead;
+  }
+  
+  // byte swap as needed
+
+  _data_from_BE(_fhdr, _volBuf.getPtr(), _volBuf.getLen());
+
+  // set headers exactly as in file
+
+  setFieldHeaderFile(_fhdr);
+  setVlevelHeaderFile(_vhdr);
+
+  // convert according to the read request
+
+  if (_apply_read_constraints(mdvx, fill_missing, do_decimate,
+                              do_final_convert,
+                              remapLut, is_vsection, false,
+                              vsection_min_lon, vsection_max_lon)) {
+    _errStr += "ERROR - MdvxField::_read_volume_pread\n";
+    return -1;
+  }
+    
+  return 0;
+
+}
+
 //////////////////////////////////////////////////////////////////////////
 //
 // convert a field after reading in the data
@@ -623,6 +623,10 @@ protected:
 
   bool _read32BitHeaders;
 
+  // number of threads for reading fields in local MDV reads
+
+  int _readNThreads;
+
   // write request members
 
   bool _writeLdataInfo;
@@ -751,6 +755,16 @@ protected:
                      double vsection_min_lon = -360.0,
                      double vsection_max_lon = 360.0);
   
+  int _readFieldsThreaded(TaFile &infile,
+                          bool fill_missing,
+                          bool do_decimate,
+                          bool do_final_convert,
+                          bool is_vsection,
+                          double vsection_min_lon,
+                          double vsection_max_lon);
+
+  static void *_readFieldsThreadMain(void *args);
+
   int _readVsectionMdv();
   
   int _convertFormatOnRead(const string &caller);
@@ -70,6 +70,7 @@
 #include <Mdv/MdvxRemapLut.hh>
 #include <toolsa/MemBuf.hh>
 #include <toolsa/TaFile.hh>
+#include <toolsa/compress.h>
 #include <vector>
 
 #define MDV_FLAG_64 0x64646464U
@@ -182,6 +183,8 @@ public:
   //   Mdvx::COMPRESSION_ZLIB - see <toolsa/compress.h>
   //   Mdvx::COMPRESSION_BZIP - see <toolsa/compress.h>
   //   Mdvx::COMPRESSION_GZIP - see <toolsa/compress.h>
+  //   Mdvx::COMPRESSION_ZSTD - see <toolsa/compress.h>
+  //   Mdvx::COMPRESSION_LZ4 - see <toolsa/compress.h>
   //
   // Scaling types apply only to conversions to int types (INT8 and INT16)
   //
@@ -963,6 +966,9 @@ protected:
   // compression
 
   int _compressGzipVol() const;
+  static Mdvx::compression_type_t
+    _planeCompressionType(int compression_type,
+                          ta_compression_method_t &ta_method);
   int _decompressGzipVol() const;
   int _decompress64() const;
 
@@ -991,6 +997,16 @@ protected:
 		   double vsection_min_lon,
 		   double vsection_max_lon);
 
+  int _read_volume_pread(int fd,
+                         const Mdvx &mdvx,
+                         bool fill_missing,
+                         bool do_decimate,
+                         bool do_final_convert,
+                         MdvxRemapLut &remapLut,
+                         bool is_vsection,
+                         double vsection_min_lon,
+                         double vsection_max_lon);
+
   int _apply_read_constraints(const Mdvx &mdvx,
                               bool fill_missing,
                               bool do_decimate,
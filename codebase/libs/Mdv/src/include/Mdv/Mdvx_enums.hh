@@ -245,6 +245,10 @@ typedef enum {
 // buffer per plane. GZIP_VOL compressed the entire volume in a single
 // compressed buffer. This is especially suitable for vertical sections
 // and time-height data.
+//
+// For writing, per-plane compression uses GZIP, ZSTD or LZ4 - the
+// other types are deprecated and written as GZIP. ZSTD and LZ4 are only
+// used if toolsa was built with them, otherwise GZIP is used.
 
 typedef enum {
 
@@ -260,7 +264,9 @@ typedef enum {
   // Gzip compression using a single buffer for the volume
   // instead of one compressed buffer per plane
   COMPRESSION_GZIP_VOL =  6,
-  COMPRESSION_TYPES_N = 7
+  COMPRESSION_ZSTD =  7,  // Zstandard - fast, gzip-like ratios
+  COMPRESSION_LZ4 =  8,   // LZ4 - fastest, lower ratios
+  COMPRESSION_TYPES_N = 9
   
 } compression_type_t;
 
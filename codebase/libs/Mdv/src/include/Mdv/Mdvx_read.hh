@@ -410,6 +410,19 @@ void clearReadAsSingleBuffer();
 
 void setRead32BitHeaders(bool val) { _read32BitHeaders = val; }
 
+// set the number of threads used to read the fields from an MDV file
+//
+// If n_threads > 1, the fields are read using positional reads, and
+// decompressed, converted and remapped concurrently, one field per
+// thread at a time. Useful for files with many compressed fields,
+// such as model output.
+//
+// Applies to local reads only - a server uses its own setting.
+// This is not reset by clearRead(). Default is 1, i.e. single threaded.
+
+void setReadNThreads(int n_threads);
+int getReadNThreads() const { return _readNThreads; }
+
 // deprecated
 
 void setReadAsSinglePart();
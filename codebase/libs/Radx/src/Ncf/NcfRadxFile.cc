@@ -307,6 +307,12 @@ void NcfRadxFile::clear()
   _nGatesVary = false;
   _nPoints = 0;
 
+  _readRayStart = 0;
+  _readNRays = 0;
+  _readNGates = 0;
+  _readPointStart = 0;
+  _readNPoints = 0;
+
 }
 
 void NcfRadxFile::_clearRays()
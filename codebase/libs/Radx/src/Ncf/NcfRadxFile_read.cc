@@ -131,6 +131,119 @@ int NcfRadxFile::readFromPath(const string &path,
 
 }
 
+////////////////////////////////////////////////////////////
+// Open file for reading one sweep at a time.
+//
+// This loads the list of sweeps to be read, honoring the
+// angle and sweep number limits. Each call to readNextSweep()
+// then reads just the rays for the next sweep in the list.
+//
+// Returns 0 on success, -1 on failure
+//
+// Use getErrStr() if error occurs
+
+int NcfRadxFile::openSweepRead(const string &path)
+  
+{
+
+  closeSweepRead();
+  clear();
+  _pathInUse = path;
+  _readPaths.clear();
+
+  vector<string> paths;
+  if (_readAggregateSweeps) {
+    _getVolumePaths(path, paths);
+  } else {
+    paths.push_back(path);
+  }
+
+  // limits are applied strictly, since we only
+  // see one sweep at a time
+
+  bool readStrictAngleLimits = _readStrictAngleLimits;
+  _readStrictAngleLimits = true;
+  int iret = _loadSweepInfo(paths);
+  _readStrictAngleLimits = readStrictAngleLimits;
+  if (iret) {
+    _addErrStr("ERROR - NcfRadxFile::openSweepRead");
+    _addErrStr("  Loading sweep info");
+    return -1;
+  }
+
+  _sweepReadList = _sweepsToRead;
+  _sweepReadPath = path;
+  _sweepReadIndex = 0;
+  _sweepReadOpen = true;
+
+  return 0;
+
+}
+
+////////////////////////////////////////////////////////////
+// Read next sweep into volume.
+// gotSweep is false when there are no more sweeps.
+//
+// Returns 0 on success, -1 on failure
+//
+// Use getErrStr() if error occurs
+
+int NcfRadxFile::readNextSweep(RadxVol &vol, bool &gotSweep)
+  
+{
+
+  gotSweep = false;
+
+  if (!_sweepReadOpen) {
+    clearErrStr();
+    _addErrStr("ERROR - NcfRadxFile::readNextSweep");
+    _addErrStr("  File not open for sweep reads");
+    return -1;
+  }
+
+  if (_sweepReadIndex >= _sweepReadList.size()) {
+    return 0;
+  }
+  SweepInfo sweepInfo = _sweepReadList[_sweepReadIndex];
+  _sweepReadIndex++;
+
+  // read just this sweep
+
+  _initForRead(sweepInfo.path, vol);
+  _sweepsToRead.push_back(sweepInfo);
+
+  if (_readPath(sweepInfo.path, 0)) {
+    _addErrStr("ERROR - NcfRadxFile::readNextSweep");
+    _addErrInt("  Sweep num: ", sweepInfo.sweepNum);
+    return -1;
+  }
+
+  _loadReadVolume();
+
+  if (_readIgnoreTransitions) {
+    _readVol->removeTransitionRays(_readTransitionNraysMargin);
+  }
+  if (!_fixedAnglesFound) {
+    _computeFixedAngles();
+  }
+
+  _fileFormat = FILE_FORMAT_CFRADIAL;
+  gotSweep = true;
+
+  return 0;
+
+}
+
+////////////////////////////////////////////////////////////
+// Close sweep reads
+
+void NcfRadxFile::closeSweepRead()
+  
+{
+  _sweepReadList.clear();
+  RadxFile::closeSweepRead();
+}
+
 ////////////////////////////////////////////////////////////
 // Read in data from specified path, load up volume object.
 // Returns 0 on success, -1 on failure
@@ -311,6 +424,10 @@ int NcfRadxFile::_readPath(const string &path, size_t pathNum)
       return -1;
     }
     
+    // compute the subset of the field data needed for these rays
+
+    _computeReadHyperslab();
+    
     // add field variables to file rays
     
     if (_readNormalFields(false)) {
@@ -2286,6 +2403,136 @@ int NcfRadxFile::_readRayNgatesAndOffsets()
 
 }
 
+/////////////////////////////////////////////////////////////
+// Compute the hyperslab of the field data to be read.
+//
+// The rays to be read are normally a contiguous block within
+// the file - for example a single sweep - so we only read the
+// data from the first to the last of those rays. If the max
+// range is set, the gates beyond that range are also skipped.
+// This way the I/O and decompression scale with the data
+// requested rather than with the file size.
+
+void NcfRadxFile::_computeReadHyperslab()
+
+{
+
+  _readRayStart = 0;
+  _readNRays = 0;
+  _readNGates = _nRangeInFile;
+  _readPointStart = 0;
+  _readNPoints = 0;
+
+  if (_raysToRead.size() == 0) {
+    return;
+  }
+
+  // ray limits
+
+  size_t minRayIndex = _nTimesInFile;
+  size_t maxRayIndex = 0;
+  for (size_t ii = 0; ii < _raysToRead.size(); ii++) {
+    size_t rayIndex = _raysToRead[ii].indexInFile;
+    if (rayIndex > _nTimesInFile - 1) {
+      // will be skipped
+      continue;
+    }
+    minRayIndex = min(minRayIndex, rayIndex);
+    maxRayIndex = max(maxRayIndex, rayIndex);
+  }
+  if (minRayIndex > maxRayIndex) {
+    return;
+  }
+  _readRayStart = minRayIndex;
+  _readNRays = maxRayIndex - minRayIndex + 1;
+
+  // variable number of gates - the points for the rays
+  // are stored in ray order, so read from the start of the
+  // first ray to the end of the last ray
+
+  if (_nGatesVary) {
+    size_t minPoint = (size_t) _nPoints;
+    size_t maxPoint = 0;
+    for (size_t ii = _readRayStart; ii <= maxRayIndex; ii++) {
+      size_t startPoint = _rayStartIndex[ii];
+      size_t endPoint = startPoint + _rayNGates[ii];
+      minPoint = min(minPoint, startPoint);
+      maxPoint = max(maxPoint, endPoint);
+    }
+    if (maxPoint > (size_t) _nPoints) {
+      maxPoint = _nPoints;
+    }
+    if (minPoint < maxPoint) {
+      _readPointStart = minPoint;
+      _readNPoints = maxPoint - minPoint;
+    }
+    return;
+  }
+
+  // constant number of gates - limit the gates to max range
+  // this matches the trimming in RadxRay::setMaxRangeKm()
+
+  if (_readSetMaxRange) {
+    int nGatesNeeded = 1;
+    for (size_t ii = 0; ii < _raysToRead.size(); ii++) {
+      size_t rayIndex = _raysToRead[ii].indexInFile;
+      if (rayIndex > _nTimesInFile - 1) {
+        continue;
+      }
+      double startRangeKm = _rayStartRange[rayIndex] / 1000.0;
+      double gateSpacingKm = _rayGateSpacing[rayIndex] / 1000.0;
+      if (gateSpacingKm <= 0) {
+        nGatesNeeded = _nRangeInFile;
+        break;
+      }
+      int nGates =
+        (int) ((_readMaxRangeKm - startRangeKm) / gateSpacingKm + 0.5);
+      nGatesNeeded = max(nGatesNeeded, nGates);
+    }
+    if (nGatesNeeded < (int) _nRangeInFile) {
+      _readNGates = nGatesNeeded;
+    }
+  }
+
+}
+
+/////////////////////////////////////////////////////////////
+// Set the start corner of the hyperslab on the variable,
+// and compute the counts along each dimension.
+// Returns the number of data values to be read.
+// Call var->set_cur() after the read, to reset the corner.
+
+size_t NcfRadxFile::_setReadHyperslab(Nc3Var *var,
+                                      bool isQualifier,
+                                      long &count0,
+                                      long &count1)
+
+{
+
+  if (isQualifier) {
+    // (time)
+    var->set_cur(_readRayStart);
+    count0 = _readNRays;
+    count1 = 0;
+    return _readNRays;
+  }
+
+  if (_nGatesVary) {
+    // (n_points)
+    var->set_cur(_readPointStart);
+    count0 = _readNPoints;
+    count1 = 0;
+    return _readNPoints;
+  }
+  
+  // (time, range)
+  var->set_cur(_readRayStart, 0);
+  count0 = _readNRays;
+  count1 = _readNGates;
+  return _readNRays * _readNGates;
+
+}
+
 ///////////////////////////////////
 // read the calibration variables
 
@@ -3835,19 +4082,11 @@ int NcfRadxFile::_addFl64FieldToRays(Nc3Var* var,
 
   // get data from array
 
-  size_t nData = _nPoints;
-  if (isQualifier) {
-    nData = _nTimesInFile;
-  }
+  long count0 = 0, count1 = 0;
+  size_t nData = _setReadHyperslab(var, isQualifier, count0, count1);
   Radx::fl64 *data = new Radx::fl64[nData];
-  int iret = 0;
-  if (isQualifier) {
-    iret = !var->get(data, _nTimesInFile);
-  } else if (_nGatesVary) {
-    iret = !var->get(data, _nPoints);
-  } else {
-    iret = !var->get(data, _nTimesInFile, _nRangeInFile);
-  }
+  int iret = !var->get(data, count0, count1);
+  var->set_cur();
   if (iret) {
     delete[] data;
     return -1;
@@ -3907,14 +4146,14 @@ int NcfRadxFile::_addFl64FieldToRays(Nc3Var* var,
     if (isQualifier) {
       field = _raysFromFile[ii]->addField(name, units, 1,
                                           missingVal,
-                                          data + rayIndex,
+                                          data + (rayIndex - _readRayStart),
                                           true, true);
     } else {
-      int nGates = _nRangeInFile;
-      int startIndex = rayIndex * _nRangeInFile;
+      int nGates = _readNGates;
+      int startIndex = (rayIndex - _readRayStart) * _readNGates;
       if (_nGatesVary) {
         nGates = _rayNGates[rayIndex];
-        startIndex = _rayStartIndex[rayIndex];
+        startIndex = _rayStartIndex[rayIndex] - _readPointStart;
       }
       field = _raysFromFile[ii]->addField(name, units, nGates,
                                           missingVal,
@@ -3947,19 +4186,11 @@ int NcfRadxFile::_addFl32FieldToRays(Nc3Var* var,
  
   // get data from array
 
-  size_t nData = _nPoints;
-  if (isQualifier) {
-    nData = _nTimesInFile;
-  }
+  long count0 = 0, count1 = 0;
+  size_t nData = _setReadHyperslab(var, isQualifier, count0, count1);
   Radx::fl32 *data = new Radx::fl32[nData];
-  int iret = 0;
-  if (isQualifier) {
-    iret = !var->get(data, _nTimesInFile);
-  } else if (_nGatesVary) {
-    iret = !var->get(data, _nPoints);
-  } else {
-    iret = !var->get(data, _nTimesInFile, _nRangeInFile);
-  }
+  int iret = !var->get(data, count0, count1);
+  var->set_cur();
   if (iret) {
     delete[] data;
     return -1;
@@ -4019,14 +4250,14 @@ int NcfRadxFile::_addFl32FieldToRays(Nc3Var* var,
     if (isQualifier) {
       field = _raysFromFile[ii]->addField(name, units, 1,
                                           missingVal,
-                                          data + rayIndex,
+                                          data + (rayIndex - _readRayStart),
                                           true, true);
     } else {
-      int nGates = _nRangeInFile;
-      int startIndex = rayIndex * _nRangeInFile;
+      int nGates = _readNGates;
+      int startIndex = (rayIndex - _readRayStart) * _readNGates;
       if (_nGatesVary) {
         nGates = _rayNGates[rayIndex];
-        startIndex = _rayStartIndex[rayIndex];
+        startIndex = _rayStartIndex[rayIndex] - _readPointStart;
       }
       field = _raysFromFile[ii]->addField(name, units, nGates,
                                           missingVal,
@@ -4059,19 +4290,11 @@ int NcfRadxFile::_addSi32FieldToRays(Nc3Var* var,
 
   // get data from array
 
-  size_t nData = _nPoints;
-  if (isQualifier) {
-    nData = _nTimesInFile;
-  }
+  long count0 = 0, count1 = 0;
+  size_t nData = _setReadHyperslab(var, isQualifier, count0, count1);
   Radx::si32 *data = new Radx::si32[nData];
-  int iret = 0;
-  if (isQualifier) {
-    iret = !var->get(data, _nTimesInFile);
-  } else if (_nGatesVary) {
-    iret = !var->get(data, _nPoints);
-  } else {
-    iret = !var->get(data, _nTimesInFile, _nRangeInFile);
-  }
+  int iret = !var->get(data, count0, count1);
+  var->set_cur();
   if (iret) {
     delete[] data;
     return -1;
@@ -4111,15 +4334,15 @@ int NcfRadxFile::_addSi32FieldToRays(Nc3Var* var,
     if (isQualifier) {
       field = _raysFromFile[ii]->addField(name, units, 1,
                                           missingVal,
-                                          data + rayIndex,
+                                          data + (rayIndex - _readRayStart),
                                           scale, offset,
                                           true, true);
     } else {
-      int nGates = _nRangeInFile;
-      int startIndex = rayIndex * _nRangeInFile;
+      int nGates = _readNGates;
+      int startIndex = (rayIndex - _readRayStart) * _readNGates;
       if (_nGatesVary) {
         nGates = _rayNGates[rayIndex];
-        startIndex = _rayStartIndex[rayIndex];
+        startIndex = _rayStartIndex[rayIndex] - _readPointStart;
       }
       field = _raysFromFile[ii]->addField(name, units, nGates,
                                           missingVal,
@@ -4154,19 +4377,11 @@ int NcfRadxFile::_addSi16FieldToRays(Nc3Var* var,
 
   // get data from array
 
-  size_t nData = _nPoints;
-  if (isQualifier) {
-    nData = _nTimesInFile;
-  }
+  long count0 = 0, count1 = 0;
+  size_t nData = _setReadHyperslab(var, isQualifier, count0, count1);
   Radx::si16 *data = new Radx::si16[nData];
-  int iret = 0;
-  if (isQualifier) {
-    iret = !var->get(data, _nTimesInFile);
-  } else if (_nGatesVary) {
-    iret = !var->get(data, _nPoints);
-  } else {
-    iret = !var->get(data, _nTimesInFile, _nRangeInFile);
-  }
+  int iret = !var->get(data, count0, count1);
+  var->set_cur();
   if (iret) {
     delete[] data;
     return -1;
@@ -4206,15 +4421,15 @@ int NcfRadxFile::_addSi16FieldToRays(Nc3Var* var,
     if (isQualifier) {
       field = _raysFromFile[ii]->addField(name, units, 1,
                                           missingVal,
-                                          data + rayIndex,
+                                          data + (rayIndex - _readRayStart),
                                           scale, offset,
                                           true, true);
     } else {
-      int nGates = _nRangeInFile;
-      int startIndex = rayIndex * _nRangeInFile;
+      int nGates = _readNGates;
+      int startIndex = (rayIndex - _readRayStart) * _readNGates;
       if (_nGatesVary) {
         nGates = _rayNGates[rayIndex];
-        startIndex = _rayStartIndex[rayIndex];
+        startIndex = _rayStartIndex[rayIndex] - _readPointStart;
       }
       field = _raysFromFile[ii]->addField(name, units, nGates,
                                           missingVal,
@@ -4250,19 +4465,11 @@ int NcfRadxFile::_addUi16FieldToRays(Nc3Var* var,
 
   // get data from array
 
-  size_t nData = _nPoints;
-  if (isQualifier) {
-    nData = _nTimesInFile;
-  }
+  long count0 = 0, count1 = 0;
+  size_t nData = _setReadHyperslab(var, isQualifier, count0, count1);
   Radx::ui16 *udata = new Radx::ui16[nData];
-  int iret = 0;
-  if (isQualifier) {
-    iret = !var->get(udata, _nTimesInFile);
-  } else if (_nGatesVary) {
-    iret = !var->get(udata, _nPoints);
-  } else {
-    iret = !var->get(udata, _nTimesInFile, _nRangeInFile);
-  }
+  int iret = !var->get(udata, count0, count1);
+  var->set_cur();
   if (iret) {
     delete[] udata;
     return -1;
@@ -4316,14 +4523,14 @@ int NcfRadxFile::_addUi16FieldToRays(Nc3Var* var,
     if (isQualifier) {
       field = _raysFromFile[ii]->addField(name, units, 1,
                                           missingVal,
-                                          fdata + rayIndex,
+                                          fdata + (rayIndex - _readRayStart),
                                           true, true);
     } else {
-      int nGates = _nRangeInFile;
-      int startIndex = rayIndex * _nRangeInFile;
+      int nGates = _readNGates;
+      int startIndex = (rayIndex - _readRayStart) * _readNGates;
       if (_nGatesVary) {
         nGates = _rayNGates[rayIndex];
-        startIndex = _rayStartIndex[rayIndex];
+        startIndex = _rayStartIndex[rayIndex] - _readPointStart;
       }
       field = _raysFromFile[ii]->addField(name, units, nGates,
                                           missingVal,
@@ -4356,19 +4563,11 @@ int NcfRadxFile::_addSi08FieldToRays(Nc3Var* var,
 
   // get data from array
 
-  size_t nData = _nPoints;
-  if (isQualifier) {
-    nData = _nTimesInFile;
-  }
+  long count0 = 0, count1 = 0;
+  size_t nData = _setReadHyperslab(var, isQualifier, count0, count1);
   Radx::si08 *data = new Radx::si08[nData];
-  int iret = 0;
-  if (isQualifier) {
-    iret = !var->get((ncbyte *) data, _nTimesInFile);
-  } else if (_nGatesVary) {
-    iret = !var->get((ncbyte *) data, _nPoints);
-  } else {
-    iret = !var->get((ncbyte *) data, _nTimesInFile, _nRangeInFile);
-  }
+  int iret = !var->get((ncbyte *) data, count0, count1);
+  var->set_cur();
   if (iret) {
     delete[] data;
     return -1;
@@ -4408,15 +4607,15 @@ int NcfRadxFile::_addSi08FieldToRays(Nc3Var* var,
     if (isQualifier) {
       field = _raysFromFile[ii]->addField(name, units, 1,
                                           missingVal,
-                                          data + rayIndex,
+                                          data + (rayIndex - _readRayStart),
                                           scale, offset,
                                           true, true);
     } else {
-      int nGates = _nRangeInFile;
-      int startIndex = rayIndex * _nRangeInFile;
+      int nGates = _readNGates;
+      int startIndex = (rayIndex - _readRayStart) * _readNGates;
       if (_nGatesVary) {
         nGates = _rayNGates[rayIndex];
-        startIndex = _rayStartIndex[rayIndex];
+        startIndex = _rayStartIndex[rayIndex] - _readPointStart;
       }
       field = _raysFromFile[ii]->addField(name, units, nGates,
                                           missingVal,
@@ -3875,7 +3875,21 @@ int NcfRadxFile::_setCompression(Nc3Var *var)
 
   int fileId = _file.getNc3File()->id();
   int varId = var->id();
+
+  // shuffle improves compression of integer-packed data
+
   int shuffle = 0;
+  if (_writeShuffle) {
+    Nc3Type vtype = var->type();
+    if (vtype == nc3Int || vtype == nc3Short ||
+        vtype == nc3Ushort || vtype == nc3Byte) {
+      shuffle = 1;
+    }
+  }
+
+  // set the chunk shape
+
+  _setChunking(var);
   
   if (nc_def_var_deflate(fileId, varId, shuffle,
                          _writeCompressed, _compressionLevel)!= NC_NOERR) {
@@ -3888,6 +3902,103 @@ int NcfRadxFile::_setCompression(Nc3Var *var)
 
 }
 
+///////////////////////////////////////////////////////////////////////////
+// Set chunk shape for field variable.
+//
+// The chunks span all gates, and a number of rays set by the
+// chunking mode, so that a sweep can be read by decompressing
+// only the chunks which hold its rays.
+
+void NcfRadxFile::_setChunking(Nc3Var *var)  
+{
+
+  if (_writeChunkingMode == CHUNKING_DEFAULT) {
+    return;
+  }
+
+  size_t nRays = _writeVol->getNRays();
+  if (nRays < 1) {
+    return;
+  }
+
+  // number of rays per chunk
+  
+  size_t chunkNRays = 1;
+  if (_writeChunkingMode == CHUNKING_SWEEP) {
+    const vector<RadxSweep *> &sweeps = _writeVol->getSweeps();
+    for (size_t ii = 0; ii < sweeps.size(); ii++) {
+      chunkNRays = max(chunkNRays, sweeps[ii]->getNRays());
+    }
+    if (sweeps.size() == 0) {
+      chunkNRays = nRays;
+    }
+  } else if (_writeChunkNRays > 0) {
+    chunkNRays = _writeChunkNRays;
+  }
+  if (chunkNRays > nRays) {
+    chunkNRays = nRays;
+  }
+
+  // limit the chunk size
+
+  size_t typeSize = 4;
+  switch (var->type()) {
+    case nc3Double:
+      typeSize = 8;
+      break;
+    case nc3Short:
+    case nc3Ushort:
+      typeSize = 2;
+      break;
+    case nc3Byte:
+      typeSize = 1;
+      break;
+    default:
+      typeSize = 4;
+  }
+  
+  size_t nGatesPerRay = 1;
+  if (var->num_dims() == 2) {
+    // (time, range)
+    nGatesPerRay = var->get_dim(1)->size();
+  } else if (var->get_dim(0) != _timeDim) {
+    // (n_points) - use the mean number of gates
+    nGatesPerRay = var->get_dim(0)->size() / nRays;
+  }
+  if (nGatesPerRay < 1) {
+    nGatesPerRay = 1;
+  }
+  size_t maxChunkNRays = _maxChunkBytes / (nGatesPerRay * typeSize);
+  if (maxChunkNRays < 1) {
+    maxChunkNRays = 1;
+  }
+  if (chunkNRays > maxChunkNRays) {
+    chunkNRays = maxChunkNRays;
+  }
+
+  // set the chunk shape
+
+  size_t chunks[2];
+  if (var->num_dims() == 2) {
+    chunks[0] = chunkNRays;
+    chunks[1] = nGatesPerRay;
+  } else if (var->get_dim(0) == _timeDim) {
+    chunks[0] = chunkNRays;
+  } else {
+    size_t nPoints = var->get_dim(0)->size();
+    chunks[0] = min(nPoints, chunkNRays * nGatesPerRay);
+  }
+  
+  int fileId = _file.getNc3File()->id();
+  int varId = var->id();
+  if (nc_def_var_chunking(fileId, varId, NC_CHUNKED, chunks) != NC_NOERR) {
+    cerr << "WARNING NcfRadxFile::_setChunking" << endl;
+    cerr << "  Cannot set chunking for field: " << var->name() << endl;
+    cerr << "  Default chunking will be used instead" << endl;
+  }
+
+}
+
 ///////////////////////////////////////////////////////////////////////////
 // Compute the output path
 
@@ -62,6 +62,7 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <arpa/inet.h>
+#include <pthread.h>
 using namespace std;
 
 const double NexradRadxFile::_prtTable[5][8] =
@@ -99,6 +100,13 @@ NexradRadxFile::NexradRadxFile() :
   _readVol = NULL;
   _file = NULL;
   _isBzipped = false;
+  _sweepReadNextRay = NULL;
+  _sweepReadEof = false;
+  _nUnzipThreads = 1;
+  long nProc = sysconf(_SC_NPROCESSORS_ONLN);
+  if (nProc > 1) {
+    _nUnzipThreads = (nProc > 8 ? 8 : (int) nProc);
+  }
   clear();
 
 }
@@ -109,9 +117,18 @@ NexradRadxFile::NexradRadxFile() :
 NexradRadxFile::~NexradRadxFile()
 
 {
+  closeSweepRead();
   clear();
 }
 
+/////////////////////////////////////////////////////////
+// set the number of threads for uncompressing LDM files
+
+void NexradRadxFile::setNUnzipThreads(int n)
+{
+  _nUnzipThreads = (n < 1 ? 1 : n);
+}
+
 /////////////////////////////////////////////////////////
 // clear the data in the object
 
@@ -173,6 +190,7 @@ void NexradRadxFile::clear()
   _gateSpacingKmShort = 0.25;
 
   _msgSeqNum = 0;
+  _origFormat = "NEXRAD";
 
   memset(&_adap, 0, sizeof(_adap));
   memset(&_vcp, 0, sizeof(_vcp));
@@ -463,20 +481,269 @@ int NexradRadxFile::readFromPath(const string &path,
 
   // volume title
 
+  if (_readTitle()) {
+    _addErrStr("ERROR - NexradRadxFile::readFromPath");
+    _close();
+    return -1;
+  }
+  vol.setOrigFormat(_origFormat);
+
+  // read in the rays
+
+  while (true) {
+    RadxRay *ray = NULL;
+    if (_readNextRay(ray)) {
+      _addErrStr("ERROR - NexradRadxFile::readFromPath");
+      _close();
+      return -1;
+    }
+    if (ray == NULL) {
+      // done
+      break;
+    }
+    if (_acceptRay(ray)) {
+      _readVol->addRay(ray);
+    }
+  }
+
+  // close file
+
+  _close();
+  
+  if (_debug) {
+    cerr << "VCP num: " << _vcpNum << endl;
+  }
+
+  // process the rays
+
+  if (_processReadVolume()) {
+    _addErrStr("ERROR - NexradRadxFile::readFromPath");
+    return -1;
+  }
+
+  // add to paths used on read
+
+  _readPaths.push_back(path);
+
+  // set the packing from the rays
+
+  _readVol->setPackingFromRays();
+  
+  // set format as read
+
+  _fileFormat = FILE_FORMAT_NEXRAD_AR2;
+  
+  if (_verbose) {
+    _readVol->print(cerr);
+  }
+  
+  return 0;
+
+}
+
+////////////////////////////////////////////////////////////
+// Open file for reading one sweep at a time.
+//
+// The rays are read in file order, so only one sweep
+// is held in memory at a time.
+//
+// Returns 0 on success, -1 on failure
+//
+// Use getErrStr() if error occurs
+
+int NexradRadxFile::openSweepRead(const string &path)
+  
+{
+
+  closeSweepRead();
+  clear();
+  _pathInUse = path;
+  _readPaths.clear();
+
+  // open file
+
+  if (_openRead(_pathInUse)) {
+    _addErrStr("ERROR - NexradRadxFile::openSweepRead");
+    return -1;
+  }
+
+  // volume title
+
+  if (_readTitle()) {
+    _addErrStr("ERROR - NexradRadxFile::openSweepRead");
+    _close();
+    return -1;
+  }
+
+  _sweepReadPath = path;
+  _sweepReadIndex = 0;
+  _sweepReadOpen = true;
+  _sweepReadEof = false;
+
+  return 0;
+
+}
+
+////////////////////////////////////////////////////////////
+// Read next sweep into volume.
+// gotSweep is false when there are no more sweeps.
+//
+// Unless _readPreserveSweeps is set, adjacent sweeps with the
+// same fixed angle - the NEXRAD split cuts - are read together
+// and combined, as for readFromPath().
+//
+// Sweeps outside the fixed angle or sweep number limits
+// are skipped.
+//
+// Returns 0 on success, -1 on failure
+//
+// Use getErrStr() if error occurs
+
+int NexradRadxFile::readNextSweep(RadxVol &vol, bool &gotSweep)
+  
+{
+
+  gotSweep = false;
+  clearErrStr();
+
+  if (!_sweepReadOpen) {
+    _addErrStr("ERROR - NexradRadxFile::readNextSweep");
+    _addErrStr("  File not open for sweep reads");
+    return -1;
+  }
+
+  while (!_sweepReadEof || _sweepReadNextRay != NULL) {
+
+    // gather the rays for the next sweep, reading ahead
+    // one ray to find the end of the sweep
+
+    vector<RadxRay *> rays;
+    if (_sweepReadNextRay != NULL) {
+      rays.push_back(_sweepReadNextRay);
+      _sweepReadNextRay = NULL;
+    }
+
+    while (!_sweepReadEof) {
+      RadxRay *ray = NULL;
+      if (_readNextRay(ray)) {
+        _addErrStr("ERROR - NexradRadxFile::readNextSweep");
+        for (size_t ii = 0; ii < rays.size(); ii++) {
+          delete rays[ii];
+        }
+        return -1;
+      }
+      if (ray == NULL) {
+        _sweepReadEof = true;
+        _close();
+        break;
+      }
+      if (!_acceptRay(ray)) {
+        continue;
+      }
+      if (rays.size() > 0) {
+        const RadxRay *prev = rays[rays.size() - 1];
+        bool sameSweep =
+          (ray->getSweepNumber() == prev->getSweepNumber());
+        if (!sameSweep && !_readPreserveSweeps) {
+          // split cut?
+          sameSweep = (fabs(ray->getFixedAngleDeg() -
+                            prev->getFixedAngleDeg()) < 0.1);
+        }
+        if (!sameSweep) {
+          // save for next call
+          _sweepReadNextRay = ray;
+          break;
+        }
+      }
+      rays.push_back(ray);
+    } // while
+
+    if (rays.size() == 0) {
+      break;
+    }
+
+    // load up the volume
+
+    _readVol = &vol;
+    vol.clear();
+    vol.setPathInUse(_sweepReadPath);
+    vol.setOrigFormat(_origFormat);
+    _startTimeSecs = rays[0]->getTimeSecs();
+    _startNanoSecs = rays[0]->getNanoSecs();
+    _endTimeSecs = rays[rays.size() - 1]->getTimeSecs();
+    _endNanoSecs = rays[rays.size() - 1]->getNanoSecs();
+    for (size_t ii = 0; ii < rays.size(); ii++) {
+      vol.addRay(rays[ii]);
+    }
+
+    // process the sweep - angle limits are applied strictly,
+    // since we only see one sweep at a time
+    
+    bool readStrictAngleLimits = _readStrictAngleLimits;
+    _readStrictAngleLimits = true;
+    int iret = _processReadVolume();
+    _readStrictAngleLimits = readStrictAngleLimits;
+    if (iret) {
+      // no data, or outside limits - try next sweep
+      if (_verbose) {
+        cerr << "NexradRadxFile::readNextSweep - skipping sweep" << endl;
+        cerr << _errStr;
+      }
+      clearErrStr();
+      vol.clear();
+      continue;
+    }
+
+    _readPaths.clear();
+    _readPaths.push_back(_sweepReadPath);
+    vol.setPackingFromRays();
+    _fileFormat = FILE_FORMAT_NEXRAD_AR2;
+    _sweepReadIndex++;
+    gotSweep = true;
+    return 0;
+    
+  } // while
+
+  return 0;
+
+}
+
+////////////////////////////////////////////////////////////
+// Close sweep reads
+
+void NexradRadxFile::closeSweepRead()
+  
+{
+  if (_sweepReadNextRay != NULL) {
+    delete _sweepReadNextRay;
+    _sweepReadNextRay = NULL;
+  }
+  _sweepReadEof = false;
+  _close();
+  RadxFile::closeSweepRead();
+}
+
+////////////////////////////////////////////////////////////
+// Read in the volume title from the open file.
+// Sets the volume number, site and orig format.
+// Returns 0 on success, -1 on failure
+
+int NexradRadxFile::_readTitle()
+  
+{
+
   NexradData::vol_title_t title;
   if (fread(&title, sizeof(title), 1, _file) != 1) {
-    _addErrStr("ERROR - NexradRadxFile::readFromPath");
+    _addErrStr("ERROR - NexradRadxFile::_readTitle");
     _addErrStr("  Cannot read title block");
     _addErrStr("  Path: ", _pathInUse);
-    _close();
     return -1;
   }
   if (strncmp(title.filetype, "ARCHIVE2", 8) &&
       strncmp(title.filetype, "AR2V", 4)) {
-    _addErrStr("ERROR - NexradRadxFile::readFromPath");
+    _addErrStr("ERROR - NexradRadxFile::_readTitle");
     _addErrStr("  Not an ARCHIVE2 file");
     _addErrStr("  Path: ", _pathInUse);
-    _close();
     return -1;
   }
   NexradData::swap(title);
@@ -492,9 +759,9 @@ int NexradRadxFile::readFromPath(const string &path,
       _readFieldNames.size() == 0) {
     // no changes to file contents
     string origFormat = title.filetype;
-    vol.setOrigFormat(origFormat.substr(0, 8));
+    _origFormat = origFormat.substr(0, 8);
   } else {
-    vol.setOrigFormat("NEXRAD");
+    _origFormat = "NEXRAD";
   }
 
   // set volume number if possible
@@ -518,6 +785,22 @@ int NexradRadxFile::readFromPath(const string &path,
     _instrumentName = loc.getName();
   }
 
+  return 0;
+
+}
+
+////////////////////////////////////////////////////////////
+// Read messages from the open file until the next ray is
+// found. VCP and adaptation messages are handled on the way.
+// ray is set to NULL at end of file.
+// Returns 0 on success, -1 on failure
+
+int NexradRadxFile::_readNextRay(RadxRay* &ray)
+  
+{
+
+  ray = NULL;
+
   // loop looking for message headers
 
   RadxBuf buf;
@@ -526,10 +809,9 @@ int NexradRadxFile::readFromPath(const string &path,
   while (!feof(_file)) {
     
     if (_readMessage(msgHdr, buf, false, cerr)) {
-      _addErrStr("ERROR - NexradRadxFile::readFromPath");
+      _addErrStr("ERROR - NexradRadxFile::_readNextRay");
       _addErrStr("  Cannot read message");
       _addErrStr("  Path: ", _pathInUse);
-      _close();
       return -1;
     }
 
@@ -543,7 +825,7 @@ int NexradRadxFile::readFromPath(const string &path,
     }
 
     if (!NexradData::msgTypeIsValid(msgHdr.message_type)) {
-      cerr << "WARNING - NexradRadxFile::readFromPath" << endl;
+      cerr << "WARNING - NexradRadxFile::_readNextRay" << endl;
       cerr << "  Bad message type: " << (int) msgHdr.message_type << endl;
       cerr << "  Path: " << _pathInUse << endl;
     }
@@ -572,68 +854,20 @@ int NexradRadxFile::readFromPath(const string &path,
 
       // create ray from message
 
-      RadxRay *ray = _handleMessageType31(buf);
-
+      ray = _handleMessageType31(buf);
       if (ray != NULL) {
-
         _checkIsLongRange(ray);
-        
-        // add ray to vol, make sure sweep numbers are increasing
-        
-        if ((ray->getSweepNumber() >= _prevSweepNum) || _readPreserveSweeps) {
-          _readVol->addRay(ray);
-          _prevSweepNum = ray->getSweepNumber();
-          if (_verbose) {
-            cerr << "Adding msg 31 ray, sweepNum, el, az: "
-                 << ray->getSweepNumber() << ", "
-                 << ray->getElevationDeg() << ", "
-                 << ray->getAzimuthDeg() << endl;
-          }
-        } else {
-          if (_verbose) {
-            cerr << "ERROR - sweep number decreased, msg 31 ray, sweepNum, el, az: "
-                 << ray->getSweepNumber() << ", "
-                 << ray->getElevationDeg() << ", "
-                 << ray->getAzimuthDeg() << endl;
-          }
-        }
+        return 0;
       }
 
     } else if (msgHdr.message_type == NexradData::DIGITAL_RADAR_DATA_1) {
 
       // create ray from message
 
-      RadxRay *ray = _handleMessageType1(buf);
-
+      ray = _handleMessageType1(buf);
       if (ray != NULL) {
-
         _checkIsLongRange(ray);
-
-        // add ray to vol, make sure sweep numbers are increasing
-        
-        if ((ray->getSweepNumber() >= _prevSweepNum) || _readPreserveSweeps) {
-          _readVol->addRay(ray);
-          _prevSweepNum = ray->getSweepNumber();
-          if (_verbose) {
-            cerr << "Adding msg 31 ray, sweepNum, el, az: "
-                 << ray->getSweepNumber() << ", "
-                 << ray->getElevationDeg() << ", "
-                 << ray->getAzimuthDeg() << endl;
-          }
-        } else {
-          if (_verbose) {
-            cerr << "ERROR - sweep number decreased, msg 31 ray, sweepNum, el, az: "
-                 << ray->getSweepNumber() << ", "
-                 << ray->getElevationDeg() << ", "
-                 << ray->getAzimuthDeg() << endl;
-          }
-        }
-        
-        if (_verbose) {
-          cerr << "Adding msg 1 ray, el, az: "
-               << ray->getElevationDeg() << ", " << ray->getAzimuthDeg() << endl;
-        }
-        
+        return 0;
       }
 
     } else if (msgHdr.message_type == NexradData::VOLUME_COVERAGE_PATTERN) {
@@ -643,7 +877,7 @@ int NexradRadxFile::readFromPath(const string &path,
     } else if (msgHdr.message_type == NexradData::RDA_ADAPTATION_DATA) {
       
       if (_handleAdaptationData(buf)) {
-        cerr << "WARNING - NexradRadxFile::readFromPath" << endl;
+        cerr << "WARNING - NexradRadxFile::_readNextRay" << endl;
         cerr << "  Adaptation data probably not set, ignoring" << endl;
         cerr << "  File: " << _pathInUse << endl;
         // TODO - fix adaptation handling
@@ -653,14 +887,50 @@ int NexradRadxFile::readFromPath(const string &path,
 
   } // while
 
-  // close file
+  return 0;
 
-  _close();
+}
+
+////////////////////////////////////////////////////////////
+// Check that the sweep numbers are increasing, unless we are
+// preserving the sweeps. Rejected rays are deleted.
+// Returns true if the ray is accepted, false otherwise.
+
+bool NexradRadxFile::_acceptRay(RadxRay *ray)
   
-  if (_debug) {
-    cerr << "VCP num: " << _vcpNum << endl;
+{
+
+  if ((ray->getSweepNumber() >= _prevSweepNum) || _readPreserveSweeps) {
+    _prevSweepNum = ray->getSweepNumber();
+    if (_verbose) {
+      cerr << "Adding ray, sweepNum, el, az: "
+           << ray->getSweepNumber() << ", "
+           << ray->getElevationDeg() << ", "
+           << ray->getAzimuthDeg() << endl;
+    }
+    return true;
   }
 
+  if (_verbose) {
+    cerr << "ERROR - sweep number decreased, ray sweepNum, el, az: "
+         << ray->getSweepNumber() << ", "
+         << ray->getElevationDeg() << ", "
+         << ray->getAzimuthDeg() << endl;
+  }
+  delete ray;
+  return false;
+
+}
+
+////////////////////////////////////////////////////////////
+// Process the rays in the read volume - combine the split
+// cuts, reorder fields and finalize.
+// Returns 0 on success, -1 on failure
+
+int NexradRadxFile::_processReadVolume()
+  
+{
+
   // set sweep info
 
   _readVol->loadSweepInfoFromRays();
@@ -721,7 +991,7 @@ int NexradRadxFile::readFromPath(const string &path,
   // check we got some data
   
   if (_readVol->getRays().size() < 1) {
-    _addErrStr("ERROR - NexradRadxFile::readFromPath");
+    _addErrStr("ERROR - NexradRadxFile::_processReadVolume");
     _addErrStr("  No valid rays found");
     return -1;
   }
@@ -732,22 +1002,6 @@ int NexradRadxFile::readFromPath(const string &path,
     return -1;
   }
 
-  // add to paths used on read
-
-  _readPaths.push_back(path);
-
-  // set the packing from the rays
-
-  _readVol->setPackingFromRays();
-  
-  // set format as read
-
-  _fileFormat = FILE_FORMAT_NEXRAD_AR2;
-  
-  if (_verbose) {
-    _readVol->print(cerr);
-  }
-  
   return 0;
 
 }
@@ -1706,25 +1960,25 @@ int NexradRadxFile::_openRead(const string &path)
     return -1;
   }
 
-  _tmpPath.clear();
+  _uncompBuf.clear();
   if (_isBzipped) {
-    // need to unzip the file into a temporary file
-    // also sets _pathInUse to tmp path
+    // need to unzip the file into memory
+    // it is then read via _file, using fmemopen()
     if (_unzipFile(path)) {
       cerr << "WARNING - - NexradRadxFile::readFromPath" << endl;
       cerr << "  Cannot uncompress zipped file" << endl;
       cerr << "  Path: " << path << endl;
       cerr << "  Continuing and assuming not bzipped" << endl;
       clearErrStr();
+      _uncompBuf.clear();
     }
   }
   
-  string pathToOpen = path;
-  if (_tmpPath.size() > 0) {
-    pathToOpen = _tmpPath;
+  if (_uncompBuf.getLen() > 0) {
+    _file = fmemopen(_uncompBuf.getPtr(), _uncompBuf.getLen(), "r");
+  } else {
+    _file = fopen(path.c_str(), "r");
   }
-  
-  _file = fopen(pathToOpen.c_str(), "r");
   if (!_file) {
     int errNum = errno;
     _addErrStr("ERROR - NexradRadxFile::_openRead");
@@ -1775,12 +2029,9 @@ void NexradRadxFile::_close()
     _file = NULL;
   }
 
-  // delete tmp file if applicable
+  // free uncompressed buffer if applicable
   
-  if (_tmpPath.size() > 0) {
-    unlink(_tmpPath.c_str());
-    _tmpPath.clear();
-  }
+  _uncompBuf.clear();
 
 }
 
@@ -3643,7 +3894,82 @@ void NexradRadxFile::_setPrtIndexes(double prtSec)
 }
 
 ////////////////////////////////////////////////
-// unzip an LDM-based zipped file
+// LDM record, and the shared state for the
+// threads which unzip them - see _unzipFile
+
+typedef struct {
+  const char *inPtr;
+  unsigned int inLen;
+  RadxBuf *out;
+  int iret;
+} ldm_record_t;
+
+typedef struct {
+  vector<ldm_record_t> *records;
+  size_t nextRecord;
+  pthread_mutex_t mutex;
+} ldm_unzip_t;
+
+////////////////////////////////////////////////
+// unzip a single LDM record into its out buffer
+
+static void _unzipLdmRecord(ldm_record_t &rec)
+
+{
+
+  unsigned int outSize = rec.inLen * 40;
+  for (int itry = 0; itry < 10; itry++) {
+    char *outPtr = (char *) rec.out->reserve(outSize);
+    unsigned int outLen = outSize;
+    rec.iret = BZ2_bzBuffToBuffDecompress(outPtr, &outLen,
+                                          (char *) rec.inPtr, rec.inLen,
+                                          0, 0);
+    if (rec.iret == BZ_OK) {
+      rec.out->reserve(outLen);
+      return;
+    } else if (rec.iret == BZ_OUTBUFF_FULL) {
+      outSize *= 2;
+      continue;
+    } else {
+      return;
+    }
+  } // itry
+
+}
+
+////////////////////////////////////////////////
+// thread main for unzipping
+// each thread takes the next record until none are left
+
+static void *_unzipThreadMain(void *args)
+
+{
+
+  ldm_unzip_t *unzip = (ldm_unzip_t *) args;
+  vector<ldm_record_t> &records = *unzip->records;
+  
+  while (true) {
+    pthread_mutex_lock(&unzip->mutex);
+    size_t irec = unzip->nextRecord;
+    unzip->nextRecord++;
+    pthread_mutex_unlock(&unzip->mutex);
+    if (irec >= records.size()) {
+      break;
+    }
+    _unzipLdmRecord(records[irec]);
+  }
+
+  return NULL;
+
+}
+
+////////////////////////////////////////////////
+// unzip an LDM-based zipped file into _uncompBuf
+//
+// The file is read into memory and split into its
+// bzip2 records, which are unzipped concurrently
+// and then joined in order after the 24-byte header.
+//
 // returns 0 on success, -1 on failure
 
 int NexradRadxFile::_unzipFile(const string &path)
@@ -3654,11 +3980,20 @@ int NexradRadxFile::_unzipFile(const string &path)
     cerr << "Unzipping file: " << path << endl;
   }
 
-  // clean up any existing tmp files
+  _uncompBuf.clear();
 
-  _removeTmpFiles();
+  // read in compressed file
 
-  // open input file
+  struct stat fstat;
+  if (!RadxPath::doStat(path, fstat)) {
+    int errNum = errno;
+    _addErrStr("ERROR - NexradRadxFile::readFromPath");
+    _addErrStr("  Cannot stat zipped file");
+    _addErrStr("  Path: ", path);
+    _addErrStr("  ", strerror(errNum));
+    return -1;
+  }
+  size_t fileLen = fstat.st_size;
 
   FILE *in = fopen(path.c_str(), "r");
   if (in == NULL) {
@@ -3670,98 +4005,68 @@ int NexradRadxFile::_unzipFile(const string &path)
     return -1;
   }
   
-  // read in header
+  RadxBuf comp;
+  char *compPtr = (char *) comp.reserve(fileLen);
+  if (fread(compPtr, 1, fileLen, in) != fileLen) {
+    _addErrStr("ERROR - NexradRadxFile::readFromPath");
+    _addErrStr("  Cannot read zipped file");
+    _addErrStr("  Path: ", path);
+    fclose(in);
+    return -1;
+  }
+  fclose(in);
+
+  // check header
   
-  char header[24];
-  if (fread(header, 1, 24, in) != 24) {
+  if (fileLen < 24) {
     _addErrStr("ERROR - NexradRadxFile::readFromPath");
     _addErrStr("  Cannot read 24-byte header");
     _addErrStr("  Path: ", path);
-    fclose(in);
     return -1;
   }
 
-  if (strncmp(header, "ARCH", 4) &&
-      strncmp(header, "AR2V", 4)) {
+  if (strncmp(compPtr, "ARCH", 4) &&
+      strncmp(compPtr, "AR2V", 4)) {
     _addErrStr("ERROR - NexradRadxFile::readFromPath");
     _addErrStr("  Not a NEXRAD file");
     _addErrStr("  Path: ", path);
-    fclose(in);
     return -1;
   }
 
-  // store output in buffer for later writing to tmp file
-
-  RadxBuf uncomp;
-  uncomp.add(header, 24);
-
-  bool lastBlock = false;
-  while (!feof(in)) {
+  // split into records, each preceded by a 4-byte length
+  
+  vector<ldm_record_t> records;
+  size_t pos = 24;
+  while (pos + 4 <= fileLen) {
 
-    // read in sub-buffer length
-    
     int32_t length;
-    if (fread(&length, 4, 1, in) != 1) {
-      if (feof(in)) {
-        break;
-      }
-      _addErrStr("ERROR - NexradRadxFile::readFromPath");
-      _addErrStr("  Cannot unzip file");
-      _addErrStr("  Path: ", path);
-    }
+    memcpy(&length, compPtr + pos, 4);
     length = ntohl(length);
+    pos += 4;
 
+    bool lastBlock = false;
     if(length < 0) {
       // a negative length indicates this is the last block
       length = -length;
       lastBlock = true;
     }
 
-    // read in sub-buffer
-    
-    RadxArray<char> inBuf_;
-    char *inBuf = inBuf_.alloc(length);
-    if ((int) fread(inBuf, 1, length, in) != length) {
+    if (pos + length > fileLen) {
       _addErrStr("ERROR - NexradRadxFile::readFromPath");
-      _addErrStr("  Cannot read zipped file");
+      _addErrStr("  Zipped file is truncated");
       _addErrStr("  Path: ", path);
-      fclose(in);
       return -1;
     }
-    
-    if (length <= 10) {
-      continue;
-    }
 
-    // unzip
-
-    unsigned int outSize = length * 40;
-    RadxArray<char> outBuf_;
-    char *outBuf = outBuf_.alloc(outSize);
-    unsigned int outLen;
-    for (int itry = 0; itry < 10; itry++) {
-      outLen = outSize;
-      int iret = BZ2_bzBuffToBuffDecompress(outBuf, &outLen,
-                                            inBuf, length,
-                                            0, 0);
-      if (iret == BZ_OK) {
-        break;
-      } else if (iret == BZ_OUTBUFF_FULL) {
-        outSize *= 2;
-        outBuf = outBuf_.alloc(outSize);
-        continue;
-      } else {
-        _addErrStr("ERROR - NexradRadxFile::readFromPath");
-        _addErrStr("  Path: ", path);
-        _addErrInt("  BZIP unzip error: ", iret);
-        fclose(in);
-        return -1;
-      }
-    } // itry
-    
-    // add to uncomp buffer
-    
-    uncomp.add(outBuf, outLen);
+    if (length > 10) {
+      ldm_record_t rec;
+      rec.inPtr = compPtr + pos;
+      rec.inLen = length;
+      rec.out = NULL;
+      rec.iret = BZ_OK;
+      records.push_back(rec);
+    }
+    pos += length;
 
     if (lastBlock) {
       break;
@@ -3769,99 +4074,80 @@ int NexradRadxFile::_unzipFile(const string &path)
 
   } // while
 
-  // success
-
-  fclose(in);
-    
-  // compute temporary path
-  
-  RadxPath rpath(path);
-  string tmpPath("/tmp/");
-  char tmpName[128];
-  long long now = time(NULL);
-  long long pid = getpid();
-  safe_snprintf(tmpName, "NexradRadxFile.%s.%lld.%lld", rpath.getFile().c_str(), now, pid);
-  tmpPath += tmpName;
+  // unzip the records
 
-  // open output file
-  
-  FILE *out = fopen(tmpPath.c_str(), "w");
-  if (out == NULL) {
-    int errNum = errno;
-    _addErrStr("ERROR - NexradRadxFile::readFromPath");
-    _addErrStr("  Cannot open tmp file for unzipping");
-    _addErrStr("  Path: ", tmpPath);
-    _addErrStr("  ", strerror(errNum));
-    return -1;
+  vector<RadxBuf> outBufs(records.size());
+  for (size_t ii = 0; ii < records.size(); ii++) {
+    records[ii].out = &outBufs[ii];
   }
-
-  // write the uncomp buffer to the tmp file
   
-  if (fwrite(uncomp.getPtr(), uncomp.getLen(), 1, out) != 1) {
-    _addErrStr("ERROR - NexradRadxFile::readFromPath");
-    _addErrStr("  Cannot write uncompressed data to tmp file");
-    _addErrStr("  Path: ", tmpPath);
-    return -1;
+  int nThreads = _nUnzipThreads;
+  if (nThreads > (int) records.size()) {
+    nThreads = (int) records.size();
   }
-  
-  fclose(out);
-  _tmpPath = tmpPath;
-  return 0;
 
-}
-
-///////////////////////////////////////////////////////////
-// clean up any existing tmp files created by
-// unzipping - see _unzipFile
-//
-// this is only required if the app exits before the tmpe
-// file is removed
-//
-// only remove files older than 2 mins
+  if (nThreads <= 1) {
 
-void NexradRadxFile::_removeTmpFiles()
+    for (size_t ii = 0; ii < records.size(); ii++) {
+      _unzipLdmRecord(records[ii]);
+    }
 
-{
+  } else {
 
-  RadxReadDir rdir;
-  if (rdir.open("/tmp") == 0) {
-    
-    // Loop thru directory looking for the tmp files
-    
-    struct dirent *dp;
-    for (dp = rdir.read(); dp != NULL; dp = rdir.read()) {
-      
-      // only include files that start with NexradRadxFile
+    ldm_unzip_t unzip;
+    unzip.records = &records;
+    unzip.nextRecord = 0;
+    pthread_mutex_init(&unzip.mutex, NULL);
 
-      string name(dp->d_name);
-      if (name.find("NexradRadxFile") != 0) {
-        continue;
+    vector<pthread_t> threads;
+    for (int ii = 0; ii < nThreads; ii++) {
+      pthread_t thread;
+      if (pthread_create(&thread, NULL, _unzipThreadMain, &unzip) == 0) {
+        threads.push_back(thread);
       }
+    }
+    if (threads.size() == 0) {
+      // cannot start threads, so unzip in this thread
+      _unzipThreadMain(&unzip);
+    }
+    for (size_t ii = 0; ii < threads.size(); ii++) {
+      pthread_join(threads[ii], NULL);
+    }
 
-      // Get the file status so we can check the modify time
-      
-      struct stat fstat;
-      string path("/tmp/");
-      path += name;
-      if (!RadxPath::doStat(path.c_str(), fstat) == 0) {
+    pthread_mutex_destroy(&unzip.mutex);
 
-        // compute file age
+  }
 
-        time_t now = time(NULL);
-        double age = (double) now - fstat.st_mtime;
+  // check for errors, and compute the uncompressed length
 
-        // remove if older than 1 minute
+  size_t uncompLen = 24;
+  for (size_t ii = 0; ii < records.size(); ii++) {
+    if (records[ii].iret != BZ_OK) {
+      _addErrStr("ERROR - NexradRadxFile::readFromPath");
+      _addErrStr("  Path: ", path);
+      _addErrInt("  BZIP unzip error: ", records[ii].iret);
+      return -1;
+    }
+    uncompLen += outBufs[ii].getLen();
+  }
 
-        if (age > 120) {
-          unlink(path.c_str());
-        }
-            
-      }
+  // join the header and uncompressed records
 
-    } // dp
-    rdir.close();
+  char *uncompPtr = (char *) _uncompBuf.reserve(uncompLen);
+  memcpy(uncompPtr, compPtr, 24);
+  size_t offset = 24;
+  for (size_t ii = 0; ii < outBufs.size(); ii++) {
+    memcpy(uncompPtr + offset, outBufs[ii].getPtr(), outBufs[ii].getLen());
+    offset += outBufs[ii].getLen();
+  }
 
-  } // if (rdir ...
+  if (_debug) {
+    cerr << "  N records unzipped: " << records.size() << endl;
+    cerr << "  N threads used: " << (nThreads < 1 ? 1 : nThreads) << endl;
+    cerr << "  Uncompressed len: " << uncompLen << endl;
+  }
+
+  return 0;
 
 }
 
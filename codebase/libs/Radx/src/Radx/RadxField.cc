@@ -3900,7 +3900,8 @@ string RadxField::statsMethodToStr(StatsMethod_t method)
 /////////////////////////////////////////////////////////
 // serialize into a RadxMsg
 
-void RadxField::serialize(RadxMsg &msg)
+void RadxField::serialize(RadxMsg &msg,
+                          bool includeData /* = true */)
   
 {
 
@@ -3923,7 +3924,9 @@ void RadxField::serialize(RadxMsg &msg)
 
   // add field data
 
-  msg.addPart(_dataPartId, _data, _nPoints * _byteWidth);
+  if (includeData) {
+    msg.addPart(_dataPartId, _data, _nPoints * _byteWidth);
+  }
 
   // assemble the message from the parts
 
@@ -3935,7 +3938,8 @@ void RadxField::serialize(RadxMsg &msg)
 // deserialize from a RadxMsg
 // return 0 on success, -1 on failure
 
-int RadxField::deserialize(const RadxMsg &msg)
+int RadxField::deserialize(const RadxMsg &msg,
+                           bool dataRequired /* = true */)
   
 {
   
@@ -4004,6 +4008,10 @@ int RadxField::deserialize(const RadxMsg &msg)
   // get the data part
 
   const RadxMsg::Part *dataPart = msg.getPartByType(_dataPartId);
+  if (dataPart == NULL && !dataRequired) {
+    // metadata only - data will be attached by caller
+    return 0;
+  }
   if (dataPart == NULL) {
     cerr << "=======================================" << endl;
     cerr << "ERROR - RadxField::deserialize" << endl;
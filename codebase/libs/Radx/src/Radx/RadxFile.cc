@@ -89,6 +89,10 @@ RadxFile::RadxFile()
   _verbose = false;
   _fileFormat = FILE_FORMAT_CFRADIAL;
   _ncFormat = NETCDF4;
+  _sweepReadOpen = false;
+  _sweepReadIndex = 0;
+  _sweepReadFile = NULL;
+  _sweepReadVol = NULL;
   clearRead();
   clearWrite();
 }
@@ -99,6 +103,12 @@ RadxFile::RadxFile()
 RadxFile::~RadxFile()
 
 {
+  if (_sweepReadFile) {
+    delete _sweepReadFile;
+  }
+  if (_sweepReadVol) {
+    delete _sweepReadVol;
+  }
 }
 
 ///////////////////////////////
@@ -454,6 +464,9 @@ void RadxFile::clearWrite()
 {
   _writeCompressed = true;
   _compressionLevel = 5;
+  _writeChunkingMode = CHUNKING_SWEEP;
+  _writeChunkNRays = 0;
+  _writeShuffle = true;
   _writeLdataInfo = false;
   _writeFileNameMode = FILENAME_WITH_START_AND_END_TIMES;
   _writeFileNamePrefix.clear();
@@ -500,6 +513,9 @@ void RadxFile::copyWriteDirectives(const RadxFile &other)
   _writeHyphenInDateTime = other._writeHyphenInDateTime; 
   _writeCompressed = other._writeCompressed;
   _compressionLevel = other._compressionLevel;
+  _writeChunkingMode = other._writeChunkingMode;
+  _writeChunkNRays = other._writeChunkNRays;
+  _writeShuffle = other._writeShuffle;
   _writeLdataInfo = other._writeLdataInfo;
   _writeProposedStdNameInNcf = other._writeProposedStdNameInNcf;
   _ncFormat = other._ncFormat;
@@ -1999,6 +2015,187 @@ int RadxFile::readFromDir(const string &dir,
 
 }
 
+/////////////////////////////////////////////////////////
+// Open a file for reading one sweep at a time.
+// CfRadial and NEXRAD are handled by the format-specific
+// classes, which read incrementally.
+// Returns 0 on success, -1 on failure
+// Use getErrStr() if error occurs
+
+int RadxFile::openSweepRead(const string &path)
+
+{
+
+  closeSweepRead();
+  clearErrStr();
+
+  // check for formats with an incremental reader
+
+  if (isNetCDF(path)) {
+    NcfRadxFile *file = new NcfRadxFile;
+    if (file->isCfRadial(path)) {
+      _sweepReadFile = file;
+    } else {
+      delete file;
+    }
+  } else {
+    NexradRadxFile *file = new NexradRadxFile;
+    if (file->isNexrad(path)) {
+      _sweepReadFile = file;
+    } else {
+      delete file;
+    }
+  }
+
+  if (_sweepReadFile == NULL) {
+    return _openSweepReadGeneric(path);
+  }
+
+  _sweepReadFile->copyReadDirectives(*this);
+  if (_sweepReadFile->openSweepRead(path)) {
+    _errStr = _sweepReadFile->getErrStr();
+    _addErrStr("ERROR - RadxFile::openSweepRead");
+    delete _sweepReadFile;
+    _sweepReadFile = NULL;
+    return -1;
+  }
+
+  _pathInUse = path;
+  _sweepReadPath = path;
+  _sweepReadOpen = true;
+
+  return 0;
+
+}
+
+/////////////////////////////////////////////////////////
+// Open for sweep reads, for formats which do not have an
+// incremental reader. The whole volume is read once, and the
+// sweeps are then copied from it in turn. This saves re-reading
+// the file for each sweep, but not memory.
+// Returns 0 on success, -1 on failure
+
+int RadxFile::_openSweepReadGeneric(const string &path)
+
+{
+
+  bool readStrictAngleLimits = _readStrictAngleLimits;
+  _readStrictAngleLimits = true;
+  _sweepReadVol = new RadxVol;
+  int iret = readFromPath(path, *_sweepReadVol);
+  _readStrictAngleLimits = readStrictAngleLimits;
+
+  if (iret) {
+    _addErrStr("ERROR - RadxFile::openSweepRead");
+    _addErrStr("  Cannot read volume, path: ", path);
+    delete _sweepReadVol;
+    _sweepReadVol = NULL;
+    return -1;
+  }
+
+  _sweepReadNums.clear();
+  const vector<RadxSweep *> &sweeps = _sweepReadVol->getSweeps();
+  for (size_t ii = 0; ii < sweeps.size(); ii++) {
+    _sweepReadNums.push_back(sweeps[ii]->getSweepNumber());
+  }
+
+  _pathInUse = path;
+  _sweepReadPath = path;
+  _sweepReadIndex = 0;
+  _sweepReadOpen = true;
+
+  return 0;
+
+}
+
+/////////////////////////////////////////////////////////
+// Read the next sweep from the file opened by openSweepRead().
+// gotSweep is set false if there are no more sweeps.
+// Returns 0 on success, -1 on failure
+// Use getErrStr() if error occurs
+
+int RadxFile::readNextSweep(RadxVol &vol, bool &gotSweep)
+
+{
+
+  gotSweep = false;
+  clearErrStr();
+
+  if (!_sweepReadOpen) {
+    _addErrStr("ERROR - RadxFile::readNextSweep");
+    _addErrStr("  File not open for sweep reads");
+    return -1;
+  }
+
+  // format-specific reader?
+
+  if (_sweepReadFile) {
+    int iret = _sweepReadFile->readNextSweep(vol, gotSweep);
+    _errStr = _sweepReadFile->getErrStr();
+    _dirInUse = _sweepReadFile->getDirInUse();
+    _pathInUse = _sweepReadFile->getPathInUse();
+    _readPaths = _sweepReadFile->getReadPaths();
+    _fileFormat = _sweepReadFile->getFileFormat();
+    return iret;
+  }
+
+  // generic - copy the next sweep from the volume read on open
+  
+  if (_sweepReadIndex >= _sweepReadNums.size()) {
+    return 0;
+  }
+  int sweepNum = _sweepReadNums[_sweepReadIndex];
+  _sweepReadIndex++;
+
+  vol.clear();
+  vol.copy(*_sweepReadVol, sweepNum);
+
+  gotSweep = true;
+  return 0;
+
+}
+
+/////////////////////////////////////////////////////////
+// Close the file opened by openSweepRead()
+
+void RadxFile::closeSweepRead()
+
+{
+  if (_sweepReadFile) {
+    _sweepReadFile->closeSweepRead();
+    delete _sweepReadFile;
+    _sweepReadFile = NULL;
+  }
+  if (_sweepReadVol) {
+    delete _sweepReadVol;
+    _sweepReadVol = NULL;
+  }
+  _sweepReadNums.clear();
+  _sweepReadIndex = 0;
+  _sweepReadPath.clear();
+  _sweepReadOpen = false;
+}
+
+/////////////////////////////////////////////////////////
+// Write a volume containing a single sweep to the
+// specified dir. CfRadial sweeps are written as individual
+// sweep files.
+// Returns 0 on success, -1 on failure
+// Use getErrStr() if error occurs
+
+int RadxFile::writeSweepToDir(const RadxVol &vol,
+                              const string &dir,
+                              bool addDaySubDir,
+                              bool addYearSubDir)
+
+{
+  bool writeIndividualSweeps = _writeIndividualSweeps;
+  _writeIndividualSweeps = true;
+  int iret = writeToDir(vol, dir, addDaySubDir, addYearSubDir);
+  _writeIndividualSweeps = writeIndividualSweeps;
+  return iret;
+}
+
 ///////////////////////////////
 // clear the error string
 
@@ -2689,6 +2886,17 @@ void RadxFile::printWriteRequest(ostream &out) const
   out << "  writeCompressed: "
       << (_writeCompressed?"Y":"N") << endl;
   out << "  compressionLevel: " << _compressionLevel << endl;
+  out << "  writeChunkingMode: ";
+  if (_writeChunkingMode == CHUNKING_SWEEP) {
+    out << "CHUNKING_SWEEP" << endl;
+  } else if (_writeChunkingMode == CHUNKING_N_RAYS) {
+    out << "CHUNKING_N_RAYS" << endl;
+    out << "  writeChunkNRays: " << _writeChunkNRays << endl;
+  } else {
+    out << "CHUNKING_DEFAULT" << endl;
+  }
+  out << "  writeShuffle: "
+      << (_writeShuffle?"Y":"N") << endl;
   out << "  writeLdataInfo: "
       << (_writeLdataInfo?"Y":"N") << endl;
 
@@ -2122,7 +2122,8 @@ void RadxRay::deleteIfUnused(const RadxRay *ray)
 /////////////////////////////////////////////////////////
 // serialize into a RadxMsg
 
-void RadxRay::serialize(RadxMsg &msg)
+void RadxRay::serialize(RadxMsg &msg,
+                        bool includeFieldData /* = true */)
   
 {
 
@@ -2174,7 +2175,7 @@ void RadxRay::serialize(RadxMsg &msg)
     // serialize
 
     RadxMsg fieldMsg(RadxMsg::RadxFieldMsg);
-    field->serialize(fieldMsg);
+    field->serialize(fieldMsg, includeFieldData);
     fieldMsg.assemble();
     msg.addPart(_fieldPartId,
                 fieldMsg.assembledMsg(), 
@@ -2192,7 +2193,8 @@ void RadxRay::serialize(RadxMsg &msg)
 // deserialize from a RadxMsg
 // return 0 on success, -1 on failure
 
-int RadxRay::deserialize(const RadxMsg &msg)
+int RadxRay::deserialize(const RadxMsg &msg,
+                         bool fieldDataRequired /* = true */)
   
 {
   
@@ -2318,7 +2320,7 @@ int RadxRay::deserialize(const RadxMsg &msg)
     // create a field, dserialize from the message
     
     RadxField *field = new RadxField;
-    if (field->deserialize(fieldMsg)) {
+    if (field->deserialize(fieldMsg, fieldDataRequired)) {
       cerr << "=======================================" << endl;
       cerr << "ERROR - RadxRay::deserialize" << endl;
       cerr << "  Adding field num: " << ifield << endl;
@@ -7273,7 +7273,8 @@ int RadxVol::_getTransIndex(const RadxSweep *sweep, double azimuth)
 /////////////////////////////////////////////////////////
 // serialize into a RadxMsg
 
-void RadxVol::serialize(RadxMsg &msg)
+void RadxVol::serialize(RadxMsg &msg,
+                        bool includeFieldData /* = true */)
   
 {
 
@@ -7342,7 +7343,7 @@ void RadxVol::serialize(RadxMsg &msg)
   for (size_t iray = 0; iray < _rays.size(); iray++) {
     RadxRay *ray = _rays[iray];
     RadxMsg rayMsg(RadxMsg::RadxRayMsg);
-    ray->serialize(rayMsg);
+    ray->serialize(rayMsg, includeFieldData);
     rayMsg.assemble();
     msg.addPart(_rayPartId,
                 rayMsg.assembledMsg(), 
@@ -7366,7 +7367,7 @@ void RadxVol::serialize(RadxMsg &msg)
   for (size_t ifield = 0; ifield < _fields.size(); ifield++) {
     RadxField *field = _fields[ifield];
     RadxMsg fieldMsg(RadxMsg::RadxFieldMsg);
-    field->serialize(fieldMsg);
+    field->serialize(fieldMsg, includeFieldData);
     fieldMsg.assemble();
     msg.addPart(_fieldPartId,
                 fieldMsg.assembledMsg(), 
@@ -7383,7 +7384,8 @@ void RadxVol::serialize(RadxMsg &msg)
 // deserialize from a RadxMsg
 // return 0 on success, -1 on failure
 
-int RadxVol::deserialize(const RadxMsg &msg)
+int RadxVol::deserialize(const RadxMsg &msg,
+                         bool fieldDataRequired /* = true */)
   
 {
   
@@ -7576,7 +7578,7 @@ int RadxVol::deserialize(const RadxMsg &msg)
     rayMsg.disassemble(rayPart->getBuf(), rayPart->getLength());
     // create a ray, dserialize from the message
     RadxRay *ray = new RadxRay;
-    if (ray->deserialize(rayMsg)) {
+    if (ray->deserialize(rayMsg, fieldDataRequired)) {
       cerr << "=======================================" << endl;
       cerr << "ERROR - RadxRay::deserialize" << endl;
       cerr << "  Adding ray, num: " << iray << endl;
@@ -7604,7 +7606,7 @@ int RadxVol::deserialize(const RadxMsg &msg)
     fieldMsg.disassemble(fieldPart->getBuf(), fieldPart->getLength());
     // create a field, dserialize from the message
     RadxField *field = new RadxField;
-    if (field->deserialize(fieldMsg)) {
+    if (field->deserialize(fieldMsg, fieldDataRequired)) {
       cerr << "=======================================" << endl;
       cerr << "ERROR - RadxField::deserialize" << endl;
       cerr << "  Adding field, num: " << ifield << endl;
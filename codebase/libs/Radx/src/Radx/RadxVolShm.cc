@@ -0,0 +1,445 @@
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* 
+// ** Copyright UCAR (c) 1990 - 2016                                         
+// ** University Corporation for Atmospheric Research (UCAR)                 
+// ** National Center for Atmospheric Research (NCAR)                        
+// ** Boulder, Colorado, USA                                                 
+// ** BSD licence applies - redistribution and use in source and binary      
+// ** forms, with or without modification, are permitted provided that       
+// ** the following conditions are met:                                      
+// ** 1) If the software is modified to produce derivative works,            
+// ** such modified software should be clearly marked, so as not             
+// ** to confuse it with the version available from UCAR.                    
+// ** 2) Redistributions of source code must retain the above copyright      
+// ** notice, this list of conditions and the following disclaimer.          
+// ** 3) Redistributions in binary form must reproduce the above copyright   
+// ** notice, this list of conditions and the following disclaimer in the    
+// ** documentation and/or other materials provided with the distribution.   
+// ** 4) Neither the name of UCAR nor the names of its contributors,         
+// ** if any, may be used to endorse or promote products derived from        
+// ** this software without specific prior written permission.               
+// ** DISCLAIMER: THIS SOFTWARE IS PROVIDED "AS IS" AND WITHOUT ANY EXPRESS  
+// ** OR IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED      
+// ** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.    
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* 
+////////////////////////////////////////////////////////////////////
+// RadxVolShm.cc
+//
+// Hand off a RadxVol between processes in shared memory.
+//
+////////////////////////////////////////////////////////////////////
+
+#include <Radx/RadxVolShm.hh>
+#include <Radx/RadxVol.hh>
+#include <Radx/RadxRay.hh>
+#include <Radx/RadxField.hh>
+#include <Radx/RadxMsg.hh>
+#include <Radx/RadxStr.hh>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+const char *RadxVolShm::_magic = "RadxShm2";
+
+//////////////////////////////////////////////////////////////
+// Constructor
+
+RadxVolShm::RadxVolShm()
+{
+  _debug = false;
+  _maxPublished = 4;
+  _shmAddr = NULL;
+  _hdrAddr = NULL;
+  _shmLen = 0;
+}
+
+//////////////////////////////////////////////////////////////
+// Destructor
+
+RadxVolShm::~RadxVolShm()
+{
+  detach();
+}
+
+//////////////////////////////////////////////////////////////
+// Publish a volume to a shared memory segment.
+// Returns 0 on success, -1 on failure.
+
+int RadxVolShm::publish(const string &name,
+                        RadxVol &vol,
+                        int nConsumers /* = 1 */)
+{
+
+  _errStr.clear();
+  string shmName = _fixName(name);
+
+  // serialize the metadata, without the field data
+
+  RadxMsg msg;
+  vol.serialize(msg, false);
+
+  // get the fields, in the order in which deserialize()
+  // will recreate them
+
+  vector<RadxField *> fields;
+  _loadFieldList(vol, fields);
+
+  // compute the layout
+
+  size_t metaOffset = _alignLen(sizeof(shm_hdr_t));
+  size_t metaLen = msg.lengthAssembled();
+  size_t tableOffset = metaOffset + _alignLen(metaLen);
+  size_t tableLen = fields.size() * sizeof(field_ref_t);
+  size_t packingOffset = tableOffset + _alignLen(tableLen);
+
+  // the gates in each ray are needed to restore the packing of
+  // fields with more than one ray, e.g. volume fields
+
+  vector<field_ref_t> refs(fields.size());
+  vector<Radx::si64> packing;
+  for (size_t ii = 0; ii < fields.size(); ii++) {
+    const RadxField *fld = fields[ii];
+    const vector<size_t> &rayNGates = fld->getRayNGates();
+    memset(&refs[ii], 0, sizeof(field_ref_t));
+    refs[ii].nRays = rayNGates.size();
+    refs[ii].packingOffset =
+      packingOffset + packing.size() * sizeof(Radx::si64);
+    packing.insert(packing.end(), rayNGates.begin(), rayNGates.end());
+  }
+  size_t packingLen = packing.size() * sizeof(Radx::si64);
+
+  size_t offset = packingOffset + _alignLen(packingLen);
+  for (size_t ii = 0; ii < fields.size(); ii++) {
+    const RadxField *fld = fields[ii];
+    refs[ii].offset = offset;
+    refs[ii].nGates = fld->getNPoints();
+    refs[ii].nBytes = fld->getNPoints() * fld->getByteWidth();
+    offset += _alignLen(refs[ii].nBytes);
+  }
+  size_t segLen = offset;
+
+  // create the segment, replacing any existing one
+
+  shm_unlink(shmName.c_str());
+  int fd = shm_open(shmName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0666);
+  if (fd < 0) {
+    int errNum = errno;
+    _errStr += "ERROR - RadxVolShm::publish\n";
+    RadxStr::addStr(_errStr, "  Cannot create shm segment: ", shmName);
+    RadxStr::addStr(_errStr, "  ", strerror(errNum));
+    return -1;
+  }
+  if (ftruncate(fd, segLen)) {
+    int errNum = errno;
+    _errStr += "ERROR - RadxVolShm::publish\n";
+    RadxStr::addStr(_errStr, "  Cannot size shm segment: ", shmName);
+    RadxStr::addStr(_errStr, "  ", strerror(errNum));
+    close(fd);
+    shm_unlink(shmName.c_str());
+    return -1;
+  }
+  void *addr = mmap(NULL, segLen, PROT_READ | PROT_WRITE,
+                    MAP_SHARED, fd, 0);
+  close(fd);
+  if (addr == MAP_FAILED) {
+    int errNum = errno;
+    _errStr += "ERROR - RadxVolShm::publish\n";
+    RadxStr::addStr(_errStr, "  Cannot map shm segment: ", shmName);
+    RadxStr::addStr(_errStr, "  ", strerror(errNum));
+    shm_unlink(shmName.c_str());
+    return -1;
+  }
+
+  // load the segment
+
+  char *base = (char *) addr;
+  shm_hdr_t *hdr = (shm_hdr_t *) base;
+  memset(hdr, 0, sizeof(shm_hdr_t));
+  hdr->segLen = segLen;
+  hdr->metaOffset = metaOffset;
+  hdr->metaLen = metaLen;
+  hdr->tableOffset = tableOffset;
+  hdr->nFields = fields.size();
+  hdr->nClaims = nConsumers;
+
+  memcpy(base + metaOffset, msg.assembledMsg(), metaLen);
+  if (tableLen > 0) {
+    memcpy(base + tableOffset, &refs[0], tableLen);
+  }
+  if (packingLen > 0) {
+    memcpy(base + packingOffset, &packing[0], packingLen);
+  }
+  for (size_t ii = 0; ii < fields.size(); ii++) {
+    if (refs[ii].nBytes > 0) {
+      memcpy(base + refs[ii].offset, fields[ii]->getData(), refs[ii].nBytes);
+    }
+  }
+
+  // the magic marks the segment as complete
+
+  __sync_synchronize();
+  memcpy(hdr->magic, _magic, sizeof(hdr->magic));
+  munmap(addr, segLen);
+
+  if (_debug) {
+    cerr << "DEBUG - RadxVolShm::publish" << endl;
+    cerr << "  Segment: " << shmName << endl;
+    cerr << "  nBytes, nFields: " << segLen << ", " << fields.size() << endl;
+  }
+
+  // keep track of our segments, removing the oldest
+
+  for (deque<string>::iterator it = _published.begin();
+       it != _published.end(); it++) {
+    if (*it == shmName) {
+      _published.erase(it);
+      break;
+    }
+  }
+  _published.push_back(shmName);
+  while ((int) _published.size() > _maxPublished) {
+    remove(_published.front());
+    _published.pop_front();
+  }
+
+  return 0;
+
+}
+
+//////////////////////////////////////////////////////////////
+// Attach to a volume in a shared memory segment.
+// Returns 0 on success, -1 on failure.
+
+int RadxVolShm::attach(const string &name, RadxVol &vol)
+{
+
+  detach();
+  _errStr.clear();
+  string shmName = _fixName(name);
+
+  int fd = shm_open(shmName.c_str(), O_RDWR, 0);
+  if (fd < 0) {
+    int errNum = errno;
+    _errStr += "ERROR - RadxVolShm::attach\n";
+    RadxStr::addStr(_errStr, "  Cannot open shm segment: ", shmName);
+    RadxStr::addStr(_errStr, "  ", strerror(errNum));
+    return -1;
+  }
+  struct stat fileStat;
+  if (fstat(fd, &fileStat) || fileStat.st_size < (off_t) sizeof(shm_hdr_t)) {
+    _errStr += "ERROR - RadxVolShm::attach\n";
+    RadxStr::addStr(_errStr, "  Bad shm segment: ", shmName);
+    close(fd);
+    return -1;
+  }
+
+  // map the whole segment copy-on-write, and the header shared
+  // so that we can release our claim
+
+  size_t segLen = fileStat.st_size;
+  void *addr = mmap(NULL, segLen, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE, fd, 0);
+  void *hdrAddr = mmap(NULL, sizeof(shm_hdr_t), PROT_READ | PROT_WRITE,
+                       MAP_SHARED, fd, 0);
+  close(fd);
+  if (addr == MAP_FAILED || hdrAddr == MAP_FAILED) {
+    int errNum = errno;
+    _errStr += "ERROR - RadxVolShm::attach\n";
+    RadxStr::addStr(_errStr, "  Cannot map shm segment: ", shmName);
+    RadxStr::addStr(_errStr, "  ", strerror(errNum));
+    if (addr != MAP_FAILED) {
+      munmap(addr, segLen);
+    }
+    if (hdrAddr != MAP_FAILED) {
+      munmap(hdrAddr, sizeof(shm_hdr_t));
+    }
+    return -1;
+  }
+  _shmName = shmName;
+  _shmAddr = addr;
+  _hdrAddr = hdrAddr;
+  _shmLen = segLen;
+
+  // check the header. Until the magic is set the producer is still
+  // loading the segment, including the claims, so do not release
+  // a claim on an incomplete segment.
+
+  const char *base = (const char *) _shmAddr;
+  const shm_hdr_t *hdr = (const shm_hdr_t *) _hdrAddr;
+  if (memcmp(hdr->magic, _magic, sizeof(hdr->magic))) {
+    _errStr += "ERROR - RadxVolShm::attach\n";
+    RadxStr::addStr(_errStr, "  Incomplete shm segment: ", shmName);
+    _unmap();
+    return -1;
+  }
+  if (hdr->segLen != (Radx::si64) segLen ||
+      hdr->metaOffset + hdr->metaLen > hdr->segLen ||
+      hdr->tableOffset + hdr->nFields * (Radx::si64) sizeof(field_ref_t) >
+      hdr->segLen) {
+    _errStr += "ERROR - RadxVolShm::attach\n";
+    RadxStr::addStr(_errStr, "  Bad shm segment: ", shmName);
+    detach();
+    return -1;
+  }
+
+  // deserialize the metadata
+
+  RadxMsg msg;
+  if (msg.disassemble(base + hdr->metaOffset, hdr->metaLen) ||
+      vol.deserialize(msg, false)) {
+    _errStr += "ERROR - RadxVolShm::attach\n";
+    RadxStr::addStr(_errStr, "  Cannot deserialize volume, segment: ",
+                    shmName);
+    vol.clear();
+    detach();
+    return -1;
+  }
+
+  // point the fields at the data in the segment
+
+  vector<RadxField *> fields;
+  _loadFieldList(vol, fields);
+  if ((Radx::si64) fields.size() != hdr->nFields) {
+    _errStr += "ERROR - RadxVolShm::attach\n";
+    RadxStr::addStr(_errStr, "  Field count mismatch, segment: ", shmName);
+    vol.clear();
+    detach();
+    return -1;
+  }
+
+  const field_ref_t *refs = (const field_ref_t *) (base + hdr->tableOffset);
+  for (size_t ii = 0; ii < fields.size(); ii++) {
+    RadxField *fld = fields[ii];
+    const field_ref_t &ref = refs[ii];
+    if (ref.nGates != (Radx::si64) fld->getNPoints() ||
+        ref.nBytes != ref.nGates * fld->getByteWidth() ||
+        ref.offset + ref.nBytes > hdr->segLen ||
+        ref.nRays < 0 ||
+        ref.packingOffset + ref.nRays * (Radx::si64) sizeof(Radx::si64) >
+        hdr->segLen) {
+      _errStr += "ERROR - RadxVolShm::attach\n";
+      RadxStr::addStr(_errStr, "  Bad field data, segment: ", shmName);
+      RadxStr::addStr(_errStr, "  Field: ", fld->getName());
+      vol.clear();
+      detach();
+      return -1;
+    }
+    const Radx::si64 *packing =
+      (const Radx::si64 *) (base + ref.packingOffset);
+    vector<size_t> rayNGates(packing, packing + ref.nRays);
+    Radx::si64 nGates = 0;
+    for (size_t iray = 0; iray < rayNGates.size(); iray++) {
+      nGates += rayNGates[iray];
+    }
+    if (nGates != ref.nGates) {
+      _errStr += "ERROR - RadxVolShm::attach\n";
+      RadxStr::addStr(_errStr, "  Bad ray packing, segment: ", shmName);
+      RadxStr::addStr(_errStr, "  Field: ", fld->getName());
+      vol.clear();
+      detach();
+      return -1;
+    }
+    // setDataRemote() sets a single ray, so restore the packing after
+    fld->setDataRemote(*fld, base + ref.offset, ref.nGates);
+    if (rayNGates.size() > 1) {
+      fld->setPacking(rayNGates);
+    }
+  }
+
+  if (_debug) {
+    cerr << "DEBUG - RadxVolShm::attach" << endl;
+    cerr << "  Segment: " << shmName << endl;
+    cerr << "  nRays, nFields: " << vol.getNRays()
+         << ", " << fields.size() << endl;
+  }
+
+  return 0;
+
+}
+
+//////////////////////////////////////////////////////////////
+// Detach from the segment, releasing this consumer's claim.
+// The segment is removed when the last claim is released.
+
+void RadxVolShm::detach()
+{
+
+  if (_shmAddr == NULL) {
+    return;
+  }
+
+  shm_hdr_t *hdr = (shm_hdr_t *) _hdrAddr;
+  int nLeft = __sync_sub_and_fetch(&hdr->nClaims, 1);
+  if (nLeft == 0) {
+    if (_debug) {
+      cerr << "DEBUG - RadxVolShm::detach" << endl;
+      cerr << "  Last claim released, removing: " << _shmName << endl;
+    }
+    shm_unlink(_shmName.c_str());
+  }
+
+  _unmap();
+
+}
+
+//////////////////////////////////////////////////////////////
+// Remove a segment by name.
+// Returns 0 on success, -1 on failure.
+
+int RadxVolShm::remove(const string &name)
+{
+  string shmName = _fixName(name);
+  if (shm_unlink(shmName.c_str())) {
+    return -1;
+  }
+  return 0;
+}
+
+//////////////////////////////////////////////////////////////
+// Unmap without releasing the claim
+
+void RadxVolShm::_unmap()
+{
+  if (_shmAddr != NULL) {
+    munmap(_shmAddr, _shmLen);
+  }
+  if (_hdrAddr != NULL) {
+    munmap(_hdrAddr, sizeof(shm_hdr_t));
+  }
+  _shmAddr = NULL;
+  _hdrAddr = NULL;
+  _shmLen = 0;
+  _shmName.clear();
+}
+
+//////////////////////////////////////////////////////////////
+// Load the list of fields - the ray fields followed by the
+// volume fields, as serialized
+
+void RadxVolShm::_loadFieldList(RadxVol &vol,
+                                vector<RadxField *> &fields)
+{
+  fields.clear();
+  vector<RadxRay *> &rays = vol.getRays();
+  for (size_t iray = 0; iray < rays.size(); iray++) {
+    vector<RadxField *> rayFields =
+      rays[iray]->getFields(Radx::FIELD_RETRIEVAL_ALL);
+    fields.insert(fields.end(), rayFields.begin(), rayFields.end());
+  }
+  vector<RadxField *> volFields = vol.getFields(Radx::FIELD_RETRIEVAL_ALL);
+  fields.insert(fields.end(), volFields.begin(), volFields.end());
+}
+
+//////////////////////////////////////////////////////////////
+// POSIX shm names must start with a single '/'
+
+string RadxVolShm::_fixName(const string &name)
+{
+  if (name.size() > 0 && name[0] == '/') {
+    return name;
+  }
+  return "/" + name;
+}
+
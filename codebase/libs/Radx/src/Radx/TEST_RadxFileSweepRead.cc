@@ -0,0 +1,446 @@
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* 
+// ** Copyright UCAR (c) 1990 - 2016                                         
+// ** University Corporation for Atmospheric Research (UCAR)                 
+// ** National Center for Atmospheric Research (NCAR)                        
+// ** Boulder, Colorado, USA                                                 
+// ** BSD licence applies - redistribution and use in source and binary      
+// ** forms, with or without modification, are permitted provided that       
+// ** the following conditions are met:                                      
+// ** 1) If the software is modified to produce derivative works,            
+// ** such modified software should be clearly marked, so as not             
+// ** to confuse it with the version available from UCAR.                    
+// ** 2) Redistributions of source code must retain the above copyright      
+// ** notice, this list of conditions and the following disclaimer.          
+// ** 3) Redistributions in binary form must reproduce the above copyright   
+// ** notice, this list of conditions and the following disclaimer in the    
+// ** documentation and/or other materials provided with the distribution.   
+// ** 4) Neither the name of UCAR nor the names of its contributors,         
+// ** if any, may be used to endorse or promote products derived from        
+// ** this software without specific prior written permission.               
+// ** DISCLAIMER: THIS SOFTWARE IS PROVIDED "AS IS" AND WITHOUT ANY EXPRESS  
+// ** OR IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED      
+// ** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.    
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* 
+/*
+ * Name: TEST_RadxFileSweepRead.cc
+ *
+ * Purpose:
+ *
+ *      To test reading one sweep at a time with openSweepRead() and
+ *      readNextSweep(), and writing one sweep at a time with
+ *      writeSweepToDir().
+ *
+ *      A synthetic volume is written in CfRadial, which has an
+ *      incremental reader, and in UF, which uses the generic reader.
+ *      Each sweep returned by readNextSweep() must match the same
+ *      sweep in the volume returned by readFromPath(), with and
+ *      without fixed angle limits.
+ *
+ *      The sweeps are then written with writeSweepToDir(), and the
+ *      CfRadial sweep files are read back as an aggregated volume.
+ *
+ * Usage:
+ *
+ *       % RadxFileSweepRead-test
+ *
+ * Inputs:
+ *
+ *       None
+ *
+ * Returns 0 on success, 1 on failure.
+ * Prints nothing on success.
+ *
+ */
+
+/*
+ * include files
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <Radx/RadxFile.hh>
+#include <Radx/RadxVol.hh>
+#include <Radx/RadxRay.hh>
+#include <Radx/RadxField.hh>
+#include <Radx/RadxSweep.hh>
+#include <Radx/RadxTime.hh>
+using namespace std;
+
+static const int nSweeps = 4;
+static const int nRaysPerSweep = 90;
+static const int nGates = 200;
+static const double elevs[nSweeps] = {0.5, 1.5, 2.5, 3.5};
+
+static int nFail = 0;
+
+/*
+ * Create a synthetic PPI volume
+ */
+
+static void _makeVol(RadxVol &vol)
+{
+
+  vol.clear();
+  vol.setTitle("RadxFileSweepRead-test");
+  vol.setInstrumentName("TEST");
+  vol.setSiteName("TEST");
+  vol.setInstrumentType(Radx::INSTRUMENT_TYPE_RADAR);
+  vol.setPlatformType(Radx::PLATFORM_TYPE_FIXED);
+  vol.setLatitudeDeg(40.0);
+  vol.setLongitudeDeg(-105.0);
+  vol.setAltitudeKm(1.6);
+  vol.setVolumeNumber(12);
+
+  // mid-day, so that aggregation does not search other day dirs
+
+  RadxTime startTime(2020, 6, 15, 12, 0, 0);
+  vector<Radx::fl32> dbz(nGates), vel(nGates);
+
+  for (int isweep = 0; isweep < nSweeps; isweep++) {
+    for (int iray = 0; iray < nRaysPerSweep; iray++) {
+      RadxRay *ray = new RadxRay;
+      ray->setVolumeNumber(12);
+      ray->setSweepNumber(isweep);
+      ray->setSweepMode(Radx::SWEEP_MODE_AZIMUTH_SURVEILLANCE);
+      ray->setTime(startTime.utime() + isweep * 20 + iray / 5, 0.0);
+      ray->setAzimuthDeg(iray * 4.0);
+      ray->setElevationDeg(elevs[isweep]);
+      ray->setFixedAngleDeg(elevs[isweep]);
+      ray->setRangeGeom(0.5, 0.25);
+      for (int igate = 0; igate < nGates; igate++) {
+        if ((igate + iray) % 17 == 0) {
+          dbz[igate] = Radx::missingFl32;
+        } else {
+          dbz[igate] = -10.0 + ((igate * 7 + iray * 3 + isweep) % 600) * 0.1;
+        }
+        vel[igate] = -20.0 + ((igate + iray * 11 + isweep * 5) % 400) * 0.1;
+      }
+      ray->addField("DBZ", "dBZ", nGates, Radx::missingFl32,
+                    dbz.data(), true);
+      ray->addField("VEL", "m/s", nGates, Radx::missingFl32,
+                    vel.data(), true);
+      vol.addRay(ray);
+    }
+  }
+
+  vol.loadVolumeInfoFromRays();
+  vol.loadSweepInfoFromRays();
+
+}
+
+/*
+ * Compare a sweep volume against one sweep of a full volume
+ */
+
+static void _compareSweep(const char *label,
+                          const RadxVol &full, size_t sweepIndex,
+                          const RadxVol &sweepVol)
+{
+
+  if (sweepVol.getNSweeps() != 1) {
+    fprintf(stderr, "FAIL - %s, sweep %d, expected 1 sweep, got %d\n",
+            label, (int) sweepIndex, (int) sweepVol.getNSweeps());
+    nFail++;
+    return;
+  }
+
+  const RadxSweep *expSweep = full.getSweeps()[sweepIndex];
+  const RadxSweep *sweep = sweepVol.getSweeps()[0];
+  if (sweep->getSweepNumber() != expSweep->getSweepNumber() ||
+      fabs(sweep->getFixedAngleDeg() - expSweep->getFixedAngleDeg()) > 0.001 ||
+      sweepVol.getNRays() != expSweep->getNRays()) {
+    fprintf(stderr, "FAIL - %s, sweep %d, wrong sweep number, "
+            "fixed angle or nRays\n", label, (int) sweepIndex);
+    nFail++;
+    return;
+  }
+
+  const vector<RadxRay *> &expRays = full.getRays();
+  const vector<RadxRay *> &rays = sweepVol.getRays();
+  for (size_t iray = 0; iray < rays.size(); iray++) {
+    const RadxRay *expRay = expRays[expSweep->getStartRayIndex() + iray];
+    const RadxRay *ray = rays[iray];
+    const vector<RadxField *> expFields = expRay->getFields();
+    if (ray->getAzimuthDeg() != expRay->getAzimuthDeg() ||
+        ray->getElevationDeg() != expRay->getElevationDeg() ||
+        ray->getNGates() != expRay->getNGates() ||
+        ray->getFields().size() != expFields.size()) {
+      fprintf(stderr, "FAIL - %s, sweep %d, ray %d, wrong ray metadata\n",
+              label, (int) sweepIndex, (int) iray);
+      nFail++;
+      return;
+    }
+    for (size_t ifield = 0; ifield < expFields.size(); ifield++) {
+      const RadxField *expFld = expFields[ifield];
+      const RadxField *fld = ray->getField(expFld->getName());
+      if (fld == NULL) {
+        fprintf(stderr, "FAIL - %s, sweep %d, ray %d, missing field %s\n",
+                label, (int) sweepIndex, (int) iray,
+                expFld->getName().c_str());
+        nFail++;
+        return;
+      }
+      RadxField expCopy(*expFld);
+      RadxField copy(*fld);
+      expCopy.convertToFl32();
+      copy.convertToFl32();
+      if (memcmp(copy.getDataFl32(), expCopy.getDataFl32(),
+                 ray->getNGates() * sizeof(Radx::fl32))) {
+        fprintf(stderr, "FAIL - %s, sweep %d, ray %d, field %s differs\n",
+                label, (int) sweepIndex, (int) iray,
+                expFld->getName().c_str());
+        nFail++;
+        return;
+      }
+    }
+  }
+
+}
+
+/*
+ * Read a file one sweep at a time, and compare against the whole
+ * volume. If limits are set, only the sweeps between 1.0 and 3.0
+ * degrees are read.
+ */
+
+static void _testSweepRead(const char *label, const string &path,
+                           bool setLimits)
+{
+
+  RadxFile full;
+  RadxFile sweeps;
+  if (setLimits) {
+    full.setReadFixedAngleLimits(1.0, 3.0);
+    full.setReadStrictAngleLimits(true);
+    sweeps.setReadFixedAngleLimits(1.0, 3.0);
+  }
+
+  RadxVol fullVol;
+  if (full.readFromPath(path, fullVol)) {
+    fprintf(stderr, "FAIL - %s, cannot read volume: %s\n",
+            label, full.getErrStr().c_str());
+    nFail++;
+    return;
+  }
+  size_t nExpected = setLimits ? 2 : nSweeps;
+  if (fullVol.getNSweeps() != nExpected) {
+    fprintf(stderr, "FAIL - %s, expected %d sweeps in volume, got %d\n",
+            label, (int) nExpected, (int) fullVol.getNSweeps());
+    nFail++;
+    return;
+  }
+
+  if (sweeps.openSweepRead(path)) {
+    fprintf(stderr, "FAIL - %s, cannot open for sweep reads: %s\n",
+            label, sweeps.getErrStr().c_str());
+    nFail++;
+    return;
+  }
+
+  size_t nRead = 0;
+  while (true) {
+    RadxVol sweepVol;
+    bool gotSweep = false;
+    if (sweeps.readNextSweep(sweepVol, gotSweep)) {
+      fprintf(stderr, "FAIL - %s, readNextSweep: %s\n",
+              label, sweeps.getErrStr().c_str());
+      nFail++;
+      break;
+    }
+    if (!gotSweep) {
+      break;
+    }
+    if (nRead < fullVol.getNSweeps()) {
+      _compareSweep(label, fullVol, nRead, sweepVol);
+    }
+    nRead++;
+  }
+  sweeps.closeSweepRead();
+
+  if (nRead != nExpected) {
+    fprintf(stderr, "FAIL - %s, expected %d sweeps, read %d\n",
+            label, (int) nExpected, (int) nRead);
+    nFail++;
+  }
+
+  // reading after close must fail
+
+  RadxVol sweepVol;
+  bool gotSweep = true;
+  if (sweeps.readNextSweep(sweepVol, gotSweep) == 0 || gotSweep) {
+    fprintf(stderr, "FAIL - %s, readNextSweep succeeded after close\n",
+            label);
+    nFail++;
+  }
+
+}
+
+/*
+ * Write the volume one sweep at a time.
+ * Returns the paths written.
+ */
+
+static vector<string> _writeSweeps(const char *label,
+                                   RadxFile::file_format_t format,
+                                   const string &inPath,
+                                   const string &outDir)
+{
+
+  vector<string> paths;
+  RadxFile in;
+  if (in.openSweepRead(inPath)) {
+    fprintf(stderr, "FAIL - %s, cannot open for sweep reads: %s\n",
+            label, in.getErrStr().c_str());
+    nFail++;
+    return paths;
+  }
+
+  RadxFile out;
+  out.setFileFormat(format);
+  while (true) {
+    RadxVol sweepVol;
+    bool gotSweep = false;
+    if (in.readNextSweep(sweepVol, gotSweep) || !gotSweep) {
+      break;
+    }
+    if (out.writeSweepToDir(sweepVol, outDir, false, false)) {
+      fprintf(stderr, "FAIL - %s, writeSweepToDir: %s\n",
+              label, out.getErrStr().c_str());
+      nFail++;
+      break;
+    }
+    paths.push_back(out.getPathInUse());
+  }
+  in.closeSweepRead();
+
+  if (paths.size() != (size_t) nSweeps) {
+    fprintf(stderr, "FAIL - %s, expected %d sweep files, wrote %d\n",
+            label, nSweeps, (int) paths.size());
+    nFail++;
+  }
+  return paths;
+
+}
+
+/*
+ * Write the volume, test the sweep reads, then write sweep files.
+ * Returns the path of the volume file.
+ */
+
+static string _testFormat(const char *label,
+                          RadxFile::file_format_t format,
+                          const RadxVol &vol, const string &dir,
+                          vector<string> &sweepPaths)
+{
+
+  RadxFile file;
+  file.setFileFormat(format);
+  string volDir = dir + "/" + label;
+  if (file.writeToDir(vol, volDir, false, false)) {
+    fprintf(stderr, "FAIL - %s, cannot write volume: %s\n",
+            label, file.getErrStr().c_str());
+    nFail++;
+    return "";
+  }
+  string path = file.getPathInUse();
+
+  _testSweepRead(label, path, false);
+  _testSweepRead(label, path, true);
+
+  sweepPaths = _writeSweeps(label, format, path, volDir + "_sweeps");
+  return path;
+
+}
+
+/* ======================================================================== */
+
+/*
+ * main program
+ */
+
+int main(int argc, char *argv[])
+{
+
+  char tmpDir[] = "/tmp/RadxFileSweepRead-test.XXXXXX";
+  if (mkdtemp(tmpDir) == NULL) {
+    fprintf(stderr, "FAIL - cannot create temporary dir\n");
+    return 1;
+  }
+  string dir(tmpDir);
+
+  RadxVol vol;
+  _makeVol(vol);
+
+  // CfRadial - incremental reader
+
+  vector<string> cfSweepPaths;
+  string cfPath = _testFormat("cfradial", RadxFile::FILE_FORMAT_CFRADIAL,
+                              vol, dir, cfSweepPaths);
+
+  // UF - generic reader
+
+  vector<string> ufSweepPaths;
+  _testFormat("uf", RadxFile::FILE_FORMAT_UF, vol, dir, ufSweepPaths);
+
+  // each UF sweep file must hold the matching sweep
+
+  RadxVol cfVol;
+  RadxFile cfFile;
+  if (cfPath.size() > 0 && cfFile.readFromPath(cfPath, cfVol) == 0) {
+    for (size_t ii = 0; ii < ufSweepPaths.size(); ii++) {
+      RadxFile ufFile;
+      RadxVol ufVol;
+      if (ufFile.readFromPath(ufSweepPaths[ii], ufVol)) {
+        fprintf(stderr, "FAIL - uf, cannot read sweep file: %s\n",
+                ufFile.getErrStr().c_str());
+        nFail++;
+        continue;
+      }
+      if (ufVol.getNSweeps() != 1 ||
+          ufVol.getNRays() != cfVol.getSweeps()[ii]->getNRays()) {
+        fprintf(stderr, "FAIL - uf, wrong sweep file contents: %s\n",
+                ufSweepPaths[ii].c_str());
+        nFail++;
+      }
+    }
+  }
+
+  // CfRadial sweep files are aggregated back into the volume
+
+  if (cfSweepPaths.size() > 0 && cfVol.getNSweeps() > 0) {
+    RadxFile aggFile;
+    aggFile.setReadAggregateSweeps(true);
+    RadxVol aggVol;
+    if (aggFile.readFromPath(cfSweepPaths[0], aggVol)) {
+      fprintf(stderr, "FAIL - cannot read aggregated sweeps: %s\n",
+              aggFile.getErrStr().c_str());
+      nFail++;
+    } else if (aggVol.getNSweeps() != cfVol.getNSweeps()) {
+      fprintf(stderr, "FAIL - expected %d aggregated sweeps, got %d\n",
+              (int) cfVol.getNSweeps(), (int) aggVol.getNSweeps());
+      nFail++;
+    } else {
+      for (size_t ii = 0; ii < cfVol.getNSweeps(); ii++) {
+        RadxVol sweepVol;
+        sweepVol.copy(aggVol, aggVol.getSweeps()[ii]->getSweepNumber());
+        _compareSweep("aggregated", cfVol, ii, sweepVol);
+      }
+    }
+  }
+
+  string cmd = "rm -rf " + dir;
+  if (system(cmd.c_str())) {
+    fprintf(stderr, "WARNING - cannot remove %s\n", dir.c_str());
+  }
+
+  if (nFail > 0) {
+    fprintf(stderr, "RadxFileSweepRead-test: %d failures\n", nFail);
+    return 1;
+  }
+  return 0;
+
+}
@@ -0,0 +1,466 @@
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* 
+// ** Copyright UCAR (c) 1990 - 2016                                         
+// ** University Corporation for Atmospheric Research (UCAR)                 
+// ** National Center for Atmospheric Research (NCAR)                        
+// ** Boulder, Colorado, USA                                                 
+// ** BSD licence applies - redistribution and use in source and binary      
+// ** forms, with or without modification, are permitted provided that       
+// ** the following conditions are met:                                      
+// ** 1) If the software is modified to produce derivative works,            
+// ** such modified software should be clearly marked, so as not             
+// ** to confuse it with the version available from UCAR.                    
+// ** 2) Redistributions of source code must retain the above copyright      
+// ** notice, this list of conditions and the following disclaimer.          
+// ** 3) Redistributions in binary form must reproduce the above copyright   
+// ** notice, this list of conditions and the following disclaimer in the    
+// ** documentation and/or other materials provided with the distribution.   
+// ** 4) Neither the name of UCAR nor the names of its contributors,         
+// ** if any, may be used to endorse or promote products derived from        
+// ** this software without specific prior written permission.               
+// ** DISCLAIMER: THIS SOFTWARE IS PROVIDED "AS IS" AND WITHOUT ANY EXPRESS  
+// ** OR IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED      
+// ** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.    
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* 
+/*
+ * Name: TEST_RadxVolShm.cc
+ *
+ * Purpose:
+ *
+ *      To test handing off a RadxVol in shared memory with RadxVolShm.
+ *
+ *      Volumes with ray fields, and with the fields loaded into the
+ *      volume, are published and attached, and must match the
+ *      original - metadata, field data and the gates in each ray.
+ *
+ *      The claims must be released by detach(), and by attach() if it
+ *      fails on a complete segment, so that the segment is removed by
+ *      the last consumer. Attaching to a missing or incomplete segment
+ *      must fail, and an incomplete segment must be left alone.
+ *
+ * Usage:
+ *
+ *       % RadxVolShm-test
+ *
+ * Inputs:
+ *
+ *       None
+ *
+ * Returns 0 on success, 1 on failure.
+ * Prints nothing on success.
+ *
+ */
+
+/*
+ * include files
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <Radx/RadxVolShm.hh>
+#include <Radx/RadxVol.hh>
+#include <Radx/RadxRay.hh>
+#include <Radx/RadxField.hh>
+#include <Radx/RadxSweep.hh>
+#include <Radx/RadxTime.hh>
+using namespace std;
+
+static int nFail = 0;
+static string prefix;
+
+/*
+ * Segment name, unique to this process
+ */
+
+static string _name(const char *label)
+{
+  return prefix + label;
+}
+
+/*
+ * Does a segment exist?
+ */
+
+static bool _exists(const string &name)
+{
+  int fd = shm_open(("/" + name).c_str(), O_RDONLY, 0);
+  if (fd < 0) {
+    return false;
+  }
+  close(fd);
+  return true;
+}
+
+/*
+ * Create a volume with two sweeps, in which the number of gates
+ * varies from ray to ray
+ */
+
+static void _makeVol(RadxVol &vol)
+{
+
+  vol.clear();
+  vol.setTitle("RadxVolShm-test");
+  vol.setInstrumentName("TEST");
+  vol.setLatitudeDeg(40.0);
+  vol.setLongitudeDeg(-105.0);
+  vol.setAltitudeKm(1.6);
+  vol.setVolumeNumber(7);
+
+  RadxTime startTime(2020, 6, 15, 12, 0, 0);
+  for (int isweep = 0; isweep < 2; isweep++) {
+    for (int iray = 0; iray < 36; iray++) {
+      RadxRay *ray = new RadxRay;
+      ray->setVolumeNumber(7);
+      ray->setSweepNumber(isweep);
+      ray->setSweepMode(Radx::SWEEP_MODE_AZIMUTH_SURVEILLANCE);
+      ray->setTime(startTime.utime() + isweep * 20 + iray / 2, 0.0);
+      ray->setAzimuthDeg(iray * 10.0);
+      ray->setElevationDeg(0.5 + isweep);
+      ray->setFixedAngleDeg(0.5 + isweep);
+      ray->setRangeGeom(0.5, 0.25);
+      int nGates = 100 + (iray * 7 + isweep * 3) % 50;
+      vector<Radx::fl32> dbz(nGates);
+      vector<Radx::si16> vel(nGates);
+      for (int igate = 0; igate < nGates; igate++) {
+        dbz[igate] = -10.0 + ((igate * 7 + iray * 3 + isweep) % 600) * 0.1;
+        vel[igate] = (igate * 13 + iray * 11 + isweep * 5) % 4000 - 2000;
+      }
+      ray->addField("DBZ", "dBZ", nGates, Radx::missingFl32,
+                    dbz.data(), true);
+      ray->addField("VEL", "m/s", nGates, Radx::missingSi16,
+                    vel.data(), 0.01, 0.0, true);
+      vol.addRay(ray);
+    }
+  }
+  vol.loadVolumeInfoFromRays();
+  vol.loadSweepInfoFromRays();
+
+}
+
+/*
+ * Compare two fields - data and packing
+ */
+
+static bool _fieldsMatch(const RadxField *f1, const RadxField *f2)
+{
+  if (f1 == NULL || f2 == NULL) {
+    return false;
+  }
+  if (f1->getName() != f2->getName() ||
+      f1->getDataType() != f2->getDataType() ||
+      f1->getNPoints() != f2->getNPoints() ||
+      f1->getRayNGates() != f2->getRayNGates() ||
+      f1->getRayStartIndex() != f2->getRayStartIndex() ||
+      f1->getScale() != f2->getScale()) {
+    return false;
+  }
+  return (memcmp(f1->getData(), f2->getData(),
+                 f1->getNPoints() * f1->getByteWidth()) == 0);
+}
+
+/*
+ * Compare two volumes
+ */
+
+static void _compareVols(const char *label,
+                         const RadxVol &expected, const RadxVol &actual)
+{
+
+  if (actual.getTitle() != expected.getTitle() ||
+      actual.getVolumeNumber() != expected.getVolumeNumber() ||
+      actual.getNSweeps() != expected.getNSweeps() ||
+      actual.getNRays() != expected.getNRays()) {
+    fprintf(stderr, "FAIL - %s, volume metadata differs\n", label);
+    nFail++;
+    return;
+  }
+
+  const vector<RadxRay *> &expRays = expected.getRays();
+  const vector<RadxRay *> &rays = actual.getRays();
+  for (size_t iray = 0; iray < rays.size(); iray++) {
+    if (rays[iray]->getAzimuthDeg() != expRays[iray]->getAzimuthDeg() ||
+        rays[iray]->getNGates() != expRays[iray]->getNGates()) {
+      fprintf(stderr, "FAIL - %s, ray %d metadata differs\n",
+              label, (int) iray);
+      nFail++;
+      return;
+    }
+    const vector<RadxField *> expFields = expRays[iray]->getFields();
+    for (size_t ifield = 0; ifield < expFields.size(); ifield++) {
+      const RadxField *expFld = expFields[ifield];
+      if (!_fieldsMatch(expFld,
+                        rays[iray]->getField(expFld->getName()))) {
+        fprintf(stderr, "FAIL - %s, ray %d, field %s differs\n",
+                label, (int) iray, expFld->getName().c_str());
+        nFail++;
+        return;
+      }
+    }
+  }
+
+  const vector<RadxField *> expFields = expected.getFields();
+  const vector<RadxField *> fields = actual.getFields();
+  if (fields.size() != expFields.size()) {
+    fprintf(stderr, "FAIL - %s, expected %d volume fields, got %d\n",
+            label, (int) expFields.size(), (int) fields.size());
+    nFail++;
+    return;
+  }
+  for (size_t ifield = 0; ifield < expFields.size(); ifield++) {
+    if (!_fieldsMatch(expFields[ifield], fields[ifield])) {
+      fprintf(stderr, "FAIL - %s, volume field %s differs\n",
+              label, expFields[ifield]->getName().c_str());
+      nFail++;
+      return;
+    }
+  }
+
+}
+
+/*
+ * Publish and attach, with ray fields or volume fields
+ */
+
+static void _testRoundTrip(const char *label, bool volFields)
+{
+
+  RadxVol vol;
+  _makeVol(vol);
+  if (volFields) {
+    vol.loadFieldsFromRays();
+  }
+
+  string name = _name(label);
+  RadxVolShm producer;
+  if (producer.publish(name, vol, 2)) {
+    fprintf(stderr, "FAIL - %s, publish: %s\n",
+            label, producer.getErrStr().c_str());
+    nFail++;
+    return;
+  }
+
+  RadxVolShm consumer1, consumer2;
+  RadxVol vol1, vol2;
+  if (consumer1.attach(name, vol1) || consumer2.attach(name, vol2)) {
+    fprintf(stderr, "FAIL - %s, attach: %s%s\n", label,
+            consumer1.getErrStr().c_str(), consumer2.getErrStr().c_str());
+    nFail++;
+    RadxVolShm::remove(name);
+    return;
+  }
+  _compareVols(label, vol, vol1);
+
+  // a change by one consumer is not seen by the other
+
+  RadxField *fld1 = vol1.getRays()[0]->getField("DBZ");
+  RadxField *fld2 = vol2.getRays()[0]->getField("DBZ");
+  if (fld1 == NULL || fld2 == NULL) {
+    fprintf(stderr, "FAIL - %s, no DBZ field\n", label);
+    nFail++;
+  } else {
+    Radx::fl32 orig = fld2->getDataFl32()[0];
+    ((Radx::fl32 *) fld1->getData())[0] = orig + 1.0;
+    if (fld2->getDataFl32()[0] != orig) {
+      fprintf(stderr, "FAIL - %s, change seen by other consumer\n", label);
+      nFail++;
+    }
+  }
+
+  // the segment is removed when the last claim is released
+
+  vol1.clear();
+  consumer1.detach();
+  if (!_exists(name)) {
+    fprintf(stderr, "FAIL - %s, segment removed before last detach\n",
+            label);
+    nFail++;
+  }
+  _compareVols(label, vol, vol2);
+  vol2.clear();
+  consumer2.detach();
+  if (_exists(name)) {
+    fprintf(stderr, "FAIL - %s, segment not removed after last detach\n",
+            label);
+    nFail++;
+    RadxVolShm::remove(name);
+  }
+
+}
+
+/*
+ * A failed attach on a complete segment releases the claim
+ */
+
+static void _testBadSegment()
+{
+
+  RadxVol vol;
+  _makeVol(vol);
+  string name = _name("bad");
+  RadxVolShm producer;
+  if (producer.publish(name, vol, 1)) {
+    fprintf(stderr, "FAIL - bad segment, publish: %s\n",
+            producer.getErrStr().c_str());
+    nFail++;
+    return;
+  }
+
+  // grow the segment, so that its length does not match the header
+
+  int fd = shm_open(("/" + name).c_str(), O_RDWR, 0);
+  struct stat fileStat;
+  if (fd < 0 || fstat(fd, &fileStat) ||
+      ftruncate(fd, fileStat.st_size + 4096)) {
+    fprintf(stderr, "FAIL - bad segment, cannot resize\n");
+    nFail++;
+    if (fd >= 0) {
+      close(fd);
+    }
+    RadxVolShm::remove(name);
+    return;
+  }
+  close(fd);
+
+  RadxVolShm consumer;
+  RadxVol cvol;
+  if (consumer.attach(name, cvol) == 0) {
+    fprintf(stderr, "FAIL - bad segment, attach succeeded\n");
+    nFail++;
+  }
+  if (consumer.isAttached()) {
+    fprintf(stderr, "FAIL - bad segment, still attached\n");
+    nFail++;
+  }
+  if (_exists(name)) {
+    fprintf(stderr, "FAIL - bad segment, claim not released\n");
+    nFail++;
+    RadxVolShm::remove(name);
+  }
+
+}
+
+/*
+ * Attach to missing and incomplete segments
+ */
+
+static void _testMissingAndIncomplete()
+{
+
+  RadxVolShm consumer;
+  RadxVol vol;
+
+  string missing = _name("missing");
+  if (consumer.attach(missing, vol) == 0 || consumer.isAttached()) {
+    fprintf(stderr, "FAIL - attach to missing segment succeeded\n");
+    nFail++;
+  }
+
+  // a segment with no magic, as while the producer is loading it
+
+  string incomplete = _name("incomplete");
+  int fd = shm_open(("/" + incomplete).c_str(),
+                    O_CREAT | O_EXCL | O_RDWR, 0666);
+  if (fd < 0 || ftruncate(fd, 4096)) {
+    fprintf(stderr, "FAIL - cannot create incomplete segment\n");
+    nFail++;
+    if (fd >= 0) {
+      close(fd);
+    }
+    RadxVolShm::remove(incomplete);
+    return;
+  }
+  close(fd);
+
+  if (consumer.attach(incomplete, vol) == 0 || consumer.isAttached()) {
+    fprintf(stderr, "FAIL - attach to incomplete segment succeeded\n");
+    nFail++;
+  }
+  if (!_exists(incomplete)) {
+    fprintf(stderr, "FAIL - incomplete segment was removed\n");
+    nFail++;
+  }
+  if (RadxVolShm::remove(incomplete)) {
+    fprintf(stderr, "FAIL - cannot remove incomplete segment\n");
+    nFail++;
+  }
+
+  // a segment too short to hold the header
+
+  string tiny = _name("tiny");
+  fd = shm_open(("/" + tiny).c_str(), O_CREAT | O_EXCL | O_RDWR, 0666);
+  if (fd >= 0) {
+    close(fd);
+    if (consumer.attach(tiny, vol) == 0 || consumer.isAttached()) {
+      fprintf(stderr, "FAIL - attach to empty segment succeeded\n");
+      nFail++;
+    }
+    RadxVolShm::remove(tiny);
+  }
+
+}
+
+/*
+ * The producer removes its oldest segments
+ */
+
+static void _testMaxPublished()
+{
+
+  RadxVol vol;
+  _makeVol(vol);
+  RadxVolShm producer;
+  producer.setMaxPublished(2);
+  vector<string> names;
+  for (int ii = 0; ii < 3; ii++) {
+    char label[32];
+    snprintf(label, sizeof(label), "max%d", ii);
+    names.push_back(_name(label));
+    if (producer.publish(names[ii], vol, 0)) {
+      fprintf(stderr, "FAIL - max published, publish: %s\n",
+              producer.getErrStr().c_str());
+      nFail++;
+    }
+  }
+  if (_exists(names[0]) || !_exists(names[1]) || !_exists(names[2])) {
+    fprintf(stderr, "FAIL - max published, wrong segments removed\n");
+    nFail++;
+  }
+  for (size_t ii = 0; ii < names.size(); ii++) {
+    RadxVolShm::remove(names[ii]);
+  }
+
+}
+
+/* ======================================================================== */
+
+/*
+ * main program
+ */
+
+int main(int argc, char *argv[])
+{
+
+  char text[64];
+  snprintf(text, sizeof(text), "RadxVolShm-test-%d-", (int) getpid());
+  prefix = text;
+
+  _testRoundTrip("rayFields", false);
+  _testRoundTrip("volFields", true);
+  _testBadSegment();
+  _testMissingAndIncomplete();
+  _testMaxPublished();
+
+  if (nFail > 0) {
+    fprintf(stderr, "RadxVolShm-test: %d failures\n", nFail);
+    return 1;
+  }
+  return 0;
+
+}
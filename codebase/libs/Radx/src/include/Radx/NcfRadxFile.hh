@@ -172,6 +172,23 @@ public:
   virtual int readFromPath(const string &path,
                            RadxVol &vol);
 
+  /// Open file for reading one sweep at a time.
+  /// Returns 0 on success, -1 on failure
+  /// Use getErrStr() if error occurs
+  
+  virtual int openSweepRead(const string &path);
+
+  /// Read next sweep into volume.
+  /// gotSweep is false when there are no more sweeps.
+  /// Returns 0 on success, -1 on failure
+  /// Use getErrStr() if error occurs
+  
+  virtual int readNextSweep(RadxVol &vol, bool &gotSweep);
+
+  /// Close sweep reads
+  
+  virtual void closeSweepRead();
+
   //@}
 
   ////////////////////////
@@ -222,6 +239,10 @@ private:
   typedef char String8_t[NCF_STRING_LEN_8];
   typedef char String32_t[NCF_STRING_LEN_32];
 
+  // max size of chunk for field variables, NetCDF4
+
+  static const size_t _maxChunkBytes = 4 * 1024 * 1024;
+
   // volume for writing
   
   const RadxVol *_writeVol; ///< volume from which data is written
@@ -516,6 +537,7 @@ private:
   vector<RadxSweep *> _sweepsInFile;
   vector<SweepInfo> _sweepsOrig;
   vector<SweepInfo> _sweepsToRead;
+  vector<SweepInfo> _sweepReadList; // for readNextSweep()
 
   // storing ray information for reading from file
 
@@ -526,6 +548,14 @@ private:
   };
   vector<RayInfo> _raysToRead;
 
+  // hyperslab of the field data covering _raysToRead
+
+  size_t _readRayStart;   // first ray
+  size_t _readNRays;      // number of rays
+  size_t _readNGates;     // number of gates, constant ngates case
+  size_t _readPointStart; // first point, variable ngates case
+  size_t _readNPoints;    // number of points, variable ngates case
+
   // ray meta data arrays
 
   vector<double> _rayAzimuths;
@@ -647,6 +677,9 @@ private:
   int _readFrequencyVariable();
   void _readRayGateGeom();
   int _readRayNgatesAndOffsets();
+  void _computeReadHyperslab();
+  size_t _setReadHyperslab(Nc3Var *var, bool isQualifier,
+                           long &count0, long &count1);
   int _readCalibrationVariables();
   int _readCal(RadxRcalib &cal, int index);
 
@@ -766,6 +799,7 @@ private:
   int _closeOnError(const string &caller);
 
   int _setCompression(Nc3Var *var);
+  void _setChunking(Nc3Var *var);
   void _computeFixedAngles();
 
   Radx::fl64 _checkMissingDouble(double val);
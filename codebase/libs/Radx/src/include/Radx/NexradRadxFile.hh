@@ -95,6 +95,13 @@ public:
   
   bool isBzipped() const { return _isBzipped; }
     
+  /// Set the number of threads used to uncompress the
+  /// bzip2 records in LDM-style files.
+  /// Default is the number of processors, up to 8.
+  /// If n is 1, the records are uncompressed serially.
+
+  void setNUnzipThreads(int n);
+    
   //////////////////////////////////////////////////////////////
   /// \name Perform writing:
   //@{
@@ -147,6 +154,24 @@ public:
   virtual int readFromPath(const string &path,
                            RadxVol &vol);
 
+  /// Open file for reading one sweep at a time.
+  /// Returns 0 on success, -1 on failure
+  /// Use getErrStr() if error occurs
+  
+  virtual int openSweepRead(const string &path);
+
+  /// Read next sweep into volume.
+  /// Split cuts are combined unless preserving sweeps.
+  /// gotSweep is false when there are no more sweeps.
+  /// Returns 0 on success, -1 on failure
+  /// Use getErrStr() if error occurs
+  
+  virtual int readNextSweep(RadxVol &vol, bool &gotSweep);
+
+  /// Close sweep reads
+  
+  virtual void closeSweepRead();
+
   //@}
 
   ////////////////////////
@@ -196,7 +221,17 @@ protected:
   
   FILE *_file;
   bool _isBzipped;
-  string _tmpPath;
+  int _nUnzipThreads;
+
+  // uncompressed LDM volume, read through _file via fmemopen()
+
+  RadxBuf _uncompBuf;
+  string _origFormat;
+
+  // reading one sweep at a time
+
+  RadxRay *_sweepReadNextRay; // read ahead, start of next sweep
+  bool _sweepReadEof;
 
   // times
 
@@ -292,6 +327,11 @@ protected:
   
   // read methods
 
+  int _readTitle();
+  int _readNextRay(RadxRay* &ray);
+  bool _acceptRay(RadxRay *ray);
+  int _processReadVolume();
+
   RadxRay *_handleMessageType31(const RadxBuf &msgBuf);
   RadxRay *_handleMessageType1(const RadxBuf &msgBuf);
 
@@ -416,7 +456,6 @@ protected:
   void _setPrtIndexes(double prtSec);
   
   int _unzipFile(const string &path);
-  void _removeTmpFiles();
   
   void _loadSignedData(const vector<Radx::ui08> &udata,
                        vector<Radx::si08> &sdata,
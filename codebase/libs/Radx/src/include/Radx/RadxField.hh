@@ -1078,13 +1078,18 @@ public:
   //@{
 
   // serialize into a RadxMsg
+  // If includeData is false, the data part is left out,
+  // and the data must be attached after deserializing.
   
-  void serialize(RadxMsg &msg);
+  void serialize(RadxMsg &msg, bool includeData = true);
   
   // deserialize from a RadxMsg
+  // If dataRequired is false, a message with no data part
+  // is accepted. The number of gates is set from the metadata
+  // but no data is attached - use setDataRemote() to attach it.
   // return 0 on success, -1 on failure
 
-  int deserialize(const RadxMsg &msg);
+  int deserialize(const RadxMsg &msg, bool dataRequired = true);
 
   //@}
 
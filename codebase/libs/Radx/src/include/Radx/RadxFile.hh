@@ -127,6 +127,14 @@ public:
     NETCDF4              ///< full netcdf 4 data model
   } netcdf_format_t;
 
+  /// chunking of field variables for CfRadial - NetCDF4 only
+  
+  typedef enum {
+    CHUNKING_DEFAULT, ///< chunk shape chosen by the NetCDF library
+    CHUNKING_SWEEP,   ///< max rays in a sweep, by all gates
+    CHUNKING_N_RAYS   ///< specified number of rays, by all gates
+  } chunking_mode_t;
+
   /// file naming by time
 
   typedef enum {
@@ -268,6 +276,40 @@ public:
     _compressionLevel = level;
   }
   
+  /// Set the chunk shape for compressed field variables.
+  ///
+  /// This applies only to NetCDF4 CfRadial files.
+  ///
+  /// CHUNKING_SWEEP: each chunk holds the max number of rays in
+  /// any sweep by all gates, so that reading a sweep decompresses
+  /// little data beyond that sweep.
+  ///
+  /// CHUNKING_N_RAYS: each chunk holds nRays rays by all gates.
+  ///
+  /// CHUNKING_DEFAULT: the NetCDF library chooses the chunk shape.
+  ///
+  /// In all but the default mode, chunks are limited to about 4 MB,
+  /// by reducing the number of rays if needed.
+  ///
+  /// The default is CHUNKING_SWEEP.
+
+  void setWriteChunking(chunking_mode_t mode, int nRays = 0) {
+    _writeChunkingMode = mode;
+    _writeChunkNRays = nRays;
+  }
+  
+  /// Set the shuffle filter on compressed field variables.
+  ///
+  /// This applies only to NetCDF4 CfRadial files, and only to
+  /// integer-packed fields. Shuffling the bytes before deflating
+  /// generally gives better compression at little cost.
+  ///
+  /// The default is true.
+
+  void setWriteShuffle(bool state) {
+    _writeShuffle = state;
+  }
+  
   /// Set to write latest_data_info on write
   
   void setWriteLdataInfo(bool state) {
@@ -816,6 +858,70 @@ public:
 
   //@}
 
+  //////////////////////////////////////////////////////////////
+  /// \name Reading and writing one sweep at a time:
+  //@{
+  
+  /// Open a file for reading one sweep at a time.
+  ///
+  /// This is an alternative to readFromPath() for applications
+  /// which process the data sweep by sweep, and do not need the
+  /// whole volume in memory at once. After opening, call
+  /// readNextSweep() until gotSweep is returned as false,
+  /// then call closeSweepRead().
+  ///
+  /// The read directives - fields, fixed angle and sweep number
+  /// limits, etc. - apply as for readFromPath(), except that
+  /// angle and sweep number limits are always applied strictly.
+  ///
+  /// CfRadial and NEXRAD files are read incrementally. Other
+  /// formats do not have an incremental reader, so the whole volume
+  /// is read by openSweepRead(), and the sweeps are copied from it.
+  /// For those formats there is no memory saving over readFromPath().
+  ///
+  /// Returns 0 on success, -1 on failure.
+  /// Use getErrStr() if error occurs.
+  
+  virtual int openSweepRead(const string &path);
+
+  /// Read the next sweep from the file opened by openSweepRead().
+  ///
+  /// On success, vol holds the volume metadata and the rays for
+  /// one sweep, and gotSweep is set to true. When there are no
+  /// more sweeps, gotSweep is set to false.
+  ///
+  /// NEXRAD split cuts are returned as a single sweep, unless
+  /// setReadPreserveSweeps(true) has been called.
+  ///
+  /// Returns 0 on success, -1 on failure.
+  /// Use getErrStr() if error occurs.
+  
+  virtual int readNextSweep(RadxVol &vol, bool &gotSweep);
+
+  /// Close the file opened by openSweepRead().
+  
+  virtual void closeSweepRead();
+
+  /// Write a volume containing a single sweep, as returned by
+  /// readNextSweep(), to the specified directory.
+  ///
+  /// This is the incremental counterpart of readNextSweep().
+  /// For CfRadial, each sweep is written to its own file, as for
+  /// setWriteIndividualSweeps(true), so that downstream apps can
+  /// start on a sweep as soon as it is written. The volume can be
+  /// reassembled on read using setReadAggregateSweeps(true).
+  /// Other formats write one file per call.
+  ///
+  /// Returns 0 on success, -1 on failure.
+  /// Use getErrStr() if error occurs.
+  
+  int writeSweepToDir(const RadxVol &vol,
+                      const string &dir,
+                      bool addDaySubDir,
+                      bool addYearSubDir);
+
+  //@}
+
   ////////////////////////
   /// \name Error string:
   //@{
@@ -977,6 +1083,9 @@ protected:
   bool _writeIndividualSweeps; ///< write individual sweeps, if applicable
   bool _writeCompressed; ///< write out compressed? CfRadial only
   int _compressionLevel; ///< write compression level
+  chunking_mode_t _writeChunkingMode; ///< chunking for NetCDF4
+  int _writeChunkNRays; ///< rays per chunk for CHUNKING_N_RAYS
+  bool _writeShuffle; ///< shuffle filter for integer fields, NetCDF4
   bool _writeLdataInfo; ///< write latest_data_info on write
   
   ///< Use 'proposed_standard_name' instead of 'standard_name' in CfRadial files
@@ -994,6 +1103,15 @@ protected:
   vector<string> _writePaths; ///< list of file paths for writes
   vector<time_t> _writeDataTimes; ///< list of data times for writes
 
+  // reading one sweep at a time
+
+  bool _sweepReadOpen; ///< openSweepRead() has succeeded
+  string _sweepReadPath; ///< path opened for sweep reads
+  size_t _sweepReadIndex; ///< index of next sweep to be read
+  vector<int> _sweepReadNums; ///< sweep numbers, for generic sweep reads
+  RadxVol *_sweepReadVol; ///< volume read on open, for generic sweep reads
+  RadxFile *_sweepReadFile; ///< format-specific object for sweep reads
+
   /// volume for reading
 
   RadxVol *_readVol; ///< volume to which data is read in
@@ -1017,6 +1135,10 @@ protected:
 
   int _readFromPathOther(const string &path, RadxVol &vol);
   
+  /// open for sweep reads, for formats without an incremental reader
+
+  int _openSweepReadGeneric(const string &path);
+
   /// add integer value to error string, with label
 
   void _addErrInt(string label, int iarg,
@@ -1866,13 +1866,17 @@ public:
   //@{
 
   // serialize into a RadxMsg
+  // If includeFieldData is false, the field data is left out.
+  // See RadxField::serialize().
   
-  void serialize(RadxMsg &msg);
+  void serialize(RadxMsg &msg, bool includeFieldData = true);
   
   // deserialize from a RadxMsg
+  // If fieldDataRequired is false, fields without data are accepted.
+  // See RadxField::deserialize().
   // return 0 on success, -1 on failure
 
-  int deserialize(const RadxMsg &msg);
+  int deserialize(const RadxMsg &msg, bool fieldDataRequired = true);
 
   //@}
   
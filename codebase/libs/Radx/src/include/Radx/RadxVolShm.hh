@@ -0,0 +1,209 @@
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* 
+// ** Copyright UCAR (c) 1990 - 2016                                         
+// ** University Corporation for Atmospheric Research (UCAR)                 
+// ** National Center for Atmospheric Research (NCAR)                        
+// ** Boulder, Colorado, USA                                                 
+// ** BSD licence applies - redistribution and use in source and binary      
+// ** forms, with or without modification, are permitted provided that       
+// ** the following conditions are met:                                      
+// ** 1) If the software is modified to produce derivative works,            
+// ** such modified software should be clearly marked, so as not             
+// ** to confuse it with the version available from UCAR.                    
+// ** 2) Redistributions of source code must retain the above copyright      
+// ** notice, this list of conditions and the following disclaimer.          
+// ** 3) Redistributions in binary form must reproduce the above copyright   
+// ** notice, this list of conditions and the following disclaimer in the    
+// ** documentation and/or other materials provided with the distribution.   
+// ** 4) Neither the name of UCAR nor the names of its contributors,         
+// ** if any, may be used to endorse or promote products derived from        
+// ** this software without specific prior written permission.               
+// ** DISCLAIMER: THIS SOFTWARE IS PROVIDED "AS IS" AND WITHOUT ANY EXPRESS  
+// ** OR IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED      
+// ** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.    
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* 
+////////////////////////////////////////////////////////////////////
+// RadxVolShm.hh
+//
+// Hand off a RadxVol between processes in shared memory.
+//
+////////////////////////////////////////////////////////////////////
+
+#ifndef RadxVolShm_HH
+#define RadxVolShm_HH
+
+#include <Radx/Radx.hh>
+#include <string>
+#include <deque>
+#include <vector>
+using namespace std;
+class RadxVol;
+class RadxField;
+
+///////////////////////////////////////////////////////////////////
+/// SHARED MEMORY VOLUME HANDOFF
+///
+/// A producer publishes a volume to a named POSIX shared memory
+/// segment. A consumer attaches to the segment, and the fields in
+/// its volume point directly at the data in the segment, so the
+/// field data is not copied or deserialized.
+///
+/// The segment holds the volume metadata, serialized as a RadxMsg
+/// without the field data, followed by a table of the field data
+/// locations, the number of gates in each ray of each field, and
+/// then the field data itself. The gates per ray are held separately
+/// since the serialized field metadata only has the total.
+///
+/// The consumer maps the segment copy-on-write, so it may modify
+/// the field data in place without affecting other consumers.
+/// Pages which are modified are copied by the kernel.
+///
+/// LIFETIME:
+///
+/// The producer sets the number of consumers expected for each
+/// volume. Each consumer releases its claim in detach(), and the
+/// segment is removed when the last claim is released. Existing
+/// mappings remain valid after removal. As a safeguard against
+/// consumers which never attach, the producer also removes its
+/// oldest segments once more than getMaxPublished() exist.
+///
+/// If attach() fails on a complete segment, the claim is released
+/// as in detach(). A segment which is not yet complete is left
+/// alone, since the producer has not finished setting the claims.
+///
+/// NOTIFICATION:
+///
+/// This class does not notify consumers. The producer should
+/// write a _latest_data_info file with the segment name as the
+/// relative data path - see RadxConvert and Radx2Grid.
+///
+/// NOTES ON USE:
+///
+/// The volume filled in by attach() must not be used after
+/// detach() is called, or after this object is destroyed,
+/// unless RadxVol::setDataLocal() is called first.
+
+class RadxVolShm {
+
+public:
+
+  /// Constructor
+  
+  RadxVolShm();
+
+  /// Destructor - detaches if attached
+
+  ~RadxVolShm();
+
+  /// Set debugging on
+
+  void setDebug(bool state) { _debug = state; }
+
+  /// Set the max number of segments held by the producer.
+  /// Default is 4.
+
+  void setMaxPublished(int val) { _maxPublished = val; }
+  int getMaxPublished() const { return _maxPublished; }
+
+  /// Publish a volume to a shared memory segment.
+  ///
+  /// name: segment name. A leading '/' is added if needed.
+  /// Any existing segment of the same name is replaced.
+  ///
+  /// nConsumers: number of consumers which will attach
+  /// to this volume. If 0, the segment is only removed
+  /// by the producer.
+  ///
+  /// Returns 0 on success, -1 on failure.
+
+  int publish(const string &name, RadxVol &vol, int nConsumers = 1);
+
+  /// Attach to a volume in a shared memory segment.
+  ///
+  /// On success, vol holds the volume, with the field data
+  /// in the segment. Any previous attachment is detached first.
+  /// On failure, this consumer's claim on the segment is released.
+  ///
+  /// Returns 0 on success, -1 on failure.
+
+  int attach(const string &name, RadxVol &vol);
+
+  /// Detach from the segment, releasing this consumer's claim.
+  /// Any volume filled in by attach() must be cleared before this
+  /// is called.
+
+  void detach();
+
+  /// Is a segment attached?
+
+  bool isAttached() const { return _shmAddr != NULL; }
+
+  /// Remove a segment by name.
+  /// Returns 0 on success, -1 on failure.
+
+  static int remove(const string &name);
+
+  /// Get the error string for the last failure.
+
+  const string &getErrStr() const { return _errStr; }
+
+private:
+
+  // segment header
+
+  typedef struct {
+    char magic[8];          // set last, once the segment is complete
+    Radx::si64 segLen;      // total length
+    Radx::si64 metaOffset;  // serialized RadxVol, without field data
+    Radx::si64 metaLen;
+    Radx::si64 tableOffset; // field_ref_t for each field
+    Radx::si64 nFields;
+    Radx::si32 nClaims;     // consumers which have not yet detached
+    Radx::si32 spareInt;
+    Radx::si64 spare[8];
+  } shm_hdr_t;
+
+  // location of the data for a field, and of the number of
+  // gates in each ray of the field
+
+  typedef struct {
+    Radx::si64 offset;        // field data
+    Radx::si64 nGates;        // total over all rays
+    Radx::si64 nBytes;
+    Radx::si64 nRays;
+    Radx::si64 packingOffset; // si64 nGates for each ray
+    Radx::si64 spare;
+  } field_ref_t;
+
+  static const char *_magic;
+  static const size_t _align = 64;
+
+  bool _debug;
+  string _errStr;
+
+  // producer
+
+  int _maxPublished;
+  deque<string> _published;
+
+  // consumer
+
+  string _shmName;
+  void *_shmAddr;   // private copy-on-write mapping of the segment
+  void *_hdrAddr;   // shared mapping of the header, for the claims
+  size_t _shmLen;
+
+  void _unmap();
+  static void _loadFieldList(RadxVol &vol, vector<RadxField *> &fields);
+  static string _fixName(const string &name);
+  static size_t _alignLen(size_t len) {
+    return ((len + _align - 1) / _align) * _align;
+  }
+
+  // no copying
+
+  RadxVolShm(const RadxVolShm &rhs);
+  RadxVolShm &operator=(const RadxVolShm &rhs);
+
+};
+
+#endif
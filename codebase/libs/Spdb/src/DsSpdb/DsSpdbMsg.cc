@@ -991,6 +991,7 @@ void DsSpdbMsg::compressDataBuf(Spdb::compression_t compression)
     uncompressDataBuf();
     return;
   }
+  compression = Spdb::checkCompressionAvailable(compression);
 
   Spdb::compression_t currentCompression = dataBufCompression();
   
@@ -1005,10 +1006,8 @@ void DsSpdbMsg::compressDataBuf(Spdb::compression_t compression)
   
   // determine toolsa compression method
   
-  ta_compression_method_t compress_method = TA_COMPRESSION_GZIP;
-  if (compression == Spdb::COMPRESSION_BZIP2) {
-    compress_method = TA_COMPRESSION_BZIP;
-  }
+  ta_compression_method_t compress_method =
+    Spdb::taCompressionMethod(compression);
   
   // compress
 
@@ -1201,6 +1200,10 @@ void DsSpdbMsg::print(ostream &out, const char *spacer) const
         out << spacer << "  Data buf compression: gzip" << endl;
       } else if (_info2.data_buf_compression == Spdb::COMPRESSION_BZIP2) {
         out << spacer << "  Data buf compression: bzip2" << endl;
+      } else if (_info2.data_buf_compression == Spdb::COMPRESSION_ZSTD) {
+        out << spacer << "  Data buf compression: zstd" << endl;
+      } else if (_info2.data_buf_compression == Spdb::COMPRESSION_LZ4) {
+        out << spacer << "  Data buf compression: lz4" << endl;
       }
       if (_horizLimitsSet) {
         out << spacer << "  Horiz limits:" << endl;
@@ -1237,6 +1240,10 @@ void DsSpdbMsg::print(ostream &out, const char *spacer) const
             out << spacer << "  Data buf compression: gzip" << endl;
           } else if (_info2.data_buf_compression == Spdb::COMPRESSION_BZIP2) {
             out << spacer << "  Data buf compression: bzip2" << endl;
+          } else if (_info2.data_buf_compression == Spdb::COMPRESSION_ZSTD) {
+            out << spacer << "  Data buf compression: zstd" << endl;
+          } else if (_info2.data_buf_compression == Spdb::COMPRESSION_LZ4) {
+            out << spacer << "  Data buf compression: lz4" << endl;
           }
           break;
         default:
@@ -37,6 +37,7 @@
 ////////////////////////////////////////////////////////////////
 
 #include <Spdb/Spdb.hh>
+#include <Spdb/SpdbDayCache.hh>
 #include <dataport/bigend.h>
 #include <toolsa/file_io.h>
 #include <toolsa/TaFile.hh>
@@ -55,6 +56,8 @@
 #include <fcntl.h>
 #include <cerrno>
 #include <sys/stat.h>
+#include <pthread.h>
+#include <cstdlib>
 #include <set>
 using namespace std;
 
@@ -81,6 +84,10 @@ Spdb::Spdb() :
         _checkWriteTimeOnGet(false),
         _latestValidWriteTime(0),
 
+        _mmapReads(false),
+        _readNThreads(1),
+        _cachedDay(NULL),
+
         _putMode(putModeOver),
         _nPutChunks(0),
         _latestValidTimePut(0),
@@ -112,6 +119,21 @@ Spdb::Spdb() :
   MEM_zero(_lockPath);
   MEM_zero(_hdr);
 
+  // options for reading via the day cache
+
+  char *SPDB_MMAP_READS = getenv("SPDB_MMAP_READS");
+  if (SPDB_MMAP_READS != NULL &&
+      !strcasecmp(SPDB_MMAP_READS, "true")) {
+    _mmapReads = true;
+  }
+  char *SPDB_READ_NTHREADS = getenv("SPDB_READ_NTHREADS");
+  if (SPDB_READ_NTHREADS != NULL) {
+    int nThreads;
+    if (sscanf(SPDB_READ_NTHREADS, "%d", &nThreads) == 1) {
+      setReadNThreads(nThreads);
+    }
+  }
+
 }
 
 ////////////////////////////////////////////////////////////
@@ -158,13 +180,27 @@ void Spdb::setLeadTimeStorage(lead_time_storage_t storage_type)
 //    Spdb::COMPRESSION_NONE
 //    Spdb::COMPRESSION_GZIP
 //    Spdb::COMPRESSION_BZIP2
+//    Spdb::COMPRESSION_ZSTD
+//    Spdb::COMPRESSION_LZ4
 // If set, chunks will be stored compressed and the
 // compression flag will be set in the auxiliary chunk header.
 // The default is COMPRESSION_NONE.
 
 void Spdb::setChunkCompressOnPut(compression_t compression)
 {
-  _chunkCompressOnPut = compression;
+  _chunkCompressOnPut = checkCompressionAvailable(compression);
+}
+
+////////////////////////////////////////////////////
+// Set number of threads for getInterval()
+
+void Spdb::setReadNThreads(int n_threads)
+{
+  if (n_threads < 1) {
+    _readNThreads = 1;
+  } else {
+    _readNThreads = n_threads;
+  }
 }
 
 ////////////////////////////////////////////////////
@@ -222,13 +258,8 @@ void Spdb::addPutChunk(int data_type,
   void *compressedBuf = NULL;
   ui64 nbytesCompressed = chunk_len;
   
-  if (_chunkCompressOnPut == COMPRESSION_GZIP) {
-    compressedBuf = ta_compress(TA_COMPRESSION_GZIP,
-                                chunk_data,
-                                chunk_len,
-                                &nbytesCompressed);
-  } else if (_chunkCompressOnPut == COMPRESSION_BZIP2) {
-    compressedBuf = ta_compress(TA_COMPRESSION_BZIP,
+  if (_chunkCompressOnPut != COMPRESSION_NONE) {
+    compressedBuf = ta_compress(taCompressionMethod(_chunkCompressOnPut),
                                 chunk_data,
                                 chunk_len,
                                 &nbytesCompressed);
@@ -1326,8 +1357,8 @@ int Spdb::_fetchExact(time_t request_time,
     return 0;
   }
   
-  chunk_ref_t *fileRefs = (chunk_ref_t *) _hdrRefBuf.getPtr();
-  aux_ref_t *fileAuxs = (aux_ref_t *) _hdrAuxBuf.getPtr();
+  const chunk_ref_t *fileRefs = _fileRefs();
+  const aux_ref_t *fileAuxs = _fileAuxs();
 
   MemBuf readBuf;
 
@@ -1604,60 +1635,42 @@ int Spdb::_getInterval(time_t start_time,
     _errStr += "ERROR - _getFirstAndLastTimes failed\n";
     return -1;
   }
-  time_t file_start_time = (start_time / SECS_IN_DAY) * SECS_IN_DAY;
 
-  
-  MemBuf readBuf;
+  // if reading via the day cache, with multiple threads,
+  // read the days concurrently
 
-  while (file_start_time <= time2) {
-    
-    // open files
+  bool done = false;
+  if (_mmapReads && _readNThreads > 1) {
+    if (_getIntervalThreaded(time1, time2,
+                             data_type, data_type2, done)) {
+      return -1;
+    }
+  }
+
+  if (!done) {
+
+    time_t file_start_time = (start_time / SECS_IN_DAY) * SECS_IN_DAY;
+    MemBuf readBuf;
     
-    if (_openFiles(0, "", file_start_time, ReadMode)) {
+    while (file_start_time <= time2) {
+      
+      if (_getIntervalDay(file_start_time, time1, time2,
+                          data_type, data_type2, readBuf)) {
+        return -1;
+      }
+      
+      // move ahead by 1 day
+      
       if (_emptyDay) {
-	file_start_time += SECS_IN_DAY;
-	continue;
+        file_start_time += SECS_IN_DAY;
       } else {
-	return -1;
+        file_start_time = (time_t) _hdr.start_of_day + SECS_IN_DAY;
       }
-    }
-    chunk_ref_t *fileRefs = (chunk_ref_t *) _hdrRefBuf.getPtr();
-    aux_ref_t *fileAuxs = (aux_ref_t *) _hdrAuxBuf.getPtr();
-    
-    // get the first indx posn at or after start time
-    
-    int posn = _firstPosnAfter(time1);
-
-    if (posn >= 0) {
+      time1 = file_start_time;
       
-      for (int i = posn; i < _hdr.n_chunks; i++) {
-	
-	if ((time_t) fileRefs[i].valid_time <= time2) {
-	  
-          if (_checkTypeThenReadChunk(data_type, data_type2,
-                                      fileRefs[i], fileAuxs[i],
-                                      readBuf)) {
-            _closeFiles();
-            return -1;
-          }
-
-	} else {
-	  
-	  break;
-	  
-	} // if (fileRefs[i].valid_time <= time2)
-	
-      } // i
+    } // while
 
-    } // if (posn >= 0)
-    _closeFiles();
-
-    // move ahead by 1 day
-    
-    file_start_time = (time_t) _hdr.start_of_day + SECS_IN_DAY;
-    time1 = file_start_time;
-
-  } // while
+  }
   
   if (_getUnique == UniqueLatest) {
     makeUniqueLatest();
@@ -1669,6 +1682,269 @@ int Spdb::_getInterval(time_t start_time,
 
 }
   
+///////////////////////////////////////////////////////////////////
+// _getIntervalDay()
+//
+// Get data in the time interval, from the files for a single day.
+// Adds to the get buffers.
+//
+// Returns 0 on success, -1 on failure.
+// If there are no files for the day, sets _emptyDay and returns 0.
+
+int Spdb::_getIntervalDay(time_t day_time,
+                          time_t time1,
+                          time_t time2,
+                          int data_type,
+                          int data_type2,
+                          MemBuf &readBuf)
+
+{
+
+  // open files
+  
+  if (_openFiles(0, "", day_time, ReadMode)) {
+    if (_emptyDay) {
+      return 0;
+    } else {
+      return -1;
+    }
+  }
+  const chunk_ref_t *fileRefs = _fileRefs();
+  const aux_ref_t *fileAuxs = _fileAuxs();
+  
+  // get the first indx posn at or after start time
+  
+  int posn = _firstPosnAfter(time1);
+  
+  if (posn >= 0) {
+    
+    for (int i = posn; i < _hdr.n_chunks; i++) {
+      
+      if ((time_t) fileRefs[i].valid_time <= time2) {
+        
+        if (_checkTypeThenReadChunk(data_type, data_type2,
+                                    fileRefs[i], fileAuxs[i],
+                                    readBuf)) {
+          _closeFiles();
+          return -1;
+        }
+        
+      } else {
+        
+        break;
+        
+      } // if (fileRefs[i].valid_time <= time2)
+      
+    } // i
+    
+  } // if (posn >= 0)
+
+  _closeFiles();
+  return 0;
+
+}
+
+// context shared by the threads in _getIntervalThreaded()
+
+namespace {
+  class GetIntervalContext {
+  public:
+    time_t time1;
+    time_t time2;
+    int data_type;
+    int data_type2;
+    vector<Spdb *> dayObjs;
+    vector<time_t> dayTimes;
+    vector<bool> failed;
+    size_t nextDay;
+    bool error;
+    pthread_mutex_t mutex;
+  };
+}
+
+///////////////////////////////////////////////////////////////////
+// _getIntervalThreaded()
+//
+// Get data in the time interval, reading the days concurrently.
+// Each day is read by a separate Spdb object, via the day cache.
+// The results are then added to the get buffers in time order.
+//
+// Sets done to false if the interval is within a single day,
+// in which case threads are not used.
+//
+// Returns 0 on success, -1 on failure.
+
+int Spdb::_getIntervalThreaded(time_t time1,
+                               time_t time2,
+                               int data_type,
+                               int data_type2,
+                               bool &done)
+
+{
+
+  done = false;
+  if (time2 < time1) {
+    return 0;
+  }
+  time_t firstDay = time1 / SECS_IN_DAY;
+  time_t lastDay = time2 / SECS_IN_DAY;
+  if (lastDay == firstDay) {
+    return 0;
+  }
+  done = true;
+
+  // set up an object for each day, with the same get options
+  
+  GetIntervalContext context;
+  context.time1 = time1;
+  context.time2 = time2;
+  context.data_type = data_type;
+  context.data_type2 = data_type2;
+  context.nextDay = 0;
+  context.error = false;
+  pthread_mutex_init(&context.mutex, NULL);
+
+  for (time_t iday = firstDay; iday <= lastDay; iday++) {
+    Spdb *dayObj = new Spdb;
+    dayObj->_dir = _dir;
+    dayObj->_appName = _appName;
+    dayObj->_getRefsOnly = _getRefsOnly;
+    dayObj->_respectZeroTypes = _respectZeroTypes;
+    dayObj->_checkWriteTimeOnGet = _checkWriteTimeOnGet;
+    dayObj->_latestValidWriteTime = _latestValidWriteTime;
+    dayObj->_chunkUncompressOnGet = _chunkUncompressOnGet;
+    dayObj->_mmapReads = true;
+    context.dayObjs.push_back(dayObj);
+    context.dayTimes.push_back(iday * SECS_IN_DAY);
+    context.failed.push_back(false);
+  }
+
+  // start the worker threads - the calling thread also does its share
+
+  size_t nThreads = _readNThreads;
+  if (nThreads > context.dayObjs.size()) {
+    nThreads = context.dayObjs.size();
+  }
+  vector<pthread_t> threads;
+  for (size_t i = 1; i < nThreads; i++) {
+    pthread_t thread;
+    if (pthread_create(&thread, NULL,
+                       _getIntervalThreadMain, (void *) &context)) {
+      // cannot create more threads, carry on with the ones we have
+      break;
+    }
+    threads.push_back(thread);
+  }
+  _getIntervalThreadMain((void *) &context);
+  for (size_t i = 0; i < threads.size(); i++) {
+    pthread_join(threads[i], NULL);
+  }
+  pthread_mutex_destroy(&context.mutex);
+
+  // add the results in time order
+
+  int iret = 0;
+  if (context.error) {
+    _errStr += "ERROR - Spdb::_getIntervalThreaded\n";
+    iret = -1;
+  }
+  
+  for (size_t ii = 0; ii < context.dayObjs.size(); ii++) {
+
+    Spdb *dayObj = context.dayObjs[ii];
+
+    if (context.failed[ii]) {
+      _errStr += dayObj->_errStr;
+    }
+
+    if (iret == 0 && !dayObj->_emptyDay) {
+
+      // header and product info as for the last day read
+
+      _hdr = dayObj->_hdr;
+      _prodId = dayObj->_prodId;
+      _prodLabel = dayObj->_prodLabel;
+      _leadTimeStorage = dayObj->_leadTimeStorage;
+
+      // the data offsets are relative to the start of the
+      // data buffer, so adjust for the data already added
+      
+      int nChunks = dayObj->_nGetChunks;
+      chunk_ref_t *refs = (chunk_ref_t *) dayObj->_getRefBuf.getPtr();
+      if (!_getRefsOnly) {
+        ui32 offset = _getDataBuf.getLen();
+        for (int jj = 0; jj < nChunks; jj++) {
+          refs[jj].offset += offset;
+        }
+      }
+      _getRefBuf.add(dayObj->_getRefBuf.getPtr(),
+                     dayObj->_getRefBuf.getLen());
+      _getAuxBuf.add(dayObj->_getAuxBuf.getPtr(),
+                     dayObj->_getAuxBuf.getLen());
+      _getDataBuf.add(dayObj->_getDataBuf.getPtr(),
+                      dayObj->_getDataBuf.getLen());
+      _storedCompression.insert(_storedCompression.end(),
+                                dayObj->_storedCompression.begin(),
+                                dayObj->_storedCompression.end());
+      _nGetChunks += nChunks;
+
+    }
+
+    delete dayObj;
+
+  } // ii
+
+  return iret;
+
+}
+
+//////////////////////////////////////////////////////////
+// Thread main for _getIntervalThreaded().
+// Takes the next unread day until all days are done,
+// or an error occurs.
+
+void *Spdb::_getIntervalThreadMain(void *args)
+  
+{
+
+  GetIntervalContext *context = (GetIntervalContext *) args;
+  MemBuf readBuf;
+
+  while (true) {
+
+    pthread_mutex_lock(&context->mutex);
+    if (context->error || context->nextDay >= context->dayObjs.size()) {
+      pthread_mutex_unlock(&context->mutex);
+      break;
+    }
+    size_t index = context->nextDay;
+    context->nextDay++;
+    pthread_mutex_unlock(&context->mutex);
+
+    // the start time applies to the first day only
+
+    time_t dayTime = context->dayTimes[index];
+    time_t time1 = dayTime;
+    if (index == 0) {
+      time1 = context->time1;
+    }
+
+    Spdb *dayObj = context->dayObjs[index];
+    if (dayObj->_getIntervalDay(dayTime, time1, context->time2,
+                                context->data_type, context->data_type2,
+                                readBuf)) {
+      pthread_mutex_lock(&context->mutex);
+      context->failed[index] = true;
+      context->error = true;
+      pthread_mutex_unlock(&context->mutex);
+    }
+
+  } // while
+
+  return NULL;
+
+}
+  
 ///////////////////////////////////////////////////////////////////
 // _getValid()
 //
@@ -1717,8 +1993,8 @@ int Spdb::_getValid(time_t request_time,
       }
     }
 
-    chunk_ref_t *fileRefs = (chunk_ref_t *) _hdrRefBuf.getPtr();
-    aux_ref_t *fileAuxs = (aux_ref_t *) _hdrAuxBuf.getPtr();
+    const chunk_ref_t *fileRefs = _fileRefs();
+    const aux_ref_t *fileAuxs = _fileAuxs();
 
     // get the first indx posn at or after start time
     
@@ -1854,8 +2130,8 @@ int Spdb::_compileTimeList(time_t start_time,
       iret = 0;
 
       time_t lastAdded = -1;
-      chunk_ref_t *ref = (chunk_ref_t *) _hdrRefBuf.getPtr();
-      aux_ref_t *aux = (aux_ref_t *) _hdrAuxBuf.getPtr();
+      const chunk_ref_t *ref = _fileRefs();
+      const aux_ref_t *aux = _fileAuxs();
       for (int i = 0; i < _hdr.n_chunks; i++, ref++, aux++) {
         if ((time_t) ref->valid_time >= start_time &&
 	    (time_t) ref->valid_time <= end_time) {
@@ -2100,6 +2376,19 @@ int Spdb::_openFiles(int prod_id,
                 vtime.year, vtime.month, vtime.day,
                 _dataExt);
 
+  // in read mode, use the day cache if possible
+
+  if (mode == ReadMode && _mmapReads) {
+    int iret = _openCached(prod_id);
+    if (iret < 0) {
+      return -1;
+    } else if (iret == 0) {
+      _openMode = mode;
+      _openDay = valid_time / SECS_IN_DAY;
+      return 0;
+    }
+  }
+
   // decide if files exist
   
   bool indx_file_exists = false;
@@ -2291,6 +2580,59 @@ int Spdb::_openReadWrite(int prod_id,
 
 }
 
+/////////////////////////////////////////////////////
+// _openCached()
+//
+// Open files in read mode via the day cache.
+// The header is copied from the cache, the chunk refs and
+// data are accessed in the cache.
+//
+// Returns 0 on success, -1 on failure, 1 if the files are not
+// available from the cache and must be opened normally.
+
+int Spdb::_openCached(int prod_id)
+     
+{
+
+  const SpdbCachedDay *day =
+    SpdbDayCache::inst().acquire(_indxPath, _dataPath);
+  if (day == NULL) {
+    return 1;
+  }
+
+  _hdr = day->getHdr();
+
+  // check that the ID is correct - if ID of 0 is passed in
+  // we accept any data ID
+  
+  if (prod_id > 0) {
+    if (_hdr.prod_id == 0) {
+      _hdr.prod_id = prod_id;
+    } else if (_hdr.prod_id != prod_id) {
+      _errStr += "ERROR - Spdb::_openCached\n";
+      _addStrErr("  Product: ", _hdr.prod_label);
+      _errStr += "  Incorrect indx file ID.\n";
+      _addIntErr("  ID found: ", _hdr.prod_id);
+      _addIntErr("  Should be: ", prod_id);
+      SpdbDayCache::inst().release(day);
+      return -1;
+    }
+  }
+  if (_hdr.prod_id != 0) {
+    _prodId = _hdr.prod_id;
+    _prodLabel = _hdr.prod_label;
+  }
+  if (_hdr.lead_time_storage != 0) {
+    _leadTimeStorage = (lead_time_storage_t) _hdr.lead_time_storage;
+  }
+
+  _cachedDay = day;
+  _filesOpen = true;
+
+  return 0;
+
+}
+
 /////////////////////////////////////////////////////
 // _openCreate()
 //
@@ -2435,6 +2777,14 @@ void Spdb::_closeFiles(bool sync /* = true*/ )
     return;
   }
 
+  if (_cachedDay != NULL) {
+    SpdbDayCache::inst().release(_cachedDay);
+    _cachedDay = NULL;
+    _filesOpen = false;
+    _openDay = 0;
+    return;
+  }
+
   if (sync && _openMode == WriteMode) {
     
     // defrag if necessary
@@ -2714,8 +3064,8 @@ int Spdb::printHeader(const string &dir,
       << endl;
   
 
-  chunk_ref_t *refs = (chunk_ref_t *) _hdrRefBuf.getPtr();
-  aux_ref_t *auxs = (aux_ref_t *) _hdrAuxBuf.getPtr();
+  const chunk_ref_t *refs = _fileRefs();
+  const aux_ref_t *auxs = _fileAuxs();
   for (int i = 0; i < _hdr.n_chunks; i++, refs++, auxs++) {
     out << setw(8) << i
 	<< setw(15) << refs->data_type
@@ -2730,6 +3080,10 @@ int Spdb::printHeader(const string &dir,
       out << setw(10) << "gzip";
     } else if (compress == COMPRESSION_BZIP2) {
       out << setw(10) << "bzip2";
+    } else if (compress == COMPRESSION_ZSTD) {
+      out << setw(10) << "zstd";
+    } else if (compress == COMPRESSION_LZ4) {
+      out << setw(10) << "lz4";
     }
     out << setw(8) << refs->len
         << " " << auxs->tag
@@ -2819,6 +3173,10 @@ void Spdb::printChunkRef(const chunk_ref_t *chunk_ref,
       out << "  compression: gzip" << endl;
     } else if (compress == COMPRESSION_BZIP2) {
       out << "  compression: bzip2" << endl;
+    } else if (compress == COMPRESSION_ZSTD) {
+      out << "  compression: zstd" << endl;
+    } else if (compress == COMPRESSION_LZ4) {
+      out << "  compression: lz4" << endl;
     }
     if (strlen(aux_ref->tag) != 0) {
       out << "  tag: " << aux_ref->tag << endl;
@@ -2851,6 +3209,10 @@ void Spdb::printChunk(const chunk_t &chunk, ostream &out)
     out << "  current_compression: gzip" << endl;
   } else if (chunk.current_compression == COMPRESSION_BZIP2) {
     out << "  current_compression: bzip2" << endl;
+  } else if (chunk.current_compression == COMPRESSION_ZSTD) {
+    out << "  current_compression: zstd" << endl;
+  } else if (chunk.current_compression == COMPRESSION_LZ4) {
+    out << "  current_compression: lz4" << endl;
   }
   if (chunk.tag.size() > 0) {
     out << "tag: " << chunk.tag << endl;
@@ -3047,7 +3409,7 @@ int Spdb::_firstPosnAfter(time_t start_time)
     return -1;
   }
   
-  chunk_ref_t *ref = (chunk_ref_t *) _hdrRefBuf.getPtr() + start_posn;
+  const chunk_ref_t *ref = _fileRefs() + start_posn;
 
   for (int i = start_posn; i < _hdr.n_chunks; i++, ref++) {
     if ((time_t) ref->valid_time >= start_time) {
@@ -3110,8 +3472,8 @@ int Spdb::_getFirstTimeAfter(time_t request_time,
     
     if (posn >= 0) {
       
-      chunk_ref_t *ref = (chunk_ref_t *) _hdrRefBuf.getPtr() + posn;
-      aux_ref_t *aux = (aux_ref_t *) _hdrAuxBuf.getPtr() + posn;
+      const chunk_ref_t *ref = _fileRefs() + posn;
+      const aux_ref_t *aux = _fileAuxs() + posn;
       for (int i = posn; i < _hdr.n_chunks; i++, ref++) {
 	if ((time_t) ref->valid_time >= search_time &&
 	    (time_t) ref->valid_time <= end_time &&
@@ -3205,8 +3567,8 @@ int Spdb::_getFirstTimeBefore(time_t request_time,
 	return -1;
       }
       
-      chunk_ref_t *ref = (chunk_ref_t *) _hdrRefBuf.getPtr() + posn_ahead;
-      aux_ref_t *aux = (aux_ref_t *) _hdrAuxBuf.getPtr() + posn_ahead;
+      const chunk_ref_t *ref = _fileRefs() + posn_ahead;
+      const aux_ref_t *aux = _fileAuxs() + posn_ahead;
       for (int i = posn_ahead; i >= 0; i--, ref--) {
 	if ((time_t) ref->valid_time <= search_time &&
 	    (time_t) ref->valid_time >= start_time &&
@@ -3335,7 +3697,7 @@ int Spdb::_posn1MinAhead(int start_posn)
 
 {
 
-  chunk_ref_t *refs = (chunk_ref_t *) _hdrRefBuf.getPtr();
+  const chunk_ref_t *refs = _fileRefs();
   time_t start_time = refs[start_posn].valid_time;
   time_t target_time = start_time + SECS_IN_MIN;
 
@@ -3370,8 +3732,8 @@ int Spdb::_posnAtTime(time_t valid_time,
     return -1;
   }
 
-  chunk_ref_t *ref = (chunk_ref_t *) _hdrRefBuf.getPtr() + minute_posn;
-  aux_ref_t *aux = (aux_ref_t *) _hdrAuxBuf.getPtr() + minute_posn;
+  const chunk_ref_t *ref = _fileRefs() + minute_posn;
+  const aux_ref_t *aux = _fileAuxs() + minute_posn;
 
   for (int i = minute_posn; i < _hdr.n_chunks; i++, ref++, aux++) {
     if (((time_t) ref->valid_time - valid_time) > SECS_IN_MIN) {
@@ -3435,6 +3797,26 @@ void Spdb::_readChunkRefs()
   
 }
 
+/////////////////////////////////////////////////
+// Access to the chunk refs for the open day.
+// These are in the day cache if that is in use.
+
+const Spdb::chunk_ref_t *Spdb::_fileRefs() const
+{
+  if (_cachedDay != NULL) {
+    return _cachedDay->getRefs();
+  }
+  return (const chunk_ref_t *) _hdrRefBuf.getPtr();
+}
+
+const Spdb::aux_ref_t *Spdb::_fileAuxs() const
+{
+  if (_cachedDay != NULL) {
+    return _cachedDay->getAuxs();
+  }
+  return (const aux_ref_t *) _hdrAuxBuf.getPtr();
+}
+
 /////////////////////////////////////////////////
 // do the chunk read if the data type is correct
 // Appends to the ref, aux and data buffers, and
@@ -3518,6 +3900,41 @@ int Spdb::_readChunk(chunk_ref_t &ref,
   
 {
   
+  // if the day cache is in use, copy or uncompress
+  // directly from the mapped data file
+
+  if (_cachedDay != NULL) {
+    if ((size_t) ref.offset + ref.len > _cachedDay->getDataLen()) {
+      _errStr += "ERROR - Spdb::_readChunk\n";
+      _addStrErr(" Prod label: ", _hdr.prod_label);
+      _addIntErr(" Chunk beyond end of data file, len: ", ref.len);
+      _addIntErr(" Data offset: ", ref.offset);
+      _errStr += _dataPath;
+      _errStr += "\n";
+      return -1;
+    }
+    const char *mapped = _cachedDay->getData() + ref.offset;
+    if (doUncompress && ta_is_compressed(mapped, ref.len)) {
+      ui64 nbytesUncompressed;
+      void *uncompressed  = ta_decompress(mapped, &nbytesUncompressed);
+      if (uncompressed != NULL) {
+        void *chunk = readBuf.reserve(nbytesUncompressed);
+        memcpy(chunk, uncompressed, nbytesUncompressed);
+        ref.len = nbytesUncompressed;
+        aux.compression = 0;
+        ta_compress_free(uncompressed);
+        return 0;
+      }
+      _errStr += "WARNING - Spdb::_readChunk\n";
+      _addStrErr(" Prod label: ", _hdr.prod_label);
+      _addIntErr(" Cannot uncompress chunk of len: ", ref.len);
+      _addIntErr(" Data offset: ", ref.offset);
+    }
+    void *chunk = readBuf.reserve(ref.len);
+    memcpy(chunk, mapped, ref.len);
+    return 0;
+  }
+
   // allocate space in buffer for chunk data
   
   void *chunk = readBuf.reserve(ref.len);
@@ -4259,6 +4676,44 @@ void Spdb::_clearErrStr() const
   TaStr::AddStr(_errStr, "Time for following error: ", DateTime::str());
 }
 
+////////////////////////////////////////////////////////////
+// Get the toolsa compression method for a compression type.
+// ZSTD and LZ4 revert to GZIP if not available in toolsa.
+
+ta_compression_method_t Spdb::taCompressionMethod(compression_t compression)
+{
+  switch (checkCompressionAvailable(compression)) {
+    case COMPRESSION_NONE:
+      return TA_COMPRESSION_NONE;
+    case COMPRESSION_BZIP2:
+      return TA_COMPRESSION_BZIP;
+    case COMPRESSION_ZSTD:
+      return TA_COMPRESSION_ZSTD;
+    case COMPRESSION_LZ4:
+      return TA_COMPRESSION_LZ4;
+    case COMPRESSION_GZIP:
+    default:
+      return TA_COMPRESSION_GZIP;
+  }
+}
+
+////////////////////////////////////////////////////////////
+// Check that a compression type is available in toolsa.
+// Returns the type, or COMPRESSION_GZIP if it is not available.
+
+Spdb::compression_t Spdb::checkCompressionAvailable(compression_t compression)
+{
+  if (compression == COMPRESSION_ZSTD &&
+      !ta_compression_available(TA_COMPRESSION_ZSTD)) {
+    return COMPRESSION_GZIP;
+  }
+  if (compression == COMPRESSION_LZ4 &&
+      !ta_compression_available(TA_COMPRESSION_LZ4)) {
+    return COMPRESSION_GZIP;
+  }
+  return compression;
+}
+
 ////////////////////////////////
 // byte swapping for chunk refs
 
@@ -0,0 +1,500 @@
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*
+// ** Copyright UCAR (c) 1990 - 2016
+// ** University Corporation for Atmospheric Research (UCAR)
+// ** National Center for Atmospheric Research (NCAR)
+// ** Boulder, Colorado, USA
+// ** BSD licence applies - redistribution and use in source and binary
+// ** forms, with or without modification, are permitted provided that
+// ** the following conditions are met:
+// ** 1) If the software is modified to produce derivative works,
+// ** such modified software should be clearly marked, so as not
+// ** to confuse it with the version available from UCAR.
+// ** 2) Redistributions of source code must retain the above copyright
+// ** notice, this list of conditions and the following disclaimer.
+// ** 3) Redistributions in binary form must reproduce the above copyright
+// ** notice, this list of conditions and the following disclaimer in the
+// ** documentation and/or other materials provided with the distribution.
+// ** 4) Neither the name of UCAR nor the names of its contributors,
+// ** if any, may be used to endorse or promote products derived from
+// ** this software without specific prior written permission.
+// ** DISCLAIMER: THIS SOFTWARE IS PROVIDED "AS IS" AND WITHOUT ANY EXPRESS
+// ** OR IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+// ** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*
+////////////////////////////////////////////////////////////////
+// SpdbDayCache.cc
+//
+// Process-wide cache of Spdb day files, for read-only access.
+//
+////////////////////////////////////////////////////////////////
+
+#include <Spdb/SpdbDayCache.hh>
+#include <dataport/bigend.h>
+#include <cstring>
+#include <cstdlib>
+#include <cerrno>
+#include <ctime>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+using namespace std;
+
+////////////////////////////////////////////////////////////
+// File identity
+
+SpdbCachedDay::FileId::FileId() :
+        dev(0),
+        ino(0),
+        size(0),
+        mtimeSec(0),
+        mtimeNsec(0)
+{
+}
+
+bool SpdbCachedDay::FileId::operator==(const FileId &other) const
+{
+  return (dev == other.dev &&
+          ino == other.ino &&
+          size == other.size &&
+          mtimeSec == other.mtimeSec &&
+          mtimeNsec == other.mtimeNsec);
+}
+
+////////////////////////////////////////////////////////////
+// Cached day - constructor
+
+SpdbCachedDay::SpdbCachedDay(const string &indxPath,
+                             const string &dataPath) :
+        _indxPath(indxPath),
+        _dataPath(dataPath),
+        _loadTime(0),
+        _data(NULL),
+        _dataLen(0),
+        _nUsers(0),
+        _inCache(false),
+        _lastUse(0)
+{
+  memset(&_hdr, 0, sizeof(_hdr));
+}
+
+////////////////////////////////////////////////////////////
+// destructor
+
+SpdbCachedDay::~SpdbCachedDay()
+{
+  if (_data != NULL) {
+    munmap(_data, _dataLen);
+  }
+}
+
+////////////////////////////////////////////////////////////
+// access to refs
+
+const Spdb::chunk_ref_t *SpdbCachedDay::getRefs() const
+{
+  if (_refs.size() == 0) {
+    return NULL;
+  }
+  return &_refs[0];
+}
+
+const Spdb::aux_ref_t *SpdbCachedDay::getAuxs() const
+{
+  if (_auxs.size() == 0) {
+    return NULL;
+  }
+  return &_auxs[0];
+}
+
+////////////////////////////////////////////////////////////
+// Load the index and map the data file.
+//
+// The index is decoded in the same way as Spdb::_openReadWrite()
+// and Spdb::_readChunkRefs(), including the recovery of files
+// which have fewer chunk refs than the header indicates.
+//
+// Returns 0 on success, -1 on failure.
+
+int SpdbCachedDay::_load()
+
+{
+
+  _loadTime = time(NULL);
+
+  // read the index file
+
+  int indxFd = open(_indxPath.c_str(), O_RDONLY);
+  if (indxFd < 0) {
+    return -1;
+  }
+
+  struct stat indxStat;
+  if (fstat(indxFd, &indxStat) ||
+      indxStat.st_size < (off_t) sizeof(Spdb::header_t)) {
+    close(indxFd);
+    return -1;
+  }
+  _indxId.dev = indxStat.st_dev;
+  _indxId.ino = indxStat.st_ino;
+  _indxId.size = indxStat.st_size;
+  _indxId.mtimeSec = indxStat.st_mtim.tv_sec;
+  _indxId.mtimeNsec = indxStat.st_mtim.tv_nsec;
+
+  size_t indxLen = indxStat.st_size;
+  vector<char> indxBuf(indxLen);
+  size_t nRead = 0;
+  while (nRead < indxLen) {
+    ssize_t nn = read(indxFd, &indxBuf[nRead], indxLen - nRead);
+    if (nn < 0 && errno == EINTR) {
+      continue;
+    }
+    if (nn <= 0) {
+      break;
+    }
+    nRead += nn;
+  }
+  close(indxFd);
+  if (nRead < sizeof(Spdb::header_t)) {
+    return -1;
+  }
+
+  // header - swap all but the label
+
+  memcpy(&_hdr, &indxBuf[0], sizeof(Spdb::header_t));
+  BE_to_array_32(((char *) &_hdr + SPDB_LABEL_MAX),
+                 sizeof(Spdb::header_t) - SPDB_LABEL_MAX);
+  if (_hdr.n_chunks < 0) {
+    _hdr.n_chunks = 0;
+  }
+
+  // chunk refs - trim n_chunks if there are not enough refs
+
+  size_t offset = sizeof(Spdb::header_t);
+  size_t nRefsAvail = (nRead - offset) / sizeof(Spdb::chunk_ref_t);
+  if ((size_t) _hdr.n_chunks > nRefsAvail) {
+    _hdr.n_chunks = nRefsAvail;
+  }
+  int nChunks = _hdr.n_chunks;
+
+  _refs.resize(nChunks);
+  if (nChunks > 0) {
+    memcpy(&_refs[0], &indxBuf[offset], nChunks * sizeof(Spdb::chunk_ref_t));
+    Spdb::chunk_refs_from_BE(&_refs[0], nChunks);
+  }
+  offset += nChunks * sizeof(Spdb::chunk_ref_t);
+
+  // aux refs - if these are missing, they are set to 0
+
+  _auxs.resize(nChunks);
+  if (nChunks > 0) {
+    size_t auxLen = nChunks * sizeof(Spdb::aux_ref_t);
+    if (nRead - offset >= auxLen) {
+      memcpy(&_auxs[0], &indxBuf[offset], auxLen);
+      Spdb::aux_refs_from_BE(&_auxs[0], nChunks);
+    } else {
+      memset(&_auxs[0], 0, auxLen);
+    }
+  }
+
+  // map the data file
+
+  int dataFd = open(_dataPath.c_str(), O_RDONLY);
+  if (dataFd < 0) {
+    return -1;
+  }
+
+  struct stat dataStat;
+  if (fstat(dataFd, &dataStat)) {
+    close(dataFd);
+    return -1;
+  }
+  _dataId.dev = dataStat.st_dev;
+  _dataId.ino = dataStat.st_ino;
+  _dataId.size = dataStat.st_size;
+  _dataId.mtimeSec = dataStat.st_mtim.tv_sec;
+  _dataId.mtimeNsec = dataStat.st_mtim.tv_nsec;
+
+  _dataLen = dataStat.st_size;
+  if (_dataLen > 0) {
+    void *addr = mmap(NULL, _dataLen, PROT_READ, MAP_SHARED, dataFd, 0);
+    if (addr == MAP_FAILED) {
+      _dataLen = 0;
+      close(dataFd);
+      return -1;
+    }
+    _data = (char *) addr;
+  }
+
+  // the mapping stays valid after the file is closed
+
+  close(dataFd);
+
+  return 0;
+
+}
+
+////////////////////////////////////////////////////////////
+// Get identity for a plain file.
+// Returns 0 on success, -1 on failure.
+
+int SpdbCachedDay::_getFileId(const string &path, FileId &id)
+{
+  struct stat fileStat;
+  if (stat(path.c_str(), &fileStat)) {
+    return -1;
+  }
+  id.dev = fileStat.st_dev;
+  id.ino = fileStat.st_ino;
+  id.size = fileStat.st_size;
+  id.mtimeSec = fileStat.st_mtim.tv_sec;
+  id.mtimeNsec = fileStat.st_mtim.tv_nsec;
+  return 0;
+}
+
+////////////////////////////////////////////////////////////
+// Cache - get the instance
+
+SpdbDayCache &SpdbDayCache::inst()
+{
+  static SpdbDayCache _instance;
+  return _instance;
+}
+
+////////////////////////////////////////////////////////////
+// constructor
+
+SpdbDayCache::SpdbDayCache() :
+        _maxDays(32),
+        _useCount(0)
+{
+  pthread_mutex_init(&_mutex, NULL);
+  char *maxDaysStr = getenv("SPDB_DAY_CACHE_MAX_DAYS");
+  if (maxDaysStr != NULL) {
+    int maxDays;
+    if (sscanf(maxDaysStr, "%d", &maxDays) == 1 && maxDays >= 0) {
+      _maxDays = maxDays;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////
+// destructor
+
+SpdbDayCache::~SpdbDayCache()
+{
+  clear();
+  pthread_mutex_destroy(&_mutex);
+}
+
+////////////////////////////////////////////////////////////
+// Acquire a day.
+// Returns NULL if not available, caller uses normal file reads.
+
+const SpdbCachedDay *SpdbDayCache::acquire(const string &indxPath,
+                                           const string &dataPath)
+
+{
+
+  // check the files exist as plain files
+
+  SpdbCachedDay::FileId indxId, dataId;
+  if (SpdbCachedDay::_getFileId(indxPath, indxId) ||
+      SpdbCachedDay::_getFileId(dataPath, dataId)) {
+    return NULL;
+  }
+  if (indxId.size < (off_t) sizeof(Spdb::header_t)) {
+    return NULL;
+  }
+
+  // look for valid entry in the cache
+
+  pthread_mutex_lock(&_mutex);
+  map<string, SpdbCachedDay *>::iterator it = _days.find(indxPath);
+  if (it != _days.end()) {
+    SpdbCachedDay *day = it->second;
+    if (_isValid(day, indxId, dataId)) {
+      day->_nUsers++;
+      day->_lastUse = ++_useCount;
+      pthread_mutex_unlock(&_mutex);
+      return day;
+    }
+    _remove(day);
+  }
+  pthread_mutex_unlock(&_mutex);
+
+  // load the day - outside the lock, since this does the file reads.
+  // Spdb acquires days with the read lock on the data directory held,
+  // so writers cannot change the files during the load. Other callers
+  // may not hold the lock, so the files are checked again after the
+  // load, and the load is retried if a write happened meanwhile.
+
+  SpdbCachedDay *day = NULL;
+  for (int itry = 0; itry < _maxLoadTries; itry++) {
+    day = new SpdbCachedDay(indxPath, dataPath);
+    if (day->_load()) {
+      delete day;
+      return NULL;
+    }
+    SpdbCachedDay::FileId indxIdAfter, dataIdAfter;
+    if (SpdbCachedDay::_getFileId(indxPath, indxIdAfter) ||
+        SpdbCachedDay::_getFileId(dataPath, dataIdAfter)) {
+      delete day;
+      return NULL;
+    }
+    if (day->_indxId == indxId && day->_dataId == dataId &&
+        indxIdAfter == indxId && dataIdAfter == dataId) {
+      break;
+    }
+    // files changed during the load
+    delete day;
+    day = NULL;
+    indxId = indxIdAfter;
+    dataId = dataIdAfter;
+  }
+  if (day == NULL) {
+    return NULL;
+  }
+
+  // add to the cache - another thread may have loaded it meanwhile,
+  // in which case the latest load replaces it
+
+  pthread_mutex_lock(&_mutex);
+  it = _days.find(indxPath);
+  if (it != _days.end()) {
+    _remove(it->second);
+  }
+  day->_inCache = true;
+  day->_nUsers = 1;
+  day->_lastUse = ++_useCount;
+  _days[indxPath] = day;
+  _trim();
+  pthread_mutex_unlock(&_mutex);
+
+  return day;
+
+}
+
+////////////////////////////////////////////////////////////
+// Release a day after use
+
+void SpdbDayCache::release(const SpdbCachedDay *day)
+
+{
+
+  if (day == NULL) {
+    return;
+  }
+
+  pthread_mutex_lock(&_mutex);
+  SpdbCachedDay *ourDay = const_cast<SpdbCachedDay *>(day);
+  ourDay->_nUsers--;
+  if (!ourDay->_inCache && ourDay->_nUsers <= 0) {
+    delete ourDay;
+  } else {
+    _trim();
+  }
+  pthread_mutex_unlock(&_mutex);
+
+}
+
+////////////////////////////////////////////////////////////
+// Set max number of days in cache
+
+void SpdbDayCache::setMaxDays(int max_days)
+{
+  pthread_mutex_lock(&_mutex);
+  _maxDays = max_days;
+  _trim();
+  pthread_mutex_unlock(&_mutex);
+}
+
+////////////////////////////////////////////////////////////
+// Free all days not in use
+
+void SpdbDayCache::clear()
+{
+  pthread_mutex_lock(&_mutex);
+  vector<SpdbCachedDay *> days;
+  for (map<string, SpdbCachedDay *>::iterator it = _days.begin();
+       it != _days.end(); it++) {
+    days.push_back(it->second);
+  }
+  for (size_t ii = 0; ii < days.size(); ii++) {
+    _remove(days[ii]);
+  }
+  pthread_mutex_unlock(&_mutex);
+}
+
+////////////////////////////////////////////////////////////
+// Number of days in cache
+
+int SpdbDayCache::getNDays()
+{
+  pthread_mutex_lock(&_mutex);
+  int nDays = (int) _days.size();
+  pthread_mutex_unlock(&_mutex);
+  return nDays;
+}
+
+////////////////////////////////////////////////////////////
+// Check if a cached day is still valid, given the current
+// identity of the files.
+//
+// If the index was modified in the second in which it was loaded,
+// a later modification in that second may not have changed the
+// file time, so the entry is not trusted.
+
+bool SpdbDayCache::_isValid(const SpdbCachedDay *day,
+                            const SpdbCachedDay::FileId &indxId,
+                            const SpdbCachedDay::FileId &dataId) const
+{
+  if (!(day->_indxId == indxId) || !(day->_dataId == dataId)) {
+    return false;
+  }
+  if (day->_indxId.mtimeSec >= day->_loadTime) {
+    return false;
+  }
+  return true;
+}
+
+////////////////////////////////////////////////////////////
+// Remove a day from the cache, deleting it if not in use.
+// Must be called with the mutex locked.
+
+void SpdbDayCache::_remove(SpdbCachedDay *day)
+{
+  _days.erase(day->_indxPath);
+  day->_inCache = false;
+  if (day->_nUsers <= 0) {
+    delete day;
+  }
+}
+
+////////////////////////////////////////////////////////////
+// Remove least recently used days not in use, to bring
+// the cache down to the max size.
+// Must be called with the mutex locked.
+
+void SpdbDayCache::_trim()
+{
+  while ((int) _days.size() > _maxDays) {
+    SpdbCachedDay *oldest = NULL;
+    for (map<string, SpdbCachedDay *>::iterator it = _days.begin();
+         it != _days.end(); it++) {
+      SpdbCachedDay *day = it->second;
+      if (day->_nUsers > 0) {
+        continue;
+      }
+      if (oldest == NULL || day->_lastUse < oldest->_lastUse) {
+        oldest = day;
+      }
+    }
+    if (oldest == NULL) {
+      // all in use
+      return;
+    }
+    _remove(oldest);
+  }
+}
+
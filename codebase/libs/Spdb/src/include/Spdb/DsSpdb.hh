@@ -111,6 +111,8 @@ public:
   //    Spdb::COMPRESSION_NONE
   //    Spdb::COMPRESSION_GZIP
   //    Spdb::COMPRESSION_BZIP2
+  //    Spdb::COMPRESSION_ZSTD
+  //    Spdb::COMPRESSION_LZ4
   // If set, data will be compressed before transmission,
   // and uncompressed on the receiving end. This applies to
   // both putting and getting data.
@@ -526,9 +526,12 @@ public:
   // Options are Spdb::COMPRESSION_NONE
   //             Spdb::COMPRESSION_GZIP
   //             Spdb::COMPRESSION_BZIP2
+  //             Spdb::COMPRESSION_ZSTD
+  //             Spdb::COMPRESSION_LZ4
 
   void setDataCompression(Spdb::compression_t compression) { 
-    _info2.data_buf_compression = compression;
+    _info2.data_buf_compression =
+      Spdb::checkCompressionAvailable(compression);
   }
 
   /////////////////////////////////
@@ -76,11 +76,14 @@
 #include <vector>
 #include <iostream>
 #include <toolsa/MemBuf.hh>
+#include <toolsa/compress.h>
 #include <dataport/port_types.h>
 #include <Spdb/Product_defines.hh>
 
 using namespace std;
 
+class SpdbCachedDay;
+
 ///////////////////////////////////////////////////////////////
 // class definition
 
@@ -185,6 +188,8 @@ public:
   //    Spdb::COMPRESSION_NONE
   //    Spdb::COMPRESSION_GZIP
   //    Spdb::COMPRESSION_BZIP2
+  //    Spdb::COMPRESSION_ZSTD
+  //    Spdb::COMPRESSION_LZ4
   // If set, chunks will be stored compressed and the
   // compression flag will be set in the auxiliary chunk header.
   // The default is COMPRESSION_NONE.
@@ -517,6 +522,38 @@ public:
     _latestValidWriteTime = 0;
   }
 
+  /////////////////////////////////////////////////////////
+  // Option to read local files via the process-wide day cache.
+  //
+  // If set, the index for each day is read once and held in
+  // memory, and the data file is memory-mapped. Later gets for
+  // the same day check that the files have not changed, and
+  // then read from memory. See SpdbDayCache.hh.
+  //
+  // Useful for servers and other long-lived processes which make
+  // repeated requests on the same data. Compressed files are read
+  // in the normal way.
+  //
+  // Default is false, or true if the environment variable
+  // SPDB_MMAP_READS is set to true.
+
+  void setMmapReads(bool state = true) { _mmapReads = state; }
+  bool getMmapReads() const { return _mmapReads; }
+
+  /////////////////////////////////////////////////////////
+  // Set the number of threads for getInterval().
+  //
+  // If n_threads > 1, and mmap reads are set, intervals spanning
+  // more than one day are read with one day per thread at a time.
+  // The results are returned in the same order as for a single
+  // thread.
+  //
+  // Default is 1, or the value of the environment variable
+  // SPDB_READ_NTHREADS if set.
+
+  void setReadNThreads(int n_threads);
+  int getReadNThreads() const { return _readNThreads; }
+
   ////////////////////////////////////////////////////////////
   // get the first, last and last_valid_time in the data base
   // Use getFirstTime(), getLastTime() and getLastValidTime()
@@ -723,6 +760,17 @@ public:
   const string &getAppName() const { return _appName; }
   void setAppName(const string &app_name) const { _appName = app_name; }
  
+  ////////////////////////////////////////////////////////////
+  // Get the toolsa compression method for a compression type.
+  // ZSTD and LZ4 revert to GZIP if not available in toolsa.
+
+  static ta_compression_method_t taCompressionMethod(compression_t compression);
+
+  // Check that a compression type is available in toolsa.
+  // Returns the type, or COMPRESSION_GZIP if it is not available.
+
+  static compression_t checkCompressionAvailable(compression_t compression);
+
   // byte swapping for chunk refs
 
   static void chunk_refs_to_BE(chunk_ref_t *refs, int nn);
@@ -781,6 +829,12 @@ public:
   bool _checkWriteTimeOnGet;
   time_t _latestValidWriteTime;
   
+  // reading via the day cache
+
+  bool _mmapReads;
+  int _readNThreads;
+  const SpdbCachedDay *_cachedDay;
+
   // put attributes
   
   put_mode_t _putMode;
@@ -879,6 +933,21 @@ public:
                    time_t end_time,
                    int data_type,
                    int data_type2);
+
+  int _getIntervalDay(time_t day_time,
+                      time_t time1,
+                      time_t time2,
+                      int data_type,
+                      int data_type2,
+                      MemBuf &readBuf);
+
+  int _getIntervalThreaded(time_t time1,
+                           time_t time2,
+                           int data_type,
+                           int data_type2,
+                           bool &done);
+
+  static void *_getIntervalThreadMain(void *args);
   
   int _getValid(time_t request_time,
                 int data_type,
@@ -904,6 +973,8 @@ public:
                      open_mode_t mode,
                      bool read_chunk_refs);
   
+  int _openCached(int prod_id);
+
   int _openCreate(int prod_id,
                   const string &prod_label,
                   time_t valid_time,
@@ -970,6 +1041,9 @@ public:
 
   void _readChunkRefs();
 
+  const chunk_ref_t *_fileRefs() const;
+  const aux_ref_t *_fileAuxs() const;
+
   int _checkTypeThenReadChunk(int data_type,
                               int data_type2,
                               const chunk_ref_t &ref,
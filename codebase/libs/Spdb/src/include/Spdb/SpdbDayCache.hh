@@ -0,0 +1,218 @@
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*
+// ** Copyright UCAR (c) 1990 - 2016
+// ** University Corporation for Atmospheric Research (UCAR)
+// ** National Center for Atmospheric Research (NCAR)
+// ** Boulder, Colorado, USA
+// ** BSD licence applies - redistribution and use in source and binary
+// ** forms, with or without modification, are permitted provided that
+// ** the following conditions are met:
+// ** 1) If the software is modified to produce derivative works,
+// ** such modified software should be clearly marked, so as not
+// ** to confuse it with the version available from UCAR.
+// ** 2) Redistributions of source code must retain the above copyright
+// ** notice, this list of conditions and the following disclaimer.
+// ** 3) Redistributions in binary form must reproduce the above copyright
+// ** notice, this list of conditions and the following disclaimer in the
+// ** documentation and/or other materials provided with the distribution.
+// ** 4) Neither the name of UCAR nor the names of its contributors,
+// ** if any, may be used to endorse or promote products derived from
+// ** this software without specific prior written permission.
+// ** DISCLAIMER: THIS SOFTWARE IS PROVIDED "AS IS" AND WITHOUT ANY EXPRESS
+// ** OR IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+// ** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*
+////////////////////////////////////////////////////////////////
+// SpdbDayCache.hh
+//
+// Process-wide cache of Spdb day files, for read-only access.
+//
+////////////////////////////////////////////////////////////////
+//
+// For each day, the cache holds the decoded index header,
+// chunk refs and aux refs, and a read-only memory map of the
+// data file. Repeated reads of the same day therefore need
+// only a stat() of the two files to check that the cached
+// entry is still valid, instead of opening the files and
+// reading and swapping the index each time.
+//
+// An entry is valid while the device, inode, size and
+// modification time of both files are unchanged. Since file
+// times have limited resolution, an entry is not trusted if the
+// index file was modified in the same second as the entry was
+// loaded - it is reloaded instead.
+//
+// Only plain files are cached. If either file is missing, or
+// is only available compressed, or cannot be read, acquire()
+// returns NULL and the caller should fall back to the normal
+// file reads, which handle those cases.
+//
+// A day is loaded with the read lock on the data directory held
+// by Spdb, so that a concurrent put is not seen half written. The
+// files are also checked after loading, and the load is retried if
+// they changed, in case acquire() is called without the lock.
+//
+// Days are reference counted, so they may be used by several
+// threads at once. A day which goes stale while in use is
+// freed when the last user releases it.
+//
+////////////////////////////////////////////////////////////////
+
+#ifndef SpdbDayCache_HH
+#define SpdbDayCache_HH
+
+#include <Spdb/Spdb.hh>
+#include <pthread.h>
+#include <sys/types.h>
+#include <string>
+#include <vector>
+#include <map>
+using namespace std;
+
+///////////////////////////////////////////////////////////////
+// A single cached day
+
+class SpdbCachedDay
+
+{
+
+  friend class SpdbDayCache;
+
+public:
+
+  // index header, in host byte order
+
+  const Spdb::header_t &getHdr() const { return _hdr; }
+
+  // chunk and aux refs, in host byte order
+  // The number of refs is getHdr().n_chunks
+
+  const Spdb::chunk_ref_t *getRefs() const;
+  const Spdb::aux_ref_t *getAuxs() const;
+
+  // mapped contents of the data file
+
+  const char *getData() const { return _data; }
+  size_t getDataLen() const { return _dataLen; }
+
+  const string &getIndxPath() const { return _indxPath; }
+  const string &getDataPath() const { return _dataPath; }
+
+private:
+
+  // file identity, for checking validity
+
+  class FileId {
+  public:
+    FileId();
+    bool operator==(const FileId &other) const;
+    dev_t dev;
+    ino_t ino;
+    off_t size;
+    time_t mtimeSec;
+    long mtimeNsec;
+  };
+
+  SpdbCachedDay(const string &indxPath,
+                const string &dataPath);
+  ~SpdbCachedDay();
+
+  int _load();
+
+  string _indxPath;
+  string _dataPath;
+
+  FileId _indxId;
+  FileId _dataId;
+  time_t _loadTime;
+
+  Spdb::header_t _hdr;
+  vector<Spdb::chunk_ref_t> _refs;
+  vector<Spdb::aux_ref_t> _auxs;
+
+  char *_data;
+  size_t _dataLen;
+
+  int _nUsers;
+  bool _inCache;
+  unsigned long _lastUse;
+
+  static int _getFileId(const string &path, FileId &id);
+
+  // private copy constructor and assignment - no copying
+
+  SpdbCachedDay(const SpdbCachedDay &);
+  SpdbCachedDay &operator=(const SpdbCachedDay &);
+
+};
+
+///////////////////////////////////////////////////////////////
+// The cache - a singleton
+
+class SpdbDayCache
+
+{
+
+public:
+
+  // get the instance
+
+  static SpdbDayCache &inst();
+
+  // Acquire a day, loading or reloading it if needed.
+  //
+  // Returns NULL if the files cannot be read as plain files,
+  // in which case the caller should use the normal file reads.
+  //
+  // A non-NULL day must be passed to release() when done.
+
+  const SpdbCachedDay *acquire(const string &indxPath,
+                               const string &dataPath);
+
+  void release(const SpdbCachedDay *day);
+
+  // Set the max number of days held in the cache.
+  // Days in use are not counted against the limit.
+  // Default is 32, or SPDB_DAY_CACHE_MAX_DAYS if set.
+
+  void setMaxDays(int max_days);
+  int getMaxDays() const { return _maxDays; }
+
+  // free all days not in use
+
+  void clear();
+
+  // number of days currently cached
+
+  int getNDays();
+
+private:
+
+  // singleton - private constructor
+
+  SpdbDayCache();
+  ~SpdbDayCache();
+
+  pthread_mutex_t _mutex;
+  map<string, SpdbCachedDay *> _days;
+  int _maxDays;
+  unsigned long _useCount;
+
+  // number of times a day is loaded if the files keep changing
+  // during the load, before falling back to the normal reads
+
+  static const int _maxLoadTries = 3;
+
+  bool _isValid(const SpdbCachedDay *day,
+                const SpdbCachedDay::FileId &indxId,
+                const SpdbCachedDay::FileId &dataId) const;
+  void _remove(SpdbCachedDay *day);
+  void _trim();
+
+  // private copy constructor and assignment - no copying
+
+  SpdbDayCache(const SpdbDayCache &);
+  SpdbDayCache &operator=(const SpdbDayCache &);
+
+};
+
+#endif
@@ -67,7 +67,9 @@ typedef enum {
 typedef enum {
   COMPRESSION_NONE = 0,
   COMPRESSION_GZIP = 1,
-  COMPRESSION_BZIP2 = 2
+  COMPRESSION_BZIP2 = 2,
+  COMPRESSION_ZSTD = 3, // reverts to GZIP if toolsa does not have zstd
+  COMPRESSION_LZ4 = 4   // reverts to GZIP if toolsa does not have lz4
 } compression_t;
 
 // header struct - occurs once at the top of the
@@ -37,8 +37,60 @@
 #include <dsserver/DsLocator.hh>
 #include <dsserver/DsServerMsg.hh>
 #include <toolsa/TaStr.hh>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <map>
+#include <vector>
+#include <poll.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
 using namespace std;
 
+// kept-alive connections, keyed on host:port
+
+namespace {
+  class KeptAliveConn {
+  public:
+    int sd;
+    time_t lastUsed;
+  };
+  map<string, vector<KeptAliveConn> > _keptAlive;
+  pthread_mutex_t _keptAliveMutex = PTHREAD_MUTEX_INITIALIZER;
+  pthread_once_t _keptAliveOnce = PTHREAD_ONCE_INIT;
+  const int maxKeptAlivePerServer = 8;
+
+  // The connections must not be shared with a forked child, since
+  // the two processes would then read each other's replies. The
+  // mutex is held across fork(), so that the child gets it unlocked
+  // and the cache in a consistent state, and the child closes its
+  // copies of the connections. The parent keeps them.
+
+  void _keptAlivePrepare() {
+    pthread_mutex_lock(&_keptAliveMutex);
+  }
+  void _keptAliveParent() {
+    pthread_mutex_unlock(&_keptAliveMutex);
+  }
+  void _keptAliveChild() {
+    for (map<string, vector<KeptAliveConn> >::iterator it =
+           _keptAlive.begin(); it != _keptAlive.end(); it++) {
+      for (size_t ii = 0; ii < it->second.size(); ii++) {
+        close(it->second[ii].sd);
+      }
+    }
+    _keptAlive.clear();
+    pthread_mutex_unlock(&_keptAliveMutex);
+  }
+  void _keptAliveInit() {
+    pthread_atfork(_keptAlivePrepare, _keptAliveParent, _keptAliveChild);
+  }
+}
+
 // constructor
 
 DsClient::DsClient()
@@ -242,14 +294,42 @@ int DsClient::_communicateNoFwd(const DsURL &url,
 				ssize_t msgLen,
 				int commTimeoutMsecs)
   
+{
+  return _communicateNoFwd(url, msgType, msgBuf, msgLen,
+                           commTimeoutMsecs, _keepAliveEnabled());
+}
+
+int DsClient::_communicateNoFwd(const DsURL &url,
+				int msgType,
+				const void *msgBuf,
+				ssize_t msgLen,
+				int commTimeoutMsecs,
+                                bool allowReuse)
+  
 {
   
-  if (_debug) {
+  // reuse a kept-alive connection if available
+
+  bool keepAlive = _keepAliveEnabled();
+  bool reused = false;
+  if (allowReuse) {
+    int sd = _getKeptAlive(url.getHost(), url.getPort());
+    if (sd >= 0) {
+      if (_debug) {
+        _writeDebug("------> _communicateNoFwd() reusing connection");
+      }
+      _sock.attachSd(sd);
+      reused = true;
+    }
+  }
+
+  if (_debug && !reused) {
     _writeDebug("------> _communicateNoFwd() opening socket");
   }
   
   // open socket
-  if (_sock.open(url.getHost().c_str(),
+  if (!reused &&
+      _sock.open(url.getHost().c_str(),
                  url.getPort(),
                  _openTimeoutMsecs)) {
     _errStr += "ERROR - COMM - DsClient::_communicateNoFwd _sock.open\n";
@@ -261,6 +341,15 @@ int DsClient::_communicateNoFwd(const DsURL &url,
     return -1;
   }
 
+  // on a kept-alive connection, disable Nagle buffering, which
+  // would delay the second part of each message
+
+  if (keepAlive && !reused) {
+    int nodelay = 1;
+    setsockopt(_sock.getSd(), IPPROTO_TCP, TCP_NODELAY,
+               &nodelay, sizeof(nodelay));
+  }
+
   // write the message
   
   if (_debug) {
@@ -269,6 +358,13 @@ int DsClient::_communicateNoFwd(const DsURL &url,
   
   if (_sock.writeMessage(msgType,
 			 msgBuf, msgLen, commTimeoutMsecs)) {
+    if (reused) {
+      // server may have closed the connection, retry on a new one
+      _closeSocket();
+      freeData();
+      return _communicateNoFwd(url, msgType, msgBuf, msgLen,
+                               commTimeoutMsecs, false);
+    }
     _errStr +=
       "ERROR - COMM - DsClient::_communicateNoFwd _sock.writeMessage\n";
     _errStr += "  Errors writing message to server.\n";
@@ -287,6 +383,35 @@ int DsClient::_communicateNoFwd(const DsURL &url,
     _writeDebug("------> _communicateNoFwd() reading reply");
   }
 
+  // On a reused connection, the server may have closed it while it
+  // was idle. That shows up as EOF or a reset before any reply byte,
+  // in which case the request was not handled and is sent again on
+  // a new connection. Any other failure, including a timeout, is
+  // returned as an error, since the request may have been applied.
+
+  if (reused) {
+    int peekStatus = _peekReply(commTimeoutMsecs);
+    if (peekStatus == 0) {
+      if (_debug) {
+        _writeDebug("------> _communicateNoFwd() connection closed, retrying");
+      }
+      _closeSocket();
+      freeData();
+      return _communicateNoFwd(url, msgType, msgBuf, msgLen,
+                               commTimeoutMsecs, false);
+    } else if (peekStatus < 0) {
+      _errStr +=
+        "ERROR - COMM - DsClient::_communicateNoFwd\n";
+      _errStr += "  No reply from server on kept-alive connection.\n";
+      TaStr::AddStr(_errStr, "  host: ", url.getHost());
+      TaStr::AddInt(_errStr, "  port: ", url.getPort());
+      TaStr::AddStr(_errStr, "  url: ", url.getURLStr());
+      _closeSocket();
+      freeData();
+      return -1;
+    }
+  }
+
   if (_sock.readMessage(commTimeoutMsecs)) {
     _errStr +=
       "ERROR - COMM - DsClient::_communicateNoFwd _sock.readMessage\n";
@@ -300,11 +425,160 @@ int DsClient::_communicateNoFwd(const DsURL &url,
     return -1;
   }
   
-  _closeSocket();
+  if (keepAlive) {
+    // keep the connection for the next request
+    _putKeptAlive(url.getHost(), url.getPort(), _sock.releaseSd());
+  } else {
+    _closeSocket();
+  }
   return 0;
 
 }
 
+////////////////////////////////////////////
+// Wait for the first byte of the reply on the open socket,
+// without consuming it.
+// Returns 1 if reply data is available, 0 if the server closed
+// or reset the connection before sending anything, -1 on timeout
+// or other error.
+
+int DsClient::_peekReply(int timeoutMsecs)
+{
+
+  int sd = _sock.getSd();
+
+  struct pollfd pfd;
+  pfd.fd = sd;
+  pfd.events = POLLIN;
+  pfd.revents = 0;
+  int pollMsecs = (timeoutMsecs < 0) ? -1 : timeoutMsecs;
+  int iret;
+  while ((iret = poll(&pfd, 1, pollMsecs)) < 0 && errno == EINTR) {
+  }
+  if (iret <= 0) {
+    // timed out, or poll failed
+    return -1;
+  }
+
+  char byte;
+  ssize_t nn;
+  while ((nn = recv(sd, &byte, 1, MSG_PEEK)) < 0 && errno == EINTR) {
+  }
+  if (nn > 0) {
+    return 1;
+  }
+  if (nn == 0 || errno == ECONNRESET) {
+    return 0;
+  }
+  return -1;
+
+}
+
+////////////////////////////////////////////
+// Is connection keep-alive enabled?
+// Set by DS_CLIENT_KEEPALIVE environment variable.
+
+bool DsClient::_keepAliveEnabled()
+{
+  char *DS_CLIENT_KEEPALIVE = getenv("DS_CLIENT_KEEPALIVE");
+  if (DS_CLIENT_KEEPALIVE != NULL &&
+      !strcasecmp(DS_CLIENT_KEEPALIVE, "true")) {
+    return true;
+  }
+  return false;
+}
+
+////////////////////////////////////////////
+// Get a kept-alive connection to the server.
+// Connections which have been idle too long, or which the
+// server has closed, are discarded.
+// Returns socket descriptor, -1 if none available.
+
+int DsClient::_getKeptAlive(const string &host, int port)
+{
+
+  int maxIdleSecs = 30;
+  char *DS_CLIENT_KEEPALIVE_SECS = getenv("DS_CLIENT_KEEPALIVE_SECS");
+  if (DS_CLIENT_KEEPALIVE_SECS != NULL) {
+    int secs;
+    if (sscanf(DS_CLIENT_KEEPALIVE_SECS, "%d", &secs) == 1) {
+      maxIdleSecs = secs;
+    }
+  }
+
+  char key[1024];
+  snprintf(key, sizeof(key), "%s:%d", host.c_str(), port);
+  time_t now = time(NULL);
+  
+  int sd = -1;
+  pthread_once(&_keptAliveOnce, _keptAliveInit);
+  pthread_mutex_lock(&_keptAliveMutex);
+  vector<KeptAliveConn> &conns = _keptAlive[key];
+  while (conns.size() > 0) {
+    KeptAliveConn conn = conns.back();
+    conns.pop_back();
+    if (now - conn.lastUsed > maxIdleSecs) {
+      close(conn.sd);
+      continue;
+    }
+    // an idle connection should have nothing to read - if it is
+    // readable the server has closed it
+    struct pollfd pfd;
+    pfd.fd = conn.sd;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    if (poll(&pfd, 1, 0) != 0) {
+      close(conn.sd);
+      continue;
+    }
+    sd = conn.sd;
+    break;
+  }
+  pthread_mutex_unlock(&_keptAliveMutex);
+
+  return sd;
+
+}
+
+////////////////////////////////////////////
+// Save a connection for reuse.
+
+void DsClient::_putKeptAlive(const string &host, int port, int sd)
+{
+
+  if (sd < 0) {
+    return;
+  }
+
+  char key[1024];
+  snprintf(key, sizeof(key), "%s:%d", host.c_str(), port);
+
+  // do not pass the connection on to programs started with exec
+
+  int flags = fcntl(sd, F_GETFD);
+  if (flags >= 0) {
+    fcntl(sd, F_SETFD, flags | FD_CLOEXEC);
+  }
+
+  KeptAliveConn conn;
+  conn.sd = sd;
+  conn.lastUsed = time(NULL);
+
+  pthread_once(&_keptAliveOnce, _keptAliveInit);
+  pthread_mutex_lock(&_keptAliveMutex);
+  vector<KeptAliveConn> &conns = _keptAlive[key];
+  if ((int) conns.size() < maxKeptAlivePerServer) {
+    conns.push_back(conn);
+    sd = -1;
+  }
+  pthread_mutex_unlock(&_keptAliveMutex);
+
+  if (sd >= 0) {
+    close(sd);
+  }
+
+}
+
 ////////////////////////////////////////////
 // Communicate with server - with forwarding
 // Uses http tunnel and/or proxy.
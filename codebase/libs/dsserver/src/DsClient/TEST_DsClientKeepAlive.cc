@@ -0,0 +1,266 @@
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*
+// ** Copyright UCAR (c) 1990 - 2016
+// ** University Corporation for Atmospheric Research (UCAR)
+// ** National Center for Atmospheric Research (NCAR)
+// ** Boulder, Colorado, USA
+// ** BSD licence applies - redistribution and use in source and binary
+// ** forms, with or without modification, are permitted provided that
+// ** the following conditions are met:
+// ** 1) If the software is modified to produce derivative works,
+// ** such modified software should be clearly marked, so as not
+// ** to confuse it with the version available from UCAR.
+// ** 2) Redistributions of source code must retain the above copyright
+// ** notice, this list of conditions and the following disclaimer.
+// ** 3) Redistributions in binary form must reproduce the above copyright
+// ** notice, this list of conditions and the following disclaimer in the
+// ** documentation and/or other materials provided with the distribution.
+// ** 4) Neither the name of UCAR nor the names of its contributors,
+// ** if any, may be used to endorse or promote products derived from
+// ** this software without specific prior written permission.
+// ** DISCLAIMER: THIS SOFTWARE IS PROVIDED "AS IS" AND WITHOUT ANY EXPRESS
+// ** OR IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+// ** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*
+/*
+ * Name: TEST_DsClientKeepAlive.cc
+ *
+ * Purpose:
+ *
+ *      To test that DsClient kept-alive connections are not shared
+ *      with forked children. A local echo server records which
+ *      processes send requests on each connection.
+ *
+ *      The parent makes a request, so that it holds a kept-alive
+ *      connection, then forks a child which makes a request. The
+ *      child must open its own connection, and the parent must
+ *      still be able to use its connection afterwards.
+ *
+ *      Children are then forked while another thread is making
+ *      requests, to check that a child does not deadlock on the
+ *      connection cache lock.
+ *
+ * Usage:
+ *
+ *       % DsClientKeepAlive-test
+ *
+ * Inputs:
+ *
+ *       None
+ *
+ * Returns 0 on success, 1 on failure.
+ * Prints nothing on success.
+ *
+ */
+
+/*
+ * include files
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <set>
+#include <vector>
+#include <pthread.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <dsserver/DsClient.hh>
+#include <didss/DsURL.hh>
+#include <toolsa/ServerSocket.hh>
+#include <toolsa/Socket.hh>
+using namespace std;
+
+static ServerSocket _server;
+static int _port = 0;
+static pthread_mutex_t _mutex = PTHREAD_MUTEX_INITIALIZER;
+static vector< set<int> > _connPids; // pids seen on each connection
+static volatile bool _busy = true;
+static int nFail = 0;
+
+/*
+ * Serve one connection, echoing each request back
+ */
+
+static void *_serveConn(void *arg)
+{
+  Socket *sock = (Socket *) arg;
+  pthread_mutex_lock(&_mutex);
+  int iconn = _connPids.size();
+  _connPids.push_back(set<int>());
+  pthread_mutex_unlock(&_mutex);
+  while (sock->readMessage() == 0) {
+    int pid = 0;
+    sscanf((const char *) sock->getData(), "%d", &pid);
+    pthread_mutex_lock(&_mutex);
+    _connPids[iconn].insert(pid);
+    pthread_mutex_unlock(&_mutex);
+    string reply((const char *) sock->getData(), sock->getNumBytes());
+    if (sock->writeMessage(1, reply.c_str(), reply.size())) {
+      break;
+    }
+  }
+  delete sock;
+  return NULL;
+}
+
+static void *_serve(void *arg)
+{
+  while (true) {
+    Socket *sock = _server.getClient();
+    if (sock == NULL) {
+      continue;
+    }
+    pthread_t th;
+    pthread_create(&th, NULL, _serveConn, sock);
+    pthread_detach(th);
+  }
+  return NULL;
+}
+
+/*
+ * Make one request, check that the reply is the echo of it
+ * Returns 0 on success, -1 on failure.
+ */
+
+static int _request(DsClient &client, int seq)
+{
+  char url[128];
+  snprintf(url, sizeof(url), "mdvp:://localhost:%d:test", _port);
+  DsURL dsUrl(url);
+  char msg[128];
+  snprintf(msg, sizeof(msg), "%d %d", (int) getpid(), seq);
+  if (client.communicateAutoFwd(dsUrl, 1, msg, strlen(msg) + 1)) {
+    fprintf(stderr, "FAIL - request failed, pid %d, seq %d\n",
+            (int) getpid(), seq);
+    return -1;
+  }
+  if (client.getReplyLen() != (ssize_t) strlen(msg) + 1 ||
+      strcmp((const char *) client.getReplyBuf(), msg)) {
+    fprintf(stderr, "FAIL - wrong reply, pid %d, seq %d\n",
+            (int) getpid(), seq);
+    return -1;
+  }
+  return 0;
+}
+
+/*
+ * Fork a child which makes one request.
+ * Returns 0 if the child succeeded, -1 otherwise.
+ */
+
+static int _forkChild(int seq)
+{
+  pid_t pid = fork();
+  if (pid == 0) {
+    // a deadlock is caught by the alarm
+    alarm(10);
+    DsClient client;
+    _exit(_request(client, seq) ? 1 : 0);
+  }
+  int status = 0;
+  if (pid < 0 || waitpid(pid, &status, 0) != pid) {
+    fprintf(stderr, "FAIL - cannot fork child\n");
+    return -1;
+  }
+  if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+    fprintf(stderr, "FAIL - child %d, seq %d, status 0x%x\n",
+            (int) pid, seq, status);
+    return -1;
+  }
+  return 0;
+}
+
+/*
+ * Make requests until told to stop
+ */
+
+static void *_requestLoop(void *arg)
+{
+  DsClient client;
+  int seq = 1000;
+  while (_busy) {
+    if (_request(client, seq++)) {
+      nFail++;
+      break;
+    }
+  }
+  return NULL;
+}
+
+/* ======================================================================== */
+
+/*
+ * main program
+ */
+
+int main(int argc, char *argv[])
+{
+
+  signal(SIGPIPE, SIG_IGN);
+  setenv("DS_CLIENT_KEEPALIVE", "true", 1);
+
+  for (int port = 15500; port < 15600; port++) {
+    if (_server.openServer(port) == 0) {
+      _port = port;
+      break;
+    }
+  }
+  if (_port == 0) {
+    fprintf(stderr, "FAIL - cannot open server\n");
+    return 1;
+  }
+  pthread_t serverThread;
+  pthread_create(&serverThread, NULL, _serve, NULL);
+
+  // parent holds a kept-alive connection when it forks
+
+  DsClient client;
+  if (_request(client, 0)) {
+    nFail++;
+  }
+  if (_forkChild(1)) {
+    nFail++;
+  }
+  if (_request(client, 2) || _request(client, 3)) {
+    nFail++;
+  }
+  pthread_mutex_lock(&_mutex);
+  if (_connPids.size() != 2) {
+    fprintf(stderr, "FAIL - expected 2 connections, got %d\n",
+            (int) _connPids.size());
+    nFail++;
+  }
+  pthread_mutex_unlock(&_mutex);
+
+  // fork while another thread is using the connection cache
+
+  pthread_t requestThread;
+  pthread_create(&requestThread, NULL, _requestLoop, NULL);
+  for (int ii = 0; ii < 20; ii++) {
+    if (_forkChild(100 + ii)) {
+      nFail++;
+    }
+  }
+  _busy = false;
+  pthread_join(requestThread, NULL);
+
+  // no connection may carry requests from more than one process
+
+  pthread_mutex_lock(&_mutex);
+  for (size_t ii = 0; ii < _connPids.size(); ii++) {
+    if (_connPids[ii].size() > 1) {
+      fprintf(stderr, "FAIL - connection %d shared by %d processes\n",
+              (int) ii, (int) _connPids[ii].size());
+      nFail++;
+    }
+  }
+  pthread_mutex_unlock(&_mutex);
+
+  if (nFail > 0) {
+    fprintf(stderr, "DsClientKeepAlive-test: %d failures\n", nFail);
+    return 1;
+  }
+  return 0;
+
+}
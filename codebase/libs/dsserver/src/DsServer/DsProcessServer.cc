@@ -78,7 +78,13 @@ DsProcessServer::DsProcessServer(const string & executableName,
   _isSecure(isSecure),
   _isReadOnly(isReadOnly),
   _allowHttp(allowHttp),
-  _lastPrint(0)
+  _lastPrint(0),
+  _poolSize(0),
+  _poolMaxWorkers(-1),
+  _poolMaxRequests(1000),
+  _keepAliveSecs(60),
+  _epollSd(-1),
+  _poolLastHousekeeping(0)
 
 {
 
@@ -129,6 +135,40 @@ DsProcessServer::DsProcessServer(const string & executableName,
     }
   }
   
+  // worker pool settings from environment?
+
+  char *DS_SERVER_POOL_SIZE = getenv("DS_SERVER_POOL_SIZE");
+  if (DS_SERVER_POOL_SIZE != NULL) {
+    int pool_size;
+    if (sscanf(DS_SERVER_POOL_SIZE, "%d", &pool_size) == 1) {
+      _poolSize = pool_size;
+    }
+  }
+  
+  char *DS_SERVER_POOL_MAX_WORKERS = getenv("DS_SERVER_POOL_MAX_WORKERS");
+  if (DS_SERVER_POOL_MAX_WORKERS != NULL) {
+    int max_workers;
+    if (sscanf(DS_SERVER_POOL_MAX_WORKERS, "%d", &max_workers) == 1) {
+      _poolMaxWorkers = max_workers;
+    }
+  }
+  
+  char *DS_SERVER_POOL_MAX_REQUESTS = getenv("DS_SERVER_POOL_MAX_REQUESTS");
+  if (DS_SERVER_POOL_MAX_REQUESTS != NULL) {
+    int max_requests;
+    if (sscanf(DS_SERVER_POOL_MAX_REQUESTS, "%d", &max_requests) == 1) {
+      _poolMaxRequests = max_requests;
+    }
+  }
+  
+  char *DS_SERVER_KEEPALIVE_SECS = getenv("DS_SERVER_KEEPALIVE_SECS");
+  if (DS_SERVER_KEEPALIVE_SECS != NULL) {
+    int keepalive_secs;
+    if (sscanf(DS_SERVER_KEEPALIVE_SECS, "%d", &keepalive_secs) == 1) {
+      _keepAliveSecs = keepalive_secs;
+    }
+  }
+  
   // Open socket on the port.
   _serverSocket = new ServerSocket();
   if (_serverSocket->openServer(_port) < 0) {
@@ -146,6 +186,9 @@ DsProcessServer::DsProcessServer(const string & executableName,
   if (_isDebug) {
     cerr << "DsProcessServer has opened ServerSocket at port " << _port << endl;
     cerr << "  _maxClients: " << _maxClients << endl;
+    if (_poolSize > 0) {
+      cerr << "  _poolSize: " << _poolSize << endl;
+    }
   }
   
   // Set status.
@@ -168,6 +211,21 @@ DsProcessServer::~DsProcessServer()
   }
 }
 
+/////////////////////////////////////////////////////////////////////
+// setWorkerPool()
+//
+// Use a pool of pre-forked worker processes instead of forking a
+//   child per client.
+//   poolSize: number of workers to keep running. 0 for fork per client.
+//   maxWorkers: max number of workers. If not positive, uses
+//     max clients.
+
+void DsProcessServer::setWorkerPool(int poolSize, int maxWorkers /* = -1 */)
+{
+  _poolSize = poolSize;
+  _poolMaxWorkers = maxWorkers;
+}
+
 /////////////////////////////////////////////////////////////////////
 // waitForClients()
 //
@@ -216,6 +274,20 @@ int DsProcessServer::waitForClients(int timeoutMSecs /* = 1000*/ )
     return -1;
   }
     
+  // use the worker pool?
+
+  if (_poolSize > 0 && !_isNoThreadDebug && !_allowHttp) {
+#if defined(__linux__)
+    return _waitForClientsPool(timeoutMSecs);
+#else
+    if (_isDebug) {
+      cerr << "WARNING - DsProcessServer::waitForClients" << endl;
+      cerr << "  Worker pool only supported on Linux" << endl;
+      cerr << "  Forking a child per client instead" << endl;
+    }
+#endif
+  }
+
   // Wait for connections.
   
   while (true) {
@@ -802,6 +874,12 @@ void DsProcessServer::purgeCompletedThreads()
     return;
   }
 
+  if (_epollSd >= 0) {
+    // worker pool is running
+    _poolReapWorkers();
+    return;
+  }
+
   pid_t dead_pid;
   int status;
 
@@ -0,0 +1,1017 @@
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*
+// ** Copyright UCAR (c) 1990 - 2016
+// ** University Corporation for Atmospheric Research (UCAR)
+// ** National Center for Atmospheric Research (NCAR)
+// ** Boulder, Colorado, USA
+// ** BSD licence applies - redistribution and use in source and binary
+// ** forms, with or without modification, are permitted provided that
+// ** the following conditions are met:
+// ** 1) If the software is modified to produce derivative works,
+// ** such modified software should be clearly marked, so as not
+// ** to confuse it with the version available from UCAR.
+// ** 2) Redistributions of source code must retain the above copyright
+// ** notice, this list of conditions and the following disclaimer.
+// ** 3) Redistributions in binary form must reproduce the above copyright
+// ** notice, this list of conditions and the following disclaimer in the
+// ** documentation and/or other materials provided with the distribution.
+// ** 4) Neither the name of UCAR nor the names of its contributors,
+// ** if any, may be used to endorse or promote products derived from
+// ** this software without specific prior written permission.
+// ** DISCLAIMER: THIS SOFTWARE IS PROVIDED "AS IS" AND WITHOUT ANY EXPRESS
+// ** OR IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+// ** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*
+///////////////////////////////////////////////////////////////
+// DsProcessServer_pool.cc
+//
+// Worker pool mode for DsProcessServer.
+//
+// The Boss process holds the client connections in an epoll set.
+// Connections with a request waiting are queued, and passed to
+// pre-forked worker processes over unix-domain sockets, using
+// SCM_RIGHTS. The worker handles the request and reports back,
+// and the connection is kept alive for further requests.
+//
+///////////////////////////////////////////////////////////////
+
+#include <dsserver/DsProcessServer.hh>
+#include <dsserver/DsServerMsg.hh>
+
+#include <toolsa/pmu.h>
+#include <toolsa/Socket.hh>
+#include <toolsa/ServerSocket.hh>
+#include <toolsa/TaStr.hh>
+#include <toolsa/DateTime.hh>
+
+#include <cerrno>
+#include <cstring>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <signal.h>
+#include <unistd.h>
+using namespace std;
+
+#if defined(__linux__)
+
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+
+// tags for epoll events, stored in the top 32 bits of the event data
+
+#define POOL_TAG_LISTEN 1ULL
+#define POOL_TAG_CONN 2ULL
+#define POOL_TAG_WORKER 3ULL
+
+#define POOL_MAX_EVENTS 64
+#define POOL_WORKER_IDLE_SECS 30
+#define POOL_STATS_INTERVAL_SECS 60
+
+static unsigned long long _poolTag(unsigned long long tag, int sd)
+{
+  return (tag << 32) | (unsigned int) sd;
+}
+
+// reply from worker to Boss after each request
+
+typedef struct {
+  si32 keepOpen; // connection is still open
+  si32 exiting;  // worker has reached max requests and is exiting
+} pool_reply_t;
+
+////////////////////////////////////////////////////////////
+// send a socket descriptor over a unix-domain socket
+// returns 0 on success, -1 on failure
+
+static int _sendSd(int chanSd, int sd)
+{
+
+  char dummy = 'c';
+  struct iovec iov;
+  iov.iov_base = &dummy;
+  iov.iov_len = 1;
+
+  union {
+    struct cmsghdr hdr;
+    char buf[CMSG_SPACE(sizeof(int))];
+  } control;
+  memset(&control, 0, sizeof(control));
+
+  struct msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control.buf;
+  msg.msg_controllen = sizeof(control.buf);
+
+  struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+  cmsg->cmsg_level = SOL_SOCKET;
+  cmsg->cmsg_type = SCM_RIGHTS;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+  memcpy(CMSG_DATA(cmsg), &sd, sizeof(int));
+
+  while (true) {
+    if (sendmsg(chanSd, &msg, MSG_NOSIGNAL) == 1) {
+      return 0;
+    }
+    if (errno != EINTR) {
+      return -1;
+    }
+  }
+
+}
+
+////////////////////////////////////////////////////////////
+// receive a socket descriptor over a unix-domain socket
+// blocks until received
+// returns descriptor on success, -1 on failure or if the
+// other end has closed
+
+static int _recvSd(int chanSd)
+{
+
+  char dummy;
+  struct iovec iov;
+  iov.iov_base = &dummy;
+  iov.iov_len = 1;
+
+  union {
+    struct cmsghdr hdr;
+    char buf[CMSG_SPACE(sizeof(int))];
+  } control;
+  memset(&control, 0, sizeof(control));
+
+  struct msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control.buf;
+  msg.msg_controllen = sizeof(control.buf);
+
+  ssize_t nn;
+  while ((nn = recvmsg(chanSd, &msg, 0)) < 0 && errno == EINTR) {
+  }
+  if (nn <= 0) {
+    return -1;
+  }
+
+  struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+  if (cmsg == NULL ||
+      cmsg->cmsg_level != SOL_SOCKET ||
+      cmsg->cmsg_type != SCM_RIGHTS) {
+    return -1;
+  }
+
+  int sd;
+  memcpy(&sd, CMSG_DATA(cmsg), sizeof(int));
+  return sd;
+
+}
+
+/////////////////////////////////////////////////////////////////////
+// _waitForClientsPool()
+//
+// Boss loop for worker pool mode. See waitForClients().
+//
+// Returns:  0 - the boss was instructed to terminate by
+//                 the return from timeoutMethod() or postHandlerMethod().
+//          -1 - something terrible happened.
+
+int DsProcessServer::_waitForClientsPool(int timeoutMSecs)
+
+{
+
+  if (_poolInit()) {
+    if (_isDebug) {
+      cerr << _errString << endl;
+    }
+    _poolShutdown();
+    return -1;
+  }
+
+  if (_isDebug) {
+    cerr << "DsProcessServer using worker pool" << endl;
+    cerr << "  poolSize: " << _poolSize << endl;
+    cerr << "  maxWorkers: " << _poolMaxWorkers << endl;
+    cerr << "  maxRequestsPerWorker: " << _poolMaxRequests << endl;
+    cerr << "  keepAliveSecs: " << _keepAliveSecs << endl;
+  }
+
+  // wake up at least once a sec for housekeeping
+
+  int waitMSecs = 1000;
+  if (timeoutMSecs > 0 && timeoutMSecs < waitMSecs) {
+    waitMSecs = timeoutMSecs;
+  }
+  double lastTimeout = _poolTimeNow();
+
+  struct epoll_event events[POOL_MAX_EVENTS];
+
+  while (true) {
+
+    int nEvents = epoll_wait(_epollSd, events, POOL_MAX_EVENTS, waitMSecs);
+    if (nEvents < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      int errNum = errno;
+      _errString = "";
+      TaStr::AddStr(_errString, "ERROR - ", _executableName);
+      _errString += "  Error in DsProcessServer::_waitForClientsPool(): ";
+      TaStr::AddStr(_errString, "  epoll_wait failed: ", strerror(errNum));
+      TaStr::AddStr(_errString, "  ", DateTime::str());
+      if (_isDebug) {
+        cerr << _errString << endl;
+      }
+      _poolShutdown();
+      return -1;
+    }
+
+    for (int ii = 0; ii < nEvents; ii++) {
+      unsigned long long tag = events[ii].data.u64 >> 32;
+      int sd = (int) (events[ii].data.u64 & 0xffffffffULL);
+      if (tag == POOL_TAG_LISTEN) {
+        _poolAccept();
+      } else if (tag == POOL_TAG_CONN) {
+        _poolConnReadable(sd);
+      } else if (tag == POOL_TAG_WORKER) {
+        for (size_t jj = 0; jj < _poolWorkers.size(); jj++) {
+          if (_poolWorkers[jj].chanSd == sd) {
+            _poolWorkerReply(jj);
+            break;
+          }
+        }
+      }
+    } // ii
+
+    // pass queued requests to workers
+
+    int nDispatched = _poolDispatch();
+
+    _poolHousekeeping(false);
+
+    if (nDispatched > 0) {
+
+      // Call the post-handler method.
+
+      bool shouldContinue = postHandlerMethod();
+      if (!shouldContinue) {
+        if (exitMethod()) {
+          if (_isDebug) {
+            cerr << "DsProcessServer returning from waitForClients() "
+                 << "because postHandlerMethod() indicated to do so."
+                 << endl;
+            cerr << "  " << DateTime::str() << endl;
+          }
+          _poolShutdown();
+          return 0; // Success.
+        }
+      }
+
+    }
+
+    // call the timeout method if no clients have arrived
+    // within the timeout period
+
+    if (timeoutMSecs > 0) {
+      double now = _poolTimeNow();
+      if (nDispatched > 0) {
+        lastTimeout = now;
+      } else if ((now - lastTimeout) * 1000.0 >= timeoutMSecs) {
+        lastTimeout = now;
+        bool shouldContinue = timeoutMethod();
+        if (!shouldContinue) {
+          if (exitMethod()) {
+            if (_isDebug) {
+              cerr << "DsProcessServer returning from waitForClients() "
+                   << "because timeoutMethod() indicated to do so."
+                   << endl;
+              cerr << "  " << DateTime::str() << endl;
+            }
+            _poolShutdown();
+            return 0; // success
+          }
+        }
+      }
+    }
+
+  } // while (true)
+
+  return -1; // should not reach here - no breaks in loop
+
+}
+
+////////////////////////////////////////////////////////////
+// initialize the pool - create epoll set, start workers
+// returns 0 on success, -1 on failure
+
+int DsProcessServer::_poolInit()
+
+{
+
+  if (_poolMaxWorkers <= 0) {
+    _poolMaxWorkers = _maxClients;
+  }
+  if (_poolMaxWorkers <= 0) {
+    _poolMaxWorkers = _poolSize;
+  }
+  if (_poolMaxWorkers < _poolSize) {
+    _poolMaxWorkers = _poolSize;
+  }
+
+  _epollSd = epoll_create1(EPOLL_CLOEXEC);
+  if (_epollSd < 0) {
+    int errNum = errno;
+    _errString = "";
+    TaStr::AddStr(_errString, "ERROR - ", _executableName);
+    _errString += "  Error in DsProcessServer::_poolInit(): ";
+    TaStr::AddStr(_errString, "  Cannot create epoll set: ", strerror(errNum));
+    return -1;
+  }
+
+  struct epoll_event event;
+  memset(&event, 0, sizeof(event));
+  event.events = EPOLLIN;
+  event.data.u64 = _poolTag(POOL_TAG_LISTEN, _serverSocket->getProtoSd());
+  if (epoll_ctl(_epollSd, EPOLL_CTL_ADD,
+                _serverSocket->getProtoSd(), &event)) {
+    int errNum = errno;
+    _errString = "";
+    TaStr::AddStr(_errString, "ERROR - ", _executableName);
+    _errString += "  Error in DsProcessServer::_poolInit(): ";
+    TaStr::AddStr(_errString, "  Cannot add server socket to epoll set: ",
+                  strerror(errNum));
+    return -1;
+  }
+
+  _poolClearStats(time(NULL));
+
+  for (int ii = 0; ii < _poolSize; ii++) {
+    if (_poolSpawnWorker()) {
+      _errString = "";
+      TaStr::AddStr(_errString, "ERROR - ", _executableName);
+      _errString += "  Error in DsProcessServer::_poolInit(): ";
+      _errString += "  Cannot start worker processes";
+      return -1;
+    }
+  }
+
+  return 0;
+
+}
+
+////////////////////////////////////////////////////////////
+// shut down the pool - close connections, stop workers
+
+void DsProcessServer::_poolShutdown()
+
+{
+
+  // closing the channels causes the workers to exit
+  // after they finish any current request
+
+  while (_poolWorkers.size() > 0) {
+    _poolRemoveWorker(_poolWorkers.size() - 1);
+  }
+
+  while (_poolConns.size() > 0) {
+    _poolCloseConn(_poolConns.begin()->first);
+  }
+  _poolReady.clear();
+
+  if (_epollSd >= 0) {
+    close(_epollSd);
+    _epollSd = -1;
+  }
+
+  // reap exited workers
+
+  purgeCompletedThreads();
+
+}
+
+////////////////////////////////////////////////////////////
+// start a worker process
+// returns 0 on success, -1 on failure
+
+int DsProcessServer::_poolSpawnWorker()
+
+{
+
+  int sv[2];
+  if (socketpair(AF_UNIX, SOCK_STREAM, 0, sv)) {
+    if (_isDebug) {
+      cerr << "ERROR - DsProcessServer::_poolSpawnWorker" << endl;
+      cerr << "  Cannot create socket pair: " << strerror(errno) << endl;
+    }
+    return -1;
+  }
+
+  pid_t childPid = fork();
+
+  if (childPid < 0) {
+    if (_isDebug) {
+      cerr << "ERROR - DsProcessServer::_poolSpawnWorker" << endl;
+      cerr << "  Cannot fork: " << strerror(errno) << endl;
+    }
+    close(sv[0]);
+    close(sv[1]);
+    return -1;
+  }
+
+  if (childPid == 0) {
+    // child - does not return
+    close(sv[0]);
+    _poolWorkerMain(sv[1]);
+    _exit(0);
+  }
+
+  // parent
+
+  close(sv[1]);
+
+  struct epoll_event event;
+  memset(&event, 0, sizeof(event));
+  event.events = EPOLLIN;
+  event.data.u64 = _poolTag(POOL_TAG_WORKER, sv[0]);
+  epoll_ctl(_epollSd, EPOLL_CTL_ADD, sv[0], &event);
+
+  PoolWorker worker;
+  worker.pid = childPid;
+  worker.chanSd = sv[0];
+  worker.busy = false;
+  worker.connSd = -1;
+  worker.dispatchTime = 0.0;
+  worker.idleSince = time(NULL);
+  _poolWorkers.push_back(worker);
+
+  if (_isDebug) {
+    cerr << "  Started worker: " << childPid
+         << ", nWorkers: " << _poolWorkers.size() << endl;
+  }
+
+  return 0;
+
+}
+
+////////////////////////////////////////////////////////////
+// main loop for a worker process - never returns
+//
+// Receives connections from the Boss, serves one request on each,
+// and reports back whether the connection is still open.
+
+void DsProcessServer::_poolWorkerMain(int chanSd)
+
+{
+
+  _isChild = true;
+
+  // close the descriptors belonging to the Boss
+
+  _serverSocket->close();
+  close(_epollSd);
+  _epollSd = -1;
+  for (size_t ii = 0; ii < _poolWorkers.size(); ii++) {
+    close(_poolWorkers[ii].chanSd);
+  }
+  _poolWorkers.clear();
+  for (map<int, PoolConn>::iterator it = _poolConns.begin();
+       it != _poolConns.end(); it++) {
+    delete it->second.socket;
+  }
+  _poolConns.clear();
+  _poolReady.clear();
+
+  int nRequests = 0;
+
+  while (true) {
+
+    int sd = _recvSd(chanSd);
+    if (sd < 0) {
+      // Boss has closed the channel, or exited
+      _exit(0);
+    }
+
+    // serve the client, as a forked child would
+
+    Socket *socket = new Socket(sd);
+    ServerSocketStruct *sss = new ServerSocketStruct;
+    sss->socket = socket;
+    sss->server = this;
+    __serveClient(sss);
+
+    bool keepOpen = (socket->isOpen() &&
+                     !socket->hasState(SockUtil::STATE_ERROR));
+    delete socket; // closes this process's copy of the descriptor
+    nRequests++;
+
+    bool exiting = (_poolMaxRequests > 0 && nRequests >= _poolMaxRequests);
+
+    pool_reply_t reply;
+    reply.keepOpen = keepOpen;
+    reply.exiting = exiting;
+    ssize_t nn;
+    while ((nn = write(chanSd, &reply, sizeof(reply))) < 0 && errno == EINTR) {
+    }
+    if (nn != (ssize_t) sizeof(reply) || exiting) {
+      _exit(0);
+    }
+
+  } // while
+
+}
+
+////////////////////////////////////////////////////////////
+// remove a worker from the pool
+// closes the channel, which causes the worker to exit
+
+void DsProcessServer::_poolRemoveWorker(size_t index)
+
+{
+
+  PoolWorker &worker = _poolWorkers[index];
+  epoll_ctl(_epollSd, EPOLL_CTL_DEL, worker.chanSd, NULL);
+  close(worker.chanSd);
+
+  // if the worker was serving a connection, the state of
+  // that connection is unknown, so close it
+
+  if (worker.busy && worker.connSd >= 0) {
+    _poolCloseConn(worker.connSd);
+  }
+
+  _poolWorkers.erase(_poolWorkers.begin() + index);
+
+}
+
+////////////////////////////////////////////////////////////
+// accept pending connections on the server socket
+
+void DsProcessServer::_poolAccept()
+
+{
+
+  while (true) {
+
+    Socket *socket = _serverSocket->getClient(0);
+    if (socket == NULL) {
+      if (_serverSocket->getErrNum() != SockUtil::TIMED_OUT &&
+          _isDebug) {
+        cerr << "Error in DsProcessServer::_poolAccept(): " << endl;
+        cerr << "  ServerSocket error while accepting client." << endl;
+        cerr << _serverSocket->getErrString();
+        cerr << DateTime::str() << endl;
+      }
+      _serverSocket->resetState();
+      _serverSocket->addState(SockUtil::STATE_OPENED);
+      return;
+    }
+
+    //  Got a connection - set last action time to now
+
+    _lastActionTime = time(NULL);
+
+    // Check the client count - can we accept?
+
+    if (_maxClients >= 0 && (int) _poolConns.size() >= _maxClients) {
+
+      string errMsg;
+      TaStr::AddInt(errMsg,
+                    "Service Denied. Too many clients being handled: ",
+                    _poolConns.size());
+      if (_isDebug) {
+	cerr << errMsg << endl;
+      }
+      string statusString;
+      sendReply(socket, DsServerMsg::SERVICE_DENIED,
+                errMsg, statusString, 1000);
+      delete socket;
+      continue;
+
+    }
+
+    int sd = socket->getSd();
+
+    // the connection may carry many requests, so disable Nagle
+    // buffering, which would delay the second part of each
+    // reply until the client acknowledges the first
+
+    int nodelay = 1;
+    setsockopt(sd, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
+
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.u64 = _poolTag(POOL_TAG_CONN, sd);
+    if (epoll_ctl(_epollSd, EPOLL_CTL_ADD, sd, &event)) {
+      delete socket;
+      continue;
+    }
+
+    PoolConn conn;
+    conn.socket = socket;
+    conn.state = CONN_IDLE;
+    conn.readyTime = 0.0;
+    conn.lastActive = _lastActionTime;
+    _poolConns[sd] = conn;
+    _numClients = _poolConns.size();
+
+    if (_isVerbose) {
+      cerr << "Server got a client, sd: " << sd
+           << ", nClients: " << _numClients << endl;
+    }
+
+  } // while
+
+}
+
+////////////////////////////////////////////////////////////
+// A connection is readable - either a request has arrived,
+// or the client has closed the connection.
+
+void DsProcessServer::_poolConnReadable(int sd)
+
+{
+
+  map<int, PoolConn>::iterator it = _poolConns.find(sd);
+  if (it == _poolConns.end()) {
+    return;
+  }
+  PoolConn &conn = it->second;
+
+  // stop watching the connection until it is returned by the worker
+
+  epoll_ctl(_epollSd, EPOLL_CTL_DEL, sd, NULL);
+
+  // check for closed connection
+
+  char cc;
+  ssize_t nn = recv(sd, &cc, 1, MSG_PEEK | MSG_DONTWAIT);
+  if (nn == 0 || (nn < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) {
+    _poolCloseConn(sd);
+    return;
+  }
+  if (nn < 0) {
+    // spurious wakeup - watch again
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.u64 = _poolTag(POOL_TAG_CONN, sd);
+    epoll_ctl(_epollSd, EPOLL_CTL_ADD, sd, &event);
+    return;
+  }
+
+  // request has arrived - queue for a worker
+
+  conn.state = CONN_READY;
+  conn.readyTime = _poolTimeNow();
+  _poolReady.push_back(sd);
+
+}
+
+////////////////////////////////////////////////////////////
+// close a connection and remove it from the pool
+
+void DsProcessServer::_poolCloseConn(int sd)
+
+{
+
+  map<int, PoolConn>::iterator it = _poolConns.find(sd);
+  if (it == _poolConns.end()) {
+    return;
+  }
+  if (it->second.state == CONN_IDLE) {
+    epoll_ctl(_epollSd, EPOLL_CTL_DEL, sd, NULL);
+  } else if (it->second.state == CONN_READY) {
+    for (deque<int>::iterator jj = _poolReady.begin();
+         jj != _poolReady.end(); jj++) {
+      if (*jj == sd) {
+        _poolReady.erase(jj);
+        break;
+      }
+    }
+  }
+  delete it->second.socket;
+  _poolConns.erase(it);
+
+  _numClients = _poolConns.size();
+  _lastActionTime = time(NULL);
+
+}
+
+////////////////////////////////////////////////////////////
+// pass queued connections to idle workers,
+// starting new workers if needed.
+// Returns the number of connections dispatched.
+
+int DsProcessServer::_poolDispatch()
+
+{
+
+  if ((int) _poolReady.size() > _poolStats.maxQueueDepth) {
+    _poolStats.maxQueueDepth = _poolReady.size();
+  }
+
+  int nDispatched = 0;
+
+  while (_poolReady.size() > 0) {
+
+    // find an idle worker
+
+    int index = -1;
+    for (size_t ii = 0; ii < _poolWorkers.size(); ii++) {
+      if (!_poolWorkers[ii].busy) {
+        index = ii;
+        break;
+      }
+    }
+    if (index < 0) {
+      if ((int) _poolWorkers.size() >= _poolMaxWorkers) {
+        // all busy - requests stay queued
+        break;
+      }
+      if (_poolSpawnWorker()) {
+        break;
+      }
+      index = _poolWorkers.size() - 1;
+    }
+
+    int sd = _poolReady.front();
+    _poolReady.pop_front();
+    PoolWorker &worker = _poolWorkers[index];
+
+    if (_sendSd(worker.chanSd, sd)) {
+      // worker has gone away - requeue the connection
+      _poolReady.push_front(sd);
+      _poolRemoveWorker(index);
+      continue;
+    }
+
+    worker.busy = true;
+    worker.connSd = sd;
+    worker.dispatchTime = _poolTimeNow();
+    PoolConn &conn = _poolConns[sd];
+    conn.state = CONN_BUSY;
+
+    double waitSecs = worker.dispatchTime - conn.readyTime;
+    _poolStats.sumWaitSecs += waitSecs;
+    if (waitSecs > _poolStats.maxWaitSecs) {
+      _poolStats.maxWaitSecs = waitSecs;
+    }
+
+    nDispatched++;
+
+  } // while
+
+  return nDispatched;
+
+}
+
+////////////////////////////////////////////////////////////
+// handle reply from worker
+
+void DsProcessServer::_poolWorkerReply(size_t index)
+
+{
+
+  PoolWorker &worker = _poolWorkers[index];
+
+  pool_reply_t reply;
+  ssize_t nn;
+  while ((nn = read(worker.chanSd, &reply, sizeof(reply))) < 0 &&
+         errno == EINTR) {
+  }
+  if (nn != (ssize_t) sizeof(reply)) {
+    // worker has exited
+    if (_isDebug) {
+      cerr << "  Worker exited, pid: " << worker.pid << endl;
+    }
+    _poolRemoveWorker(index);
+    return;
+  }
+
+  // update stats
+
+  time_t now = time(NULL);
+  double serviceSecs = _poolTimeNow() - worker.dispatchTime;
+  _poolStats.nRequests++;
+  _poolStats.sumServiceSecs += serviceSecs;
+  if (serviceSecs > _poolStats.maxServiceSecs) {
+    _poolStats.maxServiceSecs = serviceSecs;
+  }
+  _lastActionTime = now;
+
+  // return the connection to the epoll set, or close it
+
+  int sd = worker.connSd;
+  worker.busy = false;
+  worker.connSd = -1;
+  worker.idleSince = now;
+
+  map<int, PoolConn>::iterator it = _poolConns.find(sd);
+  if (it != _poolConns.end()) {
+    bool keepOpen = reply.keepOpen && _keepAliveSecs > 0;
+    if (keepOpen) {
+      struct epoll_event event;
+      memset(&event, 0, sizeof(event));
+      event.events = EPOLLIN;
+      event.data.u64 = _poolTag(POOL_TAG_CONN, sd);
+      if (epoll_ctl(_epollSd, EPOLL_CTL_ADD, sd, &event)) {
+        keepOpen = false;
+      }
+    }
+    if (keepOpen) {
+      it->second.state = CONN_IDLE;
+      it->second.lastActive = now;
+    } else {
+      it->second.state = CONN_IDLE;
+      _poolCloseConn(sd);
+    }
+  }
+
+  if (reply.exiting) {
+    if (_isVerbose) {
+      cerr << "  Worker reached max requests, pid: " << worker.pid << endl;
+    }
+    _poolRemoveWorker(index);
+  }
+
+}
+
+////////////////////////////////////////////////////////////
+// reap exited worker processes
+
+void DsProcessServer::_poolReapWorkers()
+
+{
+
+  pid_t dead_pid;
+  int status;
+
+  while ((dead_pid = waitpid((pid_t) -1, &status, WNOHANG)) > 0) {
+
+    // if exited with SIGQUIT, this tells us that the worker received a
+    // shutdown message, so we should set the _doShutdown flag
+
+    if (WIFEXITED(status)) {
+      if (WEXITSTATUS(status) == SIGQUIT) {
+	_doShutdown = true;
+      }
+    }
+
+    if (_isVerbose) {
+      cerr << "Worker died, pid: " << dead_pid << endl;
+    }
+
+    // remove from pool if still there
+
+    for (size_t ii = 0; ii < _poolWorkers.size(); ii++) {
+      if (_poolWorkers[ii].pid == dead_pid) {
+        _poolRemoveWorker(ii);
+        break;
+      }
+    }
+
+  } // while
+
+}
+
+////////////////////////////////////////////////////////////
+// periodic housekeeping, at most once per sec unless forced
+//   o close kept-alive connections idle too long
+//   o retire extra idle workers, keep the pool at its size
+//   o reap exited workers
+//   o print stats
+
+void DsProcessServer::_poolHousekeeping(bool force)
+
+{
+
+  time_t now = time(NULL);
+  if (!force && now == _poolLastHousekeeping) {
+    return;
+  }
+  _poolLastHousekeeping = now;
+
+  // idle connections
+
+  vector<int> expired;
+  for (map<int, PoolConn>::iterator it = _poolConns.begin();
+       it != _poolConns.end(); it++) {
+    if (it->second.state == CONN_IDLE &&
+        now - it->second.lastActive > _keepAliveSecs) {
+      expired.push_back(it->first);
+    }
+  }
+  for (size_t ii = 0; ii < expired.size(); ii++) {
+    _poolCloseConn(expired[ii]);
+  }
+
+  // retire one extra idle worker at a time
+
+  if ((int) _poolWorkers.size() > _poolSize) {
+    for (size_t ii = 0; ii < _poolWorkers.size(); ii++) {
+      if (!_poolWorkers[ii].busy &&
+          now - _poolWorkers[ii].idleSince > POOL_WORKER_IDLE_SECS) {
+        _poolRemoveWorker(ii);
+        break;
+      }
+    }
+  }
+
+  // replace workers which have exited
+
+  while ((int) _poolWorkers.size() < _poolSize) {
+    if (_poolSpawnWorker()) {
+      break;
+    }
+  }
+
+  _poolReapWorkers();
+
+  // stats
+
+  if (now - _poolStats.startTime >= POOL_STATS_INTERVAL_SECS) {
+    if (_isDebug) {
+      _poolPrintStats(now);
+    }
+    _poolClearStats(now);
+  }
+
+}
+
+////////////////////////////////////////////////////////////
+// print the request stats
+
+void DsProcessServer::_poolPrintStats(time_t now)
+
+{
+
+  int nBusy = 0;
+  for (size_t ii = 0; ii < _poolWorkers.size(); ii++) {
+    if (_poolWorkers[ii].busy) {
+      nBusy++;
+    }
+  }
+
+  const PoolStats &stats = _poolStats;
+  double meanWait = 0.0, meanService = 0.0;
+  if (stats.nRequests > 0) {
+    meanWait = stats.sumWaitSecs / stats.nRequests;
+    meanService = stats.sumServiceSecs / stats.nRequests;
+  }
+
+  cerr << "======== DsProcessServer worker pool ========" << endl;
+  cerr << "  " << DateTime::str(now) << ", port: " << _port << endl;
+  cerr << "  Period (secs): " << now - stats.startTime << endl;
+  cerr << "  nRequests: " << stats.nRequests << endl;
+  cerr << "  Queue wait (msecs) mean, max: "
+       << meanWait * 1000.0 << ", " << stats.maxWaitSecs * 1000.0 << endl;
+  cerr << "  Service time (msecs) mean, max: "
+       << meanService * 1000.0 << ", "
+       << stats.maxServiceSecs * 1000.0 << endl;
+  cerr << "  Queue depth now, max: "
+       << _poolReady.size() << ", " << stats.maxQueueDepth << endl;
+  cerr << "  Workers busy, total: "
+       << nBusy << ", " << _poolWorkers.size() << endl;
+  cerr << "  Open connections: " << _poolConns.size() << endl;
+  cerr << "=============================================" << endl;
+
+}
+
+////////////////////////////////////////////////////////////
+// clear the request stats
+
+void DsProcessServer::_poolClearStats(time_t now)
+
+{
+  _poolStats.nRequests = 0;
+  _poolStats.sumWaitSecs = 0.0;
+  _poolStats.maxWaitSecs = 0.0;
+  _poolStats.sumServiceSecs = 0.0;
+  _poolStats.maxServiceSecs = 0.0;
+  _poolStats.maxQueueDepth = 0;
+  _poolStats.startTime = now;
+}
+
+////////////////////////////////////////////////////////////
+// get current time in secs, with sub-sec resolution
+
+double DsProcessServer::_poolTimeNow()
+
+{
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return tv.tv_sec + tv.tv_usec / 1.0e6;
+}
+
+#else
+
+// worker pool is not supported on this system
+
+void DsProcessServer::_poolReapWorkers()
+{
+}
+
+#endif
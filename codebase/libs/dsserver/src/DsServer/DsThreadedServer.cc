@@ -65,6 +65,11 @@ DsThreadedServer::DsThreadedServer(const string & executableName,
 
 {
 
+  // clients are handled by threads sharing this object,
+  // so the worker process pool is not used
+
+  _poolSize = 0;
+
   if (!_isNoThreadDebug) {
     pthread_mutex_init(&_threadStatusMutex, NULL);
     pthread_mutex_init(&_procmapInfoMutex, NULL);
@@ -61,6 +61,17 @@ public:
   //
   // Forwarding via a proxy and/or tunnel is handled.
   //
+  // If the environment variable DS_CLIENT_KEEPALIVE is set to "true",
+  // connections made without forwarding are kept open after the reply,
+  // and reused by later requests to the same host and port from this
+  // process. This is useful with servers running in worker pool mode
+  // (see DsProcessServer). Idle connections are dropped after
+  // DS_CLIENT_KEEPALIVE_SECS (default 30). If the server has closed
+  // a reused connection - the write fails, or the connection is closed
+  // or reset before any reply arrives - the request is retried once on
+  // a new connection. It is not retried after a read timeout, or after
+  // a partial reply, since the server may already have applied it.
+  //
   // After success, retrieve the returned message
   // using getReplyBuf() and getReplyLen().
   //
@@ -118,6 +129,18 @@ protected:
 			const void *msgBuf, ssize_t msgLen,
 			int commTimeoutMsecs);
   
+  int _communicateNoFwd(const DsURL &url, int msgType,
+			const void *msgBuf, ssize_t msgLen,
+			int commTimeoutMsecs, bool allowReuse);
+
+  int _peekReply(int timeoutMsecs);
+  
+  // cache of kept-alive connections, shared by all DsClient objects
+  
+  static bool _keepAliveEnabled();
+  static int _getKeptAlive(const string &host, int port);
+  static void _putKeptAlive(const string &host, int port, int sd);
+  
   int _communicateFwd(const DsURL &url, int msgType,
 		      const void *msgBuf, ssize_t msgLen,
 		      int commTimeoutMsecs, bool &tunnelFailed);
@@ -28,6 +28,9 @@
 #include <toolsa/umisc.h>
 
 #include <string>
+#include <vector>
+#include <map>
+#include <deque>
 using namespace std;
 
 class Socket;
@@ -120,6 +123,42 @@ class ServerSocket;
 //     _isVerbose;
 //     _isSecure
 //     _isReadOnly
+//
+// Worker pool mode:
+// -----------------
+//
+// As an alternative to forking a child per client, the server can
+// run a pool of pre-forked worker processes (Linux only).
+//   o The Boss process holds all client connections in an epoll set,
+//     and accepts new connections as they arrive.
+//   o When a request arrives on a connection, the connection is queued,
+//     and passed to an idle worker process over a unix-domain socket.
+//   o The worker handles the request as a forked child would, and
+//     then tells the Boss whether the connection is still open.
+//   o Open connections are kept alive in the epoll set for further
+//     requests, until idle for more than the keep-alive time.
+//   o Workers are started on demand up to a maximum, and idle workers
+//     above the pool size are retired. Each worker exits after a
+//     given number of requests, and is replaced as needed.
+//   o Queue wait and service times per request, and the depth of the
+//     request queue, are printed every 60 secs in debug mode.
+//
+// Worker processes are long-lived, so a handler should not rely on
+// the server object being a fresh copy of the Boss for every request.
+//
+// Pool mode is selected at startup, without code changes, by setting
+// the environment variable DS_SERVER_POOL_SIZE to the number of
+// workers to keep running. It may also be set using setWorkerPool().
+// Other environment variables:
+//   DS_SERVER_POOL_MAX_WORKERS: max number of workers (default
+//     max clients).
+//   DS_SERVER_POOL_MAX_REQUESTS: requests per worker before it
+//     is replaced (default 1000, 0 for no limit).
+//   DS_SERVER_KEEPALIVE_SECS: idle time before a kept-alive
+//     connection is closed (default 60).
+//
+// Pool mode is not used with HTTP-wrapped messages, or in no-thread
+// debug mode, or by DsThreadedServer.
 
 class DsProcessServer {
   
@@ -164,6 +203,18 @@ public:
   void setNoThreadDebug(bool isNoThread) { _isNoThreadDebug = isNoThread; }
   bool isNoThreadDebug() const { return _isNoThreadDebug; }
 
+  // Use a pool of pre-forked worker processes instead of forking a
+  //   child per client. See the worker pool notes above.
+  //   poolSize: number of workers to keep running. 0 for fork per client.
+  //   maxWorkers: max number of workers. If not positive, uses
+  //     max clients.
+  //   Overrides DS_SERVER_POOL_SIZE and DS_SERVER_POOL_MAX_WORKERS.
+  // 
+  // Threads: Should only be called before waitForClients().
+  // 
+  void setWorkerPool(int poolSize, int maxWorkers = -1);
+  int getWorkerPoolSize() const { return _poolSize; }
+
   // Block and wait for clients.
   //   If a positive timeoutMSecs is provided, the wait times out,
   //     PMU registration is performed, and timeoutMethod() is called.
@@ -509,8 +560,79 @@ protected:
 
   static void *__serveClient(void * svrsockstruct);
 
+  // Worker pool settings.
+  // 
+  // Threads: Should only be set before calling waitForClients().
+  // 
+  int _poolSize;
+  int _poolMaxWorkers;
+  int _poolMaxRequests;
+  int _keepAliveSecs;
+
 private:
 
+  // Worker pool state - Boss process only
+
+  class PoolWorker {
+  public:
+    pid_t pid;
+    int chanSd;          // unix socket to the worker
+    bool busy;
+    int connSd;          // connection being served, if busy
+    double dispatchTime; // time connection was passed to worker
+    time_t idleSince;
+  };
+
+  typedef enum {
+    CONN_IDLE,  // waiting for a request, in the epoll set
+    CONN_READY, // request arrived, queued for a worker
+    CONN_BUSY   // being served by a worker
+  } conn_state_t;
+
+  class PoolConn {
+  public:
+    Socket *socket;
+    conn_state_t state;
+    double readyTime;   // time request arrived
+    time_t lastActive;
+  };
+
+  class PoolStats {
+  public:
+    int nRequests;
+    double sumWaitSecs;
+    double maxWaitSecs;
+    double sumServiceSecs;
+    double maxServiceSecs;
+    int maxQueueDepth;
+    time_t startTime;
+  };
+
+  int _epollSd;
+  vector<PoolWorker> _poolWorkers;
+  map<int, PoolConn> _poolConns;
+  deque<int> _poolReady;
+  PoolStats _poolStats;
+  time_t _poolLastHousekeeping;
+
+  int _waitForClientsPool(int timeoutMSecs);
+  int _poolInit();
+  void _poolShutdown();
+  int _poolSpawnWorker();
+  void _poolWorkerMain(int chanSd);
+  void _poolRemoveWorker(size_t index);
+  void _poolAccept();
+  void _poolConnReadable(int sd);
+  void _poolCloseConn(int sd);
+  int _poolDispatch();
+  void _poolWorkerReply(size_t index);
+  void _poolReapWorkers();
+  void _poolHousekeeping(bool force);
+  void _poolPrintStats(time_t now);
+  void _poolClearStats(time_t now);
+  static double _poolTimeNow();
+
+
   // Private methods with no bodies. DO NOT USE!
   // 
   DsProcessServer();
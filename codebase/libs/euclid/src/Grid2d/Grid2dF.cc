@@ -0,0 +1,124 @@
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* 
+// ** Copyright UCAR (c) 1990 - 2016                                         
+// ** University Corporation for Atmospheric Research (UCAR)                 
+// ** National Center for Atmospheric Research (NCAR)                        
+// ** Boulder, Colorado, USA                                                 
+// ** BSD licence applies - redistribution and use in source and binary      
+// ** forms, with or without modification, are permitted provided that       
+// ** the following conditions are met:                                      
+// ** 1) If the software is modified to produce derivative works,            
+// ** such modified software should be clearly marked, so as not             
+// ** to confuse it with the version available from UCAR.                    
+// ** 2) Redistributions of source code must retain the above copyright      
+// ** notice, this list of conditions and the following disclaimer.          
+// ** 3) Redistributions in binary form must reproduce the above copyright   
+// ** notice, this list of conditions and the following disclaimer in the    
+// ** documentation and/or other materials provided with the distribution.   
+// ** 4) Neither the name of UCAR nor the names of its contributors,         
+// ** if any, may be used to endorse or promote products derived from        
+// ** this software without specific prior written permission.               
+// ** DISCLAIMER: THIS SOFTWARE IS PROVIDED "AS IS" AND WITHOUT ANY EXPRESS  
+// ** OR IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED      
+// ** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.    
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* 
+/**
+ * @file Grid2dF.cc
+ * @brief two dimensional float data grid, with a validity mask
+ */
+
+#include <euclid/Grid2dF.hh>
+#include <euclid/Grid2d.hh>
+
+//---------------------------------------------------------------------------
+Grid2dF::Grid2dF(void) : _name("Unknown"), _npt(0), _nx(0), _ny(0)
+{
+}
+
+//---------------------------------------------------------------------------
+Grid2dF::Grid2dF(const std::string &name, int nx, int ny) : _name(name)
+{
+  _resize(nx, ny);
+}
+
+//---------------------------------------------------------------------------
+Grid2dF::Grid2dF(const Grid2d &g) : _name(g.getName())
+{
+  _resize(g.getNx(), g.getNy());
+  const std::vector<double> &d = g.getData();
+  double missing = g.getMissing();
+  for (int i=0; i<_npt; ++i)
+  {
+    if (d[i] != missing)
+    {
+      _data[i] = static_cast<float>(d[i]);
+      _mask[i >> 6] |= (static_cast<uint64_t>(1) << (i & 63));
+    }
+  }
+}
+
+//---------------------------------------------------------------------------
+Grid2dF::~Grid2dF()
+{
+}
+
+//---------------------------------------------------------------------------
+Grid2d Grid2dF::toGrid2d(double missing) const
+{
+  std::vector<double> d(_npt);
+  for (int i=0; i<_npt; ++i)
+  {
+    d[i] = isValid(i) ? _data[i] : missing;
+  }
+  return Grid2d(_name, _nx, _ny, d, missing);
+}
+
+//---------------------------------------------------------------------------
+bool Grid2dF::dimensionsEqual(const Grid2dF &g) const
+{
+  return _nx == g._nx && _ny == g._ny;
+}
+
+//---------------------------------------------------------------------------
+void Grid2dF::setAllMissing(void)
+{
+  _data.assign(_npt, 0.0);
+  _mask.assign(_mask.size(), 0);
+}
+
+//---------------------------------------------------------------------------
+int Grid2dF::numGood(void) const
+{
+  int n = 0;
+  for (size_t i=0; i<_mask.size(); ++i)
+  {
+    n += __builtin_popcountll(_mask[i]);
+  }
+  return n;
+}
+
+//---------------------------------------------------------------------------
+size_t Grid2dF::dataBytes(void) const
+{
+  return _data.size()*sizeof(float) + _mask.size()*sizeof(uint64_t);
+}
+
+//---------------------------------------------------------------------------
+void Grid2dF::_unpackRow(int y, float *ok) const
+{
+  int i0 = y*_nx;
+  for (int x=0; x<_nx; ++x)
+  {
+    int i = i0 + x;
+    ok[x] = static_cast<float>((_mask[i >> 6] >> (i & 63)) & 1);
+  }
+}
+
+//---------------------------------------------------------------------------
+void Grid2dF::_resize(int nx, int ny)
+{
+  _nx = nx;
+  _ny = ny;
+  _npt = nx*ny;
+  _data.assign(_npt, 0.0);
+  _mask.assign((_npt + 63)/64, 0);
+}
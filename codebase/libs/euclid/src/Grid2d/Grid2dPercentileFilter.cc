@@ -0,0 +1,349 @@
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* 
+// ** Copyright UCAR (c) 1990 - 2016                                         
+// ** University Corporation for Atmospheric Research (UCAR)                 
+// ** National Center for Atmospheric Research (NCAR)                        
+// ** Boulder, Colorado, USA                                                 
+// ** BSD licence applies - redistribution and use in source and binary      
+// ** forms, with or without modification, are permitted provided that       
+// ** the following conditions are met:                                      
+// ** 1) If the software is modified to produce derivative works,            
+// ** such modified software should be clearly marked, so as not             
+// ** to confuse it with the version available from UCAR.                    
+// ** 2) Redistributions of source code must retain the above copyright      
+// ** notice, this list of conditions and the following disclaimer.          
+// ** 3) Redistributions in binary form must reproduce the above copyright   
+// ** notice, this list of conditions and the following disclaimer in the    
+// ** documentation and/or other materials provided with the distribution.   
+// ** 4) Neither the name of UCAR nor the names of its contributors,         
+// ** if any, may be used to endorse or promote products derived from        
+// ** this software without specific prior written permission.               
+// ** DISCLAIMER: THIS SOFTWARE IS PROVIDED "AS IS" AND WITHOUT ANY EXPRESS  
+// ** OR IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED      
+// ** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.    
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* 
+/**
+ * @file Grid2dPercentileFilter.cc
+ */
+
+#include <euclid/Grid2dPercentileFilter.hh>
+#include <euclid/Grid2d.hh>
+#include <toolsa/TaThreadSimple.hh>
+#include <toolsa/LogStream.hh>
+#include <algorithm>
+#include <cstring>
+using std::vector;
+
+//----------------------------------------------------------------
+static inline void _addHist(int *h, const int *c, int n)
+{
+  for (int i=0; i<n; ++i)
+  {
+    h[i] += c[i];
+  }
+}
+
+//----------------------------------------------------------------
+static inline void _subtractHist(int *h, const int *c, int n)
+{
+  for (int i=0; i<n; ++i)
+  {
+    h[i] -= c[i];
+  }
+}
+
+//----------------------------------------------------------------
+TaThread *Grid2dPercentileFilter::PercentileThreads::clone(int index)
+{
+  TaThreadSimple *t = new TaThreadSimple(index);
+  t->setThreadMethod(Grid2dPercentileFilter::compute);
+  t->setThreadContext(this);
+  return (TaThread *)t;
+}
+
+//----------------------------------------------------------------
+Grid2dPercentileFilter::Grid2dPercentileFilter(const Grid2d &g, int sx, int sy,
+					       double binMin, double binMax,
+					       double binDelta) :
+  _name(g.getName()), _nx(g.getNx()), _ny(g.getNy()),
+  _missing(g.getMissing()), _sx(sx), _sy(sy), _binMin(binMin),
+  _binDelta(binDelta)
+{
+  if (_sx < 0)
+  {
+    _sx = 0;
+  }
+  if (_sy < 0)
+  {
+    _sy = 0;
+  }
+  _nbin = static_cast<int>((binMax-_binMin)/_binDelta) + 1;
+  if (_nbin < 1)
+  {
+    _nbin = 1;
+  }
+  _ncoarse = (_nbin + _nfine - 1) >> _fineShift;
+
+  // bin each point once, as in Grid2dLoopAlgMedian
+  _index.resize(_nx*_ny);
+  for (int i=0; i<_nx*_ny; ++i)
+  {
+    double v;
+    if (g.getValue(i, v))
+    {
+      int index = static_cast<int>((v - _binMin)/_binDelta);
+      if (index < 0)
+      {
+	index = 0;
+      }
+      if (index >= _nbin)
+      {
+	index = _nbin-1;
+      }
+      _index[i] = index;
+    }
+    else
+    {
+      _index[i] = -1;
+    }
+  }
+}
+
+//----------------------------------------------------------------
+Grid2dPercentileFilter::~Grid2dPercentileFilter()
+{
+}
+
+//----------------------------------------------------------------
+void Grid2dPercentileFilter::apply(const vector<double> &pct, int minGood,
+				   int numThread,
+				   vector<Grid2d> &out,
+				   vector<unsigned char> &valid) const
+{
+  out.clear();
+  for (size_t i=0; i<pct.size(); ++i)
+  {
+    out.push_back(Grid2d(_name, _nx, _ny, _missing));
+  }
+  // one byte per point, so that bands can be written by threads
+  // without sharing words
+  valid.assign(_nx*_ny, 0);
+  if (pct.empty() || _nx < 1 || _ny < 1)
+  {
+    return;
+  }
+
+  // one band of rows per thread, each band pays for filling its
+  // column histograms once
+  int nband = numThread;
+  if (nband < 1)
+  {
+    nband = 1;
+  }
+  if (nband > _ny)
+  {
+    nband = _ny;
+  }
+
+  PercentileThreads thread;
+  thread.init(numThread, false);
+  for (int i=0; i<nband; ++i)
+  {
+    int y0 = (i*_ny)/nband;
+    int y1 = ((i+1)*_ny)/nband;
+    BandInfo *info = new BandInfo(this, y0, y1, pct, minGood, out, valid);
+    thread.thread(i, (void *)info);
+  }
+  thread.waitForThreads();
+}
+
+//----------------------------------------------------------------
+void Grid2dPercentileFilter::compute(void *ti)
+{
+  BandInfo *info = static_cast<BandInfo *>(ti);
+  info->_filter->_filterBand(info->_y0, info->_y1, info->_pct,
+			     info->_minGood, info->_out, info->_valid);
+  delete info;
+}
+
+//----------------------------------------------------------------
+void Grid2dPercentileFilter::_filterBand(int y0, int y1,
+					 const vector<double> &pct,
+					 int minGood,
+					 vector<Grid2d> &out,
+					 vector<unsigned char> &valid) const
+{
+  int nf = _ncoarse*_nfine;   // fine bins, padded to whole coarse bins
+  int nc = _ncoarse;
+
+  // histograms for each column, over the rows in the window
+  vector<int> colFine(_nx*nf, 0);
+  vector<int> colCoarse(_nx*nc, 0);
+  vector<int> colN(_nx, 0);
+
+  // histograms for the window.  The fine histogram for coarse bin c is
+  // valid for the window at x = fineX[c], or not at all if fineX[c] < 0
+  vector<int> fine(nf, 0);
+  vector<int> coarse(nc, 0);
+  vector<int> fineX(nc, -1);
+
+  for (int y=y0-_sy; y<=y0+_sy; ++y)
+  {
+    if (y < 0 || y >= _ny)
+    {
+      continue;
+    }
+    const int *ip = &_index[y*_nx];
+    for (int x=0; x<_nx; ++x)
+    {
+      if (ip[x] >= 0)
+      {
+	colFine[x*nf + ip[x]]++;
+	colCoarse[x*nc + (ip[x] >> _fineShift)]++;
+	colN[x]++;
+      }
+    }
+  }
+
+  for (int y=y0; y<y1; ++y)
+  {
+    if (y > y0)
+    {
+      // move the column histograms up one row
+      int yo = y - _sy - 1;
+      int yi = y + _sy;
+      if (yo >= 0)
+      {
+	const int *ip = &_index[yo*_nx];
+	for (int x=0; x<_nx; ++x)
+	{
+	  if (ip[x] >= 0)
+	  {
+	    colFine[x*nf + ip[x]]--;
+	    colCoarse[x*nc + (ip[x] >> _fineShift)]--;
+	    colN[x]--;
+	  }
+	}
+      }
+      if (yi < _ny)
+      {
+	const int *ip = &_index[yi*_nx];
+	for (int x=0; x<_nx; ++x)
+	{
+	  if (ip[x] >= 0)
+	  {
+	    colFine[x*nf + ip[x]]++;
+	    colCoarse[x*nc + (ip[x] >> _fineShift)]++;
+	    colN[x]++;
+	  }
+	}
+      }
+    }
+
+    // the window at x=0
+    std::fill(coarse.begin(), coarse.end(), 0);
+    std::fill(fineX.begin(), fineX.end(), -1);
+    int n = 0;
+    for (int x=0; x<=_sx && x<_nx; ++x)
+    {
+      _addHist(&coarse[0], &colCoarse[x*nc], nc);
+      n += colN[x];
+    }
+
+    for (int x=0; x<_nx; ++x)
+    {
+      if (x > 0)
+      {
+	int xo = x - _sx - 1;
+	int xi = x + _sx;
+	if (xo >= 0)
+	{
+	  _subtractHist(&coarse[0], &colCoarse[xo*nc], nc);
+	  n -= colN[xo];
+	}
+	if (xi < _nx)
+	{
+	  _addHist(&coarse[0], &colCoarse[xi*nc], nc);
+	  n += colN[xi];
+	}
+      }
+
+      int ipt = y*_nx + x;
+      if (n < minGood)
+      {
+	continue;
+      }
+      valid[ipt] = 1;
+
+      for (size_t k=0; k<pct.size(); ++k)
+      {
+	// the first bin at which the cumulative count reaches the target,
+	// as in Grid2dLoopAlgMedian
+	int target = static_cast<int>(pct[k]*static_cast<double>(n));
+	int bin = 0;
+	if (target > 0)
+	{
+	  int count = 0;
+	  int c;
+	  for (c=0; c<nc-1; ++c)
+	  {
+	    if (count + coarse[c] >= target)
+	    {
+	      break;
+	    }
+	    count += coarse[c];
+	  }
+
+	  // bring the fine histogram for this coarse bin up to date, either
+	  // by moving it along from where it was last used or, if that
+	  // would be more work, by summing the columns in the window
+	  int *f = &fine[c*_nfine];
+	  int last = fineX[c];
+	  if (last < 0 || x - last > _sx)
+	  {
+	    memset(f, 0, _nfine*sizeof(int));
+	    int xa = std::max(0, x - _sx);
+	    int xb = std::min(_nx - 1, x + _sx);
+	    for (int xx=xa; xx<=xb; ++xx)
+	    {
+	      _addHist(f, &colFine[xx*nf + c*_nfine], _nfine);
+	    }
+	  }
+	  else
+	  {
+	    for (int xx=last+1; xx<=x; ++xx)
+	    {
+	      int xo = xx - _sx - 1;
+	      int xi = xx + _sx;
+	      if (xo >= 0)
+	      {
+		_subtractHist(f, &colFine[xo*nf + c*_nfine], _nfine);
+	      }
+	      if (xi < _nx)
+	      {
+		_addHist(f, &colFine[xi*nf + c*_nfine], _nfine);
+	      }
+	    }
+	  }
+	  fineX[c] = x;
+
+	  int j;
+	  for (j=0; j<_nfine-1; ++j)
+	  {
+	    count += f[j];
+	    if (count >= target)
+	    {
+	      break;
+	    }
+	  }
+	  bin = c*_nfine + j;
+	  if (bin >= _nbin)
+	  {
+	    LOG(ERROR) << "percentile bin out of range " << bin;
+	    bin = _nbin - 1;
+	  }
+	}
+	out[k][ipt] = _binMin + _binDelta*bin;
+      }
+    }
+  }
+}
@@ -0,0 +1,178 @@
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* 
+// ** Copyright UCAR (c) 1990 - 2016                                         
+// ** University Corporation for Atmospheric Research (UCAR)                 
+// ** National Center for Atmospheric Research (NCAR)                        
+// ** Boulder, Colorado, USA                                                 
+// ** BSD licence applies - redistribution and use in source and binary      
+// ** forms, with or without modification, are permitted provided that       
+// ** the following conditions are met:                                      
+// ** 1) If the software is modified to produce derivative works,            
+// ** such modified software should be clearly marked, so as not             
+// ** to confuse it with the version available from UCAR.                    
+// ** 2) Redistributions of source code must retain the above copyright      
+// ** notice, this list of conditions and the following disclaimer.          
+// ** 3) Redistributions in binary form must reproduce the above copyright   
+// ** notice, this list of conditions and the following disclaimer in the    
+// ** documentation and/or other materials provided with the distribution.   
+// ** 4) Neither the name of UCAR nor the names of its contributors,         
+// ** if any, may be used to endorse or promote products derived from        
+// ** this software without specific prior written permission.               
+// ** DISCLAIMER: THIS SOFTWARE IS PROVIDED "AS IS" AND WITHOUT ANY EXPRESS  
+// ** OR IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED      
+// ** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.    
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* 
+/**
+ * @file Grid2dSummedArea.cc
+ * @brief Summed area tables for a Grid2d, for fast box statistics
+ */
+
+#include <euclid/Grid2dSummedArea.hh>
+#include <euclid/Grid2d.hh>
+#include <cmath>
+
+//---------------------------------------------------------------------------
+Grid2dSummedArea::Grid2dSummedArea(const Grid2d &g, bool needSquares) :
+  _nx(g.getNx()), _ny(g.getNy()), _offset(0.0)
+{
+  int n = (_nx + 1)*(_ny + 1);
+  _sum.assign(n, 0.0);
+  _count.assign(n, 0);
+  if (needSquares)
+  {
+    _sumSq.assign(n, 0.0);
+  }
+
+  // offset by the mean of the grid
+
+  int ngood = 0;
+  for (int y=0; y<_ny; ++y)
+  {
+    for (int x=0; x<_nx; ++x)
+    {
+      double v;
+      if (g.getValue(x, y, v))
+      {
+	_offset += v;
+	ngood++;
+      }
+    }
+  }
+  if (ngood > 0)
+  {
+    _offset /= ngood;
+  }
+
+  // each entry is the row total so far, plus the entry above
+  for (int y=0; y<_ny; ++y)
+  {
+    double rowSum = 0.0, rowSumSq = 0.0;
+    int rowCount = 0;
+    for (int x=0; x<_nx; ++x)
+    {
+      double v;
+      if (g.getValue(x, y, v))
+      {
+	v -= _offset;
+	rowSum += v;
+	rowSumSq += v*v;
+	rowCount++;
+      }
+      int i = _ipt(x+1, y+1);
+      int iAbove = _ipt(x+1, y);
+      _sum[i] = _sum[iAbove] + rowSum;
+      _count[i] = _count[iAbove] + rowCount;
+      if (needSquares)
+      {
+	_sumSq[i] = _sumSq[iAbove] + rowSumSq;
+      }
+    }
+  }
+}
+
+//---------------------------------------------------------------------------
+Grid2dSummedArea::~Grid2dSummedArea()
+{
+}
+
+//---------------------------------------------------------------------------
+int Grid2dSummedArea::count(int x0, int x1, int y0, int y1) const
+{
+  if (!_clip(x0, x1, y0, y1))
+  {
+    return 0;
+  }
+  return _boxTotal(_count, x0, x1, y0, y1);
+}
+
+//---------------------------------------------------------------------------
+double Grid2dSummedArea::sum(int x0, int x1, int y0, int y1) const
+{
+  if (!_clip(x0, x1, y0, y1))
+  {
+    return 0.0;
+  }
+  return _boxTotal(_sum, x0, x1, y0, y1) +
+    _offset*_boxTotal(_count, x0, x1, y0, y1);
+}
+
+//---------------------------------------------------------------------------
+bool Grid2dSummedArea::mean(int x0, int x1, int y0, int y1, int minGood,
+			    double &mean) const
+{
+  if (!_clip(x0, x1, y0, y1))
+  {
+    return false;
+  }
+  int n = _boxTotal(_count, x0, x1, y0, y1);
+  if (n <= minGood || n <= 0)
+  {
+    return false;
+  }
+  mean = _offset + _boxTotal(_sum, x0, x1, y0, y1)/n;
+  return true;
+}
+
+//---------------------------------------------------------------------------
+bool Grid2dSummedArea::sdev(int x0, int x1, int y0, int y1, int minGood,
+			    double &sdev) const
+{
+  if (_sumSq.empty() || !_clip(x0, x1, y0, y1))
+  {
+    return false;
+  }
+  int n = _boxTotal(_count, x0, x1, y0, y1);
+  if (n <= minGood || n <= 0)
+  {
+    return false;
+  }
+  double s = _boxTotal(_sum, x0, x1, y0, y1);
+  double q = _boxTotal(_sumSq, x0, x1, y0, y1);
+  double var = n*q - s*s;
+
+  // differences of large totals can leave a small negative value
+  // where the true variance is 0
+  sdev = var > 0.0 ? sqrt(var)/n : 0.0;
+  return true;
+}
+
+//---------------------------------------------------------------------------
+bool Grid2dSummedArea::_clip(int &x0, int &x1, int &y0, int &y1) const
+{
+  if (x0 < 0)
+  {
+    x0 = 0;
+  }
+  if (y0 < 0)
+  {
+    y0 = 0;
+  }
+  if (x1 >= _nx)
+  {
+    x1 = _nx - 1;
+  }
+  if (y1 >= _ny)
+  {
+    y1 = _ny - 1;
+  }
+  return x0 <= x1 && y0 <= y1;
+}
@@ -31,6 +31,8 @@
 #include <euclid/Grid2dLoop.hh>
 #include <euclid/Grid2dLoopA.hh>
 #include <euclid/Grid2dMedian.hh>
+#include <euclid/Grid2dPercentileFilter.hh>
+#include <euclid/Grid2dSummedArea.hh>
 #include <euclid/Line.hh>
 #include <euclid/PointList.hh>
 #include <rapmath/AngleCombiner.hh>
@@ -2425,27 +2427,20 @@ void GridAlgs::medianSimple(int xw, int yw, double bin_min, double bin_max,
 void GridAlgs::median(int xw, int yw, double bin_min, double bin_max,
 		      double bin_delta)
 {
-  // make a fast median object
-  // Grid2dMedian F(*this, xw, yw, bin_delta, bin_min, bin_max);
-
-  // make an object to loop through the grid
-  Grid2dLoopA G(_nx, _ny, xw, yw);
-  GridAlgs tmp(*this);
-  Grid2dLoopAlgMedian A(bin_min, bin_max, bin_delta);
+  medianThreaded(xw, yw, bin_min, bin_max, bin_delta, 1);
+}
 
-  while (G.increment(tmp, A))
-  {
-    int x, y;
-    double m;
-    if (G.getXyAndResult(A, xw*yw/2, x,  y, m))
-    {
-      _data[y*_nx + x] = m;
-    }
-    else
-    {
-      _data[y*_nx + x] = _missing;
-    }
-  }
+//----------------------------------------------------------------
+void GridAlgs::medianThreaded(int xw, int yw, double bin_min, double bin_max,
+			      double bin_delta, int numThread)
+{
+  Grid2dPercentileFilter F(*this, xw, yw, bin_min, bin_max, bin_delta);
+  vector<double> pct;
+  pct.push_back(0.5);
+  vector<Grid2d> out;
+  vector<unsigned char> valid;
+  F.apply(pct, xw*yw/2, numThread, out, valid);
+  _data = out[0].getData();
 }
 
 //----------------------------------------------------------------
@@ -2548,25 +2543,34 @@ void GridAlgs::medianEntireDomain(double binMin, double binMax, double binDelta,
 void GridAlgs::speckle(int xw, int yw, double bin_min, double bin_max,
 		       double bin_delta)
 {
-  // make a fast median object
-  // Grid2dMedian F(*this, xw, yw, bin_delta, bin_min, bin_max);
-
-  // make an object to loop through the grid
-  Grid2dLoopA G(_nx, _ny, xw, yw);
-  GridAlgs tmp(*this);
-  Grid2dLoopAlgSpeckle A(bin_min, bin_max, bin_delta);
+  speckleThreaded(xw, yw, bin_min, bin_max, bin_delta, 1);
+}
 
-  while (G.increment(tmp, A))
+//----------------------------------------------------------------
+void GridAlgs::speckleThreaded(int xw, int yw, double bin_min, double bin_max,
+			       double bin_delta, int numThread)
+{
+  Grid2dPercentileFilter F(*this, xw, yw, bin_min, bin_max, bin_delta);
+  vector<double> pct;
+  pct.push_back(0.25);
+  pct.push_back(0.75);
+  vector<Grid2d> out;
+  vector<unsigned char> valid;
+  F.apply(pct, xw*yw/2, numThread, out, valid);
+
+  // a percentile may equal the missing value, so use the validity
+  // flags rather than testing the percentiles for missing
+  const vector<double> &p25 = out[0].getData();
+  const vector<double> &p75 = out[1].getData();
+  for (int i=0; i<_npt; ++i)
   {
-    int x, y;
-    double m;
-    if (G.getXyAndResult(A, xw*yw/2, x,  y, m))
+    if (valid[i])
     {
-      _data[y*_nx + x] = m;
+      _data[i] = p75[i] - p25[i];
     }
     else
     {
-      _data[y*_nx + x] = _missing;
+      _data[i] = _missing;
     }
   }
 }
@@ -2721,6 +2725,93 @@ void GridAlgs::texture(int xw, int yw, bool isX)
   }
 }
 
+//----------------------------------------------------------------
+void GridAlgs::smoothSummedArea(int xw, int yw)
+{
+  Grid2dSummedArea S(*this, false);
+  for (int y=0; y<_ny; ++y)
+  {
+    for (int x=0; x<_nx; ++x)
+    {
+      double result;
+      if (S.mean(x-xw, x+xw, y-yw, y+yw, xw*yw/2, result))
+      {
+	_data[y*_nx + x] = result;
+      }
+      else
+      {
+	_data[y*_nx + x] = _missing;
+      }
+    }
+  }
+}
+
+//----------------------------------------------------------------
+void GridAlgs::sdevSummedArea(int xw, int yw)
+{
+  Grid2dSummedArea S(*this, true);
+  for (int y=0; y<_ny; ++y)
+  {
+    for (int x=0; x<_nx; ++x)
+    {
+      double result;
+      if (S.sdev(x-xw, x+xw, y-yw, y+yw, xw*yw/2, result))
+      {
+	_data[y*_nx + x] = result;
+      }
+      else
+      {
+	_data[y*_nx + x] = _missing;
+      }
+    }
+  }
+}
+
+//----------------------------------------------------------------
+void GridAlgs::textureSummedArea(int xw, int yw, bool isX)
+{
+  // squared differences between adjacent points, as in
+  // Grid2dLoopAlgTexture
+  GridAlgs diff("diff", _nx, _ny, _missing);
+  for (int y=0; y<_ny; ++y)
+  {
+    for (int x=0; x<_nx; ++x)
+    {
+      double v1, v2;
+      bool ok;
+      if (isX)
+      {
+	ok = y-1 >= 0 && getValue(x, y, v1) && getValue(x, y-1, v2);
+      }
+      else
+      {
+	ok = x-1 >= 0 && getValue(x, y, v1) && getValue(x-1, y, v2);
+      }
+      if (ok)
+      {
+	diff._data[y*_nx + x] = (v1-v2)*(v1-v2);
+      }
+    }
+  }
+
+  Grid2dSummedArea S(diff, false);
+  for (int y=0; y<_ny; ++y)
+  {
+    for (int x=0; x<_nx; ++x)
+    {
+      double result;
+      if (S.mean(x-xw, x+xw, y-yw, y+yw, xw*yw/2, result))
+      {
+	_data[y*_nx + x] = result;
+      }
+      else
+      {
+	_data[y*_nx + x] = _missing;
+      }
+    }
+  }
+}
+
 //----------------------------------------------------------------
 void GridAlgs::db2linear(void)
 {
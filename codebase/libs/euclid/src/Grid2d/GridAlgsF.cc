@@ -0,0 +1,262 @@
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* 
+// ** Copyright UCAR (c) 1990 - 2016                                         
+// ** University Corporation for Atmospheric Research (UCAR)                 
+// ** National Center for Atmospheric Research (NCAR)                        
+// ** Boulder, Colorado, USA                                                 
+// ** BSD licence applies - redistribution and use in source and binary      
+// ** forms, with or without modification, are permitted provided that       
+// ** the following conditions are met:                                      
+// ** 1) If the software is modified to produce derivative works,            
+// ** such modified software should be clearly marked, so as not             
+// ** to confuse it with the version available from UCAR.                    
+// ** 2) Redistributions of source code must retain the above copyright      
+// ** notice, this list of conditions and the following disclaimer.          
+// ** 3) Redistributions in binary form must reproduce the above copyright   
+// ** notice, this list of conditions and the following disclaimer in the    
+// ** documentation and/or other materials provided with the distribution.   
+// ** 4) Neither the name of UCAR nor the names of its contributors,         
+// ** if any, may be used to endorse or promote products derived from        
+// ** this software without specific prior written permission.               
+// ** DISCLAIMER: THIS SOFTWARE IS PROVIDED "AS IS" AND WITHOUT ANY EXPRESS  
+// ** OR IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED      
+// ** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.    
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* 
+/**
+ * @file GridAlgsF.cc
+ * @brief Neighborhood algorithms applied to Grid2dF objects
+ */
+
+#include <euclid/GridAlgsF.hh>
+#include <euclid/Grid2d.hh>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+//---------------------------------------------------------------------------
+GridAlgsF::GridAlgsF(void) : Grid2dF()
+{
+}
+
+//---------------------------------------------------------------------------
+GridAlgsF::GridAlgsF(const std::string &name, int nx, int ny) :
+  Grid2dF(name, nx, ny)
+{
+}
+
+//---------------------------------------------------------------------------
+GridAlgsF::GridAlgsF(const Grid2d &g) : Grid2dF(g)
+{
+}
+
+//---------------------------------------------------------------------------
+GridAlgsF::GridAlgsF(const Grid2dF &g) : Grid2dF(g)
+{
+}
+
+//---------------------------------------------------------------------------
+GridAlgsF::~GridAlgsF()
+{
+}
+
+//---------------------------------------------------------------------------
+void GridAlgsF::smooth(int sx, int sy)
+{
+  Grid2dF tmp(*this);
+  _boxStats(tmp, sx, sy, BOX_MEAN, sx*sy/2);
+}
+
+//---------------------------------------------------------------------------
+void GridAlgsF::smoothNoMissing(int sx, int sy)
+{
+  Grid2dF tmp(*this);
+  _boxStats(tmp, sx, sy, BOX_MEAN_NO_MISSING, 0);
+}
+
+//---------------------------------------------------------------------------
+void GridAlgsF::sdev(int sx, int sy)
+{
+  Grid2dF tmp(*this);
+  _boxStats(tmp, sx, sy, BOX_SDEV, sx*sy/2);
+}
+
+//---------------------------------------------------------------------------
+void GridAlgsF::texture(int sx, int sy, bool isX)
+{
+  // squared differences between adjacent points, where both are valid
+  Grid2dF diff(_name, _nx, _ny);
+  for (int y=0; y<_ny; ++y)
+  {
+    for (int x=0; x<_nx; ++x)
+    {
+      int x1 = isX ? x : x - 1;
+      int y1 = isX ? y - 1 : y;
+      if (x1 < 0 || y1 < 0)
+      {
+	continue;
+      }
+      if (isValid(x, y) && isValid(x1, y1))
+      {
+	double d = _data[y*_nx + x] - _data[y1*_nx + x1];
+	diff.setValue(x, y, d*d);
+      }
+    }
+  }
+  _boxStats(diff, sx, sy, BOX_MEAN, sx*sy/2);
+}
+
+//---------------------------------------------------------------------------
+void GridAlgsF::dilate(int sx, int sy)
+{
+  Grid2dF tmp(*this);
+  const float lowest = -FLT_MAX;
+  std::vector<float> ok(_nx), colMax(_nx);
+
+  for (int y=0; y<_ny; ++y)
+  {
+    // max down the columns of the box
+    std::fill(colMax.begin(), colMax.end(), lowest);
+    int y0 = std::max(y - sy, 0);
+    int y1 = std::min(y + sy, _ny - 1);
+    for (int iy=y0; iy<=y1; ++iy)
+    {
+      const float *v = &tmp._data[iy*_nx];
+      tmp._unpackRow(iy, &ok[0]);
+      for (int x=0; x<_nx; ++x)
+      {
+	float w = ok[x] > 0 ? v[x] : lowest;
+	colMax[x] = w > colMax[x] ? w : colMax[x];
+      }
+    }
+
+    // then along the row
+    for (int x=0; x<_nx; ++x)
+    {
+      int x0 = std::max(x - sx, 0);
+      int x1 = std::min(x + sx, _nx - 1);
+      float m = lowest;
+      for (int ix=x0; ix<=x1; ++ix)
+      {
+	m = colMax[ix] > m ? colMax[ix] : m;
+      }
+      if (m > lowest)
+      {
+	setValue(x, y, m);
+      }
+      else
+      {
+	setMissing(x, y);
+      }
+    }
+  }
+}
+
+//---------------------------------------------------------------------------
+// Box statistics over (2*sx+1) by (2*sy+1) boxes clipped to the grid,
+// written to the local grid. The sums for each column of the box are
+// kept up to date as the box moves down a row, and the sums along the
+// row are taken from prefix sums of the column sums.
+void GridAlgsF::_boxStats(const Grid2dF &in, int sx, int sy, BoxStat_t stat,
+			  int minGood)
+{
+  bool needSq = (stat == BOX_SDEV);
+  std::vector<float> ok(_nx);
+  std::vector<double> colS(_nx, 0.0), colQ(_nx, 0.0), colN(_nx, 0.0);
+  std::vector<double> pS(_nx + 1, 0.0), pQ(_nx + 1, 0.0), pN(_nx + 1, 0.0);
+
+  int nextRow = 0;
+  for (int y=0; y<_ny; ++y)
+  {
+    // column sums cover rows y-sy to y+sy
+    int y1 = std::min(y + sy, _ny - 1);
+    for (; nextRow <= y1; ++nextRow)
+    {
+      _addRow(in, nextRow, 1.0, needSq, ok, colS, colQ, colN);
+    }
+    if (y - sy - 1 >= 0)
+    {
+      _addRow(in, y - sy - 1, -1.0, needSq, ok, colS, colQ, colN);
+    }
+    int nrows = y1 - std::max(y - sy, 0) + 1;
+
+    // prefix sums along the row
+    for (int x=0; x<_nx; ++x)
+    {
+      pS[x+1] = pS[x] + colS[x];
+      pN[x+1] = pN[x] + colN[x];
+    }
+    if (needSq)
+    {
+      for (int x=0; x<_nx; ++x)
+      {
+	pQ[x+1] = pQ[x] + colQ[x];
+      }
+    }
+
+    for (int x=0; x<_nx; ++x)
+    {
+      int x0 = std::max(x - sx, 0);
+      int x1 = std::min(x + sx, _nx - 1);
+      double n = pN[x1+1] - pN[x0];
+      double s = pS[x1+1] - pS[x0];
+      bool good;
+      double v = 0.0;
+      switch (stat)
+      {
+      case BOX_MEAN:
+	good = n > minGood && n > 0;
+	if (good)
+	{
+	  v = s/n;
+	}
+	break;
+      case BOX_MEAN_NO_MISSING:
+	good = n > 0 && n == nrows*(x1 - x0 + 1);
+	if (good)
+	{
+	  v = s/n;
+	}
+	break;
+      case BOX_SDEV:
+      default:
+	good = n > minGood && n > 0;
+	if (good)
+	{
+	  double q = pQ[x1+1] - pQ[x0];
+	  double var = n*q - s*s;
+	  v = var > 0 ? sqrt(var)/n : 0.0;
+	}
+	break;
+      }
+      if (good)
+      {
+	setValue(x, y, v);
+      }
+      else
+      {
+	setMissing(x, y);
+      }
+    }
+  }
+}
+
+//---------------------------------------------------------------------------
+void GridAlgsF::_addRow(const Grid2dF &in, int y, double sign, bool needSq,
+			std::vector<float> &ok, std::vector<double> &colS,
+			std::vector<double> &colQ,
+			std::vector<double> &colN) const
+{
+  const float *v = &in._data[y*_nx];
+  in._unpackRow(y, &ok[0]);
+  for (int x=0; x<_nx; ++x)
+  {
+    colS[x] += sign*v[x];
+    colN[x] += sign*ok[x];
+  }
+  if (needSq)
+  {
+    for (int x=0; x<_nx; ++x)
+    {
+      colQ[x] += sign*v[x]*v[x];
+    }
+  }
+}
@@ -0,0 +1,234 @@
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* 
+// ** Copyright UCAR (c) 1990 - 2016                                         
+// ** University Corporation for Atmospheric Research (UCAR)                 
+// ** National Center for Atmospheric Research (NCAR)                        
+// ** Boulder, Colorado, USA                                                 
+// ** BSD licence applies - redistribution and use in source and binary      
+// ** forms, with or without modification, are permitted provided that       
+// ** the following conditions are met:                                      
+// ** 1) If the software is modified to produce derivative works,            
+// ** such modified software should be clearly marked, so as not             
+// ** to confuse it with the version available from UCAR.                    
+// ** 2) Redistributions of source code must retain the above copyright      
+// ** notice, this list of conditions and the following disclaimer.          
+// ** 3) Redistributions in binary form must reproduce the above copyright   
+// ** notice, this list of conditions and the following disclaimer in the    
+// ** documentation and/or other materials provided with the distribution.   
+// ** 4) Neither the name of UCAR nor the names of its contributors,         
+// ** if any, may be used to endorse or promote products derived from        
+// ** this software without specific prior written permission.               
+// ** DISCLAIMER: THIS SOFTWARE IS PROVIDED "AS IS" AND WITHOUT ANY EXPRESS  
+// ** OR IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED      
+// ** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.    
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* 
+/**
+ * @file Grid2dF.hh
+ * @brief two dimensional float data grid, with a validity mask
+ * @class Grid2dF
+ * @brief two dimensional float data grid, with a validity mask
+ *
+ * A compact alternative to Grid2d for large grids. Values are held as
+ * float, and missing data is held in a bitmask rather than as a
+ * sentinel value, so the grid needs a little over half the memory of
+ * a Grid2d.
+ *
+ * Where a point is missing the stored value is always 0, so that
+ * sums over the data need not test each point - see GridAlgsF.
+ */
+
+# ifndef  GRID2DF_H
+# define  GRID2DF_H
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+class Grid2d;
+
+//------------------------------------------------------------------
+class Grid2dF
+{
+  friend class GridAlgsF;
+
+public:
+
+  /**
+   * Empty constructor (no data)
+   */
+  Grid2dF(void);
+
+  /**
+   * named grid with dimensions, sets all values to missing
+   * @param[in] name
+   * @param[in] nx
+   * @param[in] ny
+   */
+  Grid2dF(const std::string &name, int nx, int ny);
+
+  /**
+   * Copy of a Grid2d, with missing data values masked out
+   * @param[in] g
+   */
+  Grid2dF(const Grid2d &g);
+
+  /**
+   * Destructor
+   */
+  virtual ~Grid2dF(void);
+
+  /**
+   * @return a Grid2d copy of the local grid
+   * @param[in] missing  Missing data value to use in the Grid2d
+   */
+  Grid2d toGrid2d(double missing) const;
+
+  /**
+   * @return true if dimensions of input grid equal local dimensions
+   * @param[in] g
+   */
+  bool dimensionsEqual(const Grid2dF &g) const;
+
+  /**
+   * @return name
+   */
+  inline const std::string &getName(void) const {return _name;}
+
+  /**
+   * Set name
+   * @param[in] name
+   */
+  inline void setName(const std::string &name) {_name = name;}
+
+  /**
+   * @return number of points
+   */
+  inline int getNdata(void) const {return _npt;}
+
+  /**
+   * @return number of x
+   */
+  inline int getNx(void) const {return _nx;}
+
+  /**
+   * @return number of y
+   */
+  inline int getNy(void) const {return _ny;}
+
+  /**
+   * @return the data values, 0 where missing
+   */
+  inline const std::vector<float> &getData(void) const {return _data;}
+
+  /**
+   * @return true if data at a point is not missing
+   * @param[in] i  Index into data
+   */
+  inline bool isValid(int i) const
+  {
+    return (_mask[i >> 6] >> (i & 63)) & 1;
+  }
+
+  /**
+   * @return true if data at a point is not missing
+   * @param[in] x
+   * @param[in] y
+   */
+  inline bool isValid(int x, int y) const {return isValid(y*_nx + x);}
+
+  /**
+   * @return true if data at a point is missing
+   * @param[in] i  Index into data
+   */
+  inline bool isMissing(int i) const {return !isValid(i);}
+
+  /**
+   * @return true if data at a point is missing
+   * @param[in] x
+   * @param[in] y
+   */
+  inline bool isMissing(int x, int y) const {return !isValid(y*_nx + x);}
+
+  /**
+   * Get value at a point
+   * @return true if value is set, false if missing
+   * @param[in] x
+   * @param[in] y
+   * @param[out] v
+   */
+  inline bool getValue(int x, int y, double &v) const
+  {
+    int i = y*_nx + x;
+    if (!isValid(i))
+    {
+      return false;
+    }
+    v = _data[i];
+    return true;
+  }
+
+  /**
+   * Set value at a point, making it valid
+   * @param[in] x
+   * @param[in] y
+   * @param[in] v
+   */
+  inline void setValue(int x, int y, double v)
+  {
+    int i = y*_nx + x;
+    _data[i] = static_cast<float>(v);
+    _mask[i >> 6] |= (static_cast<uint64_t>(1) << (i & 63));
+  }
+
+  /**
+   * Set a point to missing
+   * @param[in] x
+   * @param[in] y
+   */
+  inline void setMissing(int x, int y)
+  {
+    int i = y*_nx + x;
+    _data[i] = 0.0;
+    _mask[i >> 6] &= ~(static_cast<uint64_t>(1) << (i & 63));
+  }
+
+  /**
+   * Set all points missing
+   */
+  void setAllMissing(void);
+
+  /**
+   * @return number of points that are not missing
+   */
+  int numGood(void) const;
+
+  /**
+   * @return number of bytes used to store the data and mask
+   */
+  size_t dataBytes(void) const;
+
+protected:
+
+  std::string _name;            /**< description of the data */
+  std::vector<float> _data;     /**< data values, 0 where missing */
+  std::vector<uint64_t> _mask;  /**< one bit per point, 1 = valid */
+  int _npt;                     /**< number of data grid points */
+  int _nx;                      /**< number of x grid points */
+  int _ny;                      /**< number of y grid points */
+
+  /**
+   * Set the validity of one row into a float array, 1.0 for valid and
+   * 0.0 for missing
+   * @param[in] y  Row
+   * @param[out] ok  Array of length _nx
+   */
+  void _unpackRow(int y, float *ok) const;
+
+  /**
+   * Resize for new dimensions, all missing
+   * @param[in] nx
+   * @param[in] ny
+   */
+  void _resize(int nx, int ny);
+};
+
+#endif
@@ -0,0 +1,176 @@
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* 
+// ** Copyright UCAR (c) 1990 - 2016                                         
+// ** University Corporation for Atmospheric Research (UCAR)                 
+// ** National Center for Atmospheric Research (NCAR)                        
+// ** Boulder, Colorado, USA                                                 
+// ** BSD licence applies - redistribution and use in source and binary      
+// ** forms, with or without modification, are permitted provided that       
+// ** the following conditions are met:                                      
+// ** 1) If the software is modified to produce derivative works,            
+// ** such modified software should be clearly marked, so as not             
+// ** to confuse it with the version available from UCAR.                    
+// ** 2) Redistributions of source code must retain the above copyright      
+// ** notice, this list of conditions and the following disclaimer.          
+// ** 3) Redistributions in binary form must reproduce the above copyright   
+// ** notice, this list of conditions and the following disclaimer in the    
+// ** documentation and/or other materials provided with the distribution.   
+// ** 4) Neither the name of UCAR nor the names of its contributors,         
+// ** if any, may be used to endorse or promote products derived from        
+// ** this software without specific prior written permission.               
+// ** DISCLAIMER: THIS SOFTWARE IS PROVIDED "AS IS" AND WITHOUT ANY EXPRESS  
+// ** OR IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED      
+// ** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.    
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* 
+/**
+ * @file Grid2dPercentileFilter.hh
+ * @brief Sliding window median or percentiles of a Grid2d, in constant time
+ *        per point
+ * @class Grid2dPercentileFilter
+ * @brief Sliding window median or percentiles of a Grid2d, in constant time
+ *        per point
+ *
+ * The algorithm is that of Perreault and Hebert, "Median Filtering in
+ * Constant Time" (2007). A histogram is kept for each column of the grid,
+ * over the rows in the window. The histogram for the window is the sum of
+ * the column histograms across the window, so moving one point in x takes
+ * out one column histogram and adds in another, and moving up one row takes
+ * one point out of, and adds one point to, each column histogram. Neither
+ * cost depends on the window height.
+ *
+ * The bins are grouped into coarse bins of 16 fine bins. Only the coarse
+ * histogram of the window is kept up to date at each point. The fine
+ * histogram for a coarse bin is brought up to date when a percentile falls
+ * in that coarse bin, so the search and the update are each over about
+ * sqrt(number of bins) values, not the number of bins.
+ *
+ * The bins, and the choice of bin for a percentile, are the same as in
+ * Grid2dLoopAlgMedian, so the results are identical to the traversal with
+ * Grid2dLoopA.  The window at x,y is x-sx to x+sx and y-sy to y+sy,
+ * clipped to the grid.
+ *
+ * The rows may be split into bands, each computed in its own thread.
+ */
+
+# ifndef    GRID2D_PERCENTILE_FILTER_H
+# define    GRID2D_PERCENTILE_FILTER_H
+
+#include <toolsa/TaThreadDoubleQue.hh>
+#include <string>
+#include <vector>
+
+class Grid2d;
+
+//------------------------------------------------------------------
+class Grid2dPercentileFilter
+{
+public:
+
+  /**
+   * @param[in] g  Grid to filter
+   * @param[in] sx  Window half width x
+   * @param[in] sy  Window half width y
+   * @param[in] binMin  Data minimum bin center (histograms)
+   * @param[in] binMax  Data maximum bin center (histograms)
+   * @param[in] binDelta Data diff between bin centers (histograms)
+   */
+  Grid2dPercentileFilter(const Grid2d &g, int sx, int sy, double binMin,
+			 double binMax, double binDelta);
+
+  /**
+   * Destructor
+   */
+  virtual ~Grid2dPercentileFilter(void);
+
+  /**
+   * Compute one or more percentiles at every point
+   *
+   * A percentile can be equal to the missing data value of the grid, so
+   * the points with a result are flagged in valid, and the output grids
+   * should not be tested for missing data.
+   *
+   * @param[in] pct  The percentiles, each 0 to 1
+   * @param[in] minGood  Minimum number of non-missing points in the window,
+   *                     with fewer the output is missing
+   * @param[in] numThread  Number of threads, 1 or less for no threading
+   * @param[out] out  One grid per percentile, dimensioned as the input
+   * @param[out] valid  One flag per point, 1 if the percentiles were
+   *                    computed at that point, 0 if not
+   */
+  void apply(const std::vector<double> &pct, int minGood, int numThread,
+	     std::vector<Grid2d> &out,
+	     std::vector<unsigned char> &valid) const;
+
+  /**
+   * Compute method used in threads
+   * @param[in] ti  Pointer to BandInfo
+   */
+  static void compute(void *ti);
+
+protected:
+private:
+
+  /**
+   * Number of fine bins per coarse bin, as a shift
+   */
+  static const int _fineShift = 4;
+  static const int _nfine = 1 << _fineShift;
+
+  std::string _name;      /**< Name of the input grid */
+  int _nx;                /**< Grid dimension */
+  int _ny;                /**< Grid dimension */
+  double _missing;        /**< Missing data value */
+  int _sx;                /**< Window half width x */
+  int _sy;                /**< Window half width y */
+  double _binMin;         /**< Smallest bin value */
+  double _binDelta;       /**< Bin increment */
+  int _nbin;              /**< Number of fine bins */
+  int _ncoarse;           /**< Number of coarse bins */
+
+  /**
+   * Bin index at each grid point, -1 for missing
+   */
+  std::vector<int> _index;
+
+  /**
+   * @class PercentileThreads
+   * @brief Simple class to instantiate TaThreadDoubleQue by implementing
+   * the clone() method.
+   */
+  class PercentileThreads : public TaThreadDoubleQue
+  {
+  public:
+    inline PercentileThreads() : TaThreadDoubleQue() {}
+    inline virtual ~PercentileThreads() {}
+    TaThread *clone(int index);
+  };
+
+  /**
+   * @class BandInfo
+   * @brief Information needed to filter one band of rows in a thread
+   */
+  class BandInfo
+  {
+  public:
+    inline BandInfo(const Grid2dPercentileFilter *filter, int y0, int y1,
+		    const std::vector<double> &pct, int minGood,
+		    std::vector<Grid2d> &out,
+		    std::vector<unsigned char> &valid) :
+      _filter(filter), _y0(y0), _y1(y1), _pct(pct), _minGood(minGood),
+      _out(out), _valid(valid) {}
+    inline virtual ~BandInfo(void) {}
+
+    const Grid2dPercentileFilter *_filter;  /**< The filter */
+    int _y0;                                /**< First row of the band */
+    int _y1;                                /**< One past the last row */
+    const std::vector<double> &_pct;        /**< Percentiles */
+    int _minGood;                           /**< Min non-missing count */
+    std::vector<Grid2d> &_out;              /**< Output grids */
+    std::vector<unsigned char> &_valid;     /**< Output validity */
+  };
+
+  void _filterBand(int y0, int y1, const std::vector<double> &pct,
+		   int minGood, std::vector<Grid2d> &out,
+		   std::vector<unsigned char> &valid) const;
+};
+
+#endif
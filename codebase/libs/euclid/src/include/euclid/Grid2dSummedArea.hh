@@ -0,0 +1,147 @@
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* 
+// ** Copyright UCAR (c) 1990 - 2016                                         
+// ** University Corporation for Atmospheric Research (UCAR)                 
+// ** National Center for Atmospheric Research (NCAR)                        
+// ** Boulder, Colorado, USA                                                 
+// ** BSD licence applies - redistribution and use in source and binary      
+// ** forms, with or without modification, are permitted provided that       
+// ** the following conditions are met:                                      
+// ** 1) If the software is modified to produce derivative works,            
+// ** such modified software should be clearly marked, so as not             
+// ** to confuse it with the version available from UCAR.                    
+// ** 2) Redistributions of source code must retain the above copyright      
+// ** notice, this list of conditions and the following disclaimer.          
+// ** 3) Redistributions in binary form must reproduce the above copyright   
+// ** notice, this list of conditions and the following disclaimer in the    
+// ** documentation and/or other materials provided with the distribution.   
+// ** 4) Neither the name of UCAR nor the names of its contributors,         
+// ** if any, may be used to endorse or promote products derived from        
+// ** this software without specific prior written permission.               
+// ** DISCLAIMER: THIS SOFTWARE IS PROVIDED "AS IS" AND WITHOUT ANY EXPRESS  
+// ** OR IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED      
+// ** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.    
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* 
+/**
+ * @file Grid2dSummedArea.hh
+ * @brief Summed area tables for a Grid2d, for fast box statistics
+ * @class Grid2dSummedArea
+ * @brief Summed area tables for a Grid2d, for fast box statistics
+ *
+ * Holds running 2-D sums of the non-missing data, the squares of the
+ * data, and the count of non-missing points, so that the sum, mean,
+ * standard deviation and count within any box can be found in constant
+ * time, regardless of the box size.
+ *
+ * Boxes are given as inclusive index ranges, and are clipped to the grid.
+ *
+ * The data are summed relative to the mean of the grid, which keeps the
+ * totals small and limits the loss of precision when the totals for the
+ * corners of a box are differenced.
+ */
+
+# ifndef  GRID2D_SUMMED_AREA_H
+# define  GRID2D_SUMMED_AREA_H
+
+#include <vector>
+
+class Grid2d;
+
+//------------------------------------------------------------------
+class Grid2dSummedArea
+{
+public:
+
+  /**
+   * Build the tables from a grid
+   * @param[in] g  Grid
+   * @param[in] needSquares  True to build the table of squares, needed
+   *                         for standard deviation
+   */
+  Grid2dSummedArea(const Grid2d &g, bool needSquares=true);
+
+  /**
+   * Destructor
+   */
+  virtual ~Grid2dSummedArea(void);
+
+  /**
+   * @return number of non-missing points in a box
+   * @param[in] x0  Lower x
+   * @param[in] x1  Upper x
+   * @param[in] y0  Lower y
+   * @param[in] y1  Upper y
+   */
+  int count(int x0, int x1, int y0, int y1) const;
+
+  /**
+   * @return sum of non-missing data in a box
+   * @param[in] x0  Lower x
+   * @param[in] x1  Upper x
+   * @param[in] y0  Lower y
+   * @param[in] y1  Upper y
+   */
+  double sum(int x0, int x1, int y0, int y1) const;
+
+  /**
+   * Mean of non-missing data in a box
+   * @return true if there are more than minGood non-missing points
+   * @param[in] x0  Lower x
+   * @param[in] x1  Upper x
+   * @param[in] y0  Lower y
+   * @param[in] y1  Upper y
+   * @param[in] minGood  Number of points that must be exceeded
+   * @param[out] mean
+   */
+  bool mean(int x0, int x1, int y0, int y1, int minGood,
+	    double &mean) const;
+
+  /**
+   * Standard deviation of non-missing data in a box, computed as in
+   * Grid2dLoopAlgSdev
+   * @return true if there are more than minGood non-missing points
+   * @param[in] x0  Lower x
+   * @param[in] x1  Upper x
+   * @param[in] y0  Lower y
+   * @param[in] y1  Upper y
+   * @param[in] minGood  Number of points that must be exceeded
+   * @param[out] sdev
+   *
+   * @note requires the squares table
+   */
+  bool sdev(int x0, int x1, int y0, int y1, int minGood,
+	    double &sdev) const;
+
+  /**
+   * @return true if the squares table was built
+   */
+  inline bool hasSquares(void) const {return !_sumSq.empty();}
+
+protected:
+private:
+
+  int _nx;  /**< grid x dimension */
+  int _ny;  /**< grid y dimension */
+  double _offset;  /**< mean of the grid, subtracted from the data */
+
+  /**
+   * The tables, (_nx+1) by (_ny+1), where entry (x,y) holds the total
+   * for all points with index less than x and less than y
+   */
+  std::vector<double> _sum;
+  std::vector<double> _sumSq;
+  std::vector<int> _count;
+
+  inline int _ipt(int x, int y) const {return y*(_nx + 1) + x;}
+
+  bool _clip(int &x0, int &x1, int &y0, int &y1) const;
+
+  template <class T>
+  inline T _boxTotal(const std::vector<T> &t, int x0, int x1,
+		     int y0, int y1) const
+  {
+    return t[_ipt(x1+1, y1+1)] - t[_ipt(x0, y1+1)] - t[_ipt(x1+1, y0)] +
+      t[_ipt(x0, y0)];
+  }
+};
+
+#endif
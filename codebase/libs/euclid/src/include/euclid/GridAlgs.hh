@@ -685,6 +685,19 @@ public:
    */
   void smooth(int sx, int sy);
 
+  /**
+   * Apply a sx by sy smoothing filter to the local grid, with the same
+   * results as smooth()
+   *
+   * This version uses summed area tables (Grid2dSummedArea), so the
+   * cost per point does not depend on the box size. Faster than smooth()
+   * for all but the smallest boxes.
+   *
+   * @param[in] sx
+   * @param[in] sy
+   */
+  void smoothSummedArea(int sx, int sy);
+
   /**
    * Apply a sx by sy smoothing filter to the local grid
    *
@@ -800,6 +813,18 @@ public:
    */
   void sdev(int xw, int yw);
 
+  /**
+   * For each point, set value to standard deviation in a xw by yw window
+   * around the point, with the same results as sdev()
+   *
+   * This version uses summed area tables (Grid2dSummedArea), so the
+   * cost per point does not depend on the box size.
+   *
+   * @param[in] xw  Width (x)
+   * @param[in] yw  Width (y)
+   */
+  void sdevSummedArea(int xw, int yw);
+
   /**
    * For each point, set value to standard deviation in a xw by yw window around
    * the point.
@@ -926,8 +951,10 @@ public:
   /**
    * At each point set the value to the median over a window
    *
-   * This version is the fastest algorithm, traverses the grid using
-   * Grid2dLoopA and passing around a Grid2dLoopAlgMedian object
+   * This version is the fastest algorithm, using Grid2dPercentileFilter,
+   * for which the time per point does not depend on the window size.
+   * The results are the same as traversing the grid using Grid2dLoopA
+   * and passing around a Grid2dLoopAlgMedian object.
    *
    * @param[in] nx  Median window size x
    * @param[in] ny  Median window size y
@@ -939,6 +966,21 @@ public:
   void median(int nx, int ny, double binMin, double binMax,
 	       double binDelta);
 
+  /**
+   * At each point set the value to the median over a window, as in
+   * median(), with the rows divided into bands computed in threads
+   *
+   * @param[in] nx  Median window size x
+   * @param[in] ny  Median window size y
+   *
+   * @param[in] binMin  Data minimum bin center (histograms)
+   * @param[in] binMax  Data maximum bin center (histograms)
+   * @param[in] binDelta Data diff between bin centers (histograms)
+   * @param[in] numThread  Number of threads to create
+   */
+  void medianThreaded(int nx, int ny, double binMin, double binMax,
+		      double binDelta, int numThread);
+
   /**
    * Median over the entire grid, with no overlapping boxes (output is
    * replicated within each box, one computation per box, each shift is a
@@ -988,6 +1030,20 @@ public:
   void speckle(int nx, int ny, double binMin, double binMax,
 	       double binDelta);
 
+  /**
+   * Create a 'speckle' measure as in speckle(), with the rows divided
+   * into bands computed in threads
+   * 
+   * @param[in] nx  Percentile window size x
+   * @param[in] ny  Percentile window size y
+   * @param[in] binMin  Data minimum bin center (histograms)
+   * @param[in] binMax  Data maximum bin center (histograms)
+   * @param[in] binDelta Data diff between bin centers (histograms)
+   * @param[in] numThread  Number of threads to create
+   */
+  void speckleThreaded(int nx, int ny, double binMin, double binMax,
+		       double binDelta, int numThread);
+
   /**
    * Create a 'speckle' interest measure from data in a grid, using fuzzy
    * remappings.  This is done using bins like in the median calculations.
@@ -1069,6 +1125,18 @@ public:
    */
   void texture(int nx, int ny, bool isX);
 
+  /**
+   * Compute texture at a scale, with the same results as texture()
+   *
+   * This version uses summed area tables (Grid2dSummedArea), so the
+   * cost per point does not depend on the box size.
+   *
+   * @param[in] nx  X scale
+   * @param[in] ny  Y scale
+   * @param[in] isX  True for X texture, false for Y texture
+   */
+  void textureSummedArea(int nx, int ny, bool isX);
+
   // -------------------------------------------------------------------
 
   /**
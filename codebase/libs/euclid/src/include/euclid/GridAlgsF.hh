@@ -0,0 +1,153 @@
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* 
+// ** Copyright UCAR (c) 1990 - 2016                                         
+// ** University Corporation for Atmospheric Research (UCAR)                 
+// ** National Center for Atmospheric Research (NCAR)                        
+// ** Boulder, Colorado, USA                                                 
+// ** BSD licence applies - redistribution and use in source and binary      
+// ** forms, with or without modification, are permitted provided that       
+// ** the following conditions are met:                                      
+// ** 1) If the software is modified to produce derivative works,            
+// ** such modified software should be clearly marked, so as not             
+// ** to confuse it with the version available from UCAR.                    
+// ** 2) Redistributions of source code must retain the above copyright      
+// ** notice, this list of conditions and the following disclaimer.          
+// ** 3) Redistributions in binary form must reproduce the above copyright   
+// ** notice, this list of conditions and the following disclaimer in the    
+// ** documentation and/or other materials provided with the distribution.   
+// ** 4) Neither the name of UCAR nor the names of its contributors,         
+// ** if any, may be used to endorse or promote products derived from        
+// ** this software without specific prior written permission.               
+// ** DISCLAIMER: THIS SOFTWARE IS PROVIDED "AS IS" AND WITHOUT ANY EXPRESS  
+// ** OR IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED      
+// ** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.    
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* 
+/**
+ * @file GridAlgsF.hh
+ * @brief Neighborhood algorithms applied to Grid2dF objects
+ * @class GridAlgsF
+ * @brief Neighborhood algorithms applied to Grid2dF objects
+ *
+ * Float versions of the common GridAlgs box filters. The results match
+ * the GridAlgs methods of the same name, to within float precision.
+ *
+ * The box statistics are computed with running column sums, updated a
+ * row at a time, and prefix sums along each row, so the cost per point
+ * does not depend on the box size. Since missing points hold 0 in the
+ * data and the mask is unpacked to 0/1 per row, the inner loops have no
+ * per-point tests and can be vectorized by the compiler.
+ */
+
+# ifndef  GRIDALGSF_H
+# define  GRIDALGSF_H
+
+#include <euclid/Grid2dF.hh>
+
+//------------------------------------------------------------------
+class GridAlgsF : public Grid2dF
+{
+
+public:
+
+  /**
+   * Empty constructor (no data)
+   */
+  GridAlgsF(void);
+
+  /**
+   * named grid with dimensions, sets all values to missing
+   * @param[in] name
+   * @param[in] nx
+   * @param[in] ny
+   */
+  GridAlgsF(const std::string &name, int nx, int ny);
+
+  /**
+   * Copy of a Grid2d, with missing data values masked out
+   * @param[in] g
+   */
+  GridAlgsF(const Grid2d &g);
+
+  /**
+   * base class passed in
+   * @param[in] g
+   */
+  GridAlgsF(const Grid2dF &g);
+
+  /**
+   * Destructor
+   */
+  virtual ~GridAlgsF(void);
+
+  /**
+   * Apply a smoothing filter to the local grid. At each point the output
+   * is the mean value within the (2*sx+1) by (2*sy+1) box centered at
+   * the point, or missing if there are not more than sx*sy/2 non-missing
+   * points in the box. Same as GridAlgs::smooth()
+   *
+   * @param[in] sx
+   * @param[in] sy
+   */
+  void smooth(int sx, int sy);
+
+  /**
+   * Apply a smoothing filter to the local grid, such that if any data is
+   * missing in the box, the output is set to missing.
+   *
+   * @param[in] sx
+   * @param[in] sy
+   */
+  void smoothNoMissing(int sx, int sy);
+
+  /**
+   * For each point, set value to standard deviation in a (2*sx+1) by
+   * (2*sy+1) box around the point. Same as GridAlgs::sdev()
+   *
+   * @param[in] sx
+   * @param[in] sy
+   */
+  void sdev(int sx, int sy);
+
+  /**
+   * For each point, set value to the mean squared difference between
+   * adjacent points in a (2*sx+1) by (2*sy+1) box around the point.
+   * Same as GridAlgs::texture()
+   *
+   * @param[in] sx
+   * @param[in] sy
+   * @param[in] isX  True for differences between y and y-1, false for
+   *                 differences between x and x-1 (as in GridAlgs)
+   */
+  void texture(int sx, int sy, bool isX);
+
+  /**
+   * dilation - each point in the output is the maximum of the
+   * non-missing points in a (2*sx+1) by (2*sy+1) box around the point.
+   * Same as GridAlgs::dilate()
+   *
+   * @param[in] sx
+   * @param[in] sy
+   */
+  void dilate(int sx, int sy);
+
+protected:
+private:
+
+  /**
+   * @enum BoxStat_t
+   * @brief Statistic computed by _boxStats()
+   */
+  typedef enum
+  {
+    BOX_MEAN,
+    BOX_MEAN_NO_MISSING,
+    BOX_SDEV
+  } BoxStat_t;
+
+  void _boxStats(const Grid2dF &in, int sx, int sy, BoxStat_t stat,
+		 int minGood);
+  void _addRow(const Grid2dF &in, int y, double sign, bool needSq,
+	       std::vector<float> &ok, std::vector<double> &colS,
+	       std::vector<double> &colQ, std::vector<double> &colN) const;
+};
+
+#endif
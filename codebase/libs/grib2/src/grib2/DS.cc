@@ -49,6 +49,7 @@ DS::DS (Grib2Record::Grib2Sections_t sectionsPtr) :
   _data_status = NONE;
   _dataTemp = NULL;
   _readDataPtr = NULL;
+  _ownsReadData = false;
   _drsTemplateNum = _sectionsPtr.drs->getDrsConstants().templateNumber;
 
   switch (_drsTemplateNum) {
@@ -119,7 +120,7 @@ DS::~DS()
 {
   if(_dataTemp != NULL)
     delete _dataTemp;
-  if(_readDataPtr != NULL)
+  if(_readDataPtr != NULL && _ownsReadData)
     delete[] _readDataPtr;
 }
 
@@ -129,7 +130,7 @@ void DS::freeData()
     _dataTemp->freeData();
 }
 
-int DS::unpack(g2_ui08 *dsPtr)
+int DS::unpack(g2_ui08 *dsPtr, bool copyData)
 {
   // Length of section in octets
   _sectionLen = _upkUnsigned4 (dsPtr[0], dsPtr[1], dsPtr[2], dsPtr[3]);
@@ -147,11 +148,17 @@ int DS::unpack(g2_ui08 *dsPtr)
   if(_dataTemp == NULL)
     return GRIB_FAILURE;
 
-  if(_readDataPtr != NULL)
+  if(_readDataPtr != NULL && _ownsReadData)
     delete[] _readDataPtr;
 
-  _readDataPtr = new g2_ui08[_sectionLen - 4];
-  memcpy(_readDataPtr, &(dsPtr[5]), _sectionLen -4);
+  if(copyData) {
+    _readDataPtr = new g2_ui08[_sectionLen - 4];
+    memcpy(_readDataPtr, &(dsPtr[5]), _sectionLen -4);
+  } else {
+    // point into the caller's buffer, decoded later by getData()
+    _readDataPtr = &(dsPtr[5]);
+  }
+  _ownsReadData = copyData;
 
   _data_status = READ;
 
@@ -179,7 +186,8 @@ g2_fl32 *DS::getData()
     return NULL;
 
   if(_data_status == READ) {
-    delete[] _readDataPtr;
+    if(_ownsReadData)
+      delete[] _readDataPtr;
     _readDataPtr = NULL;
   }
 
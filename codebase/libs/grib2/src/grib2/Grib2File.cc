@@ -28,11 +28,18 @@
 #include <iostream>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
 #include <unistd.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
+#include <algorithm>
 
 #include <grib2/Grib2File.hh>
+#include <grib2/DS.hh>
+#include <grib2/PDS.hh>
 #include <toolsa/file_io.h>
 #include <toolsa/str.h>
 
@@ -48,6 +55,9 @@ Grib2File::Grib2File()
   _filePath = "";
   _filePtr = NULL;
   _fileContentsRead = false;
+  _mapPtr = NULL;
+  _mapLen = 0;
+  _useIndex = false;
   _last_file_action = CONSTRUCT;
 }
 
@@ -65,6 +75,10 @@ Grib2File::~Grib2File()
   for (inventory = _inventory.begin(); inventory != _inventory.end();
        ++inventory)
     delete inventory->record;
+
+  // Records may point into the mapped file, so unmap after deleting them
+
+  _unmapFile();
   
 }
 
@@ -106,6 +120,8 @@ void Grib2File::clearInventory()
 
   _inventory.erase(_inventory.begin(), _inventory.end());
 
+  _unmapFile();
+
   _filePath = "";
   _last_file_action = CLEAR;
 }
@@ -113,104 +129,121 @@ void Grib2File::clearInventory()
 int Grib2File::read(const string &file_path)
 {
   static const string method_name = "Grib2File::read()";
-  
+
   // Clear out the current inventory so we can create a new one
 
   clearInventory();
-  
+
   // Determine the input file path
 
   if (file_path != "")
     _setFilePath(file_path);
-  
+
   if (_filePath == "")
   {
     cerr << "ERROR: " << method_name << endl;
     cerr << "No input file path specified" << endl;
-    
+
     return GRIB_FAILURE;
   }
-  
+
   // Don't reread the file
 
   if (_fileContentsRead)
     return GRIB_SUCCESS;
-  
-  
-  // Open the input file
 
-  if ((_filePtr = ta_fopen_uncompress(_filePath.c_str(), "r")) == 0)
-  {
-    cerr << "ERROR: " << method_name << endl;
-    cerr << "Error opening input GRIB file: " << _filePath << endl;
-    perror(_filePath.c_str());
-    
-    return GRIB_FAILURE;
-  }
+  string readPath(_filePath);
 
-  char *uncompressPath = STRdup(_filePath.c_str());
-  char *ext = uncompressPath + strlen(uncompressPath) - 2;
-  if (!strncmp(ext, ".Z", 2)) {
-    *ext = '\0';
-  }
+  // Uncompress the input file if needed, this strips
+  // the .Z, .gz or .bz2 extension from the path
 
-  ext = uncompressPath + strlen(uncompressPath) - 3; 
-  if (!strncmp(ext, ".gz", 3)) {
-    *ext = '\0';
-  }
+  vector<char> uncompressPath(_filePath.c_str(),
+                              _filePath.c_str() + _filePath.size() + 1);
+  if (ta_file_uncompress(&uncompressPath[0]) < 0)
+  {
+    cerr << "ERROR: " << method_name << endl;
+    cerr << "Error uncompressing input GRIB file: " << _filePath << endl;
 
-  ext = uncompressPath + strlen(uncompressPath) - 4;
-  if (!strncmp(ext, ".bz2", 4)) {
-    *ext = '\0';
+    return GRIB_FAILURE;
   }
+  string gribPath(&uncompressPath[0]);
 
   // Determine the input file size
+
   struct stat file_stat;
-  if (stat(uncompressPath, &file_stat) != 0)
+  if (stat(gribPath.c_str(), &file_stat) != 0)
   {
     cerr << "ERROR: " << method_name << endl;
     cerr << "Error stat'ing input GRIB file." << endl;
-    perror(_filePath.c_str());
-    
+    perror(gribPath.c_str());
+
     return GRIB_FAILURE;
   }
-  
+
   g2_ui64 file_size = file_stat.st_size;
+  if (file_size == 0)
+  {
+    cerr << "ERROR: " << method_name << endl;
+    cerr << "Input GRIB file is empty: " << gribPath << endl;
+
+    return GRIB_FAILURE;
+  }
 
-  // Read the input file into a local buffer
+  // Map the input file. The mapping is private, so the
+  // records may be decoded in place without changing the file.
 
-  g2_ui08 *grib_contents = new g2_ui08[file_size];
-  int bytes_read;
-  
-  if ((bytes_read = fread(grib_contents, sizeof(g2_ui08), file_size, _filePtr))
-      != (int)file_size)
+  int fd = open(gribPath.c_str(), O_RDONLY);
+  if (fd < 0)
   {
     cerr << "ERROR: " << method_name << endl;
-    cerr << "Error reading contents of GRIB file: " << _filePath << endl;
-    cerr << "Expected " << file_size << " bytes" << endl;
-    cerr << "Read " << bytes_read << " bytes." << endl;
-    
-    delete [] grib_contents;
-    fclose(_filePtr);
-    _filePtr = 0;
-    
+    cerr << "Error opening input GRIB file: " << gribPath << endl;
+    perror(gribPath.c_str());
+
     return GRIB_FAILURE;
   }
-  
-  fclose(_filePtr);
-  _filePtr = 0;
-  
-  // Unpack the contents of the GRIB file
 
+  void *map = mmap(NULL, file_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (map == MAP_FAILED)
+  {
+    cerr << "ERROR: " << method_name << endl;
+    cerr << "Error mapping input GRIB file: " << gribPath << endl;
+    perror(gribPath.c_str());
+
+    return GRIB_FAILURE;
+  }
+
+  _mapPtr = (g2_ui08 *) map;
+  _mapLen = file_size;
+
+  // Use the index if it is valid
+
+  string indexPath;
+  if (_useIndex)
+  {
+    indexPath = _getIndexPath(gribPath);
+    if (_readIndex(indexPath, file_stat) == 0)
+    {
+      _fileContentsRead = true;
+      _last_file_action = READ;
+      return GRIB_SUCCESS;
+    }
+    _inventory.clear();
+  }
+
+  // Unpack the section headers of each record in the GRIB file.
+  // The packed data stays in the mapped file until requested.
+
+  g2_ui08 *grib_contents = _mapPtr;
   g2_ui08 *grib_ptr = grib_contents;
   int rec_num = 0;
 
   while (grib_ptr < grib_contents + file_size)
   {
     bool record_found = false;
-    
+
     // some non-standard grib2 records have WMO headers
-    while (grib_ptr < grib_contents + file_size && !record_found) {
+    while (grib_ptr + 4 <= grib_contents + file_size && !record_found) {
     if (grib_ptr[0] == 'G' &&
           grib_ptr[1] == 'R' &&
           grib_ptr[2] == 'I' &&
@@ -219,14 +252,15 @@ int Grib2File::read(const string &file_path)
         record_found = true;
         break;
       }
-     
+
       ++grib_ptr;
     }
- 
-    if (!record_found)
+
+    if (!record_found || grib_ptr + EDITION_LOCATION >= grib_contents + file_size)
       break;
 
     file_inventory_t inventory;
+    inventory.offset = grib_ptr - grib_contents;
 
     g2_ui08 edition_num = grib_ptr[EDITION_LOCATION];
 
@@ -234,37 +268,320 @@ int Grib2File::read(const string &file_path)
       cerr << "ERROR: reading edition number " << endl;
       cerr << "       Illegal number is " << (int) edition_num << endl;
       cerr << "       Not a GRIB2 record, exiting " << endl;
-      delete[] grib_contents;
+      clearInventory();
+      _setFilePath(readPath);
       return GRIB_FAILURE;
     }
     else
       inventory.record = new Grib2Record();
-    
-    if (inventory.record->unpack(&grib_ptr, file_size - (grib_ptr - grib_contents)) != GRIB_SUCCESS)
+
+    if (inventory.record->unpack(&grib_ptr, file_size - inventory.offset, false) != GRIB_SUCCESS)
     {
       cerr << "ERROR: " << method_name << endl;
       cerr << "Error unpacking record in grib file" << endl;
-      delete[] grib_contents;
+      delete inventory.record;
+      clearInventory();
+      _setFilePath(readPath);
       return GRIB_FAILURE;
     }
-    
-    
+
+    inventory.length = (grib_ptr - grib_contents) - inventory.offset;
+    _loadFieldIndex(inventory);
+
     _inventory.push_back(inventory);
 
     rec_num++;
 
   }
-  
-  delete [] grib_contents;
-  
+
+  if (_useIndex)
+    _writeIndex(indexPath, file_stat);
+
   _fileContentsRead = true;
   _last_file_action = READ;
 
   return GRIB_SUCCESS;
 }
 
+void Grib2File::setUseIndex(bool useIndex, const string &indexDir)
+{
+  _useIndex = useIndex;
+  _indexDir = indexDir;
+}
+
+int Grib2File::decodeRecords(vector <Grib2Record::Grib2Sections_t> &records,
+                             int nThreads)
+{
+  // Each data section is decoded once, even if it appears twice
+
+  vector<DS *> dsList;
+  for (size_t ii = 0; ii < records.size(); ii++)
+    if (records[ii].ds != NULL)
+      dsList.push_back(records[ii].ds);
+  sort(dsList.begin(), dsList.end());
+  dsList.erase(unique(dsList.begin(), dsList.end()), dsList.end());
+
+  decode_job_t job;
+  job.dsList = &dsList;
+  job.next = 0;
+  job.nFailed = 0;
+  pthread_mutex_init(&job.mutex, NULL);
+
+  if (nThreads > (int) dsList.size())
+    nThreads = dsList.size();
+
+  vector<pthread_t> threads;
+  for (int ii = 0; ii < nThreads - 1; ii++) {
+    pthread_t thread;
+    if (pthread_create(&thread, NULL, _decodeThreadMain, &job) == 0)
+      threads.push_back(thread);
+  }
+
+  // the calling thread works too
+
+  _decodeThreadMain(&job);
+
+  for (size_t ii = 0; ii < threads.size(); ii++)
+    pthread_join(threads[ii], NULL);
+
+  pthread_mutex_destroy(&job.mutex);
+
+  if (job.nFailed > 0) {
+    cerr << "ERROR: Grib2File::decodeRecords()" << endl;
+    cerr << "Failed to decode " << job.nFailed << " records." << endl;
+    return GRIB_FAILURE;
+  }
+
+  return GRIB_SUCCESS;
+}
+
+void *Grib2File::_decodeThreadMain(void *args)
+{
+  decode_job_t *job = (decode_job_t *) args;
+
+  while (true) {
+
+    pthread_mutex_lock(&job->mutex);
+    size_t index = job->next;
+    job->next++;
+    pthread_mutex_unlock(&job->mutex);
+
+    if (index >= job->dsList->size())
+      break;
+
+    if ((*job->dsList)[index]->getData() == NULL) {
+      pthread_mutex_lock(&job->mutex);
+      job->nFailed++;
+      pthread_mutex_unlock(&job->mutex);
+    }
+
+  }
+
+  return NULL;
+}
+
+void Grib2File::_unmapFile()
+{
+  if (_mapPtr != NULL)
+    munmap(_mapPtr, _mapLen);
+  _mapPtr = NULL;
+  _mapLen = 0;
+}
+
+int Grib2File::_unpackRecord(const file_inventory_t &inventory) const
+{
+  if (inventory.record != NULL)
+    return GRIB_SUCCESS;
+
+  if (_mapPtr == NULL || inventory.offset + inventory.length > _mapLen)
+  {
+    cerr << "ERROR: Grib2File::_unpackRecord()" << endl;
+    cerr << "Record is outside of file: " << _filePath << endl;
+    return GRIB_FAILURE;
+  }
+
+  Grib2Record *record = new Grib2Record();
+  g2_ui08 *grib_ptr = _mapPtr + inventory.offset;
+  if (record->unpack(&grib_ptr, inventory.length, false) != GRIB_SUCCESS)
+  {
+    cerr << "ERROR: Grib2File::_unpackRecord()" << endl;
+    cerr << "Error unpacking record in grib file: " << _filePath << endl;
+    delete record;
+    return GRIB_FAILURE;
+  }
+
+  inventory.record = record;
+  return GRIB_SUCCESS;
+}
+
+int Grib2File::_unpackAll() const
+{
+  vector< file_inventory_t >::const_iterator inventory;
+  for (inventory = _inventory.begin(); inventory != _inventory.end(); ++inventory)
+    if (_unpackRecord(*inventory) != GRIB_SUCCESS)
+      return GRIB_FAILURE;
+  return GRIB_SUCCESS;
+}
+
+void Grib2File::_loadFieldIndex(file_inventory_t &inventory)
+{
+  inventory.fields.clear();
+  vector <Grib2Record::Grib2Sections_t> records = inventory.record->getRecords();
+  for (size_t ii = 0; ii < records.size(); ii++) {
+    field_index_t field;
+    field.name = records[ii].summary->name;
+    field.levelType = records[ii].summary->levelType;
+    field.leadTime = records[ii].pds->getForecastTime();
+    inventory.fields.push_back(field);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////
+// Index files
+//
+// The index is a text file:
+//
+//   GRIB2_INDEX 1
+//   <file size> <file modify time>
+//   <number of records>
+// then for each record
+//   R <offset> <length> <number of fields>
+// followed by a line for each field, tab separated
+//   F <lead time> <name> <level type>
+
+string Grib2File::_getIndexPath(const string &gribPath) const
+{
+  if (_indexDir.size() == 0)
+    return gribPath + ".g2idx";
+
+  string fileName(gribPath);
+  size_t slash = fileName.rfind('/');
+  if (slash != string::npos)
+    fileName = fileName.substr(slash + 1);
+  return _indexDir + "/" + fileName + ".g2idx";
+}
+
+int Grib2File::_readIndex(const string &indexPath, const struct stat &fileStat)
+{
+  FILE *in = fopen(indexPath.c_str(), "r");
+  if (in == NULL)
+    return -1;
+
+  char line[1024];
+  int version = 0;
+  long long fileSize = 0, mtime = 0;
+  int nRecords = 0;
+  if (fgets(line, sizeof(line), in) == NULL ||
+      sscanf(line, "GRIB2_INDEX %d", &version) != 1 || version != 1 ||
+      fgets(line, sizeof(line), in) == NULL ||
+      sscanf(line, "%lld %lld", &fileSize, &mtime) != 2 ||
+      fileSize != (long long) fileStat.st_size ||
+      mtime != (long long) fileStat.st_mtime ||
+      fgets(line, sizeof(line), in) == NULL ||
+      sscanf(line, "%d", &nRecords) != 1 || nRecords < 0)
+  {
+    fclose(in);
+    return -1;
+  }
+
+  for (int irec = 0; irec < nRecords; irec++) {
+
+    unsigned long long offset, length;
+    int nFields;
+    if (fgets(line, sizeof(line), in) == NULL ||
+        sscanf(line, "R %llu %llu %d", &offset, &length, &nFields) != 3 ||
+        offset + length > _mapLen || nFields < 0)
+    {
+      fclose(in);
+      return -1;
+    }
+
+    file_inventory_t inventory;
+    inventory.record = NULL;
+    inventory.offset = offset;
+    inventory.length = length;
+
+    for (int ifield = 0; ifield < nFields; ifield++) {
+      if (fgets(line, sizeof(line), in) == NULL || line[0] != 'F')
+      {
+        fclose(in);
+        return -1;
+      }
+      line[strcspn(line, "\n")] = '\0';
+      char *lead = strchr(line, '\t');
+      char *name = (lead ? strchr(lead + 1, '\t') : NULL);
+      char *level = (name ? strchr(name + 1, '\t') : NULL);
+      if (level == NULL)
+      {
+        fclose(in);
+        return -1;
+      }
+      *name = '\0';
+      *level = '\0';
+      field_index_t field;
+      field.leadTime = atol(lead + 1);
+      field.name = name + 1;
+      field.levelType = level + 1;
+      inventory.fields.push_back(field);
+    }
+
+    _inventory.push_back(inventory);
+
+  }
+
+  fclose(in);
+  return 0;
+}
+
+int Grib2File::_writeIndex(const string &indexPath, const struct stat &fileStat) const
+{
+  // write to a tmp file and rename, so that readers
+  // never see a partial index
+
+  char tmpPath[1024];
+  snprintf(tmpPath, sizeof(tmpPath), "%s.%d.tmp", indexPath.c_str(), (int) getpid());
+
+  FILE *out = fopen(tmpPath, "w");
+  if (out == NULL)
+  {
+    int errNum = errno;
+    cerr << "WARNING: Grib2File::_writeIndex()" << endl;
+    cerr << "Cannot write index file: " << indexPath << endl;
+    cerr << strerror(errNum) << endl;
+    return -1;
+  }
+
+  fprintf(out, "GRIB2_INDEX 1\n");
+  fprintf(out, "%lld %lld\n", (long long) fileStat.st_size, (long long) fileStat.st_mtime);
+  fprintf(out, "%d\n", (int) _inventory.size());
+
+  vector< file_inventory_t >::const_iterator inventory;
+  for (inventory = _inventory.begin(); inventory != _inventory.end(); ++inventory) {
+    fprintf(out, "R %llu %llu %d\n", (unsigned long long) inventory->offset,
+            (unsigned long long) inventory->length, (int) inventory->fields.size());
+    for (size_t ii = 0; ii < inventory->fields.size(); ii++) {
+      const field_index_t &field = inventory->fields[ii];
+      fprintf(out, "F\t%ld\t%s\t%s\n", field.leadTime,
+              field.name.c_str(), field.levelType.c_str());
+    }
+  }
+
+  if (fclose(out) != 0 || rename(tmpPath, indexPath.c_str()) != 0)
+  {
+    cerr << "WARNING: Grib2File::_writeIndex()" << endl;
+    cerr << "Cannot write index file: " << indexPath << endl;
+    unlink(tmpPath);
+    return -1;
+  }
+
+  return 0;
+}
+
 void Grib2File::printSummary(FILE *stream, int debug) const
 {
+  if (_unpackAll() != GRIB_SUCCESS)
+    return;
+
   vector< file_inventory_t >::const_iterator inventory;
   int rec_num = 1, fields_num = 0;
   
@@ -291,6 +608,12 @@ list <string> Grib2File::getFieldList()
   vector< file_inventory_t >::const_iterator inventory;
   list <string> fields;
   for (inventory = _inventory.begin(); inventory != _inventory.end(); ++inventory) {
+    if (inventory->record == NULL) {
+      // not unpacked yet, use the index
+      for (size_t ii = 0; ii < inventory->fields.size(); ii++)
+        fields.push_back(inventory->fields[ii].name);
+      continue;
+    }
     list <string> recordFields = inventory->record->getFieldList();
     list <string>::const_iterator field;
     for (field = recordFields.begin(); field != recordFields.end(); ++field) {
@@ -307,6 +630,12 @@ list <string> Grib2File::getFieldLevels(const string &fieldName)
   vector< file_inventory_t >::const_iterator inventory;
   list <string> levels;
   for (inventory = _inventory.begin(); inventory != _inventory.end(); ++inventory) {
+    if (inventory->record == NULL) {
+      for (size_t ii = 0; ii < inventory->fields.size(); ii++)
+        if (fieldName.compare(inventory->fields[ii].name) == 0)
+          levels.push_back(inventory->fields[ii].levelType);
+      continue;
+    }
     list <string> recordLevels = inventory->record->getFieldLevels(fieldName);
     list <string>::const_iterator level;
     for (level = recordLevels.begin(); level != recordLevels.end(); ++level) {
@@ -323,6 +652,11 @@ list <long int> Grib2File::getForecastList()
   vector< file_inventory_t >::const_iterator inventory;
   list <long int> times;
   for (inventory = _inventory.begin(); inventory != _inventory.end(); ++inventory) {
+    if (inventory->record == NULL) {
+      for (size_t ii = 0; ii < inventory->fields.size(); ii++)
+        times.push_back(inventory->fields[ii].leadTime);
+      continue;
+    }
     list <long int> recordTimes = inventory->record->getForecastList();
     list <long int>::const_iterator time;
     for (time = recordTimes.begin(); time != recordTimes.end(); ++time) {
@@ -342,6 +676,21 @@ vector <Grib2Record::Grib2Sections_t>  Grib2File::getRecords(const string &field
   vector< file_inventory_t >::const_iterator inventory;
 
   for (inventory = _inventory.begin(); inventory != _inventory.end(); ++inventory) {
+
+    // records read from an index are only unpacked if they match
+
+    if (inventory->record == NULL) {
+      bool matches = false;
+      for (size_t ii = 0; ii < inventory->fields.size() && !matches; ii++) {
+        const field_index_t &field = inventory->fields[ii];
+        matches = (fieldName.compare(field.name) == 0 &&
+                   level.compare(field.levelType) == 0 &&
+                   (leadTime == -99 || field.leadTime == leadTime));
+      }
+      if (!matches || _unpackRecord(*inventory) != GRIB_SUCCESS)
+        continue;
+    }
+
     if (inventory->record->recordMatches (fieldName, level)) {
       vector <Grib2Record::Grib2Sections_t> foundRecords = inventory->record->getRecords (fieldName, level, leadTime);
 
@@ -356,6 +705,9 @@ vector <Grib2Record::Grib2Sections_t>  Grib2File::getRecords(const string &field
 
 void Grib2File::printContents(FILE *stream, Grib2Record::print_sections_t printSec) const
 {
+  if (_unpackAll() != GRIB_SUCCESS)
+    return;
+
   vector< file_inventory_t >::const_iterator inventory;
   int rec_num = 0, fields_num = 0;
   
@@ -370,6 +722,9 @@ void Grib2File::printContents(FILE *stream, Grib2Record::print_sections_t printS
 
 void Grib2File::print(FILE *stream)
 {
+  if (_unpackAll() != GRIB_SUCCESS)
+    return;
+
   vector< file_inventory_t >::const_iterator inventory;
   
   for (inventory = _inventory.begin(); inventory != _inventory.end();
@@ -391,6 +746,8 @@ int Grib2File::create(g2_si32 disciplineNumber, time_t referenceTime, g2_si32 re
   }
 
   file_inventory_t inventory;
+  inventory.offset = 0;
+  inventory.length = 0;
   inventory.record = new Grib2Record(disciplineNumber, referenceTime, referenceTimeType, 
 				     typeOfData, generatingSubCentreID, generatingCentreID, 
 				     productionStatus, localTablesVersion, masterTablesVersion);
@@ -473,6 +830,11 @@ int Grib2File::write(const string &file_path)
       
       return GRIB_FAILURE;
     }
+
+    // Records read from an index may not be unpacked yet
+
+    if (_unpackAll() != GRIB_SUCCESS)
+      return GRIB_FAILURE;
     
     // Open the output file
     
@@ -136,7 +136,7 @@ Grib2Record::~Grib2Record()
 }
 
 
-int Grib2Record::unpack(g2_ui08 **file_ptr, g2_ui64 file_size)
+int Grib2Record::unpack(g2_ui08 **file_ptr, g2_ui64 file_size, bool copyData)
 {
   g2_ui08 *section_ptr = *file_ptr;
 
@@ -287,7 +287,7 @@ int Grib2Record::unpack(g2_ui08 **file_ptr, g2_ui64 file_size)
     if ((g2_si32) section_ptr[4] == 7) {
       RS.ds = new DS(sectionsPtr);
       // Unpack the data section
-      if ((return_value = RS.ds->unpack(section_ptr)) != GRIB_SUCCESS) {   
+      if ((return_value = RS.ds->unpack(section_ptr, copyData)) != GRIB_SUCCESS) {   
 	cerr << "ERROR: Grib2Record::unpack()" << endl;
         cerr << "Cannot unpack Data Section" << endl;
         return return_value;
@@ -581,6 +581,30 @@ vector <Grib2Record::Grib2Sections_t> Grib2Record::getRecords(const string &fiel
   return matches;
 }
 
+// get all records
+vector <Grib2Record::Grib2Sections_t> Grib2Record::getRecords()
+{
+  vector < repeatSections_t >::iterator RS;
+  vector <Grib2Sections_t> matches;
+
+  for (RS = _repeatSec.begin(); RS != _repeatSec.end(); ++RS) {
+    Grib2Sections_t match;
+    match.is = &_is;
+    match.ids = &_ids;
+    match.lus = RS->lus;
+    match.gds = RS->gds;
+    match.pds = RS->pds;
+    match.drs = RS->drs;
+    match.bms = RS->bms;
+    match.ds = RS->ds;
+    match.summary = &(RS->summary);
+    match.es = &_es;
+    matches.push_back(match);
+  }
+
+  return matches;
+}
+
 // Determine if there are any records matching those with attributes in the argument list
 bool Grib2Record::recordMatches (const string &fieldName, const string &level) {
 
@@ -29,6 +29,7 @@
 //////////////////////////////////////////////////
 
 #include <cmath>
+#include <pthread.h>
 
 #include <grib2/Template7.4000.hh>
 #include <grib2/DS.hh>
@@ -47,6 +48,10 @@ using namespace std;
 
 namespace Grib2 {
 
+// Jasper is not reentrant in all versions, so records which are
+// unpacked on several threads take turns decoding the code stream
+
+static pthread_mutex_t _jasperMutex = PTHREAD_MUTEX_INITIALIZER;
 
 Template7_pt_4000::Template7_pt_4000(Grib2Record::Grib2Sections_t sectionsPtr)
   : DataTemp(sectionsPtr), jpcminlen(200)
@@ -280,7 +285,10 @@ int Template7_pt_4000::unpack (g2_ui08 *dataPtr)
     g2_si32 *tmp_data = new g2_si32 [gridSz];
     g2_si32 compressed_len = _sectionsPtr.ds->getSize() - 5;
 
-    if(decode_jpeg2000 ((char *) dataPtr, compressed_len, tmp_data) == GRIB_FAILURE) {
+    pthread_mutex_lock(&_jasperMutex);
+    int iret = decode_jpeg2000 ((char *) dataPtr, compressed_len, tmp_data);
+    pthread_mutex_unlock(&_jasperMutex);
+    if(iret == GRIB_FAILURE) {
       delete [] tmp_data;
       return GRIB_FAILURE;
     }
@@ -70,8 +70,10 @@ public:
   
   /** @brief Unpack the Data Section
    *  @param[in] dsPtr Pointer to start of section
+   *  @param[in] copyData If false the packed data is not copied, and
+   *   dsPtr must remain valid until the data is decoded or freed
    *  @return Either GRIB_SUCCESS or GRIB_FAILURE */
-  int unpack( g2_ui08 *dsPtr );
+  int unpack( g2_ui08 *dsPtr, bool copyData = true );
 
   /** @brief Encodes a data set and stores it internally
    *  @param[in] dataPtr Pointer to data set to encode
@@ -164,6 +166,9 @@ private:
   /** @brief Pointer to read data before being decoded */
   g2_ui08 *_readDataPtr;
 
+  /** @brief Flag indicating _readDataPtr was allocated here */
+  bool _ownsReadData;
+
 };
 
 } // namespace Grib2
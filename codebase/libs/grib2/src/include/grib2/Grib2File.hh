@@ -35,6 +35,8 @@
 #include <string>
 #include <vector>
 #include <list>
+#include <pthread.h>
+#include <sys/stat.h>
 
 #include <grib2/Grib2Record.hh>
 
@@ -45,6 +47,7 @@ namespace Grib2 {
 class GribProj;
 class ProdDefTemp;
 class DataRepTemp;
+class DS;
 
 /** 
  * @class Grib2File
@@ -67,11 +70,42 @@ public:
 
   // Functions for reading a Grib2 file  
 
-  /** @brief Open and read (unpack) a grib2 file, including all records in the file.
+  /** @brief Open and inventory a grib2 file, including all records in the file.
+   *
+   * The file is memory mapped. The section headers of each record are
+   * unpacked, but the packed data is left in the mapped file until it
+   * is requested through Grib2Sections_t.ds->getData().
+   *
+   * If an index is in use (see setUseIndex) and a valid index file
+   * exists, no records are unpacked until they are requested through
+   * getRecords. Otherwise the index file is written after the inventory.
+   *
    *  @param[in] file_path Full path to file to open
    *  @return Either Grib2::GRIB_SUCCESS or Grib2::GRIB_FAILURE */
   int read(const string &file_path = "");
 
+  /** @brief Use a sidecar index file to speed up re-opening a file.
+   *
+   * The index holds the location, field names, levels and lead times
+   * of each record. It is valid while the size and modify time of the
+   * grib2 file match those stored in the index.
+   *
+   *  @param[in] useIndex Turn use of the index on or off
+   *  @param[in] indexDir Directory for index files. If empty, the index
+   *   is stored alongside the grib2 file, with the extension .g2idx */
+  void setUseIndex(bool useIndex, const string &indexDir = "");
+
+  /** @brief Decode the data for a set of records, using several threads.
+   *
+   * After this call Grib2Sections_t.ds->getData() returns the decoded
+   * data without further work. Use ds->freeData() to reclaim memory.
+   *
+   *  @param[in] records Records as returned by getRecords
+   *  @param[in] nThreads Number of threads to use
+   *  @return Either Grib2::GRIB_SUCCESS or Grib2::GRIB_FAILURE */
+  static int decodeRecords(vector <Grib2Record::Grib2Sections_t> &records,
+                           int nThreads);
+
   /** @brief Print to stream/file all Grib2 sections */
   void print(FILE *stream);
 
@@ -246,9 +280,24 @@ private:
   /** @brief Internally set the file we are reading */
   void _setFilePath (const string &new_file_path);
   
+  /** @brief Identifies a single field within a record */
+  typedef struct {
+    string name;
+    string levelType;
+    long int leadTime;
+  } field_index_t;
+
   typedef struct {
 
-    Grib2Record *record;
+    /** Unpacked record, NULL until required if read from an index */
+    mutable Grib2Record *record;
+
+    /** Location of the record in the file */
+    g2_ui64 offset;
+    g2_ui64 length;
+
+    /** Fields within the record */
+    vector< field_index_t > fields;
 
   } file_inventory_t;
   
@@ -264,6 +313,41 @@ private:
   /** @brief Curret file pointer read state */
   bool _fileContentsRead;
 
+  /** @brief Memory mapped contents of the read file */
+  g2_ui08 *_mapPtr;
+  g2_ui64 _mapLen;
+
+  /** @brief Index file options */
+  bool _useIndex;
+  string _indexDir;
+
+  /** @brief Unmap the read file */
+  void _unmapFile();
+
+  /** @brief Unpack a record from the mapped file, if not already done */
+  int _unpackRecord(const file_inventory_t &inventory) const;
+
+  /** @brief Unpack all records from the mapped file */
+  int _unpackAll() const;
+
+  /** @brief Fill out the field index for an unpacked record */
+  static void _loadFieldIndex(file_inventory_t &inventory);
+
+  /** @brief Index file support */
+  string _getIndexPath(const string &gribPath) const;
+  int _readIndex(const string &indexPath, const struct stat &fileStat);
+  int _writeIndex(const string &indexPath, const struct stat &fileStat) const;
+
+  /** @brief Thread support for decodeRecords */
+  typedef struct {
+    vector<DS *> *dsList;
+    size_t next;
+    int nFailed;
+    pthread_mutex_t mutex;
+  } decode_job_t;
+
+  static void *_decodeThreadMain(void *args);
+
   typedef enum {
     CONSTRUCT,
     CLEAR,
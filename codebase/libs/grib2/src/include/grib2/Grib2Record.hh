@@ -193,8 +193,10 @@ public:
   /** @brief Unpack a grib2 record pointed to by filePtr
    *  @param[in] filePtr Pointer to start of record
    *  @param[in] file_size Size of filePtr
+   *  @param[in] copyData If false the packed data sections are not copied,
+   *   and the buffer must remain valid for the life of the record
    *  @return Either Grib2::GRIB_SUCCESS or Grib2::GRIB_FAILURE */
-  int unpack(g2_ui08 **filePtr, g2_ui64 file_size);
+  int unpack(g2_ui08 **filePtr, g2_ui64 file_size, bool copyData = true);
 
   /** @brief Packs all the data of this record into a byte array.
    *  @return A g2_ui08 array with the data of this record into it.
@@ -253,6 +255,9 @@ public:
   vector <Grib2Sections_t> getRecords(const string &fieldName, const string &level, 
 				      const long int &leadTime = -99);
 
+  /** @brief Get all the fields in this record */
+  vector <Grib2Sections_t> getRecords();
+
   /** @brief Determine if there are any fields matching fieldName and level
    *
    * @param[in] fieldName Requested field name
@@ -0,0 +1,185 @@
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*
+// ** Copyright UCAR (c) 1990 - 2016
+// ** University Corporation for Atmospheric Research (UCAR)
+// ** National Center for Atmospheric Research (NCAR)
+// ** Boulder, Colorado, USA
+// ** BSD licence applies - redistribution and use in source and binary
+// ** forms, with or without modification, are permitted provided that
+// ** the following conditions are met:
+// ** 1) If the software is modified to produce derivative works,
+// ** such modified software should be clearly marked, so as not
+// ** to confuse it with the version available from UCAR.
+// ** 2) Redistributions of source code must retain the above copyright
+// ** notice, this list of conditions and the following disclaimer.
+// ** 3) Redistributions in binary form must reproduce the above copyright
+// ** notice, this list of conditions and the following disclaimer in the
+// ** documentation and/or other materials provided with the distribution.
+// ** 4) Neither the name of UCAR nor the names of its contributors,
+// ** if any, may be used to endorse or promote products derived from
+// ** this software without specific prior written permission.
+// ** DISCLAIMER: THIS SOFTWARE IS PROVIDED "AS IS" AND WITHOUT ANY EXPRESS
+// ** OR IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+// ** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*
+/*
+ *   Module: kd_flat.hh
+ *
+ *   Description:
+ *
+ *       KD tree stored in flat arrays, for fast Euclidean queries
+ *       on large point sets.
+ *
+ *       The tree is balanced and complete, and is held in
+ *       breadth-first order: the children of node i are nodes
+ *       2i+1 and 2i+2, so no child pointers are needed. The points
+ *       are copied into a single float32 array, reordered so that
+ *       the points in each leaf bucket are contiguous.
+ *
+ *       The query methods are const and keep all of their state on
+ *       the stack, so a single tree may be queried from several
+ *       threads at once without copying it. The batch methods
+ *       partition a set of queries across a number of threads.
+ *
+ *       Distances are returned as squares of the Euclidean distance,
+ *       as for KD_tree::nnquery() with KD_EUCLIDEAN.
+ */
+
+#ifndef KD_FLAT_HH
+#define KD_FLAT_HH
+
+#include <pthread.h>
+#include <vector>
+#include "datatype.hh"
+
+using namespace std;
+
+const int KD_FLAT_BUCKETSIZE = 16;
+const float KD_FLAT_MISSING_DIST = 1.0e30f; // distance for missing neighbors
+
+class KD_flat_tree
+{
+public:
+
+  // Construct from an array of pointers to points, as for KD_tree.
+  // The points are copied, so they need not persist.
+
+  KD_flat_tree(const KD_real **points, int num_points, int dimension);
+
+  // Construct from a contiguous array of float coordinates,
+  // num_points * dimension long, point by point.
+
+  KD_flat_tree(const float *coords, int num_points, int dimension);
+
+  ~KD_flat_tree();
+
+  // Find the numNN nearest neighbors of querpoint.
+  // found:  indices of the points found, closest first
+  // distSq: squares of distances of the points found
+  // If there are fewer than numNN points, the remaining entries
+  // are set to -1 and KD_FLAT_MISSING_DIST.
+  // Returns the number of neighbors found.
+
+  int nnquery(const float *querpoint, int numNN,
+              int *found, float *distSq) const;
+
+  // Find all points within radius of querpoint.
+  // found and distSq are cleared, and the results are returned
+  // in no particular order.
+  // Returns the number of points found.
+
+  int radiusquery(const float *querpoint, float radius,
+                  vector<int> &found, vector<float> &distSq) const;
+
+  // Batch queries.
+  // querpoints is num_queries * dimension long, query by query.
+  // The queries are divided among num_threads threads.
+  //
+  // nnqueryMany: found and distSq must be num_queries * numNN long,
+  //   with the results for each query stored as for nnquery().
+  //
+  // radiusqueryMany: found and distSq are resized to num_queries.
+
+  void nnqueryMany(const float *querpoints, int num_queries, int numNN,
+                   int *found, float *distSq, int num_threads) const;
+
+  void radiusqueryMany(const float *querpoints, int num_queries,
+                       float radius,
+                       vector< vector<int> > &found,
+                       vector< vector<float> > &distSq,
+                       int num_threads) const;
+
+  // Return the number of points specified by the user
+  int get_num_points() const { return _num_points; }
+
+  // Return the number of dimensions specified by the user
+  int get_dimension() const { return _dimension; }
+
+  // Return the depth of the tree - there are 2^depth leaves
+  int get_depth() const { return _depth; }
+
+private:
+
+  int _num_points;
+  int _dimension;
+  int _depth;
+  int _num_internal;  // number of internal nodes, 2^depth - 1
+  int _num_leaves;    // number of leaf buckets, 2^depth
+
+  // internal nodes, breadth-first
+
+  vector<int> _discrim;     // splitting dimension
+  vector<float> _cutval;    // splitting value
+
+  // leaf buckets - points for leaf k are
+  // _leafStart[k] to _leafStart[k+1] - 1
+
+  vector<int> _leafStart;
+
+  // points, reordered by leaf, and their original indices
+
+  vector<float> _coords;
+  vector<int> _index;
+
+  void _build(const float *coords);
+  void _buildNode(const float *coords, vector<int> &perm,
+                  int node, int level, int l, int r);
+  int _findMaxSpread(const float *coords, const vector<int> &perm,
+                     int l, int r) const;
+
+  // batch query support
+
+  typedef enum {
+    QUERY_NN,
+    QUERY_RADIUS
+  } query_type_t;
+
+  class BatchQuery {
+  public:
+    const KD_flat_tree *tree;
+    query_type_t qtype;
+    const float *querpoints;
+    int num_queries;
+    int numNN;
+    int *found;
+    float *distSq;
+    float radius;
+    vector< vector<int> > *foundVec;
+    vector< vector<float> > *distSqVec;
+    int nextQuery;
+    pthread_mutex_t mutex;
+  };
+
+  static const int _batchBlockSize = 256;
+
+  void _runBatch(BatchQuery &batch, int num_threads) const;
+  static void *_batchThreadMain(void *args);
+  static void _runBatchQueries(BatchQuery &batch);
+
+  // no copying
+
+  KD_flat_tree(const KD_flat_tree &);
+  KD_flat_tree & operator=(const KD_flat_tree &);
+
+};
+
+#endif /* KD_FLAT_HH */
@@ -0,0 +1,441 @@
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*
+// ** Copyright UCAR (c) 1990 - 2016
+// ** University Corporation for Atmospheric Research (UCAR)
+// ** National Center for Atmospheric Research (NCAR)
+// ** Boulder, Colorado, USA
+// ** BSD licence applies - redistribution and use in source and binary
+// ** forms, with or without modification, are permitted provided that
+// ** the following conditions are met:
+// ** 1) If the software is modified to produce derivative works,
+// ** such modified software should be clearly marked, so as not
+// ** to confuse it with the version available from UCAR.
+// ** 2) Redistributions of source code must retain the above copyright
+// ** notice, this list of conditions and the following disclaimer.
+// ** 3) Redistributions in binary form must reproduce the above copyright
+// ** notice, this list of conditions and the following disclaimer in the
+// ** documentation and/or other materials provided with the distribution.
+// ** 4) Neither the name of UCAR nor the names of its contributors,
+// ** if any, may be used to endorse or promote products derived from
+// ** this software without specific prior written permission.
+// ** DISCLAIMER: THIS SOFTWARE IS PROVIDED "AS IS" AND WITHOUT ANY EXPRESS
+// ** OR IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+// ** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*
+//----------------------------------------------------------------------
+// Module: kd_flat.cc
+//
+// Description:
+//       KD tree stored in flat arrays, with a breadth-first node
+//       layout. See kd_flat.hh.
+//----------------------------------------------------------------------
+
+// Include files
+#include <algorithm>
+#include "../include/kd/kd_flat.hh"
+
+using namespace std;
+
+// Constant, macro and type definitions
+
+// max depth of the tree - allows for 2^31 points with full buckets
+
+static const int MAX_DEPTH = 32;
+
+// Functions and objects
+
+// Comparison of points in a single dimension, for partitioning
+
+class KD_flat_compare
+{
+public:
+  KD_flat_compare(const float *coords, int dimension, int discrim) :
+    _coords(coords), _dimension(dimension), _discrim(discrim) {}
+  bool operator()(int a, int b) const
+  {
+    return (_coords[(size_t) a * _dimension + _discrim] <
+            _coords[(size_t) b * _dimension + _discrim]);
+  }
+private:
+  const float *_coords;
+  int _dimension;
+  int _discrim;
+};
+
+KD_flat_tree::KD_flat_tree(const KD_real **points, int num_points, int dimension) :
+  _num_points(num_points), _dimension(dimension)
+{
+  vector<float> coords((size_t) num_points * dimension);
+  for (int i=0; i < num_points; i++)
+    for (int j=0; j < dimension; j++)
+      coords[(size_t) i * dimension + j] = (float) points[i][j];
+  _build(coords.data());
+}
+
+KD_flat_tree::KD_flat_tree(const float *coords, int num_points, int dimension) :
+  _num_points(num_points), _dimension(dimension)
+{
+  _build(coords);
+}
+
+KD_flat_tree::~KD_flat_tree()
+{
+}
+
+// Build the tree.
+// The depth is chosen so that no leaf bucket holds more than
+// KD_FLAT_BUCKETSIZE points.
+void KD_flat_tree::_build(const float *coords)
+{
+  if (_num_points < 0)
+    _num_points = 0;
+
+  _depth = 0;
+  while (_depth < MAX_DEPTH - 1 &&
+	 (((long long) _num_points + (1LL << _depth) - 1) >> _depth) > KD_FLAT_BUCKETSIZE)
+    _depth++;
+
+  _num_leaves = 1 << _depth;
+  _num_internal = _num_leaves - 1;
+
+  _discrim.resize(_num_internal);
+  _cutval.resize(_num_internal);
+  _leafStart.resize(_num_leaves + 1);
+
+  // initialize perm array
+  vector<int> perm(_num_points);
+  for (int j=0; j < _num_points; j++)
+    perm[j] = j;
+
+  _buildNode(coords, perm, 0, 0, 0, _num_points);
+  _leafStart[_num_leaves] = _num_points;
+
+  // copy the points into leaf order
+  _coords.resize((size_t) _num_points * _dimension);
+  _index.resize(_num_points);
+  for (int i=0; i < _num_points; i++)
+    {
+      _index[i] = perm[i];
+      const float *src = coords + (size_t) perm[i] * _dimension;
+      float *dest = &_coords[(size_t) i * _dimension];
+      for (int j=0; j < _dimension; j++)
+	dest[j] = src[j];
+    }
+}
+
+// Build the subtree for node, covering perm[l] to perm[r-1].
+// The leaves are reached in left to right order, so the
+// leaf start indices are set in increasing order.
+void KD_flat_tree::_buildNode(const float *coords, vector<int> &perm,
+			      int node, int level, int l, int r)
+{
+  if (level == _depth)
+    {
+      _leafStart[node - _num_internal] = l;
+      return;
+    }
+
+  int m = (l + r) / 2;		// midpoint
+  if (r > l)
+    {
+      int discrim = _findMaxSpread(coords, perm, l, r);
+      // partition points around the midpoint, m
+      nth_element(perm.begin() + l, perm.begin() + m, perm.begin() + r,
+		  KD_flat_compare(coords, _dimension, discrim));
+      _discrim[node] = discrim;
+      _cutval[node] = coords[(size_t) perm[m] * _dimension + discrim];
+    }
+  else
+    {
+      // empty subtree
+      _discrim[node] = 0;
+      _cutval[node] = 0.0;
+    }
+
+  _buildNode(coords, perm, 2 * node + 1, level + 1, l, m);
+  _buildNode(coords, perm, 2 * node + 2, level + 1, m, r);
+}
+
+// Find dimension where the maximum spread occurs
+int KD_flat_tree::_findMaxSpread(const float *coords, const vector<int> &perm,
+				 int l, int r) const
+{
+  int maxdim = 0;
+  float maxspread = -1.0;
+
+  for (int i=0; i < _dimension; i++)
+    {
+      float min = coords[(size_t) perm[l] * _dimension + i];
+      float max = min;
+      for (int j=l+1; j < r; j++)
+	{
+	  float val = coords[(size_t) perm[j] * _dimension + i];
+	  if (val < min)
+	    min = val;
+	  else if (val > max)
+	    max = val;
+	}
+      if (max - min > maxspread)
+	{
+	  maxspread = max - min;
+	  maxdim = i;
+	}
+    }
+
+  return(maxdim);
+}
+
+// Search the tree depth first, using a stack of nodes still to be
+// visited. Each entry holds a lower bound on the squared distance
+// from the query point to the points below the node, so that
+// nodes can be skipped once better neighbors have been found.
+int KD_flat_tree::nnquery(const float *querpoint, int numNN,
+			  int *found, float *distSq) const
+{
+  if (numNN <= 0)
+    return 0;
+
+  for (int k=0; k < numNN; k++)
+    {
+      found[k] = -1;
+      distSq[k] = KD_FLAT_MISSING_DIST;
+    }
+
+  int nFound = 0;
+  float worst = KD_FLAT_MISSING_DIST;
+
+  int stackNode[MAX_DEPTH + 1];
+  float stackBound[MAX_DEPTH + 1];
+  int nStack = 1;
+  stackNode[0] = 0;
+  stackBound[0] = 0.0;
+
+  while (nStack > 0)
+    {
+      nStack--;
+      int node = stackNode[nStack];
+      if (stackBound[nStack] > worst)
+	continue;
+
+      if (node >= _num_internal)
+	{
+	  // leaf - check all points in the bucket
+	  int leaf = node - _num_internal;
+	  int hi = _leafStart[leaf + 1];
+	  for (int i=_leafStart[leaf]; i < hi; i++)
+	    {
+	      const float *pt = &_coords[(size_t) i * _dimension];
+	      float thisdist = 0.0;
+	      for (int j=0; j < _dimension; j++)
+		{
+		  float d = querpoint[j] - pt[j];
+		  thisdist += d * d;
+		}
+	      if (thisdist >= worst && nFound == numNN)
+		continue;
+
+	      // insert in sorted position
+	      int k = (nFound < numNN) ? nFound++ : numNN - 1;
+	      while (k > 0 && distSq[k-1] > thisdist)
+		{
+		  distSq[k] = distSq[k-1];
+		  found[k] = found[k-1];
+		  k--;
+		}
+	      distSq[k] = thisdist;
+	      found[k] = _index[i];
+	      if (nFound == numNN)
+		worst = distSq[numNN - 1];
+	    }
+	}
+      else
+	{
+	  // internal node - visit the near child first
+	  float val = querpoint[_discrim[node]] - _cutval[node];
+	  int nearChild = (val < 0) ? 2 * node + 1 : 2 * node + 2;
+	  int farChild = (val < 0) ? 2 * node + 2 : 2 * node + 1;
+	  float bound = stackBound[nStack];
+	  float farBound = val * val;
+	  if (farBound < bound)
+	    farBound = bound;
+	  stackNode[nStack] = farChild;
+	  stackBound[nStack] = farBound;
+	  nStack++;
+	  stackNode[nStack] = nearChild;
+	  stackBound[nStack] = bound;
+	  nStack++;
+	}
+    }
+
+  return nFound;
+}
+
+int KD_flat_tree::radiusquery(const float *querpoint, float radius,
+			      vector<int> &found, vector<float> &distSq) const
+{
+  found.clear();
+  distSq.clear();
+
+  float radiusSq = radius * radius;
+
+  int stackNode[MAX_DEPTH + 1];
+  float stackBound[MAX_DEPTH + 1];
+  int nStack = 1;
+  stackNode[0] = 0;
+  stackBound[0] = 0.0;
+
+  while (nStack > 0)
+    {
+      nStack--;
+      int node = stackNode[nStack];
+      if (stackBound[nStack] > radiusSq)
+	continue;
+
+      if (node >= _num_internal)
+	{
+	  int leaf = node - _num_internal;
+	  int hi = _leafStart[leaf + 1];
+	  for (int i=_leafStart[leaf]; i < hi; i++)
+	    {
+	      const float *pt = &_coords[(size_t) i * _dimension];
+	      float thisdist = 0.0;
+	      for (int j=0; j < _dimension; j++)
+		{
+		  float d = querpoint[j] - pt[j];
+		  thisdist += d * d;
+		}
+	      if (thisdist <= radiusSq)
+		{
+		  found.push_back(_index[i]);
+		  distSq.push_back(thisdist);
+		}
+	    }
+	}
+      else
+	{
+	  float val = querpoint[_discrim[node]] - _cutval[node];
+	  int nearChild = (val < 0) ? 2 * node + 1 : 2 * node + 2;
+	  int farChild = (val < 0) ? 2 * node + 2 : 2 * node + 1;
+	  float bound = stackBound[nStack];
+	  float farBound = val * val;
+	  if (farBound < bound)
+	    farBound = bound;
+	  stackNode[nStack] = farChild;
+	  stackBound[nStack] = farBound;
+	  nStack++;
+	  stackNode[nStack] = nearChild;
+	  stackBound[nStack] = bound;
+	  nStack++;
+	}
+    }
+
+  return (int) found.size();
+}
+
+void KD_flat_tree::nnqueryMany(const float *querpoints, int num_queries, int numNN,
+			       int *found, float *distSq, int num_threads) const
+{
+  BatchQuery batch;
+  batch.tree = this;
+  batch.qtype = QUERY_NN;
+  batch.querpoints = querpoints;
+  batch.num_queries = num_queries;
+  batch.numNN = numNN;
+  batch.found = found;
+  batch.distSq = distSq;
+  batch.radius = 0.0;
+  batch.foundVec = NULL;
+  batch.distSqVec = NULL;
+  _runBatch(batch, num_threads);
+}
+
+void KD_flat_tree::radiusqueryMany(const float *querpoints, int num_queries,
+				   float radius,
+				   vector< vector<int> > &found,
+				   vector< vector<float> > &distSq,
+				   int num_threads) const
+{
+  found.resize(num_queries);
+  distSq.resize(num_queries);
+  BatchQuery batch;
+  batch.tree = this;
+  batch.qtype = QUERY_RADIUS;
+  batch.querpoints = querpoints;
+  batch.num_queries = num_queries;
+  batch.numNN = 0;
+  batch.found = NULL;
+  batch.distSq = NULL;
+  batch.radius = radius;
+  batch.foundVec = &found;
+  batch.distSqVec = &distSq;
+  _runBatch(batch, num_threads);
+}
+
+// Run a batch of queries. The queries are handed out to the
+// threads in blocks, so that the load is balanced even if some
+// parts of the domain are more expensive to search than others.
+// The calling thread also runs queries.
+void KD_flat_tree::_runBatch(BatchQuery &batch, int num_threads) const
+{
+  batch.nextQuery = 0;
+  pthread_mutex_init(&batch.mutex, NULL);
+
+  int maxThreads = (batch.num_queries + _batchBlockSize - 1) / _batchBlockSize;
+  if (num_threads > maxThreads)
+    num_threads = maxThreads;
+
+  vector<pthread_t> threads;
+  for (int i=1; i < num_threads; i++)
+    {
+      pthread_t thread;
+      if (pthread_create(&thread, NULL, _batchThreadMain, &batch) == 0)
+	threads.push_back(thread);
+    }
+
+  _runBatchQueries(batch);
+
+  for (size_t i=0; i < threads.size(); i++)
+    pthread_join(threads[i], NULL);
+
+  pthread_mutex_destroy(&batch.mutex);
+}
+
+void *KD_flat_tree::_batchThreadMain(void *args)
+{
+  _runBatchQueries(*((BatchQuery *) args));
+  return NULL;
+}
+
+void KD_flat_tree::_runBatchQueries(BatchQuery &batch)
+{
+  const KD_flat_tree *tree = batch.tree;
+  int dimension = tree->_dimension;
+
+  for (;;)
+    {
+      // get the next block of queries
+      pthread_mutex_lock(&batch.mutex);
+      int start = batch.nextQuery;
+      batch.nextQuery += _batchBlockSize;
+      pthread_mutex_unlock(&batch.mutex);
+
+      if (start >= batch.num_queries)
+	break;
+      int end = min(start + _batchBlockSize, batch.num_queries);
+
+      for (int iq=start; iq < end; iq++)
+	{
+	  const float *querpoint = batch.querpoints + (size_t) iq * dimension;
+	  if (batch.qtype == QUERY_NN)
+	    {
+	      size_t offset = (size_t) iq * batch.numNN;
+	      tree->nnquery(querpoint, batch.numNN,
+			    batch.found + offset, batch.distSq + offset);
+	    }
+	  else
+	    {
+	      tree->radiusquery(querpoint, batch.radius,
+				(*batch.foundVec)[iq], (*batch.distSqVec)[iq]);
+	    }
+	}
+    }
+}
@@ -14,7 +14,13 @@
 // Date:   11/14/01
 //
 // Description:
-//     
+//     Timing tests for KD_tree and KD_flat_tree.
+//
+//     Usage: time_test_kd [npoints [nqueries [numNN [nthreads]]]]
+//
+//     Builds both trees over the same random 3-D points, runs the
+//     same nearest neighbor queries through each, checks that the
+//     results agree, and prints the build and query times.
 //----------------------------------------------------------------------
 
 // Include files 
@@ -25,167 +31,239 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <kd/kd.hh>
+#include <kd/kd_flat.hh>
 #include <kd/metric.hh>
 
+using namespace std;
+
 // Constant, macro and type definitions 
 
+const int DIMENSION = 3;
+
 // Global variables 
 
 // Functions and objects
 
-// Regular grid test
-// A test will consist of an input grid and a set of query points. The output will be a set
-// of nearest neighbors corresponding to the query points
-// Use regular grids for input and query points
-int test_rectquery(int xdim, int ydim, int zdim)
+static double get_time()
 {
-  int dimension = 3;
-  const int ndata = xdim * ydim * zdim;
-  int ind = 0;
-  int ret = 0;
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return tv.tv_sec + tv.tv_usec / 1.0e6;
+}
 
-  KD_real **A = new KD_real*[ndata];
-  KD_real *xdata = new KD_real[ndata];
-  KD_real *ydata = new KD_real[ndata];
-  KD_real *zdata = new KD_real[ndata];
-  KD_real *xgrid = new KD_real[ndata];
-  KD_real *ygrid = new KD_real[ndata];
-  KD_real *zgrid = new KD_real[ndata];
+static void print_time(const char *label, double secs, int nqueries)
+{
+  if (nqueries > 0)
+    printf("  %-32s %10.4f secs, %8.3f usecs/query\n",
+	   label, secs, secs * 1.0e6 / nqueries);
+  else
+    printf("  %-32s %10.4f secs\n", label, secs);
+}
 
-  for (unsigned int k=0; k<; k++)
+// Count the queries for which the neighbor distances differ between
+// the trees. The indices may legitimately differ for equidistant
+// points, so only the distances are compared. Missing neighbors,
+// when numNN exceeds the number of points, are not compared.
+static int count_mismatches(int nqueries, int numNN, const KD_real *dist,
+			    const int *found, const float *distSq)
+{
+  int nbad = 0;
+  for (int i=0; i<nqueries; i++)
     {
-      for (int j=0; j<ydim; j+=10)
+      for (int k=0; k<numNN; k++)
 	{
-	  for (int i=0; i<xdim; i+=10)
+	  if (found[i * numNN + k] < 0)
+	    continue;
+	  KD_real d1 = dist[i * numNN + k];
+	  KD_real d2 = distSq[i * numNN + k];
+	  if (fabs(d1 - d2) > 1.0e-3 * (1.0 + d1))
 	    {
-
-	      xdata[ind] = i;
-	      ydata[ind] = j;
-	      xgrid[ind] = i + 0.25;
-	      ygrid[ind] = j + 0.75;
-	      ind++;
+	      nbad++;
+	      break;
 	    }
 	}
     }
+  return nbad;
+}
+
+// Random points test
+// Points and queries are uniformly distributed in a 3-D box, with
+// a smaller extent in z - similar to the radar points searched
+// by Radx2Grid.
+int test_nnquery_random(int npoints, int nqueries, int numNN, int nthreads)
+{
+  printf("Points: %d, queries: %d, neighbors: %d, threads: %d\n",
+	 npoints, nqueries, numNN, nthreads);
+
+  srand48(12345);
+
+  vector<float> coords(npoints * DIMENSION);
+  KD_real **A = new KD_real*[npoints];
+  for (int k=0; k < npoints; k++)
+    {
+      A[k] = new KD_real[DIMENSION];
+      A[k][0] = drand48() * 20.0;
+      A[k][1] = drand48() * 400.0 - 200.0;
+      A[k][2] = drand48() * 400.0 - 200.0;
+      for (int j=0; j < DIMENSION; j++)
+	coords[k * DIMENSION + j] = A[k][j];
+    }
 
-  // Allocate and initialize array
-  for (int k=0; k < ndata; k++)
+  vector<float> queries(nqueries * DIMENSION);
+  for (int i=0; i < nqueries; i++)
     {
-      A[k] = new KD_real[dimension];
-      A[k][0] = xdata[k];
-      A[k][1] = ydata[k];
-      A[k][2] = zdata[k];
+      queries[i * DIMENSION + 0] = drand48() * 20.0;
+      queries[i * DIMENSION + 1] = drand48() * 400.0 - 200.0;
+      queries[i * DIMENSION + 2] = drand48() * 400.0 - 200.0;
     }
 
-  // Create KD tree
-  KD_tree kdt((const KD_real **)A, ndata, dimension);
-  
-  // Allocate rectangular query consisting of x bounds, y bounds, etc.
-  KD_real **rectquery = new (KD_real*)[dimension];
+  // pointer-linked tree
+
+  double start = get_time();
+  KD_tree kdt((const KD_real **)A, npoints, DIMENSION);
+  print_time("KD_tree build", get_time() - start, 0);
 
-  for (int k=0; k < dimension; k++)
-    rectquery[k] = new KD_real[2]; // for low and high bounds for each dimension
+  vector<int> found(nqueries * numNN);
+  vector<KD_real> dist(nqueries * numNN);
+  KD_real querpoint[DIMENSION];
 
-  // Run through 100 query rectangles
-  for (unsigned int i=0; i<100; i++)
+  start = get_time();
+  for (int i=0; i < nqueries; i++)
     {
-      for (unsigned int j=0; j<dimension; j++)
-	{
-	  rectquery[j][0] = i;		// x bounds
-	  rectquery[j][1] = i+10;
-	  kdt.rectquery((const KD_real **)rectquery, ptsFound);
-	}
+      for (int j=0; j < DIMENSION; j++)
+	querpoint[j] = queries[i * DIMENSION + j];
+      kdt.nnquery(querpoint, numNN, KD_EUCLIDEAN, 1,
+		  &found[i * numNN], &dist[i * numNN]);
     }
+  print_time("KD_tree nnquery", get_time() - start, nqueries);
 
+  // flat tree
 
-  for (int k=0; k < dimension; k++)
-    delete [] rectquery[k];
+  start = get_time();
+  KD_flat_tree flat(coords.data(), npoints, DIMENSION);
+  print_time("KD_flat_tree build", get_time() - start, 0);
 
-  delete [] rectquery;
+  vector<int> flatFound(nqueries * numNN);
+  vector<float> flatDistSq(nqueries * numNN);
 
-  for (int k=0; k < ndata; k++)
-    delete [] A[k];
+  start = get_time();
+  for (int i=0; i < nqueries; i++)
+    {
+      flat.nnquery(&queries[i * DIMENSION], numNN,
+		   &flatFound[i * numNN], &flatDistSq[i * numNN]);
+    }
+  print_time("KD_flat_tree nnquery", get_time() - start, nqueries);
 
-  delete [] A;
-  delete [] xdata;
-  delete [] ydata;
-  delete [] xgrid;
-  delete [] ygrid;
+  int ret = 0;
+  int nbad = count_mismatches(nqueries, numNN, dist.data(),
+			      flatFound.data(), flatDistSq.data());
+  if (nbad > 0)
+    {
+      printf("ERROR - nnquery results differ for %d queries\n", nbad);
+      ret = -1;
+    }
 
-  return(ret);
-}
+  start = get_time();
+  flat.nnqueryMany(queries.data(), nqueries, numNN,
+		   flatFound.data(), flatDistSq.data(), nthreads);
+  print_time("KD_flat_tree nnqueryMany", get_time() - start, nqueries);
 
+  nbad = count_mismatches(nqueries, numNN, dist.data(),
+			  flatFound.data(), flatDistSq.data());
+  if (nbad > 0)
+    {
+      printf("ERROR - nnqueryMany results differ for %d queries\n", nbad);
+      ret = -1;
+    }
 
-// Regular grid test
-// A test will consist of an input grid and a set of query points. The output will be a set
-// of nearest neighbors corresponding to the query points
-// Use regular grids for input and query points
-int test_nnquery_reg(int xdim, int ydim)
-{
-  int dimension = 2;
-  const int ndata = xdim * ydim;
-  const int num_neighbor = 3;
-  int found[num_neighbor];
-  KD_real dist[num_neighbor];
-
-  KD_real *xdata = new KD_real[ndata];
-  KD_real *ydata = new KD_real[ndata];
-  KD_real *xgrid = new KD_real[ndata];
-  KD_real *ygrid = new KD_real[ndata];
-  KD_real **A;
-
-  int Metric = KD_EUCLIDEAN;
-  int MinkP = 1;
-  KD_real querpoint[2];
-
-  int ind = 0;
-  for (int j=0; j<ydim; j++)
+  // radius queries, checked against the rectangle query of KD_tree
+
+  const float radius = 2.0;
+  int nradius = min(nqueries, 10000);
+  vector< vector<int> > radFound;
+  vector< vector<float> > radDistSq;
+
+  start = get_time();
+  flat.radiusqueryMany(queries.data(), nradius, radius,
+		       radFound, radDistSq, nthreads);
+  print_time("KD_flat_tree radiusqueryMany", get_time() - start, nradius);
+
+  KD_real **rectquery = new KD_real*[DIMENSION];
+  for (int k=0; k < DIMENSION; k++)
+    rectquery[k] = new KD_real[2];
+
+  nbad = 0;
+  for (int i=0; i < nradius; i++)
     {
-      for (int i=0; i<xdim; i++)
+      for (int j=0; j < DIMENSION; j++)
 	{
-	  xdata[ind] = i;
-	  ydata[ind] = j;
-	  xgrid[ind] = i + 0.25;
-	  ygrid[ind] = j + 0.75;
-	  ind++;
+	  rectquery[j][0] = queries[i * DIMENSION + j] - radius;
+	  rectquery[j][1] = queries[i * DIMENSION + j] + radius;
+	}
+      vector<int> ptsFound;
+      kdt.rectquery((const KD_real **)rectquery, ptsFound);
+      size_t ninside = 0;
+      for (size_t k=0; k < ptsFound.size(); k++)
+	{
+	  KD_real distSq = 0.0;
+	  for (int j=0; j < DIMENSION; j++)
+	    {
+	      KD_real d = A[ptsFound[k]][j] - queries[i * DIMENSION + j];
+	      distSq += d * d;
+	    }
+	  if (distSq < radius * radius * 0.999)
+	    ninside++;
 	}
+      if (radFound[i].size() < ninside)
+	nbad++;
     }
-
-  A = new KD_real*[ndata];
-  for (int k=0; k < ndata; k++)
+  if (nbad > 0)
     {
-      A[k] = new KD_real[2];	// dimension is 2
-      A[k][0] = xdata[k];
-      A[k][1] = ydata[k];
+      printf("ERROR - radiusqueryMany missed points for %d queries\n", nbad);
+      ret = -1;
     }
 
-  // Create KD tree
-  KD_tree kdt((const KD_real **)A, ndata, dimension);
-  
-  // Get nearest neighbor of query points
-  for (int i=0; i<ndata; i++)
-    {
-      querpoint[0] = xgrid[i];
-      querpoint[1] = ygrid[i];
-      kdt.nnquery(querpoint, num_neighbor, Metric, MinkP, found, dist);
-    }
+  for (int k=0; k < DIMENSION; k++)
+    delete [] rectquery[k];
+  delete [] rectquery;
 
-  for (int k=0; k < ndata; k++)
+  for (int k=0; k < npoints; k++)
     delete [] A[k];
+  delete [] A;
 
-  delete [] xdata;
-  delete [] ydata;
-  delete [] xgrid;
-  delete [] ygrid;
-  return(0);
+  return(ret);
 }
 
 
 int main(int argc, char **argv)
 {
-  int ret;
-  
-  // Find the nearest neighbors of 1000 x 1000 points
-  ret = test_nnquery_reg(1000, 1000);
+  int npoints = 1000000;
+  int nqueries = 1000000;
+  int numNN = 8;
+  int nthreads = 4;
+
+  if (argc > 1)
+    npoints = atoi(argv[1]);
+  if (argc > 2)
+    nqueries = atoi(argv[2]);
+  if (argc > 3)
+    numNN = atoi(argv[3]);
+  if (argc > 4)
+    nthreads = atoi(argv[4]);
+
+  if (npoints < 1 || nqueries < 1 || numNN < 1 || nthreads < 1)
+    {
+      fprintf(stderr, "Usage: %s [npoints [nqueries [numNN [nthreads]]]]\n",
+	      argv[0]);
+      return 1;
+    }
+
+  // KD_tree requires at least numNN points
+  if (numNN > npoints)
+    numNN = npoints;
+
+  if (test_nnquery_random(npoints, nqueries, numNN, nthreads))
+    return 1;
+
   return 0;
 }
@@ -48,6 +48,7 @@
 #include <didss/DsMessage.hh>
 #include <didss/DsMsgPart.hh>
 #include <rapformats/DsRadarMsg.hh>
+#include <rapformats/DsBeamView.hh>
 #include <rapformats/DsRadarParams.hh>
 #include <radar/IwrfTsInfo.hh>
 #include <Radx/RadxVol.hh>
@@ -176,6 +177,7 @@ protected:
   // reading DsRadar format - FMQ only
 
   DsRadarMsg _dsRadarMsg;
+  DsBeamView _dsBeamView;
   int _dsContents;
   
   // Radx objects
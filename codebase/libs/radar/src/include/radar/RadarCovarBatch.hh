@@ -0,0 +1,179 @@
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* 
+// ** Copyright UCAR (c) 1990 - 2016                                         
+// ** University Corporation for Atmospheric Research (UCAR)                 
+// ** National Center for Atmospheric Research (NCAR)                        
+// ** Boulder, Colorado, USA                                                 
+// ** BSD licence applies - redistribution and use in source and binary      
+// ** forms, with or without modification, are permitted provided that       
+// ** the following conditions are met:                                      
+// ** 1) If the software is modified to produce derivative works,            
+// ** such modified software should be clearly marked, so as not             
+// ** to confuse it with the version available from UCAR.                    
+// ** 2) Redistributions of source code must retain the above copyright      
+// ** notice, this list of conditions and the following disclaimer.          
+// ** 3) Redistributions in binary form must reproduce the above copyright   
+// ** notice, this list of conditions and the following disclaimer in the    
+// ** documentation and/or other materials provided with the distribution.   
+// ** 4) Neither the name of UCAR nor the names of its contributors,         
+// ** if any, may be used to endorse or promote products derived from        
+// ** this software without specific prior written permission.               
+// ** DISCLAIMER: THIS SOFTWARE IS PROVIDED "AS IS" AND WITHOUT ANY EXPRESS  
+// ** OR IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED      
+// ** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.    
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* 
+/////////////////////////////////////////////////////////////
+// RadarCovarBatch.hh
+//
+// RadarCovarBatch object
+//
+///////////////////////////////////////////////////////////////
+//
+// RadarCovarBatch computes the lag covariances for all gates
+// in a beam in a single pass.
+//
+// The IQ data is held in structure-of-arrays form, with the
+// real and imaginary parts in separate buffers, ordered
+// [sample][gate]. Adjacent gates therefore lie in adjacent
+// memory locations, and the sums are vectorized across gates
+// using AVX2 or AVX-512 if the CPU supports it. The SIMD level
+// is detected at run time, with a scalar fallback.
+//
+// Each gate is summed in the same order as the per-gate
+// methods in RadarMoments, using separate multiply and add
+// operations, so the results match computeCovarSinglePolH(),
+// computeCovarSinglePolV() and computeCovarDpSimHv().
+//
+////////////////////////////////////////////////////////////////
+
+#ifndef RadarCovarBatch_hh
+#define RadarCovarBatch_hh
+
+#include <toolsa/TaArray.hh>
+#include <radar/RadarComplex.hh>
+#include <radar/MomentsFields.hh>
+using namespace std;
+
+class RadarCovarBatch {
+  
+public:
+
+  // SIMD instruction set in use
+
+  typedef enum {
+    SIMD_SCALAR = 0,
+    SIMD_AVX2 = 1,
+    SIMD_AVX512 = 2
+  } simd_level_t;
+
+  // constructor
+  
+  RadarCovarBatch();
+  
+  // destructor
+  
+  ~RadarCovarBatch();
+
+  // set the dimensions - number of gates and samples
+  // buffers are only reallocated if they grow
+
+  void setDims(int nGates, int nSamples);
+
+  int getNGates() const { return _nGates; }
+  int getNSamples() const { return _nSamples; }
+
+  // Set the SIMD level.
+  // The level is limited to that available on this CPU.
+  // Mainly used for testing.
+
+  void setSimdLevel(simd_level_t level);
+  simd_level_t getSimdLevel() const { return _simdLevel; }
+
+  // get the highest SIMD level supported by this CPU
+
+  static simd_level_t getSimdAvailable();
+  
+  // load the IQ data for a gate, converting from
+  // interleaved to split real/imag form
+  // iq must have nSamples elements
+
+  void loadGateHc(int gateNum, const RadarComplex_t *iq);
+  void loadGateVc(int gateNum, const RadarComplex_t *iq);
+
+  // direct access to the split buffers, for loading in place
+  // element (isample, igate) is at [isample * getGateStride() + igate]
+
+  int getGateStride() const { return _gateStride; }
+  double *getReHc() { return _reHc.buf(); }
+  double *getImHc() { return _imHc.buf(); }
+  double *getReVc() { return _reVc.buf(); }
+  double *getImVc() { return _imVc.buf(); }
+
+  // compute the covariances for all gates
+  // same sample lengths as the corresponding RadarMoments methods
+
+  void computeSinglePolH();
+  void computeSinglePolV();
+  void computeDpSimHv();
+
+  // copy the covariances for a gate into the moments fields
+  // sets lag0, lag1, lag2, lag3 and, for DpSimHv, rvvhh0
+  
+  void loadFieldsSinglePolH(int gateNum, MomentsFields &fields) const;
+  void loadFieldsSinglePolV(int gateNum, MomentsFields &fields) const;
+  void loadFieldsDpSimHv(int gateNum, MomentsFields &fields) const;
+
+protected:
+private:
+
+  static const int _nLags = 4; // lags 0 through 3
+  static const int _gateAlign = 8; // gates per AVX-512 register
+
+  int _nGates;
+  int _nSamples;
+  int _gateStride;
+  int _nAlloc;
+  simd_level_t _simdLevel;
+
+  // IQ data, split real/imag, [sample][gate]
+  
+  TaArray<double> _reHc, _imHc;
+  TaArray<double> _reVc, _imVc;
+
+  // results, per gate
+  
+  TaArray<double> _lag0Hc, _lag0Vc;
+  TaArray<double> _lagReHc[_nLags], _lagImHc[_nLags];
+  TaArray<double> _lagReVc[_nLags], _lagImVc[_nLags];
+  TaArray<double> _rvvhh0Re, _rvvhh0Im;
+
+  // lengths used for the means
+
+  int _lag0Len;
+  int _lagLen[_nLags];
+
+  void _loadGate(int gateNum, const RadarComplex_t *iq,
+                 double *re, double *im);
+
+  void _computeChannel(const double *re, const double *im,
+                       double *lag0,
+                       TaArray<double> *lagRe,
+                       TaArray<double> *lagIm);
+
+  void _computeCross(const double *re1, const double *im1,
+                     const double *re2, const double *im2,
+                     int len, double *outRe, double *outIm);
+
+  void _setLens(int lag0Len);
+
+  void _loadFields(int gateNum,
+                   const double *lag0,
+                   const TaArray<double> *lagRe,
+                   const TaArray<double> *lagIm,
+                   double &fLag0,
+                   RadarComplex_t &fLag1,
+                   RadarComplex_t &fLag2,
+                   RadarComplex_t &fLag3) const;
+
+};
+
+#endif
@@ -36,6 +36,7 @@
 
 #include <string>
 #include <vector>
+#include <map>
 #include <fftw3.h>
 #include <pthread.h>
 #include <radar/RadarComplex.hh>
@@ -56,8 +57,9 @@ public:
   void init(int n);
   
   // constructor - initializes for given size
-  // note that fftw initialization is not inherently thread-safe
-  // so we use a mutex for safety
+  // FFTW plans are shared between objects through a process-wide
+  // cache, so only the first object of a given size pays for
+  // planning. The cache is thread-safe.
   
   RadarFft(int n);
   
@@ -73,6 +75,39 @@ public:
 
   void inv(const RadarComplex_t *in, RadarComplex_t *out) const;
 
+  // perform fwd fft on a batch of transforms
+  // in and out hold nTransforms contiguous series, each of length n
+  // uses a single fftw_plan_many_dft plan for the batch
+  
+  void fwdMany(const RadarComplex_t *in, RadarComplex_t *out,
+               int nTransforms) const;
+
+  // perform inverse fft on a batch of transforms
+  
+  void invMany(const RadarComplex_t *in, RadarComplex_t *out,
+               int nTransforms) const;
+
+  // FFTW wisdom.
+  // Importing wisdom saved by a previous run avoids re-planning
+  // at startup. Export after the plans have been created.
+  // Returns 0 on success, -1 on failure.
+
+  static int importWisdom(const string &path);
+  static int exportWisdom(const string &path);
+
+  // free the cached plans which are not in use by any RadarFft object
+  
+  static void clearPlanCache();
+
+  // Set the max number of plans kept in the cache, default 64.
+  // Plans not in use by any object are freed, least recently used
+  // first, to keep within this limit. Plans for the first maxPlans
+  // sizes are created with FFTW_MEASURE. After that, FFTW_ESTIMATE
+  // is used, which plans quickly but may execute more slowly, so that
+  // inputs with many different sizes do not pay for measuring each one.
+
+  static void setMaxCachedPlans(int maxPlans);
+
   // Shift a spectrum, in place, so that DC is in the center.
   // Swaps left and right sides.
   // DC location location starts at index 0.
@@ -135,7 +170,53 @@ private:
   fftw_complex *_out;
   fftw_complex *_tmp;
 
-  static pthread_mutex_t _initMutex;
+  // batch plans and buffers, for fwdMany() and invMany()
+  
+  mutable int _nMany;
+  mutable fftw_plan _fftFwdMany;
+  mutable fftw_plan _fftBckMany;
+  mutable fftw_complex *_inMany;
+  mutable fftw_complex *_outMany;
+
+  // process-wide plan cache
+  // plans are created on demand, and reference counted by the
+  // objects using them, so that unused plans can be freed
+  
+  class PlanKey {
+  public:
+    PlanKey(int n_, int howMany_, int sign_) :
+            n(n_), howMany(howMany_), sign(sign_) {}
+    bool operator<(const PlanKey &rhs) const {
+      if (n != rhs.n) return n < rhs.n;
+      if (howMany != rhs.howMany) return howMany < rhs.howMany;
+      return sign < rhs.sign;
+    }
+    int n;
+    int howMany;
+    int sign;
+  };
+
+  class PlanEntry {
+  public:
+    PlanEntry() : plan(NULL), nUsers(0), lastUse(0) {}
+    fftw_plan plan;
+    int nUsers;
+    unsigned long lastUse;
+  };
+
+  static pthread_mutex_t _planMutex;
+  static map<PlanKey, PlanEntry> _planCache;
+  static size_t _maxCachedPlans;
+  static size_t _nPlansMeasured;
+  static unsigned long _planUseCount;
+
+  static fftw_plan _getPlan(int n, int howMany, int sign);
+  static void _releasePlan(fftw_plan plan);
+  static void _trimPlanCache();
+  void _initMany(int nTransforms) const;
+  void _execMany(fftw_plan plan,
+                 const RadarComplex_t *in, RadarComplex_t *out,
+                 int nTransforms) const;
   
   mutable vector<vector<double> > _cosArray;
   mutable vector<vector<double> > _sinArray;
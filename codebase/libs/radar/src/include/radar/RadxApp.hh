@@ -32,6 +32,7 @@
 
 #include <rapmath/MathParser.hh>
 #include <Radx/RayxData.hh>
+#include <toolsa/TaThreadDoubleQue.hh>
 
 class MathData;
 class VolumeData;
@@ -229,6 +230,12 @@ public:
    */
   static void updateRay(const vector<RayxData> &r, RadxRay &ray);
 
+  /**
+   * Compute method used in threaded updates
+   * @param[in] ti  Pointer to AppInfo
+   */
+  static void compute(void *ti);
+
 protected:
 private:  
 
@@ -237,6 +244,57 @@ private:
 
   void _setupUserUnaryOps(const MathData &sweepData, const MathData &rayData,
 			  const VolumeData &vdata);
+
+  /**
+   * @class AppThreads
+   * @brief Simple class to instantiate TaThreadDoubleQue by implementing
+   * the clone() method.
+   */
+  class AppThreads : public TaThreadDoubleQue
+  {
+  public:
+    /**
+     * Empty constructor
+     */
+    inline AppThreads() : TaThreadDoubleQue() {}
+    /**
+     * Empty destructor
+     */
+    inline virtual ~AppThreads() {}
+    /**
+     * Clone a thread and return pointer to base class
+     * @param[in] index 
+     */
+    TaThread *clone(int index);
+  };
+
+  /**
+   * @class AppInfo
+   * @brief Information passed to the RadxApp threaded compute method
+   */
+  class AppInfo
+  {
+  public:
+    /**
+     * Constructor, args match one to one with members
+     */
+    inline AppInfo(int index, const RadxApp *app,
+		   RadxAppVolume *volume, TaThreadQue *thread) :
+      _app(app), _volume(volume), _index(index), _thread(thread) {}
+
+    /**
+     * Destructor
+     */
+    inline virtual ~AppInfo(void) {}
+
+    const RadxApp *_app;    /**< Pointer to the RadxApp object */
+    RadxAppVolume *_volume; /**< Pointer to the data */
+    int _index;             /**< Index into the volume */
+    TaThreadQue *_thread;   /**< Threading pointer, used for lock/unlock */
+
+  protected:
+  private:
+  };
 };
 
 # endif
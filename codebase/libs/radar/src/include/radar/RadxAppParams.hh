@@ -421,6 +421,8 @@ public:
 
   tdrp_bool_t thread_debug;
 
+  tdrp_bool_t thread_sweep_loop;
+
   input_t *_input;
   int input_n;
 
@@ -473,7 +475,7 @@ private:
 
   void _init();
 
-  mutable TDRPtable _table[38];
+  mutable TDRPtable _table[39];
 
   const char *_className;
 
@@ -37,6 +37,16 @@ public:
 
   #include <rapmath/MathLoopDataVirtualMethods.hh>
 
+  /**
+   * Get a block of values directly from the ray, see MathLoopData
+   */
+  virtual void getVals(int i0, int n, double *v, bool *ok) const;
+
+  /**
+   * Set a block of values directly into the ray, see MathLoopData
+   */
+  virtual void setVals(int i0, int n, const double *v, const bool *ok);
+
 protected:
 private:
 
@@ -45,6 +45,16 @@ public:
 
   #include <rapmath/MathLoopDataVirtualMethods.hh>
 
+  /**
+   * Get a block of values directly from the sweep, see MathLoopData
+   */
+  virtual void getVals(int i0, int n, double *v, bool *ok) const;
+
+  /**
+   * Set a block of values directly into the sweep, see MathLoopData
+   */
+  virtual void setVals(int i0, int n, const double *v, const bool *ok);
+
   /**
    * @return the field name
    */
@@ -245,33 +245,46 @@ int IwrfTsPulse::setFromBuffer(const void *buf, int len,
    return -1;
   }
 
-  // swap packet as required, using a copy to preserve const
-
-  char *copy = new char[len];
-  memcpy(copy, buf, len);
-  iwrf_packet_swap(copy, len);
-
-  if (_debug >= IWRF_DEBUG_EXTRA) {
-    iwrf_packet_print(stderr, copy, len);
-  }
-
   if (packet_id != IWRF_PULSE_HEADER_ID &&
       packet_id != IWRF_RVP8_PULSE_HEADER_ID) {
     cerr << "ERROR - IwrfTsPulse::setFromBuffer" << endl;
     fprintf(stderr, "  Incorrect packet id: 0x%x\n", packet_id);
     cerr << "                  len: " << len << endl;
     cerr << "                 type: " << iwrf_packet_id_to_str(packet_id) << endl;
-    delete[] copy;
     return -1;
   }
 
+  // Swap the header as required, using a copy to preserve const.
+  // Only the header is swapped, so only the header is copied.
+  // The IQ data is read directly from the buffer below, which
+  // avoids an allocation and a full copy of the IQ data per pulse.
+
   if (packet_id == IWRF_RVP8_PULSE_HEADER_ID) {
-    memcpy(&_rvp8_hdr, copy, sizeof(iwrf_rvp8_pulse_header_t));
-    delete[] copy;
+    if (len < (int) sizeof(iwrf_rvp8_pulse_header_t)) {
+      cerr << "ERROR - IwrfTsPulse::setFromBuffer" << endl;
+      cerr << "  RVP8 pulse header too short, len: " << len << endl;
+      return -1;
+    }
+    memcpy(&_rvp8_hdr, buf, sizeof(iwrf_rvp8_pulse_header_t));
+    iwrf_rvp8_pulse_header_swap(_rvp8_hdr);
+    if (_debug >= IWRF_DEBUG_EXTRA) {
+      iwrf_packet_print(stderr, &_rvp8_hdr, sizeof(_rvp8_hdr));
+    }
     return 0;
   }
 
-  memcpy(&_hdr, copy, sizeof(iwrf_pulse_header_t));
+  if (len < (int) sizeof(iwrf_pulse_header_t)) {
+    cerr << "ERROR - IwrfTsPulse::setFromBuffer" << endl;
+    cerr << "  Pulse header too short, len: " << len << endl;
+    return -1;
+  }
+  
+  memcpy(&_hdr, buf, sizeof(iwrf_pulse_header_t));
+  iwrf_pulse_header_swap(_hdr);
+
+  if (_debug >= IWRF_DEBUG_EXTRA) {
+    iwrf_packet_print(stderr, &_hdr, sizeof(_hdr));
+  }
 
   // derive
 
@@ -321,20 +334,19 @@ int IwrfTsPulse::setFromBuffer(const void *buf, int len,
     cerr << "sizeof(iwrf_pulse_header_t): "
          << sizeof(iwrf_pulse_header_t) << endl; 
     iwrf_pulse_header_print(stderr, _hdr);
-    delete[] copy;
     return -1;
   }
   
   if (_hdr.iq_encoding == IWRF_IQ_ENCODING_FL32) {
     
     _clearPacked();
-    fl32 *iq = (fl32 *) (copy + sizeof(iwrf_pulse_header_t));
+    const fl32 *iq = (const fl32 *) ((const char *) buf + sizeof(iwrf_pulse_header_t));
     _iqData = (fl32 *) _iqBuf.load(iq, _hdr.n_data * sizeof(fl32));
 
   } else if (_hdr.iq_encoding == IWRF_IQ_ENCODING_SCALED_SI32) {
     
     _clearPacked();
-    si32 *siq = (si32 *) (copy + sizeof(iwrf_pulse_header_t));
+    const si32 *siq = (const si32 *) ((const char *) buf + sizeof(iwrf_pulse_header_t));
     _iqData = (fl32 *) _iqBuf.prepare(_hdr.n_data * sizeof(fl32));
     fl32 *iq = _iqData;
     double scale = _hdr.scale;
@@ -346,7 +358,7 @@ int IwrfTsPulse::setFromBuffer(const void *buf, int len,
   } else {
 
     _clearIq();
-    si16 *packed = (si16 *) (copy + sizeof(iwrf_pulse_header_t));
+    const si16 *packed = (const si16 *) ((const char *) buf + sizeof(iwrf_pulse_header_t));
     _packed = (si16 *) _packedBuf.load(packed, _hdr.n_data * sizeof(si16));
 
   }
@@ -363,7 +375,6 @@ int IwrfTsPulse::setFromBuffer(const void *buf, int len,
 
   _checkRangeMembers();
 
-  delete[] copy;
   return 0;
 
 }
@@ -1236,24 +1236,15 @@ void DwellSpectra::filterIqUsingCmd()
 
   // invert the filtered spectra into the time series
   
-  RadarComplex_t **iqHcFilt2D = _iqHcFilt2D.dat2D();
-  RadarComplex_t **iqVcFilt2D = _iqVcFilt2D.dat2D();
-
   for (size_t igate = 0; igate < _nGates; igate++) {
-    
-    RadarComplex_t *specHcFilt1D = specHcFilt2D[igate];
-    RadarComplex_t *specVcFilt1D = specVcFilt2D[igate];
-    
-    RadarComplex_t *iqHcFilt1D = iqHcFilt2D[igate];
-    RadarComplex_t *iqVcFilt1D = iqVcFilt2D[igate];
-    
-    _fft.unshift(specHcFilt1D);
-    _fft.unshift(specVcFilt1D);
-
-    _fft.inv(specHcFilt1D, iqHcFilt1D);
-    _fft.inv(specVcFilt1D, iqVcFilt1D);
-    
+    _fft.unshift(specHcFilt2D[igate]);
+    _fft.unshift(specVcFilt2D[igate]);
   } // igate
+
+  // the 2D arrays are contiguous, so invert all gates in one batch
+
+  _fft.invMany(_specCompHcFilt2D.dat1D(), _iqHcFilt2D.dat1D(), _nGates);
+  _fft.invMany(_specCompVcFilt2D.dat1D(), _iqVcFilt2D.dat1D(), _nGates);
   
 }
 
@@ -53,7 +53,8 @@ using namespace std;
 ////////////////////////////////////////////////////
 // Base class
 
-IwrfMomReader::IwrfMomReader()
+IwrfMomReader::IwrfMomReader() :
+        _dsRadarMsg(DsMessage::PointToMem)
   
 {
   _nonBlocking = false;
@@ -66,6 +67,8 @@ IwrfMomReader::IwrfMomReader()
   _useSavedRay = false;
   _rayReady = false;
   _debug = IWRF_DEBUG_OFF;
+  // the beam data is read in place from _msgBuf, see _decodeDsRadarBeam()
+  _dsRadarMsg.setDecodeBeamData(false);
 }
 
 //////////////////////////////////////////////////////////////////
@@ -524,75 +527,22 @@ void IwrfMomReader::_decodeDsRadarBeam()
   }
 
   // load up fields
+  // the data is converted in place in the message, which may
+  // be gate-interleaved or field-planar
 
-  int byteWidth = rbeam.byteWidth;
-  
-  for (size_t iparam = 0; iparam < fparamsVec.size(); iparam++) {
+  if (_dsBeamView.init(_dsRadarMsg)) {
+    cerr << "WARNING - IwrfMomReader::_decodeDsRadarBeam" << endl;
+    cerr << "  Cannot access beam data, ignoring fields" << endl;
+  }
 
-    // is this an output field or censoring field?
+  for (size_t iparam = 0; iparam < fparamsVec.size(); iparam++) {
 
     const DsFieldParams &fparams = *fparamsVec[iparam];
-    string fieldName = fparams.name;
 
     // convert to floats
     
     Radx::fl32 *fdata = new Radx::fl32[nGates];
-
-    if (byteWidth == 4) {
-
-      fl32 *inData = (fl32 *) rbeam.data() + iparam;
-      fl32 inMissing = (fl32) fparams.missingDataValue;
-      Radx::fl32 *outData = fdata;
-      
-      for (int igate = 0; igate < nGates;
-           igate++, inData += fparamsVec.size(), outData++) {
-        fl32 inVal = *inData;
-        if (inVal == inMissing) {
-          *outData = Radx::missingFl32;
-        } else {
-          *outData = *inData;
-        }
-      } // igate
-
-    } else if (byteWidth == 2) {
-
-      ui16 *inData = (ui16 *) rbeam.data() + iparam;
-      ui16 inMissing = (ui16) fparams.missingDataValue;
-      double scale = fparams.scale;
-      double bias = fparams.bias;
-      Radx::fl32 *outData = fdata;
-      
-      for (int igate = 0; igate < nGates;
-           igate++, inData += fparamsVec.size(), outData++) {
-        ui16 inVal = *inData;
-        if (inVal == inMissing) {
-          *outData = Radx::missingFl32;
-        } else {
-          *outData = *inData * scale + bias;
-        }
-      } // igate
-
-    } else {
-
-      // byte width 1
-
-      ui08 *inData = (ui08 *) rbeam.data() + iparam;
-      ui08 inMissing = (ui08) fparams.missingDataValue;
-      double scale = fparams.scale;
-      double bias = fparams.bias;
-      Radx::fl32 *outData = fdata;
-      
-      for (int igate = 0; igate < nGates;
-           igate++, inData += fparamsVec.size(), outData++) {
-        ui08 inVal = *inData;
-        if (inVal == inMissing) {
-          *outData = Radx::missingFl32;
-        } else {
-          *outData = *inData * scale + bias;
-        }
-      } // igate
-
-    } // if (byteWidth == 4)
+    _dsBeamView.getFieldFl32(iparam, fdata, nGates, Radx::missingFl32);
 
     RadxField *field = new RadxField(fparams.name, fparams.units);
     field->copyRangeGeom(*_latestRay);
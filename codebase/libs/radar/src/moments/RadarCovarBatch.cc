@@ -0,0 +1,618 @@
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* 
+// ** Copyright UCAR (c) 1990 - 2016                                         
+// ** University Corporation for Atmospheric Research (UCAR)                 
+// ** National Center for Atmospheric Research (NCAR)                        
+// ** Boulder, Colorado, USA                                                 
+// ** BSD licence applies - redistribution and use in source and binary      
+// ** forms, with or without modification, are permitted provided that       
+// ** the following conditions are met:                                      
+// ** 1) If the software is modified to produce derivative works,            
+// ** such modified software should be clearly marked, so as not             
+// ** to confuse it with the version available from UCAR.                    
+// ** 2) Redistributions of source code must retain the above copyright      
+// ** notice, this list of conditions and the following disclaimer.          
+// ** 3) Redistributions in binary form must reproduce the above copyright   
+// ** notice, this list of conditions and the following disclaimer in the    
+// ** documentation and/or other materials provided with the distribution.   
+// ** 4) Neither the name of UCAR nor the names of its contributors,         
+// ** if any, may be used to endorse or promote products derived from        
+// ** this software without specific prior written permission.               
+// ** DISCLAIMER: THIS SOFTWARE IS PROVIDED "AS IS" AND WITHOUT ANY EXPRESS  
+// ** OR IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED      
+// ** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.    
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* 
+///////////////////////////////////////////////////////////////
+// RadarCovarBatch.cc
+//
+// RadarCovarBatch object
+//
+///////////////////////////////////////////////////////////////
+//
+// RadarCovarBatch computes the lag covariances for all gates
+// in a beam in a single pass, vectorized across gates.
+//
+////////////////////////////////////////////////////////////////
+
+#include <cstring>
+#include <radar/RadarCovarBatch.hh>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define RADAR_COVAR_X86_SIMD
+#include <immintrin.h>
+// gcc would otherwise fuse the multiplies and adds into FMA
+// instructions for AVX-512, changing the rounding
+#if defined(__clang__)
+#define RADAR_COVAR_NO_FMA
+#else
+#define RADAR_COVAR_NO_FMA __attribute__((optimize("fp-contract=off")))
+#endif
+#endif
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////
+// Kernels.
+//
+// Each kernel accumulates the sums for lags 0 through 3 for a
+// single channel, over gates [startGate, endGate).
+// The multiplies and adds are kept separate, and each gate is
+// summed in sample order, so that all kernels give the same
+// results as RadarComplex::meanPower() and
+// RadarComplex::meanConjugateProduct().
+// lagRe[0] and lagIm[0] are not used.
+
+typedef struct {
+  const double *re;
+  const double *im;
+  int stride;
+  int nSamples;
+  int lag0Len;
+  double *sum0;
+  double *sumRe[4];
+  double *sumIm[4];
+} covar_kernel_args_t;
+
+typedef struct {
+  const double *re1;
+  const double *im1;
+  const double *re2;
+  const double *im2;
+  int stride;
+  int len;
+  double *sumRe;
+  double *sumIm;
+} cross_kernel_args_t;
+
+// scalar - loops over samples, then gates
+
+static void _covarKernelScalar(const covar_kernel_args_t &args,
+                               int startGate, int endGate)
+{
+
+  for (int igate = startGate; igate < endGate; igate++) {
+    args.sum0[igate] = 0.0;
+    for (int lag = 1; lag < 4; lag++) {
+      args.sumRe[lag][igate] = 0.0;
+      args.sumIm[lag][igate] = 0.0;
+    }
+  }
+
+  for (int ii = 0; ii < args.nSamples; ii++) {
+    const double *xRe = args.re + ii * args.stride;
+    const double *xIm = args.im + ii * args.stride;
+    if (ii < args.lag0Len) {
+      for (int igate = startGate; igate < endGate; igate++) {
+        args.sum0[igate] +=
+          ((xRe[igate] * xRe[igate]) + (xIm[igate] * xIm[igate]));
+      }
+    }
+    for (int lag = 1; lag < 4; lag++) {
+      if (ii >= args.nSamples - lag) {
+        break;
+      }
+      const double *yRe = xRe + lag * args.stride;
+      const double *yIm = xIm + lag * args.stride;
+      double *sRe = args.sumRe[lag];
+      double *sIm = args.sumIm[lag];
+      for (int igate = startGate; igate < endGate; igate++) {
+        sRe[igate] += ((yRe[igate] * xRe[igate]) + (yIm[igate] * xIm[igate]));
+        sIm[igate] += ((yIm[igate] * xRe[igate]) - (yRe[igate] * xIm[igate]));
+      }
+    }
+  }
+
+}
+
+static void _crossKernelScalar(const cross_kernel_args_t &args,
+                               int startGate, int endGate)
+{
+
+  for (int igate = startGate; igate < endGate; igate++) {
+    args.sumRe[igate] = 0.0;
+    args.sumIm[igate] = 0.0;
+  }
+
+  for (int ii = 0; ii < args.len; ii++) {
+    const double *aRe = args.re1 + ii * args.stride;
+    const double *aIm = args.im1 + ii * args.stride;
+    const double *bRe = args.re2 + ii * args.stride;
+    const double *bIm = args.im2 + ii * args.stride;
+    for (int igate = startGate; igate < endGate; igate++) {
+      args.sumRe[igate] += ((aRe[igate] * bRe[igate]) + (aIm[igate] * bIm[igate]));
+      args.sumIm[igate] += ((aIm[igate] * bRe[igate]) - (aRe[igate] * bIm[igate]));
+    }
+  }
+
+}
+
+#ifdef RADAR_COVAR_X86_SIMD
+
+// AVX2 - 4 gates per register
+
+__attribute__((target("avx2"))) RADAR_COVAR_NO_FMA
+static void _covarKernelAvx2(const covar_kernel_args_t &args,
+                             int startGate, int endGate)
+{
+
+  for (int igate = startGate; igate < endGate; igate += 4) {
+
+    __m256d sum0 = _mm256_setzero_pd();
+    __m256d sumRe[4], sumIm[4];
+    for (int lag = 1; lag < 4; lag++) {
+      sumRe[lag] = _mm256_setzero_pd();
+      sumIm[lag] = _mm256_setzero_pd();
+    }
+    
+    for (int ii = 0; ii < args.nSamples; ii++) {
+      const double *pRe = args.re + ii * args.stride + igate;
+      const double *pIm = args.im + ii * args.stride + igate;
+      __m256d xRe = _mm256_loadu_pd(pRe);
+      __m256d xIm = _mm256_loadu_pd(pIm);
+      if (ii < args.lag0Len) {
+        sum0 = _mm256_add_pd(sum0,
+                             _mm256_add_pd(_mm256_mul_pd(xRe, xRe),
+                                           _mm256_mul_pd(xIm, xIm)));
+      }
+      for (int lag = 1; lag < 4; lag++) {
+        if (ii >= args.nSamples - lag) {
+          break;
+        }
+        __m256d yRe = _mm256_loadu_pd(pRe + lag * args.stride);
+        __m256d yIm = _mm256_loadu_pd(pIm + lag * args.stride);
+        sumRe[lag] = _mm256_add_pd(sumRe[lag],
+                                   _mm256_add_pd(_mm256_mul_pd(yRe, xRe),
+                                                 _mm256_mul_pd(yIm, xIm)));
+        sumIm[lag] = _mm256_add_pd(sumIm[lag],
+                                   _mm256_sub_pd(_mm256_mul_pd(yIm, xRe),
+                                                 _mm256_mul_pd(yRe, xIm)));
+      }
+    }
+
+    _mm256_storeu_pd(args.sum0 + igate, sum0);
+    for (int lag = 1; lag < 4; lag++) {
+      _mm256_storeu_pd(args.sumRe[lag] + igate, sumRe[lag]);
+      _mm256_storeu_pd(args.sumIm[lag] + igate, sumIm[lag]);
+    }
+
+  } // igate
+
+}
+
+__attribute__((target("avx2"))) RADAR_COVAR_NO_FMA
+static void _crossKernelAvx2(const cross_kernel_args_t &args,
+                             int startGate, int endGate)
+{
+
+  for (int igate = startGate; igate < endGate; igate += 4) {
+    __m256d sumRe = _mm256_setzero_pd();
+    __m256d sumIm = _mm256_setzero_pd();
+    for (int ii = 0; ii < args.len; ii++) {
+      int offset = ii * args.stride + igate;
+      __m256d aRe = _mm256_loadu_pd(args.re1 + offset);
+      __m256d aIm = _mm256_loadu_pd(args.im1 + offset);
+      __m256d bRe = _mm256_loadu_pd(args.re2 + offset);
+      __m256d bIm = _mm256_loadu_pd(args.im2 + offset);
+      sumRe = _mm256_add_pd(sumRe,
+                            _mm256_add_pd(_mm256_mul_pd(aRe, bRe),
+                                          _mm256_mul_pd(aIm, bIm)));
+      sumIm = _mm256_add_pd(sumIm,
+                            _mm256_sub_pd(_mm256_mul_pd(aIm, bRe),
+                                          _mm256_mul_pd(aRe, bIm)));
+    }
+    _mm256_storeu_pd(args.sumRe + igate, sumRe);
+    _mm256_storeu_pd(args.sumIm + igate, sumIm);
+  }
+
+}
+
+// AVX-512 - 8 gates per register
+
+__attribute__((target("avx512f"))) RADAR_COVAR_NO_FMA
+static void _covarKernelAvx512(const covar_kernel_args_t &args,
+                               int startGate, int endGate)
+{
+
+  for (int igate = startGate; igate < endGate; igate += 8) {
+
+    __m512d sum0 = _mm512_setzero_pd();
+    __m512d sumRe[4], sumIm[4];
+    for (int lag = 1; lag < 4; lag++) {
+      sumRe[lag] = _mm512_setzero_pd();
+      sumIm[lag] = _mm512_setzero_pd();
+    }
+    
+    for (int ii = 0; ii < args.nSamples; ii++) {
+      const double *pRe = args.re + ii * args.stride + igate;
+      const double *pIm = args.im + ii * args.stride + igate;
+      __m512d xRe = _mm512_loadu_pd(pRe);
+      __m512d xIm = _mm512_loadu_pd(pIm);
+      if (ii < args.lag0Len) {
+        sum0 = _mm512_add_pd(sum0,
+                             _mm512_add_pd(_mm512_mul_pd(xRe, xRe),
+                                           _mm512_mul_pd(xIm, xIm)));
+      }
+      for (int lag = 1; lag < 4; lag++) {
+        if (ii >= args.nSamples - lag) {
+          break;
+        }
+        __m512d yRe = _mm512_loadu_pd(pRe + lag * args.stride);
+        __m512d yIm = _mm512_loadu_pd(pIm + lag * args.stride);
+        sumRe[lag] = _mm512_add_pd(sumRe[lag],
+                                   _mm512_add_pd(_mm512_mul_pd(yRe, xRe),
+                                                 _mm512_mul_pd(yIm, xIm)));
+        sumIm[lag] = _mm512_add_pd(sumIm[lag],
+                                   _mm512_sub_pd(_mm512_mul_pd(yIm, xRe),
+                                                 _mm512_mul_pd(yRe, xIm)));
+      }
+    }
+
+    _mm512_storeu_pd(args.sum0 + igate, sum0);
+    for (int lag = 1; lag < 4; lag++) {
+      _mm512_storeu_pd(args.sumRe[lag] + igate, sumRe[lag]);
+      _mm512_storeu_pd(args.sumIm[lag] + igate, sumIm[lag]);
+    }
+
+  } // igate
+
+}
+
+__attribute__((target("avx512f"))) RADAR_COVAR_NO_FMA
+static void _crossKernelAvx512(const cross_kernel_args_t &args,
+                               int startGate, int endGate)
+{
+
+  for (int igate = startGate; igate < endGate; igate += 8) {
+    __m512d sumRe = _mm512_setzero_pd();
+    __m512d sumIm = _mm512_setzero_pd();
+    for (int ii = 0; ii < args.len; ii++) {
+      int offset = ii * args.stride + igate;
+      __m512d aRe = _mm512_loadu_pd(args.re1 + offset);
+      __m512d aIm = _mm512_loadu_pd(args.im1 + offset);
+      __m512d bRe = _mm512_loadu_pd(args.re2 + offset);
+      __m512d bIm = _mm512_loadu_pd(args.im2 + offset);
+      sumRe = _mm512_add_pd(sumRe,
+                            _mm512_add_pd(_mm512_mul_pd(aRe, bRe),
+                                          _mm512_mul_pd(aIm, bIm)));
+      sumIm = _mm512_add_pd(sumIm,
+                            _mm512_sub_pd(_mm512_mul_pd(aIm, bRe),
+                                          _mm512_mul_pd(aRe, bIm)));
+    }
+    _mm512_storeu_pd(args.sumRe + igate, sumRe);
+    _mm512_storeu_pd(args.sumIm + igate, sumIm);
+  }
+
+}
+
+#endif
+
+////////////////////////////////////////////////////
+// Constructor
+
+RadarCovarBatch::RadarCovarBatch() :
+        _nGates(0),
+        _nSamples(0),
+        _gateStride(0),
+        _nAlloc(0),
+        _lag0Len(0)
+        
+{
+  _simdLevel = getSimdAvailable();
+  for (int lag = 0; lag < _nLags; lag++) {
+    _lagLen[lag] = 0;
+  }
+}
+
+////////////////////////////////////////////////////
+// Destructor
+
+RadarCovarBatch::~RadarCovarBatch()
+{
+}
+
+////////////////////////////////////////////////////
+// set the dimensions
+// buffers are only reallocated if they grow
+
+void RadarCovarBatch::setDims(int nGates, int nSamples)
+  
+{
+
+  _nGates = nGates;
+  _nSamples = nSamples;
+
+  // pad the gate stride to a full AVX-512 register,
+  // so that the kernels never need a remainder loop
+
+  _gateStride = ((nGates + _gateAlign - 1) / _gateAlign) * _gateAlign;
+
+  int nNeeded = _gateStride * nSamples;
+  if (nNeeded > _nAlloc) {
+    _reHc.alloc(nNeeded);
+    _imHc.alloc(nNeeded);
+    _reVc.alloc(nNeeded);
+    _imVc.alloc(nNeeded);
+    _nAlloc = nNeeded;
+  }
+
+  // zero out so that padding gates hold valid numbers
+
+  memset(_reHc.buf(), 0, nNeeded * sizeof(double));
+  memset(_imHc.buf(), 0, nNeeded * sizeof(double));
+  memset(_reVc.buf(), 0, nNeeded * sizeof(double));
+  memset(_imVc.buf(), 0, nNeeded * sizeof(double));
+
+  // results
+
+  _lag0Hc.alloc(_gateStride);
+  _lag0Vc.alloc(_gateStride);
+  for (int lag = 0; lag < _nLags; lag++) {
+    _lagReHc[lag].alloc(_gateStride);
+    _lagImHc[lag].alloc(_gateStride);
+    _lagReVc[lag].alloc(_gateStride);
+    _lagImVc[lag].alloc(_gateStride);
+  }
+  _rvvhh0Re.alloc(_gateStride);
+  _rvvhh0Im.alloc(_gateStride);
+
+}
+
+////////////////////////////////////////////////////
+// Set the SIMD level.
+// Limited to the level available on this CPU.
+
+void RadarCovarBatch::setSimdLevel(simd_level_t level)
+{
+  simd_level_t available = getSimdAvailable();
+  if (level > available) {
+    _simdLevel = available;
+  } else {
+    _simdLevel = level;
+  }
+}
+
+////////////////////////////////////////////////////
+// get the highest SIMD level supported by this CPU
+
+RadarCovarBatch::simd_level_t RadarCovarBatch::getSimdAvailable()
+{
+#ifdef RADAR_COVAR_X86_SIMD
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) {
+    return SIMD_AVX512;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    return SIMD_AVX2;
+  }
+#endif
+  return SIMD_SCALAR;
+}
+
+////////////////////////////////////////////////////
+// load the IQ data for a gate
+
+void RadarCovarBatch::loadGateHc(int gateNum, const RadarComplex_t *iq)
+{
+  _loadGate(gateNum, iq, _reHc.buf(), _imHc.buf());
+}
+
+void RadarCovarBatch::loadGateVc(int gateNum, const RadarComplex_t *iq)
+{
+  _loadGate(gateNum, iq, _reVc.buf(), _imVc.buf());
+}
+
+void RadarCovarBatch::_loadGate(int gateNum, const RadarComplex_t *iq,
+                                double *re, double *im)
+{
+  if (gateNum < 0 || gateNum >= _nGates) {
+    return;
+  }
+  for (int ii = 0; ii < _nSamples; ii++) {
+    int offset = ii * _gateStride + gateNum;
+    re[offset] = iq[ii].re;
+    im[offset] = iq[ii].im;
+  }
+}
+
+////////////////////////////////////////////////////
+// compute covariances for all gates
+// Single polarization, horizontal channel
+
+void RadarCovarBatch::computeSinglePolH()
+{
+  _setLens(_nSamples);
+  _computeChannel(_reHc.buf(), _imHc.buf(),
+                  _lag0Hc.buf(), _lagReHc, _lagImHc);
+}
+
+////////////////////////////////////////////////////
+// compute covariances for all gates
+// Single polarization, vertical channel
+
+void RadarCovarBatch::computeSinglePolV()
+{
+  _setLens(_nSamples);
+  _computeChannel(_reVc.buf(), _imVc.buf(),
+                  _lag0Vc.buf(), _lagReVc, _lagImVc);
+}
+
+////////////////////////////////////////////////////
+// compute covariances for all gates
+// Dual pol, transmit simultaneous, receive fixed channels 
+
+void RadarCovarBatch::computeDpSimHv()
+{
+  _setLens(_nSamples - 1);
+  _computeChannel(_reHc.buf(), _imHc.buf(),
+                  _lag0Hc.buf(), _lagReHc, _lagImHc);
+  _computeChannel(_reVc.buf(), _imVc.buf(),
+                  _lag0Vc.buf(), _lagReVc, _lagImVc);
+  _computeCross(_reVc.buf(), _imVc.buf(),
+                _reHc.buf(), _imHc.buf(), _nSamples - 1,
+                _rvvhh0Re.buf(), _rvvhh0Im.buf());
+}
+
+////////////////////////////////////////////////////
+// set the lengths over which the means are computed
+
+void RadarCovarBatch::_setLens(int lag0Len)
+{
+  _lag0Len = lag0Len;
+  _lagLen[0] = lag0Len;
+  for (int lag = 1; lag < _nLags; lag++) {
+    _lagLen[lag] = _nSamples - lag;
+  }
+}
+
+////////////////////////////////////////////////////
+// compute lags 0 through 3 for one channel
+
+void RadarCovarBatch::_computeChannel(const double *re, const double *im,
+                                      double *lag0,
+                                      TaArray<double> *lagRe,
+                                      TaArray<double> *lagIm)
+{
+  
+  covar_kernel_args_t args;
+  args.re = re;
+  args.im = im;
+  args.stride = _gateStride;
+  args.nSamples = _nSamples;
+  args.lag0Len = _lag0Len;
+  args.sum0 = lag0;
+  for (int lag = 0; lag < _nLags; lag++) {
+    args.sumRe[lag] = lagRe[lag].buf();
+    args.sumIm[lag] = lagIm[lag].buf();
+  }
+
+  switch (_simdLevel) {
+#ifdef RADAR_COVAR_X86_SIMD
+    case SIMD_AVX512:
+      _covarKernelAvx512(args, 0, _gateStride);
+      break;
+    case SIMD_AVX2:
+      _covarKernelAvx2(args, 0, _gateStride);
+      break;
+#endif
+    default:
+      _covarKernelScalar(args, 0, _gateStride);
+  }
+
+  // convert sums to means, same as RadarComplex
+
+  for (int igate = 0; igate < _nGates; igate++) {
+    if (_lag0Len < 1) {
+      lag0[igate] = 0.0;
+    } else {
+      lag0[igate] /= _lag0Len;
+    }
+  }
+  for (int lag = 1; lag < _nLags; lag++) {
+    double *sRe = lagRe[lag].buf();
+    double *sIm = lagIm[lag].buf();
+    for (int igate = 0; igate < _nGates; igate++) {
+      sRe[igate] /= _lagLen[lag];
+      sIm[igate] /= _lagLen[lag];
+    }
+  }
+
+}
+
+////////////////////////////////////////////////////
+// compute lag-0 cross covariance between channels
+
+void RadarCovarBatch::_computeCross(const double *re1, const double *im1,
+                                    const double *re2, const double *im2,
+                                    int len, double *outRe, double *outIm)
+{
+  
+  cross_kernel_args_t args;
+  args.re1 = re1;
+  args.im1 = im1;
+  args.re2 = re2;
+  args.im2 = im2;
+  args.stride = _gateStride;
+  args.len = len;
+  args.sumRe = outRe;
+  args.sumIm = outIm;
+
+  switch (_simdLevel) {
+#ifdef RADAR_COVAR_X86_SIMD
+    case SIMD_AVX512:
+      _crossKernelAvx512(args, 0, _gateStride);
+      break;
+    case SIMD_AVX2:
+      _crossKernelAvx2(args, 0, _gateStride);
+      break;
+#endif
+    default:
+      _crossKernelScalar(args, 0, _gateStride);
+  }
+
+  for (int igate = 0; igate < _nGates; igate++) {
+    outRe[igate] /= len;
+    outIm[igate] /= len;
+  }
+
+}
+
+////////////////////////////////////////////////////
+// copy the covariances for a gate into the moments fields
+
+void RadarCovarBatch::loadFieldsSinglePolH(int gateNum,
+                                           MomentsFields &fields) const
+{
+  _loadFields(gateNum, _lag0Hc.buf(), _lagReHc, _lagImHc,
+              fields.lag0_hc, fields.lag1_hc, fields.lag2_hc, fields.lag3_hc);
+}
+
+void RadarCovarBatch::loadFieldsSinglePolV(int gateNum,
+                                           MomentsFields &fields) const
+{
+  _loadFields(gateNum, _lag0Vc.buf(), _lagReVc, _lagImVc,
+              fields.lag0_vc, fields.lag1_vc, fields.lag2_vc, fields.lag3_vc);
+}
+
+void RadarCovarBatch::loadFieldsDpSimHv(int gateNum,
+                                        MomentsFields &fields) const
+{
+  loadFieldsSinglePolH(gateNum, fields);
+  loadFieldsSinglePolV(gateNum, fields);
+  fields.rvvhh0.re = _rvvhh0Re.buf()[gateNum];
+  fields.rvvhh0.im = _rvvhh0Im.buf()[gateNum];
+}
+
+void RadarCovarBatch::_loadFields(int gateNum,
+                                  const double *lag0,
+                                  const TaArray<double> *lagRe,
+                                  const TaArray<double> *lagIm,
+                                  double &fLag0,
+                                  RadarComplex_t &fLag1,
+                                  RadarComplex_t &fLag2,
+                                  RadarComplex_t &fLag3) const
+{
+  fLag0 = lag0[gateNum];
+  fLag1.set(lagRe[1].buf()[gateNum], lagIm[1].buf()[gateNum]);
+  fLag2.set(lagRe[2].buf()[gateNum], lagIm[2].buf()[gateNum]);
+  fLag3.set(lagRe[3].buf()[gateNum], lagIm[3].buf()[gateNum]);
+}
+
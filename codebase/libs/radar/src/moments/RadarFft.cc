@@ -41,7 +41,11 @@
 #include <cstring>
 using namespace std;
 
-pthread_mutex_t RadarFft::_initMutex = PTHREAD_MUTEX_INITIALIZER;
+pthread_mutex_t RadarFft::_planMutex = PTHREAD_MUTEX_INITIALIZER;
+map<RadarFft::PlanKey, RadarFft::PlanEntry> RadarFft::_planCache;
+size_t RadarFft::_maxCachedPlans = 64;
+size_t RadarFft::_nPlansMeasured = 0;
+unsigned long RadarFft::_planUseCount = 0;
 
 // Constructors
 
@@ -55,6 +59,10 @@ RadarFft::RadarFft()
   _out = NULL;
   _tmp = NULL;
 
+  _nMany = 0;
+  _inMany = NULL;
+  _outMany = NULL;
+
 }
 
 void RadarFft::init(int n)
@@ -71,51 +79,38 @@ void RadarFft::init(int n)
 
   _sqrtN = sqrt((double) n);
   
-  // set up Fft plans
-  // protect with mutext because fftw initialization is not thread-safe
+  // get plans from the cache
+  // these are shared with other objects of the same size
   
-  pthread_mutex_lock(&_initMutex);
+  _fftFwd = _getPlan(n, 1, FFTW_FORWARD);
+  _fftBck = _getPlan(n, 1, FFTW_BACKWARD);
 
-  if (_n > 0) {
-    if (_in) fftw_free(_in);
-    if (_out) fftw_free(_out);
-  }
+  // local aligned buffers, so that the shared plans can be
+  // executed concurrently on different objects
   
   _in = (fftw_complex *) fftw_malloc(sizeof(fftw_complex) * n);
   _out = (fftw_complex *) fftw_malloc(sizeof(fftw_complex) * n);
   _tmp = (fftw_complex *) fftw_malloc(sizeof(fftw_complex) * n);
 
-  _fftFwd = fftw_plan_dft_1d(n, _in, _out, FFTW_FORWARD, FFTW_MEASURE);
-  _fftBck = fftw_plan_dft_1d(n, _in, _out, FFTW_BACKWARD, FFTW_MEASURE);
-
   _n = n;
 
-  pthread_mutex_unlock(&_initMutex);
-
 }
 
-RadarFft::RadarFft(int n) :
-        _n(n)
+RadarFft::RadarFft(int n)
   
 {
 
-  assert(_n != 0);
-  
-  _sqrtN = sqrt((double) _n);
-  
-  // set up Fft plans
-  // protect with mutext because fftw initialization is not thread-safe
-
-  pthread_mutex_lock(&_initMutex);
-
-  _in = (fftw_complex *) fftw_malloc(sizeof(fftw_complex) * _n);
-  _out = (fftw_complex *) fftw_malloc(sizeof(fftw_complex) * _n);
-  _tmp = (fftw_complex *) fftw_malloc(sizeof(fftw_complex) * _n);
+  _n = 0;
+  _sqrtN = 0;
+  _in = NULL;
+  _out = NULL;
+  _tmp = NULL;
 
-  _fftFwd = fftw_plan_dft_1d(_n, _in, _out, FFTW_FORWARD, FFTW_MEASURE);
-  _fftBck = fftw_plan_dft_1d(_n, _in, _out, FFTW_BACKWARD, FFTW_MEASURE);
+  _nMany = 0;
+  _inMany = NULL;
+  _outMany = NULL;
 
-  pthread_mutex_unlock(&_initMutex);
+  init(n);
 
 }
 
@@ -131,22 +126,36 @@ RadarFft::~RadarFft()
 
 ///////////////////////////////////////////////////
 // free up
+// the plans belong to the cache, so are released rather than destroyed
 
 void RadarFft::_free()
   
 {
 
+  if (_nMany > 0) {
+    _releasePlan(_fftFwdMany);
+    _releasePlan(_fftBckMany);
+  }
+
+  if (_inMany) {
+    fftw_free(_inMany);
+    _inMany = NULL;
+  }
+  
+  if (_outMany) {
+    fftw_free(_outMany);
+    _outMany = NULL;
+  }
+
+  _nMany = 0;
+
   if (_n == 0) {
     return;
   }
 
-  // protect with mutext because fftw free is not thread-safe
-
-  pthread_mutex_lock(&_initMutex);
+  _releasePlan(_fftFwd);
+  _releasePlan(_fftBck);
 
-  fftw_destroy_plan(_fftFwd);
-  fftw_destroy_plan(_fftBck);
-  
   if (_in) {
     fftw_free(_in);
     _in = NULL;
@@ -164,11 +173,8 @@ void RadarFft::_free()
 
   _n = 0;
 
-  pthread_mutex_unlock(&_initMutex);
-
 }
 
-
 ///////////////////////////////////////////////
 // compute forward
 
@@ -179,7 +185,7 @@ void RadarFft::fwd(const RadarComplex_t *in, RadarComplex_t *out) const
   assert(_n != 0);
   
   memcpy(_in, in, _n * sizeof(RadarComplex_t));
-  fftw_execute(_fftFwd);
+  fftw_execute_dft(_fftFwd, _in, _out);
 
   // adjust by sqrt(n)
 
@@ -203,7 +209,7 @@ void RadarFft::inv(const RadarComplex_t *in, RadarComplex_t *out) const
   assert(_n != 0);
   
   memcpy(_in, in, _n * sizeof(RadarComplex_t));
-  fftw_execute(_fftBck);
+  fftw_execute_dft(_fftBck, _in, _out);
 
   // adjust by sqrt(n)
 
@@ -217,6 +223,278 @@ void RadarFft::inv(const RadarComplex_t *in, RadarComplex_t *out) const
 
 }
 
+///////////////////////////////////////////////
+// compute forward on a batch of transforms
+
+void RadarFft::fwdMany(const RadarComplex_t *in, RadarComplex_t *out,
+                       int nTransforms) const
+  
+{
+  _initMany(nTransforms);
+  _execMany(_fftFwdMany, in, out, nTransforms);
+}
+
+///////////////////////////////////////////////
+// compute inverse on a batch of transforms
+
+void RadarFft::invMany(const RadarComplex_t *in, RadarComplex_t *out,
+                       int nTransforms) const
+  
+{
+  _initMany(nTransforms);
+  _execMany(_fftBckMany, in, out, nTransforms);
+}
+
+///////////////////////////////////////////////
+// initialize for batch transforms
+// buffers and plans are only changed if the batch size changes
+
+void RadarFft::_initMany(int nTransforms) const
+  
+{
+
+  assert(_n != 0);
+  assert(nTransforms > 0);
+
+  if (_nMany == nTransforms) {
+    return;
+  }
+
+  if (_nMany > 0) {
+    _releasePlan(_fftFwdMany);
+    _releasePlan(_fftBckMany);
+  }
+
+  if (_inMany) {
+    fftw_free(_inMany);
+  }
+  if (_outMany) {
+    fftw_free(_outMany);
+  }
+
+  size_t nTotal = (size_t) _n * nTransforms;
+  _inMany = (fftw_complex *) fftw_malloc(sizeof(fftw_complex) * nTotal);
+  _outMany = (fftw_complex *) fftw_malloc(sizeof(fftw_complex) * nTotal);
+
+  _fftFwdMany = _getPlan(_n, nTransforms, FFTW_FORWARD);
+  _fftBckMany = _getPlan(_n, nTransforms, FFTW_BACKWARD);
+
+  _nMany = nTransforms;
+
+}
+
+///////////////////////////////////////////////
+// execute a batch plan
+
+void RadarFft::_execMany(fftw_plan plan,
+                         const RadarComplex_t *in, RadarComplex_t *out,
+                         int nTransforms) const
+  
+{
+
+  size_t nTotal = (size_t) _n * nTransforms;
+  memcpy(_inMany, in, nTotal * sizeof(RadarComplex_t));
+  fftw_execute_dft(plan, _inMany, _outMany);
+
+  // adjust by sqrt(n)
+
+  double *oo = (double *) _outMany;
+  for (size_t ii = 0; ii < nTotal; ii++, out++) {
+    out->re = *oo / _sqrtN;
+    oo++;
+    out->im = *oo / _sqrtN;
+    oo++;
+  }
+
+}
+
+///////////////////////////////////////////////
+// get a plan from the cache, creating it if needed.
+// The FFTW planner is not thread-safe, so plan creation is
+// protected by the mutex. Execution of a plan with the new-array
+// interface is thread-safe, so no lock is needed after this.
+// The plan must be returned with _releasePlan() when no longer used.
+
+fftw_plan RadarFft::_getPlan(int n, int howMany, int sign)
+  
+{
+
+  PlanKey key(n, howMany, sign);
+
+  pthread_mutex_lock(&_planMutex);
+  
+  _planUseCount++;
+  map<PlanKey, PlanEntry>::iterator it = _planCache.find(key);
+  if (it != _planCache.end()) {
+    PlanEntry &entry = it->second;
+    entry.nUsers++;
+    entry.lastUse = _planUseCount;
+    pthread_mutex_unlock(&_planMutex);
+    return entry.plan;
+  }
+
+  // make room for the new plan
+
+  _trimPlanCache();
+
+  // measure the first sizes only, after that estimate, so that
+  // a stream of new sizes does not pay the measure cost each time
+
+  unsigned int flags = FFTW_ESTIMATE;
+  if (_nPlansMeasured < _maxCachedPlans) {
+    flags = FFTW_MEASURE;
+    _nPlansMeasured++;
+  }
+
+  // create plan on scratch buffers, since FFTW_MEASURE
+  // overwrites the arrays
+  
+  size_t nTotal = (size_t) n * howMany;
+  fftw_complex *in = (fftw_complex *) fftw_malloc(sizeof(fftw_complex) * nTotal);
+  fftw_complex *out = (fftw_complex *) fftw_malloc(sizeof(fftw_complex) * nTotal);
+
+  fftw_plan plan;
+  if (howMany == 1) {
+    plan = fftw_plan_dft_1d(n, in, out, sign, flags);
+  } else {
+    plan = fftw_plan_many_dft(1, &n, howMany,
+                              in, NULL, 1, n,
+                              out, NULL, 1, n,
+                              sign, flags);
+  }
+
+  fftw_free(in);
+  fftw_free(out);
+
+  PlanEntry &entry = _planCache[key];
+  entry.plan = plan;
+  entry.nUsers = 1;
+  entry.lastUse = _planUseCount;
+  
+  pthread_mutex_unlock(&_planMutex);
+
+  return plan;
+
+}
+
+///////////////////////////////////////////////
+// release a plan obtained from _getPlan()
+// the plan stays in the cache, for reuse, until trimmed
+
+void RadarFft::_releasePlan(fftw_plan plan)
+  
+{
+
+  pthread_mutex_lock(&_planMutex);
+  for (map<PlanKey, PlanEntry>::iterator it = _planCache.begin();
+       it != _planCache.end(); it++) {
+    if (it->second.plan == plan) {
+      if (it->second.nUsers > 0) {
+        it->second.nUsers--;
+      }
+      break;
+    }
+  }
+  pthread_mutex_unlock(&_planMutex);
+
+}
+
+///////////////////////////////////////////////
+// free unused plans, least recently used first, until there is
+// room for one more plan in the cache.
+// Plans in use are kept, so the cache may exceed the limit
+// if more than that number of plans are in use.
+// Must be called with the mutex locked.
+
+void RadarFft::_trimPlanCache()
+  
+{
+
+  while (_planCache.size() >= _maxCachedPlans) {
+    map<PlanKey, PlanEntry>::iterator oldest = _planCache.end();
+    for (map<PlanKey, PlanEntry>::iterator it = _planCache.begin();
+         it != _planCache.end(); it++) {
+      if (it->second.nUsers == 0 &&
+          (oldest == _planCache.end() ||
+           it->second.lastUse < oldest->second.lastUse)) {
+        oldest = it;
+      }
+    }
+    if (oldest == _planCache.end()) {
+      // all plans in use
+      return;
+    }
+    fftw_destroy_plan(oldest->second.plan);
+    _planCache.erase(oldest);
+  }
+
+}
+
+///////////////////////////////////////////////
+// import FFTW wisdom from file
+// Returns 0 on success, -1 on failure.
+
+int RadarFft::importWisdom(const string &path)
+  
+{
+  pthread_mutex_lock(&_planMutex);
+  int success = fftw_import_wisdom_from_filename(path.c_str());
+  pthread_mutex_unlock(&_planMutex);
+  if (!success) {
+    return -1;
+  }
+  return 0;
+}
+
+///////////////////////////////////////////////
+// export FFTW wisdom to file
+// Returns 0 on success, -1 on failure.
+
+int RadarFft::exportWisdom(const string &path)
+  
+{
+  pthread_mutex_lock(&_planMutex);
+  int success = fftw_export_wisdom_to_filename(path.c_str());
+  pthread_mutex_unlock(&_planMutex);
+  if (!success) {
+    return -1;
+  }
+  return 0;
+}
+
+///////////////////////////////////////////////
+// free the cached plans which are not in use
+
+void RadarFft::clearPlanCache()
+  
+{
+  pthread_mutex_lock(&_planMutex);
+  map<PlanKey, PlanEntry>::iterator it = _planCache.begin();
+  while (it != _planCache.end()) {
+    if (it->second.nUsers == 0) {
+      fftw_destroy_plan(it->second.plan);
+      _planCache.erase(it++);
+    } else {
+      it++;
+    }
+  }
+  pthread_mutex_unlock(&_planMutex);
+}
+
+///////////////////////////////////////////////
+// set the max number of plans kept in the cache
+
+void RadarFft::setMaxCachedPlans(int maxPlans)
+  
+{
+  if (maxPlans < 1) {
+    maxPlans = 1;
+  }
+  pthread_mutex_lock(&_planMutex);
+  _maxCachedPlans = maxPlans;
+  pthread_mutex_unlock(&_planMutex);
+}
+
 /////////////////////////////////////////////////////////////////
 // Shift a spectrum, in place, so that DC is in the center.
 // Swaps left and right sides.
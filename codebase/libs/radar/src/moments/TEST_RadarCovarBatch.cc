@@ -0,0 +1,213 @@
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* 
+// ** Copyright UCAR (c) 1990 - 2016                                         
+// ** University Corporation for Atmospheric Research (UCAR)                 
+// ** National Center for Atmospheric Research (NCAR)                        
+// ** Boulder, Colorado, USA                                                 
+// ** BSD licence applies - redistribution and use in source and binary      
+// ** forms, with or without modification, are permitted provided that       
+// ** the following conditions are met:                                      
+// ** 1) If the software is modified to produce derivative works,            
+// ** such modified software should be clearly marked, so as not             
+// ** to confuse it with the version available from UCAR.                    
+// ** 2) Redistributions of source code must retain the above copyright      
+// ** notice, this list of conditions and the following disclaimer.          
+// ** 3) Redistributions in binary form must reproduce the above copyright   
+// ** notice, this list of conditions and the following disclaimer in the    
+// ** documentation and/or other materials provided with the distribution.   
+// ** 4) Neither the name of UCAR nor the names of its contributors,         
+// ** if any, may be used to endorse or promote products derived from        
+// ** this software without specific prior written permission.               
+// ** DISCLAIMER: THIS SOFTWARE IS PROVIDED "AS IS" AND WITHOUT ANY EXPRESS  
+// ** OR IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED      
+// ** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.    
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* 
+/*
+ * Name: TEST_RadarCovarBatch.cc
+ *
+ * Purpose:
+ *
+ *      To test the batched covariance computations in RadarCovarBatch
+ *      against the per-gate computations in RadarMoments, for each
+ *      SIMD level available on this host.
+ *
+ * Usage:
+ *
+ *       % RadarCovarBatch-test
+ *
+ * Inputs: 
+ *
+ *       None
+ *
+ * Returns 0 on success, 1 on failure.
+ * Prints nothing on success.
+ *
+ */
+
+/*
+ * include files
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <radar/RadarMoments.hh>
+#include <radar/RadarCovarBatch.hh>
+using namespace std;
+
+// tolerance, relative to the lag-0 power
+// the batch sums are computed in the same order as the
+// per-gate sums, so in practice they match exactly
+
+static const double tolerance = 1.0e-12;
+
+static int nFail = 0;
+
+static void _check(const char *label, int simd, int gate,
+                   double expected, double actual, double scale)
+{
+  if (fabs(expected - actual) > tolerance * scale) {
+    fprintf(stderr, "FAIL - %s, simd %d, gate %d, "
+            "expected %.17g, got %.17g\n",
+            label, simd, gate, expected, actual);
+    nFail++;
+  }
+}
+
+static void _check(const char *label, int simd, int gate,
+                   const RadarComplex_t &expected,
+                   const RadarComplex_t &actual, double scale)
+{
+  _check(label, simd, gate, expected.re, actual.re, scale);
+  _check(label, simd, gate, expected.im, actual.im, scale);
+}
+
+static void _loadIq(int nGates, int nSamples,
+                    vector< vector<RadarComplex_t> > &iq)
+{
+  iq.resize(nGates);
+  for (int igate = 0; igate < nGates; igate++) {
+    iq[igate].resize(nSamples);
+    double phase = (igate % 17) * 0.13;
+    double amp = 1.0e-3 * (1 + igate % 11);
+    for (int ii = 0; ii < nSamples; ii++) {
+      double noise = (double) rand() / RAND_MAX - 0.5;
+      iq[igate][ii].re = amp * (cos(phase * ii) + 0.1 * noise);
+      iq[igate][ii].im = amp * (sin(phase * ii) - 0.1 * noise);
+    }
+  }
+}
+
+/* ======================================================================== */
+
+/*
+ * main program
+ */
+
+int main(int argc, char *argv[])
+{
+
+  srand(1234);
+
+  // odd gate count to exercise the padding
+
+  int nGates = 997;
+  int nSamplesList[] = {4, 31, 64};
+
+  for (size_t ilen = 0; ilen < sizeof(nSamplesList) / sizeof(int); ilen++) {
+
+    int nSamples = nSamplesList[ilen];
+    
+    vector< vector<RadarComplex_t> > iqhc, iqvc;
+    _loadIq(nGates, nSamples, iqhc);
+    _loadIq(nGates, nSamples, iqvc);
+
+    // per-gate results
+    
+    RadarMoments moments(nGates);
+    moments.setNSamples(nSamples);
+    vector<MomentsFields> singleH(nGates), singleV(nGates), simHv(nGates);
+    for (int igate = 0; igate < nGates; igate++) {
+      moments.computeCovarSinglePolH(iqhc[igate].data(), singleH[igate]);
+      moments.computeCovarSinglePolV(iqvc[igate].data(), singleV[igate]);
+      moments.computeCovarDpSimHv(iqhc[igate].data(), iqvc[igate].data(),
+                                  simHv[igate]);
+    }
+
+    // batch results, for each SIMD level
+
+    RadarCovarBatch batch;
+    for (int simd = RadarCovarBatch::SIMD_SCALAR;
+         simd <= RadarCovarBatch::getSimdAvailable(); simd++) {
+
+      batch.setSimdLevel((RadarCovarBatch::simd_level_t) simd);
+      batch.setDims(nGates, nSamples);
+      for (int igate = 0; igate < nGates; igate++) {
+        batch.loadGateHc(igate, iqhc[igate].data());
+        batch.loadGateVc(igate, iqvc[igate].data());
+      }
+      
+      batch.computeSinglePolH();
+      batch.computeSinglePolV();
+      for (int igate = 0; igate < nGates; igate++) {
+        MomentsFields fields;
+        batch.loadFieldsSinglePolH(igate, fields);
+        batch.loadFieldsSinglePolV(igate, fields);
+        const MomentsFields &eh = singleH[igate];
+        const MomentsFields &ev = singleV[igate];
+        _check("single H lag0", simd, igate,
+               eh.lag0_hc, fields.lag0_hc, eh.lag0_hc);
+        _check("single H lag1", simd, igate,
+               eh.lag1_hc, fields.lag1_hc, eh.lag0_hc);
+        _check("single H lag2", simd, igate,
+               eh.lag2_hc, fields.lag2_hc, eh.lag0_hc);
+        _check("single H lag3", simd, igate,
+               eh.lag3_hc, fields.lag3_hc, eh.lag0_hc);
+        _check("single V lag0", simd, igate,
+               ev.lag0_vc, fields.lag0_vc, ev.lag0_vc);
+        _check("single V lag1", simd, igate,
+               ev.lag1_vc, fields.lag1_vc, ev.lag0_vc);
+        _check("single V lag2", simd, igate,
+               ev.lag2_vc, fields.lag2_vc, ev.lag0_vc);
+        _check("single V lag3", simd, igate,
+               ev.lag3_vc, fields.lag3_vc, ev.lag0_vc);
+      }
+
+      batch.computeDpSimHv();
+      for (int igate = 0; igate < nGates; igate++) {
+        MomentsFields fields;
+        batch.loadFieldsDpSimHv(igate, fields);
+        const MomentsFields &ee = simHv[igate];
+        double scale = ee.lag0_hc + ee.lag0_vc;
+        _check("simHv lag0 hc", simd, igate,
+               ee.lag0_hc, fields.lag0_hc, scale);
+        _check("simHv lag0 vc", simd, igate,
+               ee.lag0_vc, fields.lag0_vc, scale);
+        _check("simHv rvvhh0", simd, igate,
+               ee.rvvhh0, fields.rvvhh0, scale);
+        _check("simHv lag1 hc", simd, igate,
+               ee.lag1_hc, fields.lag1_hc, scale);
+        _check("simHv lag1 vc", simd, igate,
+               ee.lag1_vc, fields.lag1_vc, scale);
+        _check("simHv lag2 hc", simd, igate,
+               ee.lag2_hc, fields.lag2_hc, scale);
+        _check("simHv lag2 vc", simd, igate,
+               ee.lag2_vc, fields.lag2_vc, scale);
+        _check("simHv lag3 hc", simd, igate,
+               ee.lag3_hc, fields.lag3_hc, scale);
+        _check("simHv lag3 vc", simd, igate,
+               ee.lag3_vc, fields.lag3_vc, scale);
+      }
+
+    } // simd
+
+  } // ilen
+
+  if (nFail > 0) {
+    fprintf(stderr, "TEST_RadarCovarBatch: %d failures\n", nFail);
+    return 1;
+  }
+
+  return 0;
+
+}
@@ -34,9 +34,20 @@
 #include <rapmath/VolumeData.hh>
 #include <toolsa/LogMsgStreamInit.hh>
 #include <toolsa/LogStream.hh>
+#include <toolsa/TaThreadSimple.hh>
 #include <toolsa/pmu.h>
 #include <toolsa/port.h>
 
+//------------------------------------------------------------------
+TaThread *RadxApp::AppThreads::clone(int index)
+{
+  // it is a simple thread that uses the RadxApp::compute() as method
+  TaThreadSimple *t = new TaThreadSimple(index);
+  t->setThreadMethod(RadxApp::compute);
+  t->setThreadContext(this);
+  return (TaThread *)t;
+}
+
 //------------------------------------------------------------------
 RadxApp::RadxApp(const MathData &sweepData, const MathData &rayData,
 		 const VolumeData &vdata)
@@ -144,17 +155,33 @@ bool RadxApp::update(const RadxAppParms &P, RadxAppVolume *volume)
   // do the volume commands first
   _p.processVolume(volume);
 
-  // then the loop commands, 1d
+  // then the loop commands, 1d. These are not threaded, since
+  // operators may read the neighboring rays, which other items update.
   _p.clearOutputDebugAll();
   for (int ii=0; ii < volume->numProcessingNodes(false); ++ii)
   {
     _p.processOneItem1d(volume, ii);
   }
 
-  // then the loop commands, 2d
-  for (int ii=0; ii < volume->numProcessingNodes(true); ++ii)
+  // then the loop commands, 2d, optionally threaded by sweep
+  if (P.thread_sweep_loop && P.num_threads > 1)
+  {
+    AppThreads *thread = new AppThreads();
+    thread->init(P.num_threads, P.thread_debug);
+    for (int ii=0; ii < volume->numProcessingNodes(true); ++ii)
+    {
+      AppInfo *info = new AppInfo(ii, this, volume, thread);
+      thread->thread(ii, (void *)info);
+    }
+    thread->waitForThreads();
+    delete thread;
+  }
+  else
   {
-    _p.processOneItem2d(volume, ii);
+    for (int ii=0; ii < volume->numProcessingNodes(true); ++ii)
+    {
+      _p.processOneItem2d(volume, ii);
+    }
   }
   _p.setOutputDebugAll();
 
@@ -168,6 +195,15 @@ bool RadxApp::update(const RadxAppParms &P, RadxAppVolume *volume)
 }
 
 
+//------------------------------------------------------------------
+void RadxApp::compute(void *ti)
+{
+  AppInfo *info = static_cast<AppInfo *>(ti);
+  info->_app->_p.processOneItem2d(info->_volume, info->_index,
+				  info->_thread);
+  delete info;
+}
+
 //---------------------------------------------------------------
 bool RadxApp::retrieveRay(const std::string &name, const RadxRay &ray,
                           const std::vector<RayxData> &data, RayxData &r,
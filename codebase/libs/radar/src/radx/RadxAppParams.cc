@@ -698,6 +698,18 @@
     tt->single_val.b = pFALSE;
     tt++;
     
+    // Parameter 'thread_sweep_loop'
+    // ctype is 'tdrp_bool_t'
+    
+    memset(tt, 0, sizeof(TDRPtable));
+    tt->ptype = BOOL_TYPE;
+    tt->param_name = tdrpStrDup("thread_sweep_loop");
+    tt->descr = tdrpStrDup("Option to process the sweeps in the 2d loop in threads");
+    tt->help = tdrpStrDup("If TRUE, and num_threads > 1, the 2d loop commands for each sweep are run in separate threads. Only set this if the 2d operators do not read data from other sweeps. The 1d loop commands are always run one ray at a time, since operators may read the neighboring rays.");
+    tt->val_offset = (char *) &thread_sweep_loop - &_start_;
+    tt->single_val.b = pFALSE;
+    tt++;
+    
     // Parameter 'Comment 2'
     
     memset(tt, 0, sizeof(TDRPtable));
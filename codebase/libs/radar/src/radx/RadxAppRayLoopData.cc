@@ -49,6 +49,26 @@ void RadxAppRayLoopData::setMissing(int ipt)
   RayxData::setV(ipt, RayxData::getMissing());
 }
 
+//-----------------------------------------------------------
+void RadxAppRayLoopData::getVals(int i0, int n, double *v, bool *ok) const
+{
+  for (int i=0; i<n; ++i)
+  {
+    ok[i] = RayxData::getV(i0 + i, v[i]);
+  }
+}
+
+//-----------------------------------------------------------
+void RadxAppRayLoopData::setVals(int i0, int n, const double *v,
+				 const bool *ok)
+{
+  double missing = RayxData::getMissing();
+  for (int i=0; i<n; ++i)
+  {
+    RayxData::setV(i0 + i, ok[i] ? v[i] : missing);
+  }
+}
+
 //-----------------------------------------------------------
 double RadxAppRayLoopData::getMissingValue(void) const
 {
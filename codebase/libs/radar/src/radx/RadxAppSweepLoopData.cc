@@ -82,6 +82,39 @@ void RadxAppSweepLoopData::setMissing(int ipt)
   _rays[_rayIndex(ipt)].setV(_gateIndex(ipt), _rays[0].getMissing());
 }
 
+void RadxAppSweepLoopData::getVals(int i0, int n, double *v, bool *ok) const
+{
+  // step through the rays that the block spans
+  int i = 0;
+  while (i < n)
+  {
+    int r = _rayIndex(i0 + i);
+    int g = _gateIndex(i0 + i);
+    const RayxData &ray = _rays[r];
+    for (; i<n && g<_numDataPerRay; ++i, ++g)
+    {
+      ok[i] = ray.getV(g, v[i]);
+    }
+  }
+}
+
+void RadxAppSweepLoopData::setVals(int i0, int n, const double *v,
+				   const bool *ok)
+{
+  double missing = _rays[0].getMissing();
+  int i = 0;
+  while (i < n)
+  {
+    int r = _rayIndex(i0 + i);
+    int g = _gateIndex(i0 + i);
+    RayxData &ray = _rays[r];
+    for (; i<n && g<_numDataPerRay; ++i, ++g)
+    {
+      ray.setV(g, ok[i] ? v[i] : missing);
+    }
+  }
+}
+
 double RadxAppSweepLoopData::getMissingValue(void) const
 {
   return _rays[0].getMissing();
@@ -0,0 +1,548 @@
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* 
+// ** Copyright UCAR (c) 1990 - 2016                                         
+// ** University Corporation for Atmospheric Research (UCAR)                 
+// ** National Center for Atmospheric Research (NCAR)                        
+// ** Boulder, Colorado, USA                                                 
+// ** BSD licence applies - redistribution and use in source and binary      
+// ** forms, with or without modification, are permitted provided that       
+// ** the following conditions are met:                                      
+// ** 1) If the software is modified to produce derivative works,            
+// ** such modified software should be clearly marked, so as not             
+// ** to confuse it with the version available from UCAR.                    
+// ** 2) Redistributions of source code must retain the above copyright      
+// ** notice, this list of conditions and the following disclaimer.          
+// ** 3) Redistributions in binary form must reproduce the above copyright   
+// ** notice, this list of conditions and the following disclaimer in the    
+// ** documentation and/or other materials provided with the distribution.   
+// ** 4) Neither the name of UCAR nor the names of its contributors,         
+// ** if any, may be used to endorse or promote products derived from        
+// ** this software without specific prior written permission.               
+// ** DISCLAIMER: THIS SOFTWARE IS PROVIDED "AS IS" AND WITHOUT ANY EXPRESS  
+// ** OR IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED      
+// ** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.    
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* 
+///////////////////////////////////////////////////////////////
+// DsBeamView.cc
+//
+// DsBeamView object
+//
+///////////////////////////////////////////////////////////////
+//
+// DsBeamView gives access to the beam data in a DsRadarMsg,
+// field by field, without copying the beam.
+//
+////////////////////////////////////////////////////////////////
+
+#include <cstring>
+#include <dataport/bigend.h>
+#include <didss/DsMsgPart.hh>
+#include <rapformats/DsBeamView.hh>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define DS_BEAM_VIEW_X86_SIMD
+#include <immintrin.h>
+// keep the multiplies and adds separate, as in the scalar code
+#if defined(__clang__)
+#define DS_BEAM_VIEW_NO_FMA
+#else
+#define DS_BEAM_VIEW_NO_FMA __attribute__((optimize("fp-contract=off")))
+#endif
+#endif
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////
+// Scalar kernels
+
+static inline ui16 _swap16(ui16 val)
+{
+  return (ui16) ((val >> 8) | (val << 8));
+}
+
+static inline fl32 _swapFl32(fl32 val)
+{
+  ui32 ival;
+  memcpy(&ival, &val, sizeof(ival));
+  ival = ((ival >> 24) | ((ival >> 8) & 0x0000ff00) |
+          ((ival << 8) & 0x00ff0000) | (ival << 24));
+  memcpy(&val, &ival, sizeof(val));
+  return val;
+}
+
+static void _ui08Scalar(const ui08 *in, int stride, int nGates,
+                        double scale, double bias,
+                        ui08 missingIn, fl32 missingOut, fl32 *out)
+{
+  for (int igate = 0; igate < nGates; igate++, in += stride, out++) {
+    ui08 inVal = *in;
+    if (inVal == missingIn) {
+      *out = missingOut;
+    } else {
+      *out = inVal * scale + bias;
+    }
+  }
+}
+
+static void _ui16Scalar(const ui16 *in, int stride, int nGates, bool swap,
+                        double scale, double bias,
+                        ui16 missingIn, fl32 missingOut, fl32 *out)
+{
+  for (int igate = 0; igate < nGates; igate++, in += stride, out++) {
+    ui16 inVal = *in;
+    if (swap) {
+      inVal = _swap16(inVal);
+    }
+    if (inVal == missingIn) {
+      *out = missingOut;
+    } else {
+      *out = inVal * scale + bias;
+    }
+  }
+}
+
+static void _fl32Scalar(const fl32 *in, int stride, int nGates, bool swap,
+                        fl32 missingIn, fl32 missingOut, fl32 *out)
+{
+  for (int igate = 0; igate < nGates; igate++, in += stride, out++) {
+    fl32 inVal = *in;
+    if (swap) {
+      inVal = _swapFl32(inVal);
+    }
+    if (inVal == missingIn) {
+      *out = missingOut;
+    } else {
+      *out = inVal;
+    }
+  }
+}
+
+#ifdef DS_BEAM_VIEW_X86_SIMD
+
+////////////////////////////////////////////////////////////////
+// AVX2 kernels - 8 gates per step.
+// Integer data is converted to double, 4 gates per register,
+// so that the scaling matches the scalar kernels exactly.
+// Any remaining gates are done by the scalar kernels.
+
+// scale 8 integer values, set missing values, store as floats
+
+__attribute__((target("avx2"))) DS_BEAM_VIEW_NO_FMA
+static inline void _scaleStore8(__m256i ival, __m256i missingIn,
+                                __m256d scale, __m256d bias,
+                                __m256 missingOut, fl32 *out)
+{
+  __m256d lo = _mm256_cvtepi32_pd(_mm256_castsi256_si128(ival));
+  __m256d hi = _mm256_cvtepi32_pd(_mm256_extracti128_si256(ival, 1));
+  lo = _mm256_add_pd(_mm256_mul_pd(lo, scale), bias);
+  hi = _mm256_add_pd(_mm256_mul_pd(hi, scale), bias);
+  __m256 fval = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm256_cvtpd_ps(lo)),
+                                     _mm256_cvtpd_ps(hi), 1);
+  __m256 isMissing = _mm256_castsi256_ps(_mm256_cmpeq_epi32(ival, missingIn));
+  _mm256_storeu_ps(out, _mm256_blendv_ps(fval, missingOut, isMissing));
+}
+
+__attribute__((target("avx2"))) DS_BEAM_VIEW_NO_FMA
+static void _ui08Avx2(const ui08 *in, int stride, int nGates,
+                      double scale, double bias,
+                      ui08 missingIn, fl32 missingOut, fl32 *out)
+{
+  __m256i vMissingIn = _mm256_set1_epi32(missingIn);
+  __m256d vScale = _mm256_set1_pd(scale);
+  __m256d vBias = _mm256_set1_pd(bias);
+  __m256 vMissingOut = _mm256_set1_ps(missingOut);
+  int igate = 0;
+  for (; igate + 8 <= nGates; igate += 8) {
+    __m256i ival;
+    if (stride == 1) {
+      ival = _mm256_cvtepu8_epi32
+        (_mm_loadl_epi64((const __m128i *) (in + igate)));
+    } else {
+      const ui08 *pp = in + igate * stride;
+      ival = _mm256_setr_epi32(pp[0], pp[stride], pp[2 * stride],
+                               pp[3 * stride], pp[4 * stride],
+                               pp[5 * stride], pp[6 * stride],
+                               pp[7 * stride]);
+    }
+    _scaleStore8(ival, vMissingIn, vScale, vBias, vMissingOut, out + igate);
+  }
+  _ui08Scalar(in + igate * stride, stride, nGates - igate,
+              scale, bias, missingIn, missingOut, out + igate);
+}
+
+__attribute__((target("avx2"))) DS_BEAM_VIEW_NO_FMA
+static void _ui16Avx2(const ui16 *in, int stride, int nGates, bool swap,
+                      double scale, double bias,
+                      ui16 missingIn, fl32 missingOut, fl32 *out)
+{
+  __m256i vMissingIn = _mm256_set1_epi32(missingIn);
+  __m256d vScale = _mm256_set1_pd(scale);
+  __m256d vBias = _mm256_set1_pd(bias);
+  __m256 vMissingOut = _mm256_set1_ps(missingOut);
+  __m128i swap16 = _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6,
+                                 9, 8, 11, 10, 13, 12, 15, 14);
+  __m256i lowByte = _mm256_set1_epi32(0xff);
+  int igate = 0;
+  for (; igate + 8 <= nGates; igate += 8) {
+    __m256i ival;
+    if (stride == 1) {
+      __m128i raw = _mm_loadu_si128((const __m128i *) (in + igate));
+      if (swap) {
+        raw = _mm_shuffle_epi8(raw, swap16);
+      }
+      ival = _mm256_cvtepu16_epi32(raw);
+    } else {
+      const ui16 *pp = in + igate * stride;
+      ival = _mm256_setr_epi32(pp[0], pp[stride], pp[2 * stride],
+                               pp[3 * stride], pp[4 * stride],
+                               pp[5 * stride], pp[6 * stride],
+                               pp[7 * stride]);
+      if (swap) {
+        ival = _mm256_or_si256
+          (_mm256_srli_epi32(ival, 8),
+           _mm256_slli_epi32(_mm256_and_si256(ival, lowByte), 8));
+      }
+    }
+    _scaleStore8(ival, vMissingIn, vScale, vBias, vMissingOut, out + igate);
+  }
+  _ui16Scalar(in + igate * stride, stride, nGates - igate, swap,
+              scale, bias, missingIn, missingOut, out + igate);
+}
+
+__attribute__((target("avx2")))
+static void _fl32Avx2(const fl32 *in, int stride, int nGates, bool swap,
+                      fl32 missingIn, fl32 missingOut, fl32 *out)
+{
+  __m256 vMissingIn = _mm256_set1_ps(missingIn);
+  __m256 vMissingOut = _mm256_set1_ps(missingOut);
+  __m256i swap32 = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4,
+                                    11, 10, 9, 8, 15, 14, 13, 12,
+                                    3, 2, 1, 0, 7, 6, 5, 4,
+                                    11, 10, 9, 8, 15, 14, 13, 12);
+  __m256i index = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3,
+                                                       4, 5, 6, 7),
+                                     _mm256_set1_epi32(stride));
+  int igate = 0;
+  for (; igate + 8 <= nGates; igate += 8) {
+    __m256i raw;
+    if (stride == 1) {
+      raw = _mm256_loadu_si256((const __m256i *) (in + igate));
+    } else {
+      raw = _mm256_i32gather_epi32((const int *) (in + igate * stride),
+                                   index, 4);
+    }
+    if (swap) {
+      raw = _mm256_shuffle_epi8(raw, swap32);
+    }
+    __m256 fval = _mm256_castsi256_ps(raw);
+    __m256 isMissing = _mm256_cmp_ps(fval, vMissingIn, _CMP_EQ_OQ);
+    _mm256_storeu_ps(out + igate, _mm256_blendv_ps(fval, vMissingOut, isMissing));
+  }
+  _fl32Scalar(in + igate * stride, stride, nGates - igate, swap,
+              missingIn, missingOut, out + igate);
+}
+
+#endif
+
+////////////////////////////////////////////////////////////////
+// Constructor
+
+DsBeamView::DsBeamView()
+{
+  _simdLevel = getSimdAvailable();
+  _clear();
+}
+
+////////////////////////////////////////////////////////////////
+// Destructor
+
+DsBeamView::~DsBeamView()
+{
+}
+
+////////////////////////////////////////////////////
+// get the highest SIMD level supported by this CPU
+
+DsBeamView::simd_level_t DsBeamView::getSimdAvailable()
+{
+#ifdef DS_BEAM_VIEW_X86_SIMD
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return SIMD_AVX2;
+  }
+#endif
+  return SIMD_SCALAR;
+}
+
+////////////////////////////////////////////////////
+// Set up the view on the beam part of the latest message.
+// Returns 0 on success, -1 on failure.
+
+int DsBeamView::init(const DsRadarMsg &msg)
+{
+
+  _clear();
+
+  if (!msg.allParamsSet()) {
+    return -1;
+  }
+  const DsMsgPart *part = msg.getPartByType(DsRadarMsg::RADAR_BEAM);
+  if (part == NULL || part->getLength() < (ssize_t) sizeof(DsBeamHdr_t)) {
+    return -1;
+  }
+
+  // decode the header, checking for the old version
+
+  const ui08 *buf = part->getBuf();
+  DsBeamHdr_t bhdr;
+  memcpy(&bhdr, buf, sizeof(bhdr));
+  BE_to_DsBeamHdr(&bhdr);
+  int byteWidth = bhdr.byte_width;
+  int layout = bhdr.data_layout;
+  ssize_t offset = sizeof(DsBeamHdr_t);
+  if (byteWidth != 1 && byteWidth != 2 && byteWidth != 4) {
+    DsBeamHdr_v1_t bhdr_v1;
+    memcpy(&bhdr_v1, buf, sizeof(bhdr_v1));
+    BE_to_array_32(&bhdr_v1, sizeof(DsBeamHdr_v1_t));
+    byteWidth = bhdr_v1.byte_width;
+    layout = DS_BEAM_LAYOUT_GATE_INTERLEAVED;
+    offset = sizeof(DsBeamHdr_v1_t);
+    if (byteWidth != 1 && byteWidth != 2 && byteWidth != 4) {
+      return -1;
+    }
+  }
+
+  int nFields = msg.getFieldParams().size();
+  int nGates = msg.getNGatesIn();
+  if (nFields < 1 || nGates < 1) {
+    return -1;
+  }
+  if (part->getLength() < offset + (ssize_t) nFields * nGates * byteWidth) {
+    return -1;
+  }
+
+  _nFields = nFields;
+  _nGates = nGates;
+  _byteWidth = byteWidth;
+  _fieldPlanar = (layout == DS_BEAM_LAYOUT_FIELD_PLANAR);
+  _swap = (byteWidth > 1 && !BE_is_big_endian());
+  _data = buf + offset;
+  _loadFieldParams(msg.getFieldParams());
+  _valid = true;
+
+  return 0;
+
+}
+
+////////////////////////////////////////////////////
+// Set up the view on a decoded beam.
+// Returns 0 on success, -1 on failure.
+
+int DsBeamView::init(const DsRadarBeam &beam,
+                     const vector<DsFieldParams *> &fieldParams,
+                     int nGates)
+{
+
+  _clear();
+
+  int nFields = fieldParams.size();
+  int byteWidth = beam.byteWidth;
+  if (nFields < 1 || nGates < 1) {
+    return -1;
+  }
+  if (byteWidth != 1 && byteWidth != 2 && byteWidth != 4) {
+    return -1;
+  }
+  if (beam.getDataNbytes() < nFields * nGates * byteWidth) {
+    return -1;
+  }
+
+  _nFields = nFields;
+  _nGates = nGates;
+  _byteWidth = byteWidth;
+  _fieldPlanar = false;
+  _swap = false;
+  _data = beam.data();
+  _loadFieldParams(fieldParams);
+  _valid = true;
+
+  return 0;
+
+}
+
+////////////////////////////////////////////////////
+// get pointer to gate 0 for a field
+
+const void *DsBeamView::getFieldPtr(int ifield) const
+{
+  if (!_valid || ifield < 0 || ifield >= _nFields) {
+    return NULL;
+  }
+  if (_fieldPlanar) {
+    return _data + ifield * _nGates * _byteWidth;
+  }
+  return _data + ifield * _byteWidth;
+}
+
+////////////////////////////////////////////////////
+// convert a field to floats
+
+void DsBeamView::getFieldFl32(int ifield, fl32 *out,
+                              int nGatesOut, fl32 missingOut) const
+{
+
+  const void *in = getFieldPtr(ifield);
+  if (in == NULL) {
+    for (int igate = 0; igate < nGatesOut; igate++) {
+      out[igate] = missingOut;
+    }
+    return;
+  }
+
+  int nGates = _nGates;
+  if (nGatesOut < nGates) {
+    nGates = nGatesOut;
+  }
+  int stride = getGateStride();
+  
+  if (_byteWidth == 4) {
+    fl32ToFl32((const fl32 *) in, stride, nGates, _swap,
+               (fl32) _missing[ifield], missingOut, out, _simdLevel);
+  } else if (_byteWidth == 2) {
+    ui16ToFl32((const ui16 *) in, stride, nGates, _swap,
+               _scale[ifield], _bias[ifield],
+               (ui16) _missing[ifield], missingOut, out, _simdLevel);
+  } else {
+    ui08ToFl32((const ui08 *) in, stride, nGates,
+               _scale[ifield], _bias[ifield],
+               (ui08) _missing[ifield], missingOut, out, _simdLevel);
+  }
+
+  for (int igate = nGates; igate < nGatesOut; igate++) {
+    out[igate] = missingOut;
+  }
+
+}
+
+////////////////////////////////////////////////////
+// copy a field without scaling
+
+void DsBeamView::getFieldRaw(int ifield, void *out, int nGatesOut) const
+{
+
+  const void *in = getFieldPtr(ifield);
+  if (in == NULL) {
+    return;
+  }
+
+  int nGates = _nGates;
+  if (nGatesOut < nGates) {
+    nGates = nGatesOut;
+  }
+  int stride = getGateStride();
+  
+  if (stride == 1) {
+    memcpy(out, in, nGates * _byteWidth);
+  } else if (_byteWidth == 4) {
+    const ui32 *inData = (const ui32 *) in;
+    ui32 *outData = (ui32 *) out;
+    for (int igate = 0; igate < nGates; igate++, inData += stride) {
+      outData[igate] = *inData;
+    }
+  } else if (_byteWidth == 2) {
+    const ui16 *inData = (const ui16 *) in;
+    ui16 *outData = (ui16 *) out;
+    for (int igate = 0; igate < nGates; igate++, inData += stride) {
+      outData[igate] = *inData;
+    }
+  } else {
+    const ui08 *inData = (const ui08 *) in;
+    ui08 *outData = (ui08 *) out;
+    for (int igate = 0; igate < nGates; igate++, inData += stride) {
+      outData[igate] = *inData;
+    }
+  }
+
+  if (_swap) {
+    if (_byteWidth == 2) {
+      BE_to_array_16(out, nGates * _byteWidth);
+    } else if (_byteWidth == 4) {
+      BE_to_array_32(out, nGates * _byteWidth);
+    }
+  }
+
+}
+
+////////////////////////////////////////////////////
+// de-interleave and scale routines
+
+void DsBeamView::ui08ToFl32(const ui08 *in, int stride, int nGates,
+                            double scale, double bias,
+                            ui08 missingIn, fl32 missingOut, fl32 *out,
+                            simd_level_t level /* = SIMD_SCALAR */)
+{
+#ifdef DS_BEAM_VIEW_X86_SIMD
+  if (level == SIMD_AVX2) {
+    _ui08Avx2(in, stride, nGates, scale, bias, missingIn, missingOut, out);
+    return;
+  }
+#endif
+  _ui08Scalar(in, stride, nGates, scale, bias, missingIn, missingOut, out);
+}
+
+void DsBeamView::ui16ToFl32(const ui16 *in, int stride, int nGates, bool swap,
+                            double scale, double bias,
+                            ui16 missingIn, fl32 missingOut, fl32 *out,
+                            simd_level_t level /* = SIMD_SCALAR */)
+{
+#ifdef DS_BEAM_VIEW_X86_SIMD
+  if (level == SIMD_AVX2) {
+    _ui16Avx2(in, stride, nGates, swap, scale, bias,
+              missingIn, missingOut, out);
+    return;
+  }
+#endif
+  _ui16Scalar(in, stride, nGates, swap, scale, bias,
+              missingIn, missingOut, out);
+}
+
+void DsBeamView::fl32ToFl32(const fl32 *in, int stride, int nGates, bool swap,
+                            fl32 missingIn, fl32 missingOut, fl32 *out,
+                            simd_level_t level /* = SIMD_SCALAR */)
+{
+#ifdef DS_BEAM_VIEW_X86_SIMD
+  if (level == SIMD_AVX2) {
+    _fl32Avx2(in, stride, nGates, swap, missingIn, missingOut, out);
+    return;
+  }
+#endif
+  _fl32Scalar(in, stride, nGates, swap, missingIn, missingOut, out);
+}
+
+////////////////////////////////////////////////////
+// clear the view
+
+void DsBeamView::_clear()
+{
+  _valid = false;
+  _nFields = 0;
+  _nGates = 0;
+  _byteWidth = 1;
+  _fieldPlanar = false;
+  _swap = false;
+  _data = NULL;
+  _scale.clear();
+  _bias.clear();
+  _missing.clear();
+}
+
+////////////////////////////////////////////////////
+// save the scaling and missing value for each field
+
+void DsBeamView::_loadFieldParams(const vector<DsFieldParams *> &fieldParams)
+{
+  for (size_t ii = 0; ii < fieldParams.size(); ii++) {
+    _scale.push_back(fieldParams[ii]->scale);
+    _bias.push_back(fieldParams[ii]->bias);
+    _missing.push_back(fieldParams[ii]->missingDataValue);
+  }
+}
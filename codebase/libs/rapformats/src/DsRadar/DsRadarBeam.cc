@@ -180,53 +180,7 @@ DsRadarBeam::decode( int nGatesIn, DsBeamHdr_t *bhdr_msg,
   // grab and swap header
 
   DsBeamHdr_t bhdr;
-  memcpy(&bhdr, bhdr_msg, sizeof(bhdr));
-  BE_to_DsBeamHdr(&bhdr);
-  bool version1 = false;
-
-  if (bhdr.byte_width == 1 ||
-      bhdr.byte_width == 2 ||
-      bhdr.byte_width == 4) {
-    
-  } else {
-
-    // version 0
-    // load new struct version from old version
-
-    DsBeamHdr_v1_t bhdr_v1;
-    memcpy(&bhdr_v1, bhdr_msg, sizeof(bhdr_v1));
-    BE_to_array_32(&bhdr_v1, sizeof(DsBeamHdr_v1_t));
-    version1 = true;
-
-    MEM_zero(bhdr);
-    bhdr.time = bhdr_v1.time;
-    bhdr.vol_num = bhdr_v1.vol_num;
-    bhdr.tilt_num = bhdr_v1.tilt_num;
-    bhdr.reference_time = bhdr_v1.reference_time;
-    bhdr.byte_width = bhdr_v1.byte_width;
-    bhdr.azimuth = bhdr_v1.azimuth;
-    bhdr.elevation = bhdr_v1.elevation;
-    bhdr.target_elev = bhdr_v1.target_elev;
-
-  }
-  
-  dataTime =  bhdr.time;
-  nanoSecs = bhdr.nano_secs;
-  referenceTime = bhdr.reference_time;
-  byteWidth = bhdr.byte_width;
-  volumeNum = bhdr.vol_num;
-  tiltNum = bhdr.tilt_num;
-  scanMode = bhdr.scan_mode;
-  antennaTransition = bhdr.antenna_transition;
-  azimuth = bhdr.azimuth;
-  elevation = bhdr.elevation;
-  targetElev = bhdr.target_elev;
-  targetAz = bhdr.target_az;
-  beamIsIndexed = bhdr.beam_is_indexed;
-  angularResolution = bhdr.angular_resolution;
-  nSamples = bhdr.n_samples;
-  measXmitPowerDbmH = bhdr.measXmitPowerDbmH;
-  measXmitPowerDbmV = bhdr.measXmitPowerDbmV;
+  bool version1 = _decodeHdr(bhdr_msg, bhdr);
 
   // alloc space for data
 
@@ -245,7 +199,14 @@ DsRadarBeam::decode( int nGatesIn, DsBeamHdr_t *bhdr_msg,
   if (version1) {
     msgDataPtr = (ui08*) bhdr_msg + sizeof(DsBeamHdr_v1_t);
   }
-  if( nGatesOut <=  nGatesIn ) {
+  if (bhdr.data_layout == DS_BEAM_LAYOUT_FIELD_PLANAR && nFields > 1) {
+    // the object always holds the data gate by gate
+    int nGatesCopy = nGatesOut;
+    if (nGatesIn < nGatesCopy) {
+      nGatesCopy = nGatesIn;
+    }
+    _interleave(msgDataPtr, nFields, nGatesIn, nGatesCopy);
+  } else if( nGatesOut <=  nGatesIn ) {
     memcpy( _data, msgDataPtr, (nBytesOut) );
   } else {
     memcpy( _data, msgDataPtr, (nBytesIn) );
@@ -261,48 +222,54 @@ DsRadarBeam::decode( int nGatesIn, DsBeamHdr_t *bhdr_msg,
 
 }
 
+// decode the beam header only, leaving the data empty.
+// Use DsBeamView to access the data in the message.
+
+void
+DsRadarBeam::decodeHdr( const DsBeamHdr_t *bhdr_msg )
+{
+
+  DsBeamHdr_t bhdr;
+  _decodeHdr(bhdr_msg, bhdr);
+  _alloc(0);
+  memcpy(_beam, &bhdr, sizeof(bhdr));
+
+}
+
 void *
 DsRadarBeam::encode()
 {
+  return _encode(DS_BEAM_LAYOUT_GATE_INTERLEAVED);
+}
 
-  //
-  // Encode the beam header
-  //
+// encode, optionally with the data field by field.
+// Only use fieldPlanar if all readers handle that layout.
 
-  DsBeamHdr_t *bhdr = (DsBeamHdr_t *) _beam;
-  memset( bhdr, 0, sizeof(DsBeamHdr_t) );
+void *
+DsRadarBeam::encode( int nFields, bool fieldPlanar )
+{
 
-  bhdr->time            = dataTime;
-  bhdr->nano_secs       = nanoSecs;
-  bhdr->reference_time  = referenceTime;
-  bhdr->byte_width      = byteWidth;
-  bhdr->vol_num         = volumeNum;
-  bhdr->tilt_num        = tiltNum;
-  bhdr->scan_mode       = scanMode;
-  bhdr->antenna_transition = antennaTransition;
-  bhdr->azimuth         = azimuth;
-  bhdr->elevation       = elevation;
-  bhdr->target_elev     = targetElev;
-  bhdr->target_az       = targetAz;
-  bhdr->beam_is_indexed = beamIsIndexed;
-  bhdr->angular_resolution = angularResolution;
-  bhdr->n_samples = nSamples;
-  bhdr->measXmitPowerDbmH = measXmitPowerDbmH;
-  bhdr->measXmitPowerDbmV = measXmitPowerDbmV;
-  
-  BE_from_DsBeamHdr(bhdr);
-  
-  // swap multi-byte data
-  
-  if (byteWidth == 2) {
-    BE_from_array_16(_data, _dataLen);
-  } else if (byteWidth == 4) {
-    BE_from_array_32(_data, _dataLen);
+  if (!fieldPlanar || nFields < 2 || _dataLen == 0) {
+    return _encode(DS_BEAM_LAYOUT_GATE_INTERLEAVED);
   }
 
-  // return pointer to the beam
+  // transpose the data to field-planar
+
+  int nGates = _dataLen / (nFields * byteWidth);
+  ui08 *copy = (ui08 *) umalloc(_dataLen);
+  memcpy(copy, _data, _dataLen);
+  ui08 *out = (ui08 *) _data;
+  for (int ifield = 0; ifield < nFields; ifield++) {
+    const ui08 *in = copy + ifield * byteWidth;
+    for (int igate = 0; igate < nGates; igate++) {
+      memcpy(out, in, byteWidth);
+      out += byteWidth;
+      in += nFields * byteWidth;
+    }
+  }
+  ufree(copy);
 
-  return _beam;
+  return _encode(DS_BEAM_LAYOUT_FIELD_PLANAR);
 
 }
 
@@ -541,6 +508,131 @@ DsRadarBeam::printFl32( FILE *out,
 
 }
 
+// decode and swap the header from the message, set the members.
+// Returns true if the message has a version 1 header.
+
+bool
+DsRadarBeam::_decodeHdr( const DsBeamHdr_t *bhdr_msg, DsBeamHdr_t &bhdr )
+{
+
+  memcpy(&bhdr, bhdr_msg, sizeof(bhdr));
+  BE_to_DsBeamHdr(&bhdr);
+  bool version1 = false;
+
+  if (bhdr.byte_width == 1 ||
+      bhdr.byte_width == 2 ||
+      bhdr.byte_width == 4) {
+    
+  } else {
+
+    // version 0
+    // load new struct version from old version
+
+    DsBeamHdr_v1_t bhdr_v1;
+    memcpy(&bhdr_v1, bhdr_msg, sizeof(bhdr_v1));
+    BE_to_array_32(&bhdr_v1, sizeof(DsBeamHdr_v1_t));
+    version1 = true;
+
+    MEM_zero(bhdr);
+    bhdr.time = bhdr_v1.time;
+    bhdr.vol_num = bhdr_v1.vol_num;
+    bhdr.tilt_num = bhdr_v1.tilt_num;
+    bhdr.reference_time = bhdr_v1.reference_time;
+    bhdr.byte_width = bhdr_v1.byte_width;
+    bhdr.azimuth = bhdr_v1.azimuth;
+    bhdr.elevation = bhdr_v1.elevation;
+    bhdr.target_elev = bhdr_v1.target_elev;
+
+  }
+  
+  dataTime =  bhdr.time;
+  nanoSecs = bhdr.nano_secs;
+  referenceTime = bhdr.reference_time;
+  byteWidth = bhdr.byte_width;
+  volumeNum = bhdr.vol_num;
+  tiltNum = bhdr.tilt_num;
+  scanMode = bhdr.scan_mode;
+  antennaTransition = bhdr.antenna_transition;
+  azimuth = bhdr.azimuth;
+  elevation = bhdr.elevation;
+  targetElev = bhdr.target_elev;
+  targetAz = bhdr.target_az;
+  beamIsIndexed = bhdr.beam_is_indexed;
+  angularResolution = bhdr.angular_resolution;
+  nSamples = bhdr.n_samples;
+  measXmitPowerDbmH = bhdr.measXmitPowerDbmH;
+  measXmitPowerDbmV = bhdr.measXmitPowerDbmV;
+
+  return version1;
+
+}
+
+void *
+DsRadarBeam::_encode( int dataLayout )
+{
+
+  //
+  // Encode the beam header
+  //
+
+  DsBeamHdr_t *bhdr = (DsBeamHdr_t *) _beam;
+  memset( bhdr, 0, sizeof(DsBeamHdr_t) );
+
+  bhdr->time            = dataTime;
+  bhdr->nano_secs       = nanoSecs;
+  bhdr->reference_time  = referenceTime;
+  bhdr->byte_width      = byteWidth;
+  bhdr->vol_num         = volumeNum;
+  bhdr->tilt_num        = tiltNum;
+  bhdr->scan_mode       = scanMode;
+  bhdr->antenna_transition = antennaTransition;
+  bhdr->azimuth         = azimuth;
+  bhdr->elevation       = elevation;
+  bhdr->target_elev     = targetElev;
+  bhdr->target_az       = targetAz;
+  bhdr->beam_is_indexed = beamIsIndexed;
+  bhdr->angular_resolution = angularResolution;
+  bhdr->n_samples = nSamples;
+  bhdr->data_layout = dataLayout;
+  bhdr->measXmitPowerDbmH = measXmitPowerDbmH;
+  bhdr->measXmitPowerDbmV = measXmitPowerDbmV;
+  
+  BE_from_DsBeamHdr(bhdr);
+  
+  // swap multi-byte data
+  
+  if (byteWidth == 2) {
+    BE_from_array_16(_data, _dataLen);
+  } else if (byteWidth == 4) {
+    BE_from_array_32(_data, _dataLen);
+  }
+
+  // return pointer to the beam
+
+  return _beam;
+
+}
+
+// load field-planar message data into the gate-by-gate data array.
+// _data has already been allocated and zeroed.
+
+void
+DsRadarBeam::_interleave( const ui08 *msgData, int nFields,
+                          int nGatesIn, int nGatesCopy )
+{
+
+  for (int ifield = 0; ifield < nFields; ifield++) {
+    const ui08 *in = msgData + ifield * nGatesIn * byteWidth;
+    ui08 *out = (ui08 *) _data + ifield * byteWidth;
+    for (int igate = 0; igate < nGatesCopy; igate++) {
+      memcpy(out, in, byteWidth);
+      in += byteWidth;
+      out += nFields * byteWidth;
+    }
+  }
+
+}
+
 void
 DsRadarBeam::_alloc( int in_data_len )
 {
@@ -36,11 +36,12 @@ using namespace std;
 
 DsRadarMsg::DsRadarMsg() : DsMessage()
 {
-  pad           = false;
-  paramsSet     = false;
-  accumContent  = 0;
-  nGatesOut     = 1;
-  nGatesIn      = 1;
+  _init();
+}
+   
+DsRadarMsg::DsRadarMsg( memModel_t mem_model ) : DsMessage(mem_model)
+{
+  _init();
 }
    
 DsRadarMsg::~DsRadarMsg()
@@ -78,6 +79,8 @@ DsRadarMsg::copy( const DsRadarMsg& source )
    pad          = source.pad;
    nGatesOut    = source.nGatesOut;
    nGatesIn     = source.nGatesIn;
+   decodeBeamData = source.decodeBeamData;
+   fieldPlanar  = source.fieldPlanar;
 
 }
 
@@ -155,7 +158,11 @@ DsRadarMsg::disassemble( const void *in_msg, const int msg_len,
       msgContent |= RADAR_BEAM;
       DsBeamHdr_t *beam =
 	(DsBeamHdr_t *) getPartByType(RADAR_BEAM)->getBuf();
-      radarBeam.decode(nGatesIn, beam, numFields, numGates );
+      if (decodeBeamData) {
+        radarBeam.decode(nGatesIn, beam, numFields, numGates );
+      } else {
+        radarBeam.decodeHdr(beam);
+      }
     }
   }
    
@@ -251,7 +258,11 @@ ui08 *
 
   if ( content & RADAR_BEAM ) {
 
-    radarBeam.encode();
+    if (fieldPlanar) {
+      radarBeam.encode(radarParams.getNumFields(), true);
+    } else {
+      radarBeam.encode();
+    }
     addPart(RADAR_BEAM, radarBeam.beamLen(), radarBeam.beam());
   }
 
@@ -296,6 +307,18 @@ DsRadarMsg::padBeams( bool padData, int numGates )
   nGatesOut = numGates;
 }
    
+void
+DsRadarMsg::_init()
+{
+  pad           = false;
+  paramsSet     = false;
+  accumContent  = 0;
+  nGatesOut     = 1;
+  nGatesIn      = 1;
+  decodeBeamData = true;
+  fieldPlanar   = false;
+}
+   
 void
 DsRadarMsg::_clearFields()
 {
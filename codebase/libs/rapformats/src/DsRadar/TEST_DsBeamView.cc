@@ -0,0 +1,311 @@
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*
+// ** Copyright UCAR (c) 1990 - 2016
+// ** University Corporation for Atmospheric Research (UCAR)
+// ** National Center for Atmospheric Research (NCAR)
+// ** Boulder, Colorado, USA
+// ** BSD licence applies - redistribution and use in source and binary
+// ** forms, with or without modification, are permitted provided that
+// ** the following conditions are met:
+// ** 1) If the software is modified to produce derivative works,
+// ** such modified software should be clearly marked, so as not
+// ** to confuse it with the version available from UCAR.
+// ** 2) Redistributions of source code must retain the above copyright
+// ** notice, this list of conditions and the following disclaimer.
+// ** 3) Redistributions in binary form must reproduce the above copyright
+// ** notice, this list of conditions and the following disclaimer in the
+// ** documentation and/or other materials provided with the distribution.
+// ** 4) Neither the name of UCAR nor the names of its contributors,
+// ** if any, may be used to endorse or promote products derived from
+// ** this software without specific prior written permission.
+// ** DISCLAIMER: THIS SOFTWARE IS PROVIDED "AS IS" AND WITHOUT ANY EXPRESS
+// ** OR IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+// ** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*
+/*
+ * Name: TEST_DsBeamView.cc
+ *
+ * Purpose:
+ *
+ *      To test DsBeamView against the legacy beam decoding in
+ *      DsRadarMsg. Beams are assembled with 1, 2 and 4 byte data,
+ *      in both the interleaved and field-planar layouts, and
+ *      disassembled with and without decoding the beam data.
+ *      The raw and float values from the view, for each SIMD level
+ *      available on this host, must match the legacy values exactly.
+ *
+ * Usage:
+ *
+ *       % DsBeamView-test
+ *
+ * Inputs:
+ *
+ *       None
+ *
+ * Returns 0 on success, 1 on failure.
+ * Prints nothing on success.
+ *
+ */
+
+/*
+ * include files
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <rapformats/DsRadarMsg.hh>
+#include <rapformats/DsBeamView.hh>
+using namespace std;
+
+static const fl32 missingOut = -9999.0f;
+
+static int nFail = 0;
+
+/*
+ * Legacy conversion to floats, as done by the readers on the
+ * interleaved beam data in DsRadarBeam
+ */
+
+static void _legacyFl32(const DsRadarBeam &beam, const DsFieldParams &fparams,
+                        int ifield, int nFields, int nGates, fl32 *out)
+{
+  int byteWidth = beam.byteWidth;
+  for (int igate = 0; igate < nGates; igate++) {
+    int index = igate * nFields + ifield;
+    if (byteWidth == 4) {
+      fl32 val = ((const fl32 *) beam.data())[index];
+      if (val == (fl32) fparams.missingDataValue) {
+        out[igate] = missingOut;
+      } else {
+        out[igate] = val;
+      }
+    } else if (byteWidth == 2) {
+      ui16 val = ((const ui16 *) beam.data())[index];
+      if (val == (ui16) fparams.missingDataValue) {
+        out[igate] = missingOut;
+      } else {
+        out[igate] = val * (double) fparams.scale + fparams.bias;
+      }
+    } else {
+      ui08 val = beam.data()[index];
+      if (val == (ui08) fparams.missingDataValue) {
+        out[igate] = missingOut;
+      } else {
+        out[igate] = val * (double) fparams.scale + fparams.bias;
+      }
+    }
+  }
+}
+
+/*
+ * Load pseudo-random beam data, including missing values
+ */
+
+static void _loadData(int byteWidth, int nGates, int nFields,
+                      vector<ui08> &data)
+{
+  data.resize(nGates * nFields * byteWidth);
+  unsigned int seed = 12345 + byteWidth + nGates;
+  for (int igate = 0; igate < nGates; igate++) {
+    for (int ifield = 0; ifield < nFields; ifield++) {
+      seed = seed * 1103515245 + 12345;
+      int index = igate * nFields + ifield;
+      if (byteWidth == 1) {
+        data[index] = (seed >> 16) & 0xff;
+      } else if (byteWidth == 2) {
+        ((ui16 *) data.data())[index] =
+          (seed % 7 == 0) ? 65535 : (seed >> 8) & 0xffff;
+      } else {
+        ((fl32 *) data.data())[index] = (seed % 5 == 0) ?
+          -9999.0f : ((int) (seed >> 8) % 100000) * 0.013f;
+      }
+    }
+  }
+}
+
+/*
+ * Compare floats bit for bit
+ */
+
+static void _checkFl32(const char *label, int byteWidth, int nGates,
+                       int nFields, int planar, int ifield,
+                       const vector<fl32> &expected,
+                       const vector<fl32> &actual)
+{
+  for (size_t igate = 0; igate < expected.size(); igate++) {
+    if (memcmp(&expected[igate], &actual[igate], sizeof(fl32))) {
+      fprintf(stderr, "FAIL - %s, byteWidth %d, nGates %d, nFields %d, "
+              "planar %d, field %d, gate %d, expected %g, got %g\n",
+              label, byteWidth, nGates, nFields, planar, ifield,
+              (int) igate, expected[igate], actual[igate]);
+      nFail++;
+      return;
+    }
+  }
+}
+
+/*
+ * Test one combination of byte width, gates, fields and layout
+ */
+
+static void _testBeam(int byteWidth, int nGates, int nFields, int planar)
+{
+
+  // assemble the message
+
+  DsRadarMsg outMsg;
+  DsRadarParams &rparams = outMsg.getRadarParams();
+  rparams.numFields = nFields;
+  rparams.numGates = nGates;
+  for (int ifield = 0; ifield < nFields; ifield++) {
+    // field 1 uses 0 as the missing value for integer data
+    int missing = -9999;
+    if (byteWidth != 4) {
+      if (ifield == 1) {
+        missing = 0;
+      } else {
+        missing = (byteWidth == 1) ? 255 : 65535;
+      }
+    }
+    string name = "F" + string(1, (char) ('0' + ifield));
+    DsFieldParams fparams(name.c_str(), "units",
+                          0.37 + ifield * 0.01, -11.5 + ifield,
+                          byteWidth, missing);
+    outMsg.addFieldParams(fparams);
+  }
+
+  vector<ui08> data;
+  _loadData(byteWidth, nGates, nFields, data);
+  DsRadarBeam beam;
+  beam.loadData(data.data(), data.size(), byteWidth);
+  beam.azimuth = 12.5;
+  outMsg.setRadarBeam(beam);
+  outMsg.setFieldPlanar(planar);
+
+  ui08 *buf = outMsg.assemble();
+  vector<ui08> msgBuf(buf, buf + outMsg.lengthAssembled());
+
+  // legacy decode, which always returns interleaved data
+
+  DsRadarMsg legacyMsg;
+  legacyMsg.disassemble(msgBuf.data(), msgBuf.size());
+  const DsRadarBeam &legacyBeam = legacyMsg.getRadarBeam();
+  if (legacyBeam.getDataNbytes() != (int) data.size() ||
+      memcmp(legacyBeam.data(), data.data(), data.size())) {
+    fprintf(stderr, "FAIL - legacy decode, byteWidth %d, nGates %d, "
+            "nFields %d, planar %d\n", byteWidth, nGates, nFields, planar);
+    nFail++;
+    return;
+  }
+
+  // header-only decode, with the view pointing into the message
+
+  DsRadarMsg viewMsg(DsMessage::PointToMem);
+  viewMsg.setDecodeBeamData(false);
+  viewMsg.disassemble(msgBuf.data(), msgBuf.size());
+  if (viewMsg.getRadarBeam().getDataNbytes() != 0 ||
+      viewMsg.getRadarBeam().azimuth != 12.5f) {
+    fprintf(stderr, "FAIL - header-only decode, byteWidth %d, nGates %d, "
+            "nFields %d, planar %d\n", byteWidth, nGates, nFields, planar);
+    nFail++;
+  }
+
+  DsBeamView msgView;
+  if (msgView.init(viewMsg)) {
+    fprintf(stderr, "FAIL - cannot init view on message\n");
+    nFail++;
+    return;
+  }
+  // a single field is always written interleaved
+  if (msgView.isFieldPlanar() != (planar && nFields > 1)) {
+    fprintf(stderr, "FAIL - layout, byteWidth %d, nGates %d, "
+            "nFields %d, planar %d\n", byteWidth, nGates, nFields, planar);
+    nFail++;
+  }
+
+  // view on the decoded beam
+
+  DsBeamView beamView;
+  if (beamView.init(legacyBeam, legacyMsg.getFieldParams(), nGates)) {
+    fprintf(stderr, "FAIL - cannot init view on beam\n");
+    nFail++;
+    return;
+  }
+
+  for (int ifield = 0; ifield < nFields; ifield++) {
+
+    // raw values
+
+    vector<ui08> raw(nGates * byteWidth), rawExpected(nGates * byteWidth);
+    for (int igate = 0; igate < nGates; igate++) {
+      memcpy(&rawExpected[igate * byteWidth],
+             legacyBeam.data() + (igate * nFields + ifield) * byteWidth,
+             byteWidth);
+    }
+    msgView.getFieldRaw(ifield, raw.data(), nGates);
+    if (raw != rawExpected) {
+      fprintf(stderr, "FAIL - raw, byteWidth %d, nGates %d, "
+              "nFields %d, planar %d, field %d\n",
+              byteWidth, nGates, nFields, planar, ifield);
+      nFail++;
+    }
+
+    // floats, padded past the end of the beam with missing
+
+    int nGatesOut = nGates + 3;
+    vector<fl32> expected(nGatesOut, missingOut);
+    _legacyFl32(legacyBeam, *legacyMsg.getFieldParams(ifield),
+                ifield, nFields, nGates, expected.data());
+
+    for (int simd = DsBeamView::SIMD_SCALAR;
+         simd <= DsBeamView::getSimdAvailable(); simd++) {
+      vector<fl32> actual(nGatesOut);
+      msgView.setSimdLevel((DsBeamView::simd_level_t) simd);
+      msgView.getFieldFl32(ifield, actual.data(), nGatesOut, missingOut);
+      _checkFl32(simd == DsBeamView::SIMD_SCALAR ?
+                 "message view, scalar" : "message view, simd",
+                 byteWidth, nGates, nFields, planar, ifield,
+                 expected, actual);
+    }
+
+    vector<fl32> actual(nGatesOut);
+    beamView.getFieldFl32(ifield, actual.data(), nGatesOut, missingOut);
+    _checkFl32("beam view", byteWidth, nGates, nFields, planar, ifield,
+               expected, actual);
+
+  } // ifield
+
+}
+
+/* ======================================================================== */
+
+/*
+ * main program
+ */
+
+int main(int argc, char *argv[])
+{
+
+  // gate counts either side of the SIMD block sizes
+
+  int nGatesList[] = {1, 7, 8, 9, 333, 1000};
+  int nFieldsList[] = {1, 3, 5};
+
+  for (int byteWidth = 1; byteWidth <= 4; byteWidth *= 2) {
+    for (size_t ii = 0; ii < sizeof(nGatesList) / sizeof(int); ii++) {
+      for (size_t jj = 0; jj < sizeof(nFieldsList) / sizeof(int); jj++) {
+        for (int planar = 0; planar < 2; planar++) {
+          _testBeam(byteWidth, nGatesList[ii], nFieldsList[jj], planar);
+        }
+      }
+    }
+  }
+
+  if (nFail > 0) {
+    fprintf(stderr, "DsBeamView-test: %d failures\n", nFail);
+    return 1;
+  }
+  return 0;
+
+}
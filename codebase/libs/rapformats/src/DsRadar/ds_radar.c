@@ -326,6 +326,8 @@ void DsBeamHdr_print(FILE *out, char *spacer,
           (int) bhdr->antenna_transition);
   fprintf(out, "%s n_samples: %d\n", spacer,
           (int) bhdr->n_samples);
+  fprintf(out, "%s data_layout: %d\n", spacer,
+          (int) bhdr->data_layout);
   fprintf(out, "%s azimuth: %g\n", spacer, bhdr->azimuth);
   fprintf(out, "%s elevation: %g\n", spacer, bhdr->elevation);
   fprintf(out, "%s target_elev: %g\n", spacer, bhdr->target_elev);
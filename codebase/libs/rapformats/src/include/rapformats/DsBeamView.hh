@@ -0,0 +1,177 @@
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* 
+// ** Copyright UCAR (c) 1990 - 2016                                         
+// ** University Corporation for Atmospheric Research (UCAR)                 
+// ** National Center for Atmospheric Research (NCAR)                        
+// ** Boulder, Colorado, USA                                                 
+// ** BSD licence applies - redistribution and use in source and binary      
+// ** forms, with or without modification, are permitted provided that       
+// ** the following conditions are met:                                      
+// ** 1) If the software is modified to produce derivative works,            
+// ** such modified software should be clearly marked, so as not             
+// ** to confuse it with the version available from UCAR.                    
+// ** 2) Redistributions of source code must retain the above copyright      
+// ** notice, this list of conditions and the following disclaimer.          
+// ** 3) Redistributions in binary form must reproduce the above copyright   
+// ** notice, this list of conditions and the following disclaimer in the    
+// ** documentation and/or other materials provided with the distribution.   
+// ** 4) Neither the name of UCAR nor the names of its contributors,         
+// ** if any, may be used to endorse or promote products derived from        
+// ** this software without specific prior written permission.               
+// ** DISCLAIMER: THIS SOFTWARE IS PROVIDED "AS IS" AND WITHOUT ANY EXPRESS  
+// ** OR IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED      
+// ** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.    
+// *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* 
+/////////////////////////////////////////////////////////////
+// DsBeamView.hh
+//
+// DsBeamView object
+//
+///////////////////////////////////////////////////////////////
+//
+// DsBeamView gives access to the beam data in a DsRadarMsg,
+// field by field, without copying the beam into a DsRadarBeam.
+//
+// The view points at the beam part of the message, which is in
+// big-endian byte order, either gate-interleaved or field-planar
+// (see DS_BEAM_LAYOUT_* in ds_radar.h). Each field is therefore
+// a strided array in the interleaved layout, or a contiguous one
+// in the planar layout.
+//
+// getFieldFl32() converts a field to floats in a single pass,
+// swapping, scaling and setting missing values, vectorized with
+// AVX2 if the CPU supports it. The SIMD level is detected at run
+// time, with a scalar fallback. Both give the same results as
+// converting gate by gate with (val * scale + bias).
+//
+// To avoid the copy in DsRadarMsg::disassemble(), call
+// DsRadarMsg::setDecodeBeamData(false), and use the PointToMem
+// memory model so that the parts point into the FMQ message.
+// The view is only valid until the message changes.
+//
+////////////////////////////////////////////////////////////////
+
+#ifndef DsBeamView_hh
+#define DsBeamView_hh
+
+#include <vector>
+#include <dataport/port_types.h>
+#include <rapformats/DsRadarMsg.hh>
+using namespace std;
+
+class DsBeamView {
+
+public:
+
+  typedef enum {
+    SIMD_SCALAR = 0,
+    SIMD_AVX2 = 1
+  } simd_level_t;
+
+  DsBeamView();
+  ~DsBeamView();
+
+  // Set up the view on the beam part of the latest message
+  // disassembled by msg. No data is copied.
+  // Returns 0 on success, -1 if the message has no beam, the
+  // params are not yet set, or the beam part is too short.
+
+  int init(const DsRadarMsg &msg);
+
+  // Set up the view on a decoded beam, which is in host byte
+  // order and gate-interleaved.
+  // Returns 0 on success, -1 if the beam is too short.
+
+  int init(const DsRadarBeam &beam,
+           const vector<DsFieldParams *> &fieldParams,
+           int nGates);
+
+  // set the SIMD level - defaults to the highest available
+
+  void setSimdLevel(simd_level_t level) { _simdLevel = level; }
+  simd_level_t getSimdLevel() const { return _simdLevel; }
+  
+  // get the highest SIMD level supported by this CPU
+
+  static simd_level_t getSimdAvailable();
+
+  // beam geometry
+
+  bool isValid() const { return _valid; }
+  int getNFields() const { return _nFields; }
+  int getNGates() const { return _nGates; }
+  int getByteWidth() const { return _byteWidth; }
+  bool isFieldPlanar() const { return _fieldPlanar; }
+
+  // Is the data big-endian on a little-endian host?
+  // If so, multi-byte values from getFieldPtr() must be swapped.
+
+  bool needsSwap() const { return _swap; }
+
+  // Raw access to a field: pointer to gate 0, and the step
+  // between gates, in elements of byteWidth.
+  // The step is 1 for field-planar data, nFields otherwise.
+
+  const void *getFieldPtr(int ifield) const;
+  int getGateStride() const { return _fieldPlanar ? 1 : _nFields; }
+
+  // Convert a field to floats, applying scale and bias for
+  // byte widths 1 and 2, and setting missing gates to missingOut.
+  // out must have space for nGatesOut values. Gates beyond the
+  // end of the beam are set to missingOut.
+
+  void getFieldFl32(int ifield, fl32 *out,
+                    int nGatesOut, fl32 missingOut) const;
+
+  void getFieldFl32(int ifield, fl32 *out, fl32 missingOut) const {
+    getFieldFl32(ifield, out, _nGates, missingOut);
+  }
+
+  // Copy a field to out, in host byte order, without scaling.
+  // out must have space for nGatesOut values of byteWidth.
+  // If nGatesOut exceeds the gates in the beam, the extra
+  // values are left unchanged.
+
+  void getFieldRaw(int ifield, void *out, int nGatesOut) const;
+
+  // De-interleave and scale routines.
+  // in points to gate 0, stride is the step between gates in
+  // elements. If swap is true, the input is byte-swapped.
+  // Input values equal to missingIn are set to missingOut,
+  // others to (val * scale + bias).
+
+  static void ui08ToFl32(const ui08 *in, int stride, int nGates,
+                         double scale, double bias,
+                         ui08 missingIn, fl32 missingOut, fl32 *out,
+                         simd_level_t level = SIMD_SCALAR);
+
+  static void ui16ToFl32(const ui16 *in, int stride, int nGates, bool swap,
+                         double scale, double bias,
+                         ui16 missingIn, fl32 missingOut, fl32 *out,
+                         simd_level_t level = SIMD_SCALAR);
+
+  static void fl32ToFl32(const fl32 *in, int stride, int nGates, bool swap,
+                         fl32 missingIn, fl32 missingOut, fl32 *out,
+                         simd_level_t level = SIMD_SCALAR);
+
+private:
+
+  bool _valid;
+  int _nFields;
+  int _nGates;
+  int _byteWidth;
+  bool _fieldPlanar;
+  bool _swap;
+  const ui08 *_data;
+
+  vector<double> _scale;
+  vector<double> _bias;
+  vector<int> _missing;
+
+  simd_level_t _simdLevel;
+
+  void _clear();
+  void _loadFieldParams(const vector<DsFieldParams *> &fieldParams);
+
+};
+
+#endif
@@ -93,15 +93,28 @@ public:
   void loadData( const void *in_data, int in_data_len, int byte_width );
   void loadData( const ui08 *in_data, int in_data_len );
   
-  // decode beam message, load up object
+  // decode beam message, load up object.
+  // The data is always stored gate by gate in the object, even if
+  // the message holds it field by field.
 
   void decode( int nGatesIn, DsBeamHdr_t *bhdr_msg,
 	       int nFields, int nGatesOut );
 
+  // decode the beam header only, leaving the data empty.
+  // Use DsBeamView to access the data in place in the message.
+
+  void decodeHdr( const DsBeamHdr_t *bhdr_msg );
+
   // encode returns pointer to start of beam
   // Also use get methods for details of the buffer
 
   void *encode();
+
+  // encode, with the data field by field if fieldPlanar is true.
+  // Readers built before the field-planar layout was added
+  // cannot decode it, so only use it if all readers are current.
+
+  void *encode( int nFields, bool fieldPlanar );
   
   // printing
 
@@ -182,6 +195,10 @@ private:
   int _dataLen;
 
   void _alloc( int in_data_len );
+  bool _decodeHdr( const DsBeamHdr_t *bhdr_msg, DsBeamHdr_t &bhdr );
+  void *_encode( int dataLayout );
+  void _interleave( const ui08 *msgData, int nFields,
+                    int nGatesIn, int nGatesCopy );
 
 };
 
@@ -64,6 +64,12 @@ public:
   };
 
   DsRadarMsg();
+
+  // With the PointToMem memory model, the message parts point into
+  // the buffer passed to disassemble(), which must then stay valid
+  // while the parts, or a DsBeamView on them, are in use.
+
+  DsRadarMsg( memModel_t mem_model );
   DsRadarMsg( const DsRadarMsg& source ){ copy( source ); }
   ~DsRadarMsg();
   
@@ -81,6 +87,26 @@ public:
 
   void padBeams( bool padData, int numGates = 1 );
 
+  // If decodeBeamData is false, disassemble() only decodes the beam
+  // header, and getRadarBeam().getData() is empty. Use DsBeamView to
+  // access the beam data in the message without copying it.
+  // Default is true.
+
+  void setDecodeBeamData( bool state ) { decodeBeamData = state; }
+
+  // If fieldPlanar is true, assemble() writes the beam data field by
+  // field rather than gate by gate. Only set this if all readers of
+  // the stream handle the field-planar layout. Default is false.
+  // The number of fields is taken from the radar params, which
+  // must therefore be set even if only the beam is sent.
+
+  void setFieldPlanar( bool state ) { fieldPlanar = state; }
+
+  // number of gates in the beam data of the incoming message,
+  // before any padding
+
+  inline int getNGatesIn() const { return nGatesIn; }
+
   inline bool allParamsSet() const { return paramsSet; }
 
   // const get fields should be used by apps reading this object
@@ -158,7 +184,11 @@ private:
   bool pad; // pad output data to nGatesOut?
   int nGatesOut;
   int nGatesIn;
+
+  bool decodeBeamData; // decode beam data into radarBeam?
+  bool fieldPlanar; // encode beam data field by field?
   
+  void _init();
   void _clearFields();
 
 };
@@ -113,6 +113,17 @@ extern "C" {
 #define DS_RADAR_PRF_MODE_STAGGERED_3_4 3
 #define DS_RADAR_PRF_MODE_STAGGERED_4_5 4
 
+/*
+ * beam data layout in the message.
+ * Gate-interleaved is the original layout, and the default.
+ * Field-planar stores all gates for field 0, then field 1 etc.
+ * Readers built before field-planar was added cannot decode it,
+ * so writers must select it explicitly.
+ */
+
+#define DS_BEAM_LAYOUT_GATE_INTERLEAVED 0
+#define DS_BEAM_LAYOUT_FIELD_PLANAR 1
+
 /*
  * message type definition
  */
@@ -276,7 +287,10 @@ typedef struct {
                             * dwell for this data beam.
                             * Same as samples_per_beam in radar params */
 
-  si32 spare_ints[2];
+  si32 data_layout;        /* DS_BEAM_LAYOUT_GATE_INTERLEAVED (0) or
+                            * DS_BEAM_LAYOUT_FIELD_PLANAR (1) */
+
+  si32 spare_ints[1];
 
   fl32 measXmitPowerDbmH;  /* measured H power in dBm */
   fl32 measXmitPowerDbmV;  /* measured V power in dBm */
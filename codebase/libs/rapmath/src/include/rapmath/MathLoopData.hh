@@ -33,6 +33,49 @@ public:
   #include <rapmath/MathLoopDataVirtualMethods.hh>
 #undef MATH_LOOP_DATA_BASE
 
+  /**
+   * Get a block of consecutive data values, starting at an index.
+   * Default is to call getVal() at each point, derived classes can
+   * override this with something faster
+   *
+   * @param[in] i0  Starting index
+   * @param[in] n  Number of points
+   * @param[out] v  Values, n of them
+   * @param[out] ok  True for each point where getVal() would succeed
+   */
+  inline virtual void getVals(int i0, int n, double *v, bool *ok) const
+  {
+    for (int i=0; i<n; ++i)
+    {
+      ok[i] = getVal(i0 + i, v[i]);
+    }
+  }
+
+  /**
+   * Set a block of consecutive data values, starting at an index.
+   * Default is to call setVal() or setMissing() at each point, derived
+   * classes can override this with something faster
+   *
+   * @param[in] i0  Starting index
+   * @param[in] n  Number of points
+   * @param[in] v  Values, n of them
+   * @param[in] ok  False for each point to set missing
+   */
+  inline virtual void setVals(int i0, int n, const double *v, const bool *ok)
+  {
+    for (int i=0; i<n; ++i)
+    {
+      if (ok[i])
+      {
+	setVal(i0 + i, v[i]);
+      }
+      else
+      {
+	setMissing(i0 + i);
+      }
+    }
+  }
+
 protected:
 private:
 
@@ -16,6 +16,7 @@ class ProcessingNode;
 class VolumeData;
 class Filter;
 class TaThreadQue;
+class MathProgram;
 
 class MathParser
 {
@@ -298,7 +299,7 @@ class Filter
     /**
      * Simple constructor, empty
      */
-    inline Filter(void) : _filter(NULL) {}
+    inline Filter(void) : _filter(NULL), _program(NULL) {}
 
     /**
      * Destructor
@@ -306,6 +307,7 @@ class Filter
     inline ~Filter(void) {}
 
     ProcessingNode *_filter;                 /**< Pointer to top node */
+    MathProgram *_program;                   /**< Compiled _filter, or NULL */
     Node::Pattern_t _pattern;                /**< Pattern, if any */
     std::vector<std::string> _inputs;        /**< The input variables */
     std::string _output;                     /**< The output variable */
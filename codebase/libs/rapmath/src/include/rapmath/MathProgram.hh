@@ -0,0 +1,166 @@
+/**
+ * @file MathProgram.hh
+ * @brief  An assignment compiled into a flat list of instructions that
+ *         operate on blocks of points
+ * @class MathProgram
+ * @brief  An assignment compiled into a flat list of instructions that
+ *         operate on blocks of points
+ *
+ * Assignments whose right hand side is made only of numbers, variables,
+ * the binary operators + - * / ^ and the unary operators abs, sqrt, log10
+ * and exp can be compiled. Anything else (logicals, user operators, filters
+ * such as smooth) is not, and is processed by walking the ProcessingNode
+ * tree at each point as before.
+ *
+ * Each instruction writes one register, which holds the values and the
+ * valid flags for a block of points. All the instructions are applied to
+ * one block before moving on to the next, so the intermediate values stay
+ * in cache, and each instruction is a tight loop with no virtual calls.
+ * The inputs are read, and the output written, a block at a time with
+ * MathLoopData::getVals() and MathLoopData::setVals().
+ *
+ * Results are the same as for ProcessingNode::compute() at each point:
+ * a result is missing if any input to it is missing, or on divide by zero.
+ * Operations on constants are done at compile time.
+ */
+
+#ifndef MATH_PROGRAM_H
+#define MATH_PROGRAM_H
+
+#include <rapmath/ProcessingNode.hh>
+#include <string>
+#include <vector>
+
+class MathData;
+
+//------------------------------------------------------------------
+class MathProgram
+{
+public:
+
+  /**
+   * Constructor, empty program
+   */
+  MathProgram(void);
+
+  /**
+   * Destructor
+   */
+  ~MathProgram(void);
+
+  /**
+   * Compile an assignment
+   * @param[in] assignment  The top node of a parsed assignment
+   * @return true if the whole assignment could be compiled
+   */
+  bool compile(const ProcessingNode &assignment);
+
+  /**
+   * Evaluate the program at all points of the data, storing results to
+   * the output variable
+   * @param[in,out] data
+   * @return true if successful
+   */
+  bool process(MathData *data) const;
+
+  /**
+   * @return a listing of the program, for debugging
+   */
+  std::string sprint(void) const;
+
+  /**
+   * @return index to an operand that is a variable, loaded from the data
+   * @param[in] name  Variable name
+   */
+  int load(const std::string &name);
+
+  /**
+   * @return index to an operand that is a constant
+   * @param[in] v  The value
+   */
+  int constant(double v);
+
+  /**
+   * @return index to an operand that is always missing
+   */
+  int missing(void);
+
+  /**
+   * @return index to the operand that is the result of a binary operation,
+   * or -1 if the operator is not one that can be compiled
+   * @param[in] op  Operator
+   * @param[in] a  Left operand index
+   * @param[in] b  Right operand index
+   */
+  int binary(ProcessingNode::Operator_t op, int a, int b);
+
+  /**
+   * @return index to the operand that is the result of a unary operation,
+   * or -1 if the operator is not one that can be compiled
+   * @param[in] op  Operator
+   * @param[in] a  Operand index
+   */
+  int unary(ProcessingNode::UnaryOperator_t op, int a);
+
+  /**
+   * Set the output variable and the operand assigned to it
+   * @param[in] name  Output variable name
+   * @param[in] a  Operand index
+   */
+  void setOutput(const std::string &name, int a);
+
+protected:
+private:
+
+  /**
+   * @enum Opcode_t
+   * @brief The instructions
+   */
+  typedef enum {LOAD, ADD, SUB, MULT, DIV, POW, ABS, SQRT, LOG10, EXP}
+    Opcode_t;
+
+  /**
+   * @class Operand
+   * @brief A register, a constant, or missing
+   */
+  class Operand
+  {
+  public:
+    typedef enum {REGISTER, CONSTANT, MISSING} Kind_t;
+    inline Operand(Kind_t k, int r, double v) : _kind(k), _reg(r), _value(v) {}
+    Kind_t _kind;   /**< Kind of operand */
+    int _reg;       /**< Register index, for REGISTER */
+    double _value;  /**< Value, for CONSTANT */
+  };
+
+  /**
+   * @class Instruction
+   * @brief One operation, writing one register
+   */
+  class Instruction
+  {
+  public:
+    inline Instruction(Opcode_t op, int out, int in0, int in1) :
+      _op(op), _out(out), _in0(in0), _in1(in1) {}
+    Opcode_t _op;  /**< Operation */
+    int _out;      /**< Output register */
+    int _in0;      /**< First operand index, or variable index for LOAD */
+    int _in1;      /**< Second operand index, binary operations only */
+  };
+
+  std::vector<Operand> _operands;          /**< All operands */
+  std::vector<Instruction> _program;       /**< The instructions, in order */
+  std::vector<std::string> _variables;     /**< Variables loaded */
+  int _nreg;                               /**< Number of registers */
+  std::string _output;                     /**< Output variable */
+  int _result;                             /**< Operand assigned to output */
+  bool _ok;                                /**< True if compiled */
+
+  static const int _blockSize = 256;       /**< Points per block */
+
+  int _register(void);
+  void _execute(const Instruction &inst, int n, double *v, bool *ok,
+		int &nDivZero) const;
+};
+
+#endif
@@ -16,6 +16,7 @@ class VolumeData;
 class MathData;
 class MathUserData;
 class MathLoopData;
+class MathProgram;
 
 class Node
 {
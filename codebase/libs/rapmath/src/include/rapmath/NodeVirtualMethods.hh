@@ -40,6 +40,14 @@
    */
   virtual bool compute(const MathData *data, int ind, double &v) const=0;
 
+  /**
+   * Compile the computation at a node into a program
+   * @param[in,out] program  Program appended to
+   * @param[out] operand  Index to the program operand that is the result
+   * @return true if the node could be compiled
+   */
+  virtual bool compile(MathProgram &program, int &operand) const = 0;
+
   /**
    * Append the output field names to the vector
    *
@@ -103,6 +111,14 @@
   virtual bool compute(const MathData *data,
 		       int ind, double &v) const;
 
+  /**
+   * Compile the computation at a node into a program
+   * @param[in,out] program  Program appended to
+   * @param[out] operand  Index to the program operand that is the result
+   * @return true if the node could be compiled
+   */
+  virtual bool compile(MathProgram &program, int &operand) const;
+
   /**
    * Append the output field names to the vector
    *
@@ -17,6 +17,7 @@ class Find;
 class BinaryArgs;
 class MathLoopData;
 class LogicalArgs;
+class MathProgram;
 
 class ProcessingNode
 {
@@ -245,6 +246,16 @@ public:
    */
   bool compute(const MathData *data, int ind, double &v) const;
 
+  /**
+   * Compile the computation at this node into a program
+   *
+   * @param[in,out] program  Program appended to
+   * @param[out] operand  Index to the program operand that is the result
+   *
+   * @return true if the node could be compiled
+   */
+  bool compile(MathProgram &program, int &operand) const;
+
   /**
    * Append all variable fields not on left hand side of an
    * assignment to the input vector, these are the inputs for this node
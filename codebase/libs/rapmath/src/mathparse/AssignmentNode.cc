@@ -1,4 +1,5 @@
 #include <rapmath/AssignmentNode.hh>
+#include <rapmath/MathProgram.hh>
 #include <rapmath/ProcessingNode.hh>
 #include <rapmath/LeafNode.hh>
 #include <rapmath/BinaryNode.hh>
@@ -146,6 +147,23 @@ bool AssignmentNode::compute(const MathData *data,
   return _assignedValue->compute(data, ipt, v);
 }
 
+//-------------------------------------------------------------------
+bool AssignmentNode::compile(MathProgram &program, int &operand) const
+{
+  std::string name = _variable.getName();
+  if (name.empty() || _assignedValue->isUserUnaryFunction() ||
+      _assignedValue->isMultiArgUnaryFunction())
+  {
+    return false;
+  }
+  if (!_assignedValue->compile(program, operand))
+  {
+    return false;
+  }
+  program.setOutput(name, operand);
+  return true;
+}
+
 //-------------------------------------------------------------------
 void AssignmentNode::outputFields(std::vector<std::string> &names) const
 {
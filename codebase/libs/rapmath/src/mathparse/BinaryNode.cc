@@ -1,4 +1,5 @@
 #include <rapmath/BinaryNode.hh>
+#include <rapmath/MathProgram.hh>
 #include <rapmath/BinaryArgs.hh>
 #include <toolsa/LogStream.hh>
 #include <cmath>
@@ -134,6 +135,18 @@ bool BinaryNode::compute(const MathData *data,
   }
 }
 
+//-------------------------------------------------------------------
+bool BinaryNode::compile(MathProgram &program, int &operand) const
+{
+  int a, b;
+  if (!_left->compile(program, a) || !_right->compile(program, b))
+  {
+    return false;
+  }
+  operand = program.binary(_op, a, b);
+  return operand >= 0;
+}
+
 //-------------------------------------------------------------------
 void BinaryNode::outputFields(std::vector<std::string> &names) const
 {
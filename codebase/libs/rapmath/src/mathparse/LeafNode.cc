@@ -1,4 +1,5 @@
 #include <rapmath/LeafNode.hh>
+#include <rapmath/MathProgram.hh>
 #include <toolsa/LogStream.hh>
 
 //-------------------------------------------------------------------
@@ -104,6 +105,28 @@ bool LeafNode::compute(const MathData *data, int ipt, double &v) const
   return _leafContent.getValue(data, ipt, v);
 }
 
+//-------------------------------------------------------------------
+bool LeafNode::compile(MathProgram &program, int &operand) const
+{
+  if (_leafContent.isVariable())
+  {
+    operand = program.load(_leafContent.getName());
+  }
+  else
+  {
+    double v;
+    if (_leafContent.getValue(v))
+    {
+      operand = program.constant(v);
+    }
+    else
+    {
+      operand = program.missing();
+    }
+  }
+  return true;
+}
+
 //-------------------------------------------------------------------
 void LeafNode::outputFields(std::vector<std::string> &names) const
 {
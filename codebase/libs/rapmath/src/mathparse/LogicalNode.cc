@@ -1,5 +1,6 @@
 #include <cstdlib>
 #include <rapmath/LogicalNode.hh>
+#include <rapmath/MathProgram.hh>
 #include <rapmath/MathLoopData.hh>
 #include <rapmath/MathData.hh>
 #include <rapmath/ProcessingNode.hh>
@@ -132,6 +133,13 @@ bool LogicalNode::compute(const MathData *data, int ipt, double &v) const
   return false;
 }
 
+//-------------------------------------------------------------------
+bool LogicalNode::compile(MathProgram &program, int &operand) const
+{
+  // logicals are processed point by point
+  return false;
+}
+
 //-------------------------------------------------------------------
 void LogicalNode::outputFields(std::vector<std::string> &names) const
 {
@@ -7,6 +7,7 @@
 #include <rapmath/MathUserData.hh>
 #include <rapmath/Find.hh>
 #include <rapmath/ProcessingNode.hh>
+#include <rapmath/MathProgram.hh>
 #include <rapmath/LogicalArgs.hh>
 #include <toolsa/TaThreadQue.hh>
 #include <toolsa/LogStream.hh>
@@ -724,6 +725,25 @@ bool MathParser::parse(const std::string &s, Filter_t filterType,
   f._inputs = inputs;
   f._pattern = p->pattern();
   f._dataType = filterType;
+
+  // loop assignments that are only arithmetic are compiled so they can be
+  // done a block of points at a time
+  if ((filterType == LOOP2D_TO_2D || filterType == LOOP1D) &&
+      (f._pattern == Node::DO_IT_THE_HARD_WAY ||
+       f._pattern == Node::SIMPLE_ASSIGN_SIMPLE_BINARY_TO_VAR))
+  {
+    f._program = new MathProgram();
+    if (f._program->compile(*p))
+    {
+      LOG(DEBUG_VERBOSE) << "Compiled '" << s << "'\n"
+			 << f._program->sprint();
+    }
+    else
+    {
+      delete f._program;
+      f._program = NULL;
+    }
+  }
   switch (filterType)
   {
   case VOLUME_BEFORE:
@@ -784,11 +804,19 @@ void MathParser::cleanup(void)
   {
     _filters2d[i]._filter->cleanup();
     delete _filters2d[i]._filter;
+    if (_filters2d[i]._program != NULL)
+    {
+      delete _filters2d[i]._program;
+    }
   }
   for (size_t i=0; i<_filters1d.size(); ++i)
   {
     _filters1d[i]._filter->cleanup();
     delete _filters1d[i]._filter;
+    if (_filters1d[i]._program != NULL)
+    {
+      delete _filters1d[i]._program;
+    }
   }
   for (size_t i=0; i<_volFilters.size(); ++i)
   {
@@ -1374,6 +1402,10 @@ void MathParser::_processLoop(const Filter &filter, MathData *rdata,
 	}
       }
     }
+    else if (filter._program != NULL)
+    {
+      filter._program->process(rdata);
+    }
     else
     {
       filter._filter->process(rdata);
@@ -0,0 +1,532 @@
+/**
+ * @file MathProgram.cc
+ */
+#include <rapmath/MathProgram.hh>
+#include <rapmath/MathData.hh>
+#include <rapmath/MathLoopData.hh>
+#include <toolsa/LogStream.hh>
+#include <cmath>
+#include <cstdio>
+using std::string;
+using std::vector;
+
+//------------------------------------------------------------------
+// The binary operations, for the loops below
+class _MathAdd
+{
+public:
+  static inline double f(double a, double b) {return a + b;}
+};
+class _MathSub
+{
+public:
+  static inline double f(double a, double b) {return a - b;}
+};
+class _MathMult
+{
+public:
+  static inline double f(double a, double b) {return a*b;}
+};
+class _MathPow
+{
+public:
+  static inline double f(double a, double b) {return pow(a, b);}
+};
+
+//------------------------------------------------------------------
+// Apply a binary operation to n points, where each of the inputs is
+// either a register (values and valid flags) or a constant (NULL register)
+template <class OP>
+static void _binaryLoop(int n, const double *a, const bool *aok, double ac,
+			const double *b, const bool *bok, double bc,
+			double *v, bool *ok)
+{
+  if (a != NULL && b != NULL)
+  {
+    for (int i=0; i<n; ++i)
+    {
+      v[i] = OP::f(a[i], b[i]);
+      ok[i] = aok[i] && bok[i];
+    }
+  }
+  else if (a != NULL)
+  {
+    for (int i=0; i<n; ++i)
+    {
+      v[i] = OP::f(a[i], bc);
+      ok[i] = aok[i];
+    }
+  }
+  else
+  {
+    for (int i=0; i<n; ++i)
+    {
+      v[i] = OP::f(ac, b[i]);
+      ok[i] = bok[i];
+    }
+  }
+}
+
+//------------------------------------------------------------------
+// Divide, where divide by zero gives missing as in BinaryNode::compute()
+static void _divideLoop(int n, const double *a, const bool *aok, double ac,
+			const double *b, const bool *bok, double bc,
+			double *v, bool *ok, int &nDivZero)
+{
+  for (int i=0; i<n; ++i)
+  {
+    double x = a != NULL ? a[i] : ac;
+    double y = b != NULL ? b[i] : bc;
+    bool good = (a != NULL ? aok[i] : true) && (b != NULL ? bok[i] : true);
+    if (good && y == 0)
+    {
+      ++nDivZero;
+      good = false;
+    }
+    v[i] = good ? x/y : 0.0;
+    ok[i] = good;
+  }
+}
+
+//------------------------------------------------------------------
+MathProgram::MathProgram(void) : _nreg(0), _result(-1), _ok(false)
+{
+}
+
+//------------------------------------------------------------------
+MathProgram::~MathProgram(void)
+{
+}
+
+//------------------------------------------------------------------
+bool MathProgram::compile(const ProcessingNode &assignment)
+{
+  _operands.clear();
+  _program.clear();
+  _variables.clear();
+  _nreg = 0;
+  _output = "";
+  _result = -1;
+  _ok = false;
+
+  int a;
+  if (!assignment.compile(*this, a) || _output.empty() || _result < 0)
+  {
+    return false;
+  }
+  _ok = true;
+  return true;
+}
+
+//------------------------------------------------------------------
+bool MathProgram::process(MathData *data) const
+{
+  if (!_ok)
+  {
+    LOG(ERROR) << "Program not compiled";
+    return false;
+  }
+  MathLoopData *out = data->dataPtr(_output);
+  if (out == NULL)
+  {
+    LOG(ERROR) << "No data for " << _output;
+    return false;
+  }
+
+  vector<const MathLoopData *> inputs;
+  for (size_t i=0; i<_variables.size(); ++i)
+  {
+    const MathLoopData *l = data->dataPtrConst(_variables[i]);
+    if (l == NULL)
+    {
+      LOG(ERROR) << "No named data in data object for " << _variables[i];
+    }
+    inputs.push_back(l);
+  }
+
+  int npt = data->numData();
+  const Operand &result = _operands[_result];
+  int nreg = _nreg > 0 ? _nreg : 1;
+  vector<double> values(nreg*_blockSize, 0.0);
+  bool *valid = new bool[nreg*_blockSize];
+  int nDivZero = 0;
+
+  for (int i0=0; i0<npt; i0 += _blockSize)
+  {
+    int n = npt - i0;
+    if (n > _blockSize)
+    {
+      n = _blockSize;
+    }
+    if (result._kind != Operand::REGISTER)
+    {
+      // constant or missing result
+      for (int i=0; i<n; ++i)
+      {
+	values[i] = result._value;
+	valid[i] = result._kind == Operand::CONSTANT;
+      }
+      out->setVals(i0, n, &values[0], valid);
+      continue;
+    }
+
+    for (size_t j=0; j<_program.size(); ++j)
+    {
+      const Instruction &inst = _program[j];
+      double *v = &values[inst._out*_blockSize];
+      bool *ok = valid + inst._out*_blockSize;
+      if (inst._op == LOAD)
+      {
+	if (inputs[inst._in0] == NULL)
+	{
+	  for (int i=0; i<n; ++i)
+	  {
+	    ok[i] = false;
+	  }
+	}
+	else
+	{
+	  inputs[inst._in0]->getVals(i0, n, v, ok);
+	}
+      }
+      else
+      {
+	_execute(inst, n, &values[0], valid, nDivZero);
+      }
+    }
+    out->setVals(i0, n, &values[result._reg*_blockSize],
+		 valid + result._reg*_blockSize);
+  }
+  delete [] valid;
+
+  if (nDivZero > 0)
+  {
+    LOG(ERROR) << "divide by zero at " << nDivZero << " points";
+  }
+  return true;
+}
+
+//------------------------------------------------------------------
+string MathProgram::sprint(void) const
+{
+  string ret;
+  char buf[1000];
+  for (size_t j=0; j<_program.size(); ++j)
+  {
+    const Instruction &inst = _program[j];
+    string args;
+    if (inst._op == LOAD)
+    {
+      args = _variables[inst._in0];
+    }
+    else
+    {
+      int ins[2] = {inst._in0, inst._in1};
+      int nin = inst._op == ADD || inst._op == SUB || inst._op == MULT ||
+	inst._op == DIV || inst._op == POW ? 2 : 1;
+      for (int k=0; k<nin; ++k)
+      {
+	const Operand &o = _operands[ins[k]];
+	if (o._kind == Operand::REGISTER)
+	{
+	  sprintf(buf, " r%d", o._reg);
+	}
+	else
+	{
+	  sprintf(buf, " %lf", o._value);
+	}
+	args += buf;
+      }
+    }
+    const char *names[] = {"load", "add", "sub", "mult", "div", "pow",
+			   "abs", "sqrt", "log10", "exp"};
+    sprintf(buf, "r%d = %s %s\n", inst._out, names[inst._op], args.c_str());
+    ret += buf;
+  }
+  if (_result >= 0)
+  {
+    const Operand &o = _operands[_result];
+    if (o._kind == Operand::REGISTER)
+    {
+      sprintf(buf, "%s = r%d\n", _output.c_str(), o._reg);
+    }
+    else if (o._kind == Operand::CONSTANT)
+    {
+      sprintf(buf, "%s = %lf\n", _output.c_str(), o._value);
+    }
+    else
+    {
+      sprintf(buf, "%s = missing\n", _output.c_str());
+    }
+    ret += buf;
+  }
+  return ret;
+}
+
+//------------------------------------------------------------------
+int MathProgram::load(const std::string &name)
+{
+  int var = -1;
+  for (size_t i=0; i<_variables.size(); ++i)
+  {
+    if (_variables[i] == name)
+    {
+      var = (int)i;
+      break;
+    }
+  }
+  if (var < 0)
+  {
+    var = (int)_variables.size();
+    _variables.push_back(name);
+  }
+
+  // load each variable once only
+  for (size_t j=0; j<_program.size(); ++j)
+  {
+    if (_program[j]._op == LOAD && _program[j]._in0 == var)
+    {
+      for (size_t k=0; k<_operands.size(); ++k)
+      {
+	if (_operands[k]._kind == Operand::REGISTER &&
+	    _operands[k]._reg == _program[j]._out)
+	{
+	  return (int)k;
+	}
+      }
+    }
+  }
+  int r = _register();
+  _program.push_back(Instruction(LOAD, r, var, -1));
+  _operands.push_back(Operand(Operand::REGISTER, r, 0.0));
+  return (int)_operands.size() - 1;
+}
+
+//------------------------------------------------------------------
+int MathProgram::constant(double v)
+{
+  _operands.push_back(Operand(Operand::CONSTANT, -1, v));
+  return (int)_operands.size() - 1;
+}
+
+//------------------------------------------------------------------
+int MathProgram::missing(void)
+{
+  _operands.push_back(Operand(Operand::MISSING, -1, 0.0));
+  return (int)_operands.size() - 1;
+}
+
+//------------------------------------------------------------------
+int MathProgram::binary(ProcessingNode::Operator_t op, int a, int b)
+{
+  Opcode_t code;
+  switch (op)
+  {
+  case ProcessingNode::ADD:
+    code = ADD;
+    break;
+  case ProcessingNode::SUB:
+    code = SUB;
+    break;
+  case ProcessingNode::MULT:
+    code = MULT;
+    break;
+  case ProcessingNode::DIV:
+    code = DIV;
+    break;
+  case ProcessingNode::POW:
+    code = POW;
+    break;
+  default:
+    return -1;
+  }
+
+  Operand oa = _operands[a];
+  Operand ob = _operands[b];
+  if (oa._kind == Operand::MISSING || ob._kind == Operand::MISSING)
+  {
+    return missing();
+  }
+  if (oa._kind == Operand::CONSTANT && ob._kind == Operand::CONSTANT)
+  {
+    double v;
+    switch (code)
+    {
+    case ADD:
+      v = oa._value + ob._value;
+      break;
+    case SUB:
+      v = oa._value - ob._value;
+      break;
+    case MULT:
+      v = oa._value*ob._value;
+      break;
+    case DIV:
+      if (ob._value == 0)
+      {
+	return missing();
+      }
+      v = oa._value/ob._value;
+      break;
+    case POW:
+    default:
+      v = pow(oa._value, ob._value);
+      break;
+    }
+    return constant(v);
+  }
+
+  int r = _register();
+  _program.push_back(Instruction(code, r, a, b));
+  _operands.push_back(Operand(Operand::REGISTER, r, 0.0));
+  return (int)_operands.size() - 1;
+}
+
+//------------------------------------------------------------------
+int MathProgram::unary(ProcessingNode::UnaryOperator_t op, int a)
+{
+  Opcode_t code;
+  switch (op)
+  {
+  case ProcessingNode::ABS:
+    code = ABS;
+    break;
+  case ProcessingNode::SQRT:
+    code = SQRT;
+    break;
+  case ProcessingNode::LOG10:
+    code = LOG10;
+    break;
+  case ProcessingNode::EXP:
+    code = EXP;
+    break;
+  default:
+    return -1;
+  }
+
+  Operand oa = _operands[a];
+  if (oa._kind == Operand::MISSING)
+  {
+    return missing();
+  }
+  if (oa._kind == Operand::CONSTANT)
+  {
+    double v;
+    switch (code)
+    {
+    case ABS:
+      v = fabs(oa._value);
+      break;
+    case SQRT:
+      v = sqrt(oa._value);
+      break;
+    case LOG10:
+      v = log10(oa._value);
+      break;
+    case EXP:
+    default:
+      v = exp(oa._value);
+      break;
+    }
+    return constant(v);
+  }
+
+  int r = _register();
+  _program.push_back(Instruction(code, r, a, -1));
+  _operands.push_back(Operand(Operand::REGISTER, r, 0.0));
+  return (int)_operands.size() - 1;
+}
+
+//------------------------------------------------------------------
+void MathProgram::setOutput(const std::string &name, int a)
+{
+  _output = name;
+  _result = a;
+}
+
+//------------------------------------------------------------------
+int MathProgram::_register(void)
+{
+  return _nreg++;
+}
+
+//------------------------------------------------------------------
+void MathProgram::_execute(const Instruction &inst, int n, double *values,
+			   bool *valid, int &nDivZero) const
+{
+  double *v = values + inst._out*_blockSize;
+  bool *ok = valid + inst._out*_blockSize;
+
+  const Operand &oa = _operands[inst._in0];
+  const double *a = NULL;
+  const bool *aok = NULL;
+  if (oa._kind == Operand::REGISTER)
+  {
+    a = values + oa._reg*_blockSize;
+    aok = valid + oa._reg*_blockSize;
+  }
+
+  const double *b = NULL;
+  const bool *bok = NULL;
+  double bc = 0.0;
+  if (inst._in1 >= 0)
+  {
+    const Operand &ob = _operands[inst._in1];
+    bc = ob._value;
+    if (ob._kind == Operand::REGISTER)
+    {
+      b = values + ob._reg*_blockSize;
+      bok = valid + ob._reg*_blockSize;
+    }
+  }
+
+  switch (inst._op)
+  {
+  case ADD:
+    _binaryLoop<_MathAdd>(n, a, aok, oa._value, b, bok, bc, v, ok);
+    break;
+  case SUB:
+    _binaryLoop<_MathSub>(n, a, aok, oa._value, b, bok, bc, v, ok);
+    break;
+  case MULT:
+    _binaryLoop<_MathMult>(n, a, aok, oa._value, b, bok, bc, v, ok);
+    break;
+  case POW:
+    _binaryLoop<_MathPow>(n, a, aok, oa._value, b, bok, bc, v, ok);
+    break;
+  case DIV:
+    _divideLoop(n, a, aok, oa._value, b, bok, bc, v, ok, nDivZero);
+    break;
+  case ABS:
+    for (int i=0; i<n; ++i)
+    {
+      v[i] = fabs(a[i]);
+      ok[i] = aok[i];
+    }
+    break;
+  case SQRT:
+    for (int i=0; i<n; ++i)
+    {
+      v[i] = sqrt(a[i]);
+      ok[i] = aok[i];
+    }
+    break;
+  case LOG10:
+    for (int i=0; i<n; ++i)
+    {
+      v[i] = log10(a[i]);
+      ok[i] = aok[i];
+    }
+    break;
+  case EXP:
+    for (int i=0; i<n; ++i)
+    {
+      v[i] = exp(a[i]);
+      ok[i] = aok[i];
+    }
+    break;
+  case LOAD:
+  default:
+    break;
+  }
+}
@@ -710,6 +710,12 @@ bool ProcessingNode::compute(const MathData *data, int ipt, double &v) const
   return _content->compute(data, ipt, v);
 }
 
+//-------------------------------------------------------------------
+bool ProcessingNode::compile(MathProgram &program, int &operand) const
+{
+  return _content->compile(program, operand);
+}
+
 //-------------------------------------------------------------------
 void ProcessingNode::outputFields(std::vector<std::string> &names) const
 {
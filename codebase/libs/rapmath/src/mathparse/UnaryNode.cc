@@ -2,6 +2,7 @@
  * @file UnaryNode.cc
  */
 #include <rapmath/UnaryNode.hh>
+#include <rapmath/MathProgram.hh>
 #include <rapmath/VolumeData.hh>
 #include <toolsa/LogStream.hh>
 #include <cmath>
@@ -138,6 +139,22 @@ bool UnaryNode::compute(const MathData *inputs, int ipt, double &v) const
   }
 }
 
+//-------------------------------------------------------------------
+bool UnaryNode::compile(MathProgram &program, int &operand) const
+{
+  if (!_userUopKey.empty() || _value.size() != 1)
+  {
+    return false;
+  }
+  int a;
+  if (!_value[0]->compile(program, a))
+  {
+    return false;
+  }
+  operand = program.unary(_uop, a);
+  return operand >= 0;
+}
+
 //-------------------------------------------------------------------
 void UnaryNode::outputFields(std::vector<std::string> &names) const
 {
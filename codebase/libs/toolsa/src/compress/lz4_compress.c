@@ -0,0 +1,292 @@
+/* *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* */
+/* ** Copyright UCAR (c) 1990 - 2016                                         */
+/* ** University Corporation for Atmospheric Research (UCAR)                 */
+/* ** National Center for Atmospheric Research (NCAR)                        */
+/* ** Boulder, Colorado, USA                                                 */
+/* ** BSD licence applies - redistribution and use in source and binary      */
+/* ** forms, with or without modification, are permitted provided that       */
+/* ** the following conditions are met:                                      */
+/* ** 1) If the software is modified to produce derivative works,            */
+/* ** such modified software should be clearly marked, so as not             */
+/* ** to confuse it with the version available from UCAR.                    */
+/* ** 2) Redistributions of source code must retain the above copyright      */
+/* ** notice, this list of conditions and the following disclaimer.          */
+/* ** 3) Redistributions in binary form must reproduce the above copyright   */
+/* ** notice, this list of conditions and the following disclaimer in the    */
+/* ** documentation and/or other materials provided with the distribution.   */
+/* ** 4) Neither the name of UCAR nor the names of its contributors,         */
+/* ** if any, may be used to endorse or promote products derived from        */
+/* ** this software without specific prior written permission.               */
+/* ** DISCLAIMER: THIS SOFTWARE IS PROVIDED "AS IS" AND WITHOUT ANY EXPRESS  */
+/* ** OR IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED      */
+/* ** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.    */
+/* *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* */
+/**********************************************************************
+ * lz4_compress.c
+ *
+ * Compression utilities using LZ4 compression.
+ *
+ * LZ4 compresses less than gzip or zstd, but is very fast in both
+ * directions. Suitable for real-time hops where CPU is the bottleneck.
+ *
+ * Requires liblz4. Compile with -DHAVE_LZ4 and link with -llz4
+ * to enable. Otherwise the routines in this file fail, and
+ * ta_compress() falls back to GZIP.
+ *
+ **********************************************************************/
+
+#include <toolsa/compress.h>
+#include <toolsa/umisc.h>
+#include <dataport/bigend.h>
+#ifdef HAVE_LZ4
+#include <lz4.h>
+#endif
+
+/* #define DEBUG_PRINT */
+
+/**********************************************************************
+ * lz4_available()
+ *
+ * Returns TRUE if lz4 support is compiled in, FALSE otherwise.
+ *
+ **********************************************************************/
+
+int lz4_available(void)
+
+{
+#ifdef HAVE_LZ4
+  return TRUE;
+#else
+  return FALSE;
+#endif
+}
+
+/**********************************************************************
+ * lz4_compress()
+ *
+ * In the compressed data, the first 24 bytes are a header as follows:
+ *
+ *   (ui32) Magic cookie - LZ4_COMPRESSED or LZ4_NOT_COMPRESSED
+ *   (ui32) nbytes_uncompressed
+ *   (ui32) nbytes_compressed - including this header
+ *   (ui32) nbytes_coded - (nbytes_compressed - sizeof header)
+ *   (ui32) spare
+ *   (ui32) spare
+ *
+ * The header is in BE byte order.
+ *
+ * The compressed data follows the header, as an LZ4 block.
+ *
+ * The memory for the encoded buffer is allocated by this routine,
+ * and passed back to the caller.
+ * This should be freed by the calling routine using ta_compress_free();
+ *
+ * The length of the compressed data buffer (*nbytes_compressed_p) is set.
+ *
+ * Returns pointer to the encoded buffer on success, NULL on failure.
+ *
+ **********************************************************************/
+
+void *lz4_compress(const void *uncompressed_buffer,
+		   unsigned int nbytes_uncompressed,
+		   unsigned int *nbytes_compressed_p)
+     
+{
+
+#ifdef HAVE_LZ4
+
+  int out_len;
+  int nbytes_bound;
+  unsigned int nbytes_buffer;
+  char *comp_buf;
+  char *out_buf;
+  compress_buf_hdr_t *hdr;
+
+  /*
+   * LZ4 blocks are limited to LZ4_MAX_INPUT_SIZE
+   */
+
+  if (nbytes_uncompressed > LZ4_MAX_INPUT_SIZE) {
+    return NULL;
+  }
+  
+  /*
+   * allocate for the worst case
+   */
+  
+  nbytes_bound = LZ4_compressBound((int) nbytes_uncompressed);
+  comp_buf = (char *) umalloc_min_1 (sizeof(compress_buf_hdr_t) +
+                                     nbytes_bound);
+  
+  /*
+   * compress with LZ4
+   */
+  
+  out_len = LZ4_compress_default((const char *) uncompressed_buffer,
+                                 comp_buf + sizeof(compress_buf_hdr_t),
+                                 (int) nbytes_uncompressed,
+                                 nbytes_bound);
+
+  if (out_len <= 0 || (unsigned int) out_len >= nbytes_uncompressed) {
+    
+#ifdef DEBUG_PRINT
+    if (out_len <= 0) {
+      fprintf(stderr, "LZ4 compress failed\n");
+    } else {
+      fprintf(stderr, "LZ4 failed to reduce size\n");
+      fprintf(stderr, "  Uncompressed size: %d\n", nbytes_uncompressed);
+      fprintf(stderr, "  Compressed size: %d\n", out_len);
+    }
+#endif
+
+    /*
+     * compression failed or data not compressible
+     */
+
+    ufree(comp_buf);
+    return NULL;
+    
+  }
+  
+  /*
+   * compression worked - truncate buffer
+   */
+  
+  nbytes_buffer = sizeof(compress_buf_hdr_t) + out_len;
+  out_buf = urealloc(comp_buf, nbytes_buffer);
+
+#ifdef DEBUG_PRINT
+  fprintf(stderr, "LZ4 compress succeeded\n");
+  fprintf(stderr, "  Uncompressed size: %d\n", nbytes_uncompressed);
+  fprintf(stderr, "  Compressed size: %d\n", out_len);
+#endif
+
+  /*
+   * load hdr and swap
+   */
+
+  hdr = (compress_buf_hdr_t *) out_buf;
+  MEM_zero(*hdr);
+  hdr->magic_cookie = LZ4_COMPRESSED;
+  hdr->nbytes_uncompressed = nbytes_uncompressed;
+  hdr->nbytes_compressed = nbytes_buffer;
+  hdr->nbytes_coded = out_len;
+  compress_buf_hdr_to_BE(hdr);
+  
+  if (nbytes_compressed_p != NULL) {
+    *nbytes_compressed_p = nbytes_buffer;
+  }
+  
+  return out_buf;
+
+#else
+
+  (void) uncompressed_buffer;
+  (void) nbytes_uncompressed;
+  (void) nbytes_compressed_p;
+  return NULL;
+
+#endif
+
+}
+
+/**********************************************************************
+ * lz4_decompress()
+ *
+ * Perform LZ4 decompression on buffer created using lz4_compress();
+ *
+ * The memory for the uncompressed data buffer is allocated by this routine.
+ * This should be freed by the calling routine using ta_compress_free();
+ *
+ * On success, returns pointer to the uncompressed data buffer.
+ * Also, *nbytes_uncompressed_p is set.
+ *
+ * On failure, returns NULL.
+ *
+ **********************************************************************/
+
+void *lz4_decompress(const void *compressed_buffer,
+		     unsigned int *nbytes_uncompressed_p)
+     
+{
+
+  char *uncompressed_data;
+  char *compressed_data;
+  compress_buf_hdr_t hdr;
+
+  if (compressed_buffer == NULL) {
+    *nbytes_uncompressed_p = 0;
+    return (NULL);
+  }
+
+  /*
+   * decode header
+   */
+  
+  memcpy(&hdr, compressed_buffer, sizeof(compress_buf_hdr_t));
+  compress_buf_hdr_from_BE(&hdr);
+
+  if (hdr.magic_cookie != LZ4_COMPRESSED &&
+      hdr.magic_cookie != LZ4_NOT_COMPRESSED) {
+    *nbytes_uncompressed_p = 0;
+    return (NULL);
+  }
+
+  compressed_data = (char *) compressed_buffer + sizeof(compress_buf_hdr_t);
+
+  if (hdr.magic_cookie == LZ4_NOT_COMPRESSED) {
+
+    uncompressed_data = (char *) umalloc_min_1 (hdr.nbytes_uncompressed);
+    *nbytes_uncompressed_p = hdr.nbytes_uncompressed;
+    memcpy(uncompressed_data, compressed_data, hdr.nbytes_uncompressed);
+    return (uncompressed_data);
+
+  }
+
+#ifdef HAVE_LZ4
+
+  {
+
+    int out_len;
+
+    if (hdr.nbytes_uncompressed > LZ4_MAX_INPUT_SIZE ||
+        hdr.nbytes_coded > (ui32) LZ4_compressBound(LZ4_MAX_INPUT_SIZE)) {
+      *nbytes_uncompressed_p = 0;
+      return (NULL);
+    }
+
+    uncompressed_data = (char *) umalloc_min_1 (hdr.nbytes_uncompressed);
+    out_len = LZ4_decompress_safe(compressed_data,
+                                  uncompressed_data,
+                                  (int) hdr.nbytes_coded,
+                                  (int) hdr.nbytes_uncompressed);
+    
+    if (out_len >= 0 && (ui32) out_len == hdr.nbytes_uncompressed) {
+#ifdef DEBUG_PRINT
+      fprintf(stderr, "LZ4 decompress: success\n");
+      fprintf(stderr, "  compressed_size: %d\n", hdr.nbytes_coded);
+      fprintf(stderr, "  uncompressed_size: %d\n", out_len);
+#endif
+      *nbytes_uncompressed_p = hdr.nbytes_uncompressed;
+      return(uncompressed_data);
+    } else {
+#ifdef DEBUG_PRINT
+      fprintf(stderr, "LZ4 decompress: failure\n");
+#endif
+      ufree(uncompressed_data);
+      *nbytes_uncompressed_p = 0;
+      return (NULL);
+    }
+
+  }
+
+#else
+
+  fprintf(stderr, "ERROR - lz4_decompress\n");
+  fprintf(stderr, "  lz4 support not compiled in, need HAVE_LZ4\n");
+  *nbytes_uncompressed_p = 0;
+  return (NULL);
+
+#endif
+
+}
@@ -60,7 +60,11 @@ static int _cookie_is_valid(ui32 magic_cookie)
       magic_cookie == _RLE_COMPRESSED ||
       magic_cookie == __RLE_COMPRESSED ||
       magic_cookie == ZLIB_COMPRESSED ||
-      magic_cookie == ZLIB_NOT_COMPRESSED) {
+      magic_cookie == ZLIB_NOT_COMPRESSED ||
+      magic_cookie == ZSTD_COMPRESSED ||
+      magic_cookie == ZSTD_NOT_COMPRESSED ||
+      magic_cookie == LZ4_COMPRESSED ||
+      magic_cookie == LZ4_NOT_COMPRESSED) {
     return TRUE;
   } else {
     return FALSE;
@@ -285,6 +289,16 @@ ta_compression_method_t ta_compression_method(const void *compressed_buffer,
     return TA_COMPRESSION_BZIP;
   }
 
+  if (magic_cookie == ZSTD_COMPRESSED ||
+      magic_cookie == ZSTD_NOT_COMPRESSED) {
+    return TA_COMPRESSION_ZSTD;
+  }
+
+  if (magic_cookie == LZ4_COMPRESSED ||
+      magic_cookie == LZ4_NOT_COMPRESSED) {
+    return TA_COMPRESSION_LZ4;
+  }
+
   return TA_COMPRESSION_NA;
 
 }
@@ -355,6 +369,22 @@ extern void ta_compression_debug(const void *compressed_buffer){
     fprintf(stderr, "Compression type : ZLIB_NOT_COMPRESSED\n");
     break;
 
+  case ZSTD_COMPRESSED :
+    fprintf(stderr, "Compression type : ZSTD_COMPRESSED\n");
+    break;
+
+  case ZSTD_NOT_COMPRESSED :
+    fprintf(stderr, "Compression type : ZSTD_NOT_COMPRESSED\n");
+    break;
+
+  case LZ4_COMPRESSED :
+    fprintf(stderr, "Compression type : LZ4_COMPRESSED\n");
+    break;
+
+  case LZ4_NOT_COMPRESSED :
+    fprintf(stderr, "Compression type : LZ4_NOT_COMPRESSED\n");
+    break;
+
   default :
     fprintf(stderr, "Compression type : UNKOWN\n");
     return;
@@ -479,13 +509,45 @@ int ta_gzip_buffer(const void *compressed_buffer)
 
 }
 
+/**********************************************************************
+ * ta_compression_available() - tests whether a compression method
+ * is available in this build.
+ *
+ * Returns TRUE or FALSE
+ **********************************************************************/
+
+int ta_compression_available(ta_compression_method_t method)
+     
+{
+
+  switch (method) {
+    case TA_COMPRESSION_ZSTD:
+      return zstd_available();
+    case TA_COMPRESSION_LZ4:
+      return lz4_available();
+    case TA_COMPRESSION_NA:
+    case TA_COMPRESSION_NONE:
+    case TA_COMPRESSION_RLE:
+    case TA_COMPRESSION_LZO:
+    case TA_COMPRESSION_ZLIB:
+    case TA_COMPRESSION_BZIP:
+    case TA_COMPRESSION_GZIP:
+      return TRUE;
+  }
+
+  return FALSE;
+
+}
+
 /**********************************************************************
  * ta_compress()
  *
  * Compress according to the compression method.
  *
  * For compressing, we have deprecated all methods
- * except gzip and bzip2.
+ * except gzip, bzip2, zstd and lz4. zstd and lz4 are only
+ * used for 32-bit buffers, and only if compiled in - otherwise
+ * gzip is used.
  *
  * The memory for the encoded buffer is allocated by this routine,
  * and passed back to the caller.
@@ -509,6 +571,9 @@ void *ta_compress(ta_compression_method_t method,
   /* check whether we need to use 64-bit headers */
   
   int use64bit = FALSE;
+  if (!ta_compression_available(method)) {
+    method = TA_COMPRESSION_GZIP;
+  }
   if (nbytes_uncompressed >= UI32_MAX) {
     use64bit = TRUE;
   }
@@ -619,6 +684,44 @@ void *ta_compress(ta_compression_method_t method,
       *nbytes_compressed_p = nbytes_compressed_32;
       return buf;
       
+    } else if (method == TA_COMPRESSION_ZSTD) {
+      
+      /* zstd compression */
+
+      ui32 nbytes_compressed_32;
+      void *buf = zstd_compress(uncompressed_buffer,
+                                (ui32) nbytes_uncompressed,
+                                &nbytes_compressed_32);
+
+      if (buf == NULL) {
+        buf = _ta_no_compress(ZSTD_NOT_COMPRESSED,
+                              uncompressed_buffer,
+                              nbytes_uncompressed,
+                              &nbytes_compressed_32);
+      }
+      
+      *nbytes_compressed_p = nbytes_compressed_32;
+      return buf;
+      
+    } else if (method == TA_COMPRESSION_LZ4) {
+      
+      /* lz4 compression */
+
+      ui32 nbytes_compressed_32;
+      void *buf = lz4_compress(uncompressed_buffer,
+                               (ui32) nbytes_uncompressed,
+                               &nbytes_compressed_32);
+
+      if (buf == NULL) {
+        buf = _ta_no_compress(LZ4_NOT_COMPRESSED,
+                              uncompressed_buffer,
+                              nbytes_uncompressed,
+                              &nbytes_compressed_32);
+      }
+      
+      *nbytes_compressed_p = nbytes_compressed_32;
+      return buf;
+      
     } else {
 
       /* gzip compression */
@@ -691,7 +794,9 @@ void *ta_decompress(const void *compressed_buffer,
       magic_cookie == LZO_NOT_COMPRESSED ||
       magic_cookie == BZIP_NOT_COMPRESSED ||
       magic_cookie == GZIP_NOT_COMPRESSED ||
-      magic_cookie == ZLIB_NOT_COMPRESSED) {
+      magic_cookie == ZLIB_NOT_COMPRESSED ||
+      magic_cookie == ZSTD_NOT_COMPRESSED ||
+      magic_cookie == LZ4_NOT_COMPRESSED) {
     
     /* buf has toolsa header, but is not compressed */
     /* strip off header, return data */
@@ -754,6 +859,24 @@ void *ta_decompress(const void *compressed_buffer,
       return decomp;
     }
 
+  } else if (magic_cookie == ZSTD_COMPRESSED) {
+    
+    /* only 32-bit compression for ZSTD */
+
+    ui32 nbytes_uncompressed;
+    void *decomp = zstd_decompress(compressed_buffer, &nbytes_uncompressed);
+    *nbytes_uncompressed_p = nbytes_uncompressed;
+    return decomp;
+    
+  } else if (magic_cookie == LZ4_COMPRESSED) {
+    
+    /* only 32-bit compression for LZ4 */
+
+    ui32 nbytes_uncompressed;
+    void *decomp = lz4_decompress(compressed_buffer, &nbytes_uncompressed);
+    *nbytes_uncompressed_p = nbytes_uncompressed;
+    return decomp;
+    
   } else if (magic_cookie == ZLIB_COMPRESSED) {
     
     /* only 32-bit compression for ZLIB */
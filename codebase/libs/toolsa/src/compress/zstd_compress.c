@@ -0,0 +1,460 @@
+/* *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* */
+/* ** Copyright UCAR (c) 1990 - 2016                                         */
+/* ** University Corporation for Atmospheric Research (UCAR)                 */
+/* ** National Center for Atmospheric Research (NCAR)                        */
+/* ** Boulder, Colorado, USA                                                 */
+/* ** BSD licence applies - redistribution and use in source and binary      */
+/* ** forms, with or without modification, are permitted provided that       */
+/* ** the following conditions are met:                                      */
+/* ** 1) If the software is modified to produce derivative works,            */
+/* ** such modified software should be clearly marked, so as not             */
+/* ** to confuse it with the version available from UCAR.                    */
+/* ** 2) Redistributions of source code must retain the above copyright      */
+/* ** notice, this list of conditions and the following disclaimer.          */
+/* ** 3) Redistributions in binary form must reproduce the above copyright   */
+/* ** notice, this list of conditions and the following disclaimer in the    */
+/* ** documentation and/or other materials provided with the distribution.   */
+/* ** 4) Neither the name of UCAR nor the names of its contributors,         */
+/* ** if any, may be used to endorse or promote products derived from        */
+/* ** this software without specific prior written permission.               */
+/* ** DISCLAIMER: THIS SOFTWARE IS PROVIDED "AS IS" AND WITHOUT ANY EXPRESS  */
+/* ** OR IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED      */
+/* ** WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.    */
+/* *=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=*=* */
+/**********************************************************************
+ * zstd_compress.c
+ *
+ * Compression utilities using Zstandard (zstd) compression.
+ *
+ * zstd gives compression ratios similar to gzip at several times the
+ * speed. An optional trained dictionary improves the ratio on small
+ * buffers with similar content, such as SPDB chunks or FMQ messages.
+ * Dictionaries are trained with the zstd command line tool:
+ *   zstd --train <sample files> -o dictionary
+ *
+ * Requires libzstd. Compile with -DHAVE_ZSTD and link with -lzstd
+ * to enable. Otherwise the routines in this file fail, and
+ * ta_compress() falls back to GZIP.
+ *
+ **********************************************************************/
+
+#include <toolsa/compress.h>
+#include <toolsa/umisc.h>
+#include <dataport/bigend.h>
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+/* #define DEBUG_PRINT */
+
+#ifdef HAVE_ZSTD
+
+/*
+ * compression level and dictionary - process-wide settings
+ */
+
+static int _zstdLevel = TA_ZSTD_DEFAULT_LEVEL;
+static void *_zstdDict = NULL;
+static ui64 _zstdDictLen = 0;
+static ZSTD_CDict *_zstdCDict = NULL;
+static ZSTD_DDict *_zstdDDict = NULL;
+
+#endif
+
+/**********************************************************************
+ * zstd_available()
+ *
+ * Returns TRUE if zstd support is compiled in, FALSE otherwise.
+ *
+ **********************************************************************/
+
+int zstd_available(void)
+
+{
+#ifdef HAVE_ZSTD
+  return TRUE;
+#else
+  return FALSE;
+#endif
+}
+
+/**********************************************************************
+ * ta_compress_set_zstd_level()
+ *
+ * Set the zstd compression level, 1 (fastest) to 19 (best ratio).
+ * Negative levels trade ratio for more speed.
+ * The default is TA_ZSTD_DEFAULT_LEVEL.
+ *
+ * This is a process-wide setting. Set it at startup, not while
+ * other threads are compressing.
+ *
+ **********************************************************************/
+
+void ta_compress_set_zstd_level(int level)
+
+{
+#ifdef HAVE_ZSTD
+  if (level < ZSTD_minCLevel()) {
+    level = ZSTD_minCLevel();
+  }
+  if (level > ZSTD_maxCLevel()) {
+    level = ZSTD_maxCLevel();
+  }
+  _zstdLevel = level;
+  if (_zstdCDict != NULL) {
+    /* the level is part of the digested dictionary */
+    ZSTD_freeCDict(_zstdCDict);
+    _zstdCDict = ZSTD_createCDict(_zstdDict, _zstdDictLen, _zstdLevel);
+  }
+#else
+  (void) level;
+#endif
+}
+
+/**********************************************************************
+ * ta_compress_set_zstd_dict()
+ *
+ * Load a trained zstd dictionary, used for both compression and
+ * decompression. The dictionary is copied.
+ *
+ * Buffers compressed with a dictionary record the dictionary ID, and
+ * can only be decompressed by a process which has loaded the same
+ * dictionary. Buffers compressed without a dictionary can always be
+ * decompressed.
+ *
+ * Pass NULL to unload the dictionary.
+ *
+ * This is a process-wide setting. Set it at startup, not while
+ * other threads are compressing.
+ *
+ * Returns 0 on success, -1 on failure.
+ *
+ **********************************************************************/
+
+int ta_compress_set_zstd_dict(const void *dict_buffer, ui64 dict_len)
+
+{
+
+#ifdef HAVE_ZSTD
+
+  if (_zstdCDict != NULL) {
+    ZSTD_freeCDict(_zstdCDict);
+    _zstdCDict = NULL;
+  }
+  if (_zstdDDict != NULL) {
+    ZSTD_freeDDict(_zstdDDict);
+    _zstdDDict = NULL;
+  }
+  if (_zstdDict != NULL) {
+    ufree(_zstdDict);
+    _zstdDict = NULL;
+    _zstdDictLen = 0;
+  }
+
+  if (dict_buffer == NULL || dict_len == 0) {
+    return 0;
+  }
+
+  _zstdDict = umalloc(dict_len);
+  memcpy(_zstdDict, dict_buffer, dict_len);
+  _zstdDictLen = dict_len;
+
+  _zstdCDict = ZSTD_createCDict(_zstdDict, _zstdDictLen, _zstdLevel);
+  _zstdDDict = ZSTD_createDDict(_zstdDict, _zstdDictLen);
+  if (_zstdCDict == NULL || _zstdDDict == NULL) {
+    fprintf(stderr, "ERROR - ta_compress_set_zstd_dict\n");
+    fprintf(stderr, "  Cannot load dictionary, len: %ld\n",
+            (long) dict_len);
+    ta_compress_set_zstd_dict(NULL, 0);
+    return -1;
+  }
+
+  return 0;
+
+#else
+
+  (void) dict_buffer;
+  (void) dict_len;
+  fprintf(stderr, "ERROR - ta_compress_set_zstd_dict\n");
+  fprintf(stderr, "  zstd support not compiled in, need HAVE_ZSTD\n");
+  return -1;
+
+#endif
+
+}
+
+/**********************************************************************
+ * zstd_compress()
+ *
+ * In the compressed data, the first 24 bytes are a header as follows:
+ *
+ *   (ui32) Magic cookie - ZSTD_COMPRESSED or ZSTD_NOT_COMPRESSED
+ *   (ui32) nbytes_uncompressed
+ *   (ui32) nbytes_compressed - including this header
+ *   (ui32) nbytes_coded - (nbytes_compressed - sizeof header)
+ *   (ui32) spare
+ *   (ui32) spare
+ *
+ * The header is in BE byte order.
+ *
+ * The compressed data follows the header, as a single zstd frame.
+ *
+ * The memory for the encoded buffer is allocated by this routine,
+ * and passed back to the caller.
+ * This should be freed by the calling routine using ta_compress_free();
+ *
+ * The length of the compressed data buffer (*nbytes_compressed_p) is set.
+ *
+ * Returns pointer to the encoded buffer on success, NULL on failure.
+ *
+ **********************************************************************/
+
+void *zstd_compress(const void *uncompressed_buffer,
+		    unsigned int nbytes_uncompressed,
+		    unsigned int *nbytes_compressed_p)
+     
+{
+
+#ifdef HAVE_ZSTD
+
+  size_t out_len;
+  size_t nbytes_alloc;
+  unsigned int nbytes_buffer;
+  char *comp_buf;
+  char *out_buf;
+  compress_buf_hdr_t *hdr;
+  ZSTD_CCtx *cctx;
+  
+  /*
+   * allocate for the worst case
+   */
+  
+  nbytes_alloc = (sizeof(compress_buf_hdr_t) +
+                  ZSTD_compressBound(nbytes_uncompressed));
+  comp_buf = (char *) umalloc_min_1 (nbytes_alloc);
+  
+  /*
+   * compress with ZSTD
+   */
+
+  cctx = ZSTD_createCCtx();
+  if (cctx == NULL) {
+    ufree(comp_buf);
+    return NULL;
+  }
+  
+  if (_zstdCDict != NULL) {
+    out_len = ZSTD_compress_usingCDict(cctx,
+                                       comp_buf + sizeof(compress_buf_hdr_t),
+                                       nbytes_alloc - sizeof(compress_buf_hdr_t),
+                                       uncompressed_buffer,
+                                       nbytes_uncompressed,
+                                       _zstdCDict);
+  } else {
+    out_len = ZSTD_compressCCtx(cctx,
+                                comp_buf + sizeof(compress_buf_hdr_t),
+                                nbytes_alloc - sizeof(compress_buf_hdr_t),
+                                uncompressed_buffer,
+                                nbytes_uncompressed,
+                                _zstdLevel);
+  }
+  ZSTD_freeCCtx(cctx);
+
+  if (ZSTD_isError(out_len) || out_len >= nbytes_uncompressed) {
+    
+#ifdef DEBUG_PRINT
+    if (ZSTD_isError(out_len)) {
+      fprintf(stderr, "ZSTD compress failed: %s\n",
+              ZSTD_getErrorName(out_len));
+    } else {
+      fprintf(stderr, "ZSTD failed to reduce size\n");
+      fprintf(stderr, "  Uncompressed size: %d\n", nbytes_uncompressed);
+      fprintf(stderr, "  Compressed size: %d\n", (int) out_len);
+    }
+#endif
+
+    /*
+     * compression failed or data not compressible
+     */
+
+    ufree(comp_buf);
+    return NULL;
+    
+  }
+  
+  /*
+   * compression worked - truncate buffer
+   */
+  
+  nbytes_buffer = sizeof(compress_buf_hdr_t) + out_len;
+  out_buf = urealloc(comp_buf, nbytes_buffer);
+
+#ifdef DEBUG_PRINT
+  fprintf(stderr, "ZSTD compress succeeded\n");
+  fprintf(stderr, "  Uncompressed size: %d\n", nbytes_uncompressed);
+  fprintf(stderr, "  Compressed size: %d\n", (int) out_len);
+#endif
+
+  /*
+   * load hdr and swap
+   */
+
+  hdr = (compress_buf_hdr_t *) out_buf;
+  MEM_zero(*hdr);
+  hdr->magic_cookie = ZSTD_COMPRESSED;
+  hdr->nbytes_uncompressed = nbytes_uncompressed;
+  hdr->nbytes_compressed = nbytes_buffer;
+  hdr->nbytes_coded = out_len;
+  compress_buf_hdr_to_BE(hdr);
+  
+  if (nbytes_compressed_p != NULL) {
+    *nbytes_compressed_p = nbytes_buffer;
+  }
+  
+  return out_buf;
+
+#else
+
+  (void) uncompressed_buffer;
+  (void) nbytes_uncompressed;
+  (void) nbytes_compressed_p;
+  return NULL;
+
+#endif
+
+}
+
+/**********************************************************************
+ * zstd_decompress()
+ *
+ * Perform ZSTD decompression on buffer created using zstd_compress();
+ *
+ * The memory for the uncompressed data buffer is allocated by this routine.
+ * This should be freed by the calling routine using ta_compress_free();
+ *
+ * On success, returns pointer to the uncompressed data buffer.
+ * Also, *nbytes_uncompressed_p is set.
+ *
+ * On failure, returns NULL.
+ *
+ **********************************************************************/
+
+void *zstd_decompress(const void *compressed_buffer,
+		      unsigned int *nbytes_uncompressed_p)
+     
+{
+
+  char *uncompressed_data;
+  char *compressed_data;
+  compress_buf_hdr_t hdr;
+
+  if (compressed_buffer == NULL) {
+    *nbytes_uncompressed_p = 0;
+    return (NULL);
+  }
+
+  /*
+   * decode header
+   */
+  
+  memcpy(&hdr, compressed_buffer, sizeof(compress_buf_hdr_t));
+  compress_buf_hdr_from_BE(&hdr);
+
+  if (hdr.magic_cookie != ZSTD_COMPRESSED &&
+      hdr.magic_cookie != ZSTD_NOT_COMPRESSED) {
+    *nbytes_uncompressed_p = 0;
+    return (NULL);
+  }
+
+  compressed_data = (char *) compressed_buffer + sizeof(compress_buf_hdr_t);
+
+  if (hdr.magic_cookie == ZSTD_NOT_COMPRESSED) {
+
+    uncompressed_data = (char *) umalloc_min_1 (hdr.nbytes_uncompressed);
+    *nbytes_uncompressed_p = hdr.nbytes_uncompressed;
+    memcpy(uncompressed_data, compressed_data, hdr.nbytes_uncompressed);
+    return (uncompressed_data);
+
+  }
+
+#ifdef HAVE_ZSTD
+
+  {
+
+    size_t out_len;
+    unsigned int dict_id;
+    ZSTD_DCtx *dctx;
+
+    /*
+     * check the frame dictionary against ours
+     */
+
+    dict_id = ZSTD_getDictID_fromFrame(compressed_data, hdr.nbytes_coded);
+    if (dict_id != 0 &&
+        (_zstdDDict == NULL ||
+         ZSTD_getDictID_fromDDict(_zstdDDict) != dict_id)) {
+      fprintf(stderr, "ERROR - zstd_decompress\n");
+      fprintf(stderr, "  Buffer needs zstd dictionary ID: %u\n", dict_id);
+      fprintf(stderr, "  Load it with ta_compress_set_zstd_dict()\n");
+      *nbytes_uncompressed_p = 0;
+      return (NULL);
+    }
+
+    dctx = ZSTD_createDCtx();
+    if (dctx == NULL) {
+      *nbytes_uncompressed_p = 0;
+      return (NULL);
+    }
+
+    /*
+     * use the dictionary if loaded - frames compressed without one
+     * decode correctly with it, and raw content dictionaries do not
+     * set a dictionary ID in the frame
+     */
+
+    uncompressed_data = (char *) umalloc_min_1 (hdr.nbytes_uncompressed);
+    if (_zstdDDict != NULL) {
+      out_len = ZSTD_decompress_usingDDict(dctx,
+                                           uncompressed_data,
+                                           hdr.nbytes_uncompressed,
+                                           compressed_data,
+                                           hdr.nbytes_coded,
+                                           _zstdDDict);
+    } else {
+      out_len = ZSTD_decompressDCtx(dctx,
+                                    uncompressed_data,
+                                    hdr.nbytes_uncompressed,
+                                    compressed_data,
+                                    hdr.nbytes_coded);
+    }
+    ZSTD_freeDCtx(dctx);
+    
+    if (!ZSTD_isError(out_len) && out_len == hdr.nbytes_uncompressed) {
+#ifdef DEBUG_PRINT
+      fprintf(stderr, "ZSTD decompress: success\n");
+      fprintf(stderr, "  compressed_size: %d\n", hdr.nbytes_coded);
+      fprintf(stderr, "  uncompressed_size: %d\n", (int) out_len);
+#endif
+      *nbytes_uncompressed_p = hdr.nbytes_uncompressed;
+      return(uncompressed_data);
+    } else {
+#ifdef DEBUG_PRINT
+      fprintf(stderr, "ZSTD decompress: failure\n");
+#endif
+      ufree(uncompressed_data);
+      *nbytes_uncompressed_p = 0;
+      return (NULL);
+    }
+
+  }
+
+#else
+
+  fprintf(stderr, "ERROR - zstd_decompress\n");
+  fprintf(stderr, "  zstd support not compiled in, need HAVE_ZSTD\n");
+  *nbytes_uncompressed_p = 0;
+  return (NULL);
+
+#endif
+
+}
@@ -155,6 +155,11 @@ public:
   
   virtual void close();
 
+  ///////////////////////////////////////
+  // get the listening socket descriptor
+  //
+  int getProtoSd() const { return _protoSd; }
+
 protected:
 
   int _protoSd;         // prototype socket descriptor
@@ -137,6 +137,29 @@ public:
   //
   bool isOpen() const { return (_sd >= 0); }
 
+  //////////////////////////////
+  // get the socket descriptor
+  //
+  int getSd() const { return _sd; }
+
+  /////////////////////////////////////////////////////////
+  // releaseSd()
+  //
+  // Release the socket descriptor, leaving the connection open.
+  // The caller becomes responsible for closing it.
+  //
+  // Returns the descriptor, -1 if the socket is not open.
+  //
+  int releaseSd();
+
+  /////////////////////////////////////////////////////////
+  // attachSd()
+  //
+  // Attach an open socket descriptor, for example one previously
+  // obtained from releaseSd(). Closes the current one if open.
+  //
+  void attachSd(int sd);
+
   /////////////////////////////////////////////
   // readSelect()
   //
@@ -67,9 +67,17 @@ typedef enum {
   TA_COMPRESSION_LZO =   2,  /* Lempel-Ziv-Oberhaumer */
   TA_COMPRESSION_ZLIB =  3,  /* Lempel-Ziv */
   TA_COMPRESSION_BZIP =  4,  /* bzip2 */
-  TA_COMPRESSION_GZIP =  5   /* Lempel-Ziv in gzip format */
+  TA_COMPRESSION_GZIP =  5,  /* Lempel-Ziv in gzip format */
+  TA_COMPRESSION_ZSTD =  6,  /* Zstandard - needs HAVE_ZSTD */
+  TA_COMPRESSION_LZ4 =   7   /* LZ4 - needs HAVE_LZ4 */
 } ta_compression_method_t;
 
+/*
+ * default zstd compression level - see ta_compress_set_zstd_level()
+ */
+
+#define TA_ZSTD_DEFAULT_LEVEL 3
+
 /*
  * magic cookies for various compression states
  */
@@ -87,6 +95,10 @@ typedef enum {
 #define __RLE_COMPRESSED 0xfd0301fe /* used in some early mdv files */
 #define ZLIB_COMPRESSED 0xf5f5f5f5U
 #define ZLIB_NOT_COMPRESSED 0xf6f6f6f6U
+#define ZSTD_COMPRESSED 0xf9f9f9f9U
+#define ZSTD_NOT_COMPRESSED 0xfafafafaU
+#define LZ4_COMPRESSED 0xfbfbfbfbU
+#define LZ4_NOT_COMPRESSED 0xfcfcfcfcU
 
 /**********************************************************************
  * ta_is_compressed() - tests whether buffer is compressed using toolsa
@@ -155,6 +167,19 @@ extern void ta_compression_debug(const void *compressed_buffer);
  **********************************************************************/
 
 extern int ta_gzip_buffer(const void *compressed_buffer);
+
+/**********************************************************************
+ * ta_compression_available() - tests whether a compression method
+ * is available in this build.
+ *
+ * ZSTD and LZ4 depend on optional libraries, and are only available
+ * if compiled with HAVE_ZSTD and HAVE_LZ4 respectively. If not,
+ * ta_compress() uses GZIP instead.
+ *
+ * Returns TRUE or FALSE
+ **********************************************************************/
+
+extern int ta_compression_available(ta_compression_method_t method);
      
 /***********************
  * compression
@@ -270,6 +295,146 @@ extern void *lzo_decompress(const void *compressed_buffer,
      
 #endif
      
+/***************
+ * ZSTD routines
+ ***************/
+
+/**********************************************************************
+ * zstd_available()
+ *
+ * Returns TRUE if compiled with HAVE_ZSTD, FALSE otherwise.
+ **********************************************************************/
+
+extern int zstd_available(void);
+
+/**********************************************************************
+ * ta_compress_set_zstd_level()
+ *
+ * Set the zstd compression level, 1 (fastest) to 19 (best ratio).
+ * Default is TA_ZSTD_DEFAULT_LEVEL.
+ *
+ * Process-wide - set at startup, not while other threads compress.
+ **********************************************************************/
+
+extern void ta_compress_set_zstd_level(int level);
+
+/**********************************************************************
+ * ta_compress_set_zstd_dict()
+ *
+ * Load a trained zstd dictionary, for compression and decompression.
+ * Buffers compressed with a dictionary can only be decompressed by
+ * a process which has loaded the same dictionary.
+ * Pass NULL to unload.
+ *
+ * Process-wide - set at startup, not while other threads compress.
+ *
+ * Returns 0 on success, -1 on failure.
+ **********************************************************************/
+
+extern int ta_compress_set_zstd_dict(const void *dict_buffer,
+                                     ui64 dict_len);
+
+/**********************************************************************
+ * zstd_compress()
+ *
+ * In the compressed data, the first 24 bytes are a header as follows:
+ *
+ *   (ui32) Magic cookie - ZSTD_COMPRESSED or ZSTD_NOT_COMPRESSED
+ *   (ui32) nbytes_uncompressed
+ *   (ui32) nbytes_compressed - including this header
+ *   (ui32) nbytes_coded - (nbytes_compressed - sizeof header)
+ *   (ui32) spare
+ *   (ui32) spare
+ *
+ * The header is in BE byte order.
+ *
+ * The compressed data follows the header, as a single zstd frame.
+ *
+ * The memory for the encoded buffer is allocated by this routine,
+ * and passed back to the caller.
+ * This should be freed by the calling routine using ta_compress_free().
+ *
+ * The length of the compressed data buffer (*nbytes_compressed_p) is set.
+ *
+ * Returns pointer to the encoded buffer, NULL on failure or if
+ * the data is not compressible.
+ *
+ **********************************************************************/
+
+extern void *zstd_compress(const void *uncompressed_buffer,
+			   ui32 nbytes_uncompressed,
+			   ui32 *nbytes_compressed_p);
+
+/**********************************************************************
+ * zstd_decompress()
+ *
+ * Perform ZSTD decompression on buffer created using zstd_compress();
+ *
+ * The memory for the uncompressed data buffer is allocated by this routine.
+ * This should be freed by the calling routine using ta_compress_free().
+ *
+ * On success, returns pointer to the uncompressed data buffer.
+ * Also, *nbytes_uncompressed_p is set.
+ *
+ * On failure, returns NULL.
+ *
+ **********************************************************************/
+
+extern void *zstd_decompress(const void *compressed_buffer,
+			     ui32 *nbytes_uncompressed_p);
+
+/***************
+ * LZ4 routines
+ ***************/
+
+/**********************************************************************
+ * lz4_available()
+ *
+ * Returns TRUE if compiled with HAVE_LZ4, FALSE otherwise.
+ **********************************************************************/
+
+extern int lz4_available(void);
+
+/**********************************************************************
+ * lz4_compress()
+ *
+ * Header as for zstd_compress(), with magic cookie LZ4_COMPRESSED
+ * or LZ4_NOT_COMPRESSED. The compressed data follows the header,
+ * as a single LZ4 block.
+ *
+ * The memory for the encoded buffer is allocated by this routine,
+ * and passed back to the caller.
+ * This should be freed by the calling routine using ta_compress_free().
+ *
+ * The length of the compressed data buffer (*nbytes_compressed_p) is set.
+ *
+ * Returns pointer to the encoded buffer, NULL on failure or if
+ * the data is not compressible.
+ *
+ **********************************************************************/
+
+extern void *lz4_compress(const void *uncompressed_buffer,
+			  ui32 nbytes_uncompressed,
+			  ui32 *nbytes_compressed_p);
+
+/**********************************************************************
+ * lz4_decompress()
+ *
+ * Perform LZ4 decompression on buffer created using lz4_compress();
+ *
+ * The memory for the uncompressed data buffer is allocated by this routine.
+ * This should be freed by the calling routine using ta_compress_free().
+ *
+ * On success, returns pointer to the uncompressed data buffer.
+ * Also, *nbytes_uncompressed_p is set.
+ *
+ * On failure, returns NULL.
+ *
+ **********************************************************************/
+
+extern void *lz4_decompress(const void *compressed_buffer,
+			    ui32 *nbytes_uncompressed_p);
+
 /***************
  * BZIP routines
  ***************/
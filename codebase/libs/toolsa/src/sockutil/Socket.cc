@@ -237,6 +237,37 @@ void Socket::close()
   }
 }
 
+////////////////////////////////////////////////////////
+// releaseSd()
+//
+// Release the socket descriptor, leaving the connection open.
+// Returns the descriptor, -1 if the socket is not open.
+
+int Socket::releaseSd()
+{
+  int sd = _sd;
+  _sd = -1;
+  removeState(STATE_OPENED);
+  addState(STATE_CLOSED);
+  return sd;
+}
+
+////////////////////////////////////////////////////////
+// attachSd()
+//
+// Attach an open socket descriptor.
+// Closes the current one if open.
+
+void Socket::attachSd(int sd)
+{
+  close();
+  _sd = sd;
+  if (_sd >= 0) {
+    resetState();
+    addState(STATE_OPENED);
+  }
+}
+
 ////////////////////////////////////////////////////////
 // readSelect()
 //